@@ -25,6 +25,23 @@ uniform sampler2D AmbientTexture;
 uniform bool UseAmbientTexture;
 uniform float AmbientStrength;
 
+// Shader variant of the material : the texture flags are constants and the unused branches are removed.
+#ifdef VARIANT_UseDiffuseTexture
+	#define UseDiffuseTexture VARIANT_UseDiffuseTexture
+#endif
+#ifdef VARIANT_UseSpecularTexture
+	#define UseSpecularTexture VARIANT_UseSpecularTexture
+#endif
+#ifdef VARIANT_UseShininessTexture
+	#define UseShininessTexture VARIANT_UseShininessTexture
+#endif
+#ifdef VARIANT_UseNormalTexture
+	#define UseNormalTexture VARIANT_UseNormalTexture
+#endif
+#ifdef VARIANT_UseAmbientTexture
+	#define UseAmbientTexture VARIANT_UseAmbientTexture
+#endif
+
 uniform vec3 CameraPosition;
 
 in ShaderData
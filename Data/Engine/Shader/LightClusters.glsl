@@ -0,0 +1,83 @@
+// Clustered lights : the point and spot lights are binned per view cluster on the CPU (LightClusters).
+// "PointLight.glsl" and "SpotLight.glsl" must be included before this file.
+
+uniform mat4 View;
+uniform mat4 Projection;
+
+// One texel per cluster : offset in the indices list, point lights count, spot lights count.
+uniform usamplerBuffer ClusterGrid;
+// Point lights indices then spot lights indices of each cluster.
+uniform usamplerBuffer ClusterLightIndices;
+// Two texels per light : position + radius, color * intensity.
+uniform samplerBuffer ClusterPointLights;
+// Three texels per light : position + range, direction + inner angle, color * intensity + outer angle.
+uniform samplerBuffer ClusterSpotLights;
+
+uniform vec3 ClusterGridSize;
+// Slice = log( Depth ) * Scale + Bias.
+uniform vec2 ClusterDepthSlicing;
+
+struct LightCluster
+{
+	int Offset;
+	int PointLightsCount;
+	int SpotLightsCount;
+};
+
+LightCluster GetLightCluster( in vec3 _WorldPosition )
+{
+	vec4 ViewPosition = vec4( _WorldPosition, 1.0 ) * View;
+	vec4 ClipPosition = ViewPosition * Projection;
+	vec2 NDC = ClipPosition.xy / ClipPosition.w;
+
+	ivec3 GridSize = ivec3( ClusterGridSize );
+	ivec2 Tile = clamp( ivec2( ( NDC * 0.5 + 0.5 ) * vec2( GridSize.xy ) ), ivec2( 0 ), GridSize.xy - 1 );
+
+	float Depth = max( -ViewPosition.z, 0.0001 );
+	int Slice = clamp( int( floor( log( Depth ) * ClusterDepthSlicing.x + ClusterDepthSlicing.y ) ), 0, GridSize.z - 1 );
+
+	uvec4 Cell = texelFetch( ClusterGrid, Tile.x + GridSize.x * ( Tile.y + GridSize.y * Slice ) );
+
+	LightCluster Cluster;
+	Cluster.Offset = int( Cell.x );
+	Cluster.PointLightsCount = int( Cell.y );
+	Cluster.SpotLightsCount = int( Cell.z );
+
+	return Cluster;
+}
+
+PointLight GetClusterPointLight( in LightCluster _Cluster, in int _Index )
+{
+	int LightIndex = int( texelFetch( ClusterLightIndices, _Cluster.Offset + _Index ).r );
+
+	vec4 PositionRadius = texelFetch( ClusterPointLights, LightIndex * 2 );
+	vec4 ColorIntensity = texelFetch( ClusterPointLights, LightIndex * 2 + 1 );
+
+	PointLight Light;
+	Light.Position = PositionRadius.xyz;
+	Light.Radius = PositionRadius.w;
+	Light.Color = vec4( ColorIntensity.rgb, 1.0 );
+	Light.Intensity = 1.0;
+
+	return Light;
+}
+
+SpotLight GetClusterSpotLight( in LightCluster _Cluster, in int _Index )
+{
+	int LightIndex = int( texelFetch( ClusterLightIndices, _Cluster.Offset + _Cluster.PointLightsCount + _Index ).r );
+
+	vec4 PositionRange = texelFetch( ClusterSpotLights, LightIndex * 3 );
+	vec4 DirectionInner = texelFetch( ClusterSpotLights, LightIndex * 3 + 1 );
+	vec4 ColorOuter = texelFetch( ClusterSpotLights, LightIndex * 3 + 2 );
+
+	SpotLight Light;
+	Light.Position = PositionRange.xyz;
+	Light.Range = PositionRange.w;
+	Light.LookAt = DirectionInner.xyz;
+	Light.InnerAngle = DirectionInner.w;
+	Light.Color = vec4( ColorOuter.rgb, 1.0 );
+	Light.Intensity = 1.0;
+	Light.OuterAngle = ColorOuter.w;
+
+	return Light;
+}
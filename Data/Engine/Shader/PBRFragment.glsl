@@ -14,15 +14,8 @@ in ShaderData
 } VertexIn;
 
 #include "PointLight.glsl"
-#define MAX_POINT_LIGHTS_COUNT 20
-uniform int PointLightsCount;
-uniform PointLight PointLights[MAX_POINT_LIGHTS_COUNT];
-
-
 #include "SpotLight.glsl"
-#define MAX_SPOT_LIGHTS_COUNT 10
-uniform int SpotLightsCount;
-uniform SpotLight SpotLights[MAX_SPOT_LIGHTS_COUNT];
+#include "LightClusters.glsl"
 
 #include "DirectionalLight.glsl"
 #define MAX_DIRECTIONAL_LIGHTS_COUNT 3
@@ -39,18 +32,18 @@ uniform DirectionalLight DirectionalLights[MAX_DIRECTIONAL_LIGHTS_COUNT];
 
 #include "ShadowCalculation.glsl"
 
-vec3 ProcessPointLight( in PBRData _PBRData, in vec3 _ViewDirection, in int _LightIndex )
+vec3 ProcessPointLight( in PBRData _PBRData, in vec3 _ViewDirection, in PointLight _Light )
 {
-	vec3 LightDirection = GetPointLightDirection( PointLights[_LightIndex], VertexIn.Position );	
-	vec3 Radiance = GetPointLightRadiance( PointLights[_LightIndex], _ViewDirection, VertexIn.Position );
+	vec3 LightDirection = GetPointLightDirection( _Light, VertexIn.Position );	
+	vec3 Radiance = GetPointLightRadiance( _Light, _ViewDirection, VertexIn.Position );
 
 	return CookTorranceBRDF( _PBRData, _ViewDirection, LightDirection, Radiance );
 }
 
-vec3 ProcessSpotLight( in PBRData _PBRData, in vec3 _ViewDirection, in int _LightIndex )
+vec3 ProcessSpotLight( in PBRData _PBRData, in vec3 _ViewDirection, in SpotLight _Light )
 {
-	vec3 LightDirection = GetSpotLightDirection( SpotLights[_LightIndex], VertexIn.Position );	
-	vec3 Radiance = GetSpotLightRadiance( SpotLights[_LightIndex], _ViewDirection, VertexIn.Position );
+	vec3 LightDirection = GetSpotLightDirection( _Light, VertexIn.Position );	
+	vec3 Radiance = GetSpotLightRadiance( _Light, _ViewDirection, VertexIn.Position );
 
 	return CookTorranceBRDF( _PBRData, _ViewDirection, LightDirection, Radiance );
 }
@@ -95,11 +88,13 @@ void main()
 
     vec3 Lo = vec3( 0.0 );
     
-    for( int Index = 0; Index < PointLightsCount; Index++ )
-        Lo += ProcessPointLight( Params, ViewDirection, Index );
+    LightCluster Cluster = GetLightCluster( VertexIn.Position );
+
+    for( int Index = 0; Index < Cluster.PointLightsCount; Index++ )
+        Lo += ProcessPointLight( Params, ViewDirection, GetClusterPointLight( Cluster, Index ) );
 
-	for( int Index = 0; Index < SpotLightsCount; Index++ )
-        Lo += ProcessSpotLight( Params, ViewDirection, Index );
+	for( int Index = 0; Index < Cluster.SpotLightsCount; Index++ )
+        Lo += ProcessSpotLight( Params, ViewDirection, GetClusterSpotLight( Cluster, Index ) );
 
 	for( int Index = 0; Index < DirectionalLightsCount; Index++ )
         Lo += ProcessDirectionalLight( Params, ViewDirection, Index );
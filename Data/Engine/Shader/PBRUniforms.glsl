@@ -1,41 +1,68 @@
-// Base color user inputs.
-uniform vec4 BaseColor;
+// Samplers can't be stored in a uniform block.
 uniform sampler2D BaseColorTexture;
-uniform bool UseBaseColorTexture;
-
-// Normals user inputs.
 uniform sampler2D NormalCameraTexture;
-uniform bool UseNormalCameraTexture;
-
-// Emissive user inputs.
-uniform vec4 EmissionColor;
 uniform sampler2D EmissionColorTexture;
-uniform bool UseEmissionColorTexture;
-
-// Metalness user inputs.
-uniform float Metalness;
 uniform sampler2D MetalnessTexture;
-uniform bool UseMetalnessTexture;
-
-// Roughness user inputs.
-uniform float Roughness;
 uniform sampler2D RoughnessTexture;
-uniform bool UseRoughnessTexture;
-
-// Ambient occlusion user inputs.
-uniform float AmbientOcclusion;
 uniform sampler2D AmbientOcclusionTexture;
-uniform bool UseAmbientOcclusionTexture;
-
-// Ambient color strength.
-uniform float AmbientStrength;
-
-// Image based lighting.
-uniform bool UseIBL;
 uniform samplerCube IrradianceMap;
 uniform samplerCube RadianceMap;
 uniform sampler2D BRDFLut;
-uniform int RadianceMaxLod;
 
-// HDR
-uniform bool ApplyGammaCorrection;
\ No newline at end of file
+// Material parameters, uploaded by the material only when they change.
+layout(std140) uniform MaterialParameters
+{
+	// Base color user inputs.
+	vec4 BaseColor;
+	bool UseBaseColorTexture;
+
+	// Normals user inputs.
+	bool UseNormalCameraTexture;
+
+	// Emissive user inputs.
+	vec4 EmissionColor;
+	bool UseEmissionColorTexture;
+
+	// Metalness user inputs.
+	float Metalness;
+	bool UseMetalnessTexture;
+
+	// Roughness user inputs.
+	float Roughness;
+	bool UseRoughnessTexture;
+
+	// Ambient occlusion user inputs.
+	float AmbientOcclusion;
+	bool UseAmbientOcclusionTexture;
+
+	// Ambient color strength.
+	float AmbientStrength;
+
+	// Image based lighting.
+	bool UseIBL;
+	int RadianceMaxLod;
+
+	// HDR
+	bool ApplyGammaCorrection;
+};
+
+// Shader variant of the material : the texture flags are constants and the unused branches are removed.
+// The members stay in the block so its layout is the same for all the variants.
+#ifdef VARIANT_UseBaseColorTexture
+	#define UseBaseColorTexture VARIANT_UseBaseColorTexture
+#endif
+#ifdef VARIANT_UseNormalCameraTexture
+	#define UseNormalCameraTexture VARIANT_UseNormalCameraTexture
+#endif
+#ifdef VARIANT_UseEmissionColorTexture
+	#define UseEmissionColorTexture VARIANT_UseEmissionColorTexture
+#endif
+#ifdef VARIANT_UseMetalnessTexture
+	#define UseMetalnessTexture VARIANT_UseMetalnessTexture
+#endif
+#ifdef VARIANT_UseRoughnessTexture
+	#define UseRoughnessTexture VARIANT_UseRoughnessTexture
+#endif
+#ifdef VARIANT_UseAmbientOcclusionTexture
+	#define UseAmbientOcclusionTexture VARIANT_UseAmbientOcclusionTexture
+#endif
\ No newline at end of file
@@ -0,0 +1,61 @@
+#version 450 core
+
+layout (location = 0) in vec3 Position;
+layout (location = 4) in mat4 InstanceModel;
+
+out ShaderData
+{
+	vec3 Position;
+	vec2 UV;
+} VertexOut;
+
+uniform mat4 View;
+uniform mat4 Projection;
+
+uniform vec3 CameraPosition;
+
+uniform sampler2D HeightMap;
+
+// Quadtree settings.
+uniform float CDLODGridResolution;
+uniform float CDLODLeafSize;
+uniform float CDLODLodBaseDistance;
+uniform float CDLODMorphStartRatio;
+uniform float CDLODGroundSize;
+uniform vec3 CDLODGroundPosition;
+
+
+// Place a point of the chunk grid in the ground space, offset by the snow height.
+vec3 GridToGround( vec2 GridPosition )
+{
+	const vec2 ChunkPosition = GridPosition / CDLODGridResolution - 0.5;
+	vec3 GroundPosition = ( vec4( ChunkPosition.x, 0.0, ChunkPosition.y, 1.0 ) * InstanceModel ).xyz;
+
+	GroundPosition.y = texture( HeightMap, GroundPosition.xz / CDLODGroundSize + 0.5 ).r;
+
+	return GroundPosition;
+}
+
+void main()
+{
+	// The chunk size gives its level : the leaves are level 0 and each level doubles the size.
+	const float ChunkSize = InstanceModel[0][0];
+	const float Level = round( log2( ChunkSize / CDLODLeafSize ) );
+
+	const float RangeEnd = CDLODLodBaseDistance * exp2( Level );
+	const float RangeStart = RangeEnd * CDLODMorphStartRatio;
+
+	// Integer coordinates of the vertex in the chunk grid.
+	const vec2 GridPosition = round( ( Position.xz + 0.5 ) * CDLODGridResolution );
+
+	const vec3 WorldPosition = GridToGround( GridPosition ) + CDLODGroundPosition;
+	const float Morph = clamp( ( length( CameraPosition - WorldPosition ) - RangeStart ) / ( RangeEnd - RangeStart ), 0.0, 1.0 );
+
+	// Move the odd vertices onto their even neighbors : at the end of the range the grid matches the one of the next level.
+	const vec2 MorphedGridPosition = GridPosition - fract( GridPosition * 0.5 ) * 2.0 * Morph;
+	const vec3 GroundPosition = GridToGround( MorphedGridPosition );
+
+	VertexOut.Position = GroundPosition + CDLODGroundPosition;
+	gl_Position = vec4( VertexOut.Position, 1.0 ) * ( View * Projection );
+	VertexOut.UV = GroundPosition.xz / CDLODGroundSize + 0.5;
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 330 core
+
+layout (location = 0) in vec3 Position;
+layout (location = 4) in mat4 InstanceModel;
+
+
+uniform mat4 View;
+uniform mat4 Projection;
+
+void main()
+{
+	gl_Position = vec4(Position, 1.0) * (InstanceModel * View * Projection);
+}
\ No newline at end of file
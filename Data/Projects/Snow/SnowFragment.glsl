@@ -11,15 +11,8 @@ in ShaderData
 } VertexIn;
 
 #include "../../Engine/Shader/PointLight.glsl"
-#define MAX_POINT_LIGHTS_COUNT 20
-uniform int PointLightsCount;
-uniform PointLight PointLights[MAX_POINT_LIGHTS_COUNT];
-
-
 #include "../../Engine/Shader/SpotLight.glsl"
-#define MAX_SPOT_LIGHTS_COUNT 10
-uniform int SpotLightsCount;
-uniform SpotLight SpotLights[MAX_SPOT_LIGHTS_COUNT];
+#include "../../Engine/Shader/LightClusters.glsl"
 
 #include "../../Engine/Shader/DirectionalLight.glsl"
 #define MAX_DIRECTIONAL_LIGHTS_COUNT 3
@@ -46,7 +39,18 @@ uniform float SnowGlitterScintillationSpeed;
 
 uniform sampler2D NormalMap;
 
+// Baked detail textures : chunk normal in red/green, grain normal in blue/alpha, glitter random value in red.
+uniform sampler2D SnowDetailMap;
+uniform sampler2D SnowGlitterMap;
+uniform float SnowDetailChunkCells;
+uniform float SnowDetailGrainCells;
+uniform float SnowDetailGlitterCells;
+
+// Random value of the glitter for the current pixel, computed once for all the lights.
+float GlitterRandom;
 
+
+#ifdef SNOW_ANALYTIC_NOISE
 #include "Simplex2DNoise.glsl"
 float SimplexFractalNoise( ivec2 _Offset, float Frequency )
 {
@@ -77,6 +81,16 @@ vec3 SimplexNormal( float Frequency )
 
 	return Normal;
 }
+#else
+// Same encoding as the analytic normal, the baked texture only stores X and Y.
+vec3 DecodeDetailNormal( vec2 _EncodedXY )
+{
+	vec2 XY = _EncodedXY * 2.0 - 1.0;
+	vec3 Normal = vec3( XY, sqrt( max( 1.0 - dot( XY, XY ), 0.0 ) ) );
+
+	return Normal * 0.5 + vec3( 0.5 );
+}
+#endif
 
 float Saturate( float _Value )
 {
@@ -120,7 +134,7 @@ vec3 OceanSpecular( vec3 _Normal, vec3 _ViewDirection, vec3 _LightDirection )
 // https://www.alanzucconi.com/2019/10/08/journey-sand-shader-5/
 vec3 GlitterSpecular( vec3 _Normal, vec3 _ViewDirection, vec3 _LightDirection )
 {
-	float Random = Simplex2DNoise( ( VertexIn.Position.xz + NoiseSeed ) * SnowGlitterFrequency );
+	float Random = GlitterRandom;
 	if( Random < SnowGlitterThreshold )
 		return vec3( 0.0 );
 
@@ -135,20 +149,20 @@ vec3 GlitterSpecular( vec3 _Normal, vec3 _ViewDirection, vec3 _LightDirection )
 	return ( 1.0 - RdotV ) * ( SnowGlitterColor.rgb + Scintillation );
 }
 
-void ProcessPointLight( inout vec3 _Diffuse, inout vec3 _Specular, out vec3 _Glitter, in vec3 _Normal, in vec3 _ViewDirection, in int _LightIndex )
+void ProcessPointLight( inout vec3 _Diffuse, inout vec3 _Specular, inout vec3 _Glitter, in vec3 _Normal, in vec3 _ViewDirection, in PointLight _Light )
 {
-	vec3 LightDirection = GetPointLightDirection( PointLights[_LightIndex], VertexIn.Position );	
-	vec3 Radiance = GetPointLightRadiance( PointLights[_LightIndex], _ViewDirection, VertexIn.Position );
+	vec3 LightDirection = GetPointLightDirection( _Light, VertexIn.Position );	
+	vec3 Radiance = GetPointLightRadiance( _Light, _ViewDirection, VertexIn.Position );
 
 	_Diffuse += DiffuseColor( _Normal, LightDirection ) * Radiance;
 	_Specular += OceanSpecular( _Normal, _ViewDirection, LightDirection ) * Radiance;
 	_Glitter += GlitterSpecular( _Normal, _ViewDirection, LightDirection ) * Radiance;
 }
 
-void ProcessSpotLight( inout vec3 _Diffuse, inout vec3 _Specular, inout vec3 _Glitter, in vec3 _Normal, in vec3 _ViewDirection, in int _LightIndex )
+void ProcessSpotLight( inout vec3 _Diffuse, inout vec3 _Specular, inout vec3 _Glitter, in vec3 _Normal, in vec3 _ViewDirection, in SpotLight _Light )
 {
-	vec3 LightDirection = GetSpotLightDirection( SpotLights[_LightIndex], VertexIn.Position );	
-	vec3 Radiance = GetSpotLightRadiance( SpotLights[_LightIndex], _ViewDirection, VertexIn.Position );
+	vec3 LightDirection = GetSpotLightDirection( _Light, VertexIn.Position );	
+	vec3 Radiance = GetSpotLightRadiance( _Light, _ViewDirection, VertexIn.Position );
 
 	_Diffuse += DiffuseColor( _Normal, LightDirection ) * Radiance;
 	_Specular += OceanSpecular( _Normal, _ViewDirection, LightDirection ) * Radiance;
@@ -172,9 +186,16 @@ vec3 BlendNormals()
 {
 	vec3 BaseNormal = texture( NormalMap, VertexIn.UV ).xyz;
 
+#ifdef SNOW_ANALYTIC_NOISE
 	vec3 Chunk = SimplexNormal( ChunkFrequency );
 	
 	vec3 Grain = SimplexNormal( GrainFrequency );
+#else
+	// The analytic noise has "Frequency" cells in a fifth of the UV, a baked tile has "Cells" cells.
+	vec3 Chunk = DecodeDetailNormal( texture( SnowDetailMap, VertexIn.UV * 5.0 * ChunkFrequency / SnowDetailChunkCells ).rg );
+
+	vec3 Grain = DecodeDetailNormal( texture( SnowDetailMap, VertexIn.UV * 5.0 * GrainFrequency / SnowDetailGrainCells ).ba );
+#endif
 
 	vec3 Normal = normalize( BaseNormal + ChunkAmount * Chunk + GrainAmount * Grain );
 
@@ -183,6 +204,12 @@ vec3 BlendNormals()
 
 void main()
 {	
+#ifdef SNOW_ANALYTIC_NOISE
+	GlitterRandom = Simplex2DNoise( ( VertexIn.Position.xz + NoiseSeed ) * SnowGlitterFrequency );
+#else
+	GlitterRandom = texture( SnowGlitterMap, ( VertexIn.Position.xz + NoiseSeed ) * SnowGlitterFrequency / SnowDetailGlitterCells ).r * 2.0 - 1.0;
+#endif
+
 	vec3 TangentNormal = BlendNormals();
 	vec3 Normal = TangentNormalToWorld( TangentNormal, vec3( 0.0, 1.0, 0.0 ), VertexIn.Position, VertexIn.UV );
 
@@ -192,11 +219,13 @@ void main()
 	vec3 Specular = vec3( 0.0 );
 	vec3 Glitter = vec3( 0.0 );
     
-    for( int Index = 0; Index < PointLightsCount; Index++ )
-        ProcessPointLight( Diffuse, Specular, Glitter, Normal, ViewDirection, Index );
+    LightCluster Cluster = GetLightCluster( VertexIn.Position );
+
+    for( int Index = 0; Index < Cluster.PointLightsCount; Index++ )
+        ProcessPointLight( Diffuse, Specular, Glitter, Normal, ViewDirection, GetClusterPointLight( Cluster, Index ) );
 
-	for( int Index = 0; Index < SpotLightsCount; Index++ )
-        ProcessSpotLight( Diffuse, Specular, Glitter, Normal, ViewDirection, Index );
+	for( int Index = 0; Index < Cluster.SpotLightsCount; Index++ )
+        ProcessSpotLight( Diffuse, Specular, Glitter, Normal, ViewDirection, GetClusterSpotLight( Cluster, Index ) );
 
 	for( int Index = 0; Index < DirectionalLightsCount; Index++ )
         ProcessDirectionalLight( Diffuse, Specular, Glitter, Normal, ViewDirection, Index );
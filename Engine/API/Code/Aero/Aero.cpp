@@ -32,16 +32,29 @@ namespace ae
 		// Update inputs before processing events (needed to update mouse position).
 		UpdateInputs();
 
+		// Look for modified shader files, the shaders using them are recompiled during the uploads.
+		m_Resources.GetShaderSourceCache().CheckModifiedFiles();
+
+		// Run the jobs submitted for the main thread (OpenGL work).
+		m_Jobs.ProcessMainThreadJobs();
+
+		// Upload the resources loaded in the background, within the frame budget.
+		m_AsyncLoader.ProcessUploads();
+
 		// Update the world (physics, ...).
 		m_World.Update();
 
+		Bool IsOpen = False;
 		if( m_Window != nullptr && m_Window->IsOpen() )
 		{
 			m_Window->WindowIteration();
-			return True;
+			IsOpen = True;
 		}
 
-		return False;
+		// End of the frame : the transient memory of all the threads is reused from now.
+		priv::FrameArena::EndFrame();
+
+		return IsOpen;
 	}
 
 
@@ -65,6 +78,9 @@ namespace ae
 
 		// Deinitialize GLFW library.
 		glfwTerminate();
+
+		// Write the pending messages, the next ones are written directly.
+		Log::Shutdown();
 	}
 
 	void AeroCore::SetWindow( Window* _Window )
@@ -158,6 +174,16 @@ namespace ae
 		return m_Resources;
 	}
 
+	AsyncLoader& AeroCore::GetAsyncLoader()
+	{
+		return m_AsyncLoader;
+	}
+
+	JobSystem& AeroCore::GetJobSystem()
+	{
+		return m_Jobs;
+	}
+
 	const std::string& AeroCore::GetPathToEngineData() const
 	{
 		return m_PathToEngineData;
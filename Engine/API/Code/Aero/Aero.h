@@ -6,9 +6,13 @@
 
 #include "../TimeManagement/Time/Time.h"
 
+#include "../Toolbox/JobSystem/JobSystem.h"
+#include "../Toolbox/FrameAllocator/FrameAllocator.h"
+
 #include "../World/World.h"
 
 #include "../Resources/ResourcesManager.h"
+#include "../Resources/AsyncLoader/AsyncLoader.h"
 
 #include "../Input/InputManager/InputManager.h"
 
@@ -106,6 +110,14 @@ namespace ae
 		/// <returns>The resources manager.</returns>
 		const ResourcesManager& GetResourcesManager() const;
 
+		/// <summary>Retrieve the loader streaming resources in the background.</summary>
+		/// <returns>The asynchronous loader.</returns>
+		AsyncLoader& GetAsyncLoader();
+
+		/// <summary>Retrieve the job system running the CPU work of the engine in parallel.</summary>
+		/// <returns>The job system.</returns>
+		JobSystem& GetJobSystem();
+
         /// <summary>Get the current path to the engine datas (shaders, images, ...)</summary>
         /// <returns>Path the engine datas.</returns>
         const std::string& GetPathToEngineData() const;
@@ -159,12 +171,18 @@ namespace ae
         /// <summary>Input manager object : handle all keyboard/mouse/gamepad events.</summary>
 		Input::InputManager m_InputManager;
 
+		/// <summary>Job system : run the CPU work of the modules on all the cores. Declared before them to outlive them.</summary>
+		JobSystem m_Jobs;
+
         /// <summary>World : store objects and manage them.</summary>
 		World m_World;
 
 		/// <summary>Resources Manager : store the pointers to resources (textures, shaders, ...).</summary>
 		ResourcesManager m_Resources;
 
+		/// <summary>Load resources in the background. Declared after the resources manager to stop its workers first.</summary>
+		AsyncLoader m_AsyncLoader;
+
         /// <summary>Path to folder containing shaders and Aero stuffs.</summary>
         std::string m_PathToEngineData;
 	};
@@ -8,7 +8,10 @@
 #endif
 #include "../../Graphics/Dependencies/OpenGL.h"
 
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace ae
 {
@@ -95,6 +98,33 @@ namespace ae
             }
         }
 
+        /// <summary>Level of the OpenGL checks, read before each OpenGL call check.</summary>
+        OpenGLErrorCheck CurrentOpenGLErrorCheck = DefaultOpenGLErrorCheck;
+
+        /// <summary>Maximum count of errors read at a checkpoint : glGetError returns one error flag per call.</summary>
+        constexpr Uint32 MaxOpenGLErrorsPerCheckpoint = 8;
+
+        /// <summary>Maximum count of driver messages kept between two checkpoints, the next ones are only counted.</summary>
+        constexpr Uint32 MaxOpenGLDebugMessagesQueued = 64;
+
+        /// <summary>Message of the driver waiting for the next checkpoint.</summary>
+        struct OpenGLDebugMessage
+        {
+            Log::MessageType Type;
+            std::string Text;
+        };
+
+        /// <summary>Messages received by the debug callback, from any thread of the driver. Protected by OpenGLDebugMessagesMutex.</summary>
+        std::vector<OpenGLDebugMessage> OpenGLDebugMessages;
+
+        /// <summary>Count of messages not kept since the last checkpoint. Protected by OpenGLDebugMessagesMutex.</summary>
+        Uint32 OpenGLDebugMessagesDropped = 0;
+
+        std::mutex OpenGLDebugMessagesMutex;
+
+        /// <summary>Some messages are queued : the checkpoints without message don't lock.</summary>
+        std::atomic<Bool> HasOpenGLDebugMessages( False );
+
         Bool IsThereOpenGLError( const Uint32 _glError )
         {
             return _glError != GL_NO_ERROR;
@@ -118,6 +148,99 @@ namespace ae
 
         }
 
+        const char* OpenGLDebugSourceToString( GLenum _Source )
+        {
+            switch( _Source )
+            {
+            case GL_DEBUG_SOURCE_API:				return "API";
+            case GL_DEBUG_SOURCE_WINDOW_SYSTEM:		return "Window system";
+            case GL_DEBUG_SOURCE_SHADER_COMPILER:	return "Shader compiler";
+            case GL_DEBUG_SOURCE_THIRD_PARTY:		return "Third party";
+            case GL_DEBUG_SOURCE_APPLICATION:		return "Application";
+            default:								return "Other";
+            }
+        }
+
+        const char* OpenGLDebugTypeToString( GLenum _Type )
+        {
+            switch( _Type )
+            {
+            case GL_DEBUG_TYPE_ERROR:				return "error";
+            case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:	return "deprecated behavior";
+            case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:	return "undefined behavior";
+            case GL_DEBUG_TYPE_PORTABILITY:			return "portability";
+            case GL_DEBUG_TYPE_PERFORMANCE:			return "performance";
+            case GL_DEBUG_TYPE_MARKER:				return "marker";
+            default:								return "other";
+            }
+        }
+
+        /// <summary>
+        /// Messages of the driver, can be called from a thread of the driver.<para/>
+        /// Only queued : an error logged here would get the stack trace of the driver thread and wait for the log inside the driver.
+        /// </summary>
+        void GLAPIENTRY OnOpenGLDebugMessage( GLenum _Source, GLenum _Type, GLuint _ID, GLenum _Severity, GLsizei _Length, const GLchar* _Message, const void* _UserParam )
+        {
+            OpenGLDebugMessage Message;
+            Message.Type = _Severity == GL_DEBUG_SEVERITY_HIGH || _Type == GL_DEBUG_TYPE_ERROR ? Log::Error : _Severity == GL_DEBUG_SEVERITY_MEDIUM ? Log::Warning : Log::Message;
+            Message.Text = std::string( "OpenGL " ) + OpenGLDebugSourceToString( _Source ) + " " + OpenGLDebugTypeToString( _Type ) + " (" + std::to_string( _ID ) + ") : ";
+            Message.Text += _Length < 0 ? std::string( _Message ) : std::string( _Message, Cast( size_t, _Length ) );
+
+            std::lock_guard<std::mutex> Lock( OpenGLDebugMessagesMutex );
+
+            if( OpenGLDebugMessages.size() < MaxOpenGLDebugMessagesQueued )
+                OpenGLDebugMessages.push_back( std::move( Message ) );
+            else
+                OpenGLDebugMessagesDropped++;
+
+            HasOpenGLDebugMessages.store( True, std::memory_order_release );
+        }
+
+        /// <summary>Log the messages of the driver received since the last checkpoint, on the thread of the checkpoint.</summary>
+        /// <returns>False if one of them is an error.</returns>
+        Bool LogOpenGLDebugMessages( const char* _PassName )
+        {
+            if( !HasOpenGLDebugMessages.load( std::memory_order_acquire ) )
+                return True;
+
+            std::vector<OpenGLDebugMessage> Messages;
+            Uint32 DroppedCount = 0;
+            {
+                std::lock_guard<std::mutex> Lock( OpenGLDebugMessagesMutex );
+
+                Messages.swap( OpenGLDebugMessages );
+                std::swap( DroppedCount, OpenGLDebugMessagesDropped );
+                HasOpenGLDebugMessages.store( False, std::memory_order_relaxed );
+            }
+
+            Bool IsOk = True;
+
+            // Without GL_DEBUG_OUTPUT_SYNCHRONOUS, the message can come from a previous pass.
+            for( const OpenGLDebugMessage& Message : Messages )
+            {
+                const std::string Text = Message.Text + " (reported at the end of " + _PassName + ")";
+
+                if( Message.Type == Log::Error )
+                {
+                    AE_LogError( Text );
+                    IsOk = False;
+                }
+                else if( Message.Type == Log::Warning )
+                {
+                    AE_LogWarning( Text );
+                }
+                else
+                {
+                    AE_LogMessage( Text );
+                }
+            }
+
+            if( DroppedCount > 0 )
+                AE_LogWarning( std::to_string( DroppedCount ) + " OpenGL debug messages dropped before the end of " + _PassName + "." );
+
+            return IsOk;
+        }
+
         Bool Error::CheckHResult( const Uint32 _Result )
         {
             if( !IsThereHResultError( _Result ) )
@@ -144,11 +267,87 @@ namespace ae
                 return True;
 
             std::string ErrorString;
-            ErrnoToString( ErrorString, _glError );
+            OpenGLToString( ErrorString, _glError );
+            AE_LogError( ErrorString );
 
             return False;
         }
 
+        Bool Error::CheckOpenGLCall( const char* _File, Uint32 _Line )
+        {
+            if( CurrentOpenGLErrorCheck != OpenGLErrorCheck::PerCall )
+                return True;
+
+            const GLenum glError = glGetError();
+
+            if( !IsThereOpenGLError( glError ) )
+                return True;
+
+            std::string ErrorString;
+            OpenGLToString( ErrorString, glError );
+            AE_LogError( ErrorString + " (" + _File + " : " + std::to_string( _Line ) + ")" );
+
+            return False;
+        }
+
+        Bool Error::CheckOpenGLCheckpoint( const char* _PassName )
+        {
+            // Also the messages received before a switch to another level.
+            Bool IsOk = LogOpenGLDebugMessages( _PassName );
+
+            if( CurrentOpenGLErrorCheck != OpenGLErrorCheck::Checkpoint && CurrentOpenGLErrorCheck != OpenGLErrorCheck::PerCall )
+                return IsOk;
+
+            for( Uint32 e = 0; e < MaxOpenGLErrorsPerCheckpoint; e++ )
+            {
+                const GLenum glError = glGetError();
+
+                if( !IsThereOpenGLError( glError ) )
+                    break;
+
+                std::string ErrorString;
+                OpenGLToString( ErrorString, glError );
+                AE_LogError( ErrorString + " (during " + _PassName + ")" );
+
+                IsOk = False;
+            }
+
+            return IsOk;
+        }
+
+        void Error::SetOpenGLErrorCheck( OpenGLErrorCheck _Check )
+        {
+#if !AE_OPENGL_ERROR_CHECK_CALLS
+            if( _Check == OpenGLErrorCheck::PerCall )
+                AE_LogWarning( "OpenGL per call checks are not compiled (AE_OPENGL_ERROR_CHECK_CALLS), only the checkpoints are checked." );
+#endif
+
+            CurrentOpenGLErrorCheck = _Check;
+
+            // No context yet : the callback will be installed with the creation of the window.
+            if( glDebugMessageCallback == nullptr )
+                return;
+
+            if( _Check == OpenGLErrorCheck::DebugCallback )
+            {
+                glDebugMessageCallback( OnOpenGLDebugMessage, nullptr );
+
+                // The notifications are informative only (buffer placement, ...), too frequent for the log.
+                glDebugMessageControl( GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE );
+                glEnable( GL_DEBUG_OUTPUT );
+            }
+            else
+            {
+                glDisable( GL_DEBUG_OUTPUT );
+                glDebugMessageCallback( nullptr, nullptr );
+            }
+        }
+
+        OpenGLErrorCheck Error::GetOpenGLErrorCheck()
+        {
+            return CurrentOpenGLErrorCheck;
+        }
+
 
         Uint32 Error::Win32FromHResult( Uint32 _ErrorCode )
         {
@@ -6,8 +6,48 @@
 
 #include <assert.h>
 
+/// <summary>
+/// Compile the checks after each OpenGL call (AE_ErrorCheckOpenGLError).<para/>
+/// Enabled by default in debug builds only : in release the checks cost nothing, the checkpoints and the debug callback remain.
+/// </summary>
+#ifndef AE_OPENGL_ERROR_CHECK_CALLS
+#ifdef _DEBUG
+#define AE_OPENGL_ERROR_CHECK_CALLS 1
+#else
+#define AE_OPENGL_ERROR_CHECK_CALLS 0
+#endif
+#endif
+
 namespace ae
 {
+    /// \ingroup debugging
+    /// <summary>How the OpenGL errors are checked, from the cheapest to the most precise.</summary>
+    enum class OpenGLErrorCheck : Uint8
+    {
+        /// <summary>No check.</summary>
+        Off,
+
+        /// <summary>Errors checked at the end of each pass (framebuffer unbind, frame swap) : one glGetError per pass, the error is located to the pass.</summary>
+        Checkpoint,
+
+        /// <summary>
+        /// Errors checked after each OpenGL call : the error is located to the call but each check waits for the driver.<para/>
+        /// Needs AE_OPENGL_ERROR_CHECK_CALLS, only the checkpoints are checked otherwise.
+        /// </summary>
+        PerCall,
+
+        /// <summary>
+        /// No glGetError, the driver sends its messages asynchronously (KHR_debug), they are logged at the next checkpoint.
+        /// The objects are named in the messages with their labels (glObjectLabel).<para/>
+        /// The drivers only send detailed messages to a debug context : see WindowSettings.
+        /// </summary>
+        DebugCallback
+    };
+
+    /// \ingroup debugging
+    /// <summary>Check done when nothing is set : per call in the builds compiling them, per pass otherwise.</summary>
+    constexpr OpenGLErrorCheck DefaultOpenGLErrorCheck = AE_OPENGL_ERROR_CHECK_CALLS ? OpenGLErrorCheck::PerCall : OpenGLErrorCheck::Checkpoint;
+
     namespace priv
     {
         /// \ingroup debugging
@@ -40,6 +80,35 @@ namespace ae
             static Bool CheckOpenGLError( const Uint32 _glError );
 
 
+            /// <summary>Check the OpenGL error of the last call if the per call checks are enabled.</summary>
+            /// <param name="_File">File of the call.</param>
+            /// <param name="_Line">Line of the call.</param>
+            /// <returns>True if there was no error or the check is disabled, False otherwise.</returns>
+            static Bool CheckOpenGLCall( const char* _File, Uint32 _Line );
+
+
+            /// <summary>
+            /// Check all the OpenGL errors raised since the last check, unless the checks are off or done by the debug callback.<para/>
+            /// Log the messages received by the debug callback since the last checkpoint.
+            /// </summary>
+            /// <param name="_PassName">Name of the pass that ends, for the log.</param>
+            /// <returns>True if there was no error or the check is disabled, False otherwise.</returns>
+            static Bool CheckOpenGLCheckpoint( const char* _PassName );
+
+
+            /// <summary>
+            /// Set how the OpenGL errors are checked.<para/>
+            /// The debug callback is installed on the current context : set it once the context is created (see WindowSettings).
+            /// </summary>
+            /// <param name="_Check">New level of the checks.</param>
+            static void SetOpenGLErrorCheck( OpenGLErrorCheck _Check );
+
+
+            /// <summary>Get how the OpenGL errors are checked.</summary>
+            /// <returns>Level of the checks.</returns>
+            static OpenGLErrorCheck GetOpenGLErrorCheck();
+
+
             /// <summary>Convert a HResult error value to a Win32 error value.</summary>
             /// <param name="_ErrorCode">HResult value to convert.</param>
             /// <returns>HResult error value converted.</returns>
@@ -76,9 +145,21 @@ namespace ae
 #define AE_ErrorCheckErrno(_Error) ( ae::priv::Error::CheckErrno( _Error ) )
 
 
-/// <summary>Check an OpenGL error value to see if it is ok.</summary>
-/// <returns>True if the value was ok, False otherwise.</returns>
-#define AE_ErrorCheckOpenGLError() ( ae::priv::Error::CheckOpenGLError( glGetError() ) )
+/// <summary>
+/// Check the error of the last OpenGL call, when the checks are set per call.<para/>
+/// Compiled to nothing without AE_OPENGL_ERROR_CHECK_CALLS. A statement : it has no value in both cases.
+/// </summary>
+#if AE_OPENGL_ERROR_CHECK_CALLS
+#define AE_ErrorCheckOpenGLError() ( (void)ae::priv::Error::CheckOpenGLCall( __FILE__, __LINE__ ) )
+#else
+#define AE_ErrorCheckOpenGLError() ( (void)0 )
+#endif
+
+
+/// <summary>Check the OpenGL errors raised during a pass, when the checks are set per pass or per call, and log the messages of the debug callback.</summary>
+/// <param name="_PassName">Name of the pass that ends.</param>
+/// <returns>True if there was no error or the check is disabled, False otherwise.</returns>
+#define AE_ErrorCheckOpenGLCheckpoint(_PassName) ( ae::priv::Error::CheckOpenGLCheckpoint( _PassName ) )
 
 
 /// <summary>
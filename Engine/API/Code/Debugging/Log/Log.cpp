@@ -4,9 +4,558 @@
 #include "../Error/Error.h"
 
 #include "../Dependencies/loguru.hpp"
+#include "../../Maths/Functions/MathsFunctions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ae
 {
+    namespace
+    {
+        /// <summary>Count of records of the ring of each thread, power of two.</summary>
+        constexpr Uint32 RingCapacity = 512;
+
+        /// <summary>Size of the text stored in a record, longer messages are allocated.</summary>
+        constexpr Uint32 InlineTextSize = 245;
+
+        /// <summary>Time waited by the logging thread when no message is pending.</summary>
+        constexpr std::chrono::milliseconds WakeInterval( 5 );
+
+        /// <summary>Time during which the identical messages are counted.</summary>
+        constexpr std::chrono::seconds RepeatWindow( 1 );
+
+        /// <summary>Default count of identical messages written each second.</summary>
+        constexpr Uint32 DefaultRepeatLimit = 5;
+
+        const int LogLevels[3] = { loguru::Verbosity_INFO, loguru::Verbosity_WARNING, loguru::Verbosity_ERROR };
+
+        /// <summary>A message waiting to be written, one cache line pair.</summary>
+        struct LogRecord
+        {
+            /// <summary>Whole text when it does not fit in the record or when it is an error with its stack trace.</summary>
+            std::unique_ptr<std::string> Overflow;
+
+            /// <summary>Length of the inline text.</summary>
+            Uint16 Length;
+
+            /// <summary>Type of the message.</summary>
+            Uint8 Type;
+
+            /// <summary>Text of the message when it fits, not null terminated.</summary>
+            char Text[InlineTextSize];
+        };
+
+        static_assert( sizeof( LogRecord ) == 256, "A log record must stay 256 bytes." );
+
+        /// <summary>
+        /// Records of one thread to the logging thread : single producer, single consumer.<para/>
+        /// The indices only grow, the record of an index is at index % RingCapacity.
+        /// </summary>
+        struct LogRing
+        {
+            LogRecord Records[RingCapacity];
+
+            /// <summary>Next record written by the thread, published after the record is filled.</summary>
+            alignas( 64 ) std::atomic<Uint32> WriteIndex{ 0 };
+
+            /// <summary>Next record read by the logging thread, the records before can be reused.</summary>
+            alignas( 64 ) std::atomic<Uint32> ReadIndex{ 0 };
+
+            /// <summary>Count of messages dropped because the ring was full.</summary>
+            std::atomic<Uint32> DroppedCount{ 0 };
+
+            /// <summary>The thread has exited, the ring is removed once read.</summary>
+            std::atomic<Bool> IsOrphan{ False };
+        };
+
+        /// <summary>Ring of the calling thread, given up when the thread exits.</summary>
+        struct LocalRing
+        {
+            ~LocalRing()
+            {
+                if( Ring == nullptr )
+                    return;
+
+                Ring->IsOrphan.store( True, std::memory_order_release );
+                Ring.reset();
+            }
+
+            std::shared_ptr<LogRing> Ring;
+        };
+
+        thread_local LocalRing ThreadRing;
+
+        /// <summary>Identical messages received in the current repeat window.</summary>
+        struct RepeatedMessage
+        {
+            /// <summary>Count of times the message has been received.</summary>
+            Uint32 Count = 0;
+
+            /// <summary>Type of the message.</summary>
+            Log::MessageType Type = Log::Message;
+
+            /// <summary>Text of the message, kept once it is not written anymore.</summary>
+            std::string Text;
+        };
+
+        /// <summary>FNV-1a hash of a text, to find the identical messages.</summary>
+        Uint64 HashText( const char* _Text, size_t _Length, Uint8 _Type )
+        {
+            Uint64 Hash = 14695981039346656037ull ^ _Type;
+
+            for( size_t c = 0; c < _Length; c++ )
+            {
+                Hash ^= Cast( Uint8, _Text[c] );
+                Hash *= 1099511628211ull;
+            }
+
+            return Hash;
+        }
+
+        /// <summary>Write a message with loguru, on the calling thread.</summary>
+        void WriteMessage( Log::MessageType _MessageType, const char* _Text )
+        {
+            VLOG_F( LogLevels[_MessageType], "%s", _Text );
+        }
+
+        /// <summary>Get the stack trace of the caller of the log followed by the message.</summary>
+        std::string BuildErrorText( const char* _Message )
+        {
+            // Skip this function, the backend and Log::LogMessage.
+            loguru::Text StackTrace = loguru::stacktrace( 3 );
+
+            std::string Text = StackTrace.c_str();
+            Text += "\n\t ";
+            Text += _Message;
+
+            return Text;
+        }
+
+        /// <summary>Logging thread and the rings of the threads writing to it.</summary>
+        class LogBackend
+        {
+        public:
+            LogBackend() :
+                m_IsRunning( False ),
+                m_IsStopping( False ),
+                m_IsStopped( False ),
+                m_IsWakeRequested( False ),
+                m_RingsVersion( 0 ),
+                m_RepeatLimit( DefaultRepeatLimit )
+            {
+            }
+
+            ~LogBackend()
+            {
+                Stop();
+            }
+
+            void Push( Log::MessageType _MessageType, const char* _Message )
+            {
+                if( m_IsStopped.load( std::memory_order_acquire ) )
+                {
+                    WriteMessage( _MessageType, _MessageType == Log::Error ? BuildErrorText( _Message ).c_str() : _Message );
+                    return;
+                }
+
+                std::call_once( m_StartFlag, &LogBackend::Start, this );
+
+                LogRing& Ring = GetLocalRing();
+
+                const Uint32 WriteIndex = Ring.WriteIndex.load( std::memory_order_relaxed );
+
+                // Errors are never dropped : wait for the logging thread to free a record.
+                while( WriteIndex - Ring.ReadIndex.load( std::memory_order_acquire ) >= RingCapacity )
+                {
+                    // Stopped meanwhile : the logging thread will not free a record anymore.
+                    if( m_IsStopped.load( std::memory_order_acquire ) )
+                    {
+                        DrainLocalRing( Ring );
+                        WriteMessage( _MessageType, _MessageType == Log::Error ? BuildErrorText( _Message ).c_str() : _Message );
+                        return;
+                    }
+
+                    if( _MessageType != Log::Error )
+                    {
+                        Ring.DroppedCount.fetch_add( 1, std::memory_order_relaxed );
+                        return;
+                    }
+
+                    std::this_thread::yield();
+                }
+
+                LogRecord& Record = Ring.Records[WriteIndex % RingCapacity];
+                Record.Type = Cast( Uint8, _MessageType );
+
+                if( _MessageType == Log::Error )
+                {
+                    Record.Length = 0;
+                    Record.Overflow = std::make_unique<std::string>( BuildErrorText( _Message ) );
+                }
+                else
+                {
+                    const size_t Length = std::strlen( _Message );
+
+                    if( Length <= InlineTextSize )
+                    {
+                        Record.Length = Cast( Uint16, Length );
+                        std::memcpy( Record.Text, _Message, Length );
+                    }
+                    else
+                    {
+                        Record.Length = 0;
+                        Record.Overflow = std::make_unique<std::string>( _Message, Length );
+                    }
+                }
+
+                Ring.WriteIndex.store( WriteIndex + 1, std::memory_order_release );
+
+                // Stopped between the check above and the publication : the logging thread may have read the rings for the last time.
+                // The fence pairs with the one of the logging thread, one of them sees the other store.
+                std::atomic_thread_fence( std::memory_order_seq_cst );
+
+                if( m_IsStopped.load( std::memory_order_relaxed ) )
+                {
+                    DrainLocalRing( Ring );
+                    return;
+                }
+
+                if( _MessageType == Log::Error )
+                    Flush();
+            }
+
+            void Flush()
+            {
+                if( !m_IsRunning.load( std::memory_order_acquire ) )
+                    return;
+
+                // Wait for the records published so far in each ring.
+                std::vector<std::pair<std::shared_ptr<LogRing>, Uint32>> Targets;
+                {
+                    std::lock_guard<std::mutex> Lock( m_RingsMutex );
+
+                    Targets.reserve( m_Rings.size() );
+                    for( const std::shared_ptr<LogRing>& Ring : m_Rings )
+                        Targets.emplace_back( Ring, Ring->WriteIndex.load( std::memory_order_acquire ) );
+                }
+
+                std::unique_lock<std::mutex> Lock( m_WakeMutex );
+
+                m_IsWakeRequested = True;
+                m_WakeCondition.notify_one();
+
+                m_FlushedCondition.wait( Lock, [this, &Targets]()
+                {
+                    if( !m_IsRunning.load( std::memory_order_acquire ) )
+                        return True;
+
+                    for( const auto& Target : Targets )
+                    {
+                        if( Cast( Int32, Target.first->ReadIndex.load( std::memory_order_acquire ) - Target.second ) < 0 )
+                            return False;
+                    }
+
+                    return True;
+                } );
+            }
+
+            void Stop()
+            {
+                // Block the start if the logger was never used.
+                std::call_once( m_StartFlag, []() {} );
+
+                if( m_IsStopped.exchange( True ) )
+                    return;
+
+                if( m_Thread.joinable() )
+                {
+                    {
+                        std::lock_guard<std::mutex> Lock( m_WakeMutex );
+                        m_IsStopping = True;
+                        m_WakeCondition.notify_one();
+                    }
+
+                    m_Thread.join();
+                }
+
+                std::lock_guard<std::mutex> Lock( m_WakeMutex );
+                m_IsRunning.store( False, std::memory_order_release );
+                m_FlushedCondition.notify_all();
+            }
+
+            void SetRepeatLimit( Uint32 _Count )
+            {
+                m_RepeatLimit.store( _Count, std::memory_order_relaxed );
+            }
+
+            Uint32 GetRepeatLimit() const
+            {
+                return m_RepeatLimit.load( std::memory_order_relaxed );
+            }
+
+        private:
+            void Start()
+            {
+                m_IsRunning.store( True, std::memory_order_release );
+                m_RepeatWindowStart = std::chrono::steady_clock::now();
+                m_Thread = std::thread( &LogBackend::ThreadLoop, this );
+            }
+
+            /// <summary>Write on the calling thread the records of its ring not read by the logging thread, once it has exited.</summary>
+            void DrainLocalRing( LogRing& _Ring )
+            {
+                // The logging thread may be reading the rings one last time, the ring is only ours once it is joined.
+                {
+                    std::unique_lock<std::mutex> Lock( m_WakeMutex );
+                    m_FlushedCondition.wait( Lock, [this]() { return !m_IsRunning.load( std::memory_order_acquire ); } );
+                }
+
+                Uint32 ReadIndex = _Ring.ReadIndex.load( std::memory_order_relaxed );
+                const Uint32 WriteIndex = _Ring.WriteIndex.load( std::memory_order_relaxed );
+
+                for( ; ReadIndex != WriteIndex; ReadIndex++ )
+                {
+                    LogRecord& Record = _Ring.Records[ReadIndex % RingCapacity];
+
+                    if( Record.Overflow != nullptr )
+                        WriteMessage( Cast( Log::MessageType, Record.Type ), Record.Overflow->c_str() );
+                    else
+                        WriteMessage( Cast( Log::MessageType, Record.Type ), std::string( Record.Text, Record.Length ).c_str() );
+
+                    Record.Overflow.reset();
+                }
+
+                _Ring.ReadIndex.store( ReadIndex, std::memory_order_release );
+
+                const Uint32 DroppedCount = _Ring.DroppedCount.exchange( 0, std::memory_order_relaxed );
+
+                if( DroppedCount > 0 )
+                    WriteMessage( Log::Warning, ( std::to_string( DroppedCount ) + " messages dropped, the log ring of a thread was full." ).c_str() );
+            }
+
+            LogRing& GetLocalRing()
+            {
+                if( ThreadRing.Ring == nullptr )
+                {
+                    ThreadRing.Ring = std::make_shared<LogRing>();
+
+                    std::lock_guard<std::mutex> Lock( m_RingsMutex );
+                    m_Rings.push_back( ThreadRing.Ring );
+                    m_RingsVersion.fetch_add( 1, std::memory_order_release );
+                }
+
+                return *ThreadRing.Ring;
+            }
+
+            void ThreadLoop()
+            {
+                loguru::set_thread_name( "Log" );
+
+                // Copy of the rings, refreshed when a thread logs for the first time.
+                std::vector<std::shared_ptr<LogRing>> Rings;
+                Uint32 RingsVersion = Math::Max<Uint32>();
+
+                while( True )
+                {
+                    // Read before the rings : the messages logged before the stop are all read.
+                    const Bool IsStopping = m_IsStopping.load( std::memory_order_acquire );
+
+                    // Pairs with the fence of Push : a record published before its stop check is seen here.
+                    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+                    if( RingsVersion != m_RingsVersion.load( std::memory_order_acquire ) )
+                    {
+                        std::lock_guard<std::mutex> Lock( m_RingsMutex );
+
+                        RingsVersion = m_RingsVersion.load( std::memory_order_relaxed );
+                        Rings = m_Rings;
+                    }
+
+                    const Bool HasRead = ReadRings( Rings );
+
+                    UpdateRepeatWindow( IsStopping );
+
+                    std::unique_lock<std::mutex> Lock( m_WakeMutex );
+
+                    if( HasRead )
+                        m_FlushedCondition.notify_all();
+
+                    if( IsStopping )
+                        break;
+
+                    if( !HasRead )
+                        m_WakeCondition.wait_for( Lock, WakeInterval, [this]() { return m_IsWakeRequested || m_IsStopping; } );
+
+                    m_IsWakeRequested = False;
+                }
+            }
+
+            /// <returns>True if at least one record has been read.</returns>
+            Bool ReadRings( std::vector<std::shared_ptr<LogRing>>& _Rings )
+            {
+                Bool HasRead = False;
+                Bool HasOrphan = False;
+
+                for( const std::shared_ptr<LogRing>& Ring : _Rings )
+                {
+                    // Checked before reading : the records of an exited thread are all published.
+                    HasOrphan |= Ring->IsOrphan.load( std::memory_order_acquire );
+
+                    Uint32 ReadIndex = Ring->ReadIndex.load( std::memory_order_relaxed );
+                    const Uint32 WriteIndex = Ring->WriteIndex.load( std::memory_order_acquire );
+
+                    for( ; ReadIndex != WriteIndex; ReadIndex++ )
+                    {
+                        LogRecord& Record = Ring->Records[ReadIndex % RingCapacity];
+
+                        if( Record.Overflow != nullptr )
+                            ReadMessage( Cast( Log::MessageType, Record.Type ), Record.Overflow->c_str(), Record.Overflow->size() );
+                        else
+                            ReadMessage( Cast( Log::MessageType, Record.Type ), Record.Text, Record.Length );
+
+                        Record.Overflow.reset();
+                        HasRead = True;
+
+                        Ring->ReadIndex.store( ReadIndex + 1, std::memory_order_release );
+                    }
+
+                    const Uint32 DroppedCount = Ring->DroppedCount.exchange( 0, std::memory_order_relaxed );
+
+                    if( DroppedCount > 0 )
+                        WriteMessage( Log::Warning, ( std::to_string( DroppedCount ) + " messages dropped, the log ring of a thread was full." ).c_str() );
+                }
+
+                if( HasOrphan )
+                    RemoveOrphanRings( _Rings );
+
+                return HasRead;
+            }
+
+            void RemoveOrphanRings( std::vector<std::shared_ptr<LogRing>>& _Rings )
+            {
+                auto IsFinished = []( const std::shared_ptr<LogRing>& _Ring )
+                {
+                    return _Ring->IsOrphan.load( std::memory_order_acquire ) &&
+                        _Ring->ReadIndex.load( std::memory_order_relaxed ) == _Ring->WriteIndex.load( std::memory_order_acquire );
+                };
+
+                std::lock_guard<std::mutex> Lock( m_RingsMutex );
+
+                m_Rings.erase( std::remove_if( m_Rings.begin(), m_Rings.end(), IsFinished ), m_Rings.end() );
+                _Rings.erase( std::remove_if( _Rings.begin(), _Rings.end(), IsFinished ), _Rings.end() );
+            }
+
+            void ReadMessage( Log::MessageType _MessageType, const char* _Text, size_t _Length )
+            {
+                const Uint32 RepeatLimit = m_RepeatLimit.load( std::memory_order_relaxed );
+
+                // Errors are always written.
+                if( _MessageType == Log::Error || RepeatLimit == 0 )
+                {
+                    WriteMessage( _MessageType, std::string( _Text, _Length ).c_str() );
+                    return;
+                }
+
+                RepeatedMessage& Repeated = m_RepeatedMessages[HashText( _Text, _Length, Cast( Uint8, _MessageType ) )];
+                Repeated.Count++;
+
+                if( Repeated.Count <= RepeatLimit )
+                    WriteMessage( _MessageType, std::string( _Text, _Length ).c_str() );
+
+                else if( Repeated.Text.empty() )
+                {
+                    Repeated.Type = _MessageType;
+                    Repeated.Text.assign( _Text, _Length );
+                }
+            }
+
+            void UpdateRepeatWindow( Bool _Force )
+            {
+                const std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+
+                if( !_Force && Now - m_RepeatWindowStart < RepeatWindow )
+                    return;
+
+                const Uint32 RepeatLimit = m_RepeatLimit.load( std::memory_order_relaxed );
+
+                for( const auto& Repeated : m_RepeatedMessages )
+                {
+                    if( Repeated.second.Count <= RepeatLimit )
+                        continue;
+
+                    const std::string Text = Repeated.second.Text + "\n\t (repeated " + std::to_string( Repeated.second.Count - RepeatLimit ) + " more times)";
+
+                    WriteMessage( Repeated.second.Type, Text.c_str() );
+                }
+
+                m_RepeatedMessages.clear();
+                m_RepeatWindowStart = Now;
+            }
+
+        private:
+            /// <summary>Thread writing the messages.</summary>
+            std::thread m_Thread;
+
+            /// <summary>The logging thread is started with the first message.</summary>
+            std::once_flag m_StartFlag;
+
+            /// <summary>The logging thread reads the rings.</summary>
+            std::atomic<Bool> m_IsRunning;
+
+            /// <summary>Ask the logging thread to read the rings one last time and exit. Set under m_WakeMutex.</summary>
+            std::atomic<Bool> m_IsStopping;
+
+            /// <summary>The logging thread is stopped or stopping, the messages are written by the calling thread.</summary>
+            std::atomic<Bool> m_IsStopped;
+
+            /// <summary>A flush is waiting. Protected by m_WakeMutex.</summary>
+            Bool m_IsWakeRequested;
+
+            /// <summary>Protect the wake and stop flags.</summary>
+            std::mutex m_WakeMutex;
+
+            /// <summary>Signaled to wake the logging thread before its interval.</summary>
+            std::condition_variable m_WakeCondition;
+
+            /// <summary>Signaled by the logging thread after reading records.</summary>
+            std::condition_variable m_FlushedCondition;
+
+            /// <summary>Rings of the threads that have logged.</summary>
+            std::vector<std::shared_ptr<LogRing>> m_Rings;
+
+            /// <summary>Protect the list of rings.</summary>
+            std::mutex m_RingsMutex;
+
+            /// <summary>Incremented when a ring is added.</summary>
+            std::atomic<Uint32> m_RingsVersion;
+
+            /// <summary>Count of identical messages written each second.</summary>
+            std::atomic<Uint32> m_RepeatLimit;
+
+            /// <summary>Messages received in the current window by hash, logging thread only.</summary>
+            std::unordered_map<Uint64, RepeatedMessage> m_RepeatedMessages;
+
+            /// <summary>Start of the current window, logging thread only.</summary>
+            std::chrono::steady_clock::time_point m_RepeatWindowStart;
+        };
+
+        LogBackend& GetBackend()
+        {
+            static LogBackend Backend;
+            return Backend;
+        }
+    }
+
     void Log::Initialize( Bool _LogInFile )
     {
         //loguru::init( argc, argv );
@@ -16,15 +565,33 @@ namespace ae
     }
 
     void Log::LogMessage( MessageType _MessageType, const std::string& _Message )
-	{
-        loguru::Text StackTrace = loguru::stacktrace( 1 );
+    {
+        GetBackend().Push( _MessageType, _Message.c_str() );
+    }
+
+    void Log::LogMessage( MessageType _MessageType, const char* _Message )
+    {
+        GetBackend().Push( _MessageType, _Message );
+    }
 
-        std::string Message = StackTrace.c_str();
-        Message += std::string( "\n\t " ) + _Message;
+    void Log::Flush()
+    {
+        GetBackend().Flush();
+    }
 
-        int logLevel[3] = { loguru::Verbosity_INFO, loguru::Verbosity_WARNING, loguru::Verbosity_ERROR };
+    void Log::Shutdown()
+    {
+        GetBackend().Stop();
+    }
 
-        VLOG_F( logLevel[_MessageType], Message.c_str() );
-	}
+    void Log::SetRepeatLimit( Uint32 _Count )
+    {
+        GetBackend().SetRepeatLimit( _Count );
+    }
+
+    Uint32 Log::GetRepeatLimit()
+    {
+        return GetBackend().GetRepeatLimit();
+    }
 
-} // ae
\ No newline at end of file
+} // ae
@@ -9,8 +9,12 @@ namespace ae
     /// \ingroup debugging
     /// <summary>
     /// Class that give the possibility to log messages into the console
-    /// and to a file named "log.txt".
-    /// Offer the possibility to get the stack trace. Pdb files are needed to retrieve all infos.
+    /// and to a file named "log.txt".<para/>
+    /// The messages are written by a background thread : the calling thread only copies the message
+    /// in a ring of fixed size records of its own, without lock nor allocation for the short messages.
+    /// When the ring of a thread is full, its messages and warnings are dropped and the count of lost messages is logged.<para/>
+    /// The identical messages logged more than the repeat limit in one second are folded in a single line with their count.<para/>
+    /// The errors get the stack trace of the caller and are written before LogMessage returns. Pdb files are needed to retrieve all infos.
     /// </summary>
     class AERO_CORE_EXPORT Log
     {
@@ -38,6 +42,28 @@ namespace ae
         /// <param name="_Message">Message to log.</param>
         static void LogMessage( MessageType _MessageType, const std::string& _Message );
 
+        /// <summary>Log a message to the console and to log.txt.</summary>
+        /// <param name="_MessageType">Type of the message, can be Message, Warning or Error.</param>
+        /// <param name="_Message">Message to log, null terminated.</param>
+        static void LogMessage( MessageType _MessageType, const char* _Message );
+
+        /// <summary>Wait for the messages logged so far by all the threads to be written.</summary>
+        static void Flush();
+
+        /// <summary>
+        /// Write the pending messages and stop the logging thread.<para/>
+        /// The messages logged after are written directly by the calling thread.
+        /// </summary>
+        static void Shutdown();
+
+        /// <summary>Set how many times an identical message is written each second, the next ones are only counted.</summary>
+        /// <param name="_Count">Count of identical messages written per second, 0 to write them all.</param>
+        static void SetRepeatLimit( Uint32 _Count );
+
+        /// <summary>Get how many times an identical message is written each second.</summary>
+        /// <returns>Count of identical messages written per second, 0 if they are all written.</returns>
+        static Uint32 GetRepeatLimit();
+
     };
 } // ae
 
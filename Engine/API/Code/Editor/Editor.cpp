@@ -41,6 +41,9 @@ namespace ae
 	{
 		m_IsWindowOpen.fill( true );
 
+		m_Viewport.SetPassName( "Viewport" );
+		m_FinalImage.SetPassName( "Final Image" );
+
 		Texture* ViewportColor = m_Viewport.GetAttachementTexture( FramebufferAttachement::Type::Color_0 );
 		if( ViewportColor != nullptr )
 			ViewportColor->SetName( "Viewport Multisample Color Attachement" );
@@ -145,7 +148,7 @@ namespace ae
 			if( Input::IsKeyDown( Input::Key::Keyboard_LeftShift ) )
 				CurrentCamera.SetControlToFPS();
 
-			else if( m_SelectedObject != World::InvalidObjectID )
+			else if( Aero.GetWorld().IsObjectValid( m_SelectedObject ) )
 			{
 				World& WorldRef = Aero.GetWorld();
 
@@ -284,7 +287,7 @@ namespace ae
 
 		World& WorldRef = Aero.GetWorld();
 
-		const std::unordered_map<World::ObjectID, WorldObject*>& Objects = WorldRef.GetObjects();
+		const HandleMap<WorldObject*>& Objects = WorldRef.GetObjects();
 
 		ImGuiTreeNodeFlags Flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_DefaultOpen;
 
@@ -294,12 +297,12 @@ namespace ae
 				m_DetailToShow = DetailToShow::World;
 
 
-			for( const std::pair<World::ObjectID, WorldObject*>& Object : Objects )
+			for( WorldObject* Object : Objects )
 			{
-				if( Object.second->HasParent() )
+				if( Object->HasParent() )
 					continue;
 
-				ShowOutlinerObject( Object.second, Flags );
+				ShowOutlinerObject( Object, Flags );
 			}
 
 			ImGui::TreePop();
@@ -406,6 +409,13 @@ namespace ae
 
 		World& WorldRef = Aero.GetWorld();
 
+		// The selected object may have been destroyed : its ID stays invalid even once its slot is reused.
+		if( !WorldRef.IsObjectValid( m_SelectedObject ) )
+		{
+			m_SelectedObject = World::InvalidObjectID;
+			return;
+		}
+
 		WorldObject* Object = WorldRef.GetObject( m_SelectedObject );
 
 		if( Object == nullptr )
@@ -456,19 +466,22 @@ namespace ae
 
 		ResourcesManager& ResourcesRef = Aero.GetResourcesManager();
 
-		const std::unordered_map<ResourcesManager::ResourceID, Resource*>& ResourcesPairs = ResourcesRef.GetResources();
+		const HandleMap<Resource*>& Resources = ResourcesRef.GetResources();
 
 		ImGuiTreeNodeFlags Flags = ImGuiTreeNodeFlags_Leaf;
 
-		for( const std::pair<ResourcesManager::ResourceID, Resource*>& ResourcePair : ResourcesPairs )
+		for( Uint32 r = 0; r < Resources.GetCount(); r++ )
 		{
-			ImGuiTreeNodeFlags FlagsWithSelection = Flags | ( ( m_SelectedResource == ResourcePair.first ) ? ImGuiTreeNodeFlags_Selected : 0 );
+			const ResourcesManager::ResourceID ResourceID = Resources.GetHandles()[r];
+			const Resource* ResourceRef = Resources.GetValues()[r];
+
+			ImGuiTreeNodeFlags FlagsWithSelection = Flags | ( ( m_SelectedResource == ResourceID ) ? ImGuiTreeNodeFlags_Selected : 0 );
 
-			if( ImGui::TreeNodeEx( (void*)(intptr_t)0, FlagsWithSelection, ResourcePair.second->GetName().c_str() ) )
+			if( ImGui::TreeNodeEx( (void*)(intptr_t)0, FlagsWithSelection, ResourceRef->GetName().c_str() ) )
 			{
 				if( ImGui::IsItemClicked() )
 				{
-					m_SelectedResource = ResourcePair.first;
+					m_SelectedResource = ResourceID;
 					m_DetailToShow = DetailToShow::Resource;
 					m_SelectedObject = World::InvalidObjectID;
 				}
@@ -487,6 +500,12 @@ namespace ae
 
 		World& WorldRef = Aero.GetWorld();
 
+		if( !WorldRef.IsObjectValid( m_SelectedObject ) )
+		{
+			m_SelectedObject = World::InvalidObjectID;
+			return;
+		}
+
 		WorldObject* Object = WorldRef.GetObject( m_SelectedObject );
 
 		if( Object != nullptr )
@@ -500,6 +519,12 @@ namespace ae
 
 		ResourcesManager& ResourcesRef = Aero.GetResourcesManager();
 
+		if( !ResourcesRef.IsResourceValid( m_SelectedResource ) )
+		{
+			m_SelectedResource = ResourcesManager::InvalidResourceID;
+			return;
+		}
+
 		Resource* ResourceRef = ResourcesRef.GetResource( m_SelectedResource );
 
 		if( ResourceRef != nullptr )
@@ -46,6 +46,18 @@ namespace ae
                 ImGui::SliderInt( "Fixed Frame Rate", &FixedFrameRate, 1, 100 );
                 _PhysicsSettings.FixedFrameRate = Cast( Uint32, FixedFrameRate );
 
+                int MaxStepsPerFrame = Cast( int, _PhysicsSettings.MaxStepsPerFrame );
+                ImGui::SliderInt( "Max Steps Per Frame", &MaxStepsPerFrame, 1, 32 );
+                _PhysicsSettings.MaxStepsPerFrame = Cast( Uint32, MaxStepsPerFrame );
+
+                bool Interpolate = _PhysicsSettings.Interpolate;
+                ImGui::Checkbox( "Interpolate", &Interpolate );
+                _PhysicsSettings.Interpolate = Interpolate;
+
+                ImGui::DragFloat( "Sleep Velocity", &_PhysicsSettings.SleepVelocity, 0.01f, 0.0f, std::numeric_limits<float>::max() );
+
+                ImGui::DragFloat( "Sleep Delay", &_PhysicsSettings.SleepDelay, 0.1f, 0.0f, std::numeric_limits<float>::max() );
+
                 ImGui::Separator();
             }
         }
@@ -13,6 +13,7 @@ namespace ae
 		m_UpdateProjectionMatrix( True ),
 		m_UpdateLookAtMatrix( True ),
 		m_LookAtMatrix( Matrix4x4::Identity ),
+		m_UpdateFrustum( True ),
 		m_Near( _Near ),
 		m_Far( _Far ),
 		m_OrbitCenter( Vector3::Zero ),
@@ -49,7 +50,10 @@ namespace ae
 	const Matrix4x4& Camera::GetProjectionMatrix()
 	{
 		if( m_UpdateProjectionMatrix )
+		{
 			UpdateProjectionMatrix();
+			m_UpdateFrustum = True;
+		}
 
 		return m_ProjectionMatrix;
 	}
@@ -62,6 +66,40 @@ namespace ae
 		return m_LookAtMatrix;
 	}
 
+	const Frustum& Camera::GetFrustum()
+	{
+		const Matrix4x4& Projection = GetProjectionMatrix();
+		const Matrix4x4& LookAt = GetLookAtMatrix();
+
+		if( m_UpdateFrustum )
+		{
+			m_Frustum.SetFromMatrix( Projection * LookAt );
+			m_UpdateFrustum = False;
+		}
+
+		return m_Frustum;
+	}
+
+	float Camera::GetPixelWorldSize( const Vector3& _Position, Uint32 _TargetHeight )
+	{
+		const Matrix4x4& Projection = GetProjectionMatrix();
+		const Matrix4x4& LookAt = GetLookAtMatrix();
+
+		// Clip W of the position : the depth for a perspective projection, 1 for an orthographic one.
+		float ClipW = Projection( 3, 3 );
+
+		for( Uint32 c = 0; c < 3; c++ )
+		{
+			const float ViewCoord = LookAt( c, 0 ) * _Position.X + LookAt( c, 1 ) * _Position.Y + LookAt( c, 2 ) * _Position.Z + LookAt( c, 3 );
+			ClipW += Projection( 3, c ) * ViewCoord;
+		}
+
+		// The viewport height covers 2 units in NDC, the projection scales the view height by P(1, 1) / W.
+		const float Scale = Math::Abs( Projection( 1, 1 ) ) * Cast( float, Math::Max( _TargetHeight, 1u ) );
+
+		return 2.0f * Math::Abs( ClipW ) / Math::Max( Scale, Math::Epsilon() );
+	}
+
 	void Camera::SetControlToFree()
 	{
 		m_ControlType = ControlType::Free;
@@ -187,6 +225,7 @@ namespace ae
 		}
 
 		m_UpdateLookAtMatrix = False;
+		m_UpdateFrustum = True;
 	}
 
 } // ae
\ No newline at end of file
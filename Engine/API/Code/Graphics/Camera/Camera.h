@@ -4,6 +4,7 @@
 
 #include "../../Maths/Transform/Transform.h"
 #include "../../Maths/Primitives/TRect.h"
+#include "../../Maths/Primitives/Frustum.h"
 #include "../../Maths/Functions/MathsFunctions.h"
 #include "../../World/WorldObject/WorldObject.h"
 
@@ -86,6 +87,22 @@ namespace ae
 		/// <returns>The current look at matrix of the camera.</returns>
 		const Matrix4x4& GetLookAtMatrix();
 
+		/// <summary>
+		/// Retrieve the frustum of the camera in world space. <para/>
+		/// Rebuilt only when the projection or the look at matrix has changed.
+		/// </summary>
+		/// <returns>The current frustum of the camera.</returns>
+		const Frustum& GetFrustum();
+
+		/// <summary>
+		/// Retrieve the size in world space covered by one pixel at a position. <para/>
+		/// Used to select levels of detail : an error under this size is not visible.
+		/// </summary>
+		/// <param name="_Position">Position in world space.</param>
+		/// <param name="_TargetHeight">Height in pixels of the render target.</param>
+		/// <returns>Height of a pixel at the position, in world units.</returns>
+		float GetPixelWorldSize( const Vector3& _Position, Uint32 _TargetHeight );
+
 
         /// <summary>Set the camera control to ControlType::Free.</summary>
         void SetControlToFree();
@@ -172,6 +189,11 @@ namespace ae
 		/// <summary>Matrix that hold the orientation of the camera.</summary>
 		Matrix4x4 m_LookAtMatrix;
 
+		/// <summary>Signal to know if we must rebuild the frustum from the projection and look at matrices.</summary>
+		Bool m_UpdateFrustum;
+		/// <summary>Frustum of the camera in world space.</summary>
+		Frustum m_Frustum;
+
         /// <summary>Point to look at when camera is set to orbit.</summary>
         Vector3 m_OrbitCenter;
 
@@ -2,6 +2,7 @@
 
 #include "../../Debugging/Debugging.h"
 #include "../Image/Image.h"
+#include "../Image/DecodedImage.h"
 #include "../../Aero/Aero.h"
 
 #include "../../Editor/TypesToEditor/CubeMapToEditor.h"
@@ -10,6 +11,11 @@
 
 namespace ae
 {
+	CubeMapImage::CubeMapImage()
+	{
+		SetPlaceholder();
+	}
+
 	CubeMapImage::CubeMapImage( const std::array<const std::string*, 6>& _FilePaths, Bool _AreHDR )
 	{
 		if( _AreHDR )
@@ -223,6 +229,97 @@ namespace ae
 	}
 
 
+	CubeMapImage::~CubeMapImage()
+	{
+		CancelAsyncLoading();
+	}
+
+	void CubeMapImage::SetAsync( const std::array<std::string, 6>& _FilePaths, Bool _AreHDR )
+	{
+		CancelAsyncLoading();
+
+		// The cube can be bound while the images are loading.
+		SetPlaceholder();
+
+		m_LoadingState = LoadingState::Pending;
+
+		// The decoded pixels are owned by the request, the cube is only touched by the upload on the context thread.
+		std::shared_ptr<std::array<priv::DecodedImage, 6>> Decoded = std::make_shared<std::array<priv::DecodedImage, 6>>();
+
+		m_LoadRequest = Aero.GetAsyncLoader().Load(
+			[Decoded, _FilePaths, _AreHDR]()
+			{
+				for( size_t i = 0; i < 6; i++ )
+				{
+					if( !( *Decoded )[i].LoadFromFile( _FilePaths[i], _AreHDR ) )
+						return;
+				}
+			},
+			[this, Decoded]()
+			{
+				m_LoadRequest = AsyncLoader::InvalidRequestID;
+
+				const priv::DecodedImage* Images[6];
+				for( size_t i = 0; i < 6; i++ )
+				{
+					if( ( *Decoded )[i].GetData() == nullptr )
+					{
+						AE_LogError( ( *Decoded )[i].GetError() );
+						m_LoadingState = LoadingState::Failed;
+						return;
+					}
+
+					Images[i] = &( *Decoded )[i];
+				}
+
+				UpdateDataFromImages( Images );
+
+				m_LoadingState = LoadingState::Ready;
+			} );
+	}
+
+	void CubeMapImage::SetAsync( const std::string& _FilePath, Bool _AreHDR )
+	{
+		CancelAsyncLoading();
+
+		SetPlaceholder();
+
+		m_LoadingState = LoadingState::Pending;
+
+		std::shared_ptr<priv::DecodedImage> Decoded = std::make_shared<priv::DecodedImage>();
+
+		m_LoadRequest = Aero.GetAsyncLoader().Load(
+			[Decoded, _FilePath, _AreHDR]()
+			{
+				Decoded->LoadFromFile( _FilePath, _AreHDR );
+			},
+			[this, Decoded]()
+			{
+				m_LoadRequest = AsyncLoader::InvalidRequestID;
+
+				if( Decoded->GetData() == nullptr )
+				{
+					AE_LogError( Decoded->GetError() );
+					m_LoadingState = LoadingState::Failed;
+					return;
+				}
+
+				const priv::DecodedImage* Images[6] =
+				{
+					Decoded.get(), Decoded.get(), Decoded.get(), Decoded.get(), Decoded.get(), Decoded.get()
+				};
+
+				UpdateDataFromImages( Images );
+
+				m_LoadingState = LoadingState::Ready;
+			} );
+	}
+
+	LoadingState CubeMapImage::GetLoadingState() const
+	{
+		return m_LoadingState;
+	}
+
 	const std::string& CubeMapImage::GetFilePath( Uint32 _Index ) const
 	{
 		if( _Index >= 6 )
@@ -331,4 +428,68 @@ namespace ae
 		SetName( std::string( "CubeMapImage_" ) + std::to_string( GetResourceID() ) );
 	}
 
+	void CubeMapImage::UpdateDataFromImages( const priv::DecodedImage* _ImageSources[6] )
+	{
+		m_Dimension = TextureDimension::CubeMap;
+
+		// Bind the newly created OpenGL texture to apply the next changes.
+		Bind();
+
+		// Texture settings :  repeat ? - pixel interpolation ( smoothing ) ?.
+		glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, Cast( GLint, m_Wrap ) ); AE_ErrorCheckOpenGLError();
+		glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, Cast( GLint, m_Wrap ) ); AE_ErrorCheckOpenGLError();
+		glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, Cast( GLint, m_Wrap ) ); AE_ErrorCheckOpenGLError();
+		glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, Cast( GLint, m_Filter ) ); AE_ErrorCheckOpenGLError();
+		glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, Cast( GLint, m_Filter ) ); AE_ErrorCheckOpenGLError();
+
+		for( size_t i = 0; i < 6; i++ )
+		{
+			const priv::DecodedImage& SideImage = *_ImageSources[i];
+
+			m_FilePath[i] = SideImage.GetFilePath();
+
+			m_Format = SideImage.GetTexturePixelFormat();
+
+			m_Widths[i] = SideImage.GetWidth();
+			m_Heights[i] = SideImage.GetHeight();
+
+			// Atatch each given image to a side of the cube.
+			glTexImage2D( GL_TEXTURE_CUBE_MAP_POSITIVE_X + Cast( GLenum, i ),
+						  0,
+						  ToGLInternalFormat( m_Format ),
+						  m_Widths[i],
+						  m_Heights[i],
+						  0,
+						  ToGLFormat( m_Format ),
+						  ToGLType( m_Format ),
+						  SideImage.GetData() );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		Unbind();
+	}
+
+	void CubeMapImage::SetPlaceholder()
+	{
+		Image WhitePixel( 1, 1, ImageFormat::RGB_Alpha );
+		WhitePixel.SetPixel( 0, Color::White );
+
+		std::reference_wrapper<const Image> Images[6] =
+		{
+			WhitePixel, WhitePixel, WhitePixel, WhitePixel, WhitePixel, WhitePixel
+		};
+
+		UpdateDataFromImages( Images );
+	}
+
+	void CubeMapImage::CancelAsyncLoading()
+	{
+		if( m_LoadRequest == AsyncLoader::InvalidRequestID )
+			return;
+
+		Aero.GetAsyncLoader().Cancel( m_LoadRequest );
+		m_LoadRequest = AsyncLoader::InvalidRequestID;
+		m_LoadingState = LoadingState::Ready;
+	}
+
 } // ae
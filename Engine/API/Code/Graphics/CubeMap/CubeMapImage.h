@@ -5,6 +5,7 @@
 #include "CubeMap.h"
 #include "../Image/Image.h"
 #include "../Image/ImageHDR.h"
+#include "../../Resources/AsyncLoader/AsyncLoader.h"
 
 #include <string>
 #include <array>
@@ -12,6 +13,11 @@
 
 namespace ae
 {
+	namespace priv
+	{
+		class DecodedImage;
+	}
+
 	/// \ingroup graphics
 	/// <summary>
 	/// A texture that make a cube (6 sides).<para>
@@ -24,6 +30,9 @@ namespace ae
 	class AERO_CORE_EXPORT CubeMapImage : public CubeMap
 	{
 	public:
+		/// <summary>Create a cube with one white pixel per side, to fill later with SetAsync.</summary>
+		CubeMapImage();
+
 		/// <summary>
 		/// Create a cube from 6 image files.<para/>
 		/// If there is one or more nullptr path, the function fail.<para/>
@@ -95,6 +104,30 @@ namespace ae
 		/// <param name="_ImageSource">The image source.</param>
 		explicit CubeMapImage( const ImageHDR& _ImageSource );
 
+		/// <summary>Cancel the background loading if the cube is still waiting for it.</summary>
+		virtual ~CubeMapImage();
+
+		/// <summary>
+		/// Load the cube from 6 image files in the background.<para/>
+		/// The sides are white pixels until the images are decoded by the asynchronous loader and uploaded.<para/>
+		/// Order : Right, Left, Top, Bottom, Front, Back.
+		/// </summary>
+		/// <param name="_FilePaths">The images file path.</param>
+		/// <param name="_AreHDR">Are the files HDR images ?</param>
+		void SetAsync( const std::array<std::string, 6>& _FilePaths, Bool _AreHDR = False );
+
+		/// <summary>
+		/// Load the cube from one image file in the background, used for all the sides.<para/>
+		/// The sides are white pixels until the image is decoded by the asynchronous loader and uploaded.
+		/// </summary>
+		/// <param name="_FilePath">The image file path.</param>
+		/// <param name="_AreHDR">Is the file an HDR image ?</param>
+		void SetAsync( const std::string& _FilePath, Bool _AreHDR = False );
+
+		/// <summary>Retrieve the state of the loading started by SetAsync.</summary>
+		/// <returns>Ready if the cube is not loaded in the background.</returns>
+		LoadingState GetLoadingState() const;
+
 
 		/// <summary>
 		/// Path to the loaded image.<para/>
@@ -122,6 +155,16 @@ namespace ae
 		/// <param name="_ImageSources">The image to attach to each side of the cube.</param>
 		void UpdateDataFromImages( std::reference_wrapper<const ImageHDR> _ImageSources[6] );
 
+		/// <summary>Setup the cubemap with 6 images decoded in the background.</summary>
+		/// <param name="_ImageSources">The image to attach to each side of the cube.</param>
+		void UpdateDataFromImages( const priv::DecodedImage* _ImageSources[6] );
+
+		/// <summary>Make each side of the cube one white pixel.</summary>
+		void SetPlaceholder();
+
+		/// <summary>Cancel the background loading if any.</summary>
+		void CancelAsyncLoading();
+
 
 	private:
 		/// <summary>
@@ -130,6 +173,12 @@ namespace ae
 		/// There is path per cube side.
 		/// </summary>
 		std::string m_FilePath[6];
+
+		/// <summary>Request of the background loading, invalid if the cube is not waiting for one.</summary>
+		AsyncLoader::RequestID m_LoadRequest = AsyncLoader::InvalidRequestID;
+
+		/// <summary>State of the background loading.</summary>
+		LoadingState m_LoadingState = LoadingState::Ready;
 	};
 
 } // ae
@@ -6,19 +6,186 @@
 #include "../Material/Material.h"
 #include "../Renderer/Renderer.h"
 #include "../../Toolbox/BitOperations/BitOperations.h"
+#include "../../Maths/Functions/MathsFunctions.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <exception>
 
 namespace ae
 {
+	namespace
+	{
+		/// <summary>Storage of one 3D vertex attribute in a vertex buffer.</summary>
+		struct VertexAttributeLayout
+		{
+			/// <summary>Tag of the attribute.</summary>
+			Drawable::AttributePointer Tag;
+
+			/// <summary>Location of the attribute in the shaders.</summary>
+			GLuint Location;
+
+			/// <summary>Count of components stored.</summary>
+			GLint ComponentsCount;
+
+			/// <summary>Type of the components stored.</summary>
+			GLenum Type;
+
+			/// <summary>Are the integer components mapped to [0, 1] or [-1, 1] ?</summary>
+			GLboolean Normalized;
+
+			/// <summary>Size in bytes of the attribute.</summary>
+			Uint32 Size;
+		};
+
+		/// <summary>Attributes stored in floats, in the order of Vertex3D.</summary>
+		const VertexAttributeLayout FullLayouts[] =
+		{
+			{ Drawable::AttributePointer::Position, 0, 3, GL_FLOAT, GL_FALSE, sizeof( Vector3 ) },
+			{ Drawable::AttributePointer::Color, 1, 4, GL_FLOAT, GL_FALSE, sizeof( Color ) },
+			{ Drawable::AttributePointer::TexCoords, 2, 2, GL_FLOAT, GL_FALSE, sizeof( Vector2 ) },
+			{ Drawable::AttributePointer::Normals, 3, 3, GL_FLOAT, GL_FALSE, sizeof( Vector3 ) }
+		};
+
+		/// <summary>Attributes stored in compact types, unpacked by the vertex fetch.</summary>
+		const VertexAttributeLayout QuantizedLayouts[] =
+		{
+			{ Drawable::AttributePointer::Position, 0, 3, GL_FLOAT, GL_FALSE, sizeof( Vector3 ) },
+			{ Drawable::AttributePointer::Color, 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 * sizeof( Uint8 ) },
+			{ Drawable::AttributePointer::TexCoords, 2, 2, GL_HALF_FLOAT, GL_FALSE, 2 * sizeof( Uint16 ) },
+			{ Drawable::AttributePointer::Normals, 3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof( Uint32 ) }
+		};
+
+		/// <summary>Get the layouts of the attributes for the quantized or full storage.</summary>
+		inline const VertexAttributeLayout* GetAttributeLayouts( Drawable::AttributePointer _Attributes )
+		{
+			return BitOp::BitOpAnd( _Attributes, Drawable::AttributePointer::Quantized ) ? QuantizedLayouts : FullLayouts;
+		}
+
+		/// <summary>Convert a float to a half float, rounded to the nearest.</summary>
+		Uint16 FloatToHalf( float _Value )
+		{
+			Uint32 Bits;
+			std::memcpy( &Bits, &_Value, sizeof( float ) );
+
+			const Uint32 Sign = ( Bits >> 16 ) & 0x8000;
+			const Uint32 Mantissa = Bits & 0x007FFFFF;
+			const Int32 Exponent = Cast( Int32, ( Bits >> 23 ) & 0xFF ) - 127 + 15;
+
+			// Infinity and NaN.
+			if( ( ( Bits >> 23 ) & 0xFF ) == 0xFF )
+				return Cast( Uint16, Sign | 0x7C00 | ( Mantissa != 0 ? 0x0200 : 0 ) );
+
+			// Too large, clamped to infinity.
+			if( Exponent >= 31 )
+				return Cast( Uint16, Sign | 0x7C00 );
+
+			// Too small even for a denormal.
+			if( Exponent < -10 )
+				return Cast( Uint16, Sign );
+
+			// Denormal : the implicit 1 becomes explicit and the mantissa is shifted.
+			if( Exponent <= 0 )
+			{
+				const Uint32 FullMantissa = Mantissa | 0x00800000;
+				const Uint32 Shift = Cast( Uint32, 14 - Exponent );
+				const Uint32 Rounded = ( FullMantissa + ( 1u << ( Shift - 1 ) ) ) >> Shift;
+
+				return Cast( Uint16, Sign | Rounded );
+			}
+
+			// The rounding can carry into the exponent, it stays a valid half (up to infinity).
+			const Uint32 Half = ( Cast( Uint32, Exponent ) << 10 ) | ( Mantissa >> 13 );
+			return Cast( Uint16, Sign | ( Half + ( ( Mantissa >> 12 ) & 1 ) ) );
+		}
+
+		/// <summary>Pack a unit vector in the three signed 10 bits components of a GL_INT_2_10_10_10_REV.</summary>
+		Uint32 PackNormal( const Vector3& _Normal )
+		{
+			auto ToSnorm10 = []( float _Value ) { return Cast( Uint32, Cast( Int32, std::round( Math::Clamp( -1.0f, 1.0f, _Value ) * 511.0f ) ) ) & 0x3FF; };
+
+			return ToSnorm10( _Normal.X ) | ( ToSnorm10( _Normal.Y ) << 10 ) | ( ToSnorm10( _Normal.Z ) << 20 );
+		}
+
+		/// <summary>Convert a color component to an unsigned normalized byte.</summary>
+		inline Uint8 ToUnorm8( float _Value )
+		{
+			return Cast( Uint8, Math::Clamp( 0.0f, 1.0f, _Value ) * 255.0f + 0.5f );
+		}
+
+		/// <summary>Write the attributes of the vertices in the layout of the vertex buffer attributes.</summary>
+		void PackVertices( const Vertex3DArray& _Vertices, Drawable::AttributePointer _Attributes, AE_Out std::vector<Uint8>& _Data )
+		{
+			const Bool IsQuantized = BitOp::BitOpAnd( _Attributes, Drawable::AttributePointer::Quantized );
+			const Bool HasPosition = BitOp::BitOpAnd( _Attributes, Drawable::AttributePointer::Position );
+			const Bool HasColor = BitOp::BitOpAnd( _Attributes, Drawable::AttributePointer::Color );
+			const Bool HasTexCoords = BitOp::BitOpAnd( _Attributes, Drawable::AttributePointer::TexCoords );
+			const Bool HasNormals = BitOp::BitOpAnd( _Attributes, Drawable::AttributePointer::Normals );
+
+			_Data.resize( _Vertices.size() * Drawable::GetVertexSize( _Attributes ) );
+			Uint8* Cursor = _Data.data();
+
+			auto Write = [&Cursor]( const void* _Source, size_t _Size )
+			{
+				std::memcpy( Cursor, _Source, _Size );
+				Cursor += _Size;
+			};
+
+			for( const Vertex3D& Vertex : _Vertices )
+			{
+				if( HasPosition )
+					Write( &Vertex.Position, sizeof( Vector3 ) );
+
+				if( HasColor )
+				{
+					if( IsQuantized )
+					{
+						const Uint8 Color[4] = { ToUnorm8( Vertex.Color.R() ), ToUnorm8( Vertex.Color.G() ), ToUnorm8( Vertex.Color.B() ), ToUnorm8( Vertex.Color.A() ) };
+						Write( Color, sizeof( Color ) );
+					}
+					else
+						Write( &Vertex.Color, sizeof( Color ) );
+				}
+
+				if( HasTexCoords )
+				{
+					if( IsQuantized )
+					{
+						const Uint16 UV[2] = { FloatToHalf( Vertex.UV.X ), FloatToHalf( Vertex.UV.Y ) };
+						Write( UV, sizeof( UV ) );
+					}
+					else
+						Write( &Vertex.UV, sizeof( Vector2 ) );
+				}
+
+				if( HasNormals )
+				{
+					if( IsQuantized )
+					{
+						const Uint32 Normal = PackNormal( Vertex.Normal );
+						Write( &Normal, sizeof( Normal ) );
+					}
+					else
+						Write( &Vertex.Normal, sizeof( Vector3 ) );
+				}
+			}
+		}
+	}
+
 	Drawable::Drawable( BufferType _BufferType, AttributePointer _AttributePointerTags ) :
-		m_IndicesCount( 0 ),
 		m_VerticesCount( 0 ),
+		m_IndicesCount( 0 ),
+		m_FirstIndex( 0 ),
+		m_IndexType( IndexType::UnsignedInt ),
+		m_VertexBufferAttributes( AttributePointer::Default3D ),
 		m_MaterialRef( nullptr ),
 		m_BufferType( _BufferType ),
 		m_AttributePointerTags( _AttributePointerTags ),
 		m_PrimitiveType( PrimitiveType::Triangles ),
-		m_BlendMode( BlendMode::BlendAlpha )
+		m_BlendMode( BlendMode::BlendAlpha ),
+		m_LocalBoundingSphere( Vector3::Zero, -1.0f ),
+		m_IsCullingEnabled( True )
 	{
         if( !Aero.CheckContext() )
             return;
@@ -152,40 +319,23 @@ namespace ae
 		glBindBuffer( GL_ARRAY_BUFFER, m_VertexBufferObject );
 		AE_ErrorCheckOpenGLError();
 
-		// Bind the new data.
-		glBufferData( GL_ARRAY_BUFFER, _Vertices.size() * sizeof( Vertex3D ), _Vertices.data(), Cast( GLenum, m_BufferType ) );
-		AE_ErrorCheckOpenGLError();
-
+		// Bind the new data : the full attributes are Vertex3D as is, the other formats are packed.
+		m_VertexBufferAttributes = m_AttributePointerTags;
 
-		// Update attributes for 3D object.
-
-		// Positions.
-		if( BitOp::BitOpAnd( m_AttributePointerTags, AttributePointer::Position ) )
+		if( m_VertexBufferAttributes == AttributePointer::Default3D )
+			glBufferData( GL_ARRAY_BUFFER, _Vertices.size() * sizeof( Vertex3D ), _Vertices.data(), Cast( GLenum, m_BufferType ) );
+		else
 		{
-			glEnableVertexAttribArray( 0 ); AE_ErrorCheckOpenGLError();
-			glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex3D ), 0 ); AE_ErrorCheckOpenGLError();
+			std::vector<Uint8> PackedVertices;
+			PackVertices( _Vertices, m_VertexBufferAttributes, PackedVertices );
+			glBufferData( GL_ARRAY_BUFFER, PackedVertices.size(), PackedVertices.data(), Cast( GLenum, m_BufferType ) );
 		}
 
-		// Colors.
-		if( BitOp::BitOpAnd( m_AttributePointerTags, AttributePointer::Color ) )
-		{
-			glEnableVertexAttribArray( 1 ); AE_ErrorCheckOpenGLError();
-			glVertexAttribPointer( 1, 4, GL_FLOAT, GL_FALSE, sizeof( Vertex3D ), (GLvoid*)sizeof( Vector3 ) ); AE_ErrorCheckOpenGLError();
-		}
+		AE_ErrorCheckOpenGLError();
 
-		// Tex coords.
-		if( BitOp::BitOpAnd( m_AttributePointerTags, AttributePointer::TexCoords ) )
-		{
-			glEnableVertexAttribArray( 2 ); AE_ErrorCheckOpenGLError();
-			glVertexAttribPointer( 2, 2, GL_FLOAT, GL_FALSE, sizeof( Vertex3D ), (GLvoid*)( sizeof( Vector3 ) + sizeof( Color ) ) ); AE_ErrorCheckOpenGLError();
-		}
 
-		// Normals.
-		if( BitOp::BitOpAnd( m_AttributePointerTags, AttributePointer::Normals ) )
-		{
-			glEnableVertexAttribArray( 3 ); AE_ErrorCheckOpenGLError();
-			glVertexAttribPointer( 3, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex3D ), (GLvoid*)( sizeof( Vector3 ) + sizeof( Color ) + sizeof( Vector2 ) ) ); AE_ErrorCheckOpenGLError();
-		}
+		// Update attributes for 3D object.
+		SetupVertex3DAttributes();
 
 		// Once we have finished, unbind the vertex array object.
 		if( _BindArrayBuffer )
@@ -256,6 +406,7 @@ namespace ae
             return;
 
 		m_IndicesCount = Cast( Uint32, _Indices.size() );
+		m_FirstIndex = 0;
 
 		// If not alrady done, bind the vertex array buffer to apply the next settings to it.
 		if( _BindArrayBuffer )
@@ -268,8 +419,18 @@ namespace ae
 		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ElementsArrayObject );
 		AE_ErrorCheckOpenGLError();
 
-		// Bind the new data.
-		glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_IndicesCount * sizeof( Uint32 ), _Indices.data(), Cast( GLenum, m_BufferType ) );
+		// Bind the new data, in 16 bits when every index fits : half the memory and the bandwidth.
+		const Bool Use16Bits = std::all_of( _Indices.begin(), _Indices.end(), []( Uint32 _Index ) { return _Index <= Math::Max<Uint16>(); } );
+		m_IndexType = Use16Bits ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+
+		if( Use16Bits )
+		{
+			const std::vector<Uint16> ShortIndices( _Indices.begin(), _Indices.end() );
+			glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_IndicesCount * sizeof( Uint16 ), ShortIndices.data(), Cast( GLenum, m_BufferType ) );
+		}
+		else
+			glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_IndicesCount * sizeof( Uint32 ), _Indices.data(), Cast( GLenum, m_BufferType ) );
+
 		AE_ErrorCheckOpenGLError();
 
 		// Once we have finished, unbind the vertex array object.
@@ -281,6 +442,25 @@ namespace ae
 	}
 
 
+	Uint32 Drawable::GetVertexSize( AttributePointer _Attributes )
+	{
+		const VertexAttributeLayout* Layouts = GetAttributeLayouts( _Attributes );
+		Uint32 Size = 0;
+
+		for( Uint32 a = 0; a < 4; a++ )
+		{
+			if( BitOp::BitOpAnd( _Attributes, Layouts[a].Tag ) )
+				Size += Layouts[a].Size;
+		}
+
+		return Size;
+	}
+
+	Drawable::AttributePointer Drawable::GetVertexBufferAttributes() const
+	{
+		return m_VertexBufferAttributes;
+	}
+
 	Uint32 Drawable::GetVertexBufferObject() const
 	{
 		return m_VertexBufferObject;
@@ -304,6 +484,16 @@ namespace ae
 		return m_IndicesCount;
 	}
 
+	Uint32 Drawable::GetFirstIndex() const
+	{
+		return m_FirstIndex;
+	}
+
+	IndexType Drawable::GetIndexType() const
+	{
+		return m_IndexType;
+	}
+
 	Uint32 Drawable::GetPrimitivesCount() const
 	{
 		switch( GetPrimitiveType() )
@@ -419,6 +609,46 @@ namespace ae
 	{
 	}
 
+	Bool Drawable::IsInstanced() const
+	{
+		return False;
+	}
+
+	Uint32 Drawable::GetInstancesCount() const
+	{
+		return 1;
+	}
+
+	const AABB& Drawable::GetLocalBounds() const
+	{
+		return m_LocalBounds;
+	}
+
+	const Sphere& Drawable::GetLocalBoundingSphere() const
+	{
+		return m_LocalBoundingSphere;
+	}
+
+	const AABB& Drawable::GetWorldBounds() const
+	{
+		return m_LocalBounds;
+	}
+
+	const Sphere& Drawable::GetWorldBoundingSphere() const
+	{
+		return m_LocalBoundingSphere;
+	}
+
+	void Drawable::SetCullingEnabled( Bool _Enabled )
+	{
+		m_IsCullingEnabled = _Enabled;
+	}
+
+	Bool Drawable::IsCullingEnabled() const
+	{
+		return m_IsCullingEnabled;
+	}
+
 	void Drawable::OnDrawBegin( Renderer& ) const
 	{
 	}
@@ -436,4 +666,45 @@ namespace ae
 		}
 	}
 
+	void Drawable::SetLocalBounds( const AABB& _Bounds )
+	{
+		m_LocalBounds = _Bounds;
+		m_LocalBoundingSphere = _Bounds.GetBoundingSphere();
+
+		OnLocalBoundsChanged();
+	}
+
+	void Drawable::OnLocalBoundsChanged()
+	{
+		// To fill in subclasses if needed.
+	}
+
+	void Drawable::SetupVertex3DAttributes()
+	{
+		const VertexAttributeLayout* Layouts = GetAttributeLayouts( m_VertexBufferAttributes );
+		const GLsizei Stride = Cast( GLsizei, GetVertexSize( m_VertexBufferAttributes ) );
+		Uint32 Offset = 0;
+
+		for( Uint32 a = 0; a < 4; a++ )
+		{
+			const VertexAttributeLayout& Layout = Layouts[a];
+
+			// Only the attributes stored in the buffer take space, an attribute must be stored to be enabled.
+			const Bool IsStored = BitOp::BitOpAnd( m_VertexBufferAttributes, Layout.Tag );
+
+			if( IsStored && BitOp::BitOpAnd( m_AttributePointerTags, Layout.Tag ) )
+			{
+				glEnableVertexAttribArray( Layout.Location ); AE_ErrorCheckOpenGLError();
+				glVertexAttribPointer( Layout.Location, Layout.ComponentsCount, Layout.Type, Layout.Normalized, Stride, (GLvoid*)Cast( size_t, Offset ) ); AE_ErrorCheckOpenGLError();
+			}
+			else
+			{
+				glDisableVertexAttribArray( Layout.Location ); AE_ErrorCheckOpenGLError();
+			}
+
+			if( IsStored )
+				Offset += Layout.Size;
+		}
+	}
+
 } // ae
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "../Primitives/PrimitivesType.h"
 #include "../Material/Material.h"
 #include "../BlendMode/BlendMode.h"
+#include "../../Maths/Primitives/AABB.h"
+#include "../../Maths/Primitives/Sphere.h"
 
 #include "../../World/WorldObject/WorldObject.h"
 
@@ -43,7 +45,12 @@ namespace ae
 			Default = Static
 		};
 
-		/// <summary>Enum used to specify which attribute pointer must be activated.</summary>
+		/// <summary>
+		/// Enum used to specify which attribute pointer must be activated.<para/>
+		/// The tags are also the vertex format of the 3D drawables : only the attributes tagged are stored in the vertex buffer,
+		/// tightly packed in the order position, color, UV, normal. With <c>Quantized</c>, the color is stored as RGBA8,
+		/// the UV as half floats and the normal as packed 10 bits components, the shaders read them without any change.
+		/// </summary>
 		enum class AttributePointer : Uint8
 		{
 			/// <summary>No attribute to activate.</summary>
@@ -61,9 +68,15 @@ namespace ae
 			/// <summary>Correspond to the vertex normals attribute.</summary>
 			Normals = TexCoords << 1,
 
-			/// <summary>Default attributes for 3D drawables.</summary>
+			/// <summary>Store the color, UV and normal attributes in compact types. The position stays in floats.</summary>
+			Quantized = Normals << 1,
+
+			/// <summary>Default attributes for 3D drawables, 48 bytes per vertex : same layout as Vertex3D.</summary>
 			Default3D = Position | Color | TexCoords | Normals,
 
+			/// <summary>All the 3D attributes quantized, 24 bytes per vertex.</summary>
+			Compact3D = Default3D | Quantized,
+
 			/// <summary>Default attributes for 2D drawables.</summary>
 			Default2D = Position | Color | TexCoords,
 
@@ -131,6 +144,15 @@ namespace ae
 		/// <param name="_BindArrayBuffer">Need to bind the vertex array buffer ?</param>
 		void UpdateIndicesBuffer( const IndexArray& _Indices, Bool _BindArrayBuffer = True );
 
+		/// <summary>Get the size of one vertex stored in a vertex buffer with some attributes.</summary>
+		/// <param name="_Attributes">Attributes stored, with or without <c>Quantized</c>.</param>
+		/// <returns>Size in bytes of one vertex.</returns>
+		static Uint32 GetVertexSize( AttributePointer _Attributes );
+
+		/// <summary>Get the attributes stored in the vertex buffer, the format of the buffer.</summary>
+		/// <returns>Attributes stored in the vertex buffer of 3D vertices.</returns>
+		AttributePointer GetVertexBufferAttributes() const;
+
 		/// <summary>Get the OpenGL vertex buffer ID.</summary>
 		/// <returns>ID of OpenGL vertex buffer of the mesh.</returns>
 		Uint32 GetVertexBufferObject() const;
@@ -152,6 +174,14 @@ namespace ae
 		/// <returns>Count of indices in the current indices buffer.</returns>
 		Uint32 GetIndicesCount() const;
 
+		/// <summary>Get the first index drawn, the drawable can use only a range of its indices buffer.</summary>
+		/// <returns>Position of the first index to draw in the indices buffer.</returns>
+		Uint32 GetFirstIndex() const;
+
+		/// <summary>Get the type of the values in the indices buffer.</summary>
+		/// <returns>16 bits when the indices allow it, 32 bits otherwise.</returns>
+		IndexType GetIndexType() const;
+
 		/// <summary>Get the number of primitives (triangles, quads or lines) of the drawable.</summary>
 		/// <returns>The current primitives count.</returns>
 		Uint32 GetPrimitivesCount() const;
@@ -235,6 +265,47 @@ namespace ae
 		/// <param name="_Shader">Shader to send the parameters to.</param>
 		virtual void SendTransformToShader( const Shader& _Shader ) const;
 
+		/// <summary>
+		/// Is the drawable rendered with instancing ?<para/>
+		/// If so, the renderer uses the instanced shader of the material and draws GetInstancesCount() instances in one call.
+		/// </summary>
+		/// <returns>True if the drawable is instanced, False otherwise.</returns>
+		virtual Bool IsInstanced() const;
+
+		/// <summary>Get the count of instances to draw.</summary>
+		/// <returns>Count of instances of the drawable, 1 for non instanced drawables.</returns>
+		virtual Uint32 GetInstancesCount() const;
+
+		/// <summary>
+		/// Retrieve the box containing the vertices of the drawable, in its local space.<para/>
+		/// Invalid until the bounds are computed : such a drawable is never culled.
+		/// </summary>
+		/// <returns>The local bounding box of the drawable.</returns>
+		const AABB& GetLocalBounds() const;
+
+		/// <summary>Retrieve the sphere containing the local bounding box of the drawable.</summary>
+		/// <returns>The local bounding sphere of the drawable. Radius of -1 if the bounds are invalid.</returns>
+		const Sphere& GetLocalBoundingSphere() const;
+
+		/// <summary>Retrieve the box containing the drawable in world space. Same as the local bounds for non transformable drawables.</summary>
+		/// <returns>The world bounding box of the drawable.</returns>
+		virtual const AABB& GetWorldBounds() const;
+
+		/// <summary>Retrieve the sphere containing the drawable in world space. Same as the local sphere for non transformable drawables.</summary>
+		/// <returns>The world bounding sphere of the drawable.</returns>
+		virtual const Sphere& GetWorldBoundingSphere() const;
+
+		/// <summary>
+		/// Can the renderer skip the drawable when its bounds are out of the camera frustum ?<para/>
+		/// Disable it for drawables moving their vertices out of their bounds in the shaders.
+		/// </summary>
+		/// <param name="_Enabled">True to allow the culling, False to always draw the drawable.</param>
+		void SetCullingEnabled( Bool _Enabled );
+
+		/// <summary>Can the renderer skip the drawable when its bounds are out of the camera frustum ?</summary>
+		/// <returns>True if the drawable can be culled, False otherwise.</returns>
+		Bool IsCullingEnabled() const;
+
 		/// <summary>Event call at the beggining of the draw function of the renderer.</summary>
 		/// <param name="_Renderer">The renderer used to draw this object.</param>
 		virtual void OnDrawBegin( Renderer& _Renderer ) const;
@@ -247,6 +318,19 @@ namespace ae
 		/// <summary>Free the memory of the material hold if it is an instance.</summary>
 		void DeleteInstanceMaterial();
 
+		/// <summary>
+		/// Enable the attributes of 3D vertices activated in the attribute pointer tags, with the layout of the vertex buffer attributes.<para/>
+		/// The vertex array and the vertex buffer must be bound before calling this function.
+		/// </summary>
+		void SetupVertex3DAttributes();
+
+		/// <summary>Set the box containing the vertices in local space and update the local bounding sphere.</summary>
+		/// <param name="_Bounds">The new local bounds.</param>
+		void SetLocalBounds( const AABB& _Bounds );
+
+		/// <summary>Alert subclasses of changement of the local bounds.</summary>
+		virtual void OnLocalBoundsChanged();
+
 	protected:
 
 		/// <summary>OpenGL vertex buffer. Hold data of vertex and elements buffers.</summary>
@@ -264,6 +348,15 @@ namespace ae
 		/// <summary>Save of the indices count for rendering purpose.</summary>
 		Uint32 m_IndicesCount;
 
+		/// <summary>Position of the first index to draw, for the drawables using a range of their indices (levels of detail).</summary>
+		Uint32 m_FirstIndex;
+
+		/// <summary>Type of the values in the indices buffer.</summary>
+		IndexType m_IndexType;
+
+		/// <summary>Attributes stored in the vertex buffer of 3D vertices, they give its layout.</summary>
+		AttributePointer m_VertexBufferAttributes;
+
 		/// <summary>The drawable material.</summary>
 		Material* m_MaterialRef;
 
@@ -278,6 +371,15 @@ namespace ae
 
 		/// <summary>Blend setting for rendering.</summary>
 		BlendMode m_BlendMode;
+
+		/// <summary>Box containing the vertices in local space.</summary>
+		AABB m_LocalBounds;
+
+		/// <summary>Sphere containing the local bounding box.</summary>
+		Sphere m_LocalBoundingSphere;
+
+		/// <summary>Can the renderer skip the drawable when it is out of the camera frustum ?</summary>
+		Bool m_IsCullingEnabled;
 	};
 
 } // ae
@@ -4,10 +4,58 @@
 
 namespace ae
 {
+	TransformableDrawable3D::TransformableDrawable3D() :
+		m_WorldBoundingSphere( Vector3::Zero, -1.0f ),
+		m_UpdateWorldBounds( True ),
+		m_WorldBoundsVersion( 0 )
+	{
+		AttachTransform( *this );
+	}
+
 	void TransformableDrawable3D::SendTransformToShader( const Shader& _Shader ) const
 	{
-		const std::string ModelParameterName = Material::GetDefaultParameterName( Material::DefaultParameters::Model3DMatrix );
-		_Shader.SetMatrix4x4( _Shader.GetUniformLocation( ModelParameterName ), const_cast<TransformableDrawable3D*>( this )->GetMatrix() );
+		const std::string& ModelParameterName = Material::GetDefaultParameterName( Material::DefaultParameters::Model3DMatrix );
+		_Shader.SetMatrix4x4( _Shader.GetUniformLocation( ModelParameterName ), GetWorldMatrix() );
+	}
+
+	const AABB& TransformableDrawable3D::GetWorldBounds() const
+	{
+		UpdateWorldBounds();
+
+		return m_WorldBounds;
+	}
+
+	const Sphere& TransformableDrawable3D::GetWorldBoundingSphere() const
+	{
+		UpdateWorldBounds();
+
+		return m_WorldBoundingSphere;
+	}
+
+	void TransformableDrawable3D::OnTransformChanged()
+	{
+		m_UpdateWorldBounds = True;
+		MarkTransformDirty();
+	}
+
+	void TransformableDrawable3D::OnLocalBoundsChanged()
+	{
+		m_UpdateWorldBounds = True;
+	}
+
+	void TransformableDrawable3D::UpdateWorldBounds() const
+	{
+		// A parent may have moved without changing the transform of this drawable.
+		const Uint32 WorldVersion = GetWorldMatrixVersion();
+
+		if( !m_UpdateWorldBounds && WorldVersion == m_WorldBoundsVersion )
+			return;
+
+		m_WorldBounds = m_LocalBounds.GetTransformed( GetWorldMatrix() );
+		m_WorldBoundingSphere = m_WorldBounds.GetBoundingSphere();
+
+		m_UpdateWorldBounds = False;
+		m_WorldBoundsVersion = WorldVersion;
 	}
 
 } // ae
\ No newline at end of file
@@ -14,12 +14,47 @@ namespace ae
 	class AERO_CORE_EXPORT TransformableDrawable3D : public Transform, public Drawable
 	{
 	public:
+		/// <summary>Build a transformable drawable, with the world bounds to compute. Its transform is added to the world hierarchy.</summary>
+		TransformableDrawable3D();
+
 		/// <summary>
 		/// Send the transform (3x3 matrix for TransformableDrawable2D, 4x4 matrix for TransformableDrawable3D) to the shader.
 		/// The shader must be bound before calling this function.
 		/// </summary>
 		/// <param name="_Shader">Shader to send the parameters to.</param>
 		void SendTransformToShader( const Shader& _Shader ) const override;
+
+		/// <summary>Retrieve the box containing the drawable in world space, recomputed only after a change of the transform or of the local bounds.</summary>
+		/// <returns>The world bounding box of the drawable.</returns>
+		const AABB& GetWorldBounds() const override;
+
+		/// <summary>Retrieve the sphere containing the world bounding box of the drawable.</summary>
+		/// <returns>The world bounding sphere of the drawable.</returns>
+		const Sphere& GetWorldBoundingSphere() const override;
+
+	protected:
+		/// <summary>Flag the world bounds and the world matrix to be recomputed.</summary>
+		void OnTransformChanged() override;
+
+		/// <summary>Flag the world bounds to be recomputed.</summary>
+		void OnLocalBoundsChanged() override;
+
+	private:
+		/// <summary>Compute the world bounds from the local bounds and the transform if needed.</summary>
+		void UpdateWorldBounds() const;
+
+	private:
+		/// <summary>Cache of the local bounds transformed to world space.</summary>
+		mutable AABB m_WorldBounds;
+
+		/// <summary>Cache of the sphere containing the world bounds.</summary>
+		mutable Sphere m_WorldBoundingSphere;
+
+		/// <summary>Must the world bounds be recomputed ?</summary>
+		mutable Bool m_UpdateWorldBounds;
+
+		/// <summary>Version of the world matrix the world bounds were computed with.</summary>
+		mutable Uint32 m_WorldBoundsVersion;
 	};
 
 } // ae
@@ -16,7 +16,8 @@ namespace ae
 	Framebuffer::Framebuffer( Uint32 _Width, Uint32 _Height, AttachementPreset _Preset ) :
 		m_FramebufferID( 0 ),
 		m_Width( _Width ),
-		m_Height( _Height )
+		m_Height( _Height ),
+		m_PassName( "Framebuffer" )
 	{
 		CreateFramebuffer();
 		Create( _Preset );
@@ -26,7 +27,8 @@ namespace ae
 	Framebuffer::Framebuffer( Uint32 _Width, Uint32 _Height, const FramebufferAttachement& _Attachement ) :
 		m_FramebufferID( 0 ),
 		m_Width( _Width ),
-		m_Height( _Height )
+		m_Height( _Height ),
+		m_PassName( "Framebuffer" )
 	{
 		CreateFramebuffer();
 		Create( { _Attachement } );
@@ -36,7 +38,8 @@ namespace ae
 	Framebuffer::Framebuffer( Uint32 _Width, Uint32 _Height, std::initializer_list<FramebufferAttachement> _Attachements ) :
 		m_FramebufferID( 0 ),
 		m_Width( _Width ),
-		m_Height( _Height )
+		m_Height( _Height ),
+		m_PassName( "Framebuffer" )
 	{
 		CreateFramebuffer();
 
@@ -86,6 +89,8 @@ namespace ae
 
 	void Framebuffer::Unbind()
 	{
+		AE_ErrorCheckOpenGLCheckpoint( m_PassName.c_str() );
+
 		// Remove this framebuffer from the bound heap.
 		m_BoundFramebuffers.pop();
 
@@ -106,6 +111,16 @@ namespace ae
 		return m_Height;
 	}
 
+	void Framebuffer::SetPassName( const std::string& _PassName )
+	{
+		m_PassName = _PassName;
+	}
+
+	const std::string& Framebuffer::GetPassName() const
+	{
+		return m_PassName;
+	}
+
 
 	Uint32 Framebuffer::GetAttachementTextureID( FramebufferAttachement::Type _Type ) const
 	{
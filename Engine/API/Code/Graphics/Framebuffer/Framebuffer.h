@@ -142,6 +142,14 @@ namespace ae
 		/// <returns>Height of the framebuffer texture.</returns>
 		Uint32 GetHeight() const override;
 
+		/// <summary>Set the name of the pass drawn in the framebuffer, given to the OpenGL error checks when it is unbound.</summary>
+		/// <param name="_PassName">The new name of the pass.</param>
+		void SetPassName( const std::string& _PassName );
+
+		/// <summary>Retrieve the name of the pass drawn in the framebuffer.</summary>
+		/// <returns>The name of the pass.</returns>
+		const std::string& GetPassName() const;
+
 		/// <summary>Get the OpenGL ID of the attachement texture.</summary>
 		/// <param name="_Type">Attachement to retrieve the texture ID from.</param>
 		/// <returns>
@@ -242,6 +250,9 @@ namespace ae
 		/// <summary>Height of the framebuffer.</summary>
 		Uint32 m_Height;
 
+		/// <summary>Name of the pass drawn in the framebuffer, for the error checks.</summary>
+		std::string m_PassName;
+
 		/// <summary>Track of all current bound FBO.</summary>
 		static std::stack<Uint32> m_BoundFramebuffers;
 	};
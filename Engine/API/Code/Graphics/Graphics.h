@@ -72,6 +72,7 @@
 #include "Mesh/3D/SphereMesh.h"
 #include "Mesh/3D/PlaneMesh.h"
 #include "Mesh/3D/CurveMesh.h"
+#include "Mesh/3D/InstancedMesh.h"
 
 #include "Mesh/2D/Mesh2D.h"
 #include "Mesh/2D/QuadMesh.h"
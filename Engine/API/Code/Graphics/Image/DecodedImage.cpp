@@ -0,0 +1,131 @@
+#include "DecodedImage.h"
+
+#include "../STBImageHelper/STBImageHelper.h"
+
+namespace ae
+{
+	namespace priv
+	{
+		DecodedImage::DecodedImage() :
+			m_Pixels( nullptr ),
+			m_IsHDR( False ),
+			m_Width( 0 ),
+			m_Height( 0 ),
+			m_ChannelsCount( 0 )
+		{
+		}
+
+		DecodedImage::~DecodedImage()
+		{
+			Free();
+		}
+
+		Bool DecodedImage::LoadFromFile( const std::string& _FileName, Bool _IsHDR )
+		{
+			Free();
+
+			Int32 Width = 0;
+			Int32 Height = 0;
+			Int32 ChannelsCount = 0;
+
+			m_IsHDR = _IsHDR;
+			if( _IsHDR )
+				m_Pixels = STBLoadFileFloat( Width, Height, ChannelsCount, _FileName );
+			else
+				m_Pixels = STBLoadFileUint8( Width, Height, ChannelsCount, _FileName );
+
+			if( m_Pixels == nullptr || !Width || !Height )
+			{
+				m_Error = std::string( "Failed to load " ) + _FileName + std::string( " Reason : " ) + STBGetFailureReason();
+				Free();
+				return False;
+			}
+
+			// Same limit as Image and ImageHDR.
+			if( Width > 4096 || Height > 4096 )
+			{
+				m_Error = "Failed to load " + _FileName + " Reason : Picture' size bigger than 4096";
+				Free();
+				return False;
+			}
+
+			m_Width = Cast( Uint32, Width );
+			m_Height = Cast( Uint32, Height );
+			m_ChannelsCount = Cast( Uint32, ChannelsCount );
+			m_FilePath = _FileName;
+			m_Error.clear();
+
+			return True;
+		}
+
+		const void* DecodedImage::GetData() const
+		{
+			return m_Pixels;
+		}
+
+		Uint32 DecodedImage::GetWidth() const
+		{
+			return m_Width;
+		}
+
+		Uint32 DecodedImage::GetHeight() const
+		{
+			return m_Height;
+		}
+
+		TexturePixelFormat DecodedImage::GetTexturePixelFormat() const
+		{
+			switch( m_ChannelsCount )
+			{
+			case 1:
+				return m_IsHDR ? TexturePixelFormat::Red_F32 : TexturePixelFormat::Red_U8;
+
+			case 2:
+				return m_IsHDR ? TexturePixelFormat::RedGreen_F32 : TexturePixelFormat::RedGreen_U8;
+
+			case 3:
+				return m_IsHDR ? TexturePixelFormat::RGB_F32 : TexturePixelFormat::RGB_U8;
+
+			case 4:
+				return m_IsHDR ? TexturePixelFormat::RGBA_F32 : TexturePixelFormat::RGBA_U8;
+
+			default:
+				return TexturePixelFormat::Unknown;
+			}
+		}
+
+		const std::string& DecodedImage::GetFilePath() const
+		{
+			return m_FilePath;
+		}
+
+		const std::string& DecodedImage::GetError() const
+		{
+			return m_Error;
+		}
+
+		void DecodedImage::Free()
+		{
+			if( m_Pixels == nullptr )
+				return;
+
+			if( m_IsHDR )
+			{
+				float* Pixels = Cast( float*, m_Pixels );
+				STBFreeImage( Pixels );
+			}
+			else
+			{
+				Uint8* Pixels = Cast( Uint8*, m_Pixels );
+				STBFreeImage( Pixels );
+			}
+
+			m_Pixels = nullptr;
+			m_Width = 0;
+			m_Height = 0;
+			m_ChannelsCount = 0;
+		}
+
+	} // priv
+
+} // ae
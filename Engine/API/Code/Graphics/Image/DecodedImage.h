@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../../Toolbox/Toolbox.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+#include "../Texture/TexturePixelFormat.h"
+
+#include <string>
+
+namespace ae
+{
+	namespace priv
+	{
+		/// \ingroup graphics
+		/// <summary>
+		/// Pixels decoded from an image file, without resource nor OpenGL object.<para/>
+		/// Unlike Image and ImageHDR, it can be loaded from any thread and is used by the asynchronous loading
+		/// to decode on a worker thread then upload on the context thread.
+		/// </summary>
+		/// <seealso cref="AsyncLoader" />
+		class AERO_CORE_EXPORT DecodedImage : public NotCopiable
+		{
+		public:
+			/// <summary>Build an empty image.</summary>
+			DecodedImage();
+
+			/// <summary>Free the pixels.</summary>
+			~DecodedImage();
+
+			/// <summary>Decode an image file. Doesn't log, the error can be retrieved with GetError.</summary>
+			/// <param name="_FileName">Image file to decode.</param>
+			/// <param name="_IsHDR">Decode as floating pixels ?</param>
+			/// <returns>True if the file has been decoded, False otherwise.</returns>
+			Bool LoadFromFile( const std::string& _FileName, Bool _IsHDR );
+
+			/// <summary>Get the raw pixels, 8 bits or float depending on the format.</summary>
+			/// <returns>The pixels.</returns>
+			const void* GetData() const;
+
+			/// <summary>Get the width of the image.</summary>
+			/// <returns>Width of the image.</returns>
+			Uint32 GetWidth() const;
+
+			/// <summary>Get the height of the image.</summary>
+			/// <returns>Height of the image.</returns>
+			Uint32 GetHeight() const;
+
+			/// <summary>Get the texture format matching the pixels.</summary>
+			/// <returns>Texture format of the image.</returns>
+			TexturePixelFormat GetTexturePixelFormat() const;
+
+			/// <summary>Get the path of the decoded file.</summary>
+			/// <returns>Path of the file.</returns>
+			const std::string& GetFilePath() const;
+
+			/// <summary>Get the reason of the last failed decode.</summary>
+			/// <returns>Error message, empty if the decode succeeded.</returns>
+			const std::string& GetError() const;
+
+		private:
+			/// <summary>Free the pixels.</summary>
+			void Free();
+
+		private:
+			/// <summary>Pixels allocated by the decoder.</summary>
+			void* m_Pixels;
+
+			/// <summary>Are the pixels floats ?</summary>
+			Bool m_IsHDR;
+
+			/// <summary>Width of the image.</summary>
+			Uint32 m_Width;
+
+			/// <summary>Height of the image.</summary>
+			Uint32 m_Height;
+
+			/// <summary>Count of channels per pixel.</summary>
+			Uint32 m_ChannelsCount;
+
+			/// <summary>Path of the decoded file.</summary>
+			std::string m_FilePath;
+
+			/// <summary>Reason of the last failed decode.</summary>
+			std::string m_Error;
+		};
+
+	} // priv
+
+} // ae
@@ -4,6 +4,7 @@
 #include "../../Maths/Functions/MathsFunctions.h"
 #include "../../Editor/TypesToEditor/LightToEditor.h"
 
+#include <cstdio>
 
 namespace ae
 {
@@ -55,4 +56,26 @@ namespace ae
         priv::ui::LightToEditor( *this );
     }
 
+
+    Light::UniformName::UniformName( const std::string& _ArrayName, Uint32 _Index )
+    {
+        // Room for the index and the longest member name.
+        m_Name.reserve( _ArrayName.size() + 32 );
+
+        char Index[16];
+        std::snprintf( Index, sizeof( Index ), "[%u]", _Index );
+
+        m_Name.append( _ArrayName.c_str(), _ArrayName.size() );
+        m_Name.append( Index );
+        m_PrefixSize = m_Name.size();
+    }
+
+    const char* Light::UniformName::Get( const char* _Member )
+    {
+        m_Name.resize( m_PrefixSize );
+        m_Name.append( _Member );
+
+        return m_Name.c_str();
+    }
+
 } // ae
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../../Maths/Transform/Transform.h"
 #include "../Color/Color.h"
 #include "../../World/WorldObject/WorldObject.h"
+#include "../../Toolbox/FrameAllocator/FrameAllocator.h"
 
 namespace ae
 {
@@ -73,6 +74,32 @@ namespace ae
         /// </summary>
         virtual void ToEditor() override;
 
+	protected:
+		/// <summary>
+		/// Build the names of the members of a light in a uniform array ("PointLights[2].Color").<para/>
+		/// The name lives in the frame arena, sending the lights each draw does not allocate.
+		/// </summary>
+		class AERO_CORE_EXPORT UniformName
+		{
+		public:
+			/// <summary>Build the name of the light in the array.</summary>
+			/// <param name="_ArrayName">The light array name in the shader.</param>
+			/// <param name="_Index">The index in the array of the light.</param>
+			UniformName( const std::string& _ArrayName, Uint32 _Index );
+
+			/// <summary>Get the name of a member of the light.</summary>
+			/// <param name="_Member">Name of the member, with its dot (".Color").</param>
+			/// <returns>The full name, valid until the next call.</returns>
+			const char* Get( const char* _Member );
+
+		private:
+			/// <summary>Name of the light in the array, followed by the last member asked.</summary>
+			FrameString m_Name;
+
+			/// <summary>Size of the name of the light in the array.</summary>
+			size_t m_PrefixSize;
+		};
+
 	protected:
 		/// <summary>Light color.</summary>
 		Color m_Color;
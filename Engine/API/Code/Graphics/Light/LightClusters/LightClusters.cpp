@@ -0,0 +1,505 @@
+#include "LightClusters.h"
+
+#include "../Lights.h"
+#include "../../Camera/Camera.h"
+#include "../../Shader/Shader.h"
+#include "../../Material/Material.h"
+#include "../../Dependencies/OpenGL.h"
+#include "../../../World/World.h"
+#include "../../../Maths/Vector/Vector2.h"
+#include "../../../Maths/Functions/MathsFunctions.h"
+#include "../../../Debugging/Debugging.h"
+#include "../../../Aero/Aero.h"
+
+namespace ae
+{
+	/// <summary>Under this count of lights, the binning stays on the calling thread.</summary>
+	static constexpr size_t MinLightsForWorkers = 32;
+
+	/// <summary>Unproject a point from normalized device coordinates to view space.</summary>
+	/// <param name="_InverseProjection">Inverse of the camera projection.</param>
+	/// <param name="_X">NDC X coordinate.</param>
+	/// <param name="_Y">NDC Y coordinate.</param>
+	/// <param name="_Z">NDC Z coordinate.</param>
+	/// <returns>The point in view space.</returns>
+	static Vector3 UnprojectNDC( const Matrix4x4& _InverseProjection, float _X, float _Y, float _Z )
+	{
+		const float* const M = _InverseProjection.GetData();
+
+		const float X = M[Matrix4x4::R0C0] * _X + M[Matrix4x4::R0C1] * _Y + M[Matrix4x4::R0C2] * _Z + M[Matrix4x4::R0C3];
+		const float Y = M[Matrix4x4::R1C0] * _X + M[Matrix4x4::R1C1] * _Y + M[Matrix4x4::R1C2] * _Z + M[Matrix4x4::R1C3];
+		const float Z = M[Matrix4x4::R2C0] * _X + M[Matrix4x4::R2C1] * _Y + M[Matrix4x4::R2C2] * _Z + M[Matrix4x4::R2C3];
+		const float W = M[Matrix4x4::R3C0] * _X + M[Matrix4x4::R3C1] * _Y + M[Matrix4x4::R3C2] * _Z + M[Matrix4x4::R3C3];
+
+		return Vector3( X / W, Y / W, Z / W );
+	}
+
+	/// <summary>Check if a sphere overlaps an axis aligned box.</summary>
+	/// <param name="_Center">Center of the sphere.</param>
+	/// <param name="_Radius">Radius of the sphere.</param>
+	/// <param name="_Min">Minimum corner of the box.</param>
+	/// <param name="_Max">Maximum corner of the box.</param>
+	/// <returns>True if the sphere and the box overlap.</returns>
+	static Bool SphereIntersectsBox( const Vector3& _Center, float _Radius, const Vector3& _Min, const Vector3& _Max )
+	{
+		const float DX = Math::Max( 0.0f, Math::Max( _Min.X - _Center.X, _Center.X - _Max.X ) );
+		const float DY = Math::Max( 0.0f, Math::Max( _Min.Y - _Center.Y, _Center.Y - _Max.Y ) );
+		const float DZ = Math::Max( 0.0f, Math::Max( _Min.Z - _Center.Z, _Center.Z - _Max.Z ) );
+
+		return ( DX * DX + DY * DY + DZ * DZ ) <= _Radius * _Radius;
+	}
+
+
+	LightClusters::LightClusters( Uint32 _CountX, Uint32 _CountY, Uint32 _CountZ ) :
+		m_CountX( 1 ),
+		m_CountY( 1 ),
+		m_CountZ( 1 ),
+		m_WorkersCount( 0 ),
+		m_Near( 0.1f ),
+		m_Far( 100.0f ),
+		m_SliceScale( 0.0f ),
+		m_SliceBias( 0.0f ),
+		m_MustRebuild( True ),
+		m_LastCamera( nullptr ),
+		m_BufferIDs( { 0, 0, 0, 0 } ),
+		m_TextureIDs( { 0, 0, 0, 0 } )
+	{
+		SetGridSize( _CountX, _CountY, _CountZ );
+	}
+
+	LightClusters::~LightClusters()
+	{
+		FreeGPUResources();
+	}
+
+	void LightClusters::SetGridSize( Uint32 _CountX, Uint32 _CountY, Uint32 _CountZ )
+	{
+		if( _CountX == 0 || _CountY == 0 || _CountZ == 0 )
+		{
+			AE_LogError( "Invalid light clusters grid size, every dimension must be at least 1." );
+			return;
+		}
+
+		m_CountX = _CountX;
+		m_CountY = _CountY;
+		m_CountZ = _CountZ;
+
+		m_Cells.assign( GetClustersCount(), Cell{ 0, 0, 0, 0 } );
+		m_Bounds.clear();
+
+		m_MustRebuild = True;
+	}
+
+	Uint32 LightClusters::GetCountX() const
+	{
+		return m_CountX;
+	}
+
+	Uint32 LightClusters::GetCountY() const
+	{
+		return m_CountY;
+	}
+
+	Uint32 LightClusters::GetCountZ() const
+	{
+		return m_CountZ;
+	}
+
+	Uint32 LightClusters::GetClustersCount() const
+	{
+		return m_CountX * m_CountY * m_CountZ;
+	}
+
+	void LightClusters::SetWorkersCount( Uint32 _WorkersCount )
+	{
+		m_WorkersCount = _WorkersCount;
+	}
+
+	Uint32 LightClusters::GetWorkersCount() const
+	{
+		return m_WorkersCount;
+	}
+
+	void LightClusters::Bin( const Matrix4x4& _View, const Matrix4x4& _Projection, float _Near, float _Far,
+							 const std::vector<LightBounds>& _PointLights, const std::vector<LightBounds>& _SpotLights )
+	{
+		const float Near = Math::Max( Math::Epsilon(), _Near );
+		const float Far = Math::Max( Near + Math::Epsilon(), _Far );
+
+		// The bounds only depend on the projection, don't recompute them each frame.
+		if( m_Bounds.size() != GetClustersCount() || Near != m_Near || Far != m_Far || !( m_BoundsProjection == _Projection ) )
+		{
+			m_Near = Near;
+			m_Far = Far;
+			ComputeClustersBounds( _Projection );
+		}
+
+		// Slice = log( Depth ) * Scale + Bias.
+		const float LogFarByNear = Math::Log( m_Far / m_Near );
+		m_SliceScale = Cast( float, m_CountZ ) / LogFarByNear;
+		m_SliceBias = -Cast( float, m_CountZ ) * Math::Log( m_Near ) / LogFarByNear;
+
+
+		// Move the lights in view space once, the view matrix is rigid so the radius is kept.
+		m_ViewPointLights.resize( _PointLights.size() );
+		for( size_t i = 0; i < _PointLights.size(); i++ )
+			m_ViewPointLights[i] = LightBounds{ _View.GetTransformedPoint( _PointLights[i].Position ), _PointLights[i].Radius };
+
+		m_ViewSpotLights.resize( _SpotLights.size() );
+		for( size_t i = 0; i < _SpotLights.size(); i++ )
+			m_ViewSpotLights[i] = LightBounds{ _View.GetTransformedPoint( _SpotLights[i].Position ), _SpotLights[i].Radius };
+
+
+		// Split the depth slices between the threads of the job system, each chunk write its own cells and its own indices list.
+		JobSystem& Jobs = Aero.GetJobSystem();
+
+		Uint32 WorkersCount = m_WorkersCount == 0 ? Jobs.GetThreadsCount() : m_WorkersCount;
+		WorkersCount = Math::Min( WorkersCount, m_CountZ );
+
+		if( _PointLights.size() + _SpotLights.size() < MinLightsForWorkers )
+			WorkersCount = 1;
+
+		const Uint32 SlicesPerWorker = ( m_CountZ + WorkersCount - 1 ) / WorkersCount;
+
+		std::vector<std::vector<Uint32>> WorkersIndices( WorkersCount );
+
+		Jobs.ParallelFor( 0, WorkersCount, 1, [this, SlicesPerWorker, &WorkersIndices]( Uint32 _Begin, Uint32 _End )
+		{
+			for( Uint32 w = _Begin; w < _End; w++ )
+			{
+				const Uint32 FirstSlice = Math::Min( w * SlicesPerWorker, m_CountZ );
+				const Uint32 EndSlice = Math::Min( FirstSlice + SlicesPerWorker, m_CountZ );
+
+				BinSlices( FirstSlice, EndSlice, WorkersIndices[w] );
+			}
+		} );
+
+
+		// Concatenate the workers lists and make the cells offsets absolute.
+		m_LightIndices.clear();
+
+		const Uint32 CellsPerSlice = m_CountX * m_CountY;
+		for( Uint32 w = 0; w < WorkersCount; w++ )
+		{
+			const Uint32 FirstSlice = Math::Min( w * SlicesPerWorker, m_CountZ );
+			const Uint32 EndSlice = Math::Min( FirstSlice + SlicesPerWorker, m_CountZ );
+			const Uint32 BaseOffset = Cast( Uint32, m_LightIndices.size() );
+
+			for( Uint32 c = FirstSlice * CellsPerSlice; c < EndSlice * CellsPerSlice; c++ )
+				m_Cells[c].Offset += BaseOffset;
+
+			m_LightIndices.insert( m_LightIndices.end(), WorkersIndices[w].cbegin(), WorkersIndices[w].cend() );
+		}
+	}
+
+	void LightClusters::BinSlices( Uint32 _FirstSlice, Uint32 _EndSlice, AE_Out std::vector<Uint32>& _Indices )
+	{
+		_Indices.clear();
+
+		std::vector<Uint32> PointCandidates;
+		std::vector<Uint32> SpotCandidates;
+		PointCandidates.reserve( m_ViewPointLights.size() );
+		SpotCandidates.reserve( m_ViewSpotLights.size() );
+
+		const float FarByNear = m_Far / m_Near;
+		const float CountZ = Cast( float, m_CountZ );
+
+		for( Uint32 z = _FirstSlice; z < _EndSlice; z++ )
+		{
+			// View depth range of the slice. The camera look toward -Z.
+			const float SliceNear = m_Near * Math::Pow( FarByNear, Cast( float, z ) / CountZ );
+			const float SliceFar = m_Near * Math::Pow( FarByNear, Cast( float, z + 1 ) / CountZ );
+
+			// Reject once per slice the lights that cannot reach it.
+			PointCandidates.clear();
+			for( Uint32 i = 0; i < Cast( Uint32, m_ViewPointLights.size() ); i++ )
+			{
+				const float Depth = -m_ViewPointLights[i].Position.Z;
+				const float Radius = m_ViewPointLights[i].Radius;
+				if( Depth + Radius >= SliceNear && Depth - Radius <= SliceFar )
+					PointCandidates.push_back( i );
+			}
+
+			SpotCandidates.clear();
+			for( Uint32 i = 0; i < Cast( Uint32, m_ViewSpotLights.size() ); i++ )
+			{
+				const float Depth = -m_ViewSpotLights[i].Position.Z;
+				const float Radius = m_ViewSpotLights[i].Radius;
+				if( Depth + Radius >= SliceNear && Depth - Radius <= SliceFar )
+					SpotCandidates.push_back( i );
+			}
+
+			for( Uint32 y = 0; y < m_CountY; y++ )
+			{
+				for( Uint32 x = 0; x < m_CountX; x++ )
+				{
+					const Uint32 ClusterIndex = GetClusterIndex( x, y, z );
+					const ClusterBounds& Bounds = m_Bounds[ClusterIndex];
+					Cell& ClusterCell = m_Cells[ClusterIndex];
+
+					ClusterCell.Offset = Cast( Uint32, _Indices.size() );
+
+					for( const Uint32 LightIndex : PointCandidates )
+					{
+						const LightBounds& Light = m_ViewPointLights[LightIndex];
+						if( SphereIntersectsBox( Light.Position, Light.Radius, Bounds.Min, Bounds.Max ) )
+							_Indices.push_back( LightIndex );
+					}
+
+					ClusterCell.PointLightsCount = Cast( Uint32, _Indices.size() ) - ClusterCell.Offset;
+
+					for( const Uint32 LightIndex : SpotCandidates )
+					{
+						const LightBounds& Light = m_ViewSpotLights[LightIndex];
+						if( SphereIntersectsBox( Light.Position, Light.Radius, Bounds.Min, Bounds.Max ) )
+							_Indices.push_back( LightIndex );
+					}
+
+					ClusterCell.SpotLightsCount = Cast( Uint32, _Indices.size() ) - ClusterCell.Offset - ClusterCell.PointLightsCount;
+				}
+			}
+		}
+	}
+
+	void LightClusters::ComputeClustersBounds( const Matrix4x4& _Projection )
+	{
+		m_BoundsProjection = _Projection;
+		m_Bounds.resize( GetClustersCount() );
+
+		const Matrix4x4 InverseProjection = _Projection.GetInverse();
+
+		const float FarByNear = m_Far / m_Near;
+		const float CountZ = Cast( float, m_CountZ );
+
+		for( Uint32 z = 0; z < m_CountZ; z++ )
+		{
+			const std::array<float, 2> SliceDepths =
+			{
+				m_Near * Math::Pow( FarByNear, Cast( float, z ) / CountZ ),
+				m_Near * Math::Pow( FarByNear, Cast( float, z + 1 ) / CountZ )
+			};
+
+			for( Uint32 y = 0; y < m_CountY; y++ )
+			{
+				for( Uint32 x = 0; x < m_CountX; x++ )
+				{
+					ClusterBounds& Bounds = m_Bounds[GetClusterIndex( x, y, z )];
+					Bounds.Min = Vector3( Math::Max<float>(), Math::Max<float>(), Math::Max<float>() );
+					Bounds.Max = Vector3( Math::Lowest<float>(), Math::Lowest<float>(), Math::Lowest<float>() );
+
+					// Intersect the 4 corner rays of the tile with the slice near and far planes.
+					for( Uint32 Corner = 0; Corner < 4; Corner++ )
+					{
+						const float NDCX = -1.0f + 2.0f * Cast( float, x + ( Corner & 1 ) ) / Cast( float, m_CountX );
+						const float NDCY = -1.0f + 2.0f * Cast( float, y + ( Corner >> 1 ) ) / Cast( float, m_CountY );
+
+						const Vector3 RayStart = UnprojectNDC( InverseProjection, NDCX, NDCY, -1.0f );
+						const Vector3 RayEnd = UnprojectNDC( InverseProjection, NDCX, NDCY, 1.0f );
+						const Vector3 RayDirection = RayEnd - RayStart;
+
+						for( const float Depth : SliceDepths )
+						{
+							const float T = ( -Depth - RayStart.Z ) / RayDirection.Z;
+							const Vector3 Point = RayStart + RayDirection * T;
+
+							Bounds.Min = Vector3( Math::Min( Bounds.Min.X, Point.X ), Math::Min( Bounds.Min.Y, Point.Y ), Math::Min( Bounds.Min.Z, Point.Z ) );
+							Bounds.Max = Vector3( Math::Max( Bounds.Max.X, Point.X ), Math::Max( Bounds.Max.Y, Point.Y ), Math::Max( Bounds.Max.Z, Point.Z ) );
+						}
+					}
+				}
+			}
+		}
+	}
+
+	Uint32 LightClusters::GetClusterIndex( Uint32 _X, Uint32 _Y, Uint32 _Z ) const
+	{
+		return _X + m_CountX * ( _Y + m_CountY * _Z );
+	}
+
+	Uint32 LightClusters::GetSlice( float _ViewDepth ) const
+	{
+		const float Slice = Math::Log( Math::Max( Math::Epsilon(), _ViewDepth ) ) * m_SliceScale + m_SliceBias;
+
+		return Cast( Uint32, Math::Clamp( 0.0f, Cast( float, m_CountZ - 1 ), Math::Floor( Slice ) ) );
+	}
+
+	const std::vector<LightClusters::Cell>& LightClusters::GetCells() const
+	{
+		return m_Cells;
+	}
+
+	const std::vector<Uint32>& LightClusters::GetLightIndices() const
+	{
+		return m_LightIndices;
+	}
+
+	Uint32 LightClusters::GetMaxLightsPerCluster() const
+	{
+		Uint32 MaxCount = 0;
+		for( const Cell& ClusterCell : m_Cells )
+			MaxCount = Math::Max( MaxCount, ClusterCell.PointLightsCount + ClusterCell.SpotLightsCount );
+
+		return MaxCount;
+	}
+
+
+	void LightClusters::Invalidate()
+	{
+		m_MustRebuild = True;
+	}
+
+	void LightClusters::Update( const World& _World, Camera& _Camera )
+	{
+		if( !m_MustRebuild && m_LastCamera == &_Camera )
+			return;
+
+		m_PointLightsBounds.clear();
+		m_SpotLightsBounds.clear();
+		m_PointLightsData.clear();
+		m_SpotLightsData.clear();
+
+		for( Light* CurrentLight : _World.GetLights() )
+		{
+			if( CurrentLight == nullptr || !CurrentLight->IsEnabled() )
+				continue;
+
+			const Vector3& Position = CurrentLight->GetPosition();
+			const Color& LightColor = CurrentLight->GetColor();
+			const float Intensity = CurrentLight->GetIntensity();
+
+			if( CurrentLight->GetLightType() == Light::LightType::Point )
+			{
+				const PointLight* Point = static_cast<const PointLight*>( CurrentLight );
+
+				m_PointLightsBounds.push_back( LightBounds{ Position, Point->GetRadius() } );
+				m_PointLightsData.insert( m_PointLightsData.end(),
+				{
+					Position.X, Position.Y, Position.Z, Point->GetRadius(),
+					LightColor.R() * Intensity, LightColor.G() * Intensity, LightColor.B() * Intensity, 0.0f
+				} );
+			}
+			else if( CurrentLight->GetLightType() == Light::LightType::Spot )
+			{
+				SpotLight* Spot = static_cast<SpotLight*>( CurrentLight );
+				const Vector3 Direction = Spot->GetForward();
+
+				// The spot attenuation is spherical, its range sphere is a conservative bound of the cone.
+				m_SpotLightsBounds.push_back( LightBounds{ Position, Spot->GetRange() } );
+				m_SpotLightsData.insert( m_SpotLightsData.end(),
+				{
+					Position.X, Position.Y, Position.Z, Spot->GetRange(),
+					Direction.X, Direction.Y, Direction.Z, Spot->GetInnerAngle(),
+					LightColor.R() * Intensity, LightColor.G() * Intensity, LightColor.B() * Intensity, Spot->GetOuterAngle()
+				} );
+			}
+		}
+
+		Bin( _Camera.GetLookAtMatrix(), _Camera.GetProjectionMatrix(), _Camera.GetNear(), _Camera.GetFar(), m_PointLightsBounds, m_SpotLightsBounds );
+
+		UploadToGPU();
+
+		m_MustRebuild = False;
+		m_LastCamera = &_Camera;
+	}
+
+	Bool LightClusters::IsUsedByShader( const Shader& _Shader )
+	{
+		return _Shader.GetUniformLocation( Material::GetDefaultParameterName( Material::DefaultParameters::Clusters_Grid ) ) >= 0;
+	}
+
+	void LightClusters::SendToShader( const Shader& _Shader, AE_InOut Uint32& _TextureUnit ) const
+	{
+		static const std::array<Material::DefaultParameters, 4> TextureParameters =
+		{
+			Material::DefaultParameters::Clusters_Grid,
+			Material::DefaultParameters::Clusters_LightIndices,
+			Material::DefaultParameters::Clusters_PointLights,
+			Material::DefaultParameters::Clusters_SpotLights
+		};
+
+		for( size_t t = 0; t < TextureParameters.size(); t++ )
+		{
+			const Int32 Location = _Shader.GetUniformLocation( Material::GetDefaultParameterName( TextureParameters[t] ) );
+
+			glActiveTexture( GL_TEXTURE0 + _TextureUnit ); AE_ErrorCheckOpenGLError();
+			glBindTexture( GL_TEXTURE_BUFFER, m_TextureIDs[t] ); AE_ErrorCheckOpenGLError();
+
+			_Shader.SetInt( Location, _TextureUnit );
+			_TextureUnit++;
+		}
+
+		Int32 Location = _Shader.GetUniformLocation( Material::GetDefaultParameterName( Material::DefaultParameters::Clusters_GridSize ) );
+		_Shader.SetVector3( Location, Vector3( Cast( float, m_CountX ), Cast( float, m_CountY ), Cast( float, m_CountZ ) ) );
+
+		Location = _Shader.GetUniformLocation( Material::GetDefaultParameterName( Material::DefaultParameters::Clusters_DepthSlicing ) );
+		_Shader.SetVector2( Location, Vector2( m_SliceScale, m_SliceBias ) );
+	}
+
+	void LightClusters::Clean( AE_InOut Uint32& _TextureUnit ) const
+	{
+		for( size_t t = 0; t < m_TextureIDs.size(); t++ )
+		{
+			glActiveTexture( GL_TEXTURE0 + _TextureUnit ); AE_ErrorCheckOpenGLError();
+			glBindTexture( GL_TEXTURE_BUFFER, 0 ); AE_ErrorCheckOpenGLError();
+			_TextureUnit++;
+		}
+	}
+
+	void LightClusters::UploadToGPU()
+	{
+		if( m_BufferIDs[0] == 0 )
+		{
+			glGenBuffers( Cast( GLsizei, m_BufferIDs.size() ), m_BufferIDs.data() ); AE_ErrorCheckOpenGLError();
+			glGenTextures( Cast( GLsizei, m_TextureIDs.size() ), m_TextureIDs.data() ); AE_ErrorCheckOpenGLError();
+		}
+
+		// Texture buffers cannot be empty, upload at least one (zeroed) texel.
+		static const std::array<Uint32, 4> EmptyTexel = { 0, 0, 0, 0 };
+
+		const std::array<const void*, 4> Datas =
+		{
+			m_Cells.data(),
+			m_LightIndices.empty() ? EmptyTexel.data() : Cast( const void*, m_LightIndices.data() ),
+			m_PointLightsData.empty() ? EmptyTexel.data() : Cast( const void*, m_PointLightsData.data() ),
+			m_SpotLightsData.empty() ? EmptyTexel.data() : Cast( const void*, m_SpotLightsData.data() )
+		};
+
+		const std::array<size_t, 4> Sizes =
+		{
+			m_Cells.size() * sizeof( Cell ),
+			m_LightIndices.empty() ? sizeof( Uint32 ) : m_LightIndices.size() * sizeof( Uint32 ),
+			m_PointLightsData.empty() ? sizeof( EmptyTexel ) : m_PointLightsData.size() * sizeof( float ),
+			m_SpotLightsData.empty() ? sizeof( EmptyTexel ) : m_SpotLightsData.size() * sizeof( float )
+		};
+
+		const std::array<GLenum, 4> Formats = { GL_RGBA32UI, GL_R32UI, GL_RGBA32F, GL_RGBA32F };
+
+		for( size_t b = 0; b < m_BufferIDs.size(); b++ )
+		{
+			glBindBuffer( GL_TEXTURE_BUFFER, m_BufferIDs[b] ); AE_ErrorCheckOpenGLError();
+
+			// Orphan the previous storage, the lists change every frame.
+			glBufferData( GL_TEXTURE_BUFFER, Cast( GLsizeiptr, Sizes[b] ), nullptr, GL_STREAM_DRAW ); AE_ErrorCheckOpenGLError();
+			glBufferSubData( GL_TEXTURE_BUFFER, 0, Cast( GLsizeiptr, Sizes[b] ), Datas[b] ); AE_ErrorCheckOpenGLError();
+
+			glBindTexture( GL_TEXTURE_BUFFER, m_TextureIDs[b] ); AE_ErrorCheckOpenGLError();
+			glTexBuffer( GL_TEXTURE_BUFFER, Formats[b], m_BufferIDs[b] ); AE_ErrorCheckOpenGLError();
+		}
+
+		glBindTexture( GL_TEXTURE_BUFFER, 0 ); AE_ErrorCheckOpenGLError();
+		glBindBuffer( GL_TEXTURE_BUFFER, 0 ); AE_ErrorCheckOpenGLError();
+	}
+
+	void LightClusters::FreeGPUResources()
+	{
+		if( m_BufferIDs[0] == 0 )
+			return;
+
+		glDeleteTextures( Cast( GLsizei, m_TextureIDs.size() ), m_TextureIDs.data() );
+		glDeleteBuffers( Cast( GLsizei, m_BufferIDs.size() ), m_BufferIDs.data() );
+
+		m_TextureIDs.fill( 0 );
+		m_BufferIDs.fill( 0 );
+	}
+
+} // ae
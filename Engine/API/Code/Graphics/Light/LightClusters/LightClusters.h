@@ -0,0 +1,249 @@
+#ifndef _LIGHTCLUSTERS_AERO_H_
+#define _LIGHTCLUSTERS_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../../Maths/Vector/Vector3.h"
+#include "../../../Maths/Matrix/Matrix4x4.h"
+#include "../../../Idioms/NotCopiable/NotCopiable.h"
+
+#include <vector>
+#include <array>
+
+namespace ae
+{
+	class World;
+	class Camera;
+	class Shader;
+
+	/// \ingroup graphics
+	/// <summary>
+	/// Clustered (froxel) light assignment.<para/>
+	/// The camera frustum is split in a grid of clusters (tiles on screen, exponential slices in depth)
+	/// and each point/spot light of the world is binned in the clusters its volume overlaps.<para/>
+	/// The binning is done on the CPU (split in jobs along the depth slices) and doesn't need any OpenGL context,
+	/// only the upload of the compact lists to the texture buffers does.<para/>
+	/// Shaders including "LightClusters.glsl" then only iterate the lights of the fragment cluster.
+	/// </summary>
+	/// <seealso cref="Light" />
+	/// <seealso cref="Renderer" />
+	class AERO_CORE_EXPORT LightClusters : public NotCopiable
+	{
+	public:
+		/// <summary>Bounding sphere of a light to bin in the clusters.</summary>
+		struct LightBounds
+		{
+			/// <summary>World position of the light volume center.</summary>
+			Vector3 Position;
+
+			/// <summary>Radius of the light volume.</summary>
+			float Radius;
+		};
+
+		/// <summary>Content of one cluster, laid out as it is sent to the shaders (one RGBA32UI texel).</summary>
+		struct Cell
+		{
+			/// <summary>Offset of the first light index of the cluster in the light indices list.</summary>
+			Uint32 Offset;
+
+			/// <summary>Count of point light indices of the cluster (stored first).</summary>
+			Uint32 PointLightsCount;
+
+			/// <summary>Count of spot light indices of the cluster (stored after the point lights).</summary>
+			Uint32 SpotLightsCount;
+
+			/// <summary>Unused, keep the cell 16 bytes wide.</summary>
+			Uint32 Padding;
+		};
+
+	public:
+		/// <summary>Create an empty clusters grid. No OpenGL resources are created until the first upload.</summary>
+		/// <param name="_CountX">Count of clusters along the screen width.</param>
+		/// <param name="_CountY">Count of clusters along the screen height.</param>
+		/// <param name="_CountZ">Count of depth slices.</param>
+		LightClusters( Uint32 _CountX = 16, Uint32 _CountY = 9, Uint32 _CountZ = 24 );
+
+		/// <summary>Free the OpenGL buffers if they were created.</summary>
+		~LightClusters();
+
+		/// <summary>Change the clusters grid size. The next update will rebuild the clusters.</summary>
+		/// <param name="_CountX">Count of clusters along the screen width.</param>
+		/// <param name="_CountY">Count of clusters along the screen height.</param>
+		/// <param name="_CountZ">Count of depth slices.</param>
+		void SetGridSize( Uint32 _CountX, Uint32 _CountY, Uint32 _CountZ );
+
+		/// <summary>Retrieve the count of clusters along the screen width.</summary>
+		/// <returns>Count of clusters along X.</returns>
+		Uint32 GetCountX() const;
+
+		/// <summary>Retrieve the count of clusters along the screen height.</summary>
+		/// <returns>Count of clusters along Y.</returns>
+		Uint32 GetCountY() const;
+
+		/// <summary>Retrieve the count of depth slices.</summary>
+		/// <returns>Count of clusters along Z.</returns>
+		Uint32 GetCountZ() const;
+
+		/// <summary>Retrieve the total count of clusters.</summary>
+		/// <returns>Count of clusters in the grid.</returns>
+		Uint32 GetClustersCount() const;
+
+		/// <summary>
+		/// Set the maximum count of jobs running the binning in parallel.<para/>
+		/// 0 let the clusters use all the threads of the job system.
+		/// </summary>
+		/// <param name="_WorkersCount">Maximum count of jobs.</param>
+		void SetWorkersCount( Uint32 _WorkersCount );
+
+		/// <summary>Retrieve the maximum count of jobs running the binning in parallel.</summary>
+		/// <returns>Maximum count of jobs, 0 for all the threads of the job system.</returns>
+		Uint32 GetWorkersCount() const;
+
+		/// <summary>
+		/// Bin lights bounds in the clusters of a view.<para/>
+		/// CPU only, doesn't need any OpenGL context.
+		/// </summary>
+		/// <param name="_View">View matrix of the camera (world to view space).</param>
+		/// <param name="_Projection">Projection matrix of the camera.</param>
+		/// <param name="_Near">Near distance of the camera.</param>
+		/// <param name="_Far">Far distance of the camera.</param>
+		/// <param name="_PointLights">Bounds of the point lights, the cluster lists refer to the index in this array.</param>
+		/// <param name="_SpotLights">Bounds of the spot lights, the cluster lists refer to the index in this array.</param>
+		void Bin( const Matrix4x4& _View, const Matrix4x4& _Projection, float _Near, float _Far,
+				  const std::vector<LightBounds>& _PointLights, const std::vector<LightBounds>& _SpotLights );
+
+		/// <summary>Retrieve the index of a cluster in the cells array.</summary>
+		/// <param name="_X">Cluster X coordinate.</param>
+		/// <param name="_Y">Cluster Y coordinate.</param>
+		/// <param name="_Z">Cluster depth slice.</param>
+		/// <returns>Index of the cluster.</returns>
+		Uint32 GetClusterIndex( Uint32 _X, Uint32 _Y, Uint32 _Z ) const;
+
+		/// <summary>Retrieve the depth slice of a view space depth for the last binned view.</summary>
+		/// <param name="_ViewDepth">Positive distance along the camera forward axis.</param>
+		/// <returns>Depth slice, clamped to the grid.</returns>
+		Uint32 GetSlice( float _ViewDepth ) const;
+
+		/// <summary>Retrieve the clusters of the last binning.</summary>
+		/// <returns>Clusters cells.</returns>
+		const std::vector<Cell>& GetCells() const;
+
+		/// <summary>Retrieve the light indices of the last binning. Each cell references a range of this array.</summary>
+		/// <returns>Light indices.</returns>
+		const std::vector<Uint32>& GetLightIndices() const;
+
+		/// <summary>Retrieve the maximum count of lights found in a single cluster for the last binning.</summary>
+		/// <returns>Maximum lights count in a cluster.</returns>
+		Uint32 GetMaxLightsPerCluster() const;
+
+
+		/// <summary>Force the clusters to be rebuilt at the next update. Called by the world each frame.</summary>
+		void Invalidate();
+
+		/// <summary>
+		/// Gather the enabled point and spot lights of the world, bin them for the camera view and upload the result.<para/>
+		/// Nothing is done if the clusters are still valid for this camera.
+		/// </summary>
+		/// <param name="_World">World to take the lights from.</param>
+		/// <param name="_Camera">Camera the clusters are built for.</param>
+		void Update( const World& _World, Camera& _Camera );
+
+		/// <summary>Check if a shader use the clustered lights (it includes "LightClusters.glsl").</summary>
+		/// <param name="_Shader">Shader to check.</param>
+		/// <returns>True if the shader has the clusters uniforms, False otherwise.</returns>
+		static Bool IsUsedByShader( const Shader& _Shader );
+
+		/// <summary>Bind the clusters texture buffers and send the grid parameters to a shader.</summary>
+		/// <param name="_Shader">Shader to send the clusters to.</param>
+		/// <param name="_TextureUnit">Texture unit to start binding the texture buffers to. Incremented for each binding.</param>
+		void SendToShader( const Shader& _Shader, AE_InOut Uint32& _TextureUnit ) const;
+
+		/// <summary>Unbind the clusters texture buffers.</summary>
+		/// <param name="_TextureUnit">Texture unit to start unbinding from. Incremented for each unbinding.</param>
+		void Clean( AE_InOut Uint32& _TextureUnit ) const;
+
+	private:
+		/// <summary>Bin the lights for a range of depth slices.</summary>
+		/// <param name="_FirstSlice">First slice to process.</param>
+		/// <param name="_EndSlice">Slice after the last one to process.</param>
+		/// <param name="_Indices">Light indices of the processed clusters, offsets of the cells are relative to this array.</param>
+		void BinSlices( Uint32 _FirstSlice, Uint32 _EndSlice, AE_Out std::vector<Uint32>& _Indices );
+
+		/// <summary>Compute the view space bounding boxes of the clusters.</summary>
+		/// <param name="_Projection">Projection matrix of the camera.</param>
+		void ComputeClustersBounds( const Matrix4x4& _Projection );
+
+		/// <summary>Create the OpenGL buffers and textures if needed and fill them with the binned data.</summary>
+		void UploadToGPU();
+
+		/// <summary>Free the OpenGL buffers and textures.</summary>
+		void FreeGPUResources();
+
+	private:
+		/// <summary>Axis aligned bounding box of a cluster in view space.</summary>
+		struct ClusterBounds
+		{
+			/// <summary>Minimum corner.</summary>
+			Vector3 Min;
+			/// <summary>Maximum corner.</summary>
+			Vector3 Max;
+		};
+
+		/// <summary>Count of clusters along screen width.</summary>
+		Uint32 m_CountX;
+		/// <summary>Count of clusters along screen height.</summary>
+		Uint32 m_CountY;
+		/// <summary>Count of depth slices.</summary>
+		Uint32 m_CountZ;
+
+		/// <summary>Maximum count of jobs for the binning, 0 for all the threads of the job system.</summary>
+		Uint32 m_WorkersCount;
+
+		/// <summary>Near distance of the last binned view.</summary>
+		float m_Near;
+		/// <summary>Far distance of the last binned view.</summary>
+		float m_Far;
+		/// <summary>Scale and bias to go from log( depth ) to depth slice.</summary>
+		float m_SliceScale;
+		/// <summary>Scale and bias to go from log( depth ) to depth slice.</summary>
+		float m_SliceBias;
+
+		/// <summary>View space bounds of each cluster.</summary>
+		std::vector<ClusterBounds> m_Bounds;
+
+		/// <summary>Projection matrix used to compute the clusters bounds.</summary>
+		Matrix4x4 m_BoundsProjection;
+
+		/// <summary>Bounds of the world point lights gathered by the last update.</summary>
+		std::vector<LightBounds> m_PointLightsBounds;
+		/// <summary>Bounds of the world spot lights gathered by the last update.</summary>
+		std::vector<LightBounds> m_SpotLightsBounds;
+
+		/// <summary>Point lights of the current binning in view space.</summary>
+		std::vector<LightBounds> m_ViewPointLights;
+		/// <summary>Spot lights of the current binning in view space.</summary>
+		std::vector<LightBounds> m_ViewSpotLights;
+
+		/// <summary>Clusters content.</summary>
+		std::vector<Cell> m_Cells;
+		/// <summary>Lights indices referenced by the clusters.</summary>
+		std::vector<Uint32> m_LightIndices;
+
+		/// <summary>Point lights data, two RGBA32F texels per light (position + radius, color * intensity).</summary>
+		std::vector<float> m_PointLightsData;
+		/// <summary>Spot lights data, three RGBA32F texels per light (position + range, direction + inner angle, color * intensity + outer angle).</summary>
+		std::vector<float> m_SpotLightsData;
+
+		/// <summary>Must the clusters be rebuilt at the next update ?</summary>
+		Bool m_MustRebuild;
+		/// <summary>Camera of the last update.</summary>
+		const Camera* m_LastCamera;
+
+		/// <summary>OpenGL buffers : cells, indices, point lights, spot lights.</summary>
+		std::array<Uint32, 4> m_BufferIDs;
+		/// <summary>OpenGL texture buffers views of m_BufferIDs.</summary>
+		std::array<Uint32, 4> m_TextureIDs;
+	};
+
+} // ae
+
+#endif // _LIGHTCLUSTERS_AERO_H_
@@ -28,18 +28,18 @@ namespace ae
 
 	void PointLight::SendToShader( const std::string& _LightName, Uint32 _LightIndex, const Shader& _Shader )
 	{
-		const std::string IndexedLightName = _LightName + "[" + std::to_string( _LightIndex ) + "]";
+		UniformName IndexedLightName( _LightName, _LightIndex );
 
-		Uint32 Location = _Shader.GetUniformLocation( IndexedLightName + ".Position" );
+		Uint32 Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Position" ) );
 		_Shader.SetVector3( Location, m_Position );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".Color" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Color" ) );
 		_Shader.SetColor( Location, m_Color );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".Radius" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Radius" ) );
 		_Shader.SetFloat( Location, m_Radius );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".Intensity" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Intensity" ) );
 		_Shader.SetFloat( Location, m_Intensity );
 	}
 
@@ -64,27 +64,27 @@ namespace ae
 
 	void SpotLight::SendToShader( const std::string& _LightName, Uint32 _LightIndex, const Shader& _Shader )
 	{
-        const std::string IndexedLightName = _LightName + "[" + std::to_string( _LightIndex ) + "]";
+        UniformName IndexedLightName( _LightName, _LightIndex );
 
-		Uint32 Location = _Shader.GetUniformLocation( IndexedLightName + ".Position" );
+		Uint32 Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Position" ) );
 		_Shader.SetVector3( Location, m_Position );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".Color" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Color" ) );
 		_Shader.SetColor( Location, m_Color );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".LookAt" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".LookAt" ) );
 		_Shader.SetVector3( Location, GetForward() );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".InnerAngle" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".InnerAngle" ) );
 		_Shader.SetFloat( Location, m_InnerAngle );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".OuterAngle" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".OuterAngle" ) );
 		_Shader.SetFloat( Location, m_OuterAngle );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".Intensity" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Intensity" ) );
 		_Shader.SetFloat( Location, m_Intensity );
 
-		Location = _Shader.GetUniformLocation( IndexedLightName + ".Range" );
+		Location = _Shader.GetUniformLocation( IndexedLightName.Get( ".Range" ) );
 		_Shader.SetFloat( Location, m_Range );
 	}
 
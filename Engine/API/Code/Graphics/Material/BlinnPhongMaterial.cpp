@@ -8,6 +8,10 @@ namespace ae
 	BlinnPhongMaterial::BlinnPhongMaterial()
 	{
 		SetShader( Aero.GetResourcesManager().GetDefault3DShader() );
+		SetInstancedShader( Aero.GetResourcesManager().GetDefaultInstanced3DShader() );
+
+		// The texture slots rarely change, the shader is specialized for the filled ones.
+		SetShaderVariantsEnabled( True );
 
 		const std::string& DiffuseColorName = GetDefaultParameterName( DefaultParameters::DiffuseColor );
 		m_DiffuseColor = AddColorParameterToMaterial( DiffuseColorName, DiffuseColorName, Color::White );
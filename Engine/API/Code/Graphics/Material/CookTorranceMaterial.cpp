@@ -8,6 +8,10 @@ namespace ae
 	CookTorranceMaterial::CookTorranceMaterial()
 	{
 		SetShader( *Aero.GetResourcesManager().GetDefaultCookTorranceShader() );
+		SetInstancedShader( Aero.GetResourcesManager().GetDefaultInstancedCookTorranceShader() );
+
+		// The texture slots rarely change, the shader is specialized for the filled ones.
+		SetShaderVariantsEnabled( True );
 
 		const std::string& BaseColorName = GetDefaultParameterName( DefaultParameters::PBR_BaseColor );
 		m_BaseColor = AddColorParameterToMaterial( BaseColorName, BaseColorName, Color::White );
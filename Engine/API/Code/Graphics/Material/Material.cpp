@@ -13,6 +13,7 @@
 #include "../Shader/ShaderParameter/ShaderParameterVector3.h"
 #include "../Shader/ShaderParameter/ShaderParameterMatrix3x3.h"
 #include "../Shader/ShaderParameter/ShaderParameterMatrix4x4.h"
+#include "../Shader/UniformBlock/UniformBlockPool.h"
 #include "../Texture/Texture.h"
 #include "../CubeMap/CubeMap.h"
 #include "../ShadowMap/ShadowMap.h"
@@ -20,8 +21,21 @@
 
 #include "../../Editor/TypesToEditor/MaterialToEditor.h"
 
+#include <algorithm>
+
 namespace ae
 {
+	namespace
+	{
+		/// <summary>Identify a program and its revision, the binding of the uniform block is lost when a shader is recompiled.</summary>
+		/// <param name="_Shader">Shader to identify.</param>
+		/// <returns>Key of the program.</returns>
+		Uint64 GetProgramKey( const Shader& _Shader )
+		{
+			return ( Cast( Uint64, _Shader.GetProgramID() ) << 32 ) | Cast( Uint64, _Shader.GetRevision() );
+		}
+	}
+
 	const std::array<std::string, Cast( size_t, Material::DefaultParameters::Count )> Material::DefaultParametersNames =
 	{
 		// 3D
@@ -119,6 +133,14 @@ namespace ae
 		// Directional lights count.
 		"DirectionalLightsCount",
 
+		// Light clusters.
+		"ClusterGrid",
+		"ClusterLightIndices",
+		"ClusterPointLights",
+		"ClusterSpotLights",
+		"ClusterGridSize",
+		"ClusterDepthSlicing",
+
 		// Skybox cube map.
 		"CubeMap",
 
@@ -149,19 +171,31 @@ namespace ae
 
 	Material::Material() :
 		m_ShaderRef( nullptr ),
+		m_InstancedShaderRef( nullptr ),
 		m_IsInstance( False ),
 		m_ShadowMapRef( nullptr ),
 		m_NeedLights( True ),
-		m_NeedCamera( True )
+		m_NeedCamera( True ),
+		m_MustBuildUniformBlock( True ),
+		m_UniformBlockPool( nullptr ),
+		m_UniformBlockSlot( priv::UniformBlockPool::InvalidSlot ),
+		m_AreShaderVariantsEnabled( False ),
+		m_MustListVariantParameters( True )
 	{
 		SetName( std::string( "Material_" ) + std::to_string( GetResourceID() ) );
 	}
 
 	Material::Material( const Shader& _Shader ) :
+		m_InstancedShaderRef( nullptr ),
 		m_IsInstance( False ),
 		m_ShadowMapRef( nullptr ),
 		m_NeedLights( True ),
-		m_NeedCamera( True )
+		m_NeedCamera( True ),
+		m_MustBuildUniformBlock( True ),
+		m_UniformBlockPool( nullptr ),
+		m_UniformBlockSlot( priv::UniformBlockPool::InvalidSlot ),
+		m_AreShaderVariantsEnabled( False ),
+		m_MustListVariantParameters( True )
 	{
 		SetShader( _Shader );
 
@@ -169,7 +203,13 @@ namespace ae
 	}
 
 	Material::Material( const Material& _Other ) :
-		m_IsInstance( False )
+		m_InstancedShaderRef( nullptr ),
+		m_IsInstance( False ),
+		m_MustBuildUniformBlock( True ),
+		m_UniformBlockPool( nullptr ),
+		m_UniformBlockSlot( priv::UniformBlockPool::InvalidSlot ),
+		m_AreShaderVariantsEnabled( False ),
+		m_MustListVariantParameters( True )
 	{
 		CopyMaterial( _Other );
 
@@ -183,6 +223,11 @@ namespace ae
 		return *this;
 	}
 
+	Material::~Material()
+	{
+		ReleaseUniformBlock();
+	}
+
 	void Material::AddParameter( ShaderParameter* _Parameter )
 	{
 		if( _Parameter == nullptr )
@@ -192,6 +237,10 @@ namespace ae
 		RemoveParameter( _Parameter->GetName() );
 
 		m_Parameters.emplace( _Parameter->GetName(), _Parameter );
+
+		// The parameters must be sorted again between the uniform block and the ones sent one by one.
+		ReleaseUniformBlock();
+		ResetShaderVariants();
 	}
 
 	void Material::RemoveParameter( const std::string& _ParameterName )
@@ -201,6 +250,10 @@ namespace ae
 		if( ItParam == m_Parameters.end() )
 			return;
 
+		// The uniform block and variant lists must not keep the removed parameter.
+		ReleaseUniformBlock();
+		ResetShaderVariants();
+
 		if( ItParam->second->IsDestroyedWithMaterial() )
 			delete ItParam->second;
 
@@ -212,6 +265,9 @@ namespace ae
 		if( m_Parameters.empty() )
 			return;
 
+		ReleaseUniformBlock();
+		ResetShaderVariants();
+
 		for( const std::pair<const std::string, ShaderParameter*>& ParamPair : m_Parameters )
 		{
 			if( ParamPair.second != nullptr && ParamPair.second->IsDestroyedWithMaterial() )
@@ -245,12 +301,21 @@ namespace ae
 		if( m_Parameters.empty() )
 			return;
 
-		for( const std::pair<const std::string, ShaderParameter*>& ParamPair : m_Parameters )
+		// Parameters or shader changed since the last draw, find again what can be stored in the uniform block.
+		ValidateUniformBlock( _Shader );
+
+		if( m_UniformBlockPool != nullptr )
+			SendUniformBlock( _Shader, _TextureUnit, _ImageUnit );
+
+		else
 		{
-			if( ParamPair.second == nullptr )
-				continue;
+			for( const std::pair<const std::string, ShaderParameter*>& ParamPair : m_Parameters )
+			{
+				if( ParamPair.second == nullptr )
+					continue;
 
-			ParamPair.second->SendToShader( _Shader, _TextureUnit, _ImageUnit );
+				ParamPair.second->SendToShader( _Shader, _TextureUnit, _ImageUnit );
+			}
 		}
 
 		const std::string& HasShadowMapName = GetDefaultParameterName( DefaultParameters::ShadowMap_HasShadowMap );
@@ -268,12 +333,22 @@ namespace ae
 		if( m_Parameters.empty() )
 			return;
 
-		for( const std::pair<const std::string, ShaderParameter*>& ParamPair : m_Parameters )
+		// Parameters stored in the uniform block have nothing to clean.
+		if( m_UniformBlockPool != nullptr )
 		{
-			if( ParamPair.second == nullptr )
-				continue;
+			for( ShaderParameter* Parameter : m_SentParameters )
+				Parameter->Clean( _Shader, _TextureUnit, _ImageUnit );
+		}
+
+		else
+		{
+			for( const std::pair<const std::string, ShaderParameter*>& ParamPair : m_Parameters )
+			{
+				if( ParamPair.second == nullptr )
+					continue;
 
-			ParamPair.second->Clean( _Shader, _TextureUnit, _ImageUnit );
+				ParamPair.second->Clean( _Shader, _TextureUnit, _ImageUnit );
+			}
 		}
 
 		if( HasShadowMap() )
@@ -372,9 +447,136 @@ namespace ae
 		}
 
 		SetShader( _Other.GetShader() );
+		SetInstancedShader( _Other.GetInstancedShader() );
 		SetShadowMap( _Other.GetShadowMap() );
 		SetNeedLights( _Other.NeedLights() );
 		SetNeedCamera( _Other.NeedCamera() );
+
+		m_ShaderDefines = _Other.m_ShaderDefines;
+		m_AreShaderVariantsEnabled = _Other.m_AreShaderVariantsEnabled;
+		ResetShaderVariants();
+	}
+
+	void Material::BuildUniformBlock( const Shader& _Shader ) const
+	{
+		ReleaseUniformBlock();
+
+		m_MustBuildUniformBlock = False;
+		m_UniformBlockPrograms.push_back( GetProgramKey( _Shader ) );
+
+		priv::UniformBlockLayout Layout;
+		if( !Layout.LoadFromShader( _Shader, priv::UniformBlockLayout::MaterialBlockName, priv::UniformBlockLayout::MaterialBindingPoint ) )
+			return;
+
+		// Materials with the same layout share the buffers of the pool.
+		m_UniformBlockPool = &Aero.GetResourcesManager().GetUniformBlockPool( Layout );
+		m_UniformBlockSlot = m_UniformBlockPool->Allocate();
+		m_UniformBlockData.assign( Layout.GetSize(), 0 );
+
+		for( const std::pair<const std::string, ShaderParameter*>& ParamPair : m_Parameters )
+		{
+			if( ParamPair.second == nullptr )
+				continue;
+
+			if( ParamPair.second->WriteToUniformBlock( Layout, m_UniformBlockData.data() ) )
+				m_BlockParameters.push_back( ParamPair.second );
+			else
+				m_SentParameters.push_back( ParamPair.second );
+		}
+
+		// Versions in the order of the upload checks : block parameters then sent ones.
+		for( const ShaderParameter* Parameter : m_BlockParameters )
+			m_UploadedVersions.push_back( Parameter->GetVersion() );
+
+		for( const ShaderParameter* Parameter : m_SentParameters )
+			m_UploadedVersions.push_back( Parameter->GetVersion() );
+
+		m_UniformBlockPool->Upload( m_UniformBlockSlot, m_UniformBlockData.data() );
+	}
+
+	void Material::SendUniformBlock( const Shader& _Shader, AE_InOut Uint32& _TextureUnit, AE_InOut Uint32& _ImageUnit ) const
+	{
+		// A parameter shared by several materials changes once for all : each material compares with its own last upload.
+		Bool IsDirty = False;
+		Uint32 VersionIndex = 0;
+		for( const ShaderParameter* Parameter : m_BlockParameters )
+			IsDirty |= Parameter->GetVersion() != m_UploadedVersions[VersionIndex++];
+
+		// Texture/bool parameters write their boolean in the block.
+		for( const ShaderParameter* Parameter : m_SentParameters )
+			IsDirty |= Parameter->GetVersion() != m_UploadedVersions[VersionIndex++];
+
+		if( IsDirty )
+		{
+			const priv::UniformBlockLayout& Layout = m_UniformBlockPool->GetLayout();
+
+			VersionIndex = 0;
+			for( const ShaderParameter* Parameter : m_BlockParameters )
+			{
+				Parameter->WriteToUniformBlock( Layout, m_UniformBlockData.data() );
+				m_UploadedVersions[VersionIndex++] = Parameter->GetVersion();
+			}
+
+			for( const ShaderParameter* Parameter : m_SentParameters )
+			{
+				Parameter->WriteToUniformBlock( Layout, m_UniformBlockData.data() );
+				m_UploadedVersions[VersionIndex++] = Parameter->GetVersion();
+			}
+
+			m_UniformBlockPool->Upload( m_UniformBlockSlot, m_UniformBlockData.data() );
+		}
+
+		m_UniformBlockPool->Bind( m_UniformBlockSlot );
+
+		for( ShaderParameter* Parameter : m_SentParameters )
+			Parameter->SendToShader( _Shader, _TextureUnit, _ImageUnit );
+	}
+
+	void Material::ValidateUniformBlock( const Shader& _Shader ) const
+	{
+		if( m_MustBuildUniformBlock )
+		{
+			BuildUniformBlock( _Shader );
+			return;
+		}
+
+		const Uint64 ProgramKey = GetProgramKey( _Shader );
+		if( std::find( m_UniformBlockPrograms.cbegin(), m_UniformBlockPrograms.cend(), ProgramKey ) != m_UniformBlockPrograms.cend() )
+			return;
+
+		// Another program uses the material (instanced variant for example).
+		// Keep the block if this program has the same layout, it only needs its binding point.
+		priv::UniformBlockLayout Layout;
+		const Bool HasBlock = Layout.LoadFromShader( _Shader, priv::UniformBlockLayout::MaterialBlockName, priv::UniformBlockLayout::MaterialBindingPoint );
+		const Bool IsSameLayout = m_UniformBlockPool != nullptr ? HasBlock && Layout.GetKey() == m_UniformBlockPool->GetLayout().GetKey() : !HasBlock;
+
+		if( IsSameLayout )
+			m_UniformBlockPrograms.push_back( ProgramKey );
+		else
+			BuildUniformBlock( _Shader );
+	}
+
+	void Material::ReleaseUniformBlock() const
+	{
+		if( m_UniformBlockPool != nullptr )
+			m_UniformBlockPool->Free( m_UniformBlockSlot );
+
+		m_UniformBlockPool = nullptr;
+		m_UniformBlockSlot = priv::UniformBlockPool::InvalidSlot;
+		m_BlockParameters.clear();
+		m_SentParameters.clear();
+		m_UploadedVersions.clear();
+		m_UniformBlockPrograms.clear();
+		m_MustBuildUniformBlock = True;
+	}
+
+	void Material::ResetShaderVariants() const
+	{
+		m_MustListVariantParameters = True;
+		m_VariantParameters.clear();
+
+		for( ShaderVariantSelection& Selection : m_ShaderVariants )
+			Selection = ShaderVariantSelection();
 	}
 
 
@@ -557,6 +759,8 @@ namespace ae
 	{
 		m_ShaderRef = &_Shader;
 		DiscardSavedUniformsLocation();
+		ReleaseUniformBlock();
+		ResetShaderVariants();
 	}
 
 	void Material::ToEditor()
@@ -569,6 +773,8 @@ namespace ae
 	{
 		m_ShaderRef = _Shader;
 		DiscardSavedUniformsLocation();
+		ReleaseUniformBlock();
+		ResetShaderVariants();
 	}
 
 	const Shader* Material::GetShader() const
@@ -576,6 +782,102 @@ namespace ae
 		return m_ShaderRef;
 	}
 
+	void Material::SetInstancedShader( const Shader* _Shader )
+	{
+		m_InstancedShaderRef = _Shader;
+		ResetShaderVariants();
+	}
+
+	const Shader* Material::GetInstancedShader() const
+	{
+		return m_InstancedShaderRef;
+	}
+
+	void Material::SetShaderDefine( const std::string& _Name, const std::string& _Value )
+	{
+		m_ShaderDefines[_Name] = _Value;
+		ResetShaderVariants();
+	}
+
+	void Material::RemoveShaderDefine( const std::string& _Name )
+	{
+		if( m_ShaderDefines.erase( _Name ) > 0 )
+			ResetShaderVariants();
+	}
+
+	const Shader::DefinesMap& Material::GetShaderDefines() const
+	{
+		return m_ShaderDefines;
+	}
+
+	void Material::SetShaderVariantsEnabled( Bool _Enabled )
+	{
+		if( m_AreShaderVariantsEnabled == _Enabled )
+			return;
+
+		m_AreShaderVariantsEnabled = _Enabled;
+		ResetShaderVariants();
+	}
+
+	Bool Material::AreShaderVariantsEnabled() const
+	{
+		return m_AreShaderVariantsEnabled;
+	}
+
+	const Shader* Material::SelectShader( Bool _Instanced ) const
+	{
+		const Shader* BaseShader = _Instanced ? m_InstancedShaderRef : m_ShaderRef;
+
+		if( BaseShader == nullptr || ( !m_AreShaderVariantsEnabled && m_ShaderDefines.empty() ) )
+			return BaseShader;
+
+		if( m_MustListVariantParameters )
+		{
+			m_MustListVariantParameters = False;
+			m_VariantParameters.clear();
+
+			if( m_AreShaderVariantsEnabled )
+			{
+				Bool Value = False;
+				for( const std::pair<const std::string, ShaderParameter*>& ParamPair : m_Parameters )
+				{
+					if( ParamPair.second != nullptr && ParamPair.second->GetVariantFlag( Value ) != nullptr && m_VariantParameters.size() < 64 )
+						m_VariantParameters.push_back( ParamPair.second );
+				}
+			}
+		}
+
+		// The flags are read at each draw since a parameter can change without the material knowing it.
+		Uint64 Flags = 0;
+		for( size_t p = 0; p < m_VariantParameters.size(); p++ )
+		{
+			Bool Value = False;
+			m_VariantParameters[p]->GetVariantFlag( Value );
+
+			if( Value )
+				Flags |= 1ull << p;
+		}
+
+		ShaderVariantSelection& Selection = m_ShaderVariants[_Instanced ? 1 : 0];
+		if( Selection.Variant != nullptr && Selection.BaseShader == BaseShader && Selection.Flags == Flags )
+			return Selection.Variant;
+
+		Shader::DefinesMap Defines = m_ShaderDefines;
+		for( const ShaderParameter* Parameter : m_VariantParameters )
+		{
+			Bool Value = False;
+			const std::string* FlagName = Parameter->GetVariantFlag( Value );
+
+			Defines[std::string( "VARIANT_" ) + *FlagName] = Value ? "true" : "false";
+		}
+
+		Selection.BaseShader = BaseShader;
+		Selection.Flags = Flags;
+		Selection.Variant = &BaseShader->GetVariant( Defines );
+
+		return Selection.Variant;
+	}
+
 	Bool Material::IsInstance() const
 	{
 		return m_IsInstance;
@@ -621,4 +923,9 @@ namespace ae
 		return m_NeedCamera;
 	}
 
+	Bool Material::IsUsingUniformBlock() const
+	{
+		return m_UniformBlockPool != nullptr;
+	}
+
 } // ae
@@ -8,6 +8,7 @@
 
 #include <unordered_map>
 #include <array>
+#include <vector>
 #include <string>
 
 // Pre-declaration of Assimp material structure.
@@ -31,6 +32,11 @@ namespace ae
 	class ShaderParameterVector2;
 	class ShaderParameterVector3;
 
+	namespace priv
+	{
+		class UniformBlockPool;
+	}
+
 
 	/// \ingroup graphics
 	/// <summary>Shading settings for rendering.</summary>
@@ -164,6 +170,19 @@ namespace ae
 			/// <summary>Integer parameter for point light count for 3D default shader.</summary>
 			DirectionalLightsCount,
 
+			/// <summary>Texture buffer of the light clusters cells (offset and counts of each cluster).</summary>
+			Clusters_Grid,
+			/// <summary>Texture buffer of the light indices referenced by the light clusters.</summary>
+			Clusters_LightIndices,
+			/// <summary>Texture buffer of the point lights data for the light clusters.</summary>
+			Clusters_PointLights,
+			/// <summary>Texture buffer of the spot lights data for the light clusters.</summary>
+			Clusters_SpotLights,
+			/// <summary>Vector 3D parameter for the count of light clusters along each axis.</summary>
+			Clusters_GridSize,
+			/// <summary>Vector 2D parameter for the scale and bias to compute the depth slice of a light cluster.</summary>
+			Clusters_DepthSlicing,
+
 			/// <summary>Cube map parameter for default skybox shader.</summary>
 			Skybox_CubeMap,
 
@@ -257,6 +276,9 @@ namespace ae
 		/// <returns>The calling material after the copy.</returns>
 		Material& operator=( const Material& _Other );
 
+		/// <summary>Give back the uniform block slot of the material to its pool.</summary>
+		~Material();
+
 		/// <summary>
 		/// Add a shader parameter to the material.<para/>
 		/// If a parameter with the same name exists, the stored one will be removed  (and freed if it's managed by material)
@@ -312,6 +334,14 @@ namespace ae
 		/// <param name="_ImageUnit">The target image unit in the shader for the parameter.</param>
 		void Clean( const Shader& _Shader, AE_InOut Uint32& _TextureUnit, AE_InOut Uint32& _ImageUnit ) const;
 
+		/// <summary>
+		/// Is the material currently sending its parameters with a uniform buffer ?<para/>
+		/// Always the case when the shader declares a "MaterialParameters" uniform block : the members of the block have no
+		/// uniform location to be sent one by one. The buffer is uploaded again only when a parameter changed.
+		/// </summary>
+		/// <returns>True if the material has a slot in a uniform block pool, False otherwise.</returns>
+		Bool IsUsingUniformBlock() const;
+
 		/// <summary>
 		/// Retrieve a parameter with the given <paramref name="_Name"/> in the material.<para/>
 		/// Return nullptr if the parameter is not found.
@@ -563,6 +593,54 @@ namespace ae
 		/// <returns>The shader that the material is using. Can be null.</returns>
 		const Shader* GetShader() const;
 
+		/// <summary>
+		/// Set the shader to use when this material is applied to an instanced drawable.<para/>
+		/// It must read the model matrix from the per-instance attributes instead of the Model uniform.
+		/// </summary>
+		/// <param name="_Shader">The new instanced shader to use. Can be null.</param>
+		void SetInstancedShader( const Shader* _Shader );
+
+		/// <summary>Retrieve the shader used when this material is applied to an instanced drawable.</summary>
+		/// <returns>The instanced shader of the material. Can be null.</returns>
+		const Shader* GetInstancedShader() const;
+
+		/// <summary>
+		/// Set a preprocessor define injected in the shaders of the material.<para/>
+		/// The material is drawn with a variant of its shaders compiled with its defines.
+		/// </summary>
+		/// <param name="_Name">Name of the define.</param>
+		/// <param name="_Value">Value of the define.</param>
+		void SetShaderDefine( const std::string& _Name, const std::string& _Value = "1" );
+
+		/// <summary>Remove a preprocessor define from the shaders of the material.</summary>
+		/// <param name="_Name">Name of the define to remove.</param>
+		void RemoveShaderDefine( const std::string& _Name );
+
+		/// <summary>Retrieve the preprocessor defines injected in the shaders of the material.</summary>
+		/// <returns>Defines of the material.</returns>
+		const Shader::DefinesMap& GetShaderDefines() const;
+
+		/// <summary>
+		/// Draw the material with variants of its shaders specialized for the static flags of its parameters (disabled by default).<para/>
+		/// Each flag (a texture slot filled or not for example) is defined as VARIANT_[uniform name] to true or false,
+		/// a shader can replace the uniform by the define so its branches are removed at compilation.<para/>
+		/// A variant is compiled each time a new combination of flags is drawn, better for flags that rarely change.
+		/// </summary>
+		/// <param name="_Enabled">True to select a variant from the flags, False to use the shaders as is.</param>
+		void SetShaderVariantsEnabled( Bool _Enabled );
+
+		/// <summary>Are the shaders specialized for the static flags of the parameters ?</summary>
+		/// <returns>True if the variants are enabled, False otherwise.</returns>
+		Bool AreShaderVariantsEnabled() const;
+
+		/// <summary>
+		/// Retrieve the shader to draw with : the variant of the shader (or instanced shader) matching the defines and the flags of the material.<para/>
+		/// The selection is cached and done again only when a flag changes.
+		/// </summary>
+		/// <param name="_Instanced">Is the drawable instanced ?</param>
+		/// <returns>The shader to draw the material with. Can be null.</returns>
+		const Shader* SelectShader( Bool _Instanced ) const;
+
 		/// <summary>Is the material has been created by the drawable that hold it ?</summary>
 		/// <returns>True if the material is an instance, False otherwise.</returns>
 		Bool IsInstance() const;
@@ -623,11 +701,54 @@ namespace ae
 		/// <param name="_Other">Other material to copy.</param>
 		void CopyMaterial( const Material& _Other );
 
+		/// <summary>
+		/// Read the uniform block layout of the shader, take a slot in the pool of this layout and
+		/// sort the parameters between the ones stored in the block and the ones still sent one by one.
+		/// </summary>
+		/// <param name="_Shader">Shader to read the block from.</param>
+		void BuildUniformBlock( const Shader& _Shader ) const;
+
+		/// <summary>Upload the uniform block if a parameter changed, bind it and send the parameters outside the block.</summary>
+		/// <param name="_Shader">Shader to send the parameters to.</param>
+		/// <param name="_TextureUnit">Texture unit to use with texture parameters bound as texture. Incremented for each texture sent.</param>
+		/// <param name="_ImageUnit">Image unit to use with texture parameters bound as image. Incremented for each image sent.</param>
+		void SendUniformBlock( const Shader& _Shader, AE_InOut Uint32& _TextureUnit, AE_InOut Uint32& _ImageUnit ) const;
+
+		/// <summary>
+		/// Check that the uniform block can be used with the program of <paramref name="_Shader"/>.<para/>
+		/// Build it again if the program has a different block layout.
+		/// </summary>
+		/// <param name="_Shader">Shader the parameters will be sent to.</param>
+		void ValidateUniformBlock( const Shader& _Shader ) const;
+
+		/// <summary>Give back the uniform block slot and ask for a rebuild at the next draw.</summary>
+		void ReleaseUniformBlock() const;
+
+		/// <summary>Forget the selected variants, the flags and the shaders are read again at the next draw.</summary>
+		void ResetShaderVariants() const;
+
+	private:
+		/// <summary>Variant selected for a shader of the material.</summary>
+		struct ShaderVariantSelection
+		{
+			/// <summary>Shader the variant has been selected from.</summary>
+			const Shader* BaseShader = nullptr;
+
+			/// <summary>Values of the flags the variant has been selected with, one bit per flag.</summary>
+			Uint64 Flags = 0;
+
+			/// <summary>Selected variant, null if not selected yet.</summary>
+			const Shader* Variant = nullptr;
+		};
+
 
 	private:
 		/// <summary>Shader to use when rendering.</summary>
 		const Shader* m_ShaderRef;
 
+		/// <summary>Shader to use when rendering an instanced drawable.</summary>
+		const Shader* m_InstancedShaderRef;
+
 		/// <summary>Shader parameters (uniforms).</summary>
 		std::unordered_map<std::string, ShaderParameter*> m_Parameters;
 
@@ -642,6 +763,45 @@ namespace ae
 
 		/// <summary>Must the renderer send the camera data (matrices, far, near, position, ...) to the material shader ?</summary>
 		Bool m_NeedCamera;
+
+		/// <summary>Must the uniform block be built again before the next draw ? (Parameters or shader changed)</summary>
+		mutable Bool m_MustBuildUniformBlock;
+
+		/// <summary>Programs (ID and revision) the uniform block has been checked against. They all share the same block layout.</summary>
+		mutable std::vector<Uint64> m_UniformBlockPrograms;
+
+		/// <summary>Pool holding the uniform block of the material. Null if the material doesn't use a uniform block.</summary>
+		mutable priv::UniformBlockPool* m_UniformBlockPool;
+
+		/// <summary>Slot of the material in the uniform block pool.</summary>
+		mutable Uint32 m_UniformBlockSlot;
+
+		/// <summary>CPU copy of the uniform block.</summary>
+		mutable std::vector<Uint8> m_UniformBlockData;
+
+		/// <summary>Parameters entirely stored in the uniform block.</summary>
+		mutable std::vector<ShaderParameter*> m_BlockParameters;
+
+		/// <summary>Parameters that must still be sent one by one (textures, uniforms outside the block).</summary>
+		mutable std::vector<ShaderParameter*> m_SentParameters;
+
+		/// <summary>Versions of the block parameters then of the sent parameters at the last upload of the uniform block.</summary>
+		mutable std::vector<Uint32> m_UploadedVersions;
+
+		/// <summary>Preprocessor defines injected in the shaders.</summary>
+		Shader::DefinesMap m_ShaderDefines;
+
+		/// <summary>Are the shaders specialized for the static flags of the parameters ?</summary>
+		Bool m_AreShaderVariantsEnabled;
+
+		/// <summary>Must the parameters with a flag be listed again ?</summary>
+		mutable Bool m_MustListVariantParameters;
+
+		/// <summary>Parameters with a static flag, the first 64 ones select the variant.</summary>
+		mutable std::vector<const ShaderParameter*> m_VariantParameters;
+
+		/// <summary>Variants selected for the shader and the instanced shader.</summary>
+		mutable std::array<ShaderVariantSelection, 2> m_ShaderVariants;
 	};
 } // ae
 
@@ -0,0 +1,459 @@
+#include "CookedMesh.h"
+
+#pragma warning( push )
+#pragma warning( disable : 26812 )
+
+#include <assimp/material.h>
+
+#pragma warning( pop )
+
+#ifdef WINDOWS
+#include <Windows.h>
+#elif defined( LINUX )
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <cstring>
+#include <limits>
+
+namespace ae
+{
+	namespace priv
+	{
+		namespace
+		{
+			/// <summary>"AEMS" read as a little endian integer.</summary>
+			constexpr Uint32 CookedMeshMagic = 0x534D4541;
+
+			/// <summary>Layout of the beginning of a cooked file.</summary>
+			struct CookedMeshHeader
+			{
+				Uint32 Magic;
+				Uint32 Version;
+				Uint64 SourceHash;
+				Uint32 ImportFlags;
+				Uint32 VertexSize;
+				Uint32 VerticesCount;
+				Uint32 IndicesCount;
+				Uint32 IndexSize;
+				Uint32 LODsCount;
+				float BoundsMin[3];
+				float BoundsMax[3];
+				Uint32 MaterialSize;
+				Uint32 Padding;
+			};
+
+			static_assert( sizeof( CookedMeshHeader ) == 72, "The header of cooked meshes must not have hidden padding." );
+			static_assert( sizeof( MeshLOD ) == 12, "The levels of detail of cooked meshes must not have hidden padding." );
+
+			/// <summary>Round a size to the next multiple of 4 bytes.</summary>
+			inline Uint64 AlignSize( Uint64 _Size )
+			{
+				return ( _Size + 3 ) & ~Cast( Uint64, 3 );
+			}
+
+			/// <summary>Offset of the vertices in the file.</summary>
+			inline Uint64 GetVerticesOffset( const CookedMeshHeader& _Header )
+			{
+				return sizeof( CookedMeshHeader ) + Cast( Uint64, _Header.LODsCount ) * sizeof( MeshLOD );
+			}
+
+			/// <summary>Offset of the indices in the file.</summary>
+			inline Uint64 GetIndicesOffset( const CookedMeshHeader& _Header )
+			{
+				return GetVerticesOffset( _Header ) + Cast( Uint64, _Header.VerticesCount ) * _Header.VertexSize;
+			}
+
+			/// <summary>Offset of the material description in the file.</summary>
+			inline Uint64 GetMaterialOffset( const CookedMeshHeader& _Header )
+			{
+				return GetIndicesOffset( _Header ) + AlignSize( Cast( Uint64, _Header.IndicesCount ) * _Header.IndexSize );
+			}
+
+			/// <summary>Map a file in memory, or read it in <paramref name="_Buffer"/> if the platform can not map it.</summary>
+			Bool OpenFileView( const std::string& _File, AE_Out const Uint8*& _Data, AE_Out Uint64& _Size, AE_Out std::vector<Uint8>& _Buffer )
+			{
+				_Data = nullptr;
+				_Size = 0;
+
+#ifdef WINDOWS
+				HANDLE File = CreateFileA( _File.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+				if( File == INVALID_HANDLE_VALUE )
+					return False;
+
+				LARGE_INTEGER FileSize;
+				if( !GetFileSizeEx( File, &FileSize ) || FileSize.QuadPart == 0 )
+				{
+					CloseHandle( File );
+					return False;
+				}
+
+				// The view keeps the mapping alive, the handles can be closed right away.
+				HANDLE Mapping = CreateFileMappingA( File, NULL, PAGE_READONLY, 0, 0, NULL );
+				CloseHandle( File );
+
+				if( Mapping == NULL )
+					return False;
+
+				const void* View = MapViewOfFile( Mapping, FILE_MAP_READ, 0, 0, 0 );
+				CloseHandle( Mapping );
+
+				if( View == nullptr )
+					return False;
+
+				_Data = Cast( const Uint8*, View );
+				_Size = Cast( Uint64, FileSize.QuadPart );
+				return True;
+
+#elif defined( LINUX )
+				const int File = open( _File.c_str(), O_RDONLY );
+				if( File < 0 )
+					return False;
+
+				struct stat FileStat;
+				if( fstat( File, &FileStat ) != 0 || FileStat.st_size == 0 )
+				{
+					close( File );
+					return False;
+				}
+
+				void* View = mmap( nullptr, Cast( size_t, FileStat.st_size ), PROT_READ, MAP_PRIVATE, File, 0 );
+				close( File );
+
+				if( View == MAP_FAILED )
+					return False;
+
+				_Data = Cast( const Uint8*, View );
+				_Size = Cast( Uint64, FileStat.st_size );
+				return True;
+
+#else
+				std::ifstream File( _File, std::ios::binary | std::ios::ate );
+				if( !File.is_open() )
+					return False;
+
+				const std::streampos FileLength = File.tellg();
+				if( FileLength <= 0 )
+					return False;
+
+				_Buffer.resize( Cast( size_t, FileLength ) );
+				File.seekg( 0 );
+				File.read( reinterpret_cast<char*>( _Buffer.data() ), FileLength );
+
+				_Data = _Buffer.data();
+				_Size = _Buffer.size();
+				return True;
+#endif
+			}
+
+			/// <summary>Unmap or free a file opened with OpenFileView.</summary>
+			void CloseFileView( const Uint8* _Data, Uint64 _Size, AE_InOut std::vector<Uint8>& _Buffer )
+			{
+				if( _Data == nullptr )
+					return;
+
+				if( !_Buffer.empty() )
+				{
+					std::vector<Uint8>().swap( _Buffer );
+					return;
+				}
+
+#ifdef WINDOWS
+				UnmapViewOfFile( _Data );
+#elif defined( LINUX )
+				munmap( const_cast<Uint8*>( _Data ), Cast( size_t, _Size ) );
+#endif
+			}
+
+			/// <summary>Append a value to a byte array.</summary>
+			template<typename T>
+			void WriteValue( AE_InOut std::vector<Uint8>& _Bytes, const T& _Value )
+			{
+				const Uint8* Bytes = reinterpret_cast<const Uint8*>( &_Value );
+				_Bytes.insert( _Bytes.end(), Bytes, Bytes + sizeof( T ) );
+			}
+
+			/// <summary>Read a value from a byte array and advance the cursor. Fails if the value goes past the end.</summary>
+			template<typename T>
+			Bool ReadValue( AE_Out T& _Value, AE_InOut const Uint8*& _Cursor, const Uint8* _End )
+			{
+				if( Cast( Uint64, _End - _Cursor ) < sizeof( T ) )
+					return False;
+
+				std::memcpy( &_Value, _Cursor, sizeof( T ) );
+				_Cursor += sizeof( T );
+				return True;
+			}
+
+			/// <summary>Serialize all the properties of an Assimp material.</summary>
+			void WriteMaterial( AE_Out std::vector<Uint8>& _Bytes, const aiMaterial& _Material )
+			{
+				WriteValue( _Bytes, Cast( Uint32, _Material.mNumProperties ) );
+
+				for( unsigned int p = 0; p < _Material.mNumProperties; p++ )
+				{
+					const aiMaterialProperty& Property = *_Material.mProperties[p];
+
+					WriteValue( _Bytes, Cast( Uint32, Property.mKey.length ) );
+					_Bytes.insert( _Bytes.end(), Property.mKey.data, Property.mKey.data + Property.mKey.length );
+
+					WriteValue( _Bytes, Cast( Uint32, Property.mSemantic ) );
+					WriteValue( _Bytes, Cast( Uint32, Property.mIndex ) );
+					WriteValue( _Bytes, Cast( Uint32, Property.mType ) );
+					WriteValue( _Bytes, Cast( Uint32, Property.mDataLength ) );
+
+					const Uint8* Data = reinterpret_cast<const Uint8*>( Property.mData );
+					_Bytes.insert( _Bytes.end(), Data, Data + Property.mDataLength );
+				}
+			}
+		}
+
+		std::string CookedMesh::GetCookedPath( const std::string& _SourceFile )
+		{
+			return _SourceFile + Extension;
+		}
+
+		Bool CookedMesh::HashFile( AE_Out Uint64& _Hash, const std::string& _File )
+		{
+			const Uint8* Data = nullptr;
+			Uint64 Size = 0;
+			std::vector<Uint8> Buffer;
+
+			if( !OpenFileView( _File, Data, Size, Buffer ) )
+				return False;
+
+			// FNV-1a, 64 bits.
+			_Hash = 14695981039346656037ull;
+			for( Uint64 b = 0; b < Size; b++ )
+			{
+				_Hash ^= Data[b];
+				_Hash *= 1099511628211ull;
+			}
+
+			CloseFileView( Data, Size, Buffer );
+
+			return True;
+		}
+
+		Bool CookedMesh::Write( const std::string& _CookedFile, Uint64 _SourceHash, Uint32 _ImportFlags,
+								const Vertex3DArray& _Vertices, const std::vector<Uint32>& _Indices, const std::vector<MeshLOD>& _LODs,
+								const Vector3& _BoundsMin, const Vector3& _BoundsMax, const aiMaterial* _Material )
+		{
+			CookedMeshHeader Header;
+			std::memset( &Header, 0, sizeof( CookedMeshHeader ) );
+
+			Header.Magic = CookedMeshMagic;
+			Header.Version = FormatVersion;
+			Header.SourceHash = _SourceHash;
+			Header.ImportFlags = _ImportFlags;
+			Header.VertexSize = sizeof( Vertex3D );
+			Header.VerticesCount = Cast( Uint32, _Vertices.size() );
+			Header.IndicesCount = Cast( Uint32, _Indices.size() );
+			Header.LODsCount = Cast( Uint32, _LODs.size() );
+
+			// Halve the indices when all the vertices can be addressed with 16 bits.
+			const Bool UseShortIndices = _Vertices.size() <= Cast( size_t, std::numeric_limits<Uint16>::max() ) + 1;
+			Header.IndexSize = UseShortIndices ? sizeof( Uint16 ) : sizeof( Uint32 );
+
+			Header.BoundsMin[0] = _BoundsMin.X;
+			Header.BoundsMin[1] = _BoundsMin.Y;
+			Header.BoundsMin[2] = _BoundsMin.Z;
+			Header.BoundsMax[0] = _BoundsMax.X;
+			Header.BoundsMax[1] = _BoundsMax.Y;
+			Header.BoundsMax[2] = _BoundsMax.Z;
+
+			std::vector<Uint8> MaterialBytes;
+			if( _Material != nullptr )
+				WriteMaterial( MaterialBytes, *_Material );
+
+			Header.MaterialSize = Cast( Uint32, MaterialBytes.size() );
+
+			std::ofstream File( _CookedFile, std::ios::binary | std::ios::trunc );
+			if( !File.is_open() )
+				return False;
+
+			File.write( reinterpret_cast<const char*>( &Header ), sizeof( CookedMeshHeader ) );
+			File.write( reinterpret_cast<const char*>( _LODs.data() ), _LODs.size() * sizeof( MeshLOD ) );
+			File.write( reinterpret_cast<const char*>( _Vertices.data() ), _Vertices.size() * sizeof( Vertex3D ) );
+
+			if( UseShortIndices )
+			{
+				std::vector<Uint16> ShortIndices( _Indices.begin(), _Indices.end() );
+				File.write( reinterpret_cast<const char*>( ShortIndices.data() ), ShortIndices.size() * sizeof( Uint16 ) );
+			}
+			else
+				File.write( reinterpret_cast<const char*>( _Indices.data() ), _Indices.size() * sizeof( Uint32 ) );
+
+			const Uint64 IndicesSize = Cast( Uint64, _Indices.size() ) * Header.IndexSize;
+			const Uint32 Padding = 0;
+			File.write( reinterpret_cast<const char*>( &Padding ), AlignSize( IndicesSize ) - IndicesSize );
+
+			File.write( reinterpret_cast<const char*>( MaterialBytes.data() ), MaterialBytes.size() );
+
+			return File.good();
+		}
+
+		CookedMesh::CookedMesh() :
+			m_Data( nullptr ),
+			m_Size( 0 )
+		{
+		}
+
+		CookedMesh::~CookedMesh()
+		{
+			Close();
+		}
+
+		Bool CookedMesh::Open( const std::string& _CookedFile, Uint64 _SourceHash, Uint32 _ImportFlags )
+		{
+			Close();
+
+			if( !OpenFileView( _CookedFile, m_Data, m_Size, m_Buffer ) )
+				return False;
+
+			if( m_Size < sizeof( CookedMeshHeader ) )
+			{
+				Close();
+				return False;
+			}
+
+			const CookedMeshHeader& Header = *reinterpret_cast<const CookedMeshHeader*>( m_Data );
+
+			const Bool IsValid = Header.Magic == CookedMeshMagic
+				&& Header.Version == FormatVersion
+				&& Header.VertexSize == sizeof( Vertex3D )
+				&& ( Header.IndexSize == sizeof( Uint16 ) || Header.IndexSize == sizeof( Uint32 ) )
+				&& Header.SourceHash == _SourceHash
+				&& Header.ImportFlags == _ImportFlags
+				&& GetMaterialOffset( Header ) + Header.MaterialSize <= m_Size;
+
+			if( !IsValid )
+			{
+				Close();
+				return False;
+			}
+
+			return True;
+		}
+
+		void CookedMesh::Close()
+		{
+			CloseFileView( m_Data, m_Size, m_Buffer );
+
+			m_Data = nullptr;
+			m_Size = 0;
+		}
+
+		const Vertex3D* CookedMesh::GetVertices() const
+		{
+			const CookedMeshHeader& Header = *reinterpret_cast<const CookedMeshHeader*>( m_Data );
+			return reinterpret_cast<const Vertex3D*>( m_Data + GetVerticesOffset( Header ) );
+		}
+
+		Uint32 CookedMesh::GetVerticesCount() const
+		{
+			return reinterpret_cast<const CookedMeshHeader*>( m_Data )->VerticesCount;
+		}
+
+		const void* CookedMesh::GetIndices() const
+		{
+			const CookedMeshHeader& Header = *reinterpret_cast<const CookedMeshHeader*>( m_Data );
+			return m_Data + GetIndicesOffset( Header );
+		}
+
+		Uint32 CookedMesh::GetIndicesCount() const
+		{
+			return reinterpret_cast<const CookedMeshHeader*>( m_Data )->IndicesCount;
+		}
+
+		Uint32 CookedMesh::GetIndexSize() const
+		{
+			return reinterpret_cast<const CookedMeshHeader*>( m_Data )->IndexSize;
+		}
+
+		void CookedMesh::ReadIndices( AE_Out std::vector<Uint32>& _Indices ) const
+		{
+			const Uint32 IndicesCount = GetIndicesCount();
+
+			if( GetIndexSize() == sizeof( Uint32 ) )
+			{
+				const Uint32* Indices = Cast( const Uint32*, GetIndices() );
+				_Indices.assign( Indices, Indices + IndicesCount );
+			}
+			else
+			{
+				const Uint16* Indices = Cast( const Uint16*, GetIndices() );
+				_Indices.assign( Indices, Indices + IndicesCount );
+			}
+		}
+
+		void CookedMesh::ReadLODs( AE_Out std::vector<MeshLOD>& _LODs ) const
+		{
+			const CookedMeshHeader& Header = *reinterpret_cast<const CookedMeshHeader*>( m_Data );
+			const MeshLOD* LODs = reinterpret_cast<const MeshLOD*>( m_Data + sizeof( CookedMeshHeader ) );
+
+			_LODs.assign( LODs, LODs + Header.LODsCount );
+		}
+
+		Vector3 CookedMesh::GetBoundsMin() const
+		{
+			const CookedMeshHeader& Header = *reinterpret_cast<const CookedMeshHeader*>( m_Data );
+			return Vector3( Header.BoundsMin[0], Header.BoundsMin[1], Header.BoundsMin[2] );
+		}
+
+		Vector3 CookedMesh::GetBoundsMax() const
+		{
+			const CookedMeshHeader& Header = *reinterpret_cast<const CookedMeshHeader*>( m_Data );
+			return Vector3( Header.BoundsMax[0], Header.BoundsMax[1], Header.BoundsMax[2] );
+		}
+
+		aiMaterial* CookedMesh::CreateMaterial() const
+		{
+			const CookedMeshHeader& Header = *reinterpret_cast<const CookedMeshHeader*>( m_Data );
+
+			if( Header.MaterialSize == 0 )
+				return nullptr;
+
+			const Uint8* Cursor = m_Data + GetMaterialOffset( Header );
+			const Uint8* End = Cursor + Header.MaterialSize;
+
+			Uint32 PropertiesCount = 0;
+			if( !ReadValue( PropertiesCount, Cursor, End ) )
+				return nullptr;
+
+			aiMaterial* Material = new aiMaterial();
+
+			for( Uint32 p = 0; p < PropertiesCount; p++ )
+			{
+				Uint32 KeyLength = 0;
+				if( !ReadValue( KeyLength, Cursor, End ) || Cast( Uint64, End - Cursor ) < KeyLength )
+					break;
+
+				const std::string Key( reinterpret_cast<const char*>( Cursor ), KeyLength );
+				Cursor += KeyLength;
+
+				Uint32 Semantic = 0;
+				Uint32 Index = 0;
+				Uint32 Type = 0;
+				Uint32 DataLength = 0;
+
+				if( !ReadValue( Semantic, Cursor, End ) || !ReadValue( Index, Cursor, End ) || !ReadValue( Type, Cursor, End ) || !ReadValue( DataLength, Cursor, End ) )
+					break;
+
+				if( Cast( Uint64, End - Cursor ) < DataLength )
+					break;
+
+				Material->AddBinaryProperty( Cursor, DataLength, Key.c_str(), Semantic, Index, Cast( aiPropertyTypeInfo, Type ) );
+				Cursor += DataLength;
+			}
+
+			return Material;
+		}
+
+	} // priv
+
+} // ae
@@ -0,0 +1,153 @@
+#ifndef _COOKEDMESH_AERO_H_
+#define _COOKEDMESH_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../../Idioms/NotCopiable/NotCopiable.h"
+#include "../../../Maths/Vector/Vector3.h"
+#include "../../Vertex/VertexArray.h"
+
+#include <vector>
+#include <string>
+
+// Pre-declaration of Assimp material structure.
+struct aiMaterial;
+
+namespace ae
+{
+	namespace priv
+	{
+		/// \ingroup graphics
+		/// <summary>Range of indices drawing one level of detail of a mesh.</summary>
+		struct MeshLOD
+		{
+			/// <summary>First index of the level in the index buffer.</summary>
+			Uint32 FirstIndex = 0;
+
+			/// <summary>Count of indices of the level.</summary>
+			Uint32 IndicesCount = 0;
+
+			/// <summary>Maximum distance between the level and the full mesh, in model space. 0 for the full mesh.</summary>
+			float Error = 0.0f;
+		};
+
+		/// \ingroup graphics
+		/// <summary>
+		/// Packed binary version of a 3D file, written next to the source file with the ".aemesh" extension.<para/>
+		/// Holds the vertices as they are sent to the GPU, the indices (16 bits when possible), the bounds,
+		/// the levels of detail and the material description.<para/>
+		/// The file is memory mapped and validated against the hash of the source file and the import flags,
+		/// a cooked file older than its source is ignored.
+		/// </summary>
+		/// <seealso cref="SharedGeometry" />
+		class AERO_CORE_EXPORT CookedMesh : public NotCopiable
+		{
+		public:
+			/// <summary>Extension added to the source file path to get the cooked file path.</summary>
+			static constexpr const char* Extension = ".aemesh";
+
+			/// <summary>Version of the format, increase it when the layout of the file or of Vertex3D changes.</summary>
+			static constexpr Uint32 FormatVersion = 3;
+
+		public:
+			/// <summary>Get the path of the cooked file of a source file.</summary>
+			/// <param name="_SourceFile">Path to the source 3D file.</param>
+			/// <returns>Path to the cooked file.</returns>
+			static std::string GetCookedPath( const std::string& _SourceFile );
+
+			/// <summary>Hash the content of a file.</summary>
+			/// <param name="_Hash">Hash of the file content.</param>
+			/// <param name="_File">File to hash.</param>
+			/// <returns>True if the file could be read, False otherwise.</returns>
+			static Bool HashFile( AE_Out Uint64& _Hash, const std::string& _File );
+
+			/// <summary>Write a cooked file. Doesn't log, can be called from any thread.</summary>
+			/// <param name="_CookedFile">Path of the cooked file to write.</param>
+			/// <param name="_SourceHash">Hash of the source file content.</param>
+			/// <param name="_ImportFlags">Assimp post process flags used to import the source file.</param>
+			/// <param name="_Vertices">Vertices of the mesh.</param>
+			/// <param name="_Indices">Indices of the mesh.</param>
+			/// <param name="_LODs">Levels of detail, ranges in <paramref name="_Indices"/>.</param>
+			/// <param name="_BoundsMin">Minimum corner of the bounding box of the mesh.</param>
+			/// <param name="_BoundsMax">Maximum corner of the bounding box of the mesh.</param>
+			/// <param name="_Material">Material description to save. Can be null.</param>
+			/// <returns>True if the file has been written, False otherwise.</returns>
+			static Bool Write( const std::string& _CookedFile, Uint64 _SourceHash, Uint32 _ImportFlags,
+							   const Vertex3DArray& _Vertices, const std::vector<Uint32>& _Indices, const std::vector<MeshLOD>& _LODs,
+							   const Vector3& _BoundsMin, const Vector3& _BoundsMax, const aiMaterial* _Material );
+
+		public:
+			/// <summary>Build a closed cooked mesh.</summary>
+			CookedMesh();
+
+			/// <summary>Unmap the file.</summary>
+			~CookedMesh();
+
+			/// <summary>
+			/// Map a cooked file and check it has been cooked from the expected source.<para/>
+			/// Fails silently if the file doesn't exist or is outdated, the caller is expected to cook it again.
+			/// </summary>
+			/// <param name="_CookedFile">Path of the cooked file.</param>
+			/// <param name="_SourceHash">Hash of the current source file content.</param>
+			/// <param name="_ImportFlags">Assimp post process flags expected.</param>
+			/// <returns>True if the file is valid and mapped, False otherwise.</returns>
+			Bool Open( const std::string& _CookedFile, Uint64 _SourceHash, Uint32 _ImportFlags );
+
+			/// <summary>Unmap the file.</summary>
+			void Close();
+
+			/// <summary>Retrieve the vertices, pointing in the mapped file.</summary>
+			/// <returns>Vertices of the mesh.</returns>
+			const Vertex3D* GetVertices() const;
+
+			/// <summary>Get the count of vertices.</summary>
+			/// <returns>Count of vertices.</returns>
+			Uint32 GetVerticesCount() const;
+
+			/// <summary>Retrieve the indices, pointing in the mapped file.</summary>
+			/// <returns>Indices of the mesh, 16 or 32 bits wide.</returns>
+			const void* GetIndices() const;
+
+			/// <summary>Get the count of indices.</summary>
+			/// <returns>Count of indices.</returns>
+			Uint32 GetIndicesCount() const;
+
+			/// <summary>Get the size of one index.</summary>
+			/// <returns>2 or 4 bytes.</returns>
+			Uint32 GetIndexSize() const;
+
+			/// <summary>Read the indices as 32 bits values.</summary>
+			/// <param name="_Indices">Array to fill with the indices.</param>
+			void ReadIndices( AE_Out std::vector<Uint32>& _Indices ) const;
+
+			/// <summary>Read the levels of detail of the mesh.</summary>
+			/// <param name="_LODs">Array to fill with the levels of detail.</param>
+			void ReadLODs( AE_Out std::vector<MeshLOD>& _LODs ) const;
+
+			/// <summary>Get the minimum corner of the bounding box of the mesh.</summary>
+			/// <returns>Minimum corner.</returns>
+			Vector3 GetBoundsMin() const;
+
+			/// <summary>Get the maximum corner of the bounding box of the mesh.</summary>
+			/// <returns>Maximum corner.</returns>
+			Vector3 GetBoundsMax() const;
+
+			/// <summary>Rebuild the material description saved in the file.</summary>
+			/// <returns>New material, to delete by the caller. Null if the file has no material.</returns>
+			aiMaterial* CreateMaterial() const;
+
+		private:
+			/// <summary>Beginning of the mapped file.</summary>
+			const Uint8* m_Data;
+
+			/// <summary>Size in bytes of the mapped file.</summary>
+			Uint64 m_Size;
+
+			/// <summary>Content of the file when it can not be mapped.</summary>
+			std::vector<Uint8> m_Buffer;
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _COOKEDMESH_AERO_H_
@@ -0,0 +1,214 @@
+#include "InstancedMesh.h"
+
+#include "Mesh3D.h"
+#include "../../../Aero/Aero.h"
+#include "../../../Debugging/Debugging.h"
+#include "../../Material/BlinnPhongMaterial.h"
+
+#include "../../../Editor/TypesToEditor/MaterialToEditor.h"
+
+namespace ae
+{
+	// The instance buffer is filled directly with the matrices data.
+	static_assert( sizeof( Matrix4x4 ) == 16 * sizeof( float ), "Matrix4x4 must be tightly packed to be used as instance attribute." );
+
+	InstancedMesh::InstancedMesh( const Mesh3D& _Mesh ) :
+		Drawable( BufferType::Static, AttributePointer::Default3D ),
+		m_MeshRef( nullptr ),
+		m_InstanceBufferObject( 0 ),
+		m_InstancesCount( 0 )
+	{
+		if( Aero.CheckContext() )
+		{
+			// The vertex and index buffers are the ones of the mesh, free the ones created by the drawable.
+			glDeleteBuffers( 1, &m_VertexBufferObject );
+			AE_ErrorCheckOpenGLError();
+
+			glDeleteBuffers( 1, &m_ElementsArrayObject );
+			AE_ErrorCheckOpenGLError();
+
+			glGenBuffers( 1, &m_InstanceBufferObject );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		m_VertexBufferObject = 0;
+		m_ElementsArrayObject = 0;
+
+		SetMaterial( *Aero.GetResourcesManager().GetDefault3DMaterial() );
+
+		SetMesh( _Mesh );
+
+		SetName( std::string( "InstancedMesh_" ) + std::to_string( GetObjectID() ) );
+	}
+
+	InstancedMesh::~InstancedMesh()
+	{
+		// Buffers owned by the mesh, don't let the drawable destroy them.
+		m_VertexBufferObject = 0;
+		m_ElementsArrayObject = 0;
+
+		if( !Aero.CheckContext() )
+			return;
+
+		if( m_InstanceBufferObject )
+		{
+			glDeleteBuffers( 1, &m_InstanceBufferObject );
+			AE_ErrorCheckOpenGLError();
+			m_InstanceBufferObject = 0;
+		}
+	}
+
+	void InstancedMesh::SetMesh( const Mesh3D& _Mesh )
+	{
+		m_MeshRef = &_Mesh;
+
+		m_VertexBufferObject = _Mesh.GetVertexBufferObject();
+		m_ElementsArrayObject = _Mesh.GetElementsArrayObject();
+		m_AttributePointerTags = _Mesh.GetAttributePointerTags();
+		m_VertexBufferAttributes = _Mesh.GetVertexBufferAttributes();
+		m_PrimitiveType = _Mesh.GetPrimitiveType();
+
+		LinkBuffers();
+		ApplyChanges();
+	}
+
+	const Mesh3D& InstancedMesh::GetMesh() const
+	{
+		return *m_MeshRef;
+	}
+
+	Uint32 InstancedMesh::AddInstance( const Matrix4x4& _Transform )
+	{
+		m_Instances.push_back( _Transform );
+
+		return Cast( Uint32, m_Instances.size() - 1 );
+	}
+
+	void InstancedMesh::SetInstance( Uint32 _Index, const Matrix4x4& _Transform )
+	{
+		m_Instances[_Index] = _Transform;
+	}
+
+	const Matrix4x4& InstancedMesh::GetInstance( Uint32 _Index ) const
+	{
+		return m_Instances[_Index];
+	}
+
+	void InstancedMesh::RemoveInstance( Uint32 _Index )
+	{
+		if( _Index >= m_Instances.size() )
+		{
+			AE_LogWarning( "Trying to remove an instance that doesn't exist." );
+			return;
+		}
+
+		m_Instances[_Index] = m_Instances.back();
+		m_Instances.pop_back();
+	}
+
+	void InstancedMesh::ClearInstances()
+	{
+		m_Instances.clear();
+	}
+
+	const InstancedMesh::InstanceArray& InstancedMesh::GetInstances() const
+	{
+		return m_Instances;
+	}
+
+	void InstancedMesh::ApplyChanges()
+	{
+		m_VerticesCount = m_MeshRef->GetVerticesCount();
+		m_IndicesCount = m_MeshRef->GetIndicesCount();
+		m_FirstIndex = m_MeshRef->GetFirstIndex();
+		m_IndexType = m_MeshRef->GetIndexType();
+
+		// Bounds of all the instances : the instances are drawn in one call, culled all together or not at all.
+		AABB Bounds;
+
+		for( const Matrix4x4& Instance : m_Instances )
+			Bounds.Grow( m_MeshRef->GetLocalBounds().GetTransformed( Instance ) );
+
+		SetLocalBounds( Bounds );
+
+		if( !Aero.CheckContext() )
+			return;
+
+		glBindBuffer( GL_ARRAY_BUFFER, m_InstanceBufferObject );
+		AE_ErrorCheckOpenGLError();
+
+		glBufferData( GL_ARRAY_BUFFER, m_Instances.size() * sizeof( Matrix4x4 ), m_Instances.data(), Cast( GLenum, m_BufferType ) );
+		AE_ErrorCheckOpenGLError();
+
+		glBindBuffer( GL_ARRAY_BUFFER, 0 );
+		AE_ErrorCheckOpenGLError();
+
+		m_InstancesCount = Cast( Uint32, m_Instances.size() );
+	}
+
+	Bool InstancedMesh::IsInstanced() const
+	{
+		return True;
+	}
+
+	Uint32 InstancedMesh::GetInstancesCount() const
+	{
+		return m_InstancesCount;
+	}
+
+	void InstancedMesh::ToEditor()
+	{
+		WorldObject::ToEditor();
+		priv::ui::MaterialToEditor( GetMaterial() );
+	}
+
+	void InstancedMesh::LinkBuffers()
+	{
+		if( !Aero.CheckContext() )
+			return;
+
+		glBindVertexArray( m_VertexArrayObject );
+		AE_ErrorCheckOpenGLError();
+
+		// Vertex attributes read from the mesh vertex buffer.
+		// Disable them first, the previous mesh may have used more attributes.
+		for( Uint32 a = 0; a < InstanceMatrixLocation; a++ )
+		{
+			glDisableVertexAttribArray( a );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		// A mesh still loading has no buffer yet, SetMesh must be called again once it is loaded.
+		if( m_VertexBufferObject != 0 )
+		{
+			glBindBuffer( GL_ARRAY_BUFFER, m_VertexBufferObject );
+			AE_ErrorCheckOpenGLError();
+
+			SetupVertex3DAttributes();
+		}
+
+		// The element buffer binding is stored in the vertex array.
+		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ElementsArrayObject );
+		AE_ErrorCheckOpenGLError();
+
+		// Model matrix of the instance, one column per attribute, advanced once per instance.
+		glBindBuffer( GL_ARRAY_BUFFER, m_InstanceBufferObject );
+		AE_ErrorCheckOpenGLError();
+
+		for( Uint32 c = 0; c < 4; c++ )
+		{
+			const Uint32 Location = InstanceMatrixLocation + c;
+
+			glEnableVertexAttribArray( Location ); AE_ErrorCheckOpenGLError();
+			glVertexAttribPointer( Location, 4, GL_FLOAT, GL_FALSE, sizeof( Matrix4x4 ), (GLvoid*)( c * 4 * sizeof( float ) ) ); AE_ErrorCheckOpenGLError();
+			glVertexAttribDivisor( Location, 1 ); AE_ErrorCheckOpenGLError();
+		}
+
+		glBindVertexArray( 0 );
+		AE_ErrorCheckOpenGLError();
+
+		glBindBuffer( GL_ARRAY_BUFFER, 0 );
+		AE_ErrorCheckOpenGLError();
+	}
+
+} // ae
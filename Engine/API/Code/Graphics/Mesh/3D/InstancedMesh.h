@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../../Maths/Matrix/Matrix4x4.h"
+#include "../../Drawable/Drawable.h"
+
+#include <vector>
+
+namespace ae
+{
+	class Mesh3D;
+
+	/// \ingroup graphics
+	/// <summary>
+	/// Draw many copies of a 3D mesh in one draw call.<para/>
+	/// The vertex and index buffers of the mesh are shared, only the transform of each instance is stored
+	/// in a per-instance buffer. The mesh must live longer than the instanced mesh.<para/>
+	/// The material must provide an instanced shader reading the model matrix from the attribute 4 (mat4 over 4 to 7).
+	/// </summary>
+	/// <seealso cref="Mesh3D" />
+	/// <seealso cref="Material::SetInstancedShader" />
+	class AERO_CORE_EXPORT InstancedMesh : public Drawable
+	{
+	public:
+		/// <summary>Alias for array of instances transforms for better readability.</summary>
+		using InstanceArray = std::vector<Matrix4x4>;
+
+		/// <summary>Location of the first column of the instance model matrix in the shaders.</summary>
+		static constexpr Uint32 InstanceMatrixLocation = 4;
+
+	public:
+		/// <summary>Cannot create an instanced mesh without mesh.</summary>
+		InstancedMesh() = delete;
+
+		/// <summary>Build an instanced mesh sharing the buffers of <paramref name="_Mesh"/>, without any instance.</summary>
+		/// <param name="_Mesh">Mesh to draw for each instance.</param>
+		explicit InstancedMesh( const Mesh3D& _Mesh );
+
+		/// <summary>Destructor. The buffers of the mesh are left untouched.</summary>
+		virtual ~InstancedMesh();
+
+		/// <summary>Change the mesh drawn for each instance.</summary>
+		/// <param name="_Mesh">New mesh to draw.</param>
+		void SetMesh( const Mesh3D& _Mesh );
+
+		/// <summary>Retrieve the mesh drawn for each instance.</summary>
+		/// <returns>The mesh drawn for each instance.</returns>
+		const Mesh3D& GetMesh() const;
+
+
+		/// <summary>Add an instance. Call ApplyChanges to send it to the GPU.</summary>
+		/// <param name="_Transform">Model matrix of the new instance.</param>
+		/// <returns>Index of the new instance.</returns>
+		Uint32 AddInstance( const Matrix4x4& _Transform );
+
+		/// <summary>Modify the transform of an instance. Call ApplyChanges to send it to the GPU.</summary>
+		/// <param name="_Index">Index of the instance to modify.</param>
+		/// <param name="_Transform">New model matrix of the instance.</param>
+		void SetInstance( Uint32 _Index, const Matrix4x4& _Transform );
+
+		/// <summary>Retrieve the transform of an instance.</summary>
+		/// <param name="_Index">Index of the instance to retrieve.</param>
+		/// <returns>Model matrix of the instance.</returns>
+		const Matrix4x4& GetInstance( Uint32 _Index ) const;
+
+		/// <summary>
+		/// Remove an instance. The last instance takes its index.<para/>
+		/// Call ApplyChanges to send the modification to the GPU.
+		/// </summary>
+		/// <param name="_Index">Index of the instance to remove.</param>
+		void RemoveInstance( Uint32 _Index );
+
+		/// <summary>Remove all the instances. Call ApplyChanges to send the modification to the GPU.</summary>
+		void ClearInstances();
+
+		/// <summary>Retrieve the transforms of all the instances.</summary>
+		/// <returns>Model matrices of the instances.</returns>
+		const InstanceArray& GetInstances() const;
+
+
+		/// <summary>
+		/// Send the instances transforms to the GPU.<para/>
+		/// Also read again the vertices and indices counts of the mesh, call it after modifying the mesh.
+		/// </summary>
+		void ApplyChanges();
+
+
+		/// <summary>Is the drawable rendered with instancing ?</summary>
+		/// <returns>Always True.</returns>
+		Bool IsInstanced() const override;
+
+		/// <summary>Get the count of instances sent to the GPU.</summary>
+		/// <returns>Count of instances drawn.</returns>
+		Uint32 GetInstancesCount() const override;
+
+
+		/// <summary>
+		/// Function called by the editor.
+		/// It allows the class to expose some attributes for user editing.
+		/// Think to call all inherited class function too when overloading.
+		/// </summary>
+		virtual void ToEditor() override;
+
+	private:
+		/// <summary>Setup the vertex array with the buffers of the mesh and the instance buffer.</summary>
+		void LinkBuffers();
+
+	private:
+		/// <summary>Mesh drawn for each instance.</summary>
+		const Mesh3D* m_MeshRef;
+
+		/// <summary>Model matrix of each instance.</summary>
+		InstanceArray m_Instances;
+
+		/// <summary>OpenGL buffer holding the model matrix of each instance.</summary>
+		Uint32 m_InstanceBufferObject;
+
+		/// <summary>Count of instances in the instance buffer.</summary>
+		Uint32 m_InstancesCount;
+	};
+
+} // ae
@@ -6,6 +6,7 @@
 #include "../../Material/BlinnPhongMaterial.h"
 #include "../../Material/CookTorranceMaterial.h"
 #include "../../Material/ToonMaterial.h"
+#include "SharedGeometry.h"
 
 #include "../../../Editor/TypesToEditor/MaterialToEditor.h"
 
@@ -25,9 +26,14 @@
 
 namespace ae
 {
+	/// <summary>Assimp post process flags used to load the meshes. Part of the geometry cache and cooked files keys.</summary>
+	static const Uint32 MeshImportFlags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenSmoothNormals | aiProcess_GenUVCoords;
+
 	Mesh3D::Mesh3D( const Uint32 _VerticesCount, const Uint32 _IndicesCount ) :
 		m_Vertices( _VerticesCount ),
-		m_Indices( _IndicesCount )
+		m_Indices( _IndicesCount ),
+		m_SharedGeometry( nullptr ),
+		m_LOD( 0 )
 	{
 		SetBufferType( BufferType::Static );
 		SetAttributePointerTags( AttributePointer::Default3D );
@@ -40,7 +46,9 @@ namespace ae
 	}
 	Mesh3D::Mesh3D( const Vertex3DArray& _Vertices, const IndexArray& _Indices ) :
 		m_Vertices( _Vertices ),
-		m_Indices( _Indices )
+		m_Indices( _Indices ),
+		m_SharedGeometry( nullptr ),
+		m_LOD( 0 )
 	{
 		SetBufferType( BufferType::Static );
 		SetAttributePointerTags( AttributePointer::Default3D );
@@ -52,7 +60,9 @@ namespace ae
 		SetName( std::string( "Mesh3D_" ) + std::to_string( GetObjectID() ) );
 	}
 
-	Mesh3D::Mesh3D( const std::string& _FileName, Bool _UseTextureBool )
+	Mesh3D::Mesh3D( const std::string& _FileName, Bool _UseTextureBool ) :
+		m_SharedGeometry( nullptr ),
+		m_LOD( 0 )
 	{
 		SetBufferType( BufferType::Static );
 		SetAttributePointerTags( AttributePointer::Default3D );
@@ -62,8 +72,15 @@ namespace ae
 		SetName( std::string( "Mesh3D_" ) + std::to_string( GetObjectID() ) );
 	}
 
+	Mesh3D::~Mesh3D()
+	{
+		ReleaseSharedGeometry();
+	}
+
 	void Mesh3D::Setup( const Uint32 _VerticesCount, const Uint32 _IndicesCount )
 	{
+		DetachSharedGeometry( False );
+
 		m_Vertices.clear();
 		m_Vertices.resize( _VerticesCount );
 
@@ -75,6 +92,8 @@ namespace ae
 
 	void Mesh3D::Setup( const Vertex3DArray& _Vertices, const IndexArray& _Indices )
 	{
+		DetachSharedGeometry( False );
+
 		m_Vertices = _Vertices;
 		m_Indices = _Indices;
 
@@ -83,6 +102,8 @@ namespace ae
 
 	void Mesh3D::Setup( Vertex3DArray&& _Vertices, IndexArray&& _Indices )
 	{
+		DetachSharedGeometry( False );
+
 		m_Vertices = std::move( _Vertices );
 		m_Indices = std::move( _Indices );
 
@@ -91,161 +112,142 @@ namespace ae
 
 	void Mesh3D::LoadFromFile( const std::string& _FileName, Bool _UseTextureBool )
 	{
-		Assimp::Importer Importer;
-		const aiScene* Scene = Importer.ReadFile( _FileName, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenSmoothNormals | aiProcess_GenUVCoords );
-
-		if( Scene == nullptr || Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || Scene->mRootNode == nullptr )
-		{
-			AE_LogError( std::string( "Failed to load " ) + _FileName + ". " + Importer.GetErrorString() );
-			return;
-		}
+		// Meshes loading the same file share the geometry, the file is read only once.
+		priv::SharedGeometry* Geometry = Aero.GetResourcesManager().AcquireGeometry( _FileName, MeshImportFlags );
 
-		if( Scene->mNumMeshes == 0 )
+		if( Geometry == nullptr )
 			return;
 
-		// For the moment, we support only one mesh per file.
+		AttachSharedGeometry( *Geometry );
+		ApplyFileMaterial( _FileName, _UseTextureBool );
+	}
 
-		aiMesh* FirstMesh = Scene->mMeshes[0];
+	void Mesh3D::LoadFromFileAsync( const std::string& _FileName, Bool _UseTextureBool, std::function<void( Mesh3D& )> _OnLoaded )
+	{
+		priv::SharedGeometry* Geometry = Aero.GetResourcesManager().AcquireGeometry( _FileName, MeshImportFlags, True );
 
-		if( FirstMesh == nullptr )
+		if( Geometry == nullptr )
 			return;
 
-		m_Vertices.clear();
-		m_Vertices.resize( FirstMesh->mNumVertices );
-
-		m_Indices.clear();
-		m_Indices.resize( static_cast<size_t>( FirstMesh->mNumFaces )* static_cast<size_t>( 3 ) );
+		AttachSharedGeometry( *Geometry );
 
-		for( unsigned int v = 0; v < FirstMesh->mNumVertices; v++ )
+		std::function<void()> OnGeometryLoaded = [this, _FileName, _UseTextureBool, _OnLoaded]()
 		{
-			if( FirstMesh->mVertices != nullptr )
-			{
-				m_Vertices[v].Position.X = static_cast<float>( FirstMesh->mVertices[v].x );
-				m_Vertices[v].Position.Y = static_cast<float>( FirstMesh->mVertices[v].y );
-				m_Vertices[v].Position.Z = static_cast<float>( FirstMesh->mVertices[v].z );
-			}
+			if( m_SharedGeometry->GetLoadingState() != LoadingState::Ready )
+				return;
 
-			if( FirstMesh->mNormals != nullptr )
-			{
-				m_Vertices[v].Normal.X = static_cast<float>( FirstMesh->mNormals[v].x );
-				m_Vertices[v].Normal.Y = static_cast<float>( FirstMesh->mNormals[v].y );
-				m_Vertices[v].Normal.Z = static_cast<float>( FirstMesh->mNormals[v].z );
-			}
+			BindSharedGeometry();
+			ApplyFileMaterial( _FileName, _UseTextureBool );
 
-			// Take only the first vertex color.
-			if( FirstMesh->mColors != nullptr && FirstMesh->mColors[0] != nullptr )
-			{
-				m_Vertices[v].Color.R( static_cast<float>( FirstMesh->mColors[0][v].r ) );
-				m_Vertices[v].Color.G( static_cast<float>( FirstMesh->mColors[0][v].g ) );
-				m_Vertices[v].Color.B( static_cast<float>( FirstMesh->mColors[0][v].b ) );
-				m_Vertices[v].Color.A( static_cast<float>( FirstMesh->mColors[0][v].a ) );
-			}
+			if( _OnLoaded )
+				_OnLoaded( *this );
+		};
 
-			// Take only the first UV dim.
-			if( FirstMesh->mTextureCoords != nullptr && FirstMesh->mTextureCoords[0] != nullptr )
-			{
-				m_Vertices[v].UV.X = static_cast<float>( FirstMesh->mTextureCoords[0][v].x );
-				m_Vertices[v].UV.Y = static_cast<float>( FirstMesh->mTextureCoords[0][v].y );
-			}
+		// Already loaded by another mesh.
+		if( Geometry->GetLoadingState() != LoadingState::Pending )
+		{
+			OnGeometryLoaded();
+			return;
 		}
 
-		size_t IndiceCursor = 0;
-		for( unsigned int f = 0; f < FirstMesh->mNumFaces; f++ )
-		{
-			const aiFace& Face = FirstMesh->mFaces[f];
+		// Placeholder until the geometry is uploaded : no triangle and the default material.
+		SetMaterial( *Aero.GetResourcesManager().GetDefault3DMaterial() );
 
-			for( unsigned int i = 0; i < Face.mNumIndices; i++ )
-			{
-				m_Indices[IndiceCursor] = Face.mIndices[i];
-				IndiceCursor++;
-			}
-		}
+		Geometry->AddLoadedCallback( this, std::move( OnGeometryLoaded ) );
+	}
 
-		if( Scene->mMaterials != nullptr && FirstMesh->mMaterialIndex < Scene->mNumMaterials )
+	LoadingState Mesh3D::GetLoadingState() const
+	{
+		return m_SharedGeometry != nullptr ? m_SharedGeometry->GetLoadingState() : LoadingState::Ready;
+	}
+
+	void Mesh3D::ApplyFileMaterial( const std::string& _FileName, Bool _UseTextureBool )
+	{
+		const ::aiMaterial* AssimpMaterial = m_SharedGeometry->GetMaterial();
+		if( AssimpMaterial != nullptr )
 		{
 			const std::string Directory = _FileName.substr( 0, _FileName.find_last_of( '/' ) );
-			const ::aiMaterial* AssimpMaterial = Scene->mMaterials[FirstMesh->mMaterialIndex];
-
-			if( AssimpMaterial != nullptr )
-			{
 
-				SetMaterial( *Aero.GetResourcesManager().GetDefault3DMaterial() );
+			SetMaterial( *Aero.GetResourcesManager().GetDefault3DMaterial() );
 
 
-				int ShadingModel = aiShadingMode::aiShadingMode_Blinn;
-				AssimpMaterial->Get( AI_MATKEY_SHADING_MODEL, ShadingModel );
+			int ShadingModel = aiShadingMode::aiShadingMode_Blinn;
+			AssimpMaterial->Get( AI_MATKEY_SHADING_MODEL, ShadingModel );
 
-				switch( ShadingModel )
-				{
-				case aiShadingMode::aiShadingMode_Blinn:
-				case aiShadingMode::aiShadingMode_Phong:
-				case aiShadingMode::aiShadingMode_Flat:
-				case aiShadingMode::aiShadingMode_Gouraud:
-				case aiShadingMode::aiShadingMode_NoShading:
-				{
-					BlinnPhongMaterial* Mat = new BlinnPhongMaterial;
-					SetMaterial( *Mat );
-					priv::AssimpLoadBlinnPhongMaterial( *Mat, AssimpMaterial, Directory );
-				}
-				break;
-
-				case aiShadingMode::aiShadingMode_Toon:
-				{
-					ToonMaterial* Mat = new ToonMaterial;
-					SetMaterial( *Mat );
-					priv::AssimpLoadToonMaterial( *Mat, AssimpMaterial, Directory );
-				}
-				break;
+			switch( ShadingModel )
+			{
+			case aiShadingMode::aiShadingMode_Blinn:
+			case aiShadingMode::aiShadingMode_Phong:
+			case aiShadingMode::aiShadingMode_Flat:
+			case aiShadingMode::aiShadingMode_Gouraud:
+			case aiShadingMode::aiShadingMode_NoShading:
+			{
+				BlinnPhongMaterial* Mat = new BlinnPhongMaterial;
+				SetMaterial( *Mat );
+				priv::AssimpLoadBlinnPhongMaterial( *Mat, AssimpMaterial, Directory );
+			}
+			break;
 
-				case aiShadingMode::aiShadingMode_CookTorrance:
-				case aiShadingMode::aiShadingMode_Minnaert:
-				case aiShadingMode::aiShadingMode_OrenNayar:
-				{
-					CookTorranceMaterial* Mat = new CookTorranceMaterial;
-					SetMaterial( *Mat );
-					priv::AssimpLoadCookTorranceMaterial( *Mat, AssimpMaterial, Directory );
-				}
-				break;
+			case aiShadingMode::aiShadingMode_Toon:
+			{
+				ToonMaterial* Mat = new ToonMaterial;
+				SetMaterial( *Mat );
+				priv::AssimpLoadToonMaterial( *Mat, AssimpMaterial, Directory );
+			}
+			break;
 
-				default:
-				{
-					Material* Mat = new Material;
-					SetMaterial( *Mat );
-					priv::AssimpLoadMaterial( *Mat, AssimpMaterial, Directory, _UseTextureBool );
-				}
-				break;
-				}
+			case aiShadingMode::aiShadingMode_CookTorrance:
+			case aiShadingMode::aiShadingMode_Minnaert:
+			case aiShadingMode::aiShadingMode_OrenNayar:
+			{
+				CookTorranceMaterial* Mat = new CookTorranceMaterial;
+				SetMaterial( *Mat );
+				priv::AssimpLoadCookTorranceMaterial( *Mat, AssimpMaterial, Directory );
+			}
+			break;
 
-				GetMaterial().SetIsInstance( True );
-				GetMaterial().SaveUniformsLocation();
+			default:
+			{
+				Material* Mat = new Material;
+				SetMaterial( *Mat );
+				priv::AssimpLoadMaterial( *Mat, AssimpMaterial, Directory, _UseTextureBool );
+			}
+			break;
 			}
-		}
 
-		ApplyChanges();
+			GetMaterial().SetIsInstance( True );
+			GetMaterial().SaveUniformsLocation();
+		}
 	}
 
 	const Vertex3D& Mesh3D::operator[]( const Uint32 _Index ) const
 	{
-		return m_Vertices[_Index];
+		return GetVertex( _Index );
 	}
 
 	Vertex3D& Mesh3D::operator[]( const Uint32 _Index )
 	{
+		DetachSharedGeometry( True );
+
 		return m_Vertices[_Index];
 	}
 
 	void Mesh3D::SetVertex( const Uint32 _Index, const Vertex3D& _Vertex )
 	{
+		DetachSharedGeometry( True );
+
 		m_Vertices[_Index] = _Vertex;
 	}
 
 	const Vertex3D& Mesh3D::GetVertex( const Uint32 _Index ) const
 	{
-		return m_Vertices[_Index];
+		return m_SharedGeometry != nullptr ? m_SharedGeometry->GetVertices()[_Index] : m_Vertices[_Index];
 	}
 
 	void Mesh3D::SetIndice( const Uint32 _Index, const Uint32 _Value )
 	{
+		DetachSharedGeometry( True );
+
 		m_Indices[_Index] = _Value;
 	}
 
@@ -254,6 +256,8 @@ namespace ae
 		if( GetPrimitiveType() != PrimitiveType::Triangles )
 			throw std::exception( "Incompatible mesh primitive type with SetTriangleIndices function. Must be set to PrimitiveType::Triangles." );
 
+		DetachSharedGeometry( True );
+
 		if( m_Indices.size() < 3 || _TriangleIndex > ( m_Indices.size() - 3 ) )
 			throw std::out_of_range( "Index out of range." );
 
@@ -269,6 +273,8 @@ namespace ae
 		if( GetPrimitiveType() != PrimitiveType::Quads )
 			throw std::exception( "Incompatible mesh primitive type with SetQuadIndices function. Must be set to PrimitiveType::Quads." );
 
+		DetachSharedGeometry( True );
+
 		if( m_Indices.size() < 4 || _QuadIndex > ( m_Indices.size() - 4 ) )
 			throw std::out_of_range( "Index out of range." );
 
@@ -282,14 +288,130 @@ namespace ae
 
 	Uint32 Mesh3D::GetIndice( const Uint32 _Index ) const
 	{
-		return m_Indices[_Index];
+		return m_SharedGeometry != nullptr ? m_SharedGeometry->GetIndices()[_Index] : m_Indices[_Index];
 	}
 
 
 
 	void Mesh3D::ApplyChanges()
 	{
+		// The shared buffers are already up to date, the geometry is detached before any modification.
+		if( m_SharedGeometry != nullptr )
+			return;
+
 		UpdateBuffers( m_Vertices, m_Indices );
+
+		AABB Bounds;
+
+		for( const Vertex3D& Vertex : m_Vertices )
+			Bounds.Grow( Vertex.Position );
+
+		SetLocalBounds( Bounds );
+	}
+
+	Bool Mesh3D::CookFile( const std::string& _FileName )
+	{
+		return priv::SharedGeometry::Cook( _FileName, MeshImportFlags );
+	}
+
+	Uint32 Mesh3D::GetImportFlags()
+	{
+		return MeshImportFlags;
+	}
+
+	void Mesh3D::SetVertexFormat( AttributePointer _Attributes )
+	{
+		// The shared buffers are always in the default format.
+		if( m_SharedGeometry != nullptr )
+		{
+			if( _Attributes == AttributePointer::Default3D )
+			{
+				SetAttributePointerTags( _Attributes );
+				return;
+			}
+
+			DetachSharedGeometry( True );
+		}
+
+		SetAttributePointerTags( _Attributes );
+		ApplyChanges();
+	}
+
+	Bool Mesh3D::IsSharingGeometry() const
+	{
+		return m_SharedGeometry != nullptr;
+	}
+
+	Uint32 Mesh3D::GetLODsCount() const
+	{
+		if( m_SharedGeometry == nullptr || m_SharedGeometry->GetLODs().empty() )
+			return 1;
+
+		return Cast( Uint32, m_SharedGeometry->GetLODs().size() );
+	}
+
+	void Mesh3D::SetLOD( Uint32 _LOD )
+	{
+		m_LOD = Math::Min( _LOD, GetLODsCount() - 1 );
+
+		// The levels are ranges of the shared indices, nothing to upload.
+		if( m_SharedGeometry == nullptr || m_SharedGeometry->GetLoadingState() != LoadingState::Ready || m_SharedGeometry->GetLODs().empty() )
+			return;
+
+		const priv::MeshLOD& LOD = m_SharedGeometry->GetLODs()[m_LOD];
+		m_FirstIndex = LOD.FirstIndex;
+		m_IndicesCount = LOD.IndicesCount;
+	}
+
+	Uint32 Mesh3D::GetLOD() const
+	{
+		return m_LOD;
+	}
+
+	float Mesh3D::GetLODError( Uint32 _LOD ) const
+	{
+		if( m_SharedGeometry == nullptr || _LOD >= m_SharedGeometry->GetLODs().size() )
+			return 0.0f;
+
+		return m_SharedGeometry->GetLODs()[_LOD].Error;
+	}
+
+	void Mesh3D::GetLODIndices( Uint32 _LOD, AE_Out Uint32& _FirstIndex, AE_Out Uint32& _IndicesCount ) const
+	{
+		if( m_SharedGeometry == nullptr || m_SharedGeometry->GetLODs().empty() )
+		{
+			_FirstIndex = 0;
+			_IndicesCount = m_SharedGeometry != nullptr ? Cast( Uint32, m_SharedGeometry->GetIndices().size() ) : Cast( Uint32, m_Indices.size() );
+			return;
+		}
+
+		const priv::MeshLOD& LOD = m_SharedGeometry->GetLODs()[Math::Min( _LOD, GetLODsCount() - 1 )];
+		_FirstIndex = LOD.FirstIndex;
+		_IndicesCount = LOD.IndicesCount;
+	}
+
+	Uint32 Mesh3D::SelectLOD( float _MaxWorldError )
+	{
+		// The errors are in model space, the largest scale gives the worst case in world space.
+		const Vector3& Scale = GetScale();
+		const float MaxScale = Math::Max( Math::Abs( Scale.X ), Math::Max( Math::Abs( Scale.Y ), Math::Abs( Scale.Z ) ) );
+
+		// The errors increase with the levels, keep the last one under the tolerance.
+		Uint32 Selected = 0;
+		const Uint32 LODsCount = GetLODsCount();
+
+		for( Uint32 l = 1; l < LODsCount; l++ )
+		{
+			if( GetLODError( l ) * MaxScale > _MaxWorldError )
+				break;
+
+			Selected = l;
+		}
+
+		if( Selected != m_LOD )
+			SetLOD( Selected );
+
+		return Selected;
 	}
 
 	void Mesh3D::ToEditor()
@@ -299,4 +421,134 @@ namespace ae
 		priv::ui::MaterialToEditor( GetMaterial() );
 	}
 
+	void Mesh3D::AttachSharedGeometry( priv::SharedGeometry& _Geometry )
+	{
+		if( m_SharedGeometry != nullptr )
+			ReleaseSharedGeometry();
+
+		// Free the mesh own buffers, the shared ones are used instead.
+		else if( Aero.CheckContext() )
+		{
+			if( m_ElementsArrayObject )
+			{
+				glDeleteBuffers( 1, &m_ElementsArrayObject );
+				AE_ErrorCheckOpenGLError();
+			}
+
+			if( m_VertexBufferObject )
+			{
+				glDeleteBuffers( 1, &m_VertexBufferObject );
+				AE_ErrorCheckOpenGLError();
+			}
+		}
+
+		m_SharedGeometry = &_Geometry;
+
+		Vertex3DArray().swap( m_Vertices );
+		IndexArray().swap( m_Indices );
+
+		m_VertexBufferObject = 0;
+		m_ElementsArrayObject = 0;
+		m_VerticesCount = 0;
+		m_IndicesCount = 0;
+		m_FirstIndex = 0;
+		m_LOD = 0;
+		SetLocalBounds( AABB() );
+
+		// A pending geometry has no buffer yet, the mesh stays empty until it is bound.
+		if( _Geometry.GetLoadingState() == LoadingState::Ready )
+			BindSharedGeometry();
+	}
+
+	void Mesh3D::BindSharedGeometry()
+	{
+		m_VertexBufferObject = m_SharedGeometry->GetVertexBufferObject();
+		m_ElementsArrayObject = m_SharedGeometry->GetElementsArrayObject();
+		m_VerticesCount = Cast( Uint32, m_SharedGeometry->GetVertices().size() );
+		m_IndicesCount = Cast( Uint32, m_SharedGeometry->GetIndices().size() );
+		m_FirstIndex = 0;
+		m_IndexType = m_SharedGeometry->GetIndexType();
+
+		// Draw only the range of the level of detail, the indices of all the levels follow each other.
+		SetLOD( m_LOD );
+
+		if( m_VerticesCount > 0 )
+			SetLocalBounds( AABB( m_SharedGeometry->GetBoundsMin(), m_SharedGeometry->GetBoundsMax() ) );
+
+		if( !Aero.CheckContext() )
+			return;
+
+		glBindVertexArray( m_VertexArrayObject );
+		AE_ErrorCheckOpenGLError();
+
+		glBindBuffer( GL_ARRAY_BUFFER, m_VertexBufferObject );
+		AE_ErrorCheckOpenGLError();
+
+		// The shared buffers hold the full vertices.
+		m_VertexBufferAttributes = AttributePointer::Default3D;
+		SetupVertex3DAttributes();
+
+		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_ElementsArrayObject );
+		AE_ErrorCheckOpenGLError();
+
+		glBindVertexArray( 0 );
+		AE_ErrorCheckOpenGLError();
+	}
+
+	void Mesh3D::DetachSharedGeometry( Bool _CopyData )
+	{
+		if( m_SharedGeometry == nullptr )
+			return;
+
+		// Nothing to copy before the geometry is uploaded.
+		if( _CopyData && m_SharedGeometry->GetLoadingState() == LoadingState::Pending )
+			Aero.GetAsyncLoader().Flush();
+
+		// Copy before releasing, the geometry can be freed by the release.
+		if( _CopyData )
+		{
+			// Only the full mesh is kept, the levels of detail are not updated by the modifications.
+			const std::vector<Uint32>& Indices = m_SharedGeometry->GetIndices();
+			const std::vector<priv::MeshLOD>& LODs = m_SharedGeometry->GetLODs();
+			const size_t FullMeshCount = LODs.empty() ? Indices.size() : LODs[0].IndicesCount;
+
+			m_Vertices = m_SharedGeometry->GetVertices();
+			m_Indices.assign( Indices.begin(), Indices.begin() + FullMeshCount );
+		}
+
+		ReleaseSharedGeometry();
+
+		if( Aero.CheckContext() )
+		{
+			glGenBuffers( 1, &m_VertexBufferObject );
+			AE_ErrorCheckOpenGLError();
+
+			glGenBuffers( 1, &m_ElementsArrayObject );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		// Keep the mesh drawable until the caller apply its modifications.
+		if( _CopyData )
+			ApplyChanges();
+	}
+
+	void Mesh3D::ReleaseSharedGeometry()
+	{
+		if( m_SharedGeometry == nullptr )
+			return;
+
+		// The buffers belong to the geometry, they must not be deleted by the drawable.
+		m_VertexBufferObject = 0;
+		m_ElementsArrayObject = 0;
+		m_VerticesCount = 0;
+		m_IndicesCount = 0;
+		m_FirstIndex = 0;
+		m_LOD = 0;
+
+		m_SharedGeometry->RemoveLoadedCallbacks( this );
+
+		Aero.GetResourcesManager().ReleaseGeometry( *m_SharedGeometry );
+		m_SharedGeometry = nullptr;
+	}
+
 } // ae
\ No newline at end of file
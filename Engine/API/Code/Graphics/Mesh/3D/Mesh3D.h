@@ -4,15 +4,24 @@
 #include "../../Color/Color.h"
 #include "../../Vertex/Vertex3D.h"
 #include "../../Drawable/TransformableDrawable3D.h"
+#include "../../../Resources/AsyncLoader/AsyncLoader.h"
 
 #include <array>
+#include <functional>
 
 namespace ae
 {
+	namespace priv
+	{
+		class SharedGeometry;
+	}
+
 	/// \ingroup graphics
 	/// <summary>
 	/// Represent a 3D models in the scene.<para/>
-	/// By default, the material is initialized with the parameters for the Blinn Phong shipped with the engine.
+	/// By default, the material is initialized with the parameters for the Blinn Phong shipped with the engine.<para/>
+	/// Meshes loaded from the same file share their vertex and index buffers, the geometry is copied
+	/// only when a shared mesh is modified.
 	/// </summary>
 	/// <seealso cref="Transform" />
 	/// <seealso cref="Drawable" />
@@ -37,6 +46,9 @@ namespace ae
 		/// <param name="_UseTextureBool">Use simple texture parameter or texture/bool pair to handle invalid texture ?</param>
 		explicit Mesh3D( const std::string& _FileName, Bool _UseTextureBool = False );
 
+		/// <summary>Give back the shared geometry if the mesh was loaded from a file.</summary>
+		virtual ~Mesh3D();
+
 		/// <summary>Build an empty mesh but reserve vertices and indices.</summary>
 		/// <param name="_VerticesCount">Count of vertices to reserve.</param>
 		/// <param name="_IndicesCount">Count of indices to reserve.</param>
@@ -60,6 +72,33 @@ namespace ae
 		/// <param name="_UseTextureBool">Use simple texture parameter or texture/bool pair to handle invalid texture ?</param>
 		void LoadFromFile( const std::string& _FileName, Bool _UseTextureBool = False );
 
+		/// <summary>
+		/// Load a 3D file in the background.<para/>
+		/// Until the file is decoded by the asynchronous loader and uploaded, the mesh has no triangle and uses the default material.
+		/// Once loaded, the geometry and the material of the file are set, then <paramref name="_OnLoaded"/> is called,
+		/// it is the place to change the material or the textures of the file.
+		/// </summary>
+		/// <param name="_FileName">Path to the 3D file to load.</param>
+		/// <param name="_UseTextureBool">Use simple texture parameter or texture/bool pair to handle invalid texture ?</param>
+		/// <param name="_OnLoaded">Function called on the main thread once the mesh is loaded. Not called if the loading fails.</param>
+		void LoadFromFileAsync( const std::string& _FileName, Bool _UseTextureBool = False, std::function<void( Mesh3D& )> _OnLoaded = nullptr );
+
+		/// <summary>Retrieve the state of the loading of the file.</summary>
+		/// <returns>Ready if the mesh is not loaded from a file.</returns>
+		LoadingState GetLoadingState() const;
+
+		/// <summary>
+		/// Write the cooked version of a 3D file, read instead of the source by LoadFromFile.<para/>
+		/// Files are cooked on their first load anyway, this allows to do it offline.
+		/// </summary>
+		/// <param name="_FileName">Path to the 3D file to cook.</param>
+		/// <returns>True if the cooked file has been written, False otherwise.</returns>
+		static Bool CookFile( const std::string& _FileName );
+
+		/// <summary>Retrieve the Assimp post process flags used to import the 3D files, part of the cooked files keys.</summary>
+		/// <returns>Import flags of the meshes.</returns>
+		static Uint32 GetImportFlags();
+
 		/// <summary>Retrieve one vertex. Read Only.</summary>
 		/// <param name="_Index">Index of the vertex to retrieve.</param>
 		/// <returns>Vertex at the specified index. Read Only.</returns>
@@ -108,6 +147,55 @@ namespace ae
 		/// <summary>Apply modifications done to the vertices and indices.</summary>
 		void ApplyChanges();
 
+		/// <summary>
+		/// Change the attributes stored in the vertex buffer, to cut the memory and the bandwidth of the vertices.<para/>
+		/// For example, AttributePointer::Position for a depth only geometry (12 bytes per vertex),
+		/// AttributePointer::Compact3D for a lit mesh (24 bytes) instead of AttributePointer::Default3D (48 bytes).<para/>
+		/// A mesh sharing its geometry stops sharing it for any other format than the default one, with only its full level of detail.
+		/// </summary>
+		/// <param name="_Attributes">Attributes to store, with <c>Quantized</c> to store them in compact types.</param>
+		void SetVertexFormat( AttributePointer _Attributes );
+
+		/// <summary>Is the mesh using the buffers of a file loaded by other meshes ?</summary>
+		/// <returns>True if the mesh shares its geometry, False if the mesh owns its buffers.</returns>
+		Bool IsSharingGeometry() const;
+
+
+		/// <summary>
+		/// Retrieve the count of levels of detail of the mesh.<para/>
+		/// The levels are generated when a file is cooked, a mesh built from vertices and indices has only one.
+		/// </summary>
+		/// <returns>Count of levels of detail, the full mesh included.</returns>
+		Uint32 GetLODsCount() const;
+
+		/// <summary>Change the level of detail drawn. The level 0 is the full mesh.</summary>
+		/// <param name="_LOD">Level to draw, clamped to the levels available.</param>
+		void SetLOD( Uint32 _LOD );
+
+		/// <summary>Retrieve the level of detail drawn.</summary>
+		/// <returns>Level drawn, 0 for the full mesh.</returns>
+		Uint32 GetLOD() const;
+
+		/// <summary>Retrieve the maximum distance between a level of detail and the full mesh, in model space.</summary>
+		/// <param name="_LOD">Level to retrieve the error.</param>
+		/// <returns>Error of the level, 0 for the full mesh or a level that doesn't exist.</returns>
+		float GetLODError( Uint32 _LOD ) const;
+
+		/// <summary>Retrieve the range of the triangles indices of a level of detail, to read with GetIndice.</summary>
+		/// <param name="_LOD">Level to retrieve the range, clamped to the levels available.</param>
+		/// <param name="_FirstIndex">First index of the level.</param>
+		/// <param name="_IndicesCount">Count of indices of the level.</param>
+		void GetLODIndices( Uint32 _LOD, AE_Out Uint32& _FirstIndex, AE_Out Uint32& _IndicesCount ) const;
+
+		/// <summary>
+		/// Draw the coarsest level of detail whose error, scaled by the transform, is under a tolerance.<para/>
+		/// The tolerance is typically the size of a pixel at the distance of the mesh for the colour pass,
+		/// or the size of a texel of the depth map for a footprint pass.
+		/// </summary>
+		/// <param name="_MaxWorldError">Maximum error allowed, in world space.</param>
+		/// <returns>The level selected.</returns>
+		Uint32 SelectLOD( float _MaxWorldError );
+
 
 		/// <summary>
 		/// Function called by the editor.
@@ -117,13 +205,43 @@ namespace ae
 		virtual void ToEditor() override;
 		
 
+	private:
+		/// <summary>Use the buffers of a geometry loaded by the resources manager instead of the mesh ones.</summary>
+		/// <param name="_Geometry">Geometry to use. The mesh takes the reference given by the manager.</param>
+		void AttachSharedGeometry( priv::SharedGeometry& _Geometry );
+
+		/// <summary>
+		/// Stop sharing the geometry and create the mesh own buffers.<para/>
+		/// Has no effect if the mesh doesn't share its geometry.
+		/// </summary>
+		/// <param name="_CopyData">Copy the shared vertices and indices in the mesh before any modification ?</param>
+		void DetachSharedGeometry( Bool _CopyData );
+
+		/// <summary>Give back the shared geometry to the resources manager without creating new buffers.</summary>
+		void ReleaseSharedGeometry();
+
+		/// <summary>Use the buffers of the shared geometry in the vertex array. The geometry must be loaded.</summary>
+		void BindSharedGeometry();
+
+		/// <summary>Build the material of the mesh from the material description of the shared geometry.</summary>
+		/// <param name="_FileName">Path to the 3D file, the textures are relative to it.</param>
+		/// <param name="_UseTextureBool">Use simple texture parameter or texture/bool pair to handle invalid texture ?</param>
+		void ApplyFileMaterial( const std::string& _FileName, Bool _UseTextureBool );
+
 	protected:
 
-		/// <summary>Vertices of the mesh.</summary>
+		/// <summary>Vertices of the mesh. Empty while the geometry is shared.</summary>
 		Vertex3DArray m_Vertices;
 
-		/// <summary>Triangles indices.</summary>
+		/// <summary>Triangles indices. Empty while the geometry is shared.</summary>
 		IndexArray m_Indices;
+
+	private:
+		/// <summary>Geometry loaded from a file and shared with other meshes. Null if the mesh owns its buffers.</summary>
+		priv::SharedGeometry* m_SharedGeometry;
+
+		/// <summary>Level of detail drawn, only meaningful with a shared geometry.</summary>
+		Uint32 m_LOD;
 	};
 
 } // ae
@@ -0,0 +1,313 @@
+#include "MeshOptimizer.h"
+
+#include "../../../Maths/Functions/MathsFunctions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+namespace ae
+{
+	namespace priv
+	{
+		namespace
+		{
+			/// <summary>Size of the cache simulated by the triangles ordering, larger than the real one to look further ahead.</summary>
+			constexpr Uint32 ForsythCacheSize = 32;
+
+			/// <summary>Score of the vertices of the last triangle : lower than the next ones to avoid strips.</summary>
+			constexpr float ForsythLastTriangleScore = 0.75f;
+
+			/// <summary>Decrease of the score of a vertex with its position in the cache.</summary>
+			constexpr float ForsythCacheDecayPower = 1.5f;
+
+			/// <summary>Bonus for the vertices with few triangles left, to finish them before they leave the cache.</summary>
+			constexpr float ForsythValenceBoostScale = 2.0f;
+
+			/// <summary>Decrease of the valence bonus with the count of triangles left.</summary>
+			constexpr float ForsythValenceBoostPower = 0.5f;
+
+			constexpr Uint32 InvalidIndex = Math::Max<Uint32>();
+
+			/// <summary>Score of a vertex for the ordering of Forsyth : higher when it is recently used and has few triangles left.</summary>
+			float ComputeVertexScore( Int32 _CachePosition, Uint32 _RemainingTriangles )
+			{
+				// No triangle left, the vertex must not attract anything.
+				if( _RemainingTriangles == 0 )
+					return -1.0f;
+
+				float Score = 0.0f;
+
+				if( _CachePosition >= 0 )
+				{
+					if( _CachePosition < 3 )
+						Score = ForsythLastTriangleScore;
+					else
+					{
+						const float Scaler = 1.0f / Cast( float, ForsythCacheSize - 3 );
+						Score = std::pow( 1.0f - Cast( float, _CachePosition - 3 ) * Scaler, ForsythCacheDecayPower );
+					}
+				}
+
+				Score += ForsythValenceBoostScale * std::pow( Cast( float, _RemainingTriangles ), -ForsythValenceBoostPower );
+
+				return Score;
+			}
+		}
+
+		std::string MeshOptimizationStats::ToString() const
+		{
+			char Buffer[256];
+			std::snprintf( Buffer, sizeof( Buffer ), "ACMR %.2f -> %.2f, vertices %u -> %u, buffers %.1f KB -> %.1f KB",
+						   ACMRBefore, ACMRAfter, VerticesCountBefore, VerticesCountAfter,
+						   Cast( double, BuffersSizeBefore ) / 1024.0, Cast( double, BuffersSizeAfter ) / 1024.0 );
+
+			return std::string( Buffer );
+		}
+
+		Uint32 MeshOptimizer::DeduplicateVertices( AE_InOut Vertex3DArray& _Vertices, AE_InOut std::vector<Uint32>& _Indices )
+		{
+			const Uint32 VerticesCount = Cast( Uint32, _Vertices.size() );
+
+			// Sort by content, then by position in the array : the identical vertices follow each other, the first one leads.
+			std::vector<Uint32> Sorted( VerticesCount );
+			std::iota( Sorted.begin(), Sorted.end(), 0 );
+
+			std::sort( Sorted.begin(), Sorted.end(), [&_Vertices]( Uint32 _A, Uint32 _B )
+			{
+				const Int32 Compare = std::memcmp( &_Vertices[_A], &_Vertices[_B], sizeof( Vertex3D ) );
+				return Compare != 0 ? Compare < 0 : _A < _B;
+			} );
+
+			std::vector<Uint32> Leader( VerticesCount );
+
+			for( Uint32 s = 0; s < VerticesCount; s++ )
+			{
+				const Uint32 Current = Sorted[s];
+				const Bool IsDuplicate = s > 0 && std::memcmp( &_Vertices[Sorted[s - 1]], &_Vertices[Current], sizeof( Vertex3D ) ) == 0;
+
+				Leader[Current] = IsDuplicate ? Leader[Sorted[s - 1]] : Current;
+			}
+
+			// Compact the leaders, in their original order.
+			std::vector<Uint32> Remap( VerticesCount, InvalidIndex );
+			Uint32 WriteCursor = 0;
+
+			for( Uint32 v = 0; v < VerticesCount; v++ )
+			{
+				if( Leader[v] != v )
+					continue;
+
+				Remap[v] = WriteCursor;
+				_Vertices[WriteCursor] = _Vertices[v];
+				WriteCursor++;
+			}
+
+			for( Uint32& Index : _Indices )
+				Index = Remap[Leader[Index]];
+
+			_Vertices.resize( WriteCursor );
+
+			return VerticesCount - WriteCursor;
+		}
+
+		void MeshOptimizer::OptimizeVertexCache( AE_InOut std::vector<Uint32>& _Indices, Uint32 _FirstIndex, Uint32 _IndicesCount, Uint32 _VerticesCount )
+		{
+			const Uint32 TrianglesCount = _IndicesCount / 3;
+
+			if( TrianglesCount < 2 || _VerticesCount == 0 )
+				return;
+
+			const Uint32* const Triangles = _Indices.data() + _FirstIndex;
+
+			// Triangles of each vertex, packed : the triangles of the vertex v are in [Offsets[v], Offsets[v] + Remaining[v]).
+			std::vector<Uint32> Remaining( _VerticesCount, 0 );
+
+			for( Uint32 i = 0; i < TrianglesCount * 3; i++ )
+				Remaining[Triangles[i]]++;
+
+			std::vector<Uint32> Offsets( _VerticesCount, 0 );
+
+			for( Uint32 v = 1; v < _VerticesCount; v++ )
+				Offsets[v] = Offsets[v - 1] + Remaining[v - 1];
+
+			std::vector<Uint32> VertexTriangles( TrianglesCount * 3 );
+			std::vector<Uint32> Filled( _VerticesCount, 0 );
+
+			for( Uint32 t = 0; t < TrianglesCount; t++ )
+			{
+				for( Uint32 c = 0; c < 3; c++ )
+				{
+					const Uint32 Vertex = Triangles[t * 3 + c];
+					VertexTriangles[Offsets[Vertex] + Filled[Vertex]] = t;
+					Filled[Vertex]++;
+				}
+			}
+
+			std::vector<Int32> CachePositions( _VerticesCount, -1 );
+			std::vector<float> VertexScores( _VerticesCount );
+
+			for( Uint32 v = 0; v < _VerticesCount; v++ )
+				VertexScores[v] = ComputeVertexScore( -1, Remaining[v] );
+
+			std::vector<float> TriangleScores( TrianglesCount );
+			std::vector<Bool> IsTriangleAdded( TrianglesCount, False );
+
+			Uint32 BestTriangle = InvalidIndex;
+			float BestScore = -1.0f;
+
+			for( Uint32 t = 0; t < TrianglesCount; t++ )
+			{
+				TriangleScores[t] = VertexScores[Triangles[t * 3]] + VertexScores[Triangles[t * 3 + 1]] + VertexScores[Triangles[t * 3 + 2]];
+
+				if( TriangleScores[t] > BestScore )
+				{
+					BestScore = TriangleScores[t];
+					BestTriangle = t;
+				}
+			}
+
+			std::vector<Uint32> Result;
+			Result.reserve( TrianglesCount * 3 );
+
+			std::vector<Uint32> Cache;
+			std::vector<Uint32> NewCache;
+			Cache.reserve( ForsythCacheSize + 3 );
+			NewCache.reserve( ForsythCacheSize + 3 );
+
+			// When no triangle of the cache is left, continue with the next triangle in the input order.
+			Uint32 InputCursor = 0;
+
+			for( Uint32 Added = 0; Added < TrianglesCount; Added++ )
+			{
+				if( BestTriangle == InvalidIndex )
+				{
+					while( IsTriangleAdded[InputCursor] )
+						InputCursor++;
+
+					BestTriangle = InputCursor;
+				}
+
+				const Uint32* const Triangle = Triangles + BestTriangle * 3;
+				IsTriangleAdded[BestTriangle] = True;
+				Result.insert( Result.end(), Triangle, Triangle + 3 );
+
+				// The triangle is not waiting on its vertices anymore.
+				for( Uint32 c = 0; c < 3; c++ )
+				{
+					const Uint32 Vertex = Triangle[c];
+					Uint32* const First = VertexTriangles.data() + Offsets[Vertex];
+					Uint32* const Last = First + Remaining[Vertex];
+
+					*std::find( First, Last, BestTriangle ) = *( Last - 1 );
+					Remaining[Vertex]--;
+				}
+
+				// The vertices of the triangle go to the front of the cache, the others move back.
+				NewCache.assign( Triangle, Triangle + 3 );
+
+				for( Uint32 Vertex : Cache )
+				{
+					if( Vertex != Triangle[0] && Vertex != Triangle[1] && Vertex != Triangle[2] )
+						NewCache.push_back( Vertex );
+				}
+
+				for( Uint32 i = 0; i < NewCache.size(); i++ )
+				{
+					const Uint32 Vertex = NewCache[i];
+					CachePositions[Vertex] = i < ForsythCacheSize ? Cast( Int32, i ) : -1;
+					VertexScores[Vertex] = ComputeVertexScore( CachePositions[Vertex], Remaining[Vertex] );
+				}
+
+				// Only the triangles around the cache changed, the best one is among them.
+				BestTriangle = InvalidIndex;
+				BestScore = -1.0f;
+
+				for( Uint32 Vertex : NewCache )
+				{
+					for( Uint32 a = 0; a < Remaining[Vertex]; a++ )
+					{
+						const Uint32 t = VertexTriangles[Offsets[Vertex] + a];
+						TriangleScores[t] = VertexScores[Triangles[t * 3]] + VertexScores[Triangles[t * 3 + 1]] + VertexScores[Triangles[t * 3 + 2]];
+
+						if( TriangleScores[t] > BestScore || ( TriangleScores[t] == BestScore && t < BestTriangle ) )
+						{
+							BestScore = TriangleScores[t];
+							BestTriangle = t;
+						}
+					}
+				}
+
+				if( NewCache.size() > ForsythCacheSize )
+					NewCache.resize( ForsythCacheSize );
+
+				Cache.swap( NewCache );
+			}
+
+			std::copy( Result.begin(), Result.end(), _Indices.begin() + _FirstIndex );
+		}
+
+		void MeshOptimizer::OptimizeVertexFetch( AE_InOut Vertex3DArray& _Vertices, AE_InOut std::vector<Uint32>& _Indices )
+		{
+			std::vector<Uint32> Remap( _Vertices.size(), InvalidIndex );
+			Vertex3DArray Sorted;
+			Sorted.reserve( _Vertices.size() );
+
+			for( Uint32& Index : _Indices )
+			{
+				if( Remap[Index] == InvalidIndex )
+				{
+					Remap[Index] = Cast( Uint32, Sorted.size() );
+					Sorted.push_back( _Vertices[Index] );
+				}
+
+				Index = Remap[Index];
+			}
+
+			_Vertices.swap( Sorted );
+		}
+
+		float MeshOptimizer::ComputeACMR( const std::vector<Uint32>& _Indices, Uint32 _FirstIndex, Uint32 _IndicesCount, Uint32 _CacheSize )
+		{
+			const Uint32 TrianglesCount = _IndicesCount / 3;
+
+			if( TrianglesCount == 0 )
+				return 0.0f;
+
+			const auto First = _Indices.begin() + _FirstIndex;
+			const auto Last = First + TrianglesCount * 3;
+			const Uint32 VerticesCount = *std::max_element( First, Last ) + 1;
+
+			// FIFO cache : a vertex is still in the cache while less than CacheSize vertices have been loaded after it.
+			std::vector<Uint32> LoadTimes( VerticesCount, InvalidIndex );
+			Uint32 Misses = 0;
+
+			for( auto Index = First; Index != Last; ++Index )
+			{
+				const Uint32 LoadTime = LoadTimes[*Index];
+
+				if( LoadTime == InvalidIndex || Misses - LoadTime >= _CacheSize )
+				{
+					LoadTimes[*Index] = Misses;
+					Misses++;
+				}
+			}
+
+			return Cast( float, Misses ) / Cast( float, TrianglesCount );
+		}
+
+		IndexType MeshOptimizer::SelectIndexType( size_t _VerticesCount )
+		{
+			return _VerticesCount <= Cast( size_t, Math::Max<Uint16>() ) + 1 ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+		}
+
+		Uint32 MeshOptimizer::GetIndexSize( IndexType _Type )
+		{
+			return _Type == IndexType::UnsignedShort ? sizeof( Uint16 ) : sizeof( Uint32 );
+		}
+
+	} // priv
+
+} // ae
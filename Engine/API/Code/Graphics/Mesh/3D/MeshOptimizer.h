@@ -0,0 +1,103 @@
+#ifndef _MESHOPTIMIZER_AERO_H_
+#define _MESHOPTIMIZER_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../Vertex/VertexArray.h"
+#include "../../Primitives/PrimitivesType.h"
+#include "CookedMesh.h"
+
+#include <vector>
+#include <string>
+
+namespace ae
+{
+	namespace priv
+	{
+		/// <summary>Measures of a mesh before and after the optimization, to report the gain.</summary>
+		struct MeshOptimizationStats
+		{
+			/// <summary>Average cache miss ratio of the full mesh in file order : vertices transformed per triangle.</summary>
+			float ACMRBefore = 0.0f;
+
+			/// <summary>Average cache miss ratio of the full mesh once optimized.</summary>
+			float ACMRAfter = 0.0f;
+
+			/// <summary>Count of vertices in file order.</summary>
+			Uint32 VerticesCountBefore = 0;
+
+			/// <summary>Count of vertices once deduplicated.</summary>
+			Uint32 VerticesCountAfter = 0;
+
+			/// <summary>Size in bytes of the vertex and index buffers in file order, 32 bits indices.</summary>
+			Uint64 BuffersSizeBefore = 0;
+
+			/// <summary>Size in bytes of the vertex and index buffers once optimized, levels of detail included.</summary>
+			Uint64 BuffersSizeAfter = 0;
+
+			/// <summary>Format the measures in one line for the log.</summary>
+			/// <returns>Readable version of the measures.</returns>
+			std::string ToString() const;
+		};
+
+		/// \ingroup graphics
+		/// <summary>
+		/// Reorder the geometry of a mesh for the GPU, at import time.<para/>
+		/// - The identical vertices are merged.<para/>
+		/// - The triangles are sorted to reuse the vertices of the post transform cache (Forsyth).<para/>
+		/// - The vertices are sorted in the order of their first use to fetch the memory linearly.<para/>
+		/// CPU only and deterministic, like the simplification of the levels of detail.
+		/// </summary>
+		/// <seealso cref="MeshSimplifier" />
+		/// <seealso cref="SharedGeometry" />
+		class AERO_CORE_EXPORT MeshOptimizer
+		{
+		public:
+			/// <summary>Size of the FIFO cache simulated to compute the ACMR, close to the post transform cache of the GPUs.</summary>
+			static constexpr Uint32 ACMRCacheSize = 16;
+
+		public:
+			/// <summary>Merge the vertices with exactly the same attributes and remap the indices.</summary>
+			/// <param name="_Vertices">Vertices to deduplicate, the first occurrence of each vertex is kept in place order.</param>
+			/// <param name="_Indices">Indices to remap.</param>
+			/// <returns>Count of vertices removed.</returns>
+			static Uint32 DeduplicateVertices( AE_InOut Vertex3DArray& _Vertices, AE_InOut std::vector<Uint32>& _Indices );
+
+			/// <summary>Reorder the triangles of a range of a triangle list to maximize the hits in the post transform cache.</summary>
+			/// <param name="_Indices">Triangle list to reorder.</param>
+			/// <param name="_FirstIndex">First index of the range, multiple of 3.</param>
+			/// <param name="_IndicesCount">Count of indices of the range, multiple of 3.</param>
+			/// <param name="_VerticesCount">Count of vertices indexed.</param>
+			static void OptimizeVertexCache( AE_InOut std::vector<Uint32>& _Indices, Uint32 _FirstIndex, Uint32 _IndicesCount, Uint32 _VerticesCount );
+
+			/// <summary>
+			/// Sort the vertices in the order of their first use in the indices and remap them.<para/>
+			/// The vertices not used by any triangle are removed.
+			/// </summary>
+			/// <param name="_Vertices">Vertices to reorder.</param>
+			/// <param name="_Indices">Indices to remap.</param>
+			static void OptimizeVertexFetch( AE_InOut Vertex3DArray& _Vertices, AE_InOut std::vector<Uint32>& _Indices );
+
+			/// <summary>Compute the average cache miss ratio of a range of a triangle list with a FIFO cache.</summary>
+			/// <param name="_Indices">Triangle list.</param>
+			/// <param name="_FirstIndex">First index of the range.</param>
+			/// <param name="_IndicesCount">Count of indices of the range.</param>
+			/// <param name="_CacheSize">Count of vertices kept in the simulated cache.</param>
+			/// <returns>Count of vertices transformed per triangle : 3 without reuse, 0.5 at best on a regular grid.</returns>
+			static float ComputeACMR( const std::vector<Uint32>& _Indices, Uint32 _FirstIndex, Uint32 _IndicesCount, Uint32 _CacheSize = ACMRCacheSize );
+
+			/// <summary>Get the smallest index type able to address a count of vertices.</summary>
+			/// <param name="_VerticesCount">Count of vertices to index.</param>
+			/// <returns>16 bits indices when possible, 32 bits otherwise.</returns>
+			static IndexType SelectIndexType( size_t _VerticesCount );
+
+			/// <summary>Get the size in bytes of one index.</summary>
+			/// <param name="_Type">Type of the indices.</param>
+			/// <returns>Size of one index.</returns>
+			static Uint32 GetIndexSize( IndexType _Type );
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _MESHOPTIMIZER_AERO_H_
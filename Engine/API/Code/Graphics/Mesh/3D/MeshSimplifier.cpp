@@ -0,0 +1,413 @@
+#include "MeshSimplifier.h"
+
+#include "../../../Maths/Functions/MathsFunctions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ae
+{
+	namespace priv
+	{
+		namespace
+		{
+			/// <summary>Symmetric 4x4 matrix summing the squared distances to a set of planes : a2 ab ac ad b2 bc bd c2 cd d2.</summary>
+			struct Quadric
+			{
+				double Values[10] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+				/// <summary>Add the plane ax + by + cz + d = 0, normal normalized.</summary>
+				void AddPlane( double _A, double _B, double _C, double _D )
+				{
+					Values[0] += _A * _A; Values[1] += _A * _B; Values[2] += _A * _C; Values[3] += _A * _D;
+					Values[4] += _B * _B; Values[5] += _B * _C; Values[6] += _B * _D;
+					Values[7] += _C * _C; Values[8] += _C * _D;
+					Values[9] += _D * _D;
+				}
+
+				void Add( const Quadric& _Other )
+				{
+					for( Uint32 i = 0; i < 10; i++ )
+						Values[i] += _Other.Values[i];
+				}
+
+				/// <summary>Sum of the squared distances of a point to the planes.</summary>
+				double Evaluate( const Vector3& _Point ) const
+				{
+					const double X = _Point.X;
+					const double Y = _Point.Y;
+					const double Z = _Point.Z;
+
+					const double Result = Values[0] * X * X + 2.0 * Values[1] * X * Y + 2.0 * Values[2] * X * Z + 2.0 * Values[3] * X
+										+ Values[4] * Y * Y + 2.0 * Values[5] * Y * Z + 2.0 * Values[6] * Y
+										+ Values[7] * Z * Z + 2.0 * Values[8] * Z
+										+ Values[9];
+
+					// Rounding can make it slightly negative.
+					return Result > 0.0 ? Result : 0.0;
+				}
+			};
+
+			/// <summary>Removal of the vertex From, its triangles are moved to the vertex To.</summary>
+			struct EdgeCollapse
+			{
+				Uint32 From;
+				Uint32 To;
+				double Cost;
+
+				Bool operator<( const EdgeCollapse& _Other ) const
+				{
+					if( Cost != _Other.Cost )
+						return Cost < _Other.Cost;
+
+					if( From != _Other.From )
+						return From < _Other.From;
+
+					return To < _Other.To;
+				}
+			};
+
+			/// <summary>Key of an undirected edge, same for both directions.</summary>
+			inline Uint64 MakeEdgeKey( Uint32 _A, Uint32 _B )
+			{
+				return _A < _B ? ( Cast( Uint64, _A ) << 32 ) | _B : ( Cast( Uint64, _B ) << 32 ) | _A;
+			}
+
+			inline Vector3 TriangleNormal( const Vector3& _A, const Vector3& _B, const Vector3& _C )
+			{
+				return ( _B - _A ).Cross( _C - _A );
+			}
+
+			/// <summary>Give to each vertex the index of the first vertex with the same position, to see through the attribute seams.</summary>
+			void BuildPositionRemap( const Vertex3DArray& _Vertices, AE_Out std::vector<Uint32>& _Remap )
+			{
+				const Uint32 VerticesCount = Cast( Uint32, _Vertices.size() );
+
+				std::vector<Uint32> Order( VerticesCount );
+				std::iota( Order.begin(), Order.end(), 0u );
+
+				// Sort by position then by index : the smallest index of each position comes first, whatever the sort implementation.
+				std::sort( Order.begin(), Order.end(), [&_Vertices]( Uint32 _A, Uint32 _B )
+				{
+					const Vector3& A = _Vertices[_A].Position;
+					const Vector3& B = _Vertices[_B].Position;
+
+					if( A.X != B.X ) return A.X < B.X;
+					if( A.Y != B.Y ) return A.Y < B.Y;
+					if( A.Z != B.Z ) return A.Z < B.Z;
+					return _A < _B;
+				} );
+
+				_Remap.resize( VerticesCount );
+
+				for( Uint32 i = 0; i < VerticesCount; i++ )
+				{
+					const Uint32 Vertex = Order[i];
+					const Bool SameAsPrevious = i > 0 && _Vertices[Order[i - 1]].Position == _Vertices[Vertex].Position;
+
+					_Remap[Vertex] = SameAsPrevious ? _Remap[Order[i - 1]] : Vertex;
+				}
+			}
+
+			/// <summary>Lock the vertices on seams, borders and non manifold edges : removing them would open the surface.</summary>
+			void BuildLockedVertices( const std::vector<Uint32>& _Indices, const std::vector<Uint32>& _Remap, AE_Out std::vector<Uint8>& _Locked )
+			{
+				const Uint32 VerticesCount = Cast( Uint32, _Remap.size() );
+
+				_Locked.assign( VerticesCount, 0 );
+
+				std::vector<Uint32> PositionUses( VerticesCount, 0 );
+				for( Uint32 v = 0; v < VerticesCount; v++ )
+					PositionUses[_Remap[v]]++;
+
+				for( Uint32 v = 0; v < VerticesCount; v++ )
+				{
+					if( PositionUses[_Remap[v]] > 1 )
+						_Locked[_Remap[v]] = 1;
+				}
+
+				// Edges used by exactly two triangles are inside the surface, the others are borders or non manifold.
+				std::vector<Uint64> Edges;
+				Edges.reserve( _Indices.size() );
+
+				for( size_t t = 0; t + 2 < _Indices.size(); t += 3 )
+				{
+					for( Uint32 e = 0; e < 3; e++ )
+						Edges.push_back( MakeEdgeKey( _Remap[_Indices[t + e]], _Remap[_Indices[t + ( e + 1 ) % 3]] ) );
+				}
+
+				std::sort( Edges.begin(), Edges.end() );
+
+				for( size_t Start = 0; Start < Edges.size(); )
+				{
+					size_t End = Start + 1;
+					while( End < Edges.size() && Edges[End] == Edges[Start] )
+						End++;
+
+					if( End - Start != 2 )
+					{
+						_Locked[Cast( Uint32, Edges[Start] >> 32 )] = 1;
+						_Locked[Cast( Uint32, Edges[Start] & 0xFFFFFFFFull )] = 1;
+					}
+
+					Start = End;
+				}
+			}
+
+		} // anonymous
+
+		float MeshSimplifier::Simplify( const Vertex3DArray& _Vertices, const std::vector<Uint32>& _Indices, Uint32 _TargetIndicesCount, AE_Out std::vector<Uint32>& _Result )
+		{
+			const Uint32 VerticesCount = Cast( Uint32, _Vertices.size() );
+
+			// Start without the degenerated triangles.
+			_Result.clear();
+			_Result.reserve( _Indices.size() );
+
+			for( size_t t = 0; t + 2 < _Indices.size(); t += 3 )
+			{
+				const Uint32 A = _Indices[t];
+				const Uint32 B = _Indices[t + 1];
+				const Uint32 C = _Indices[t + 2];
+
+				if( A != B && B != C && A != C && A < VerticesCount && B < VerticesCount && C < VerticesCount )
+				{
+					_Result.push_back( A );
+					_Result.push_back( B );
+					_Result.push_back( C );
+				}
+			}
+
+			std::vector<Uint32> Remap;
+			BuildPositionRemap( _Vertices, Remap );
+
+			std::vector<Uint8> Locked;
+			BuildLockedVertices( _Result, Remap, Locked );
+
+			// Quadrics are shared by the vertices of a seam.
+			std::vector<Quadric> Quadrics( VerticesCount );
+
+			for( size_t t = 0; t < _Result.size(); t += 3 )
+			{
+				const Vector3& A = _Vertices[_Result[t]].Position;
+				const Vector3 Normal = TriangleNormal( A, _Vertices[_Result[t + 1]].Position, _Vertices[_Result[t + 2]].Position );
+				const float Length = Normal.Length();
+
+				if( Length <= 0.0f )
+					continue;
+
+				const Vector3 PlaneNormal = Normal / Length;
+				const double Distance = -Cast( double, PlaneNormal.Dot( A ) );
+
+				for( Uint32 i = 0; i < 3; i++ )
+					Quadrics[Remap[_Result[t + i]]].AddPlane( PlaneNormal.X, PlaneNormal.Y, PlaneNormal.Z, Distance );
+			}
+
+			double MaxCost = 0.0;
+
+			std::vector<Uint32> TrianglesOffsets;
+			std::vector<Uint32> VertexTriangles;
+			std::vector<Uint64> Edges;
+			std::vector<EdgeCollapse> Collapses;
+			std::vector<Uint32> CollapseTarget( VerticesCount );
+			std::vector<Uint8> Touched;
+
+			// Each pass collapses the cheapest independent edges, the adjacency is rebuilt between the passes.
+			while( _Result.size() > _TargetIndicesCount )
+			{
+				const Uint32 TrianglesCount = Cast( Uint32, _Result.size() / 3 );
+
+				// Triangles of each vertex.
+				TrianglesOffsets.assign( VerticesCount + 1, 0 );
+				for( Uint32 Index : _Result )
+					TrianglesOffsets[Index + 1]++;
+
+				for( Uint32 v = 0; v < VerticesCount; v++ )
+					TrianglesOffsets[v + 1] += TrianglesOffsets[v];
+
+				VertexTriangles.resize( _Result.size() );
+				std::vector<Uint32> Cursors( TrianglesOffsets.begin(), TrianglesOffsets.end() - 1 );
+
+				for( Uint32 t = 0; t < TrianglesCount; t++ )
+				{
+					for( Uint32 i = 0; i < 3; i++ )
+						VertexTriangles[Cursors[_Result[t * 3 + i]]++] = t;
+				}
+
+				// Cheapest direction of each edge.
+				Edges.clear();
+				for( Uint32 t = 0; t < TrianglesCount; t++ )
+				{
+					for( Uint32 e = 0; e < 3; e++ )
+						Edges.push_back( MakeEdgeKey( _Result[t * 3 + e], _Result[t * 3 + ( e + 1 ) % 3] ) );
+				}
+
+				std::sort( Edges.begin(), Edges.end() );
+				Edges.erase( std::unique( Edges.begin(), Edges.end() ), Edges.end() );
+
+				Collapses.clear();
+				for( Uint64 Edge : Edges )
+				{
+					const Uint32 A = Cast( Uint32, Edge >> 32 );
+					const Uint32 B = Cast( Uint32, Edge & 0xFFFFFFFFull );
+
+					if( Remap[A] == Remap[B] )
+						continue;
+
+					Quadric EdgeQuadric = Quadrics[Remap[A]];
+					EdgeQuadric.Add( Quadrics[Remap[B]] );
+
+					const Bool CanRemoveA = Locked[Remap[A]] == 0;
+					const Bool CanRemoveB = Locked[Remap[B]] == 0;
+
+					if( !CanRemoveA && !CanRemoveB )
+						continue;
+
+					const double CostAToB = CanRemoveA ? EdgeQuadric.Evaluate( _Vertices[B].Position ) : Math::Max<double>();
+					const double CostBToA = CanRemoveB ? EdgeQuadric.Evaluate( _Vertices[A].Position ) : Math::Max<double>();
+
+					if( CostAToB <= CostBToA )
+						Collapses.push_back( { A, B, CostAToB } );
+					else
+						Collapses.push_back( { B, A, CostBToA } );
+				}
+
+				if( Collapses.empty() )
+					break;
+
+				std::sort( Collapses.begin(), Collapses.end() );
+
+				// A collapse removes about two triangles. Don't go much further than needed in the cost order,
+				// the next pass will have more accurate quadrics.
+				const Uint32 TrianglesToRemove = ( TrianglesCount * 3 - _TargetIndicesCount + 2 ) / 3;
+				const size_t LimitIndex = Math::Min( Collapses.size() - 1, Cast( size_t, TrianglesToRemove / 2 ) );
+				const double CostLimit = Collapses[LimitIndex].Cost * 1.5 + Math::Epsilon<double>();
+
+				std::iota( CollapseTarget.begin(), CollapseTarget.end(), 0u );
+				Touched.assign( VerticesCount, 0 );
+
+				Uint32 RemovedTriangles = 0;
+				Uint32 CollapsesCount = 0;
+
+				for( const EdgeCollapse& Collapse : Collapses )
+				{
+					if( RemovedTriangles >= TrianglesToRemove || Collapse.Cost > CostLimit )
+						break;
+
+					if( Touched[Collapse.From] || Touched[Collapse.To] )
+						continue;
+
+					const Vector3& FromPosition = _Vertices[Collapse.From].Position;
+					const Vector3& ToPosition = _Vertices[Collapse.To].Position;
+
+					// Reject the collapses flipping a triangle.
+					Bool IsValid = True;
+					Uint32 CollapsedTriangles = 0;
+
+					for( Uint32 i = TrianglesOffsets[Collapse.From]; i < TrianglesOffsets[Collapse.From + 1] && IsValid; i++ )
+					{
+						const Uint32* Triangle = &_Result[VertexTriangles[i] * 3];
+
+						if( Triangle[0] == Collapse.To || Triangle[1] == Collapse.To || Triangle[2] == Collapse.To )
+						{
+							CollapsedTriangles++;
+							continue;
+						}
+
+						Vector3 Corners[3] = { _Vertices[Triangle[0]].Position, _Vertices[Triangle[1]].Position, _Vertices[Triangle[2]].Position };
+						const Vector3 OldNormal = TriangleNormal( Corners[0], Corners[1], Corners[2] );
+
+						for( Uint32 c = 0; c < 3; c++ )
+						{
+							if( Triangle[c] == Collapse.From )
+								Corners[c] = ToPosition;
+						}
+
+						const Vector3 NewNormal = TriangleNormal( Corners[0], Corners[1], Corners[2] );
+
+						IsValid = OldNormal.Dot( NewNormal ) > 0.0f;
+					}
+
+					if( !IsValid || FromPosition == ToPosition )
+						continue;
+
+					// Freeze the neighborhood, the adjacency is not updated until the next pass.
+					for( Uint32 i = TrianglesOffsets[Collapse.From]; i < TrianglesOffsets[Collapse.From + 1]; i++ )
+					{
+						const Uint32* Triangle = &_Result[VertexTriangles[i] * 3];
+						Touched[Triangle[0]] = Touched[Triangle[1]] = Touched[Triangle[2]] = 1;
+					}
+
+					CollapseTarget[Collapse.From] = Collapse.To;
+					Quadrics[Remap[Collapse.To]].Add( Quadrics[Remap[Collapse.From]] );
+
+					MaxCost = Math::Max( MaxCost, Collapse.Cost );
+					RemovedTriangles += CollapsedTriangles;
+					CollapsesCount++;
+				}
+
+				if( CollapsesCount == 0 )
+					break;
+
+				// Move the triangles of the removed vertices and drop the collapsed ones.
+				size_t WriteCursor = 0;
+
+				for( size_t t = 0; t < _Result.size(); t += 3 )
+				{
+					const Uint32 A = CollapseTarget[_Result[t]];
+					const Uint32 B = CollapseTarget[_Result[t + 1]];
+					const Uint32 C = CollapseTarget[_Result[t + 2]];
+
+					if( Remap[A] == Remap[B] || Remap[B] == Remap[C] || Remap[A] == Remap[C] )
+						continue;
+
+					_Result[WriteCursor++] = A;
+					_Result[WriteCursor++] = B;
+					_Result[WriteCursor++] = C;
+				}
+
+				_Result.resize( WriteCursor );
+			}
+
+			return Cast( float, std::sqrt( MaxCost ) );
+		}
+
+		void MeshSimplifier::BuildLODChain( const Vertex3DArray& _Vertices, AE_InOut std::vector<Uint32>& _Indices, AE_Out std::vector<MeshLOD>& _LODs, const MeshLODSettings& _Settings )
+		{
+			_LODs.assign( 1, MeshLOD() );
+			_LODs[0].IndicesCount = Cast( Uint32, _Indices.size() );
+
+			// Each level is simplified from the full mesh, the quadrics measure the error against the original surface.
+			const std::vector<Uint32> FullMesh( _Indices );
+			std::vector<Uint32> Level;
+
+			const float Ratio = Math::Clamp( 0.05f, 0.95f, _Settings.ReductionRatio );
+
+			for( Uint32 l = 1; l < _Settings.MaxLODsCount; l++ )
+			{
+				const MeshLOD& Previous = _LODs.back();
+				const Uint32 TargetTriangles = Cast( Uint32, Cast( float, Previous.IndicesCount / 3 ) * Ratio );
+
+				if( TargetTriangles < _Settings.MinTrianglesCount )
+					break;
+
+				const float Error = Simplify( _Vertices, FullMesh, TargetTriangles * 3, Level );
+
+				// The locked vertices prevent to go further, the level would be almost the same as the previous one.
+				if( Cast( float, Level.size() ) > Cast( float, Previous.IndicesCount ) * 0.9f )
+					break;
+
+				MeshLOD NewLOD;
+				NewLOD.FirstIndex = Cast( Uint32, _Indices.size() );
+				NewLOD.IndicesCount = Cast( Uint32, Level.size() );
+				NewLOD.Error = Math::Max( Error, Previous.Error );
+
+				_Indices.insert( _Indices.end(), Level.begin(), Level.end() );
+				_LODs.push_back( NewLOD );
+			}
+		}
+
+	} // priv
+
+} // ae
@@ -0,0 +1,61 @@
+#ifndef _MESHSIMPLIFIER_AERO_H_
+#define _MESHSIMPLIFIER_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../Vertex/VertexArray.h"
+#include "CookedMesh.h"
+
+#include <vector>
+
+namespace ae
+{
+	namespace priv
+	{
+		/// <summary>Settings of the generation of the levels of detail of a mesh.</summary>
+		struct MeshLODSettings
+		{
+			/// <summary>Maximum count of levels, the full mesh included.</summary>
+			Uint32 MaxLODsCount = 5;
+
+			/// <summary>Ratio of triangles kept from a level to the next one.</summary>
+			float ReductionRatio = 0.5f;
+
+			/// <summary>No level is generated under this count of triangles.</summary>
+			Uint32 MinTrianglesCount = 128;
+		};
+
+		/// \ingroup graphics
+		/// <summary>
+		/// Reduce the triangles count of a mesh with edge collapses ordered by quadric error (Garland and Heckbert).<para/>
+		/// The vertices are never moved nor created, only the indices change : all the levels of detail share the vertex buffer.
+		/// The vertices on the borders and on the attribute seams (same position, other attributes) are never removed to avoid cracks.<para/>
+		/// CPU only and deterministic : the same input always gives the same output, it can run in a cooking tool without context.
+		/// </summary>
+		/// <seealso cref="SharedGeometry" />
+		class AERO_CORE_EXPORT MeshSimplifier
+		{
+		public:
+			/// <summary>Simplify a triangle list until a count of indices is reached or no edge can be collapsed.</summary>
+			/// <param name="_Vertices">Vertices of the mesh.</param>
+			/// <param name="_Indices">Triangle list to simplify.</param>
+			/// <param name="_TargetIndicesCount">Count of indices to reach.</param>
+			/// <param name="_Result">Simplified triangle list, indexing <paramref name="_Vertices"/>.</param>
+			/// <returns>Geometric error of the result, as a distance in the space of the vertices.</returns>
+			static float Simplify( const Vertex3DArray& _Vertices, const std::vector<Uint32>& _Indices, Uint32 _TargetIndicesCount, AE_Out std::vector<Uint32>& _Result );
+
+			/// <summary>
+			/// Generate the levels of detail of a mesh and append their indices after the full mesh ones.<para/>
+			/// Stop when a level would have too few triangles or when the simplification cannot reduce the mesh anymore.
+			/// </summary>
+			/// <param name="_Vertices">Vertices of the mesh.</param>
+			/// <param name="_Indices">Triangle list of the full mesh, the indices of the levels are appended.</param>
+			/// <param name="_LODs">Ranges of each level in <paramref name="_Indices"/>, the first one is the full mesh.</param>
+			/// <param name="_Settings">Settings of the generation.</param>
+			static void BuildLODChain( const Vertex3DArray& _Vertices, AE_InOut std::vector<Uint32>& _Indices, AE_Out std::vector<MeshLOD>& _LODs, const MeshLODSettings& _Settings = MeshLODSettings() );
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _MESHSIMPLIFIER_AERO_H_
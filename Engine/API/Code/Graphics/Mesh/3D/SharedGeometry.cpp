@@ -0,0 +1,449 @@
+#include "SharedGeometry.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+
+#include "../../Dependencies/OpenGL.h"
+#include "../../../Debugging/Debugging.h"
+#include "../../../TimeManagement/Time/Time.h"
+#include "../../../Aero/Aero.h"
+
+#pragma warning( push )
+#pragma warning( disable : 26812 )
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/material.h>
+
+#pragma warning( pop )
+
+#include <algorithm>
+
+namespace ae
+{
+	namespace priv
+	{
+		std::string SharedGeometry::MakeKey( const std::string& _FileName, Uint32 _ImportFlags )
+		{
+			// The same file can be written with both separators.
+			std::string Key = _FileName;
+			std::replace( Key.begin(), Key.end(), '\\', '/' );
+
+			return Key + "|" + std::to_string( _ImportFlags );
+		}
+
+		Bool SharedGeometry::Cook( const std::string& _FileName, Uint32 _ImportFlags )
+		{
+			Uint64 SourceHash = 0;
+			if( !CookedMesh::HashFile( SourceHash, _FileName ) )
+			{
+				AE_LogError( std::string( "Can not open file : " ) + _FileName );
+				return False;
+			}
+
+			SharedGeometry Geometry;
+			if( !Geometry.Import( _FileName, _ImportFlags ) )
+			{
+				AE_LogError( Geometry.m_Error );
+				return False;
+			}
+
+			AE_LogMessage( Geometry.m_Message );
+
+			if( !Geometry.WriteCookedFile( _FileName, SourceHash, _ImportFlags ) )
+			{
+				AE_LogWarning( std::string( "Can not write cooked mesh : " ) + CookedMesh::GetCookedPath( _FileName ) );
+				return False;
+			}
+
+			return True;
+		}
+
+		SharedGeometry::SharedGeometry() :
+			m_Material( nullptr ),
+			m_VertexBufferObject( 0 ),
+			m_ElementsArrayObject( 0 ),
+			m_IndexType( IndexType::UnsignedInt ),
+			m_LoadTime( 0.0f ),
+			m_ReferencesCount( 0 ),
+			m_IsLoadedFromCookedFile( False ),
+			m_LoadingState( LoadingState::Pending ),
+			m_IsDecoded( False )
+		{
+		}
+
+		SharedGeometry::~SharedGeometry()
+		{
+			if( m_Material != nullptr )
+			{
+				delete m_Material;
+				m_Material = nullptr;
+			}
+
+			if( !Aero.CheckContext() )
+				return;
+
+			if( m_ElementsArrayObject )
+			{
+				glDeleteBuffers( 1, &m_ElementsArrayObject );
+				AE_ErrorCheckOpenGLError();
+				m_ElementsArrayObject = 0;
+			}
+
+			if( m_VertexBufferObject )
+			{
+				glDeleteBuffers( 1, &m_VertexBufferObject );
+				AE_ErrorCheckOpenGLError();
+				m_VertexBufferObject = 0;
+			}
+		}
+
+		Bool SharedGeometry::LoadFromFile( const std::string& _FileName, Uint32 _ImportFlags )
+		{
+			Decode( _FileName, _ImportFlags );
+			FinishLoading();
+
+			return m_LoadingState == LoadingState::Ready;
+		}
+
+		void SharedGeometry::Decode( const std::string& _FileName, Uint32 _ImportFlags )
+		{
+			const Time StartTime = Time::GetTick();
+
+			// The hash of the source tells if the cooked file is still valid.
+			Uint64 SourceHash = 0;
+			if( !CookedMesh::HashFile( SourceHash, _FileName ) )
+			{
+				m_Error = std::string( "Can not open file : " ) + _FileName;
+				return;
+			}
+
+			std::unique_ptr<CookedMesh> Cooked( new CookedMesh() );
+			if( Cooked->Open( CookedMesh::GetCookedPath( _FileName ), SourceHash, _ImportFlags ) )
+			{
+				m_Vertices.assign( Cooked->GetVertices(), Cooked->GetVertices() + Cooked->GetVerticesCount() );
+				Cooked->ReadIndices( m_Indices );
+				Cooked->ReadLODs( m_LODs );
+				m_BoundsMin = Cooked->GetBoundsMin();
+				m_BoundsMax = Cooked->GetBoundsMax();
+				m_Material = Cooked->CreateMaterial();
+				m_IsLoadedFromCookedFile = True;
+
+				// The vertices and the indices are stored as they are sent to the GPU, keep the file mapped to upload them straight from it.
+				m_Cooked = std::move( Cooked );
+			}
+			else
+			{
+				if( !Import( _FileName, _ImportFlags ) )
+					return;
+
+				if( !WriteCookedFile( _FileName, SourceHash, _ImportFlags ) )
+					m_Warning = std::string( "Can not write cooked mesh : " ) + CookedMesh::GetCookedPath( _FileName );
+
+				m_IsLoadedFromCookedFile = False;
+			}
+
+			m_IsDecoded = True;
+			m_LoadTime = Cast( float, Time::GetTick().AsMicroSeconds() - StartTime.AsMicroSeconds() ) * 0.000001f;
+		}
+
+		void SharedGeometry::FinishLoading()
+		{
+			// Messages of the decode are logged here, in order with the result of the load.
+			if( !m_Warning.empty() )
+				AE_LogWarning( m_Warning );
+
+			if( !m_Message.empty() )
+				AE_LogMessage( m_Message );
+
+			if( !m_IsDecoded )
+			{
+				AE_LogError( m_Error );
+				m_LoadingState = LoadingState::Failed;
+			}
+			else
+			{
+				const Time StartTime = Time::GetTick();
+
+				if( m_Cooked != nullptr )
+				{
+					// Uploaded as stored in the file : the 16 bits indices are not narrowed again from the copy read for the CPU.
+					const IndexType CookedIndexType = m_Cooked->GetIndexSize() == sizeof( Uint16 ) ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+					UploadBuffers( m_Cooked->GetVertices(), m_Cooked->GetIndices(), CookedIndexType );
+					m_Cooked.reset();
+				}
+				else if( MeshOptimizer::SelectIndexType( m_Vertices.size() ) == IndexType::UnsignedShort )
+				{
+					// Imported in this run : the indices are narrowed once, as they are written in the cooked file.
+					const std::vector<Uint16> ShortIndices( m_Indices.begin(), m_Indices.end() );
+					UploadBuffers( m_Vertices.data(), ShortIndices.data(), IndexType::UnsignedShort );
+				}
+				else
+					UploadBuffers( m_Vertices.data(), m_Indices.data(), IndexType::UnsignedInt );
+
+				m_LoadTime += Cast( float, Time::GetTick().AsMicroSeconds() - StartTime.AsMicroSeconds() ) * 0.000001f;
+				m_LoadingState = LoadingState::Ready;
+			}
+
+			// A callback can add or remove callbacks, run them from a copy.
+			std::vector<std::pair<const void*, std::function<void()>>> Callbacks;
+			Callbacks.swap( m_LoadedCallbacks );
+
+			for( std::pair<const void*, std::function<void()>>& Callback : Callbacks )
+				Callback.second();
+		}
+
+		LoadingState SharedGeometry::GetLoadingState() const
+		{
+			return m_LoadingState;
+		}
+
+		void SharedGeometry::AddLoadedCallback( const void* _Owner, std::function<void()> _Callback )
+		{
+			m_LoadedCallbacks.emplace_back( _Owner, std::move( _Callback ) );
+		}
+
+		void SharedGeometry::RemoveLoadedCallbacks( const void* _Owner )
+		{
+			m_LoadedCallbacks.erase( std::remove_if( m_LoadedCallbacks.begin(), m_LoadedCallbacks.end(),
+													 [_Owner]( const std::pair<const void*, std::function<void()>>& _Callback ) { return _Callback.first == _Owner; } ),
+									 m_LoadedCallbacks.end() );
+		}
+
+		Bool SharedGeometry::Import( const std::string& _FileName, Uint32 _ImportFlags )
+		{
+			Assimp::Importer Importer;
+			const aiScene* Scene = Importer.ReadFile( _FileName, _ImportFlags );
+
+			if( Scene == nullptr || Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || Scene->mRootNode == nullptr )
+			{
+				m_Error = std::string( "Failed to load " ) + _FileName + ". " + Importer.GetErrorString();
+				return False;
+			}
+
+			// For the moment, we support only one mesh per file.
+			aiMesh* FirstMesh = Scene->mNumMeshes > 0 ? Scene->mMeshes[0] : nullptr;
+
+			if( FirstMesh == nullptr )
+			{
+				m_Error = std::string( "Failed to load " ) + _FileName + ". The file has no mesh.";
+				return False;
+			}
+
+			m_Vertices.clear();
+			m_Vertices.resize( FirstMesh->mNumVertices );
+
+			m_Indices.clear();
+			m_Indices.resize( static_cast<size_t>( FirstMesh->mNumFaces ) * static_cast<size_t>( 3 ) );
+
+			for( unsigned int v = 0; v < FirstMesh->mNumVertices; v++ )
+			{
+				if( FirstMesh->mVertices != nullptr )
+				{
+					m_Vertices[v].Position.X = static_cast<float>( FirstMesh->mVertices[v].x );
+					m_Vertices[v].Position.Y = static_cast<float>( FirstMesh->mVertices[v].y );
+					m_Vertices[v].Position.Z = static_cast<float>( FirstMesh->mVertices[v].z );
+				}
+
+				if( FirstMesh->mNormals != nullptr )
+				{
+					m_Vertices[v].Normal.X = static_cast<float>( FirstMesh->mNormals[v].x );
+					m_Vertices[v].Normal.Y = static_cast<float>( FirstMesh->mNormals[v].y );
+					m_Vertices[v].Normal.Z = static_cast<float>( FirstMesh->mNormals[v].z );
+				}
+
+				// Take only the first vertex color.
+				if( FirstMesh->mColors != nullptr && FirstMesh->mColors[0] != nullptr )
+				{
+					m_Vertices[v].Color.R( static_cast<float>( FirstMesh->mColors[0][v].r ) );
+					m_Vertices[v].Color.G( static_cast<float>( FirstMesh->mColors[0][v].g ) );
+					m_Vertices[v].Color.B( static_cast<float>( FirstMesh->mColors[0][v].b ) );
+					m_Vertices[v].Color.A( static_cast<float>( FirstMesh->mColors[0][v].a ) );
+				}
+
+				// Take only the first UV dim.
+				if( FirstMesh->mTextureCoords != nullptr && FirstMesh->mTextureCoords[0] != nullptr )
+				{
+					m_Vertices[v].UV.X = static_cast<float>( FirstMesh->mTextureCoords[0][v].x );
+					m_Vertices[v].UV.Y = static_cast<float>( FirstMesh->mTextureCoords[0][v].y );
+				}
+			}
+
+			size_t IndiceCursor = 0;
+			for( unsigned int f = 0; f < FirstMesh->mNumFaces; f++ )
+			{
+				const aiFace& Face = FirstMesh->mFaces[f];
+
+				for( unsigned int i = 0; i < Face.mNumIndices; i++ )
+				{
+					m_Indices[IndiceCursor] = Face.mIndices[i];
+					IndiceCursor++;
+				}
+			}
+
+			// Bounds are saved in the cooked file, compute them once at import.
+			m_BoundsMin = m_Vertices.empty() ? Vector3::Zero : m_Vertices[0].Position;
+			m_BoundsMax = m_BoundsMin;
+
+			for( const Vertex3D& Vertex : m_Vertices )
+			{
+				m_BoundsMin.X = std::min( m_BoundsMin.X, Vertex.Position.X );
+				m_BoundsMin.Y = std::min( m_BoundsMin.Y, Vertex.Position.Y );
+				m_BoundsMin.Z = std::min( m_BoundsMin.Z, Vertex.Position.Z );
+
+				m_BoundsMax.X = std::max( m_BoundsMax.X, Vertex.Position.X );
+				m_BoundsMax.Y = std::max( m_BoundsMax.Y, Vertex.Position.Y );
+				m_BoundsMax.Z = std::max( m_BoundsMax.Z, Vertex.Position.Z );
+			}
+
+			// Measure the file order before any change.
+			MeshOptimizationStats Stats;
+			Stats.ACMRBefore = MeshOptimizer::ComputeACMR( m_Indices, 0, Cast( Uint32, m_Indices.size() ) );
+			Stats.VerticesCountBefore = Cast( Uint32, m_Vertices.size() );
+			Stats.BuffersSizeBefore = Cast( Uint64, m_Vertices.size() * sizeof( Vertex3D ) + m_Indices.size() * sizeof( Uint32 ) );
+
+			// Assimp splits the vertices per face for some formats, merge them before the simplification sees false seams.
+			MeshOptimizer::DeduplicateVertices( m_Vertices, m_Indices );
+
+			// The levels of detail are appended after the full mesh indices, they are cooked with it.
+			MeshSimplifier::BuildLODChain( m_Vertices, m_Indices, m_LODs );
+
+			// Each level is drawn alone, each one is ordered for the post transform cache.
+			for( const MeshLOD& LOD : m_LODs )
+				MeshOptimizer::OptimizeVertexCache( m_Indices, LOD.FirstIndex, LOD.IndicesCount, Cast( Uint32, m_Vertices.size() ) );
+
+			// The full mesh comes first in the indices : its vertices are the first fetched.
+			MeshOptimizer::OptimizeVertexFetch( m_Vertices, m_Indices );
+
+			Stats.ACMRAfter = MeshOptimizer::ComputeACMR( m_Indices, 0, m_LODs[0].IndicesCount );
+			Stats.VerticesCountAfter = Cast( Uint32, m_Vertices.size() );
+			Stats.BuffersSizeAfter = Cast( Uint64, m_Vertices.size() * sizeof( Vertex3D ) + m_Indices.size() * MeshOptimizer::GetIndexSize( MeshOptimizer::SelectIndexType( m_Vertices.size() ) ) );
+
+			m_Message = std::string( "Optimized " ) + _FileName + " : " + Stats.ToString();
+
+			// Keep the material description, the scene is freed with the importer.
+			if( Scene->mMaterials != nullptr && FirstMesh->mMaterialIndex < Scene->mNumMaterials && Scene->mMaterials[FirstMesh->mMaterialIndex] != nullptr )
+			{
+				m_Material = new aiMaterial();
+				aiMaterial::CopyPropertyList( m_Material, Scene->mMaterials[FirstMesh->mMaterialIndex] );
+			}
+
+			return True;
+		}
+
+		Bool SharedGeometry::WriteCookedFile( const std::string& _FileName, Uint64 _SourceHash, Uint32 _ImportFlags ) const
+		{
+			return CookedMesh::Write( CookedMesh::GetCookedPath( _FileName ), _SourceHash, _ImportFlags, m_Vertices, m_Indices, m_LODs, m_BoundsMin, m_BoundsMax, m_Material );
+		}
+
+		void SharedGeometry::UploadBuffers( const Vertex3D* _Vertices, const void* _Indices, IndexType _IndexType )
+		{
+			if( !Aero.CheckContext() )
+				return;
+
+			glGenBuffers( 1, &m_VertexBufferObject );
+			AE_ErrorCheckOpenGLError();
+
+			glGenBuffers( 1, &m_ElementsArrayObject );
+			AE_ErrorCheckOpenGLError();
+
+			glBindBuffer( GL_ARRAY_BUFFER, m_VertexBufferObject );
+			AE_ErrorCheckOpenGLError();
+
+			glBufferData( GL_ARRAY_BUFFER, m_Vertices.size() * sizeof( Vertex3D ), _Vertices, GL_STATIC_DRAW );
+			AE_ErrorCheckOpenGLError();
+
+			// No vertex array is bound here, upload the indices through the array buffer target.
+			// The buffer is bound as element buffer by the vertex array of each mesh.
+			glBindBuffer( GL_ARRAY_BUFFER, m_ElementsArrayObject );
+			AE_ErrorCheckOpenGLError();
+
+			m_IndexType = _IndexType;
+
+			glBufferData( GL_ARRAY_BUFFER, m_Indices.size() * MeshOptimizer::GetIndexSize( m_IndexType ), _Indices, GL_STATIC_DRAW );
+			AE_ErrorCheckOpenGLError();
+
+			glBindBuffer( GL_ARRAY_BUFFER, 0 );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		const Vertex3DArray& SharedGeometry::GetVertices() const
+		{
+			return m_Vertices;
+		}
+
+		const std::vector<Uint32>& SharedGeometry::GetIndices() const
+		{
+			return m_Indices;
+		}
+
+		const aiMaterial* SharedGeometry::GetMaterial() const
+		{
+			return m_Material;
+		}
+
+		const std::vector<MeshLOD>& SharedGeometry::GetLODs() const
+		{
+			return m_LODs;
+		}
+
+		const Vector3& SharedGeometry::GetBoundsMin() const
+		{
+			return m_BoundsMin;
+		}
+
+		const Vector3& SharedGeometry::GetBoundsMax() const
+		{
+			return m_BoundsMax;
+		}
+
+		Bool SharedGeometry::IsLoadedFromCookedFile() const
+		{
+			return m_IsLoadedFromCookedFile;
+		}
+
+		Uint32 SharedGeometry::GetVertexBufferObject() const
+		{
+			return m_VertexBufferObject;
+		}
+
+		Uint32 SharedGeometry::GetElementsArrayObject() const
+		{
+			return m_ElementsArrayObject;
+		}
+
+		IndexType SharedGeometry::GetIndexType() const
+		{
+			return m_IndexType;
+		}
+
+		Uint64 SharedGeometry::GetMemorySize() const
+		{
+			return Cast( Uint64, m_Vertices.size() * sizeof( Vertex3D ) + m_Indices.size() * MeshOptimizer::GetIndexSize( m_IndexType ) );
+		}
+
+		float SharedGeometry::GetLoadTime() const
+		{
+			return m_LoadTime;
+		}
+
+		void SharedGeometry::AddReference()
+		{
+			m_ReferencesCount++;
+		}
+
+		Uint32 SharedGeometry::RemoveReference()
+		{
+			if( m_ReferencesCount > 0 )
+				m_ReferencesCount--;
+
+			return m_ReferencesCount;
+		}
+
+		Uint32 SharedGeometry::GetReferencesCount() const
+		{
+			return m_ReferencesCount;
+		}
+
+	} // priv
+
+} // ae
@@ -0,0 +1,268 @@
+#ifndef _SHAREDGEOMETRY_AERO_H_
+#define _SHAREDGEOMETRY_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../../Idioms/NotCopiable/NotCopiable.h"
+#include "../../Vertex/VertexArray.h"
+#include "../../Primitives/PrimitivesType.h"
+#include "../../../Maths/Vector/Vector3.h"
+#include "CookedMesh.h"
+#include "../../../Resources/AsyncLoader/AsyncLoader.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+
+// Pre-declaration of Assimp material structure.
+struct aiMaterial;
+
+namespace ae
+{
+	/// \ingroup graphics
+	/// <summary>Statistics of the geometry cache of the resources manager.</summary>
+	/// <seealso cref="ResourcesManager::GetGeometryCacheStats" />
+	struct GeometryCacheStats
+	{
+		/// <summary>Count of geometries loaded in the cache.</summary>
+		Uint32 GeometriesCount = 0;
+
+		/// <summary>Count of meshes using a geometry of the cache.</summary>
+		Uint32 ReferencesCount = 0;
+
+		/// <summary>Count of loads answered by the cache.</summary>
+		Uint32 Hits = 0;
+
+		/// <summary>Count of loads that had to read the file.</summary>
+		Uint32 Misses = 0;
+
+		/// <summary>Size in bytes of the vertex and index buffers of the cached geometries.</summary>
+		Uint64 GPUMemory = 0;
+
+		/// <summary>Size in bytes of the buffers that would be duplicated without the cache.</summary>
+		Uint64 SavedGPUMemory = 0;
+
+		/// <summary>Time in seconds spent reading and uploading the cached geometries.</summary>
+		float LoadTime = 0.0f;
+
+		/// <summary>Time in seconds that would have been spent loading again the files answered by the cache.</summary>
+		float SavedLoadTime = 0.0f;
+	};
+
+	namespace priv
+	{
+		/// \ingroup graphics
+		/// <summary>
+		/// Geometry of a 3D file, loaded once and shared by all the meshes loading the same file with the same import flags.<para/>
+		/// Holds the vertex and index buffers, a CPU copy of the vertices and indices and the material description of the file.<para/>
+		/// The geometry is ref-counted by the resources manager and destroyed when the last mesh releases it.
+		/// </summary>
+		/// <seealso cref="Mesh3D" />
+		/// <seealso cref="ResourcesManager" />
+		class AERO_CORE_EXPORT SharedGeometry : public NotCopiable
+		{
+		public:
+			/// <summary>Build the key identifying a geometry in the cache.</summary>
+			/// <param name="_FileName">Path to the 3D file.</param>
+			/// <param name="_ImportFlags">Assimp post process flags.</param>
+			/// <returns>Key of the geometry.</returns>
+			static std::string MakeKey( const std::string& _FileName, Uint32 _ImportFlags );
+
+			/// <summary>
+			/// Import a 3D file and write its cooked version, without uploading anything to the GPU.<para/>
+			/// Allow to cook the files offline, the loading cooks them anyway when they are missing or outdated.
+			/// </summary>
+			/// <param name="_FileName">Path to the 3D file to cook.</param>
+			/// <param name="_ImportFlags">Assimp post process flags.</param>
+			/// <returns>True if the cooked file has been written, False otherwise.</returns>
+			static Bool Cook( const std::string& _FileName, Uint32 _ImportFlags );
+
+		public:
+			/// <summary>Build an empty geometry.</summary>
+			SharedGeometry();
+
+			/// <summary>Free the buffers and the material description.</summary>
+			~SharedGeometry();
+
+			/// <summary>
+			/// Read the first mesh of a 3D file and upload it to the GPU.<para/>
+			/// Use the cooked file if it is up to date, import the source and cook it otherwise.
+			/// </summary>
+			/// <param name="_FileName">Path to the 3D file to load.</param>
+			/// <param name="_ImportFlags">Assimp post process flags.</param>
+			/// <returns>True if the file has been loaded, False otherwise.</returns>
+			Bool LoadFromFile( const std::string& _FileName, Uint32 _ImportFlags );
+
+			/// <summary>
+			/// Read the first mesh of a 3D file, from its cooked version when up to date.<para/>
+			/// Doesn't touch OpenGL nor the logger and can run on a worker thread. Must be followed by FinishLoading.
+			/// </summary>
+			/// <param name="_FileName">Path to the 3D file to load.</param>
+			/// <param name="_ImportFlags">Assimp post process flags.</param>
+			void Decode( const std::string& _FileName, Uint32 _ImportFlags );
+
+			/// <summary>
+			/// Upload the decoded geometry to the GPU, log the decode errors and run the loaded callbacks.<para/>
+			/// Must be called on the context thread.
+			/// </summary>
+			void FinishLoading();
+
+			/// <summary>Retrieve the state of the loading.</summary>
+			/// <returns>Pending until FinishLoading is called, then Ready or Failed.</returns>
+			LoadingState GetLoadingState() const;
+
+			/// <summary>Add a function to call once the geometry is loaded, whether the loading succeeded or not.</summary>
+			/// <param name="_Owner">Owner of the callback, to remove it.</param>
+			/// <param name="_Callback">Function to call.</param>
+			void AddLoadedCallback( const void* _Owner, std::function<void()> _Callback );
+
+			/// <summary>Remove all the loaded callbacks of an owner. Must be called by owners destroyed before the end of the loading.</summary>
+			/// <param name="_Owner">Owner of the callbacks to remove.</param>
+			void RemoveLoadedCallbacks( const void* _Owner );
+
+			/// <summary>Retrieve the vertices of the geometry.</summary>
+			/// <returns>Vertices of the geometry.</returns>
+			const Vertex3DArray& GetVertices() const;
+
+			/// <summary>Retrieve the triangles indices of the geometry, the levels of detail follow the full mesh ones.</summary>
+			/// <returns>Indices of the geometry.</returns>
+			const std::vector<Uint32>& GetIndices() const;
+
+			/// <summary>Retrieve the material description of the file.</summary>
+			/// <returns>Material of the mesh in the file. Can be null.</returns>
+			const aiMaterial* GetMaterial() const;
+
+			/// <summary>Retrieve the levels of detail of the geometry.</summary>
+			/// <returns>Ranges of indices of each level, the first one is the full mesh.</returns>
+			const std::vector<MeshLOD>& GetLODs() const;
+
+			/// <summary>Get the minimum corner of the bounding box of the geometry.</summary>
+			/// <returns>Minimum corner, in model space.</returns>
+			const Vector3& GetBoundsMin() const;
+
+			/// <summary>Get the maximum corner of the bounding box of the geometry.</summary>
+			/// <returns>Maximum corner, in model space.</returns>
+			const Vector3& GetBoundsMax() const;
+
+			/// <summary>Was the geometry read from a cooked file ?</summary>
+			/// <returns>True if the geometry comes from a cooked file, False if the source has been imported.</returns>
+			Bool IsLoadedFromCookedFile() const;
+
+			/// <summary>Get the OpenGL vertex buffer ID.</summary>
+			/// <returns>ID of the OpenGL vertex buffer.</returns>
+			Uint32 GetVertexBufferObject() const;
+
+			/// <summary>Get the OpenGL elements buffer ID.</summary>
+			/// <returns>ID of the OpenGL elements buffer.</returns>
+			Uint32 GetElementsArrayObject() const;
+
+			/// <summary>Get the type of the indices in the elements buffer.</summary>
+			/// <returns>16 bits when the vertices count allows it, 32 bits otherwise.</returns>
+			IndexType GetIndexType() const;
+
+			/// <summary>Get the size in bytes of the vertex and index buffers.</summary>
+			/// <returns>Size of the buffers.</returns>
+			Uint64 GetMemorySize() const;
+
+			/// <summary>Get the time spent reading the file and uploading the buffers.</summary>
+			/// <returns>Load time in seconds.</returns>
+			float GetLoadTime() const;
+
+			/// <summary>Add a mesh using the geometry.</summary>
+			void AddReference();
+
+			/// <summary>Remove a mesh using the geometry.</summary>
+			/// <returns>Count of meshes still using the geometry.</returns>
+			Uint32 RemoveReference();
+
+			/// <summary>Get the count of meshes using the geometry.</summary>
+			/// <returns>Count of meshes using the geometry.</returns>
+			Uint32 GetReferencesCount() const;
+
+		private:
+			/// <summary>
+			/// Read the first mesh of the source file with Assimp.<para/>
+			/// The vertices are deduplicated, the levels of detail generated, then the triangles and the vertices reordered for the GPU caches.
+			/// </summary>
+			/// <param name="_FileName">Path to the 3D file to import.</param>
+			/// <param name="_ImportFlags">Assimp post process flags.</param>
+			/// <returns>True if the file has been imported, False otherwise.</returns>
+			Bool Import( const std::string& _FileName, Uint32 _ImportFlags );
+
+			/// <summary>Write the cooked version of the imported geometry.</summary>
+			/// <param name="_FileName">Path to the source 3D file.</param>
+			/// <param name="_SourceHash">Hash of the source file content.</param>
+			/// <param name="_ImportFlags">Assimp post process flags used to import the file.</param>
+			/// <returns>True if the cooked file has been written, False otherwise.</returns>
+			Bool WriteCookedFile( const std::string& _FileName, Uint64 _SourceHash, Uint32 _ImportFlags ) const;
+
+			/// <summary>Create the OpenGL buffers and fill them.</summary>
+			/// <param name="_Vertices">Vertices to upload, <c>m_Vertices</c> size is used as count.</param>
+			/// <param name="_Indices">Indices to upload, <c>m_Indices</c> size is used as count.</param>
+			/// <param name="_IndexType">Type of the indices to upload, kept to draw them.</param>
+			void UploadBuffers( const Vertex3D* _Vertices, const void* _Indices, IndexType _IndexType );
+
+		private:
+			/// <summary>Vertices of the geometry.</summary>
+			Vertex3DArray m_Vertices;
+
+			/// <summary>Triangles indices of all the levels of detail, in 32 bits for the CPU reads. The elements buffer can hold them in 16 bits.</summary>
+			std::vector<Uint32> m_Indices;
+
+			/// <summary>Levels of detail, ranges in the indices.</summary>
+			std::vector<MeshLOD> m_LODs;
+
+			/// <summary>Minimum corner of the bounding box.</summary>
+			Vector3 m_BoundsMin;
+
+			/// <summary>Maximum corner of the bounding box.</summary>
+			Vector3 m_BoundsMax;
+
+			/// <summary>Copy of the material description of the file.</summary>
+			aiMaterial* m_Material;
+
+			/// <summary>OpenGL vertex buffer.</summary>
+			Uint32 m_VertexBufferObject;
+
+			/// <summary>OpenGL elements buffer.</summary>
+			Uint32 m_ElementsArrayObject;
+
+			/// <summary>Type of the indices in the elements buffer, 16 bits when the vertices count allows it.</summary>
+			IndexType m_IndexType;
+
+			/// <summary>Time in seconds spent loading the geometry.</summary>
+			float m_LoadTime;
+
+			/// <summary>Count of meshes using the geometry.</summary>
+			Uint32 m_ReferencesCount;
+
+			/// <summary>Does the geometry come from a cooked file ?</summary>
+			Bool m_IsLoadedFromCookedFile;
+
+			/// <summary>State of the loading.</summary>
+			LoadingState m_LoadingState;
+
+			/// <summary>Has the decode step succeeded ?</summary>
+			Bool m_IsDecoded;
+
+			/// <summary>Cooked file kept mapped between the decode and the upload.</summary>
+			std::unique_ptr<CookedMesh> m_Cooked;
+
+			/// <summary>Error of the decode step, logged by FinishLoading.</summary>
+			std::string m_Error;
+
+			/// <summary>Warning of the decode step, logged by FinishLoading.</summary>
+			std::string m_Warning;
+
+			/// <summary>Report of the optimization done by the import, logged by FinishLoading.</summary>
+			std::string m_Message;
+
+			/// <summary>Functions to call once loaded, with their owner.</summary>
+			std::vector<std::pair<const void*, std::function<void()>>> m_LoadedCallbacks;
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _SHAREDGEOMETRY_AERO_H_
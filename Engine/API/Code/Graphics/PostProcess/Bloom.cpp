@@ -49,6 +49,7 @@ namespace ae
 			FramebufferAttachement AttachementColor( FramebufferAttachement::Type::Color_0, _Texture.GetFormat(), _Texture.GetFilterMode(), _Texture.GetDimension() );
 			FramebufferAttachement AttachementBrightColor( FramebufferAttachement::Type::Color_1, _Texture.GetFormat(), _Texture.GetFilterMode(), _Texture.GetDimension() );
 			m_FBO = std::make_unique<Framebuffer>( _Texture.GetWidth(), _Texture.GetHeight(), std::initializer_list<FramebufferAttachement>{ AttachementColor, AttachementBrightColor } );
+			m_FBO->SetPassName( "Bloom" );
 
 			m_FBO->Bind();
 			m_FBO->SetDepthMode( DepthMode::NoDepthTest );
@@ -40,6 +40,7 @@ namespace ae
 
 			FramebufferAttachement Attachement( FramebufferAttachement::Type::Color_0, _Texture.GetFormat(), _Texture.GetFilterMode(), _Texture.GetDimension() );
 			m_FBO = std::make_unique<Framebuffer>( _Texture.GetWidth(), _Texture.GetHeight(), Attachement );
+			m_FBO->SetPassName( "Gamma Correction" );
 
 			m_FBO->Bind();
 			m_FBO->SetDepthMode( DepthMode::NoDepthTest );
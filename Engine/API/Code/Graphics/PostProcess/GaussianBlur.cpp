@@ -197,6 +197,8 @@ namespace ae
 		FramebufferAttachement Attachement( FramebufferAttachement::Type::Color_0, _Texture.GetFormat(), TextureFilterMode::Linear, TextureDimension::Texture2D );
 		m_HorizontalFBO = std::make_unique<Framebuffer>( _Width, _Height, Attachement );
 		m_VerticalFBO = std::make_unique<Framebuffer>( _Width, _Height, Attachement );
+		m_HorizontalFBO->SetPassName( "Horizontal Blur" );
+		m_VerticalFBO->SetPassName( "Vertical Blur" );
 
 		m_HorizontalFBO->GetAttachementTexture()->SetWrapMode( TextureWrapMode::ClampToEdge );
 		m_VerticalFBO->GetAttachementTexture()->SetWrapMode( TextureWrapMode::ClampToEdge );
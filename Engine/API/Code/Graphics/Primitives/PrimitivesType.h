@@ -94,6 +94,19 @@ namespace ae
         /// </summary>
         Patches = GL_PATCHES
     };
+
+    /// \ingroup graphics
+    /// <summary>
+    /// Type of the values in an index buffer.
+    /// </summary>
+    enum class IndexType : GLenum
+    {
+        /// <summary>16 bits indices, for the buffers indexing at most 65536 vertices. Half the size and bandwidth.</summary>
+        UnsignedShort = GL_UNSIGNED_SHORT,
+
+        /// <summary>32 bits indices.</summary>
+        UnsignedInt = GL_UNSIGNED_INT
+    };
 } // ae
 
 #endif
\ No newline at end of file
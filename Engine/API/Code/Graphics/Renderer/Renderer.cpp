@@ -9,6 +9,7 @@
 #include "../Texture/Texture.h"
 #include "../Shader/Shader.h"
 #include "../Light/Lights.h"
+#include "../Light/LightClusters/LightClusters.h"
 #include "../../Maths/Transform/Transform.h"
 #include "../../Maths/Transform/Transform2D.h"
 #include "../../World/World.h"
@@ -24,7 +25,9 @@ namespace ae
 	Renderer::Renderer() :
 		m_DrawMode( DrawMode::Unknown ),
 		m_CullingMode( CullingMode::Unknown ),
-		m_DepthMode( DepthMode::Unknown )
+		m_DepthMode( DepthMode::Unknown ),
+		m_IsFrustumCullingEnabled( True ),
+		m_CulledObjectsCount( 0 )
 	{
 	}
 	Renderer::~Renderer()
@@ -57,6 +60,8 @@ namespace ae
 
 		glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 		AE_ErrorCheckOpenGLError();
+
+		m_CulledObjectsCount = 0;
 	}
 
 	void Renderer::Draw( const Drawable& _Object, Camera* _Camera )
@@ -70,7 +75,9 @@ namespace ae
 		if( !_Object.IsEnabled() )
 			return;
 
-		if( _Material.GetShader() == nullptr )
+		// Instanced drawables need a shader reading the model matrix from the instance attributes, specialized for the material flags.
+		const Shader* MaterialShader = _Material.SelectShader( _Object.IsInstanced() );
+		if( MaterialShader == nullptr )
 		{
 			AE_LogWarning( "Invalid shader. Object will not be drawn." );
 			return;
@@ -83,7 +90,7 @@ namespace ae
 		}
 
 		// Don't draw empty meshes.
-		if( _Object.GetVerticesCount() == 0 )
+		if( _Object.GetVerticesCount() == 0 || _Object.GetInstancesCount() == 0 )
 			return;
 
 		if( !CheckCountPrimitive( _Object.GetIndicesCount(), _Object.GetPrimitiveType() ) )
@@ -92,6 +99,20 @@ namespace ae
 			return;
 		}
 
+		Camera& CurrentCamera = _Camera != nullptr ? *_Camera : Aero.GetCamera();
+
+		// Skip the objects out of the camera frustum, the sphere test rejects most of them before the tighter box test.
+		if( m_IsFrustumCullingEnabled && _Object.IsCullingEnabled() && _Object.GetWorldBounds().IsValid() )
+		{
+			const Frustum& CameraFrustum = CurrentCamera.GetFrustum();
+
+			if( !CameraFrustum.Intersects( _Object.GetWorldBoundingSphere() ) || !CameraFrustum.Intersects( _Object.GetWorldBounds() ) )
+			{
+				m_CulledObjectsCount++;
+				return;
+			}
+		}
+
 
 		glViewport( Cast( GLint, 0 ), Cast( GLint, 0 ), Cast( GLint, GetWidth() ), Cast( GLint, GetHeight() ) );
 		AE_ErrorCheckOpenGLError();
@@ -99,10 +120,7 @@ namespace ae
 		// Call user event.
 		_Object.OnDrawBegin( *this );
 
-
-		Camera& CurrentCamera = _Camera != nullptr ? *_Camera : Aero.GetCamera();
-
-		const Shader& ObjectShader = *_Material.GetShader();
+		const Shader& ObjectShader = *MaterialShader;
 
 		// Attach the material shader to OpenGL and send its parameters.
 		ObjectShader.Bind();
@@ -122,7 +140,7 @@ namespace ae
 
 		// Send world lights to shader.
 		if( _Material.NeedLights() )
-			SendLightsToShader( ObjectShader );
+			SendLightsToShader( ObjectShader, CurrentCamera, TextureUnit );
 
 
 		// Draw the object with the bound shader.
@@ -134,6 +152,9 @@ namespace ae
 		ImageUnit = 0;
 		_Material.Clean( ObjectShader, TextureUnit, ImageUnit );
 
+		if( _Material.NeedLights() && LightClusters::IsUsedByShader( ObjectShader ) )
+			Aero.GetWorld().GetLightClusters().Clean( TextureUnit );
+
 		// Clear the shader from OpenGL.
 		ObjectShader.Unbind();
 
@@ -255,13 +276,40 @@ namespace ae
 		// Bind the drawable OpenGL buffers.
 		glBindVertexArray( _Object.GetVertexArrayObject() ); AE_ErrorCheckOpenGLError();
 
+		// Offset in bytes of the first index drawn in the element buffer.
+		const IndexType Type = _Object.GetIndexType();
+		const size_t IndexSize = Type == IndexType::UnsignedShort ? sizeof( Uint16 ) : sizeof( Uint32 );
+		const void* FirstIndex = reinterpret_cast<const void*>( Cast( size_t, _Object.GetFirstIndex() ) * IndexSize );
+
 		// Draw the vertex array's buffers.
-		glDrawElements( Cast( GLenum, _PrimitiveType ), _Object.GetIndicesCount(), GL_UNSIGNED_INT, 0 ); AE_ErrorCheckOpenGLError();
+		if( _Object.IsInstanced() )
+		{
+			glDrawElementsInstanced( Cast( GLenum, _PrimitiveType ), _Object.GetIndicesCount(), Cast( GLenum, Type ), FirstIndex, _Object.GetInstancesCount() ); AE_ErrorCheckOpenGLError();
+		}
+		else
+		{
+			glDrawElements( Cast( GLenum, _PrimitiveType ), _Object.GetIndicesCount(), Cast( GLenum, Type ), FirstIndex ); AE_ErrorCheckOpenGLError();
+		}
 
 		// Unbind vertex array buffer.
 		glBindVertexArray( 0 );
 	}
 
+	void Renderer::SetFrustumCullingEnabled( Bool _Enabled )
+	{
+		m_IsFrustumCullingEnabled = _Enabled;
+	}
+
+	Bool Renderer::IsFrustumCullingEnabled() const
+	{
+		return m_IsFrustumCullingEnabled;
+	}
+
+	Uint32 Renderer::GetCulledObjectsCount() const
+	{
+		return m_CulledObjectsCount;
+	}
+
 	void Renderer::SetBlendingMode( const BlendMode& _BlendMode )
 	{
 		glBlendFunc( Cast( GLenum, _BlendMode.SourceFactor ), Cast( GLenum, _BlendMode.DestinationFactor ) );
@@ -326,28 +374,40 @@ namespace ae
 	}
 
 
-	void Renderer::SendLightsToShader( const Shader& _Shader )
+	void Renderer::SendLightsToShader( const Shader& _Shader, Camera& _Camera, AE_InOut Uint32& _TextureUnit )
 	{
-		const std::array<std::string, 3> UniformNames =
+		World& WorldRef = Aero.GetWorld();
+
+		// Point and spot lights go through the clusters, only the directional lights stay in uniforms arrays.
+		const Bool UseClusters = LightClusters::IsUsedByShader( _Shader );
+		if( UseClusters )
+		{
+			LightClusters& Clusters = WorldRef.GetLightClusters();
+			Clusters.Update( WorldRef, _Camera );
+			Clusters.SendToShader( _Shader, _TextureUnit );
+		}
+
+		// References to the static names, not copies : nothing to allocate per draw.
+		const std::array<const std::string*, 3> UniformNames =
 		{
-			 Material::GetDefaultParameterName( Material::DefaultParameters::PointLights ),
-			 Material::GetDefaultParameterName( Material::DefaultParameters::SpotLights ),
-			 Material::GetDefaultParameterName( Material::DefaultParameters::DirectionalLights )
+			 &Material::GetDefaultParameterName( Material::DefaultParameters::PointLights ),
+			 &Material::GetDefaultParameterName( Material::DefaultParameters::SpotLights ),
+			 &Material::GetDefaultParameterName( Material::DefaultParameters::DirectionalLights )
 		};
 
 		std::array<Uint32, 3> LightsCount = { 0, 0, 0 };
 
-		const World& WorldRef = Aero.GetWorld();
-		const std::unordered_map<World::ObjectID, Light*>& Lights = WorldRef.GetLights();
-		for( const std::pair<World::ObjectID, Light*>& LightItem : Lights )
+		for( Light* Light : WorldRef.GetLights() )
 		{
-			Light* Light = LightItem.second;
 			if( !Light->IsEnabled() || Light->GetLightType() == Light::LightType::Unknown )
 				continue;
 
+			if( UseClusters && Light->GetLightType() != Light::LightType::Directional )
+				continue;
+
 			const size_t LightTypeID = static_cast<size_t>( Light->GetLightType() );
 
-			Light->SendToShader( UniformNames[LightTypeID], LightsCount[LightTypeID], _Shader );
+			Light->SendToShader( *UniformNames[LightTypeID], LightsCount[LightTypeID], _Shader );
 			LightsCount[LightTypeID]++;
 		}
 
@@ -115,6 +115,21 @@ namespace ae
 		/// <summary>Set the depth mode to the default mode (DepthMode::Less).</summary>
 		void ResetDepthMode();
 
+		/// <summary>
+		/// Skip the drawables whose bounds are out of the camera frustum.<para/>
+		/// Drawables with invalid bounds or with the culling disabled are always drawn.
+		/// </summary>
+		/// <param name="_Enabled">True to test the drawables against the frustum, False to draw everything.</param>
+		void SetFrustumCullingEnabled( Bool _Enabled );
+
+		/// <summary>Are the drawables out of the camera frustum skipped ?</summary>
+		/// <returns>True if the drawables are tested against the frustum, False otherwise.</returns>
+		Bool IsFrustumCullingEnabled() const;
+
+		/// <summary>Get the count of drawables skipped by the frustum culling since the last clear.</summary>
+		/// <returns>Count of drawables culled.</returns>
+		Uint32 GetCulledObjectsCount() const;
+
 		/// <summary>Get the width of the render target surface.</summary>
 		virtual Uint32 GetWidth() const AE_IsVirtualPure;
 
@@ -122,9 +137,14 @@ namespace ae
 		virtual Uint32 GetHeight() const AE_IsVirtualPure;
 
 	private:
-		/// <summary>Send the world lights to the shader.</summary>
+		/// <summary>
+		/// Send the world lights to the shader.<para/>
+		/// If the shader use the light clusters, the point and spot lights are sent through the clusters texture buffers.
+		/// </summary>
 		/// <param name="_Shader">The shader to send the lights to.</param>
-		void SendLightsToShader( const Shader& _Shader );
+		/// <param name="_Camera">The camera used for the rendering.</param>
+		/// <param name="_TextureUnit">Next free texture unit. Incremented for each texture bound.</param>
+		void SendLightsToShader( const Shader& _Shader, Camera& _Camera, AE_InOut Uint32& _TextureUnit );
 
 	protected:
 
@@ -174,6 +194,12 @@ namespace ae
 
 		/// <summary>Depth mode for the renderer (disabled, less, less equal ...).</summary>
 		DepthMode m_DepthMode;
+
+		/// <summary>Skip the drawables out of the camera frustum ?</summary>
+		Bool m_IsFrustumCullingEnabled;
+
+		/// <summary>Count of drawables skipped by the frustum culling since the last clear.</summary>
+		Uint32 m_CulledObjectsCount;
 	};
 
 } // ae
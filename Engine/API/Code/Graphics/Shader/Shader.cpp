@@ -12,6 +12,10 @@
 
 #include "../Dependencies/OpenGL.h"
 
+#include "ShaderCache/ShaderCache.h"
+#include "ShaderCache/ShaderSourceCache.h"
+#include "../../TimeManagement/Time/Time.h"
+
 #include "../../Aero/Aero.h"
 
 #include <fstream>
@@ -34,7 +38,11 @@ namespace ae
 		m_TesselationControlFile( _TesselationControlPath ),
 		m_TesselationEvaluationFile( _TesselationEvaluationPath ),
 		m_FragmentFile( _FragmentPath ),
-		m_ComputeFile( "" )
+		m_ComputeFile( "" ),
+
+		m_IsLinkPending( False ),
+		m_CacheKey( 0 ),
+		m_Revision( 0 )
 	{
 		if( !Aero.CheckContext() )
 			AE_LogError( "Invalid context. Cannot create shader." );
@@ -60,7 +68,11 @@ namespace ae
 		m_TesselationControlFile( "" ),
 		m_TesselationEvaluationFile( "" ),
 		m_FragmentFile( "" ),
-		m_ComputeFile( _ComputePath )
+		m_ComputeFile( _ComputePath ),
+
+		m_IsLinkPending( False ),
+		m_CacheKey( 0 ),
+		m_Revision( 0 )
 	{
 		if( !Aero.CheckContext() )
 			AE_LogError( "Invalid context. Cannot create shader." );
@@ -72,13 +84,45 @@ namespace ae
 		SetName( std::string( "ComputeShader_" ) + std::to_string( GetResourceID() ) );
 	}
 
+	Shader::Shader( const Shader& _Base, const DefinesMap& _Defines ) :
+		m_ProgramID( 0 ),
+		m_VertexID( 0 ),
+		m_GeometryID( 0 ),
+		m_TesselationControlID( 0 ),
+		m_TesselationEvaluationID( 0 ),
+		m_FragmentID( 0 ),
+		m_ComputeID( 0 ),
+
+		m_VertexFile( _Base.m_VertexFile ),
+		m_GeometryFile( _Base.m_GeometryFile ),
+		m_TesselationControlFile( _Base.m_TesselationControlFile ),
+		m_TesselationEvaluationFile( _Base.m_TesselationEvaluationFile ),
+		m_FragmentFile( _Base.m_FragmentFile ),
+		m_ComputeFile( _Base.m_ComputeFile ),
+
+		m_IsLinkPending( False ),
+		m_CacheKey( 0 ),
+		m_Revision( 0 ),
+		m_Defines( _Defines )
+	{
+		CreateShader();
+
+		Compile();
+
+		SetName( _Base.GetName() + " (" + BuildDefinesKey( _Defines ) + ")" );
+	}
+
 	Shader::~Shader()
 	{
+		Aero.GetResourcesManager().GetShaderSourceCache().RemoveShader( *this );
+
 		FreeResource();
 	}
 
 	void Shader::Bind() const
 	{
+		FinishLinking();
+
 		glUseProgram( m_ProgramID );
 		AE_ErrorCheckOpenGLError();
 	}
@@ -165,6 +209,8 @@ namespace ae
 		LocationsMap::const_iterator itExisting = m_CachedLocations.find( _Name );
 		if( itExisting == m_CachedLocations.cend() )
 		{
+			FinishLinking();
+
 			const Int32 Location = glGetUniformLocation( m_ProgramID, _Name.c_str() );
 			AE_ErrorCheckOpenGLError();
 
@@ -175,11 +221,43 @@ namespace ae
 		return itExisting->second;
 	}
 
+	Int32 Shader::GetUniformLocation( const char* _Name ) const
+	{
+		// The map needs a std::string to search (no heterogeneous lookup before C++20) :
+		// reuse one per thread, it only allocates when a name longer than all the previous ones comes.
+		thread_local std::string LookupName;
+		LookupName.assign( _Name );
+
+		return GetUniformLocation( LookupName );
+	}
+
 	Uint32 Shader::GetProgramID() const
 	{
+		FinishLinking();
+
 		return m_ProgramID;
 	}
 
+	Uint32 Shader::GetRevision() const
+	{
+		return m_Revision;
+	}
+
+	Bool Shader::IsCompilationFinished() const
+	{
+		if( !m_IsLinkPending )
+			return True;
+
+		if( !Aero.GetResourcesManager().GetShaderCache().IsParallelCompileAvailable() )
+			return True;
+
+		GLint IsFinished = GL_FALSE;
+		glGetProgramiv( m_ProgramID, GL_COMPLETION_STATUS_ARB, &IsFinished );
+		AE_ErrorCheckOpenGLError();
+
+		return IsFinished ? True : False;
+	}
+
 	void Shader::SetName( const std::string& _NewName )
 	{
 		Resource::SetName( _NewName );
@@ -191,25 +269,98 @@ namespace ae
 
 	void Shader::Compile() const
 	{
+		const Time StartTime = Time::GetTick();
+
 		DetachShaders();
+		DeleteShaders();
 		ClearLocationsCached();
 
-		if( !m_ComputeFile.empty() )
+		m_IsLinkPending = False;
+		m_CacheKey = 0;
+		m_Revision++;
+
+		// Stages in the order they are hashed for the cache.
+		const std::string* StageFiles[] = { &m_ComputeFile, &m_VertexFile, &m_FragmentFile, &m_GeometryFile, &m_TesselationControlFile, &m_TesselationEvaluationFile };
+		const Uint32 StageTypes[] = { GL_COMPUTE_SHADER, GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER };
+		Uint32* StageIDs[] = { &m_ComputeID, &m_VertexID, &m_FragmentID, &m_GeometryID, &m_TesselationControlID, &m_TesselationEvaluationID };
+		constexpr Uint32 StagesCount = 6;
+
+		// A compute shader is alone in its program.
+		const Uint32 UsedStagesCount = m_ComputeFile.empty() ? StagesCount : 1;
+
+		std::vector<priv::ShaderStageSource> Stages( StagesCount );
+		std::unordered_set<std::string> Dependencies;
+		Bool AreSourcesValid = True;
+
+		for( Uint32 s = 0; s < UsedStagesCount; s++ )
 		{
-			m_ComputeID = CompileShader( m_ComputeFile, GL_COMPUTE_SHADER );
+			Stages[s].Type = StageTypes[s];
+
+			if( StageFiles[s]->empty() )
+				continue;
+
+			AreSourcesValid &= PreprocessShader( Stages[s].Code, *StageFiles[s], Dependencies );
+
+			// Injected before hashing, each variant has its own binary in the cache.
+			InjectDefines( Stages[s].Code );
 		}
-		else
+
+		// Editing one of these files compiles the shader again.
+		Aero.GetResourcesManager().GetShaderSourceCache().SetDependencies( *this, Dependencies );
+
+		priv::ShaderCache& Cache = Aero.GetResourcesManager().GetShaderCache();
+
+		// A shader with a missing file is linked anyway to report the error, it is never cached.
+		if( AreSourcesValid )
 		{
-			m_VertexID = m_VertexFile.empty() ? 0 : CompileShader( m_VertexFile, GL_VERTEX_SHADER );
-			m_FragmentID = m_FragmentFile.empty() ? 0 : CompileShader( m_FragmentFile, GL_FRAGMENT_SHADER );
-			m_GeometryID = m_GeometryFile.empty() ? 0 : CompileShader( m_GeometryFile, GL_GEOMETRY_SHADER );
-			m_TesselationControlID = m_TesselationControlFile.empty() ? 0 : CompileShader( m_TesselationControlFile, GL_TESS_CONTROL_SHADER );
-			m_TesselationEvaluationID = m_TesselationEvaluationFile.empty() ? 0 : CompileShader( m_TesselationEvaluationFile, GL_TESS_EVALUATION_SHADER );
+			const Uint64 Key = Cache.ComputeKey( Stages );
+
+			if( Cache.LoadProgram( m_ProgramID, Key ) )
+			{
+				Cache.AddCreationTime( Cast( float, Time::GetTick().AsMicroSeconds() - StartTime.AsMicroSeconds() ) * 0.000001f );
+				return;
+			}
+
+			m_CacheKey = Key;
 		}
 
+		// The status of the compilation and of the link are checked at the first use,
+		// so the driver can compile the following shaders meanwhile.
+		for( Uint32 s = 0; s < UsedStagesCount; s++ )
+			*StageIDs[s] = Stages[s].Code.empty() ? 0 : CompileShader( Stages[s].Code, StageTypes[s] );
+
+		Cache.PrepareProgram( m_ProgramID );
+
 		LinkShaders();
 
-		DeleteShaders();
+		m_IsLinkPending = True;
+
+		Cache.AddCreationTime( Cast( float, Time::GetTick().AsMicroSeconds() - StartTime.AsMicroSeconds() ) * 0.000001f );
+	}
+
+	const Shader& Shader::GetVariant( const DefinesMap& _Defines ) const
+	{
+		if( _Defines.empty() )
+			return *this;
+
+		const std::string Key = BuildDefinesKey( _Defines );
+
+		std::unique_ptr<Shader>& Variant = m_Variants[Key];
+		if( Variant == nullptr )
+		{
+			// The defines of this shader are kept, the requested ones override them.
+			DefinesMap VariantDefines = _Defines;
+			VariantDefines.insert( m_Defines.cbegin(), m_Defines.cend() );
+
+			Variant.reset( new Shader( *this, VariantDefines ) );
+		}
+
+		return *Variant;
+	}
+
+	const Shader::DefinesMap& Shader::GetDefines() const
+	{
+		return m_Defines;
 	}
 
 	const std::string& Shader::GetVertexFile() const
@@ -254,11 +405,14 @@ namespace ae
 
 	void Shader::Dispatch( Uint32 _CountGroupsX, Uint32 _CountGroupsY, Uint32 _CountGroupsZ ) const
 	{
-		if( m_ComputeID == 0 )
+		if( m_ComputeFile.empty() )
 			return;
 
 		glDispatchCompute( Math::Max( _CountGroupsX, 1u ), Math::Max( _CountGroupsY, 1u ), Math::Max(  _CountGroupsZ, 1u ) );
 		AE_ErrorCheckOpenGLError();
+
+		// A dispatch is a pass of its own : its errors are named after the shader.
+		AE_ErrorCheckOpenGLCheckpoint( GetName().c_str() );
 	}
 
 	void Shader::ToEditor()
@@ -267,23 +421,68 @@ namespace ae
 		priv::ui::ShaderToEditor( *this );
 	}
 
-	Uint32 Shader::CompileShader( const std::string& _ShaderPath, Uint32 _ShaderType ) const
-	{   
-		// Retrieve shader file content.
-		std::string ShaderContent;
+	Bool Shader::PreprocessShader( AE_Out std::string& _ShaderContent, const std::string& _ShaderPath, AE_InOut std::unordered_set<std::string>& _Dependencies ) const
+	{
+		_Dependencies.insert( _ShaderPath );
+
+		const std::string* FileContent = ReadSourceFile( _ShaderPath );
+		if( FileContent == nullptr )
+			return False;
+
+		_ShaderContent.clear();
+		_ShaderContent.reserve( FileContent->size() );
+
+		std::unordered_set<std::string> IncludeHistory;
+		const Bool Success = ProcessIncludes( _ShaderContent, *FileContent, _ShaderPath, IncludeHistory );
+
+		// Even on failure, the shader must be compiled again when the faulty include is fixed.
+		_Dependencies.insert( IncludeHistory.cbegin(), IncludeHistory.cend() );
+
+		return Success;
+	}
+
+	std::string Shader::BuildDefinesKey( const DefinesMap& _Defines )
+	{
+		std::string Key;
+
+		for( const std::pair<const std::string, std::string>& Define : _Defines )
+			Key += Define.first + "=" + Define.second + ";";
+
+		return Key;
+	}
+
+	void Shader::InjectDefines( AE_InOut std::string& _ShaderContent ) const
+	{
+		if( m_Defines.empty() || _ShaderContent.empty() )
+			return;
+
+		std::string Defines;
+		for( const std::pair<const std::string, std::string>& Define : m_Defines )
+			Defines += "#define " + Define.first + " " + Define.second + "\n";
 
-		if( !ReadEntireFile( ShaderContent, _ShaderPath ) )
-			return 0;
+		// The #version directive must stay the first one of the stage.
+		size_t InsertPosition = 0;
 
-		std::vector<std::string> IncludeHistory;
-		if( !ProcessIncludes( ShaderContent, _ShaderPath, IncludeHistory ) )
-			return 0;
+		const size_t VersionPosition = _ShaderContent.find( "#version" );
+		if( VersionPosition != std::string::npos )
+		{
+			const size_t EndOfLine = _ShaderContent.find( '\n', VersionPosition );
+			InsertPosition = EndOfLine != std::string::npos ? EndOfLine + 1 : _ShaderContent.size();
+
+			if( EndOfLine == std::string::npos )
+				Defines.insert( 0, "\n" );
+		}
+
+		_ShaderContent.insert( InsertPosition, Defines );
+	}
 
+	Uint32 Shader::CompileShader( const std::string& _ShaderContent, Uint32 _ShaderType ) const
+	{   
 		Uint32 ShaderID = glCreateShader( _ShaderType );
 		AE_ErrorCheckOpenGLError();
 
 		// Link source.
-		const char* ShaderSourceCode = ShaderContent.data();
+		const char* ShaderSourceCode = _ShaderContent.data();
 		glShaderSource( ShaderID, 1, &ShaderSourceCode, NULL );
 		AE_ErrorCheckOpenGLError();
 
@@ -291,19 +490,25 @@ namespace ae
 		glCompileShader( ShaderID );
 		AE_ErrorCheckOpenGLError();
 
+		return ShaderID;
+	}
+
+	void Shader::CheckCompileStatus( Uint32 _ShaderID, const std::string& _ShaderPath ) const
+	{
+		if( _ShaderID == 0 )
+			return;
+
 		// Check for compilation error.
 		Int32 Success;
-		glGetShaderiv( ShaderID, GL_COMPILE_STATUS, &Success );
+		glGetShaderiv( _ShaderID, GL_COMPILE_STATUS, &Success );
 		AE_ErrorCheckOpenGLError();
 
 		if( !Success )
 		{
 			std::string InfoLog( 1024, ' ' );
-			glGetShaderInfoLog( ShaderID, 1024, NULL, &InfoLog[0] );
+			glGetShaderInfoLog( _ShaderID, 1024, NULL, &InfoLog[0] );
 			AE_LogError( std::string( "Failed to compile shader : \n" ) + _ShaderPath + "\n" + InfoLog + "\n" );
 		}		
-
-		return ShaderID;
 	}
 
 	void Shader::LinkShaders() const
@@ -345,11 +550,30 @@ namespace ae
 		}
 
 		glLinkProgram( m_ProgramID ); AE_ErrorCheckOpenGLError();
+	}
+
+	void Shader::FinishLinking() const
+	{
+		if( !m_IsLinkPending )
+			return;
 
-		// Check for link errors.
+		m_IsLinkPending = False;
+
+		const Time StartTime = Time::GetTick();
+
+		CheckCompileStatus( m_ComputeID, m_ComputeFile );
+		CheckCompileStatus( m_VertexID, m_VertexFile );
+		CheckCompileStatus( m_FragmentID, m_FragmentFile );
+		CheckCompileStatus( m_GeometryID, m_GeometryFile );
+		CheckCompileStatus( m_TesselationControlID, m_TesselationControlFile );
+		CheckCompileStatus( m_TesselationEvaluationID, m_TesselationEvaluationFile );
+
+		// Check for link errors, waits for the driver to finish.
 		Int32 Success;
 		glGetProgramiv( m_ProgramID, GL_LINK_STATUS, &Success ); AE_ErrorCheckOpenGLError();
 
+		priv::ShaderCache& Cache = Aero.GetResourcesManager().GetShaderCache();
+
 		if( !Success )
 		{
 			Int32 LogLength = 1024;
@@ -360,6 +584,13 @@ namespace ae
 			glGetProgramInfoLog( m_ProgramID, LogLength, NULL, &InfoLog[0] );
 			AE_LogError( std::string( "Failed to link shader : \n" ) + InfoLog + "\n" );
 		}
+		else if( m_CacheKey != 0 )
+			Cache.SaveProgram( m_ProgramID, m_CacheKey );
+
+		DetachShaders();
+		DeleteShaders();
+
+		Cache.AddCreationTime( Cast( float, Time::GetTick().AsMicroSeconds() - StartTime.AsMicroSeconds() ) * 0.000001f );
 	}
 
 	void Shader::DeleteShaders() const
@@ -368,36 +599,42 @@ namespace ae
 		{
 			glDeleteShader( m_ComputeID );
 			AE_ErrorCheckOpenGLError();
+			m_ComputeID = 0;
 		}
 
 		if( m_VertexID != 0 )
 		{
 			glDeleteShader( m_VertexID );
 			AE_ErrorCheckOpenGLError();
+			m_VertexID = 0;
 		}
 
 		if( m_FragmentID != 0 )
 		{
 			glDeleteShader( m_FragmentID );
 			AE_ErrorCheckOpenGLError();
+			m_FragmentID = 0;
 		}
 
 		if( m_GeometryID != 0 )
 		{
 			glDeleteShader( m_GeometryID );
 			AE_ErrorCheckOpenGLError();
+			m_GeometryID = 0;
 		}
 
 		if( m_TesselationControlID != 0 )
 		{
 			glDeleteShader( m_TesselationControlID );
 			AE_ErrorCheckOpenGLError();
+			m_TesselationControlID = 0;
 		}
 
 		if( m_TesselationEvaluationID != 0 )
 		{
 			glDeleteShader( m_TesselationEvaluationID );
 			AE_ErrorCheckOpenGLError();
+			m_TesselationEvaluationID = 0;
 		}
 	}
 
@@ -460,36 +697,22 @@ namespace ae
 
 	
 
-	Bool Shader::ProcessIncludes( AE_InOut std::string& _ShaderContent, const std::string& _ShaderPath, std::vector<std::string>& _IncludeHistory ) const
+	Bool Shader::ProcessIncludes( AE_InOut std::string& _Output, const std::string& _ShaderContent, const std::string& _ShaderPath, AE_InOut std::unordered_set<std::string>& _IncludeHistory ) const
 	{
 		constexpr const char* IncludeToken = "#include";
 
-		// Continue only if there is at least one include.
-		if( _ShaderContent.find( IncludeToken, 0 ) == std::string::npos )
-			return True;
-
 		std::string Path = _ShaderPath;
 		RemoveFileFromPath( Path );
 
-		size_t FinalContentSize = 0;
-		std::vector<std::string> ShaderParts;
-
 		size_t OriginPosition = 0;
 		size_t Position = 0;		
 
-		std::string PathToInclude;
-		std::string IncludedContent;
-
 		constexpr size_t QuoteSize = 1;
 
 		while( ( Position = _ShaderContent.find( IncludeToken, OriginPosition ) ) != std::string::npos )
 		{
 			// Save what was before the include directive (that wasn't an include).
-			if( Position - OriginPosition > 0 )
-			{
-				ShaderParts.push_back( _ShaderContent.substr( OriginPosition, Position - OriginPosition ) );
-				FinalContentSize += ShaderParts.back().size();
-			}
+			_Output.append( _ShaderContent, OriginPosition, Position - OriginPosition );
 						
 			const size_t FirstQuotePosition = _ShaderContent.find( '\"', Position );
 			const size_t SecondQuotePosition = _ShaderContent.find( '\"', FirstQuotePosition + QuoteSize );
@@ -505,76 +728,52 @@ namespace ae
 			OriginPosition = SecondQuotePosition + QuoteSize;
 
 			// Check if the include is commented.
-			if( Position >= 2 )
-			{
-				if( _ShaderContent.substr( Position - 2, 2 ) == "//" )
-					continue;
-			}
+			if( Position >= 2 && _ShaderContent.compare( Position - 2, 2, "//" ) == 0 )
+				continue;
 
-			PathToInclude = Path + "/" + _ShaderContent.substr( FirstQuotePosition + QuoteSize, LengthInclude );
+			// Built in place : one allocation instead of a temporary per concatenation.
+			std::string PathToInclude;
+			PathToInclude.reserve( Path.size() + 1 + LengthInclude );
+			PathToInclude.append( Path ).append( 1, '/' ).append( _ShaderContent, FirstQuotePosition + QuoteSize, LengthInclude );
 
 			// Skip if it already has been included.
-			if( CheckIncludeHistory( PathToInclude, _IncludeHistory ) )
+			if( !_IncludeHistory.insert( PathToInclude ).second )
 				continue;
 			
-			// Load the include file.
-			if( !ReadEntireFile( IncludedContent, PathToInclude ) )
+			// Load the include file, shared by all the shaders including it.
+			const std::string* IncludedContent = ReadSourceFile( PathToInclude );
+			if( IncludedContent == nullptr )
 				return False;
 
-			// Check if the incuded file has include directive.
-			if( !ProcessIncludes( IncludedContent, PathToInclude, _IncludeHistory ) )
+			// The included file can have include directives too, its content is appended directly.
+			if( !ProcessIncludes( _Output, *IncludedContent, PathToInclude, _IncludeHistory ) )
 				return False;
-
-			ShaderParts.push_back( IncludedContent );
-			FinalContentSize += ShaderParts.back().size();
-
-			_IncludeHistory.push_back( PathToInclude );
 		}
 
-		// Concatenate all the part and the last part.
-		if( !ShaderParts.empty() )
-		{
-			std::string LastPart = _ShaderContent.substr( OriginPosition, _ShaderContent.size() - OriginPosition );
-
-			_ShaderContent.clear();
-			_ShaderContent.reserve( FinalContentSize );
-
-			for( const std::string& Part : ShaderParts )
-				_ShaderContent += Part;
-			
-			// Must include the rest of the file since we save only what is before the includes directives, not what is after the last one.
-			_ShaderContent += LastPart;
-		}
+		// Must include the rest of the file since we save only what is before the includes directives, not what is after the last one.
+		_Output.append( _ShaderContent, OriginPosition, std::string::npos );
 
 		return True;
 	}
 
 
-	Bool Shader::ReadEntireFile( AE_Out std::string& _Content, const std::string& _Path ) const
+	const std::string* Shader::ReadSourceFile( const std::string& _Path ) const
 	{
-		std::ifstream File( _Path, std::ios::binary );
-		if( !File.is_open() )
+		const std::string* Content = Aero.GetResourcesManager().GetShaderSourceCache().GetFile( _Path );
+
+		if( Content == nullptr )
 		{
 			AE_LogError( std::string( "Can not open file : " ) + _Path );
-			return False;
+			return nullptr;
 		}
 
-		// Retrieve length of the content.
-		File.seekg( 0, std::ios::end );
-		std::streampos FileLength = File.tellg();
-		File.seekg( 0 );
-
-		if( FileLength == 0 )
+		if( Content->empty() )
 		{
 			AE_LogError( std::string( "File is empty : " ) + _Path );
-			return False;
+			return nullptr;
 		}
 
-		// Retrieve shader file content.
-		_Content.resize( Cast( Uint32, FileLength ), ' ' );
-		File.read( &_Content[0], FileLength );
-
-		return True;
+		return Content;
 	}
 
 	void Shader::RemoveFileFromPath( AE_InOut std::string& _Path ) const
@@ -584,15 +783,4 @@ namespace ae
 			_Path.erase( _Path.begin() + Position, _Path.end() );
 	}
 
-	Bool Shader::CheckIncludeHistory( const std::string& _Path, const std::vector<std::string>& _IncludeHistory ) const
-	{
-		for( const std::string& PreviousInclude : _IncludeHistory )
-		{
-			if( _Path == PreviousInclude )
-				return True;
-		}
-
-		return False;
-	}
-
 } // ae
\ No newline at end of file
@@ -6,7 +6,10 @@
 #include "../../Resources/Resource/Resource.h"
 
 #include <string>
+#include <map>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace ae
 {
@@ -30,8 +33,15 @@ namespace ae
 		/// <summary>Alias for map string/int of uniform locations (name/location).</summary>
 		using LocationsMap = std::unordered_map<std::string, Int32>;
 
+		/// <summary>Alias for map string/string of preprocessor defines (name/value), sorted to build stable keys.</summary>
+		using DefinesMap = std::map<std::string, std::string>;
+
 	public:
-		/// <summary>Create an OpenGL shader from shader files. </summary>
+		/// <summary>
+		/// Create an OpenGL shader from shader files.<para/>
+		/// The program is loaded from the shader cache when its sources did not change,
+		/// otherwise it is compiled in the background when the driver allows it and its link status is checked at the first use.
+		/// </summary>
 		/// <param name="_VertexPath">The vertex file path.</param>
 		/// <param name="_FragmentPath">The fragment file path.</param>
 		/// <param name="_GeometryPath">The geometry file shader (optional).</param>
@@ -116,20 +126,55 @@ namespace ae
 		/// <returns>The location of the variable in the shader.</returns>
 		Int32 GetUniformLocation( const std::string& _Name ) const;
 
-		/// <summary>Get the OpenGL program ID of the shader.</summary>
+		/// <summary>Retrieve the location of a uniform variable from its name, without allocation once the location is cached.</summary>
+		/// <param name="_Name">The name of the uniform variable, null terminated.</param>
+		/// <returns>The location of the variable in the shader.</returns>
+		Int32 GetUniformLocation( const char* _Name ) const;
+
+		/// <summary>Get the OpenGL program ID of the shader. Waits for the link if it is not finished.</summary>
 		/// <returns>Program ID of the shader.</returns>
 		Uint32 GetProgramID() const;
 
+		/// <summary>
+		/// Get the count of compilations of the shader.<para/>
+		/// It changes each time the shader is compiled again (hot reload, editor), the uniform locations saved before are invalid then.
+		/// </summary>
+		/// <returns>Revision of the program.</returns>
+		Uint32 GetRevision() const;
+
+		/// <summary>
+		/// Has the driver finished to compile and link the shader ?<para/>
+		/// Doesn't wait, the first use of a shader not finished waits for it.
+		/// Without GL_ARB_parallel_shader_compile the driver compiles synchronously and the shader is always finished.
+		/// </summary>
+		/// <returns>True if the shader can be used without waiting, False otherwise.</returns>
+		Bool IsCompilationFinished() const;
+
 		/// <summary>Set the name of the object.</summary>
 		/// <param name="_NewName">The new name to apply to the object.</param>
 		void SetName( const std::string& _NewName ) final;
 
 		/// <summary>
 		/// Recompile shaders file provided in constructor.<para/>
-		/// Allow to update modified shader at runtime.
+		/// Allow to update modified shader at runtime.<para/>
+		/// Loads the program from the shader cache if the preprocessed sources are unchanged.
 		/// </summary>
 		void Compile() const;
 
+		/// <summary>
+		/// Retrieve a variant of the shader compiled with some preprocessor defines.<para/>
+		/// The defines are injected after the #version line of each stage, so the shader code can
+		/// test them with #ifdef and the driver can fold the branches and unroll the loops depending on them.<para/>
+		/// A variant is compiled the first time it is requested, then it is cached with the shader.
+		/// </summary>
+		/// <param name="_Defines">Defines of the variant.</param>
+		/// <returns>The variant, the shader itself if there is no define.</returns>
+		const Shader& GetVariant( const DefinesMap& _Defines ) const;
+
+		/// <summary>Retrieve the defines the shader is compiled with.</summary>
+		/// <returns>Defines of the shader, empty if it is not a variant.</returns>
+		const DefinesMap& GetDefines() const;
+
 		/// <summary>Retrieve the path to the vertex file shader.</summary>
 		/// <returns>Path to the vertex file shader.</returns>
 		const std::string& GetVertexFile() const;
@@ -180,15 +225,50 @@ namespace ae
 		void ToEditor() override;
 
 	private:
-		/// <summary>A shader from a file and retrieve an OpenGL ID for the shader. </summary>
+		/// <summary>Create a variant of a shader, with the same files and some defines.</summary>
+		/// <param name="_Base">Shader to create a variant of.</param>
+		/// <param name="_Defines">Defines of the variant.</param>
+		Shader( const Shader& _Base, const DefinesMap& _Defines );
+
+		/// <summary>Build the key of a set of defines, used to find the variants.</summary>
+		/// <param name="_Defines">Defines to build the key of.</param>
+		/// <returns>The defines as "NAME=VALUE;" sequence.</returns>
+		static std::string BuildDefinesKey( const DefinesMap& _Defines );
+
+		/// <summary>Insert the defines of the shader after the #version directive of a preprocessed stage.</summary>
+		/// <param name="_ShaderContent">The preprocessed shader code.</param>
+		void InjectDefines( AE_InOut std::string& _ShaderContent ) const;
+
+		/// <summary>Read a shader file and replace its includes by their content.</summary>
+		/// <param name="_ShaderContent">The preprocessed shader code.</param>
 		/// <param name="_ShaderPath">The shader file path.</param>
+		/// <param name="_Dependencies">Filled with the shader file and the included files.</param>
+		/// <returns>True if the file and its includes could be read, False otherwise.</returns>
+		Bool PreprocessShader( AE_Out std::string& _ShaderContent, const std::string& _ShaderPath, AE_InOut std::unordered_set<std::string>& _Dependencies ) const;
+
+		/// <summary>
+		/// Start the compilation of a shader and retrieve an OpenGL ID for the shader.<para/>
+		/// The compilation status is checked by FinishLinking.
+		/// </summary>
+		/// <param name="_ShaderContent">The preprocessed shader code.</param>
 		/// <param name="_ShaderType">Type of the shader.</param>
-		/// <returns>OpenGL ID of the compiled shader.</returns>
-		Uint32 CompileShader( const std::string& _ShaderPath, Uint32 _ShaderType ) const;
+		/// <returns>OpenGL ID of the shader.</returns>
+		Uint32 CompileShader( const std::string& _ShaderContent, Uint32 _ShaderType ) const;
 
-		/// <summary>Attach and link the compiled shaders with the currently bound program.</summary>
+		/// <summary>Log the compilation errors of a shader.</summary>
+		/// <param name="_ShaderID">OpenGL ID of the shader.</param>
+		/// <param name="_ShaderPath">The shader file path, for the log.</param>
+		void CheckCompileStatus( Uint32 _ShaderID, const std::string& _ShaderPath ) const;
+
+		/// <summary>Attach the compiled shaders to the program and start the link.</summary>
 		void LinkShaders() const;
 
+		/// <summary>
+		/// Wait for the link started by Compile, log the errors and save the program in the shader cache.<para/>
+		/// Does nothing if the link is already finished.
+		/// </summary>
+		void FinishLinking() const;
+
 		/// <summary>Destroy compiled shaders.</summary>
 		void DeleteShaders() const;
 
@@ -208,29 +288,22 @@ namespace ae
 		/// Can fail if the files don't exists or if the #include directive is not well written.<para/>
 		/// Origin path for includes is the original file path.
 		/// </summary>
+		/// <param name="_Output">The preprocessed code is appended to it.</param>
 		/// <param name="_ShaderContent">The shader to parse.</param>
 		/// <param name="_ShaderPath">The path to the shader to parse.</param>
-		/// <param name="_RemoveFileFromPath">Must remove last part of the path ? (Everything after the last '/').</param>
 		/// <param name="_IncludeHistory">Keep track of the included file to avoid duplications.</param>
 		/// <returns>True if the parsing was sucessfull, False otherwise.</returns>
-		Bool ProcessIncludes( AE_InOut std::string& _ShaderContent, const std::string& _ShaderPath, std::vector<std::string>& _IncludeHistory ) const;
+		Bool ProcessIncludes( AE_InOut std::string& _Output, const std::string& _ShaderContent, const std::string& _ShaderPath, AE_InOut std::unordered_set<std::string>& _IncludeHistory ) const;
 
-		/// <summary>Retrieve the entire content of a file.</summary>
-		/// <param name="_Content">The content of the file.</param>
+		/// <summary>Retrieve the entire content of a file from the shader source cache.</summary>
 		/// <param name="_Path">Path to the file to read.</param>
-		/// <returns>True if the reading was sucessfull, False otherwise.</returns>
-		Bool ReadEntireFile( AE_Out std::string& _Content, const std::string& _Path ) const;
+		/// <returns>The content of the file, null if it cannot be read or is empty.</returns>
+		const std::string* ReadSourceFile( const std::string& _Path ) const;
 
 		/// <summary>Remove the part after the last '/'.</summary>
 		/// <param name="_Path">The path to process.</param>
 		void RemoveFileFromPath( AE_InOut std::string& _Path ) const;
 
-		/// <summary>Check if the file is not already included.</summary>
-		/// <param name="_Path">The path to check?</param>
-		/// <param name="_IncludeHistory">The history of the includes.</param>
-		/// <returns>True if the path has already been included, False otherwise.</returns>
-		Bool CheckIncludeHistory( const std::string& _Path, const std::vector<std::string>& _IncludeHistory ) const;
-
 	private:
 		/// <summary>OpenGL shader program ID.</summary>
 		Uint32 m_ProgramID;
@@ -272,6 +345,21 @@ namespace ae
 		/// <summary>Path to compute shader file.</summary>
 		std::string m_ComputeFile;
 
+		/// <summary>Has the link been started without checking its status yet ?</summary>
+		mutable Bool m_IsLinkPending;
+
+		/// <summary>Key of the program in the shader cache, 0 if it must not be cached.</summary>
+		mutable Uint64 m_CacheKey;
+
+		/// <summary>Count of compilations of the shader.</summary>
+		mutable Uint32 m_Revision;
+
+		/// <summary>Preprocessor defines injected in each stage.</summary>
+		DefinesMap m_Defines;
+
+		/// <summary>Variants of the shader already compiled, by key of their defines.</summary>
+		mutable std::unordered_map<std::string, std::unique_ptr<Shader>> m_Variants;
+
 		/// <summary>
 		/// Locations saved when user call GetUniformLocation the first time for a parameter. <para/>
 		/// The purpose is to use this map instead of fetching the location with OpenGL each time GetUniformLocation is called.
@@ -0,0 +1,284 @@
+#include "ShaderCache.h"
+
+#include "../../../Debugging/Debugging.h"
+#include "../../Dependencies/OpenGL.h"
+
+#ifdef WINDOWS
+#include <direct.h>
+#elif defined( LINUX )
+#include <sys/stat.h>
+#endif
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+namespace ae
+{
+	namespace priv
+	{
+		namespace
+		{
+			/// <summary>"AEPG" read as a little endian integer.</summary>
+			constexpr Uint32 ProgramBinaryMagic = 0x47504541;
+
+			/// <summary>Layout of the beginning of a cached binary.</summary>
+			struct ProgramBinaryHeader
+			{
+				Uint32 Magic;
+				Uint32 Version;
+				Uint64 Key;
+				Uint32 BinaryFormat;
+				Uint32 BinarySize;
+			};
+
+			/// <summary>Continue a FNV-1a 64 bits hash with some data.</summary>
+			/// <param name="_Hash">Hash to continue.</param>
+			/// <param name="_Data">Data to hash.</param>
+			/// <param name="_Size">Size in bytes of the data.</param>
+			void HashData( AE_InOut Uint64& _Hash, const void* _Data, size_t _Size )
+			{
+				const Uint8* Bytes = Cast( const Uint8*, _Data );
+
+				for( size_t b = 0; b < _Size; b++ )
+				{
+					_Hash ^= Bytes[b];
+					_Hash *= 1099511628211ull;
+				}
+			}
+
+			/// <summary>Retrieve an OpenGL string, empty if not available.</summary>
+			/// <param name="_Name">Name of the string.</param>
+			/// <returns>The string.</returns>
+			std::string GetOpenGLString( GLenum _Name )
+			{
+				const GLubyte* String = glGetString( _Name );
+				AE_ErrorCheckOpenGLError();
+
+				return String != nullptr ? std::string( reinterpret_cast<const char*>( String ) ) : std::string();
+			}
+		}
+
+		ShaderCache::ShaderCache() :
+			m_Directory( "ShaderCache" ),
+			m_IsEnabled( True ),
+			m_IsInitialized( False ),
+			m_IsBinarySupported( False ),
+			m_IsParallelCompileAvailable( False ),
+			m_IsDirectoryCreated( False ),
+			m_DriverHash( 0 )
+		{
+		}
+
+		void ShaderCache::SetDirectory( const std::string& _Directory )
+		{
+			m_Directory = _Directory;
+			m_IsDirectoryCreated = False;
+		}
+
+		const std::string& ShaderCache::GetDirectory() const
+		{
+			return m_Directory;
+		}
+
+		void ShaderCache::SetEnabled( Bool _Enabled )
+		{
+			m_IsEnabled = _Enabled;
+		}
+
+		Bool ShaderCache::IsEnabled() const
+		{
+			return m_IsEnabled;
+		}
+
+		Uint64 ShaderCache::ComputeKey( const std::vector<ShaderStageSource>& _Stages )
+		{
+			InitializeDriverInfos();
+
+			Uint64 Key = m_DriverHash;
+
+			for( const ShaderStageSource& Stage : _Stages )
+			{
+				HashData( Key, &Stage.Type, sizeof( Uint32 ) );
+				HashData( Key, Stage.Code.data(), Stage.Code.size() );
+			}
+
+			return Key;
+		}
+
+		Bool ShaderCache::LoadProgram( Uint32 _ProgramID, Uint64 _Key )
+		{
+			InitializeDriverInfos();
+
+			if( !m_IsEnabled || !m_IsBinarySupported )
+			{
+				m_Stats.Misses++;
+				return False;
+			}
+
+			std::ifstream File( GetProgramPath( _Key ), std::ios::binary );
+
+			ProgramBinaryHeader Header;
+			if( !File.is_open() || !File.read( reinterpret_cast<char*>( &Header ), sizeof( ProgramBinaryHeader ) ) ||
+				Header.Magic != ProgramBinaryMagic || Header.Version != FormatVersion || Header.Key != _Key || Header.BinarySize == 0 )
+			{
+				m_Stats.Misses++;
+				return False;
+			}
+
+			std::vector<char> Binary( Header.BinarySize );
+			if( !File.read( Binary.data(), Header.BinarySize ) )
+			{
+				m_Stats.Misses++;
+				return False;
+			}
+
+			glProgramBinary( _ProgramID, Header.BinaryFormat, Binary.data(), Cast( GLsizei, Header.BinarySize ) );
+			AE_ErrorCheckOpenGLError();
+
+			// The driver can refuse a binary it has not produced itself, the sources must be compiled then.
+			GLint Success = GL_FALSE;
+			glGetProgramiv( _ProgramID, GL_LINK_STATUS, &Success );
+			AE_ErrorCheckOpenGLError();
+
+			if( !Success )
+			{
+				m_Stats.Rejected++;
+				m_Stats.Misses++;
+				return False;
+			}
+
+			m_Stats.Hits++;
+			return True;
+		}
+
+		void ShaderCache::SaveProgram( Uint32 _ProgramID, Uint64 _Key )
+		{
+			InitializeDriverInfos();
+
+			if( !m_IsEnabled || !m_IsBinarySupported )
+				return;
+
+			GLint BinarySize = 0;
+			glGetProgramiv( _ProgramID, GL_PROGRAM_BINARY_LENGTH, &BinarySize );
+			AE_ErrorCheckOpenGLError();
+
+			if( BinarySize <= 0 )
+				return;
+
+			std::vector<char> Binary( Cast( size_t, BinarySize ) );
+			GLenum BinaryFormat = 0;
+
+			glGetProgramBinary( _ProgramID, BinarySize, nullptr, &BinaryFormat, Binary.data() );
+			AE_ErrorCheckOpenGLError();
+
+			if( !m_IsDirectoryCreated )
+			{
+				// Fails when the directory already exists, the opening of the file tells if it is usable.
+#ifdef WINDOWS
+				_mkdir( m_Directory.c_str() );
+#elif defined( LINUX )
+				mkdir( m_Directory.c_str(), 0755 );
+#endif
+				m_IsDirectoryCreated = True;
+			}
+
+			ProgramBinaryHeader Header;
+			std::memset( &Header, 0, sizeof( ProgramBinaryHeader ) );
+
+			Header.Magic = ProgramBinaryMagic;
+			Header.Version = FormatVersion;
+			Header.Key = _Key;
+			Header.BinaryFormat = BinaryFormat;
+			Header.BinarySize = Cast( Uint32, BinarySize );
+
+			const std::string ProgramPath = GetProgramPath( _Key );
+
+			std::ofstream File( ProgramPath, std::ios::binary | std::ios::trunc );
+			if( !File.is_open() )
+			{
+				AE_LogWarning( std::string( "Failed to open the shader cache file " ) + ProgramPath + ". The shader will be compiled at each launch." );
+				return;
+			}
+
+			File.write( reinterpret_cast<const char*>( &Header ), sizeof( ProgramBinaryHeader ) );
+			File.write( Binary.data(), BinarySize );
+
+			// Never leave a truncated binary, it would be read and refused at each launch.
+			if( !File.good() )
+			{
+				File.close();
+				std::remove( ProgramPath.c_str() );
+			}
+		}
+
+		void ShaderCache::PrepareProgram( Uint32 _ProgramID )
+		{
+			InitializeDriverInfos();
+
+			if( !m_IsEnabled || !m_IsBinarySupported )
+				return;
+
+			glProgramParameteri( _ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		Bool ShaderCache::IsParallelCompileAvailable()
+		{
+			InitializeDriverInfos();
+
+			return m_IsParallelCompileAvailable;
+		}
+
+		void ShaderCache::AddCreationTime( float _Seconds )
+		{
+			m_Stats.CreationTime += _Seconds;
+		}
+
+		const ShaderCacheStats& ShaderCache::GetStats() const
+		{
+			return m_Stats;
+		}
+
+		void ShaderCache::InitializeDriverInfos()
+		{
+			if( m_IsInitialized )
+				return;
+
+			m_IsInitialized = True;
+
+			// A binary is only valid for the driver that produced it.
+			const std::string Driver = GetOpenGLString( GL_VENDOR ) + "|" + GetOpenGLString( GL_RENDERER ) + "|" + GetOpenGLString( GL_VERSION );
+
+			const Uint32 Version = FormatVersion;
+
+			m_DriverHash = 14695981039346656037ull;
+			HashData( m_DriverHash, &Version, sizeof( Uint32 ) );
+			HashData( m_DriverHash, Driver.data(), Driver.size() );
+
+			GLint BinaryFormatsCount = 0;
+			glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &BinaryFormatsCount );
+			AE_ErrorCheckOpenGLError();
+
+			m_IsBinarySupported = BinaryFormatsCount > 0;
+
+			m_IsParallelCompileAvailable = GLEW_ARB_parallel_shader_compile ? True : False;
+			if( m_IsParallelCompileAvailable )
+			{
+				// Let the driver choose the count of compiler threads.
+				glMaxShaderCompilerThreadsARB( 0xFFFFFFFF );
+				AE_ErrorCheckOpenGLError();
+			}
+		}
+
+		std::string ShaderCache::GetProgramPath( Uint64 _Key ) const
+		{
+			char KeyString[17];
+			std::snprintf( KeyString, sizeof( KeyString ), "%016llx", Cast( unsigned long long, _Key ) );
+
+			return m_Directory + "/" + KeyString + Extension;
+		}
+
+	} // priv
+
+} // ae
@@ -0,0 +1,159 @@
+#ifndef _SHADERCACHE_AERO_H_
+#define _SHADERCACHE_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../../Idioms/NotCopiable/NotCopiable.h"
+
+#include <string>
+#include <vector>
+
+namespace ae
+{
+	/// \ingroup graphics
+	/// <summary>Statistics of the shader program cache of the resources manager.</summary>
+	/// <seealso cref="ResourcesManager::GetShaderCacheStats" />
+	struct ShaderCacheStats
+	{
+		/// <summary>Count of programs loaded from a binary of the cache.</summary>
+		Uint32 Hits = 0;
+
+		/// <summary>Count of programs compiled from their sources.</summary>
+		Uint32 Misses = 0;
+
+		/// <summary>Count of binaries refused by the driver, usually after a driver update.</summary>
+		Uint32 Rejected = 0;
+
+		/// <summary>Time in seconds spent by the main thread creating programs : reading, compiling and waiting for the links.</summary>
+		float CreationTime = 0.0f;
+	};
+
+	namespace priv
+	{
+		/// \ingroup graphics
+		/// <summary>Source of one stage of a shader program, after the includes have been processed.</summary>
+		struct ShaderStageSource
+		{
+			/// <summary>OpenGL type of the stage (GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...).</summary>
+			Uint32 Type = 0;
+
+			/// <summary>Code of the stage.</summary>
+			std::string Code;
+		};
+
+		/// \ingroup graphics
+		/// <summary>
+		/// Disk cache of linked shader programs.<para/>
+		/// The binary of a program is saved once linked and is loaded instead of compiling the sources the next time.
+		/// A binary is found with the hash of the preprocessed sources of the stages and of the driver description,
+		/// so editing a shader, one of its includes or updating the driver compiles the program again.<para/>
+		/// Also enables parallel compilation in the driver when GL_ARB_parallel_shader_compile is available.
+		/// </summary>
+		/// <seealso cref="Shader" />
+		/// <seealso cref="ResourcesManager" />
+		class AERO_CORE_EXPORT ShaderCache : public NotCopiable
+		{
+		public:
+			/// <summary>Extension of the cached binaries.</summary>
+			static constexpr const char* Extension = ".aeprogram";
+
+			/// <summary>Version of the format, increase it when the layout of the file changes.</summary>
+			static constexpr Uint32 FormatVersion = 1;
+
+		public:
+			/// <summary>Build an enabled cache saving in the "ShaderCache" directory.</summary>
+			ShaderCache();
+
+			/// <summary>Set the directory where the binaries are saved. It is created when the first binary is saved.</summary>
+			/// <param name="_Directory">Path to the directory.</param>
+			void SetDirectory( const std::string& _Directory );
+
+			/// <summary>Get the directory where the binaries are saved.</summary>
+			/// <returns>Path to the directory.</returns>
+			const std::string& GetDirectory() const;
+
+			/// <summary>Enable or disable the cache. When disabled, all the programs are compiled from their sources.</summary>
+			/// <param name="_Enabled">Use the cache ?</param>
+			void SetEnabled( Bool _Enabled );
+
+			/// <summary>Is the cache used ?</summary>
+			/// <returns>True if the cache is used, False otherwise.</returns>
+			Bool IsEnabled() const;
+
+			/// <summary>Compute the key of a program from the sources of its stages and the driver description.</summary>
+			/// <param name="_Stages">Preprocessed sources of the stages.</param>
+			/// <returns>Key of the program in the cache.</returns>
+			Uint64 ComputeKey( const std::vector<ShaderStageSource>& _Stages );
+
+			/// <summary>
+			/// Load the binary of a program from the cache.<para/>
+			/// When it fails, the program must be linked from its sources.
+			/// </summary>
+			/// <param name="_ProgramID">OpenGL program to load the binary in.</param>
+			/// <param name="_Key">Key of the program.</param>
+			/// <returns>True if the program has been loaded and is linked, False otherwise.</returns>
+			Bool LoadProgram( Uint32 _ProgramID, Uint64 _Key );
+
+			/// <summary>Save the binary of a linked program in the cache.</summary>
+			/// <param name="_ProgramID">OpenGL program to save.</param>
+			/// <param name="_Key">Key of the program.</param>
+			void SaveProgram( Uint32 _ProgramID, Uint64 _Key );
+
+			/// <summary>Ask the driver to keep the binary of a program that will be linked.</summary>
+			/// <param name="_ProgramID">OpenGL program.</param>
+			void PrepareProgram( Uint32 _ProgramID );
+
+			/// <summary>
+			/// Can the driver compile and link in the background ?<para/>
+			/// The driver is told to use as many threads as it wants the first time it is called.
+			/// </summary>
+			/// <returns>True if GL_ARB_parallel_shader_compile is available, False otherwise.</returns>
+			Bool IsParallelCompileAvailable();
+
+			/// <summary>Add time spent creating programs to the statistics.</summary>
+			/// <param name="_Seconds">Time spent in seconds.</param>
+			void AddCreationTime( float _Seconds );
+
+			/// <summary>Retrieve the statistics of the cache.</summary>
+			/// <returns>Statistics of the cache.</returns>
+			const ShaderCacheStats& GetStats() const;
+
+		private:
+			/// <summary>Query the driver description and the binary support once a context exists.</summary>
+			void InitializeDriverInfos();
+
+			/// <summary>Get the path of the binary of a program.</summary>
+			/// <param name="_Key">Key of the program.</param>
+			/// <returns>Path to the binary file.</returns>
+			std::string GetProgramPath( Uint64 _Key ) const;
+
+		private:
+			/// <summary>Directory of the binaries.</summary>
+			std::string m_Directory;
+
+			/// <summary>Is the cache used ?</summary>
+			Bool m_IsEnabled;
+
+			/// <summary>Has the driver been queried ?</summary>
+			Bool m_IsInitialized;
+
+			/// <summary>Does the driver support at least one program binary format ?</summary>
+			Bool m_IsBinarySupported;
+
+			/// <summary>Is GL_ARB_parallel_shader_compile available ?</summary>
+			Bool m_IsParallelCompileAvailable;
+
+			/// <summary>Has the directory been created ?</summary>
+			Bool m_IsDirectoryCreated;
+
+			/// <summary>Hash of the vendor, renderer and version strings of the driver.</summary>
+			Uint64 m_DriverHash;
+
+			/// <summary>Statistics of the cache.</summary>
+			ShaderCacheStats m_Stats;
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _SHADERCACHE_AERO_H_
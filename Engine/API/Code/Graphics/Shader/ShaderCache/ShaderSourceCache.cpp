@@ -0,0 +1,234 @@
+#include "ShaderSourceCache.h"
+
+#include "../Shader.h"
+#include "../../../Debugging/Debugging.h"
+#include "../../../TimeManagement/Time/Time.h"
+#include "../../../Aero/Aero.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <memory>
+
+namespace ae
+{
+	namespace priv
+	{
+		namespace
+		{
+			/// <summary>Retrieve the last modification time of a file. Can be called from any thread.</summary>
+			/// <param name="_Path">Path to the file.</param>
+			/// <param name="_WriteTime">Modification time of the file.</param>
+			/// <returns>True if the file exists, False otherwise.</returns>
+			Bool GetFileWriteTime( const std::string& _Path, AE_Out Int64& _WriteTime )
+			{
+#ifdef WINDOWS
+				struct _stat64 FileInfos;
+				if( _stat64( _Path.c_str(), &FileInfos ) != 0 )
+					return False;
+#else
+				struct stat FileInfos;
+				if( stat( _Path.c_str(), &FileInfos ) != 0 )
+					return False;
+#endif
+
+				_WriteTime = Cast( Int64, FileInfos.st_mtime );
+				return True;
+			}
+
+			/// <summary>Read the entire content of a file. Doesn't log, can be called from any thread.</summary>
+			/// <param name="_Content">The content of the file.</param>
+			/// <param name="_Path">Path to the file to read.</param>
+			/// <returns>True if the reading was sucessfull, False otherwise.</returns>
+			Bool ReadFile( AE_Out std::string& _Content, const std::string& _Path )
+			{
+				std::ifstream File( _Path, std::ios::binary );
+				if( !File.is_open() )
+					return False;
+
+				File.seekg( 0, std::ios::end );
+				const std::streamoff FileLength = File.tellg();
+				File.seekg( 0 );
+
+				if( FileLength < 0 )
+					return False;
+
+				_Content.resize( Cast( size_t, FileLength ) );
+				if( FileLength > 0 )
+					File.read( &_Content[0], FileLength );
+
+				return !File.fail();
+			}
+		}
+
+		ShaderSourceCache::ShaderSourceCache() :
+			m_IsHotReloadEnabled( True ),
+			m_HotReloadInterval( 1.0f ),
+			m_LastCheckTime( 0 ),
+			m_CheckRequest( AsyncLoader::InvalidRequestID )
+		{
+		}
+
+		const std::string* ShaderSourceCache::GetFile( const std::string& _Path )
+		{
+			Int64 WriteTime = 0;
+			if( !GetFileWriteTime( _Path, WriteTime ) )
+				return nullptr;
+
+			SourceFile& File = m_Files[_Path];
+
+			if( !File.IsLoaded || File.WriteTime != WriteTime )
+			{
+				File.IsLoaded = ReadFile( File.Content, _Path );
+				File.WriteTime = WriteTime;
+			}
+
+			return File.IsLoaded ? &File.Content : nullptr;
+		}
+
+		void ShaderSourceCache::SetDependencies( const Shader& _Shader, const std::unordered_set<std::string>& _Files )
+		{
+			RemoveShader( _Shader );
+
+			std::vector<std::string>& ShaderFiles = m_ShaderFiles[&_Shader];
+			ShaderFiles.reserve( _Files.size() );
+
+			for( const std::string& Path : _Files )
+			{
+				m_Files[Path].Shaders.insert( &_Shader );
+				ShaderFiles.push_back( Path );
+			}
+		}
+
+		void ShaderSourceCache::RemoveShader( const Shader& _Shader )
+		{
+			std::unordered_map<const Shader*, std::vector<std::string>>::iterator ItShader = m_ShaderFiles.find( &_Shader );
+			if( ItShader == m_ShaderFiles.end() )
+				return;
+
+			for( const std::string& Path : ItShader->second )
+			{
+				std::unordered_map<std::string, SourceFile>::iterator ItFile = m_Files.find( Path );
+				if( ItFile != m_Files.end() )
+					ItFile->second.Shaders.erase( &_Shader );
+			}
+
+			m_ShaderFiles.erase( ItShader );
+		}
+
+		std::vector<const Shader*> ShaderSourceCache::GetDependentShaders( const std::string& _Path ) const
+		{
+			std::unordered_map<std::string, SourceFile>::const_iterator ItFile = m_Files.find( _Path );
+			if( ItFile == m_Files.cend() )
+				return std::vector<const Shader*>();
+
+			return std::vector<const Shader*>( ItFile->second.Shaders.cbegin(), ItFile->second.Shaders.cend() );
+		}
+
+		void ShaderSourceCache::SetHotReloadEnabled( Bool _Enabled )
+		{
+			m_IsHotReloadEnabled = _Enabled;
+		}
+
+		Bool ShaderSourceCache::IsHotReloadEnabled() const
+		{
+			return m_IsHotReloadEnabled;
+		}
+
+		void ShaderSourceCache::SetHotReloadInterval( float _Seconds )
+		{
+			m_HotReloadInterval = _Seconds;
+		}
+
+		float ShaderSourceCache::GetHotReloadInterval() const
+		{
+			return m_HotReloadInterval;
+		}
+
+		void ShaderSourceCache::CheckModifiedFiles()
+		{
+			if( !m_IsHotReloadEnabled || m_Files.empty() )
+				return;
+
+			AsyncLoader& Loader = Aero.GetAsyncLoader();
+
+			// Only one check at a time.
+			if( m_CheckRequest != AsyncLoader::InvalidRequestID && Loader.IsPending( m_CheckRequest ) )
+				return;
+
+			const Int64 CurrentTime = Time::GetTick().AsMicroSeconds();
+			if( Cast( float, CurrentTime - m_LastCheckTime ) * 0.000001f < m_HotReloadInterval )
+				return;
+
+			m_LastCheckTime = CurrentTime;
+
+			// The worker works on a copy of the known modification times, the cache is only touched on the main thread.
+			std::shared_ptr<std::vector<ScannedFile>> Files = std::make_shared<std::vector<ScannedFile>>();
+			Files->reserve( m_Files.size() );
+
+			for( const std::pair<const std::string, SourceFile>& FilePair : m_Files )
+			{
+				if( FilePair.second.Shaders.empty() )
+					continue;
+
+				ScannedFile File;
+				File.Path = FilePair.first;
+				File.WriteTime = FilePair.second.WriteTime;
+				Files->push_back( std::move( File ) );
+			}
+
+			m_CheckRequest = Loader.Load(
+				[Files]()
+				{
+					for( ScannedFile& File : *Files )
+					{
+						Int64 WriteTime = 0;
+						if( !GetFileWriteTime( File.Path, WriteTime ) || WriteTime == File.WriteTime )
+							continue;
+
+						// Editors can save in several steps, the file is read again at the next check if it was incomplete.
+						File.IsModified = ReadFile( File.Content, File.Path );
+						if( File.IsModified )
+							File.WriteTime = WriteTime;
+					}
+				},
+				[this, Files]()
+				{
+					m_CheckRequest = AsyncLoader::InvalidRequestID;
+					ApplyModifiedFiles( *Files );
+				} );
+		}
+
+		void ShaderSourceCache::ApplyModifiedFiles( std::vector<ScannedFile>& _Files )
+		{
+			std::unordered_set<const Shader*> ShadersToCompile;
+
+			for( ScannedFile& File : _Files )
+			{
+				if( !File.IsModified )
+					continue;
+
+				std::unordered_map<std::string, SourceFile>::iterator ItFile = m_Files.find( File.Path );
+				if( ItFile == m_Files.end() )
+					continue;
+
+				ItFile->second.Content = std::move( File.Content );
+				ItFile->second.WriteTime = File.WriteTime;
+				ItFile->second.IsLoaded = True;
+
+				ShadersToCompile.insert( ItFile->second.Shaders.cbegin(), ItFile->second.Shaders.cend() );
+			}
+
+			// The compilation starts here and the link status is checked at the first use of each shader,
+			// the driver compiles them in the background when it can.
+			for( const Shader* ShaderToCompile : ShadersToCompile )
+			{
+				AE_LogMessage( std::string( "Recompiling modified shader " ) + ShaderToCompile->GetName() );
+				ShaderToCompile->Compile();
+			}
+		}
+
+	} // priv
+
+} // ae
@@ -0,0 +1,141 @@
+#ifndef _SHADERSOURCECACHE_AERO_H_
+#define _SHADERSOURCECACHE_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../../Idioms/NotCopiable/NotCopiable.h"
+#include "../../../Resources/AsyncLoader/AsyncLoader.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ae
+{
+	class Shader;
+
+	namespace priv
+	{
+		/// \ingroup graphics
+		/// <summary>
+		/// Content of the shader files and includes, shared by all the shaders.<para/>
+		/// A file is read once and read again only when its modification time changes.
+		/// The cache also knows which shaders use each file, so with the hot reload,
+		/// editing a file recompiles only the shaders that depend on it.<para/>
+		/// The files are checked for modifications on a worker of the asynchronous loader,
+		/// the shaders are recompiled during its upload step.
+		/// </summary>
+		/// <seealso cref="Shader" />
+		/// <seealso cref="ResourcesManager" />
+		class AERO_CORE_EXPORT ShaderSourceCache : public NotCopiable
+		{
+		public:
+			/// <summary>
+			/// Build an empty cache with the hot reload enabled.<para/>
+			/// The asynchronous loader is destroyed before the resources manager, a check in progress never outlives the cache.
+			/// </summary>
+			ShaderSourceCache();
+
+			/// <summary>Retrieve the content of a file, read from the disk if not cached or modified since.</summary>
+			/// <param name="_Path">Path to the file.</param>
+			/// <returns>The content of the file, null if it cannot be read.</returns>
+			const std::string* GetFile( const std::string& _Path );
+
+			/// <summary>Set the files used by a shader, replacing the previous ones.</summary>
+			/// <param name="_Shader">Shader using the files.</param>
+			/// <param name="_Files">Stage files and includes of the shader.</param>
+			void SetDependencies( const Shader& _Shader, const std::unordered_set<std::string>& _Files );
+
+			/// <summary>Forget the files used by a shader. Called when the shader is destroyed.</summary>
+			/// <param name="_Shader">Shader to forget.</param>
+			void RemoveShader( const Shader& _Shader );
+
+			/// <summary>Retrieve the shaders using a file, directly or through an include.</summary>
+			/// <param name="_Path">Path to the file.</param>
+			/// <returns>Shaders using the file.</returns>
+			std::vector<const Shader*> GetDependentShaders( const std::string& _Path ) const;
+
+			/// <summary>Enable or disable the recompilation of the shaders when their files are modified.</summary>
+			/// <param name="_Enabled">Recompile modified shaders ?</param>
+			void SetHotReloadEnabled( Bool _Enabled );
+
+			/// <summary>Are the shaders recompiled when their files are modified ?</summary>
+			/// <returns>True if the hot reload is enabled, False otherwise.</returns>
+			Bool IsHotReloadEnabled() const;
+
+			/// <summary>Set the time between two checks of the files.</summary>
+			/// <param name="_Seconds">Interval in seconds.</param>
+			void SetHotReloadInterval( float _Seconds );
+
+			/// <summary>Get the time between two checks of the files.</summary>
+			/// <returns>Interval in seconds.</returns>
+			float GetHotReloadInterval() const;
+
+			/// <summary>
+			/// Start a check of the files in the background if the interval is elapsed.<para/>
+			/// Called each frame by AeroCore::Update.
+			/// </summary>
+			void CheckModifiedFiles();
+
+		private:
+			/// <summary>A cached file.</summary>
+			struct SourceFile
+			{
+				/// <summary>Content of the file.</summary>
+				std::string Content;
+
+				/// <summary>Modification time of the file when it has been read.</summary>
+				Int64 WriteTime = 0;
+
+				/// <summary>Has the file been read successfully ?</summary>
+				Bool IsLoaded = False;
+
+				/// <summary>Shaders using the file.</summary>
+				std::unordered_set<const Shader*> Shaders;
+			};
+
+			/// <summary>A file checked in the background.</summary>
+			struct ScannedFile
+			{
+				/// <summary>Path to the file.</summary>
+				std::string Path;
+
+				/// <summary>Modification time known by the cache, then read from the disk.</summary>
+				Int64 WriteTime = 0;
+
+				/// <summary>New content of the file if modified.</summary>
+				std::string Content;
+
+				/// <summary>Has the file been modified and read again ?</summary>
+				Bool IsModified = False;
+			};
+
+			/// <summary>Update the modified files and recompile the shaders using them.</summary>
+			/// <param name="_Files">Files checked in the background.</param>
+			void ApplyModifiedFiles( std::vector<ScannedFile>& _Files );
+
+		private:
+			/// <summary>Cached files by path.</summary>
+			std::unordered_map<std::string, SourceFile> m_Files;
+
+			/// <summary>Files used by each shader.</summary>
+			std::unordered_map<const Shader*, std::vector<std::string>> m_ShaderFiles;
+
+			/// <summary>Are the shaders recompiled when their files are modified ?</summary>
+			Bool m_IsHotReloadEnabled;
+
+			/// <summary>Time between two checks of the files, in seconds.</summary>
+			float m_HotReloadInterval;
+
+			/// <summary>Time of the last check, in microseconds.</summary>
+			Int64 m_LastCheckTime;
+
+			/// <summary>Request of the check in progress.</summary>
+			AsyncLoader::RequestID m_CheckRequest;
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _SHADERSOURCECACHE_AERO_H_
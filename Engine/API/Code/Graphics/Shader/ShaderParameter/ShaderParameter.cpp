@@ -11,8 +11,11 @@ namespace ae
 		m_UniformName( _UniformName ),
 		m_IsLocationSaved( False ),
 		m_UniformLocation( -1 ),
+		m_SavedProgramID( 0 ),
+		m_SavedRevision( 0 ),
 		m_IsEditable( True ),
-		m_IsDestroyedWithMaterial( False )
+		m_IsDestroyedWithMaterial( False ),
+		m_Version( 0 )
 	{
 	}
 
@@ -33,6 +36,9 @@ namespace ae
 		// The uniform name has changed, so the saved location can be invalid now.
 		// We disable the save for safety.
 		DiscardSave();
+
+		// The parameter can target another member of the uniform block.
+		MarkDirty();
 	}
 
 	void ShaderParameter::SaveUniformLocation( const Shader& _Shader )
@@ -41,6 +47,8 @@ namespace ae
 			return;
 
 		m_UniformLocation = _Shader.GetUniformLocation( m_UniformName );
+		m_SavedProgramID = _Shader.GetProgramID();
+		m_SavedRevision = _Shader.GetRevision();
 		m_IsLocationSaved = True;
 	}
 
@@ -48,6 +56,8 @@ namespace ae
 	{
 		m_IsLocationSaved = False;
 		m_UniformLocation = -1;
+		m_SavedProgramID = 0;
+		m_SavedRevision = 0;
 	}
 
 	Bool ShaderParameter::IsSaved() const
@@ -55,6 +65,12 @@ namespace ae
 		return m_IsLocationSaved;
 	}
 
+	Bool ShaderParameter::IsSavedFor( const Shader& _Shader ) const
+	{
+		// A recompiled shader can have moved its uniforms.
+		return m_IsLocationSaved && m_SavedProgramID == _Shader.GetProgramID() && m_SavedRevision == _Shader.GetRevision();
+	}
+
 	Bool ShaderParameter::IsEditable() const
 	{
 		return m_IsEditable;
@@ -77,7 +93,7 @@ namespace ae
 
 	Int32 ShaderParameter::GetUniformLocation( const Shader& _Shader ) const
 	{
-		return IsSaved() ? m_UniformLocation : _Shader.GetUniformLocation( GetUniformName() );
+		return IsSavedFor( _Shader ) ? m_UniformLocation : _Shader.GetUniformLocation( GetUniformName() );
 	}
 
 	void ShaderParameter::SendToShader( const Shader&, AE_InOut Uint32&, AE_InOut Uint32& )
@@ -90,6 +106,26 @@ namespace ae
 	{
 	}
 
+	Bool ShaderParameter::WriteToUniformBlock( const priv::UniformBlockLayout&, AE_Out Uint8* ) const
+	{
+		return False;
+	}
+
+	const std::string* ShaderParameter::GetVariantFlag( AE_Out Bool& ) const
+	{
+		return nullptr;
+	}
+
+	void ShaderParameter::MarkDirty()
+	{
+		m_Version++;
+	}
+
+	Uint32 ShaderParameter::GetVersion() const
+	{
+		return m_Version;
+	}
+
 	void ShaderParameter::ToEditor()
 	{
 		priv::ui::ShaderParameterToEditor( *this );
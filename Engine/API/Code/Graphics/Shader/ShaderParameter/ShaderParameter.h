@@ -8,6 +8,11 @@ namespace ae
 {
 	class Shader;
 
+	namespace priv
+	{
+		class UniformBlockLayout;
+	}
+
 	/// \ingroup graphics
 	/// <summary>
 	/// Top class for shader parameters.<para/>
@@ -72,6 +77,14 @@ namespace ae
 		/// <returns>True if the uniform location has been saved, False otherwise.</returns>
 		Bool IsSaved() const;
 
+		/// <summary>
+		/// The uniform location has been saved from the program of <paramref name="_Shader"/> ?<para/>
+		/// A material can be drawn with several shaders (instanced variant for example), the saved location is only valid for one of them.
+		/// </summary>
+		/// <param name="_Shader">Shader to check.</param>
+		/// <returns>True if the uniform location has been saved from this shader, False otherwise.</returns>
+		Bool IsSavedFor( const Shader& _Shader ) const;
+
 		/// <summary>Is the parameter is visible in the editor ?</summary>
 		/// <returns>True if the parameter is visible in the editor, False otherwise.</returns>
 		Bool IsEditable() const;
@@ -102,7 +115,7 @@ namespace ae
 
 		/// <summary>
 		/// Get the uniform location of the parameter.<para/>
-		/// If the uniform is saved, the saved one is returned. <para/>
+		/// If the uniform is saved for this shader, the saved one is returned. <para/>
 		/// Otherwise the location is asked to the <paramref name="_Shader"/>.<para/>
 		/// </summary>
 		/// <param name="_Shader">The shader to ask the uniform to if it is not saved.</param>
@@ -129,6 +142,40 @@ namespace ae
 		/// <param name="_ImageUnit">The target image unit in the shader for the parameter.</param>
 		virtual void Clean( const Shader& _Shader, AE_InOut Uint32& _TextureUnit, AE_InOut Uint32& _ImageUnit );
 
+		/// <summary>
+		/// Write the parameter in a uniform block.<para/>
+		/// Used by the materials that pack their parameters in a uniform buffer.
+		/// </summary>
+		/// <param name="_Layout">Layout of the block to write to.</param>
+		/// <param name="_Data">Block data to write the parameter value in.</param>
+		/// <returns>
+		/// True if the whole parameter is stored in the block and doesn't need to be sent anymore, 
+		/// False if it must still be sent with SendToShader (not in the block, or texture to bind).
+		/// </returns>
+		virtual Bool WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const;
+
+		/// <summary>
+		/// Retrieve the static flag of the parameter used to select a shader variant.<para/>
+		/// A flag is a boolean uniform that changes rarely (a texture slot filled or not for example),
+		/// the material can compile a variant of its shader where the flag is a constant.
+		/// </summary>
+		/// <param name="_Value">Value of the flag, set only if the parameter has one.</param>
+		/// <returns>Name of the boolean uniform of the flag, null if the parameter has no flag.</returns>
+		virtual const std::string* GetVariantFlag( AE_Out Bool& _Value ) const;
+
+		/// <summary>
+		/// Tag the parameter as changed by incrementing its version.<para/>
+		/// Called by the setters, the uniform blocks of the materials holding the parameter will be uploaded again.
+		/// </summary>
+		void MarkDirty();
+
+		/// <summary>
+		/// Retrieve the version of the parameter, incremented at each change.<para/>
+		/// Each material compares it with the version of its last upload : a parameter shared by several materials is uploaded by all of them.
+		/// </summary>
+		/// <returns>Version of the parameter.</returns>
+		Uint32 GetVersion() const;
+
 		/// <summary>
 		/// Function called by the editor.
 		/// It allows the class to expose some attributes for user editing.
@@ -163,6 +210,12 @@ namespace ae
 		/// <summary>If saved, contains the uniform location in the shader.</summary>
 		Int32 m_UniformLocation;
 
+		/// <summary>If saved, program the uniform location has been fetched from.</summary>
+		Uint32 m_SavedProgramID;
+
+		/// <summary>If saved, revision of the program the uniform location has been fetched from.</summary>
+		Uint32 m_SavedRevision;
+
 		/// <summary>If true, the editor will call ToEditor() function.</summary>
 		Bool m_IsEditable;
 		
@@ -171,6 +224,9 @@ namespace ae
 		/// the parameter will be freed too.
 		/// </summary>
 		Bool m_IsDestroyedWithMaterial;
+
+		/// <summary>Count of changes of the parameter, compared by the materials with the one of their last uniform block upload.</summary>
+		Uint32 m_Version;
 	};
 
 } // ae
@@ -1,6 +1,7 @@
 #include "ShaderParameterBool.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 
 #include "../../../Editor/TypesToEditor/ShaderParameterBoolToEditor.h"
 
@@ -14,6 +15,7 @@ namespace ae
 	void ShaderParameterBool::SetValue( Bool _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 	}
 	Bool ShaderParameterBool::GetValue() const
 	{
@@ -22,6 +24,7 @@ namespace ae
 	ShaderParameter& ShaderParameterBool::operator=( Bool _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 
 		return *this;
 	}
@@ -36,6 +39,10 @@ namespace ae
 
 		Shader::SetBool( Location, m_Value );
 	}
+	Bool ShaderParameterBool::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		return _Layout.WriteBool( _Data, GetUniformName(), m_Value );
+	}
 	void ShaderParameterBool::ToEditor()
 	{
 		ShaderParameter::ToEditor();
@@ -56,6 +56,12 @@ namespace ae
 		/// <param name="_ImageUnit">The target image unit in the shader for the parameter.</param>
 		void SendToShader( const Shader& _Shader, AE_InOut Uint32& _TextureUnit, AE_InOut Uint32& _ImageUnit ) override final;
 
+		/// <summary>Write the parameter value in a uniform block.</summary>
+		/// <param name="_Layout">Layout of the block to write to.</param>
+		/// <param name="_Data">Block data to write the parameter value in.</param>
+		/// <returns>True if the uniform is a member of the block, False otherwise.</returns>
+		Bool WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const override final;
+
 		/// <summary>
 		/// Function called by the editor.
 		/// It allows the class to expose some attributes for user editing.
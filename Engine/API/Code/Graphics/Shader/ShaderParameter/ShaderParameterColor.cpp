@@ -1,6 +1,7 @@
 #include "ShaderParameterColor.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../../Maths/Functions/MathsFunctions.h"
 
 #include "../../../Editor/TypesToEditor/ShaderParameterColorToEditor.h"
@@ -16,6 +17,7 @@ namespace ae
 	void ShaderParameterColor::SetValue( const Color& _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 	}
 
 	const Color& ShaderParameterColor::GetValue() const
@@ -26,6 +28,7 @@ namespace ae
 	ShaderParameter& ShaderParameterColor::operator=( const Color& _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 
 		return *this;
 	}
@@ -42,6 +45,11 @@ namespace ae
 		Shader::SetColor( Location, m_Value );
 	}
 
+	Bool ShaderParameterColor::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		return _Layout.Write( _Data, GetUniformName(), m_Value );
+	}
+
 	void ShaderParameterColor::ToEditor()
 	{
 		ShaderParameter::ToEditor();
@@ -16,6 +16,7 @@ namespace ae
 	void ShaderParameterCubeMap::SetValue( const CubeMap* _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 	}
 	const CubeMap* ShaderParameterCubeMap::GetValue() const
 	{
@@ -24,6 +25,7 @@ namespace ae
 	ShaderParameter& ShaderParameterCubeMap::operator=( CubeMap* _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 
 		return *this;
 	}
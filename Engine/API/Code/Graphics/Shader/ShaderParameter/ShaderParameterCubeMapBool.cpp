@@ -1,6 +1,7 @@
 #include "ShaderParameterCubeMapBool.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../CubeMap/CubeMap.h"
 #include "../../../Debugging/Debugging.h"
 #include "../../Dependencies/OpenGL.h"
@@ -22,11 +23,13 @@ namespace ae
 	void ShaderParameterCubeMapBool::SetCubeMap( const CubeMap* _Value )
 	{
 		m_CubeMap = _Value;
+		MarkDirty();
 	}
 
 	ShaderParameter& ShaderParameterCubeMapBool::operator=( const CubeMap* _Value )
 	{
 		m_CubeMap = _Value;
+		MarkDirty();
 
 		return *this;
 	}
@@ -51,11 +54,12 @@ namespace ae
 		m_UniformNameBool = _Name;
 
 		DiscardSave();
+		MarkDirty();
 	}
 
 	Int32 ShaderParameterCubeMapBool::GetUniformLocationBool( const Shader& _Shader ) const
 	{
-		return IsSaved() ? m_UniformLocationBool : _Shader.GetUniformLocation( GetUniformNameBool() );
+		return IsSavedFor( _Shader ) ? m_UniformLocationBool : _Shader.GetUniformLocation( GetUniformNameBool() );
 	}
 
 	void ShaderParameterCubeMapBool::SaveUniformLocation( const Shader& _Shader )
@@ -149,6 +153,23 @@ namespace ae
 		}
 	}
 
+	Bool ShaderParameterCubeMapBool::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		_Layout.WriteBool( _Data, GetUniformNameBool(), IsCubeMapValid() );
+
+		// The cube map must still be bound by SendToShader.
+		return False;
+	}
+
+	const std::string* ShaderParameterCubeMapBool::GetVariantFlag( AE_Out Bool& _Value ) const
+	{
+		if( m_UniformNameBool.empty() )
+			return nullptr;
+
+		_Value = IsCubeMapValid();
+		return &m_UniformNameBool;
+	}
+
 	void ShaderParameterCubeMapBool::ToEditor()
 	{
 		ShaderParameter::ToEditor();
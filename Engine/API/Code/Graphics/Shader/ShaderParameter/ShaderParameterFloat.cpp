@@ -1,6 +1,7 @@
 #include "ShaderParameterFloat.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../../Maths/Functions/MathsFunctions.h"
 
 #include "../../../Editor/TypesToEditor/ShaderParameterFloatToEditor.h"
@@ -69,6 +70,10 @@ namespace ae
 
 		Shader::SetFloat( Location, m_Value );
 	}
+	Bool ShaderParameterFloat::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		return _Layout.Write( _Data, GetUniformName(), m_Value );
+	}
 	void ShaderParameterFloat::ToEditor()
 	{
 		ShaderParameter::ToEditor();
@@ -85,5 +90,7 @@ namespace ae
 	void ShaderParameterFloat::ClampValue()
 	{
 		m_Value = Math::Clamp( m_Min, m_Max, m_Value );
+
+		MarkDirty();
 	}
 } // ae
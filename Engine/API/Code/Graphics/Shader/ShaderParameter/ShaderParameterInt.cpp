@@ -1,6 +1,7 @@
 #include "ShaderParameterInt.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../../Maths/Functions/MathsFunctions.h"
 
 #include "../../../Editor/TypesToEditor/ShaderParameterIntToEditor.h"
@@ -85,6 +86,11 @@ namespace ae
 	}
 
 
+	Bool ShaderParameterInt::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		return _Layout.Write( _Data, GetUniformName(), m_Value );
+	}
+
 	void ShaderParameterInt::ToEditor()
 	{
 		ShaderParameter::ToEditor();
@@ -102,6 +108,8 @@ namespace ae
 	void ShaderParameterInt::ClampValue()
 	{
 		m_Value = Math::Clamp( m_Min, m_Max, m_Value );
+
+		MarkDirty();
 	}
 
 } // ae
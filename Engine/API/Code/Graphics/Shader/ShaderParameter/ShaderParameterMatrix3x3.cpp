@@ -1,6 +1,7 @@
 #include "ShaderParameterMatrix3x3.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../../Maths/Functions/MathsFunctions.h"
 
 #include "../../../Editor/TypesToEditor/ShaderParameterMatrix3x3ToEditor.h"
@@ -15,6 +16,7 @@ namespace ae
 	void ShaderParameterMatrix3x3::SetValue( const Matrix3x3& _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 	}
 	const Matrix3x3& ShaderParameterMatrix3x3::GetValue() const
 	{
@@ -23,6 +25,7 @@ namespace ae
 	ShaderParameter& ShaderParameterMatrix3x3::operator=( const Matrix3x3& _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 
 		return *this;
 	}
@@ -37,6 +40,10 @@ namespace ae
 
 		Shader::SetMatrix3x3( Location, m_Value );
 	}
+	Bool ShaderParameterMatrix3x3::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		return _Layout.Write( _Data, GetUniformName(), m_Value );
+	}
 	void ShaderParameterMatrix3x3::ToEditor()
 	{
 		ShaderParameter::ToEditor();
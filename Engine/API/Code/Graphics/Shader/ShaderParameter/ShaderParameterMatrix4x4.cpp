@@ -1,6 +1,7 @@
 #include "ShaderParameterMatrix4x4.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../../Maths/Functions/MathsFunctions.h"
 
 #include "../../../Editor/TypesToEditor/ShaderParameterMatrix4x4ToEditor.h"
@@ -15,6 +16,7 @@ namespace ae
 	void ShaderParameterMatrix4x4::SetValue( const Matrix4x4& _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 	}
 	const Matrix4x4& ShaderParameterMatrix4x4::GetValue() const
 	{
@@ -23,6 +25,7 @@ namespace ae
 	ShaderParameter& ShaderParameterMatrix4x4::operator=( const Matrix4x4& _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 
 		return *this;
 	}
@@ -37,6 +40,10 @@ namespace ae
 
 		Shader::SetMatrix4x4( Location, m_Value );
 	}
+	Bool ShaderParameterMatrix4x4::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		return _Layout.Write( _Data, GetUniformName(), m_Value );
+	}
 	void ShaderParameterMatrix4x4::ToEditor()
 	{
 		ShaderParameter::ToEditor();
@@ -16,6 +16,7 @@ namespace ae
 	void ShaderParameterTexture::SetValue( const Texture* _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 	}
 	const Texture* ShaderParameterTexture::GetValue() const
 	{
@@ -24,6 +25,7 @@ namespace ae
 	ShaderParameter& ShaderParameterTexture::operator=( const Texture* _Value )
 	{
 		m_Value = _Value;
+		MarkDirty();
 
 		return *this;
 	}
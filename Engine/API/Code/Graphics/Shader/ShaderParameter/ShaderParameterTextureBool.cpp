@@ -1,6 +1,7 @@
 #include "ShaderParameterTextureBool.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../Texture/Texture.h"
 
 #include "../../../Debugging/Debugging.h"
@@ -23,11 +24,13 @@ namespace ae
 	void ShaderParameterTextureBool::SetTexture( const Texture* _Value )
 	{
 		m_Texture = _Value;
+		MarkDirty();
 	}
 
 	ShaderParameterTextureBool& ShaderParameterTextureBool::operator=( const Texture* _Value )
 	{
 		m_Texture = _Value;
+		MarkDirty();
 
 		return *this;
 	}
@@ -54,11 +57,14 @@ namespace ae
 		// The uniform name has changed, so the saved location can be invalid now.
 		// We disable the save for safety.
 		DiscardSave();
+
+		// The boolean can target another member of the uniform block.
+		MarkDirty();
 	}
 
 	Int32 ShaderParameterTextureBool::GetUniformLocationBool( const Shader& _Shader ) const
 	{
-		return IsSaved() ? m_UniformLocationBool : _Shader.GetUniformLocation( GetUniformNameBool() );
+		return IsSavedFor( _Shader ) ? m_UniformLocationBool : _Shader.GetUniformLocation( GetUniformNameBool() );
 	}
 
 	void ShaderParameterTextureBool::SaveUniformLocation( const Shader& _Shader )
@@ -152,6 +158,23 @@ namespace ae
 		}
 	}
 
+	Bool ShaderParameterTextureBool::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		_Layout.WriteBool( _Data, GetUniformNameBool(), IsTextureValid() );
+
+		// The texture must still be bound by SendToShader.
+		return False;
+	}
+
+	const std::string* ShaderParameterTextureBool::GetVariantFlag( AE_Out Bool& _Value ) const
+	{
+		if( m_UniformNameBool.empty() )
+			return nullptr;
+
+		_Value = IsTextureValid();
+		return &m_UniformNameBool;
+	}
+
 	void ShaderParameterTextureBool::ToEditor()
 	{
 		ShaderParameter::ToEditor();
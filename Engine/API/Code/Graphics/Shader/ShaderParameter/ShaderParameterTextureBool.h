@@ -104,6 +104,17 @@ namespace ae
 		/// <param name="_ImageUnit">The target image unit in the shader for the parameter.</param>
 		void Clean( const Shader& _Shader, AE_InOut Uint32& _TextureUnit, AE_InOut Uint32& _ImageUnit ) override final;
 
+		/// <summary>Write the boolean telling if the texture is valid in a uniform block.</summary>
+		/// <param name="_Layout">Layout of the block to write to.</param>
+		/// <param name="_Data">Block data to write the boolean in.</param>
+		/// <returns>Always False, the texture must still be sent with SendToShader.</returns>
+		Bool WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const override final;
+
+		/// <summary>Retrieve the boolean telling if the texture is valid, as flag to select a shader variant.</summary>
+		/// <param name="_Value">Is the texture valid ?</param>
+		/// <returns>Name of the boolean uniform.</returns>
+		const std::string* GetVariantFlag( AE_Out Bool& _Value ) const override final;
+
 		/// <summary>
 		/// Function called by the editor.
 		/// It allows the class to expose some attributes for user editing.
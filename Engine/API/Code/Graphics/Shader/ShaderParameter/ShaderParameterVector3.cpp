@@ -1,6 +1,7 @@
 #include "ShaderParameterVector3.h"
 
 #include "../Shader.h"
+#include "../UniformBlock/UniformBlockLayout.h"
 #include "../../../Maths/Functions/MathsFunctions.h"
 
 #include "../../../Editor/TypesToEditor/ShaderParameterVector3ToEditor.h"
@@ -69,6 +70,10 @@ namespace ae
 
 		Shader::SetVector3( Location, m_Value );
 	}
+	Bool ShaderParameterVector3::WriteToUniformBlock( const priv::UniformBlockLayout& _Layout, AE_Out Uint8* _Data ) const
+	{
+		return _Layout.Write( _Data, GetUniformName(), m_Value );
+	}
 	void ShaderParameterVector3::ToEditor()
 	{
 		ShaderParameter::ToEditor();
@@ -85,5 +90,7 @@ namespace ae
 		m_Value.X = Math::Clamp( m_Min, m_Max, m_Value.X );
 		m_Value.Y = Math::Clamp( m_Min, m_Max, m_Value.Y );
 		m_Value.Z = Math::Clamp( m_Min, m_Max, m_Value.Z );
+
+		MarkDirty();
 	}
 } // ae
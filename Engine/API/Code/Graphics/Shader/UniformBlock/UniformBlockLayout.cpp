@@ -0,0 +1,242 @@
+#include "UniformBlockLayout.h"
+
+#include "../Shader.h"
+#include "../../Color/Color.h"
+#include "../../Dependencies/OpenGL.h"
+#include "../../../Maths/Vector/Vector2.h"
+#include "../../../Maths/Vector/Vector3.h"
+#include "../../../Maths/Matrix/Matrix3x3.h"
+#include "../../../Maths/Matrix/Matrix4x4.h"
+#include "../../../Maths/Functions/MathsFunctions.h"
+#include "../../../Debugging/Debugging.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+namespace ae
+{
+	namespace priv
+	{
+		const std::string UniformBlockLayout::MaterialBlockName = "MaterialParameters";
+
+		UniformBlockLayout::UniformBlockLayout() :
+			m_Size( 0 ),
+			m_BindingPoint( 0 )
+		{
+		}
+
+		Bool UniformBlockLayout::LoadFromShader( const Shader& _Shader, const std::string& _BlockName, Uint32 _BindingPoint )
+		{
+			m_Members.clear();
+			m_Key.clear();
+			m_Size = 0;
+			m_BindingPoint = _BindingPoint;
+
+			const Uint32 ProgramID = _Shader.GetProgramID();
+			if( ProgramID == 0 )
+				return False;
+
+			const GLuint BlockIndex = glGetUniformBlockIndex( ProgramID, _BlockName.c_str() );
+			AE_ErrorCheckOpenGLError();
+
+			if( BlockIndex == GL_INVALID_INDEX )
+				return False;
+
+			GLint BlockSize = 0;
+			glGetActiveUniformBlockiv( ProgramID, BlockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &BlockSize );
+			AE_ErrorCheckOpenGLError();
+
+			GLint MembersCount = 0;
+			glGetActiveUniformBlockiv( ProgramID, BlockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &MembersCount );
+			AE_ErrorCheckOpenGLError();
+
+			if( BlockSize <= 0 || MembersCount <= 0 )
+				return False;
+
+			std::vector<GLint> Indices( MembersCount );
+			glGetActiveUniformBlockiv( ProgramID, BlockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, Indices.data() );
+			AE_ErrorCheckOpenGLError();
+
+			const std::vector<GLuint> UniformIndices( Indices.begin(), Indices.end() );
+			std::vector<GLint> Offsets( MembersCount );
+			std::vector<GLint> Types( MembersCount );
+			std::vector<GLint> MatrixStrides( MembersCount );
+
+			glGetActiveUniformsiv( ProgramID, MembersCount, UniformIndices.data(), GL_UNIFORM_OFFSET, Offsets.data() );
+			AE_ErrorCheckOpenGLError();
+			glGetActiveUniformsiv( ProgramID, MembersCount, UniformIndices.data(), GL_UNIFORM_TYPE, Types.data() );
+			AE_ErrorCheckOpenGLError();
+			glGetActiveUniformsiv( ProgramID, MembersCount, UniformIndices.data(), GL_UNIFORM_MATRIX_STRIDE, MatrixStrides.data() );
+			AE_ErrorCheckOpenGLError();
+
+			GLint MaxNameLength = 0;
+			glGetProgramiv( ProgramID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &MaxNameLength );
+			AE_ErrorCheckOpenGLError();
+
+			std::vector<char> NameBuffer( Cast( size_t, Math::Max( MaxNameLength, 1 ) ) );
+
+			// Members sorted by offset to build the key.
+			std::vector<std::pair<Uint32, std::string>> SortedMembers;
+			SortedMembers.reserve( MembersCount );
+
+			// Members of a block with an instance name are prefixed by the block name.
+			const std::string BlockPrefix = _BlockName + ".";
+
+			for( GLint m = 0; m < MembersCount; m++ )
+			{
+				GLsizei NameLength = 0;
+				glGetActiveUniformName( ProgramID, UniformIndices[m], Cast( GLsizei, NameBuffer.size() ), &NameLength, NameBuffer.data() );
+				AE_ErrorCheckOpenGLError();
+
+				std::string Name( NameBuffer.data(), NameLength );
+				if( Name.compare( 0, BlockPrefix.size(), BlockPrefix ) == 0 )
+					Name.erase( 0, BlockPrefix.size() );
+
+				Member NewMember;
+				NewMember.Offset = Cast( Uint32, Offsets[m] );
+				NewMember.Type = Cast( Uint32, Types[m] );
+				NewMember.MatrixStride = Cast( Uint32, MatrixStrides[m] );
+
+				SortedMembers.emplace_back( NewMember.Offset, Name + ":" + std::to_string( NewMember.Type ) );
+				m_Members.emplace( std::move( Name ), NewMember );
+			}
+
+			std::sort( SortedMembers.begin(), SortedMembers.end() );
+
+			m_Size = Cast( Uint32, BlockSize );
+			m_Key = std::to_string( m_Size );
+			for( const std::pair<Uint32, std::string>& SortedMember : SortedMembers )
+				m_Key += ";" + std::to_string( SortedMember.first ) + ":" + SortedMember.second;
+
+			glUniformBlockBinding( ProgramID, BlockIndex, _BindingPoint );
+			AE_ErrorCheckOpenGLError();
+
+			return True;
+		}
+
+		Bool UniformBlockLayout::IsValid() const
+		{
+			return m_Size > 0;
+		}
+
+		Uint32 UniformBlockLayout::GetSize() const
+		{
+			return m_Size;
+		}
+
+		Uint32 UniformBlockLayout::GetBindingPoint() const
+		{
+			return m_BindingPoint;
+		}
+
+		const std::string& UniformBlockLayout::GetKey() const
+		{
+			return m_Key;
+		}
+
+		const UniformBlockLayout::Member* UniformBlockLayout::FindMember( const std::string& _Name ) const
+		{
+			std::unordered_map<std::string, Member>::const_iterator ItMember = m_Members.find( _Name );
+
+			return ItMember == m_Members.cend() ? nullptr : &ItMember->second;
+		}
+
+		Bool UniformBlockLayout::Write( AE_Out Uint8* _Data, const std::string& _Name, float _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			std::memcpy( _Data + BlockMember->Offset, &_Value, sizeof( float ) );
+			return True;
+		}
+
+		Bool UniformBlockLayout::Write( AE_Out Uint8* _Data, const std::string& _Name, Int32 _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			std::memcpy( _Data + BlockMember->Offset, &_Value, sizeof( Int32 ) );
+			return True;
+		}
+
+		Bool UniformBlockLayout::WriteBool( AE_Out Uint8* _Data, const std::string& _Name, Bool _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			// Booleans take 4 bytes in a block.
+			const Uint32 Value = _Value ? 1 : 0;
+			std::memcpy( _Data + BlockMember->Offset, &Value, sizeof( Uint32 ) );
+			return True;
+		}
+
+		Bool UniformBlockLayout::Write( AE_Out Uint8* _Data, const std::string& _Name, const Vector2& _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			const float Values[2] = { _Value.X, _Value.Y };
+			std::memcpy( _Data + BlockMember->Offset, Values, sizeof( Values ) );
+			return True;
+		}
+
+		Bool UniformBlockLayout::Write( AE_Out Uint8* _Data, const std::string& _Name, const Vector3& _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			const float Values[3] = { _Value.X, _Value.Y, _Value.Z };
+			std::memcpy( _Data + BlockMember->Offset, Values, sizeof( Values ) );
+			return True;
+		}
+
+		Bool UniformBlockLayout::Write( AE_Out Uint8* _Data, const std::string& _Name, const Color& _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			const float Values[4] = { _Value.R(), _Value.G(), _Value.B(), _Value.A() };
+			std::memcpy( _Data + BlockMember->Offset, Values, sizeof( Values ) );
+			return True;
+		}
+
+		Bool UniformBlockLayout::Write( AE_Out Uint8* _Data, const std::string& _Name, const Matrix3x3& _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			WriteMatrix( _Data, *BlockMember, _Value.GetData(), 3 );
+			return True;
+		}
+
+		Bool UniformBlockLayout::Write( AE_Out Uint8* _Data, const std::string& _Name, const Matrix4x4& _Value ) const
+		{
+			const Member* BlockMember = FindMember( _Name );
+			if( BlockMember == nullptr )
+				return False;
+
+			WriteMatrix( _Data, *BlockMember, _Value.GetData(), 4 );
+			return True;
+		}
+
+		void UniformBlockLayout::WriteMatrix( AE_Out Uint8* _Data, const Member& _Member, const float* _Values, Uint32 _Size ) const
+		{
+			// Same as glUniformMatrix without transposition : each group of _Size floats is a column of the GLSL matrix.
+			// In a block, columns are MatrixStride bytes apart (16 bytes for std140, even for a mat3).
+			const Uint32 Stride = _Member.MatrixStride > 0 ? _Member.MatrixStride : Cast( Uint32, _Size * sizeof( float ) );
+
+			for( Uint32 c = 0; c < _Size; c++ )
+				std::memcpy( _Data + _Member.Offset + c * Stride, _Values + c * _Size, _Size * sizeof( float ) );
+		}
+
+	} // priv
+
+} // ae
@@ -0,0 +1,170 @@
+#ifndef _UNIFORMBLOCKLAYOUT_AERO_H_
+#define _UNIFORMBLOCKLAYOUT_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+
+#include <unordered_map>
+#include <string>
+
+namespace ae
+{
+	class Shader;
+	class Color;
+	class Vector2;
+	class Vector3;
+	class Matrix3x3;
+	class Matrix4x4;
+
+	namespace priv
+	{
+		/// \ingroup graphics
+		/// <summary>
+		/// Memory layout of a uniform block of a shader program, read from the program reflection.<para/>
+		/// Give the offset of each member of the block so parameters can be packed in a CPU buffer
+		/// and uploaded in one go to a uniform buffer.
+		/// </summary>
+		/// <seealso cref="UniformBlockPool" />
+		/// <seealso cref="Material" />
+		class AERO_CORE_EXPORT UniformBlockLayout
+		{
+		public:
+			/// <summary>Name of the block used by the materials to store their parameters.</summary>
+			static const std::string MaterialBlockName;
+
+			/// <summary>Binding point of the materials block. The point 4 is used by the snow parameters.</summary>
+			static constexpr Uint32 MaterialBindingPoint = 5;
+
+			/// <summary>Location of a member in the block.</summary>
+			struct Member
+			{
+				/// <summary>Offset in bytes of the member from the start of the block.</summary>
+				Uint32 Offset;
+
+				/// <summary>OpenGL type of the member (GL_FLOAT, GL_FLOAT_VEC3, ...).</summary>
+				Uint32 Type;
+
+				/// <summary>Offset in bytes between two columns of a matrix member. 0 for non matrix members.</summary>
+				Uint32 MatrixStride;
+			};
+
+		public:
+			/// <summary>Create an empty (invalid) layout.</summary>
+			UniformBlockLayout();
+
+			/// <summary>
+			/// Read the layout of a block from a shader program and assign the block to <paramref name="_BindingPoint"/>.<para/>
+			/// The shader must be linked.
+			/// </summary>
+			/// <param name="_Shader">Shader to read the block from.</param>
+			/// <param name="_BlockName">Name of the block in the shader.</param>
+			/// <param name="_BindingPoint">Binding point to assign to the block.</param>
+			/// <returns>True if the block exists in the shader, False otherwise.</returns>
+			Bool LoadFromShader( const Shader& _Shader, const std::string& _BlockName, Uint32 _BindingPoint );
+
+			/// <summary>Is the layout read from a shader block ?</summary>
+			/// <returns>True if the layout is valid, False otherwise.</returns>
+			Bool IsValid() const;
+
+			/// <summary>Retrieve the size in bytes of the block.</summary>
+			/// <returns>Size of the block.</returns>
+			Uint32 GetSize() const;
+
+			/// <summary>Retrieve the binding point of the block.</summary>
+			/// <returns>Binding point of the block.</returns>
+			Uint32 GetBindingPoint() const;
+
+			/// <summary>
+			/// Retrieve the key identifying the layout.<para/>
+			/// Two blocks with the same members at the same offsets have the same key and can share their buffers.
+			/// </summary>
+			/// <returns>Key of the layout.</returns>
+			const std::string& GetKey() const;
+
+			/// <summary>Retrieve a member of the block.</summary>
+			/// <param name="_Name">Name of the member.</param>
+			/// <returns>The member if it exists in the block, nullptr otherwise.</returns>
+			const Member* FindMember( const std::string& _Name ) const;
+
+			/// <summary>Write a float member.</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool Write( AE_Out Uint8* _Data, const std::string& _Name, float _Value ) const;
+
+			/// <summary>Write an integer member.</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool Write( AE_Out Uint8* _Data, const std::string& _Name, Int32 _Value ) const;
+
+			/// <summary>Write a boolean member (4 bytes in a block).</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool WriteBool( AE_Out Uint8* _Data, const std::string& _Name, Bool _Value ) const;
+
+			/// <summary>Write a 2D vector member.</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool Write( AE_Out Uint8* _Data, const std::string& _Name, const Vector2& _Value ) const;
+
+			/// <summary>Write a 3D vector member.</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool Write( AE_Out Uint8* _Data, const std::string& _Name, const Vector3& _Value ) const;
+
+			/// <summary>Write a color member (vec4).</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool Write( AE_Out Uint8* _Data, const std::string& _Name, const Color& _Value ) const;
+
+			/// <summary>Write a 3x3 matrix member. Laid out like Shader::SetMatrix3x3 without transposition.</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool Write( AE_Out Uint8* _Data, const std::string& _Name, const Matrix3x3& _Value ) const;
+
+			/// <summary>Write a 4x4 matrix member. Laid out like Shader::SetMatrix4x4 without transposition.</summary>
+			/// <param name="_Data">Block data to write to. Must be at least GetSize() bytes.</param>
+			/// <param name="_Name">Name of the member.</param>
+			/// <param name="_Value">Value to write.</param>
+			/// <returns>True if the member exists in the block, False otherwise.</returns>
+			Bool Write( AE_Out Uint8* _Data, const std::string& _Name, const Matrix4x4& _Value ) const;
+
+		private:
+			/// <summary>Write the columns of a matrix member.</summary>
+			/// <param name="_Data">Block data to write to.</param>
+			/// <param name="_Member">Matrix member.</param>
+			/// <param name="_Values">Matrix values, one column after another.</param>
+			/// <param name="_Size">Count of columns and rows of the matrix.</param>
+			void WriteMatrix( AE_Out Uint8* _Data, const Member& _Member, const float* _Values, Uint32 _Size ) const;
+
+		private:
+			/// <summary>Members of the block by name.</summary>
+			std::unordered_map<std::string, Member> m_Members;
+
+			/// <summary>Size in bytes of the block.</summary>
+			Uint32 m_Size;
+
+			/// <summary>Binding point of the block.</summary>
+			Uint32 m_BindingPoint;
+
+			/// <summary>Members names, offsets and types, sorted by offset.</summary>
+			std::string m_Key;
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _UNIFORMBLOCKLAYOUT_AERO_H_
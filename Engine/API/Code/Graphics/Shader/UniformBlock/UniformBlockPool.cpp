@@ -0,0 +1,113 @@
+#include "UniformBlockPool.h"
+
+#include "../../Dependencies/OpenGL.h"
+#include "../../../Debugging/Debugging.h"
+
+namespace ae
+{
+	namespace priv
+	{
+		UniformBlockPool::UniformBlockPool( const UniformBlockLayout& _Layout ) :
+			m_Layout( _Layout ),
+			m_SlotSize( 0 ),
+			m_UsedSlotsCount( 0 )
+		{
+			// Ranges bound to a binding point must start on this alignment.
+			GLint Alignment = 256;
+			glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &Alignment );
+			AE_ErrorCheckOpenGLError();
+
+			const Uint32 Align = Alignment > 0 ? Cast( Uint32, Alignment ) : 256;
+			m_SlotSize = ( ( m_Layout.GetSize() + Align - 1 ) / Align ) * Align;
+		}
+
+		UniformBlockPool::~UniformBlockPool()
+		{
+			if( m_BufferIDs.empty() )
+				return;
+
+			glDeleteBuffers( Cast( GLsizei, m_BufferIDs.size() ), m_BufferIDs.data() );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		const UniformBlockLayout& UniformBlockPool::GetLayout() const
+		{
+			return m_Layout;
+		}
+
+		Uint32 UniformBlockPool::Allocate()
+		{
+			if( m_FreeSlots.empty() )
+			{
+				// All the buffers are full, create a new one.
+				Uint32 NewBufferID = 0;
+				glGenBuffers( 1, &NewBufferID );
+				AE_ErrorCheckOpenGLError();
+
+				glBindBuffer( GL_UNIFORM_BUFFER, NewBufferID );
+				AE_ErrorCheckOpenGLError();
+
+				glBufferData( GL_UNIFORM_BUFFER, m_SlotSize * SlotsPerBuffer, nullptr, GL_DYNAMIC_DRAW );
+				AE_ErrorCheckOpenGLError();
+
+				glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+				AE_ErrorCheckOpenGLError();
+
+				const Uint32 FirstSlot = Cast( Uint32, m_BufferIDs.size() ) * SlotsPerBuffer;
+				m_BufferIDs.push_back( NewBufferID );
+
+				// Push in reverse order so the first slots are taken first.
+				for( Uint32 s = SlotsPerBuffer; s > 0; s-- )
+					m_FreeSlots.push_back( FirstSlot + s - 1 );
+			}
+
+			const Uint32 Slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			m_UsedSlotsCount++;
+
+			return Slot;
+		}
+
+		void UniformBlockPool::Free( Uint32 _Slot )
+		{
+			if( _Slot == InvalidSlot || _Slot / SlotsPerBuffer >= m_BufferIDs.size() )
+			{
+				AE_LogWarning( "Trying to free an invalid slot of a uniform block pool." );
+				return;
+			}
+
+			m_FreeSlots.push_back( _Slot );
+			m_UsedSlotsCount--;
+		}
+
+		void UniformBlockPool::Upload( Uint32 _Slot, const Uint8* _Data )
+		{
+			glBindBuffer( GL_UNIFORM_BUFFER, m_BufferIDs[_Slot / SlotsPerBuffer] );
+			AE_ErrorCheckOpenGLError();
+
+			glBufferSubData( GL_UNIFORM_BUFFER, ( _Slot % SlotsPerBuffer ) * m_SlotSize, m_Layout.GetSize(), _Data );
+			AE_ErrorCheckOpenGLError();
+
+			glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		void UniformBlockPool::Bind( Uint32 _Slot ) const
+		{
+			glBindBufferRange( GL_UNIFORM_BUFFER, m_Layout.GetBindingPoint(), m_BufferIDs[_Slot / SlotsPerBuffer], ( _Slot % SlotsPerBuffer ) * m_SlotSize, m_Layout.GetSize() );
+			AE_ErrorCheckOpenGLError();
+		}
+
+		Uint32 UniformBlockPool::GetUsedSlotsCount() const
+		{
+			return m_UsedSlotsCount;
+		}
+
+		Uint32 UniformBlockPool::GetBuffersCount() const
+		{
+			return Cast( Uint32, m_BufferIDs.size() );
+		}
+
+	} // priv
+
+} // ae
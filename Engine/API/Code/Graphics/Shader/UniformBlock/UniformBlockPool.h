@@ -0,0 +1,89 @@
+#ifndef _UNIFORMBLOCKPOOL_AERO_H_
+#define _UNIFORMBLOCKPOOL_AERO_H_
+
+#include "../../../Toolbox/Toolbox.h"
+#include "../../../Idioms/NotCopiable/NotCopiable.h"
+#include "UniformBlockLayout.h"
+
+#include <vector>
+
+namespace ae
+{
+	namespace priv
+	{
+		/// \ingroup graphics
+		/// <summary>
+		/// Uniform buffers shared by all the blocks with the same layout.<para/>
+		/// Each user (material) takes a slot in the pool, the slots are packed in pages of big uniform buffers
+		/// and bound with a range, so switching between two materials is a single buffer bind.
+		/// </summary>
+		/// <seealso cref="UniformBlockLayout" />
+		/// <seealso cref="Material" />
+		class AERO_CORE_EXPORT UniformBlockPool : public NotCopiable
+		{
+		public:
+			/// <summary>Count of slots stored in one uniform buffer.</summary>
+			static constexpr Uint32 SlotsPerBuffer = 64;
+
+			/// <summary>Value of an invalid slot.</summary>
+			static constexpr Uint32 InvalidSlot = 0xFFFFFFFF;
+
+		public:
+			/// <summary>Create a pool for a block layout. Buffers are created when slots are taken.</summary>
+			/// <param name="_Layout">Layout of the blocks stored in the pool.</param>
+			UniformBlockPool( const UniformBlockLayout& _Layout );
+
+			/// <summary>Free the uniform buffers.</summary>
+			~UniformBlockPool();
+
+			/// <summary>Retrieve the layout of the blocks stored in the pool.</summary>
+			/// <returns>Layout of the blocks.</returns>
+			const UniformBlockLayout& GetLayout() const;
+
+			/// <summary>Take a free slot in the pool. Create a new uniform buffer if all are full.</summary>
+			/// <returns>The slot taken.</returns>
+			Uint32 Allocate();
+
+			/// <summary>Give back a slot to the pool.</summary>
+			/// <param name="_Slot">Slot to free.</param>
+			void Free( Uint32 _Slot );
+
+			/// <summary>Upload the data of a block in its slot.</summary>
+			/// <param name="_Slot">Slot to update.</param>
+			/// <param name="_Data">Block data, must be the size of the layout.</param>
+			void Upload( Uint32 _Slot, const Uint8* _Data );
+
+			/// <summary>Bind a slot to the binding point of the layout.</summary>
+			/// <param name="_Slot">Slot to bind.</param>
+			void Bind( Uint32 _Slot ) const;
+
+			/// <summary>Retrieve the count of slots in use.</summary>
+			/// <returns>Count of slots in use.</returns>
+			Uint32 GetUsedSlotsCount() const;
+
+			/// <summary>Retrieve the count of uniform buffers created by the pool.</summary>
+			/// <returns>Count of uniform buffers.</returns>
+			Uint32 GetBuffersCount() const;
+
+		private:
+			/// <summary>Layout of the blocks.</summary>
+			UniformBlockLayout m_Layout;
+
+			/// <summary>Size of a slot in bytes : the block size aligned on the uniform buffer offset alignment.</summary>
+			Uint32 m_SlotSize;
+
+			/// <summary>Uniform buffers, each holds SlotsPerBuffer slots.</summary>
+			std::vector<Uint32> m_BufferIDs;
+
+			/// <summary>Slots available for allocation.</summary>
+			std::vector<Uint32> m_FreeSlots;
+
+			/// <summary>Count of slots in use.</summary>
+			Uint32 m_UsedSlotsCount;
+		};
+
+	} // priv
+
+} // ae
+
+#endif // _UNIFORMBLOCKPOOL_AERO_H_
@@ -4,6 +4,7 @@
 #include "../Drawable/Drawable.h"
 #include "../../Debugging/Debugging.h"
 #include "../../Aero/Aero.h"
+#include "../../Toolbox/FrameAllocator/FrameAllocator.h"
 
 #include "../../Editor/TypesToEditor/ShadowMapToEditor.h"
 
@@ -36,6 +37,7 @@ namespace ae
 
 
 		SetName( std::string( "ShadowMap_" ) + std::to_string( GetResourceID() ) );
+		SetPassName( GetName() );
 	}
 
 	void ShadowMap::Bind()
@@ -58,6 +60,15 @@ namespace ae
 		if( !_Object.IsEnabled() )
 			return;
 
+		// The shadow map shaders read the model matrix from a uniform.
+		if( _Object.IsInstanced() )
+		{
+			if( m_SkippedInstanced.insert( _Object.GetObjectID() ).second )
+				AE_LogWarning( "Instanced drawable \"" + _Object.GetName() + "\" cannot be drawn in a shadow map. Object will not be drawn." );
+
+			return;
+		}
+
 		if( !CheckCountPrimitive( _Object.GetIndicesCount(), _Object.GetPrimitiveType() ) )
 		{
 			AE_LogWarning( "Count of indices do not fit with the primitive. Object will not be drawn." );
@@ -310,8 +321,16 @@ namespace ae
 	{
 		// Send light matrices.
 		const std::string& ViewName = Material::GetDefaultParameterName( Material::DefaultParameters::ShadowMap_ViewMatrix );
+		FrameString IndexedViewName( ViewName.c_str(), ViewName.size() );
+		IndexedViewName.append( "[0]" );
+
+		const size_t IndexPosition = ViewName.size() + 1;
+
 		for( Uint32 s = 0; s < 6; s++ )
-			m_ShaderRef->SetMatrix4x4( m_ShaderRef->GetUniformLocation( ViewName + '[' + std::to_string( s ) + ']' ), m_ViewMatrix[s] );
+		{
+			IndexedViewName[IndexPosition] = Cast( char, '0' + s );
+			m_ShaderRef->SetMatrix4x4( m_ShaderRef->GetUniformLocation( IndexedViewName.c_str() ), m_ViewMatrix[s] );
+		}
 
 		// Far distance.
 		const std::string& FarName = Material::GetDefaultParameterName( Material::DefaultParameters::ShadowMap_Far );
@@ -8,6 +8,7 @@
 #include "../../Resources/Resource/Resource.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <stack>
 
@@ -196,5 +197,8 @@ namespace ae
 
 		/// <summary>Is the shadow is omnidirectional ? (Point light / cube map)</summary>
 		Bool m_IsOmnidirectional;
+
+		/// <summary>Instanced drawables already skipped : the warning is logged once per drawable, not every frame.</summary>
+		std::unordered_set<World::ObjectID> m_SkippedInstanced;
 	};
 } // ae
@@ -3,32 +3,55 @@
 #include "../Framebuffer/Attachement/FramebufferAttachement.h"
 #include "../Image/Image.h"
 #include "../Image/ImageHDR.h"
+#include "../Image/DecodedImage.h"
+#include "../../Aero/Aero.h"
 #include "../../Debugging/Debugging.h"
 #include "../Dependencies/OpenGL.h"
 #include "../../Editor/TypesToEditor/TextureToEditor.h"
 
 namespace ae
 {
-	TextureImage::TextureImage( const std::string& _FilePath, const IntRect& _SubRect )
+	TextureImage::TextureImage() :
+		m_LoadRequest( AsyncLoader::InvalidRequestID ),
+		m_LoadingState( LoadingState::Ready )
+	{
+		SetPlaceholder();
+		SetName( std::string( "TextureImage_" ) + std::to_string( GetResourceID() ) );
+	}
+
+	TextureImage::TextureImage( const std::string& _FilePath, const IntRect& _SubRect ) :
+		m_LoadRequest( AsyncLoader::InvalidRequestID ),
+		m_LoadingState( LoadingState::Ready )
 	{
 		Set( _FilePath, _SubRect );
 		SetName( std::string( "TextureImage_" ) + std::to_string( GetResourceID() ) );
 	}
 
-	TextureImage::TextureImage( const Image& _ImageSource, const IntRect& _SubRect )
+	TextureImage::TextureImage( const Image& _ImageSource, const IntRect& _SubRect ) :
+		m_LoadRequest( AsyncLoader::InvalidRequestID ),
+		m_LoadingState( LoadingState::Ready )
 	{
 		Set( _ImageSource, _SubRect );
 		SetName( std::string( "TextureImage_" ) + std::to_string( GetResourceID() ) );
 	}
 
-	TextureImage::TextureImage( const ImageHDR& _ImageSource, const IntRect& _SubRect )
+	TextureImage::TextureImage( const ImageHDR& _ImageSource, const IntRect& _SubRect ) :
+		m_LoadRequest( AsyncLoader::InvalidRequestID ),
+		m_LoadingState( LoadingState::Ready )
 	{
 		Set( _ImageSource, _SubRect );
 		SetName( std::string( "TextureImage_" ) + std::to_string( GetResourceID() ) );
 	}
 
+	TextureImage::~TextureImage()
+	{
+		CancelAsyncLoading();
+	}
+
 	void TextureImage::Set( const std::string& _FilePath, const IntRect& _SubRect )
 	{
+		CancelAsyncLoading();
+
 		const Image ImageSource( _FilePath );
 
 		m_Dimension = TextureDimension::Texture2D;
@@ -41,6 +64,8 @@ namespace ae
 
 	void TextureImage::Set( const Image& _ImageSource, const IntRect& _SubRect )
 	{
+		CancelAsyncLoading();
+
 		m_Dimension = TextureDimension::Texture2D;
 		m_Width = _ImageSource.GetWidth();
 		m_Height = _ImageSource.GetHeight();
@@ -51,6 +76,8 @@ namespace ae
 
 	void TextureImage::Set( const ImageHDR& _ImageSource, const IntRect& _SubRect )
 	{
+		CancelAsyncLoading();
+
 		m_Dimension = TextureDimension::Texture2D;
 		m_Width = _ImageSource.GetWidth();
 		m_Height = _ImageSource.GetHeight();
@@ -59,6 +86,47 @@ namespace ae
 		UpdateDataFromImage( _ImageSource, _SubRect );
 	}
 
+	void TextureImage::SetAsync( const std::string& _FilePath, Bool _IsHDR, const IntRect& _SubRect )
+	{
+		CancelAsyncLoading();
+
+		// The texture can be bound while the image is loading.
+		SetPlaceholder();
+
+		m_FilePath = _FilePath;
+		m_LoadingState = LoadingState::Pending;
+
+		// The decoded pixels are owned by the request, the texture is only touched by the upload on the context thread.
+		std::shared_ptr<priv::DecodedImage> Decoded = std::make_shared<priv::DecodedImage>();
+
+		m_LoadRequest = Aero.GetAsyncLoader().Load(
+			[Decoded, _FilePath, _IsHDR]()
+			{
+				Decoded->LoadFromFile( _FilePath, _IsHDR );
+			},
+			[this, Decoded, _SubRect]()
+			{
+				m_LoadRequest = AsyncLoader::InvalidRequestID;
+
+				if( Decoded->GetData() == nullptr )
+				{
+					AE_LogError( Decoded->GetError() );
+					m_LoadingState = LoadingState::Failed;
+					return;
+				}
+
+				m_Format = Decoded->GetTexturePixelFormat();
+				UpdateDataFromPixels( Decoded->GetData(), Decoded->GetWidth(), Decoded->GetHeight(), _SubRect );
+
+				m_LoadingState = LoadingState::Ready;
+			} );
+	}
+
+	LoadingState TextureImage::GetLoadingState() const
+	{
+		return m_LoadingState;
+	}
+
 	const std::string& TextureImage::GetFilePath() const
 	{
 		return m_FilePath;
@@ -84,12 +152,22 @@ namespace ae
 	}
 
 	void TextureImage::UpdateDataFromImage( const Image& _ImageSource, const IntRect& _SubRect )
+	{
+		UpdateDataFromPixels( _ImageSource.GetData(), _ImageSource.GetWidth(), _ImageSource.GetHeight(), _SubRect );
+	}
+
+	void TextureImage::UpdateDataFromImage( const ImageHDR& _ImageSource, const IntRect& _SubRect )
+	{
+		UpdateDataFromPixels( _ImageSource.GetData(), _ImageSource.GetWidth(), _ImageSource.GetHeight(), _SubRect );
+	}
+
+	void TextureImage::UpdateDataFromPixels( const void* _Pixels, Uint32 _Width, Uint32 _Height, const IntRect& _SubRect )
 	{
 		// If the rect is not user defined, chose the image size.
 		if( _SubRect.Left == 0 && _SubRect.Right == 0 && _SubRect.Top == 0 && _SubRect.Bottom == 0 )
 		{
-			m_Width = _ImageSource.GetWidth();
-			m_Height = _ImageSource.GetHeight();
+			m_Width = _Width;
+			m_Height = _Height;
 		}
 		else
 		{
@@ -102,35 +180,30 @@ namespace ae
 		Bind();
 
 		// Send to OpenGL the part of the image we want.
-		glTexSubImage2D( GL_TEXTURE_2D, 0, _SubRect.Left, _SubRect.Top, m_Width, m_Height, ToGLFormat( m_Format ), ToGLType( m_Format ), _ImageSource.GetData() );
+		glTexSubImage2D( GL_TEXTURE_2D, 0, _SubRect.Left, _SubRect.Top, m_Width, m_Height, ToGLFormat( m_Format ), ToGLType( m_Format ), _Pixels );
 		AE_ErrorCheckOpenGLError();
 
 		Unbind();
 	}
 
-	void TextureImage::UpdateDataFromImage( const ImageHDR& _ImageSource, const IntRect& _SubRect )
+	void TextureImage::SetPlaceholder()
 	{
-		// If the rect is not user defined, chose the image size.
-		if( _SubRect.Left == 0 && _SubRect.Right == 0 && _SubRect.Top == 0 && _SubRect.Bottom == 0 )
-		{
-			m_Width = _ImageSource.GetWidth();
-			m_Height = _ImageSource.GetHeight();
-		}
-		else
-		{
-			m_Width = Math::Abs( _SubRect.Right - _SubRect.Left );
-			m_Height = Math::Abs( _SubRect.Bottom - _SubRect.Top );
-		}
+		const Uint8 WhitePixel[4] = { 255, 255, 255, 255 };
 
-		Texture2D::SetupEmpty();
+		m_Dimension = TextureDimension::Texture2D;
+		m_Format = TexturePixelFormat::RGBA_U8;
 
-		Bind();
+		UpdateDataFromPixels( WhitePixel, 1, 1, IntRect() );
+	}
 
-		// Send to OpenGL the part of the image we want.
-		glTexSubImage2D( GL_TEXTURE_2D, 0, _SubRect.Left, _SubRect.Top, m_Width, m_Height, ToGLFormat( m_Format ), ToGLType( m_Format ), _ImageSource.GetData() );
-		AE_ErrorCheckOpenGLError();
+	void TextureImage::CancelAsyncLoading()
+	{
+		if( m_LoadRequest == AsyncLoader::InvalidRequestID )
+			return;
 
-		Unbind();
+		Aero.GetAsyncLoader().Cancel( m_LoadRequest );
+		m_LoadRequest = AsyncLoader::InvalidRequestID;
+		m_LoadingState = LoadingState::Ready;
 	}
 
 } // ae
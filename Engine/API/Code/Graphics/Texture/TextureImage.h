@@ -3,6 +3,7 @@
 #include "../../Toolbox/Toolbox.h"
 #include "Texture2D.h"
 #include "../../Maths/Primitives/TRect.h"
+#include "../../Resources/AsyncLoader/AsyncLoader.h"
 
 namespace ae
 {
@@ -17,6 +18,9 @@ namespace ae
 	class AERO_CORE_EXPORT TextureImage : public Texture2D
 	{
 	public:
+		/// <summary>Create a texture made of one white pixel, to fill later with Set or SetAsync.</summary>
+		TextureImage();
+
 		/// <summary>Create a texture from a image file.</summary>
 		/// <param name="_FilePath">The image file path.</param>
 		/// <param name="_SubRect">The area if you want to select only a part of the image.</param>
@@ -32,6 +36,9 @@ namespace ae
 		/// <param name="_SubRect">The area if you want to select only a part of the image.</param>
 		TextureImage( const ImageHDR& _ImageSource, const IntRect& _SubRect = IntRect() );
 
+		/// <summary>Cancel the background loading if the texture is still waiting for it.</summary>
+		virtual ~TextureImage();
+
 
 		/// <summary>Create a texture from an image.</summary>
 		/// <param name="_FilePath">The path to the image file to load.</param>
@@ -48,6 +55,19 @@ namespace ae
 		/// <param name="_SubRect">The area if you want to select only a part of the image.</param>
 		void Set( const ImageHDR& _ImageSource, const IntRect& _SubRect = IntRect() );
 
+		/// <summary>
+		/// Load the texture from an image file in the background.<para/>
+		/// The texture is a white pixel until the image is decoded by the asynchronous loader and uploaded.
+		/// </summary>
+		/// <param name="_FilePath">The path to the image file to load.</param>
+		/// <param name="_IsHDR">Load the file as an HDR image ?</param>
+		/// <param name="_SubRect">The area if you want to select only a part of the image.</param>
+		void SetAsync( const std::string& _FilePath, Bool _IsHDR = False, const IntRect& _SubRect = IntRect() );
+
+		/// <summary>Retrieve the state of the loading started by SetAsync.</summary>
+		/// <returns>Ready if the texture is not loaded in the background.</returns>
+		LoadingState GetLoadingState() const;
+
 		/// <summary>
 		/// Path to the loaded image.<para/>
 		/// Can be empty if image created from memory.
@@ -84,6 +104,19 @@ namespace ae
 		/// <param name="_SubRect">The area to select in the image.</param>
 		void UpdateDataFromImage( const ImageHDR& _ImageSource, const IntRect& _SubRect );
 
+		/// <summary>Update the OpenGL texture data from raw pixels, <c>m_Format</c> must already match them.</summary>
+		/// <param name="_Pixels">Pixels of the image.</param>
+		/// <param name="_Width">Width of the image.</param>
+		/// <param name="_Height">Height of the image.</param>
+		/// <param name="_SubRect">The area to select in the image.</param>
+		void UpdateDataFromPixels( const void* _Pixels, Uint32 _Width, Uint32 _Height, const IntRect& _SubRect );
+
+		/// <summary>Make the texture one white pixel.</summary>
+		void SetPlaceholder();
+
+		/// <summary>Cancel the background loading if any.</summary>
+		void CancelAsyncLoading();
+
 
 	protected:
 		/// <summary>
@@ -91,6 +124,13 @@ namespace ae
 		/// Can be a path to an image into the resource manager.
 		/// </summary>
 		std::string m_FilePath;
+
+	private:
+		/// <summary>Request of the background loading, invalid if the texture is not waiting for one.</summary>
+		AsyncLoader::RequestID m_LoadRequest;
+
+		/// <summary>State of the background loading.</summary>
+		LoadingState m_LoadingState;
 	};
 
 } // ae
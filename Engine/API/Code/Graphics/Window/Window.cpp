@@ -56,6 +56,7 @@ namespace ae
 		glfwWindowHint( GLFW_CONTEXT_VERSION_MAJOR, 4 );
 		glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 5 );
 		glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
+		glfwWindowHint( GLFW_OPENGL_DEBUG_CONTEXT, m_WindowUserInfo.ErrorCheck == OpenGLErrorCheck::DebugCallback ? GLFW_TRUE : GLFW_FALSE );
 
 		m_GLFWWindow = glfwCreateWindow( Cast( int, m_WindowUserInfo.Width ),
 										 Cast( int, m_WindowUserInfo.Height ),
@@ -92,6 +93,8 @@ namespace ae
 		glewExperimental = GL_TRUE;
 		glewInit();
 
+		priv::Error::SetOpenGLErrorCheck( m_WindowUserInfo.ErrorCheck );
+
 		// After opengl and glew init, create our rendering target.
 		InitializeRendering();
 
@@ -237,6 +240,19 @@ namespace ae
 		glfwSwapInterval( _ActivateVSync ? 1 : 0 );
 	}
 
+	OpenGLErrorCheck Window::GetOpenGLErrorCheck() const
+	{
+		return m_WindowUserInfo.ErrorCheck;
+	}
+
+	void Window::SetOpenGLErrorCheck( OpenGLErrorCheck _Check )
+	{
+		m_WindowUserInfo.ErrorCheck = _Check;
+
+		if( m_IsOpen && m_Context.MakeCurrent() )
+			priv::Error::SetOpenGLErrorCheck( _Check );
+	}
+
 	void Window::OnKeyEvent( GLFWwindow*, Int32, Int32 _ScanCodes, Int32 _Action, Int32 )
 	{
 		Int32 WinKey = priv::Input::GLFWScanCodeToPlatformKey( _ScanCodes );
@@ -351,6 +367,8 @@ namespace ae
 	{
 		Renderer::Render();
 
+		AE_ErrorCheckOpenGLCheckpoint( "frame" );
+
 		// Update frame time before swapping to avoid VSync.
 		UpdateFrameTime();
 
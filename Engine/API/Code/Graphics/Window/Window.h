@@ -10,6 +10,8 @@
 #include "../../Maths/Primitives/TRect.h"
 #include "../../Maths/Vector/Vector2.h"
 
+#include "../../Debugging/Error/Error.h"
+
 
 #include <string>
 #include <memory>
@@ -63,7 +65,8 @@ namespace ae
             AntiAliasing( 0 ),
             FrameRate( 60 ),
             VSync( True ),
-            IsDPIAware( True )
+            IsDPIAware( True ),
+            ErrorCheck( DefaultOpenGLErrorCheck )
         {
         }
 
@@ -97,6 +100,9 @@ namespace ae
 
         /// <summary>Window and UI must be scaled according to the monitor DPI ?</summary>
         Bool IsDPIAware;
+
+        /// <summary>How the OpenGL errors are checked. With DebugCallback, a debug context is created for the detailed messages of the driver.</summary>
+        OpenGLErrorCheck ErrorCheck;
     };
 
     /// \ingroup graphics
@@ -287,6 +293,17 @@ namespace ae
         /// <summary>Should the framerate be syncrhonized with the monitor refresh frequence ? </summary>
         /// <param name="_ActivateVSync">True to activate the VSync, False to disable it.</param>
         void SetVSync( Bool _ActivateVSync );
+
+        /// <summary>How are the OpenGL errors checked ?</summary>
+        /// <returns>Level of the checks.</returns>
+        OpenGLErrorCheck GetOpenGLErrorCheck() const;
+
+        /// <summary>
+        /// Change how the OpenGL errors are checked.<para/>
+        /// The driver may send fewer messages to the debug callback if the window was not created with it (no debug context).
+        /// </summary>
+        /// <param name="_Check">New level of the checks.</param>
+        void SetOpenGLErrorCheck( OpenGLErrorCheck _Check );
         
         /// <summary>Is the application scale the window and the UI according the monitor DPI ?</summary>
         /// <returns>True if the scale is applied, false otherwise.</returns>
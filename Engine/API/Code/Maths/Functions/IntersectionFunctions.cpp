@@ -199,5 +199,519 @@ namespace ae
 			return True;
 		}
 
+
+		float ClosestPointSegment( Vector3& _OutClosest, const Vector3& _Point, const Vector3& _SegmentA, const Vector3& _SegmentB )
+		{
+			// See Real-Time Collision Detection, Christer Ericson, 5.1.2 Closest Point on Line Segment to Point, p127
+
+			const Vector3 AB( _SegmentA, _SegmentB );
+			const float LengthSqr = AB.LengthSqr();
+
+			const float Position = LengthSqr > 0.0f ? Math::Clamp01( Vector3( _SegmentA, _Point ).Dot( AB ) / LengthSqr ) : 0.0f;
+
+			_OutClosest = _SegmentA + AB * Position;
+
+			return Position;
+		}
+
+		void ClosestPointsSegmentSegment( Vector3& _OutClosestA, Vector3& _OutClosestB,
+										  const Vector3& _SegmentA0, const Vector3& _SegmentA1, const Vector3& _SegmentB0, const Vector3& _SegmentB1 )
+		{
+			// See Real-Time Collision Detection, Christer Ericson, 5.1.9 Closest Points of Two Line Segments, p148
+
+			constexpr float Epsilon = Math::Epsilon();
+
+			const Vector3 DirectionA( _SegmentA0, _SegmentA1 );
+			const Vector3 DirectionB( _SegmentB0, _SegmentB1 );
+			const Vector3 BToA( _SegmentB0, _SegmentA0 );
+
+			const float LengthSqrA = DirectionA.LengthSqr();
+			const float LengthSqrB = DirectionB.LengthSqr();
+			const float ProjectionB = DirectionB.Dot( BToA );
+
+			float PositionA = 0.0f;
+			float PositionB = 0.0f;
+
+			// Both segments are points.
+			if( LengthSqrA <= Epsilon && LengthSqrB <= Epsilon )
+			{
+				PositionA = 0.0f;
+				PositionB = 0.0f;
+			}
+			// The first segment is a point.
+			else if( LengthSqrA <= Epsilon )
+			{
+				PositionA = 0.0f;
+				PositionB = Math::Clamp01( ProjectionB / LengthSqrB );
+			}
+			else
+			{
+				const float ProjectionA = DirectionA.Dot( BToA );
+
+				// The second segment is a point.
+				if( LengthSqrB <= Epsilon )
+				{
+					PositionB = 0.0f;
+					PositionA = Math::Clamp01( -ProjectionA / LengthSqrA );
+				}
+				else
+				{
+					const float Directions = DirectionA.Dot( DirectionB );
+					const float Denom = LengthSqrA * LengthSqrB - Directions * Directions;
+
+					// Parallel segments : any point of the first one, the clamping below gives the closest one of the second.
+					PositionA = Denom != 0.0f ? Math::Clamp01( ( Directions * ProjectionB - ProjectionA * LengthSqrB ) / Denom ) : 0.0f;
+					PositionB = ( Directions * PositionA + ProjectionB ) / LengthSqrB;
+
+					// The closest point is outside of the second segment : clamp it and compute the first one again.
+					if( PositionB < 0.0f )
+					{
+						PositionB = 0.0f;
+						PositionA = Math::Clamp01( -ProjectionA / LengthSqrA );
+					}
+					else if( PositionB > 1.0f )
+					{
+						PositionB = 1.0f;
+						PositionA = Math::Clamp01( ( Directions - ProjectionA ) / LengthSqrA );
+					}
+				}
+			}
+
+			_OutClosestA = _SegmentA0 + DirectionA * PositionA;
+			_OutClosestB = _SegmentB0 + DirectionB * PositionB;
+		}
+
+		void ClosestPointTriangle( Vector3& _OutClosest, float& _OutU, float& _OutV, float& _OutW, const Vector3& _Point,
+								   const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC )
+		{
+			// See Real-Time Collision Detection, Christer Ericson, 5.1.5 Closest Point on Triangle to Point, p141
+
+			const Vector3 AB( _TriA, _TriB );
+			const Vector3 AC( _TriA, _TriC );
+
+			// Vertex region of A.
+			const Vector3 AP( _TriA, _Point );
+			const float D1 = AB.Dot( AP );
+			const float D2 = AC.Dot( AP );
+			if( D1 <= 0.0f && D2 <= 0.0f )
+			{
+				_OutClosest = _TriA;
+				_OutU = 1.0f; _OutV = 0.0f; _OutW = 0.0f;
+				return;
+			}
+
+			// Vertex region of B.
+			const Vector3 BP( _TriB, _Point );
+			const float D3 = AB.Dot( BP );
+			const float D4 = AC.Dot( BP );
+			if( D3 >= 0.0f && D4 <= D3 )
+			{
+				_OutClosest = _TriB;
+				_OutU = 0.0f; _OutV = 1.0f; _OutW = 0.0f;
+				return;
+			}
+
+			// Edge region of AB.
+			const float VC = D1 * D4 - D3 * D2;
+			if( VC <= 0.0f && D1 >= 0.0f && D3 <= 0.0f )
+			{
+				const float Position = D1 / ( D1 - D3 );
+				_OutClosest = _TriA + AB * Position;
+				_OutU = 1.0f - Position; _OutV = Position; _OutW = 0.0f;
+				return;
+			}
+
+			// Vertex region of C.
+			const Vector3 CP( _TriC, _Point );
+			const float D5 = AB.Dot( CP );
+			const float D6 = AC.Dot( CP );
+			if( D6 >= 0.0f && D5 <= D6 )
+			{
+				_OutClosest = _TriC;
+				_OutU = 0.0f; _OutV = 0.0f; _OutW = 1.0f;
+				return;
+			}
+
+			// Edge region of AC.
+			const float VB = D5 * D2 - D1 * D6;
+			if( VB <= 0.0f && D2 >= 0.0f && D6 <= 0.0f )
+			{
+				const float Position = D2 / ( D2 - D6 );
+				_OutClosest = _TriA + AC * Position;
+				_OutU = 1.0f - Position; _OutV = 0.0f; _OutW = Position;
+				return;
+			}
+
+			// Edge region of BC.
+			const float VA = D3 * D6 - D5 * D4;
+			if( VA <= 0.0f && ( D4 - D3 ) >= 0.0f && ( D5 - D6 ) >= 0.0f )
+			{
+				const float Position = ( D4 - D3 ) / ( ( D4 - D3 ) + ( D5 - D6 ) );
+				_OutClosest = _TriB + Vector3( _TriB, _TriC ) * Position;
+				_OutU = 0.0f; _OutV = 1.0f - Position; _OutW = Position;
+				return;
+			}
+
+			// Face region.
+			const float Denom = 1.0f / ( VA + VB + VC );
+			_OutV = VB * Denom;
+			_OutW = VC * Denom;
+			_OutU = 1.0f - _OutV - _OutW;
+			_OutClosest = _TriA + AB * _OutV + AC * _OutW;
+		}
+
+		float ClosestPointsSegmentTriangle( Vector3& _OutOnSegment, Vector3& _OutOnTriangle, const Vector3& _SegmentA, const Vector3& _SegmentB,
+											const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC )
+		{
+			float U = 0.0f;
+			float V = 0.0f;
+			float W = 0.0f;
+
+			// The segment crosses the plane of the triangle inside of it : the closest points are the crossing.
+			const Vector3 Normal = Vector3( _TriA, _TriB ).Cross( Vector3( _TriA, _TriC ) );
+			const float DistanceA = Normal.Dot( Vector3( _TriA, _SegmentA ) );
+			const float DistanceB = Normal.Dot( Vector3( _TriA, _SegmentB ) );
+
+			if( DistanceA * DistanceB <= 0.0f && DistanceA != DistanceB )
+			{
+				const Vector3 Crossing = _SegmentA + Vector3( _SegmentA, _SegmentB ) * ( DistanceA / ( DistanceA - DistanceB ) );
+
+				Vector3 OnTriangle;
+				ClosestPointTriangle( OnTriangle, U, V, W, Crossing, _TriA, _TriB, _TriC );
+
+				if( U > 0.0f && V > 0.0f && W > 0.0f )
+				{
+					_OutOnSegment = Crossing;
+					_OutOnTriangle = Crossing;
+					return 0.0f;
+				}
+			}
+
+			// Otherwise the closest points involve an end of the segment or an edge of the triangle.
+			float BestDistanceSqr = Math::Max<float>();
+
+			auto Keep = [&BestDistanceSqr, &_OutOnSegment, &_OutOnTriangle]( const Vector3& _OnSegment, const Vector3& _OnTriangle )
+			{
+				const float DistanceSqr = Vector3( _OnSegment, _OnTriangle ).LengthSqr();
+
+				if( DistanceSqr < BestDistanceSqr )
+				{
+					BestDistanceSqr = DistanceSqr;
+					_OutOnSegment = _OnSegment;
+					_OutOnTriangle = _OnTriangle;
+				}
+			};
+
+			Vector3 OnSegment;
+			Vector3 OnTriangle;
+
+			ClosestPointTriangle( OnTriangle, U, V, W, _SegmentA, _TriA, _TriB, _TriC );
+			Keep( _SegmentA, OnTriangle );
+
+			ClosestPointTriangle( OnTriangle, U, V, W, _SegmentB, _TriA, _TriB, _TriC );
+			Keep( _SegmentB, OnTriangle );
+
+			ClosestPointsSegmentSegment( OnSegment, OnTriangle, _SegmentA, _SegmentB, _TriA, _TriB );
+			Keep( OnSegment, OnTriangle );
+
+			ClosestPointsSegmentSegment( OnSegment, OnTriangle, _SegmentA, _SegmentB, _TriB, _TriC );
+			Keep( OnSegment, OnTriangle );
+
+			ClosestPointsSegmentSegment( OnSegment, OnTriangle, _SegmentA, _SegmentB, _TriC, _TriA );
+			Keep( OnSegment, OnTriangle );
+
+			return BestDistanceSqr;
+		}
+
+		void ClosestPointAABB( Vector3& _OutClosest, const Vector3& _Point, const Vector3& _BoxMin, const Vector3& _BoxMax )
+		{
+			_OutClosest.X = Math::Clamp( _BoxMin.X, _BoxMax.X, _Point.X );
+			_OutClosest.Y = Math::Clamp( _BoxMin.Y, _BoxMax.Y, _Point.Y );
+			_OutClosest.Z = Math::Clamp( _BoxMin.Z, _BoxMax.Z, _Point.Z );
+		}
+
+		Bool SphereSphere( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+						   const Vector3& _CenterA, float _RadiusA, const Vector3& _CenterB, float _RadiusB )
+		{
+			const Vector3 BToA( _CenterB, _CenterA );
+			const float DistanceSqr = BToA.LengthSqr();
+			const float Radii = _RadiusA + _RadiusB;
+
+			if( DistanceSqr > Radii * Radii )
+				return False;
+
+			const float Distance = Math::Sqrt( DistanceSqr );
+
+			// Same centers : any direction separates them.
+			_OutNormal = Distance > Math::Epsilon() ? BToA / Distance : Vector3::AxeY;
+			_OutDepth = Radii - Distance;
+			_OutPoint = _CenterB + _OutNormal * _RadiusB;
+
+			return True;
+		}
+
+		Bool SphereAABB( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+						 const Vector3& _Center, float _Radius, const Vector3& _BoxMin, const Vector3& _BoxMax )
+		{
+			Vector3 Closest;
+			ClosestPointAABB( Closest, _Center, _BoxMin, _BoxMax );
+
+			const Vector3 BoxToCenter( Closest, _Center );
+			const float DistanceSqr = BoxToCenter.LengthSqr();
+
+			if( DistanceSqr > _Radius * _Radius )
+				return False;
+
+			if( DistanceSqr > Math::EpsilonSquared() )
+			{
+				const float Distance = Math::Sqrt( DistanceSqr );
+
+				_OutNormal = BoxToCenter / Distance;
+				_OutDepth = _Radius - Distance;
+				_OutPoint = Closest;
+
+				return True;
+			}
+
+			// The center is inside of the box : push it through the closest face.
+			Uint32 BestAxis = 0;
+			float BestSign = 1.0f;
+			float BestDistance = Math::Max<float>();
+
+			for( Uint32 Axis = 0; Axis < 3; Axis++ )
+			{
+				const float ToMin = _Center[Axis] - _BoxMin[Axis];
+				const float ToMax = _BoxMax[Axis] - _Center[Axis];
+
+				if( ToMin < BestDistance )
+				{
+					BestDistance = ToMin;
+					BestAxis = Axis;
+					BestSign = -1.0f;
+				}
+
+				if( ToMax < BestDistance )
+				{
+					BestDistance = ToMax;
+					BestAxis = Axis;
+					BestSign = 1.0f;
+				}
+			}
+
+			_OutNormal = Vector3::Zero;
+			_OutNormal[BestAxis] = BestSign;
+			_OutDepth = _Radius + BestDistance;
+			_OutPoint = _Center;
+			_OutPoint[BestAxis] = BestSign > 0.0f ? _BoxMax[BestAxis] : _BoxMin[BestAxis];
+
+			return True;
+		}
+
+		Bool SphereTriangle( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth, float& _OutU, float& _OutV, float& _OutW,
+							 const Vector3& _Center, float _Radius, const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC )
+		{
+			Vector3 Closest;
+			float U = 0.0f;
+			float V = 0.0f;
+			float W = 0.0f;
+			ClosestPointTriangle( Closest, U, V, W, _Center, _TriA, _TriB, _TriC );
+
+			const Vector3 TriangleToCenter( Closest, _Center );
+			const float DistanceSqr = TriangleToCenter.LengthSqr();
+
+			if( DistanceSqr > _Radius * _Radius )
+				return False;
+
+			const float Distance = Math::Sqrt( DistanceSqr );
+
+			// The center is on the triangle : push it along the normal of the triangle.
+			_OutNormal = Distance > Math::Epsilon() ? TriangleToCenter / Distance : Vector3( _TriA, _TriB ).Cross( Vector3( _TriA, _TriC ) ).GetNormalized();
+			_OutDepth = _Radius - Distance;
+			_OutPoint = Closest;
+			_OutU = U;
+			_OutV = V;
+			_OutW = W;
+
+			return True;
+		}
+
+		Bool CapsuleAABB( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+						  const Vector3& _SegmentA, const Vector3& _SegmentB, float _Radius, const Vector3& _BoxMin, const Vector3& _BoxMax )
+		{
+			// The distance from the points of the segment to the box is convex : a ternary search finds the closest one.
+			const Vector3 AB( _SegmentA, _SegmentB );
+
+			auto DistanceSqrToBox = [&]( float _Position )
+			{
+				const Vector3 Point = _SegmentA + AB * _Position;
+
+				Vector3 Closest;
+				ClosestPointAABB( Closest, Point, _BoxMin, _BoxMax );
+
+				return Vector3( Closest, Point ).LengthSqr();
+			};
+
+			float Low = 0.0f;
+			float High = 1.0f;
+
+			// Each iteration keeps two thirds of the interval : 20 iterations are below a thousandth of the segment.
+			if( AB.LengthSqr() > Math::EpsilonSquared() )
+			{
+				for( Uint32 i = 0; i < 20; i++ )
+				{
+					const float Third = ( High - Low ) / 3.0f;
+					const float Left = Low + Third;
+					const float Right = High - Third;
+
+					if( DistanceSqrToBox( Left ) < DistanceSqrToBox( Right ) )
+						High = Right;
+					else
+						Low = Left;
+				}
+			}
+
+			return SphereAABB( _OutPoint, _OutNormal, _OutDepth, _SegmentA + AB * ( ( Low + High ) * 0.5f ), _Radius, _BoxMin, _BoxMax );
+		}
+
+		Bool CapsuleTriangle( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth, float& _OutU, float& _OutV, float& _OutW,
+							  const Vector3& _SegmentA, const Vector3& _SegmentB, float _Radius,
+							  const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC )
+		{
+			Vector3 OnSegment;
+			Vector3 OnTriangle;
+			const float DistanceSqr = ClosestPointsSegmentTriangle( OnSegment, OnTriangle, _SegmentA, _SegmentB, _TriA, _TriB, _TriC );
+
+			if( DistanceSqr > _Radius * _Radius )
+				return False;
+
+			// Not crossing : same contact as the sphere at the closest point of the segment.
+			if( DistanceSqr > Math::EpsilonSquared() )
+				return SphereTriangle( _OutPoint, _OutNormal, _OutDepth, _OutU, _OutV, _OutW, OnSegment, _Radius, _TriA, _TriB, _TriC );
+
+			// Crossing : push the capsule along the normal of the triangle, to the side of its longest part.
+			const Vector3 Normal = Vector3( _TriA, _TriB ).Cross( Vector3( _TriA, _TriC ) ).GetNormalized();
+			const float DistanceA = Normal.Dot( Vector3( _TriA, _SegmentA ) );
+			const float DistanceB = Normal.Dot( Vector3( _TriA, _SegmentB ) );
+
+			const Bool IsAOutside = Math::Abs( DistanceA ) >= Math::Abs( DistanceB );
+			const float Outside = IsAOutside ? DistanceA : DistanceB;
+			const float Inside = IsAOutside ? DistanceB : DistanceA;
+
+			ClosestPointTriangle( _OutPoint, _OutU, _OutV, _OutW, OnTriangle, _TriA, _TriB, _TriC );
+			_OutNormal = Outside >= 0.0f ? Normal : -Normal;
+			_OutDepth = _Radius + Math::Abs( Inside );
+
+			return True;
+		}
+
+		Bool AABBAABB( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+					   const Vector3& _MinA, const Vector3& _MaxA, const Vector3& _MinB, const Vector3& _MaxB )
+		{
+			// Push the first box along the axis of the smallest overlap.
+			Uint32 BestAxis = 0;
+			float BestOverlap = Math::Max<float>();
+
+			for( Uint32 Axis = 0; Axis < 3; Axis++ )
+			{
+				const float Overlap = Math::Min( _MaxA[Axis] - _MinB[Axis], _MaxB[Axis] - _MinA[Axis] );
+
+				if( Overlap < 0.0f )
+					return False;
+
+				if( Overlap < BestOverlap )
+				{
+					BestOverlap = Overlap;
+					BestAxis = Axis;
+				}
+			}
+
+			const Bool IsAbove = _MinA[BestAxis] + _MaxA[BestAxis] > _MinB[BestAxis] + _MaxB[BestAxis];
+
+			_OutNormal = Vector3::Zero;
+			_OutNormal[BestAxis] = IsAbove ? 1.0f : -1.0f;
+			_OutDepth = BestOverlap;
+
+			// Center of the overlapping region, on the face of the second box.
+			for( Uint32 Axis = 0; Axis < 3; Axis++ )
+				_OutPoint[Axis] = ( Math::Max( _MinA[Axis], _MinB[Axis] ) + Math::Min( _MaxA[Axis], _MaxB[Axis] ) ) * 0.5f;
+
+			_OutPoint[BestAxis] = IsAbove ? _MaxB[BestAxis] : _MinB[BestAxis];
+
+			return True;
+		}
+
+		Bool AABBTriangle( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth, float& _OutU, float& _OutV, float& _OutW,
+						   const Vector3& _BoxMin, const Vector3& _BoxMax, const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC )
+		{
+			// See Real-Time Collision Detection, Christer Ericson, 5.2.9 Testing AABB Against Triangle, p169
+			// The 13 axes are tested in the space of the box, the smallest overlap gives the contact.
+
+			const Vector3 Center = ( _BoxMin + _BoxMax ) * 0.5f;
+			const Vector3 Extents = ( _BoxMax - _BoxMin ) * 0.5f;
+
+			const Vector3 Points[3] = { _TriA - Center, _TriB - Center, _TriC - Center };
+			const Vector3 Edges[3] = { Vector3( Points[0], Points[1] ), Vector3( Points[1], Points[2] ), Vector3( Points[2], Points[0] ) };
+
+			Vector3 BestAxis;
+			float BestDepth = Math::Max<float>();
+
+			// Return False if the axis separates the shapes, keep it if it needs the smallest move.
+			// The edges axes only replace a face axis when clearly better : they give unstable contacts on flat parts.
+			auto TestAxis = [&]( const Vector3& _Axis, float _Tolerance )
+			{
+				const float LengthSqr = _Axis.LengthSqr();
+				if( LengthSqr < Math::EpsilonSquared() )
+					return True;
+
+				const float P0 = Points[0].Dot( _Axis );
+				const float P1 = Points[1].Dot( _Axis );
+				const float P2 = Points[2].Dot( _Axis );
+				const float TriangleMin = Math::Min( P0, Math::Min( P1, P2 ) );
+				const float TriangleMax = Math::Max( P0, Math::Max( P1, P2 ) );
+				const float BoxRadius = Extents.X * Math::Abs( _Axis.X ) + Extents.Y * Math::Abs( _Axis.Y ) + Extents.Z * Math::Abs( _Axis.Z );
+
+				if( TriangleMin > BoxRadius || TriangleMax < -BoxRadius )
+					return False;
+
+				// The box can leave the triangle by any side of the axis.
+				const float InverseLength = 1.0f / Math::Sqrt( LengthSqr );
+				const float DepthPositive = ( TriangleMax + BoxRadius ) * InverseLength;
+				const float DepthNegative = ( BoxRadius - TriangleMin ) * InverseLength;
+				const Bool IsPositive = DepthPositive < DepthNegative;
+				const float Depth = IsPositive ? DepthPositive : DepthNegative;
+
+				if( Depth < BestDepth * _Tolerance )
+				{
+					BestDepth = Depth;
+					BestAxis = _Axis * ( IsPositive ? InverseLength : -InverseLength );
+				}
+
+				return True;
+			};
+
+			if( !TestAxis( Vector3::AxeX, 1.0f ) || !TestAxis( Vector3::AxeY, 1.0f ) || !TestAxis( Vector3::AxeZ, 1.0f ) )
+				return False;
+
+			if( !TestAxis( Edges[0].Cross( Edges[1] ), 1.0f ) )
+				return False;
+
+			const Vector3 BoxAxes[3] = { Vector3::AxeX, Vector3::AxeY, Vector3::AxeZ };
+
+			for( Uint32 b = 0; b < 3; b++ )
+			{
+				for( Uint32 e = 0; e < 3; e++ )
+				{
+					if( !TestAxis( BoxAxes[b].Cross( Edges[e] ), 0.95f ) )
+						return False;
+				}
+			}
+
+			ClosestPointTriangle( _OutPoint, _OutU, _OutV, _OutW, Center, _TriA, _TriB, _TriC );
+			_OutNormal = BestAxis;
+			_OutDepth = BestDepth;
+
+			return True;
+		}
+
 	} // Intersections
 } // ae
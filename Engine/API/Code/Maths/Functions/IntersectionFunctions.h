@@ -107,5 +107,158 @@ namespace ae
 								const Vector3& _SphereCenter, float _SphereRadius, const Vector3& _SphereVelocity,
 								const Vector3& _PlanePosition, const Vector3& _PlaneNormal );
 
+		/// <summary>Compute the closest point of a segment to a point.</summary>
+		/// <param name="_OutClosest">Closest point of the segment.</param>
+		/// <param name="_Point">The point to get closest to.</param>
+		/// <param name="_SegmentA">Start of the segment.</param>
+		/// <param name="_SegmentB">End of the segment.</param>
+		/// <returns>Position of the closest point on the segment, from 0 (start) to 1 (end).</returns>
+		float ClosestPointSegment( Vector3& _OutClosest, const Vector3& _Point, const Vector3& _SegmentA, const Vector3& _SegmentB );
+
+		/// <summary>Compute the closest points of two segments.</summary>
+		/// <param name="_OutClosestA">Point of the first segment closest to the second one.</param>
+		/// <param name="_OutClosestB">Point of the second segment closest to the first one.</param>
+		/// <param name="_SegmentA0">Start of the first segment.</param>
+		/// <param name="_SegmentA1">End of the first segment.</param>
+		/// <param name="_SegmentB0">Start of the second segment.</param>
+		/// <param name="_SegmentB1">End of the second segment.</param>
+		void ClosestPointsSegmentSegment( Vector3& _OutClosestA, Vector3& _OutClosestB,
+										  const Vector3& _SegmentA0, const Vector3& _SegmentA1, const Vector3& _SegmentB0, const Vector3& _SegmentB1 );
+
+		/// <summary>Compute the closest point of a triangle to a point.</summary>
+		/// <param name="_OutClosest">Closest point of the triangle.</param>
+		/// <param name="_OutU">The weight of the first point of the triangle on the closest point.</param>
+		/// <param name="_OutV">The weight of the second point of the triangle on the closest point.</param>
+		/// <param name="_OutW">The weight of the third point of the triangle on the closest point.</param>
+		/// <param name="_Point">The point to get closest to.</param>
+		/// <param name="_TriA">First point of the triangle.</param>
+		/// <param name="_TriB">Second point of the triangle.</param>
+		/// <param name="_TriC">Third point of the triangle.</param>
+		void ClosestPointTriangle( Vector3& _OutClosest, float& _OutU, float& _OutV, float& _OutW, const Vector3& _Point,
+								   const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC );
+
+		/// <summary>Compute the closest points of a segment and a triangle.</summary>
+		/// <param name="_OutOnSegment">Point of the segment closest to the triangle.</param>
+		/// <param name="_OutOnTriangle">Point of the triangle closest to the segment.</param>
+		/// <param name="_SegmentA">Start of the segment.</param>
+		/// <param name="_SegmentB">End of the segment.</param>
+		/// <param name="_TriA">First point of the triangle.</param>
+		/// <param name="_TriB">Second point of the triangle.</param>
+		/// <param name="_TriC">Third point of the triangle.</param>
+		/// <returns>Squared distance between the closest points, 0 if the segment crosses the triangle.</returns>
+		float ClosestPointsSegmentTriangle( Vector3& _OutOnSegment, Vector3& _OutOnTriangle, const Vector3& _SegmentA, const Vector3& _SegmentB,
+											const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC );
+
+		/// <summary>Compute the closest point of an axis aligned box to a point.</summary>
+		/// <param name="_OutClosest">Closest point of the box, the point itself if it is inside.</param>
+		/// <param name="_Point">The point to get closest to.</param>
+		/// <param name="_BoxMin">Minimum corner of the box.</param>
+		/// <param name="_BoxMax">Maximum corner of the box.</param>
+		void ClosestPointAABB( Vector3& _OutClosest, const Vector3& _Point, const Vector3& _BoxMin, const Vector3& _BoxMax );
+
+
+		// Contacts between overlapping shapes.
+		// They all give the contact the same way : the normal goes from the second shape to the first one,
+		// moving the first shape of the depth along the normal separates them, and the point is on the surface of the second shape.
+
+		/// <summary>Compute the contact between two spheres.</summary>
+		/// <param name="_OutPoint">Point of the second sphere the deepest in the first one. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutNormal">Direction to push the first sphere out of the second one. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutDepth">Distance to push the first sphere along the normal to separate them. Stay unchanged if there is no contact.</param>
+		/// <param name="_CenterA">Center of the first sphere.</param>
+		/// <param name="_RadiusA">Radius of the first sphere.</param>
+		/// <param name="_CenterB">Center of the second sphere.</param>
+		/// <param name="_RadiusB">Radius of the second sphere.</param>
+		/// <returns>True if the spheres are overlapping, false otherwise.</returns>
+		Bool SphereSphere( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+						   const Vector3& _CenterA, float _RadiusA, const Vector3& _CenterB, float _RadiusB );
+
+		/// <summary>Compute the contact between a sphere and an axis aligned box.</summary>
+		/// <param name="_OutPoint">Point of the box the deepest in the sphere. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutNormal">Direction to push the sphere out of the box. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutDepth">Distance to push the sphere along the normal to separate them. Stay unchanged if there is no contact.</param>
+		/// <param name="_Center">Center of the sphere.</param>
+		/// <param name="_Radius">Radius of the sphere.</param>
+		/// <param name="_BoxMin">Minimum corner of the box.</param>
+		/// <param name="_BoxMax">Maximum corner of the box.</param>
+		/// <returns>True if the sphere and the box are overlapping, false otherwise.</returns>
+		Bool SphereAABB( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+						 const Vector3& _Center, float _Radius, const Vector3& _BoxMin, const Vector3& _BoxMax );
+
+		/// <summary>Compute the contact between a sphere and a triangle, seen from both sides.</summary>
+		/// <param name="_OutPoint">Point of the triangle the deepest in the sphere. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutNormal">Direction to push the sphere out of the triangle. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutDepth">Distance to push the sphere along the normal to separate them. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutU">The weight of the first point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutV">The weight of the second point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutW">The weight of the third point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_Center">Center of the sphere.</param>
+		/// <param name="_Radius">Radius of the sphere.</param>
+		/// <param name="_TriA">First point of the triangle.</param>
+		/// <param name="_TriB">Second point of the triangle.</param>
+		/// <param name="_TriC">Third point of the triangle.</param>
+		/// <returns>True if the sphere and the triangle are overlapping, false otherwise.</returns>
+		Bool SphereTriangle( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth, float& _OutU, float& _OutV, float& _OutW,
+							 const Vector3& _Center, float _Radius, const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC );
+
+		/// <summary>Compute the contact between a capsule and an axis aligned box.</summary>
+		/// <param name="_OutPoint">Point of the box the deepest in the capsule. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutNormal">Direction to push the capsule out of the box. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutDepth">Distance to push the capsule along the normal to separate them. Stay unchanged if there is no contact.</param>
+		/// <param name="_SegmentA">Center of the first end of the capsule.</param>
+		/// <param name="_SegmentB">Center of the second end of the capsule.</param>
+		/// <param name="_Radius">Radius of the capsule.</param>
+		/// <param name="_BoxMin">Minimum corner of the box.</param>
+		/// <param name="_BoxMax">Maximum corner of the box.</param>
+		/// <returns>True if the capsule and the box are overlapping, false otherwise.</returns>
+		Bool CapsuleAABB( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+						  const Vector3& _SegmentA, const Vector3& _SegmentB, float _Radius, const Vector3& _BoxMin, const Vector3& _BoxMax );
+
+		/// <summary>Compute the contact between a capsule and a triangle, seen from both sides.</summary>
+		/// <param name="_OutPoint">Point of the triangle the deepest in the capsule. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutNormal">Direction to push the capsule out of the triangle. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutDepth">Distance to push the capsule along the normal to separate them. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutU">The weight of the first point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutV">The weight of the second point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutW">The weight of the third point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_SegmentA">Center of the first end of the capsule.</param>
+		/// <param name="_SegmentB">Center of the second end of the capsule.</param>
+		/// <param name="_Radius">Radius of the capsule.</param>
+		/// <param name="_TriA">First point of the triangle.</param>
+		/// <param name="_TriB">Second point of the triangle.</param>
+		/// <param name="_TriC">Third point of the triangle.</param>
+		/// <returns>True if the capsule and the triangle are overlapping, false otherwise.</returns>
+		Bool CapsuleTriangle( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth, float& _OutU, float& _OutV, float& _OutW,
+							  const Vector3& _SegmentA, const Vector3& _SegmentB, float _Radius,
+							  const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC );
+
+		/// <summary>Compute the contact between two axis aligned boxes.</summary>
+		/// <param name="_OutPoint">Point on the face of the second box the deepest in the first one. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutNormal">Direction to push the first box out of the second one, along an axis. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutDepth">Distance to push the first box along the normal to separate them. Stay unchanged if there is no contact.</param>
+		/// <param name="_MinA">Minimum corner of the first box.</param>
+		/// <param name="_MaxA">Maximum corner of the first box.</param>
+		/// <param name="_MinB">Minimum corner of the second box.</param>
+		/// <param name="_MaxB">Maximum corner of the second box.</param>
+		/// <returns>True if the boxes are overlapping, false otherwise.</returns>
+		Bool AABBAABB( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth,
+					   const Vector3& _MinA, const Vector3& _MaxA, const Vector3& _MinB, const Vector3& _MaxB );
+
+		/// <summary>Compute the contact between an axis aligned box and a triangle, seen from both sides, with the separating axis test.</summary>
+		/// <param name="_OutPoint">Point of the triangle closest to the center of the box. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutNormal">Direction to push the box out of the triangle. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutDepth">Distance to push the box along the normal to separate them. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutU">The weight of the first point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutV">The weight of the second point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_OutW">The weight of the third point of the triangle on the contact point. Stay unchanged if there is no contact.</param>
+		/// <param name="_BoxMin">Minimum corner of the box.</param>
+		/// <param name="_BoxMax">Maximum corner of the box.</param>
+		/// <param name="_TriA">First point of the triangle.</param>
+		/// <param name="_TriB">Second point of the triangle.</param>
+		/// <param name="_TriC">Third point of the triangle.</param>
+		/// <returns>True if the box and the triangle are overlapping, false otherwise.</returns>
+		Bool AABBTriangle( Vector3& _OutPoint, Vector3& _OutNormal, float& _OutDepth, float& _OutU, float& _OutV, float& _OutW,
+						   const Vector3& _BoxMin, const Vector3& _BoxMax, const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC );
+
 	} // Intersections
 } // ae
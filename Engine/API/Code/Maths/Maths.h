@@ -26,6 +26,8 @@
 #include "Primitives/TRect.h"
 #include "Primitives/Plane.h"
 #include "Primitives/Sphere.h"
+#include "Primitives/AABB.h"
+#include "Primitives/Frustum.h"
 
 #include "Curve/Curve.h"
 #include "Curve/CurveLinear.h"
@@ -375,11 +375,7 @@ namespace ae
 
     Matrix3x3& Matrix3x3::operator*=( const Matrix3x3& _MatB )
     {
-        Matrix3x3 Result;
-
-        priv::MatrixToolbox::Multiply( Result.m_Mat, m_Mat, 3, 3, _MatB.m_Mat, 3 );
-
-        *this = Result;
+        priv::MatrixToolbox::Multiply<3, 3, 3>( m_Mat, m_Mat, _MatB.m_Mat );
 
         return *this;
     }
@@ -537,7 +533,7 @@ namespace ae
     {
         Matrix3x3 Result;
 
-        priv::MatrixToolbox::Multiply( Result.GetData(), _MatA.GetData(), 3, 3, _MatB.GetData(), 3 );
+        priv::MatrixToolbox::Multiply<3, 3, 3>( Result.GetData(), _MatA.GetData(), _MatB.GetData() );
 
         return Result;
     }
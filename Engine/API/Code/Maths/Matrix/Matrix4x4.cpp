@@ -311,141 +311,8 @@ namespace ae
 
     Matrix4x4& Matrix4x4::Inverse()
     {
-        // http://www.cg.info.hiroshima-cu.ac.jp/~miyazaki/knowledge/teche23.html
-
-        // b11 = 112233 122331 132132 112332 122133 132231
-        // b12 = 012332 022133 032231 012233 022331 032132
-        // b13 = 011233 021331 031132 011332 021133 031231
-        // b14 = 011233 021331 031132 011332 021321 031122
-        // b21 = 102332 122033 132230 102233 122330 132032
-        // b22 = 002233 022330 032032 002332 022033 032230
-        // b23 = 001332 021033 031230 001233 021330 031032
-        // b24 = 001223 021320 031022 001322 021023 031220
-        // b31 = 102133 112330 132031 102331 112033 132130
-        // b32 = 002331 012033 032130 002133 012330 032031
-        // b33 = 001133 011330 031031 001331 011033 031130
-        // b34 = 001321 011023 031120 001123 011320 031021
-        // b41 = 102231 112032 122130 102132 112230 122031
-        // b42 = 002132 012230 022031 002231 012032 022130
-        // b43 = 001231 011032 021130 001132 011230 021031
-        // b44 = 001122 011220 021021 001221 011022 021120
-
-        float C11, C12, C13, C14;
-        float C21, C22, C23, C24;
-        float C31, C32, C33, C34;
-        float C41, C42, C43, C44;
-
-        const float Determinant =
-            m_Mat[R0C0] * m_Mat[R1C1] * m_Mat[R2C2] * m_Mat[R3C3]
-            + m_Mat[R0C0] * m_Mat[R1C2] * m_Mat[R2C3] * m_Mat[R3C1]
-            + m_Mat[R0C0] * m_Mat[R1C3] * m_Mat[R2C1] * m_Mat[R3C2]
-
-            + m_Mat[R0C1] * m_Mat[R1C0] * m_Mat[R2C3] * m_Mat[R3C2]
-            + m_Mat[R0C1] * m_Mat[R1C2] * m_Mat[R2C0] * m_Mat[R3C3]
-            + m_Mat[R0C1] * m_Mat[R1C3] * m_Mat[R2C2] * m_Mat[R3C0]
-
-            + m_Mat[R0C2] * m_Mat[R1C0] * m_Mat[R2C1] * m_Mat[R3C3]
-            + m_Mat[R0C2] * m_Mat[R1C1] * m_Mat[R2C3] * m_Mat[R3C0]
-            + m_Mat[R0C2] * m_Mat[R1C3] * m_Mat[R2C0] * m_Mat[R3C1]
-
-            + m_Mat[R0C3] * m_Mat[R1C0] * m_Mat[R2C2] * m_Mat[R3C1]
-            + m_Mat[R0C3] * m_Mat[R1C1] * m_Mat[R2C0] * m_Mat[R3C2]
-            + m_Mat[R0C3] * m_Mat[R1C2] * m_Mat[R2C1] * m_Mat[R3C0]
-
-            - m_Mat[R0C0] * m_Mat[R1C1] * m_Mat[R2C3] * m_Mat[R3C2]
-            - m_Mat[R0C0] * m_Mat[R1C2] * m_Mat[R2C1] * m_Mat[R3C3]
-            - m_Mat[R0C0] * m_Mat[R1C3] * m_Mat[R2C2] * m_Mat[R3C1]
-
-            - m_Mat[R0C1] * m_Mat[R1C0] * m_Mat[R2C2] * m_Mat[R3C3]
-            - m_Mat[R0C1] * m_Mat[R1C2] * m_Mat[R2C3] * m_Mat[R3C0]
-            - m_Mat[R0C1] * m_Mat[R1C3] * m_Mat[R2C0] * m_Mat[R3C2]
-
-            - m_Mat[R0C2] * m_Mat[R1C0] * m_Mat[R2C3] * m_Mat[R3C1]
-            - m_Mat[R0C2] * m_Mat[R1C1] * m_Mat[R2C0] * m_Mat[R3C3]
-            - m_Mat[R0C2] * m_Mat[R1C3] * m_Mat[R2C1] * m_Mat[R3C0]
-
-            - m_Mat[R0C3] * m_Mat[R1C0] * m_Mat[R2C1] * m_Mat[R3C2]
-            - m_Mat[R0C3] * m_Mat[R1C1] * m_Mat[R2C2] * m_Mat[R3C0]
-            - m_Mat[R0C3] * m_Mat[R1C2] * m_Mat[R2C0] * m_Mat[R3C1];
-
-        if( Determinant == 0.0f )
-        {
+        if( !priv::MatrixToolbox::Inverse4x4( m_Mat, m_Mat ) )
             AE_LogError( "Can't inverse the matrix, derterminant is equal to 0." );
-            return *this;
-        }
-
-        const float InvDeterminant = 1.0f / Determinant;
-
-        C11 = ( m_Mat[R1C1] * m_Mat[R2C2] * m_Mat[R3C3] + m_Mat[R1C2] * m_Mat[R2C3] * m_Mat[R3C1] + m_Mat[R1C3] * m_Mat[R2C1] * m_Mat[R3C2] )
-            - ( m_Mat[R1C1] * m_Mat[R2C3] * m_Mat[R3C2] + m_Mat[R1C2] * m_Mat[R2C1] * m_Mat[R3C3] + m_Mat[R1C3] * m_Mat[R2C2] * m_Mat[R3C1] );
-
-        C12 = ( m_Mat[R0C1] * m_Mat[R2C3] * m_Mat[R3C2] + m_Mat[R0C2] * m_Mat[R2C1] * m_Mat[R3C3] + m_Mat[R0C0] * m_Mat[R2C2] * m_Mat[R3C1] )
-            - ( m_Mat[R0C1] * m_Mat[R2C2] * m_Mat[R3C3] + m_Mat[R0C2] * m_Mat[R2C3] * m_Mat[R3C1] + m_Mat[R0C3] * m_Mat[R2C1] * m_Mat[R3C2] );
-
-        C13 = ( m_Mat[R0C1] * m_Mat[R1C2] * m_Mat[R3C3] + m_Mat[R0C2] * m_Mat[R1C3] * m_Mat[R3C1] + m_Mat[R0C0] * m_Mat[R1C1] * m_Mat[R3C2] )
-            - ( m_Mat[R0C1] * m_Mat[R1C3] * m_Mat[R3C2] + m_Mat[R0C2] * m_Mat[R1C1] * m_Mat[R3C3] + m_Mat[R0C3] * m_Mat[R1C2] * m_Mat[R3C1] );
-
-        C14 = ( m_Mat[R0C1] * m_Mat[R1C3] * m_Mat[R2C2] + m_Mat[R0C2] * m_Mat[R1C1] * m_Mat[R2C3] + m_Mat[R0C3] * m_Mat[R1C2] * m_Mat[R2C1] )
-            - ( m_Mat[R0C1] * m_Mat[R1C2] * m_Mat[R2C3] + m_Mat[R0C2] * m_Mat[R1C3] * m_Mat[R2C1] + m_Mat[R0C3] * m_Mat[R1C1] * m_Mat[R2C2] );
-
-
-        C21 = ( m_Mat[R1C0] * m_Mat[R2C3] * m_Mat[R3C2] + m_Mat[R1C2] * m_Mat[R2C0] * m_Mat[R3C3] + m_Mat[R1C3] * m_Mat[R2C2] * m_Mat[R3C0] )
-            - ( m_Mat[R1C0] * m_Mat[R2C2] * m_Mat[R3C3] + m_Mat[R1C2] * m_Mat[R2C3] * m_Mat[R3C0] + m_Mat[R1C3] * m_Mat[R2C0] * m_Mat[R3C2] );
-
-        C22 = ( m_Mat[R0C0] * m_Mat[R2C2] * m_Mat[R3C3] + m_Mat[R0C2] * m_Mat[R2C3] * m_Mat[R3C0] + m_Mat[R0C3] * m_Mat[R2C0] * m_Mat[R3C2] )
-            - ( m_Mat[R0C0] * m_Mat[R2C3] * m_Mat[R3C2] + m_Mat[R0C2] * m_Mat[R2C0] * m_Mat[R3C3] + m_Mat[R0C3] * m_Mat[R2C2] * m_Mat[R3C0] );
-
-        C23 = ( m_Mat[R0C0] * m_Mat[R1C3] * m_Mat[R3C2] + m_Mat[R0C2] * m_Mat[R1C0] * m_Mat[R3C3] + m_Mat[R0C3] * m_Mat[R1C2] * m_Mat[R3C0] )
-            - ( m_Mat[R0C0] * m_Mat[R1C2] * m_Mat[R3C3] + m_Mat[R0C2] * m_Mat[R1C3] * m_Mat[R3C0] + m_Mat[R0C3] * m_Mat[R1C0] * m_Mat[R3C2] );
-
-        C24 = ( m_Mat[R0C0] * m_Mat[R1C2] * m_Mat[R2C3] + m_Mat[R0C2] * m_Mat[R1C3] * m_Mat[R2C0] + m_Mat[R0C3] * m_Mat[R1C0] * m_Mat[R2C2] )
-            - ( m_Mat[R0C0] * m_Mat[R1C3] * m_Mat[R2C2] + m_Mat[R0C2] * m_Mat[R1C0] * m_Mat[R2C3] + m_Mat[R0C3] * m_Mat[R1C2] * m_Mat[R2C0] );
-
-
-        C31 = ( m_Mat[R1C0] * m_Mat[R2C1] * m_Mat[R3C3] + m_Mat[R1C1] * m_Mat[R2C3] * m_Mat[R3C0] + m_Mat[R1C3] * m_Mat[R2C0] * m_Mat[R3C1] )
-            - ( m_Mat[R1C0] * m_Mat[R2C3] * m_Mat[R3C1] + m_Mat[R1C1] * m_Mat[R2C0] * m_Mat[R3C3] + m_Mat[R1C3] * m_Mat[R2C1] * m_Mat[R3C0] );
-
-        C32 = ( m_Mat[R0C0] * m_Mat[R2C3] * m_Mat[R3C1] + m_Mat[R0C1] * m_Mat[R2C0] * m_Mat[R3C3] + m_Mat[R0C3] * m_Mat[R2C1] * m_Mat[R3C0] )
-            - ( m_Mat[R0C0] * m_Mat[R2C1] * m_Mat[R3C3] + m_Mat[R0C1] * m_Mat[R2C3] * m_Mat[R3C0] + m_Mat[R0C3] * m_Mat[R2C0] * m_Mat[R3C1] );
-
-        C33 = ( m_Mat[R0C0] * m_Mat[R1C1] * m_Mat[R3C3] + m_Mat[R0C1] * m_Mat[R1C3] * m_Mat[R3C0] + m_Mat[R0C3] * m_Mat[R1C0] * m_Mat[R3C1] )
-            - ( m_Mat[R0C0] * m_Mat[R1C3] * m_Mat[R3C1] + m_Mat[R0C1] * m_Mat[R1C0] * m_Mat[R3C3] + m_Mat[R0C3] * m_Mat[R1C1] * m_Mat[R3C0] );
-
-        C34 = ( m_Mat[R0C0] * m_Mat[R1C3] * m_Mat[R2C1] + m_Mat[R0C1] * m_Mat[R1C0] * m_Mat[R2C3] + m_Mat[R0C3] * m_Mat[R1C1] * m_Mat[R2C0] )
-            - ( m_Mat[R0C0] * m_Mat[R1C1] * m_Mat[R2C3] + m_Mat[R0C1] * m_Mat[R1C3] * m_Mat[R2C0] + m_Mat[R0C3] * m_Mat[R1C0] * m_Mat[R2C1] );
-
-
-        C41 = ( m_Mat[R1C0] * m_Mat[R2C2] * m_Mat[R3C1] + m_Mat[R1C1] * m_Mat[R2C0] * m_Mat[R3C2] + m_Mat[R1C2] * m_Mat[R2C1] * m_Mat[R3C0] )
-            - ( m_Mat[R1C0] * m_Mat[R2C1] * m_Mat[R3C2] + m_Mat[R1C1] * m_Mat[R2C2] * m_Mat[R3C0] + m_Mat[R1C2] * m_Mat[R2C0] * m_Mat[R3C1] );
-
-        C42 = ( m_Mat[R0C0] * m_Mat[R2C1] * m_Mat[R3C2] + m_Mat[R0C1] * m_Mat[R2C2] * m_Mat[R3C0] + m_Mat[R0C2] * m_Mat[R2C0] * m_Mat[R3C1] )
-            - ( m_Mat[R0C0] * m_Mat[R2C2] * m_Mat[R3C1] + m_Mat[R0C1] * m_Mat[R2C0] * m_Mat[R3C2] + m_Mat[R0C2] * m_Mat[R2C1] * m_Mat[R3C0] );
-
-        C43 = ( m_Mat[R0C0] * m_Mat[R1C2] * m_Mat[R3C1] + m_Mat[R0C1] * m_Mat[R1C0] * m_Mat[R3C2] + m_Mat[R0C2] * m_Mat[R1C1] * m_Mat[R3C0] )
-            - ( m_Mat[R0C0] * m_Mat[R1C1] * m_Mat[R3C2] + m_Mat[R0C1] * m_Mat[R1C2] * m_Mat[R3C0] + m_Mat[R0C2] * m_Mat[R1C0] * m_Mat[R3C1] );
-
-        C44 = ( m_Mat[R0C0] * m_Mat[R1C1] * m_Mat[R2C2] + m_Mat[R0C1] * m_Mat[R1C2] * m_Mat[R2C0] + m_Mat[R0C2] * m_Mat[R1C0] * m_Mat[R2C1] )
-            - ( m_Mat[R0C0] * m_Mat[R1C2] * m_Mat[R2C1] + m_Mat[R0C1] * m_Mat[R1C0] * m_Mat[R2C2] + m_Mat[R0C2] * m_Mat[R1C1] * m_Mat[R2C0] );
-
-        m_Mat[R0C0] = C11 * InvDeterminant;
-        m_Mat[R0C1] = C12 * InvDeterminant;
-        m_Mat[R0C2] = C13 * InvDeterminant;
-        m_Mat[R0C3] = C14 * InvDeterminant;
-
-        m_Mat[R1C0] = C21 * InvDeterminant;
-        m_Mat[R1C1] = C22 * InvDeterminant;
-        m_Mat[R1C2] = C23 * InvDeterminant;
-        m_Mat[R1C3] = C24 * InvDeterminant;
-
-        m_Mat[R2C0] = C31 * InvDeterminant;
-        m_Mat[R2C1] = C32 * InvDeterminant;
-        m_Mat[R2C2] = C33 * InvDeterminant;
-        m_Mat[R2C3] = C34 * InvDeterminant;
-
-        m_Mat[R3C0] = C41 * InvDeterminant;
-        m_Mat[R3C1] = C42 * InvDeterminant;
-        m_Mat[R3C2] = C43 * InvDeterminant;
-        m_Mat[R3C3] = C44 * InvDeterminant;
 
         return *this;
     }
@@ -484,6 +351,21 @@ namespace ae
         _Point.Z = Copy.X * m_Mat[R2C0] + Copy.Y * m_Mat[R2C1] + Copy.Z * m_Mat[R2C2] + m_Mat[R2C3];
     }
 
+    void Matrix4x4::TransformPoints( const Vector3* _Points, AE_Out Vector3* _Result, Uint32 _Count ) const
+    {
+        static_assert( sizeof( Vector3 ) == 3 * sizeof( float ), "The points are read as packed floats." );
+
+        priv::MatrixToolbox::TransformPoints( &_Result->X, m_Mat, &_Points->X, _Count );
+    }
+
+    void Matrix4x4::TransformPoints( AE_InOut std::vector<Vector3>& _Points ) const
+    {
+        if( _Points.empty() )
+            return;
+
+        TransformPoints( _Points.data(), _Points.data(), Cast( Uint32, _Points.size() ) );
+    }
+
     Matrix4x4& Matrix4x4::SetToPerspectiveMatrix( const float _Fov, const float _Aspect, const float _Near, const float _Far )
     {
         float TanHalfFovY = Math::Tan( _Fov / 2.0f );
@@ -586,12 +468,7 @@ namespace ae
 
     inline Matrix4x4& Matrix4x4::Transpose()
     {
-        std::swap( m_Mat[R1C0], m_Mat[R0C1] );
-        std::swap( m_Mat[R2C0], m_Mat[R0C2] );
-        std::swap( m_Mat[R3C0], m_Mat[R0C3] );
-        std::swap( m_Mat[R2C1], m_Mat[R1C2] );
-        std::swap( m_Mat[R3C1], m_Mat[R1C3] );
-        std::swap( m_Mat[R3C2], m_Mat[R2C3] );
+        priv::MatrixToolbox::Transpose<4, 4>( m_Mat, m_Mat );
 
         return *this;
     }
@@ -664,11 +541,7 @@ namespace ae
 
     Matrix4x4& Matrix4x4::operator*=( const Matrix4x4& _MatB )
     {
-        Matrix4x4 Result;
-
-        priv::MatrixToolbox::Multiply( Result.m_Mat, m_Mat, 4, 4, _MatB.m_Mat, 4 );
-
-        *this = Result;
+        priv::MatrixToolbox::Multiply<4, 4, 4>( m_Mat, m_Mat, _MatB.m_Mat );
 
         return *this;
     }
@@ -755,7 +628,7 @@ namespace ae
         if( _Col < 0 || _Col >= 4 )
             throw std::out_of_range( "Invalid column" );
 
-        return m_Mat[_Row * +_Col];
+        return m_Mat[_Row * 4 + _Col];
     }
 
 
@@ -827,7 +700,7 @@ namespace ae
     {
         Matrix4x4 Result;
 
-        priv::MatrixToolbox::Multiply( Result.GetData(), _MatA.GetData(), 4, 4, _MatB.GetData(), 4 );
+        priv::MatrixToolbox::Multiply<4, 4, 4>( Result.GetData(), _MatA.GetData(), _MatB.GetData() );
 
         return Result;
     }
@@ -8,6 +8,7 @@
 #include <string>
 #include <iostream>
 #include <array>
+#include <vector>
 
 namespace ae
 {
@@ -402,6 +403,19 @@ namespace ae
         /// \snippetdoc UnitTestMatrix4x4/Functionalities.cpp TransformPoint expected output
         void TransformPoint( AE_InOut Vector3& _Point ) const;
 
+        /// <summary>
+        /// Transforms an array of points, four at a time with SSE. <para/>
+        /// Quicker than a TransformPoint per point for the meshes, bounds corners, ...
+        /// </summary>
+        /// <param name="_Points">The points to transform.</param>
+        /// <param name="_Result">The transformed points, can be <paramref name="_Points"/>.</param>
+        /// <param name="_Count">Count of points.</param>
+        void TransformPoints( const Vector3* _Points, AE_Out Vector3* _Result, Uint32 _Count ) const;
+
+        /// <summary>Transforms an array of points in place, four at a time with SSE.</summary>
+        /// <param name="_Points">The points to transform.</param>
+        void TransformPoints( AE_InOut std::vector<Vector3>& _Points ) const;
+
 
         /// <summary>
         /// Set the matrix to do a perspective projection.
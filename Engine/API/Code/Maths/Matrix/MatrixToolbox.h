@@ -4,6 +4,11 @@
 #include "../../Toolbox/Toolbox.h"
 #include "../../Maths/Functions/MathsFunctions.h"
 
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __SSE2__ )
+#define AE_MATRIX_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace ae
 {
 	/// \ingroup math
@@ -202,6 +207,307 @@ namespace ae
 				return Trace;
 			}
 
+
+			////////////////////////////////////////////////////////////
+			// Fixed size kernels : the sizes are known at compile time, the loops are unrolled.
+			// The results can be one of the operands. The 4x4 float versions use SSE when available.
+			////////////////////////////////////////////////////////////
+
+			template<Uint32 CountRowA, Uint32 CountColA, Uint32 CountColB, typename T>
+			void Multiply( AE_Out T* const _Result, const T* const _A, const T* const _B )
+			{
+				T Temp[CountRowA * CountColB];
+
+				for( Uint32 Row = 0; Row < CountRowA; Row++ )
+				{
+					for( Uint32 Col = 0; Col < CountColB; Col++ )
+					{
+						T Sum = _A[Row * CountColA] * _B[Col];
+
+						for( Uint32 K = 1; K < CountColA; K++ )
+							Sum += _A[Row * CountColA + K] * _B[K * CountColB + Col];
+
+						Temp[Row * CountColB + Col] = Sum;
+					}
+				}
+
+				for( Uint32 Index = 0; Index < CountRowA * CountColB; Index++ )
+					_Result[Index] = Temp[Index];
+			}
+
+			template<Uint32 CountRow, Uint32 CountCol, typename T>
+			void Transpose( AE_Out T* const _Result, const T* const _Data )
+			{
+				T Temp[CountRow * CountCol];
+
+				for( Uint32 Row = 0; Row < CountRow; Row++ )
+				{
+					for( Uint32 Col = 0; Col < CountCol; Col++ )
+						Temp[Col * CountRow + Row] = _Data[Row * CountCol + Col];
+				}
+
+				for( Uint32 Index = 0; Index < CountRow * CountCol; Index++ )
+					_Result[Index] = Temp[Index];
+			}
+
+			/// <summary>Inverse of a 4x4 matrix from its cofactors. Returns False and does not write the result if the matrix is not invertible.</summary>
+			template<typename T>
+			Bool Inverse4x4( AE_Out T* const _Result, const T* const _Data )
+			{
+				const T* const M = _Data;
+
+				// 2x2 determinants of the two upper rows and of the two lower rows.
+				const T S0 = M[0] * M[5] - M[4] * M[1];
+				const T S1 = M[0] * M[6] - M[4] * M[2];
+				const T S2 = M[0] * M[7] - M[4] * M[3];
+				const T S3 = M[1] * M[6] - M[5] * M[2];
+				const T S4 = M[1] * M[7] - M[5] * M[3];
+				const T S5 = M[2] * M[7] - M[6] * M[3];
+
+				const T C5 = M[10] * M[15] - M[14] * M[11];
+				const T C4 = M[9] * M[15] - M[13] * M[11];
+				const T C3 = M[9] * M[14] - M[13] * M[10];
+				const T C2 = M[8] * M[15] - M[12] * M[11];
+				const T C1 = M[8] * M[14] - M[12] * M[10];
+				const T C0 = M[8] * M[13] - M[12] * M[9];
+
+				const T Determinant = S0 * C5 - S1 * C4 + S2 * C3 + S3 * C2 - S4 * C1 + S5 * C0;
+
+				if( Determinant == Cast( T, 0 ) )
+					return False;
+
+				const T InvDeterminant = Cast( T, 1 ) / Determinant;
+
+				const T Inverse[16] =
+				{
+					( M[5] * C5 - M[6] * C4 + M[7] * C3 ) * InvDeterminant,
+					( -M[1] * C5 + M[2] * C4 - M[3] * C3 ) * InvDeterminant,
+					( M[13] * S5 - M[14] * S4 + M[15] * S3 ) * InvDeterminant,
+					( -M[9] * S5 + M[10] * S4 - M[11] * S3 ) * InvDeterminant,
+
+					( -M[4] * C5 + M[6] * C2 - M[7] * C1 ) * InvDeterminant,
+					( M[0] * C5 - M[2] * C2 + M[3] * C1 ) * InvDeterminant,
+					( -M[12] * S5 + M[14] * S2 - M[15] * S1 ) * InvDeterminant,
+					( M[8] * S5 - M[10] * S2 + M[11] * S1 ) * InvDeterminant,
+
+					( M[4] * C4 - M[5] * C2 + M[7] * C0 ) * InvDeterminant,
+					( -M[0] * C4 + M[1] * C2 - M[3] * C0 ) * InvDeterminant,
+					( M[12] * S4 - M[13] * S2 + M[15] * S0 ) * InvDeterminant,
+					( -M[8] * S4 + M[9] * S2 - M[11] * S0 ) * InvDeterminant,
+
+					( -M[4] * C3 + M[5] * C1 - M[6] * C0 ) * InvDeterminant,
+					( M[0] * C3 - M[1] * C1 + M[2] * C0 ) * InvDeterminant,
+					( -M[12] * S3 + M[13] * S1 - M[14] * S0 ) * InvDeterminant,
+					( M[8] * S3 - M[9] * S1 + M[10] * S0 ) * InvDeterminant
+				};
+
+				for( Uint32 Index = 0; Index < 16; Index++ )
+					_Result[Index] = Inverse[Index];
+
+				return True;
+			}
+
+			/// <summary>Transform points (x, y, z packed) by a 4x4 matrix, w = 1. The result can be the points array.</summary>
+			template<typename T>
+			void TransformPoints( AE_Out T* const _Result, const T* const _Matrix, const T* const _Points, const Uint32 _CountPoints )
+			{
+				const T* const M = _Matrix;
+
+				for( Uint32 Point = 0; Point < _CountPoints; Point++ )
+				{
+					const T X = _Points[Point * 3];
+					const T Y = _Points[Point * 3 + 1];
+					const T Z = _Points[Point * 3 + 2];
+
+					_Result[Point * 3] = X * M[0] + Y * M[1] + Z * M[2] + M[3];
+					_Result[Point * 3 + 1] = X * M[4] + Y * M[5] + Z * M[6] + M[7];
+					_Result[Point * 3 + 2] = X * M[8] + Y * M[9] + Z * M[10] + M[11];
+				}
+			}
+
+#ifdef AE_MATRIX_SSE
+			namespace SSE
+			{
+				/// <summary>Build a shuffle mask from four lane indices, lane 0 first.</summary>
+				#define AE_SHUFFLE_MASK( _X, _Y, _Z, _W ) ( ( _X ) | ( ( _Y ) << 2 ) | ( ( _Z ) << 4 ) | ( ( _W ) << 6 ) )
+
+				/// <summary>Product of two 2x2 matrices packed as ( m00, m01, m10, m11 ) : A * B.</summary>
+				inline __m128 Multiply2x2( const __m128 _A, const __m128 _B )
+				{
+					return _mm_add_ps( _mm_mul_ps( _A, _mm_shuffle_ps( _B, _B, AE_SHUFFLE_MASK( 0, 3, 0, 3 ) ) ),
+									   _mm_mul_ps( _mm_shuffle_ps( _A, _A, AE_SHUFFLE_MASK( 1, 0, 3, 2 ) ), _mm_shuffle_ps( _B, _B, AE_SHUFFLE_MASK( 2, 1, 2, 1 ) ) ) );
+				}
+
+				/// <summary>Product of the adjugate of a 2x2 matrix with another one : adj( A ) * B.</summary>
+				inline __m128 AdjugateMultiply2x2( const __m128 _A, const __m128 _B )
+				{
+					return _mm_sub_ps( _mm_mul_ps( _mm_shuffle_ps( _A, _A, AE_SHUFFLE_MASK( 3, 3, 0, 0 ) ), _B ),
+									   _mm_mul_ps( _mm_shuffle_ps( _A, _A, AE_SHUFFLE_MASK( 1, 1, 2, 2 ) ), _mm_shuffle_ps( _B, _B, AE_SHUFFLE_MASK( 2, 3, 0, 1 ) ) ) );
+				}
+
+				/// <summary>Product of a 2x2 matrix with the adjugate of another one : A * adj( B ).</summary>
+				inline __m128 MultiplyAdjugate2x2( const __m128 _A, const __m128 _B )
+				{
+					return _mm_sub_ps( _mm_mul_ps( _A, _mm_shuffle_ps( _B, _B, AE_SHUFFLE_MASK( 3, 0, 3, 0 ) ) ),
+									   _mm_mul_ps( _mm_shuffle_ps( _A, _A, AE_SHUFFLE_MASK( 1, 0, 3, 2 ) ), _mm_shuffle_ps( _B, _B, AE_SHUFFLE_MASK( 2, 1, 2, 1 ) ) ) );
+				}
+
+			} // SSE
+
+			template<>
+			inline void Multiply<4, 4, 4, float>( AE_Out float* const _Result, const float* const _A, const float* const _B )
+			{
+				const __m128 RowB0 = _mm_loadu_ps( _B );
+				const __m128 RowB1 = _mm_loadu_ps( _B + 4 );
+				const __m128 RowB2 = _mm_loadu_ps( _B + 8 );
+				const __m128 RowB3 = _mm_loadu_ps( _B + 12 );
+
+				// Each row of the result is the rows of B weighted by the row of A, read before being written.
+				for( Uint32 Row = 0; Row < 4; Row++ )
+				{
+					const __m128 RowA = _mm_loadu_ps( _A + Row * 4 );
+
+					__m128 Result = _mm_mul_ps( _mm_shuffle_ps( RowA, RowA, AE_SHUFFLE_MASK( 0, 0, 0, 0 ) ), RowB0 );
+					Result = _mm_add_ps( Result, _mm_mul_ps( _mm_shuffle_ps( RowA, RowA, AE_SHUFFLE_MASK( 1, 1, 1, 1 ) ), RowB1 ) );
+					Result = _mm_add_ps( Result, _mm_mul_ps( _mm_shuffle_ps( RowA, RowA, AE_SHUFFLE_MASK( 2, 2, 2, 2 ) ), RowB2 ) );
+					Result = _mm_add_ps( Result, _mm_mul_ps( _mm_shuffle_ps( RowA, RowA, AE_SHUFFLE_MASK( 3, 3, 3, 3 ) ), RowB3 ) );
+
+					_mm_storeu_ps( _Result + Row * 4, Result );
+				}
+			}
+
+			template<>
+			inline void Transpose<4, 4, float>( AE_Out float* const _Result, const float* const _Data )
+			{
+				__m128 Row0 = _mm_loadu_ps( _Data );
+				__m128 Row1 = _mm_loadu_ps( _Data + 4 );
+				__m128 Row2 = _mm_loadu_ps( _Data + 8 );
+				__m128 Row3 = _mm_loadu_ps( _Data + 12 );
+
+				_MM_TRANSPOSE4_PS( Row0, Row1, Row2, Row3 );
+
+				_mm_storeu_ps( _Result, Row0 );
+				_mm_storeu_ps( _Result + 4, Row1 );
+				_mm_storeu_ps( _Result + 8, Row2 );
+				_mm_storeu_ps( _Result + 12, Row3 );
+			}
+
+			template<>
+			inline Bool Inverse4x4<float>( AE_Out float* const _Result, const float* const _Data )
+			{
+				// Block inversion : the matrix is split in four 2x2 matrices | A B |
+				//                                                            | C D |
+				const __m128 Row0 = _mm_loadu_ps( _Data );
+				const __m128 Row1 = _mm_loadu_ps( _Data + 4 );
+				const __m128 Row2 = _mm_loadu_ps( _Data + 8 );
+				const __m128 Row3 = _mm_loadu_ps( _Data + 12 );
+
+				const __m128 A = _mm_movelh_ps( Row0, Row1 );
+				const __m128 B = _mm_movehl_ps( Row1, Row0 );
+				const __m128 C = _mm_movelh_ps( Row2, Row3 );
+				const __m128 D = _mm_movehl_ps( Row3, Row2 );
+
+				// Determinants ( |A|, |B|, |C|, |D| ).
+				const __m128 SubDeterminants = _mm_sub_ps( _mm_mul_ps( _mm_shuffle_ps( Row0, Row2, AE_SHUFFLE_MASK( 0, 2, 0, 2 ) ), _mm_shuffle_ps( Row1, Row3, AE_SHUFFLE_MASK( 1, 3, 1, 3 ) ) ),
+														   _mm_mul_ps( _mm_shuffle_ps( Row0, Row2, AE_SHUFFLE_MASK( 1, 3, 1, 3 ) ), _mm_shuffle_ps( Row1, Row3, AE_SHUFFLE_MASK( 0, 2, 0, 2 ) ) ) );
+
+				const __m128 DeterminantA = _mm_shuffle_ps( SubDeterminants, SubDeterminants, AE_SHUFFLE_MASK( 0, 0, 0, 0 ) );
+				const __m128 DeterminantB = _mm_shuffle_ps( SubDeterminants, SubDeterminants, AE_SHUFFLE_MASK( 1, 1, 1, 1 ) );
+				const __m128 DeterminantC = _mm_shuffle_ps( SubDeterminants, SubDeterminants, AE_SHUFFLE_MASK( 2, 2, 2, 2 ) );
+				const __m128 DeterminantD = _mm_shuffle_ps( SubDeterminants, SubDeterminants, AE_SHUFFLE_MASK( 3, 3, 3, 3 ) );
+
+				const __m128 AdjDC = SSE::AdjugateMultiply2x2( D, C );
+				const __m128 AdjAB = SSE::AdjugateMultiply2x2( A, B );
+
+				// Adjugates of the blocks of the inverse.
+				__m128 X = _mm_sub_ps( _mm_mul_ps( DeterminantD, A ), SSE::Multiply2x2( B, AdjDC ) );
+				__m128 W = _mm_sub_ps( _mm_mul_ps( DeterminantA, D ), SSE::Multiply2x2( C, AdjAB ) );
+				__m128 Y = _mm_sub_ps( _mm_mul_ps( DeterminantB, C ), SSE::MultiplyAdjugate2x2( D, AdjAB ) );
+				__m128 Z = _mm_sub_ps( _mm_mul_ps( DeterminantC, B ), SSE::MultiplyAdjugate2x2( A, AdjDC ) );
+
+				// |M| = |A| |D| + |B| |C| - trace( adj( A ) B adj( D ) C ).
+				__m128 Trace = _mm_mul_ps( AdjAB, _mm_shuffle_ps( AdjDC, AdjDC, AE_SHUFFLE_MASK( 0, 2, 1, 3 ) ) );
+				Trace = _mm_add_ps( Trace, _mm_movehl_ps( Trace, Trace ) );
+				Trace = _mm_add_ss( Trace, _mm_shuffle_ps( Trace, Trace, AE_SHUFFLE_MASK( 1, 1, 1, 1 ) ) );
+
+				__m128 Determinant = _mm_add_ss( _mm_mul_ss( DeterminantA, DeterminantD ), _mm_mul_ss( DeterminantB, DeterminantC ) );
+				Determinant = _mm_sub_ss( Determinant, Trace );
+
+				if( _mm_cvtss_f32( Determinant ) == 0.0f )
+					return False;
+
+				const __m128 InvDeterminant = _mm_div_ps( _mm_setr_ps( 1.0f, -1.0f, -1.0f, 1.0f ), _mm_shuffle_ps( Determinant, Determinant, AE_SHUFFLE_MASK( 0, 0, 0, 0 ) ) );
+
+				X = _mm_mul_ps( X, InvDeterminant );
+				Y = _mm_mul_ps( Y, InvDeterminant );
+				Z = _mm_mul_ps( Z, InvDeterminant );
+				W = _mm_mul_ps( W, InvDeterminant );
+
+				// The shuffles apply the last adjugate and put the blocks back in rows.
+				_mm_storeu_ps( _Result, _mm_shuffle_ps( X, Y, AE_SHUFFLE_MASK( 3, 1, 3, 1 ) ) );
+				_mm_storeu_ps( _Result + 4, _mm_shuffle_ps( X, Y, AE_SHUFFLE_MASK( 2, 0, 2, 0 ) ) );
+				_mm_storeu_ps( _Result + 8, _mm_shuffle_ps( Z, W, AE_SHUFFLE_MASK( 3, 1, 3, 1 ) ) );
+				_mm_storeu_ps( _Result + 12, _mm_shuffle_ps( Z, W, AE_SHUFFLE_MASK( 2, 0, 2, 0 ) ) );
+
+				return True;
+			}
+
+			template<>
+			inline void TransformPoints<float>( AE_Out float* const _Result, const float* const _Matrix, const float* const _Points, const Uint32 _CountPoints )
+			{
+				const float* const M = _Matrix;
+
+				const __m128 M00 = _mm_set1_ps( M[0] ), M01 = _mm_set1_ps( M[1] ), M02 = _mm_set1_ps( M[2] ), M03 = _mm_set1_ps( M[3] );
+				const __m128 M10 = _mm_set1_ps( M[4] ), M11 = _mm_set1_ps( M[5] ), M12 = _mm_set1_ps( M[6] ), M13 = _mm_set1_ps( M[7] );
+				const __m128 M20 = _mm_set1_ps( M[8] ), M21 = _mm_set1_ps( M[9] ), M22 = _mm_set1_ps( M[10] ), M23 = _mm_set1_ps( M[11] );
+
+				// Four points at once : the 12 floats are loaded in 3 registers, moved to x, y, z registers and back.
+				// The sums are in the order of the scalar version, the results are the same.
+				Uint32 Point = 0;
+				for( ; Point + 4 <= _CountPoints; Point += 4 )
+				{
+					const float* const Source = _Points + Point * 3;
+
+					const __m128 P0 = _mm_loadu_ps( Source );		// x0 y0 z0 x1
+					const __m128 P1 = _mm_loadu_ps( Source + 4 );	// y1 z1 x2 y2
+					const __m128 P2 = _mm_loadu_ps( Source + 8 );	// z2 x3 y3 z3
+
+					const __m128 X2Y2X3Y3 = _mm_shuffle_ps( P1, P2, AE_SHUFFLE_MASK( 2, 3, 1, 2 ) );
+					const __m128 Y0Z0Y1Z1 = _mm_shuffle_ps( P0, P1, AE_SHUFFLE_MASK( 1, 2, 0, 1 ) );
+
+					const __m128 X = _mm_shuffle_ps( P0, X2Y2X3Y3, AE_SHUFFLE_MASK( 0, 3, 0, 2 ) );
+					const __m128 Y = _mm_shuffle_ps( Y0Z0Y1Z1, X2Y2X3Y3, AE_SHUFFLE_MASK( 0, 2, 1, 3 ) );
+					const __m128 Z = _mm_shuffle_ps( Y0Z0Y1Z1, P2, AE_SHUFFLE_MASK( 1, 3, 0, 3 ) );
+
+					const __m128 RX = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( X, M00 ), _mm_mul_ps( Y, M01 ) ), _mm_mul_ps( Z, M02 ) ), M03 );
+					const __m128 RY = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( X, M10 ), _mm_mul_ps( Y, M11 ) ), _mm_mul_ps( Z, M12 ) ), M13 );
+					const __m128 RZ = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( X, M20 ), _mm_mul_ps( Y, M21 ) ), _mm_mul_ps( Z, M22 ) ), M23 );
+
+					const __m128 ResultXY01 = _mm_unpacklo_ps( RX, RY );	// x0 y0 x1 y1
+					const __m128 ResultXY23 = _mm_unpackhi_ps( RX, RY );	// x2 y2 x3 y3
+
+					float* const Destination = _Result + Point * 3;
+
+					_mm_storeu_ps( Destination, _mm_shuffle_ps( ResultXY01, _mm_shuffle_ps( RZ, ResultXY01, AE_SHUFFLE_MASK( 0, 0, 2, 2 ) ), AE_SHUFFLE_MASK( 0, 1, 0, 2 ) ) );
+					_mm_storeu_ps( Destination + 4, _mm_shuffle_ps( _mm_shuffle_ps( ResultXY01, RZ, AE_SHUFFLE_MASK( 3, 3, 1, 1 ) ), ResultXY23, AE_SHUFFLE_MASK( 0, 2, 0, 1 ) ) );
+					_mm_storeu_ps( Destination + 8, _mm_shuffle_ps( _mm_shuffle_ps( RZ, ResultXY23, AE_SHUFFLE_MASK( 2, 2, 2, 2 ) ), _mm_shuffle_ps( ResultXY23, RZ, AE_SHUFFLE_MASK( 3, 3, 3, 3 ) ), AE_SHUFFLE_MASK( 0, 2, 0, 2 ) ) );
+				}
+
+				for( ; Point < _CountPoints; Point++ )
+				{
+					const float X = _Points[Point * 3];
+					const float Y = _Points[Point * 3 + 1];
+					const float Z = _Points[Point * 3 + 2];
+
+					_Result[Point * 3] = X * M[0] + Y * M[1] + Z * M[2] + M[3];
+					_Result[Point * 3 + 1] = X * M[4] + Y * M[5] + Z * M[6] + M[7];
+					_Result[Point * 3 + 2] = X * M[8] + Y * M[9] + Z * M[10] + M[11];
+				}
+			}
+
+			#undef AE_SHUFFLE_MASK
+#endif
+
 		} // MatrixToolbox
 
 	} // priv
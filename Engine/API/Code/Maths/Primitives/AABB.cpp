@@ -0,0 +1,150 @@
+#include "AABB.h"
+
+#include "../Functions/MathsFunctions.h"
+#include "../Matrix/Matrix4x4.h"
+
+namespace ae
+{
+
+    AABB::AABB() :
+        m_Min( Math::Max<float>(), Math::Max<float>(), Math::Max<float>() ),
+        m_Max( -Math::Max<float>(), -Math::Max<float>(), -Math::Max<float>() )
+    {
+    }
+
+    AABB::AABB( const Vector3& _Min, const Vector3& _Max ) :
+        m_Min( _Min ),
+        m_Max( _Max )
+    {
+    }
+
+    void AABB::SetMin( const Vector3& _Min )
+    {
+        m_Min = _Min;
+    }
+
+    const Vector3& AABB::GetMin() const
+    {
+        return m_Min;
+    }
+
+    void AABB::SetMax( const Vector3& _Max )
+    {
+        m_Max = _Max;
+    }
+
+    const Vector3& AABB::GetMax() const
+    {
+        return m_Max;
+    }
+
+    Vector3 AABB::GetCenter() const
+    {
+        return Vector3( ( m_Min.X + m_Max.X ) * 0.5f, ( m_Min.Y + m_Max.Y ) * 0.5f, ( m_Min.Z + m_Max.Z ) * 0.5f );
+    }
+
+    Vector3 AABB::GetExtents() const
+    {
+        return Vector3( ( m_Max.X - m_Min.X ) * 0.5f, ( m_Max.Y - m_Min.Y ) * 0.5f, ( m_Max.Z - m_Min.Z ) * 0.5f );
+    }
+
+    Bool AABB::IsValid() const
+    {
+        return m_Min.X <= m_Max.X && m_Min.Y <= m_Max.Y && m_Min.Z <= m_Max.Z;
+    }
+
+    void AABB::Reset()
+    {
+        *this = AABB();
+    }
+
+    void AABB::Grow( const Vector3& _Point )
+    {
+        m_Min.X = Math::Min( m_Min.X, _Point.X );
+        m_Min.Y = Math::Min( m_Min.Y, _Point.Y );
+        m_Min.Z = Math::Min( m_Min.Z, _Point.Z );
+
+        m_Max.X = Math::Max( m_Max.X, _Point.X );
+        m_Max.Y = Math::Max( m_Max.Y, _Point.Y );
+        m_Max.Z = Math::Max( m_Max.Z, _Point.Z );
+    }
+
+    void AABB::Grow( const AABB& _Other )
+    {
+        if( !_Other.IsValid() )
+            return;
+
+        Grow( _Other.m_Min );
+        Grow( _Other.m_Max );
+    }
+
+    Bool AABB::Intersects( const AABB& _Other ) const
+    {
+        if( !IsValid() || !_Other.IsValid() )
+            return False;
+
+        return m_Min.X <= _Other.m_Max.X && m_Max.X >= _Other.m_Min.X &&
+               m_Min.Y <= _Other.m_Max.Y && m_Max.Y >= _Other.m_Min.Y &&
+               m_Min.Z <= _Other.m_Max.Z && m_Max.Z >= _Other.m_Min.Z;
+    }
+
+    Bool AABB::Contains( const Vector3& _Point ) const
+    {
+        return _Point.X >= m_Min.X && _Point.X <= m_Max.X &&
+               _Point.Y >= m_Min.Y && _Point.Y <= m_Max.Y &&
+               _Point.Z >= m_Min.Z && _Point.Z <= m_Max.Z;
+    }
+
+    Bool AABB::Contains( const AABB& _Other ) const
+    {
+        return _Other.m_Min.X >= m_Min.X && _Other.m_Max.X <= m_Max.X &&
+               _Other.m_Min.Y >= m_Min.Y && _Other.m_Max.Y <= m_Max.Y &&
+               _Other.m_Min.Z >= m_Min.Z && _Other.m_Max.Z <= m_Max.Z;
+    }
+
+    float AABB::GetSurfaceArea() const
+    {
+        if( !IsValid() )
+            return 0.0f;
+
+        const float SizeX = m_Max.X - m_Min.X;
+        const float SizeY = m_Max.Y - m_Min.Y;
+        const float SizeZ = m_Max.Z - m_Min.Z;
+
+        return 2.0f * ( SizeX * SizeY + SizeY * SizeZ + SizeZ * SizeX );
+    }
+
+    AABB AABB::GetTransformed( const Matrix4x4& _Transform ) const
+    {
+        if( !IsValid() )
+            return AABB();
+
+        // Transform the center, then project the extents on each axis of the transform (Arvo).
+        const float* const M = _Transform.GetData();
+        const Vector3 Center = GetCenter();
+        const Vector3 Extents = GetExtents();
+
+        float NewCenter[3];
+        float NewExtents[3];
+
+        for( Uint32 r = 0; r < 3; r++ )
+        {
+            const float* const Row = M + r * 4;
+
+            NewCenter[r] = Row[0] * Center.X + Row[1] * Center.Y + Row[2] * Center.Z + Row[3];
+            NewExtents[r] = Math::Abs( Row[0] ) * Extents.X + Math::Abs( Row[1] ) * Extents.Y + Math::Abs( Row[2] ) * Extents.Z;
+        }
+
+        return AABB( Vector3( NewCenter[0] - NewExtents[0], NewCenter[1] - NewExtents[1], NewCenter[2] - NewExtents[2] ),
+                     Vector3( NewCenter[0] + NewExtents[0], NewCenter[1] + NewExtents[1], NewCenter[2] + NewExtents[2] ) );
+    }
+
+    Sphere AABB::GetBoundingSphere() const
+    {
+        if( !IsValid() )
+            return Sphere( Vector3::Zero, -1.0f );
+
+        return Sphere( GetCenter(), GetExtents().Length() );
+    }
+
+} // ae
@@ -0,0 +1,107 @@
+#pragma once
+
+
+
+#include "../../Toolbox/Toolbox.h"
+#include "../Vector/Vector3.h"
+#include "Sphere.h"
+
+namespace ae
+{
+    class Matrix4x4;
+
+    /// \ingroup math
+    /// <summary>
+    /// 3D axis aligned bounding box represented by its minimum and maximum corners.<para/>
+    /// A default box is invalid (empty) : growing it with a point makes it contain only this point.
+    /// </summary>
+    class AERO_CORE_EXPORT AABB
+    {
+    public:
+        /// <summary>Build an invalid (empty) box.</summary>
+        AABB();
+
+        /// <summary>Build a box from its corners.</summary>
+        /// <param name="_Min">The minimum corner of the box.</param>
+        /// <param name="_Max">The maximum corner of the box.</param>
+        AABB( const Vector3& _Min, const Vector3& _Max );
+
+        /// <summary>Set the minimum corner of the box.</summary>
+        /// <param name="_Min">The new minimum corner of the box.</param>
+        void SetMin( const Vector3& _Min );
+
+        /// <summary>Retrieve the minimum corner of the box.</summary>
+        /// <returns>The minimum corner of the box.</returns>
+        const Vector3& GetMin() const;
+
+        /// <summary>Set the maximum corner of the box.</summary>
+        /// <param name="_Max">The new maximum corner of the box.</param>
+        void SetMax( const Vector3& _Max );
+
+        /// <summary>Retrieve the maximum corner of the box.</summary>
+        /// <returns>The maximum corner of the box.</returns>
+        const Vector3& GetMax() const;
+
+        /// <summary>Retrieve the center of the box.</summary>
+        /// <returns>The center of the box.</returns>
+        Vector3 GetCenter() const;
+
+        /// <summary>Retrieve the half size of the box in each axis.</summary>
+        /// <returns>The half size of the box.</returns>
+        Vector3 GetExtents() const;
+
+        /// <summary>Is the box containing at least one point ?</summary>
+        /// <returns>True if the minimum corner is not above the maximum one, False otherwise.</returns>
+        Bool IsValid() const;
+
+        /// <summary>Make the box invalid (empty).</summary>
+        void Reset();
+
+        /// <summary>Grow the box to contain a point.</summary>
+        /// <param name="_Point">The point to contain.</param>
+        void Grow( const Vector3& _Point );
+
+        /// <summary>Grow the box to contain another box. Invalid boxes are ignored.</summary>
+        /// <param name="_Other">The box to contain.</param>
+        void Grow( const AABB& _Other );
+
+        /// <summary>
+        /// Test if the box is intersecting the <paramref name="_Other"/> box.<para/>
+        /// Boxes touching on their faces are intersecting. Invalid boxes intersect nothing.
+        /// </summary>
+        /// <param name="_Other">The other box to do the intersection test with.</param>
+        /// <returns>True if the boxes are intersecting each other, False otherwise.</returns>
+        Bool Intersects( const AABB& _Other ) const;
+
+        /// <summary>Test if the box contains the <paramref name="_Point"/>, boundaries included.</summary>
+        /// <param name="_Point">The point to test.</param>
+        /// <returns>True if the <paramref name="_Point"/> is inside the box, False otherwise.</returns>
+        Bool Contains( const Vector3& _Point ) const;
+
+        /// <summary>Test if the box entirely contains the <paramref name="_Other"/> box, boundaries included.</summary>
+        /// <param name="_Other">The box to test.</param>
+        /// <returns>True if the <paramref name="_Other"/> box is inside the box, False otherwise.</returns>
+        Bool Contains( const AABB& _Other ) const;
+
+        /// <summary>Get the area of the faces of the box, the cost of a box in the bounding volume hierarchies.</summary>
+        /// <returns>Surface area of the box, 0 for an invalid box.</returns>
+        float GetSurfaceArea() const;
+
+        /// <summary>Get the box containing this box once transformed. An invalid box stays invalid.</summary>
+        /// <param name="_Transform">The transform to apply to the box.</param>
+        /// <returns>The axis aligned box containing the transformed box.</returns>
+        AABB GetTransformed( const Matrix4x4& _Transform ) const;
+
+        /// <summary>Get the sphere containing the box, centered on the box.</summary>
+        /// <returns>The bounding sphere of the box. Radius of -1 for an invalid box.</returns>
+        Sphere GetBoundingSphere() const;
+
+    private:
+        /// <summary>The minimum corner of the box.</summary>
+        Vector3 m_Min;
+
+        /// <summary>The maximum corner of the box.</summary>
+        Vector3 m_Max;
+    };
+
+} // ae
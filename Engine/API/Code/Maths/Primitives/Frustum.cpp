@@ -0,0 +1,134 @@
+#include "Frustum.h"
+
+#include "AABB.h"
+#include "Sphere.h"
+#include "../Functions/MathsFunctions.h"
+#include "../Matrix/Matrix4x4.h"
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __SSE2__ )
+#define AE_FRUSTUM_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace ae
+{
+
+    Frustum::Frustum()
+    {
+        for( Uint32 p = 0; p < PaddedPlanesCount; p++ )
+        {
+            m_NormalsX[p] = 0.0f;
+            m_NormalsY[p] = 0.0f;
+            m_NormalsZ[p] = 0.0f;
+            m_Distances[p] = 1.0f;
+        }
+    }
+
+    Frustum::Frustum( const Matrix4x4& _ViewProjection ) :
+        Frustum()
+    {
+        SetFromMatrix( _ViewProjection );
+    }
+
+    void Frustum::SetFromMatrix( const Matrix4x4& _ViewProjection )
+    {
+        // Gribb / Hartmann : each plane is the sum or the difference of the last row with one of the others.
+        const Matrix4x4& M = _ViewProjection;
+
+        const float Signs[2] = { 1.0f, -1.0f };
+
+        for( Uint32 p = 0; p < Cast( Uint32, PlaneIndex::Count ); p++ )
+        {
+            const Uint32 Row = p / 2;
+            const float Sign = Signs[p % 2];
+
+            const float X = M( 3, 0 ) + Sign * M( Row, 0 );
+            const float Y = M( 3, 1 ) + Sign * M( Row, 1 );
+            const float Z = M( 3, 2 ) + Sign * M( Row, 2 );
+            const float W = M( 3, 3 ) + Sign * M( Row, 3 );
+
+            // Normalized so the tests compare real distances with the radius and the extents.
+            const float InvLength = 1.0f / Math::Max( std::sqrt( X * X + Y * Y + Z * Z ), Math::Epsilon() );
+
+            m_NormalsX[p] = X * InvLength;
+            m_NormalsY[p] = Y * InvLength;
+            m_NormalsZ[p] = Z * InvLength;
+            m_Distances[p] = W * InvLength;
+        }
+    }
+
+    Plane Frustum::GetPlane( PlaneIndex _Index ) const
+    {
+        const Uint32 p = Math::Min( Cast( Uint32, _Index ), Cast( Uint32, PlaneIndex::Count ) - 1 );
+        const Vector3 Normal( m_NormalsX[p], m_NormalsY[p], m_NormalsZ[p] );
+
+        return Plane( Normal * -m_Distances[p], Normal );
+    }
+
+    Bool Frustum::Intersects( const AABB& _Box ) const
+    {
+        if( !_Box.IsValid() )
+            return False;
+
+        return IntersectsCenterExtents( _Box.GetCenter(), _Box.GetExtents(), 0.0f );
+    }
+
+    Bool Frustum::Intersects( const Sphere& _Sphere ) const
+    {
+        if( _Sphere.GetRadius() < 0.0f )
+            return False;
+
+        return IntersectsCenterExtents( _Sphere.GetCenter(), Vector3::Zero, _Sphere.GetRadius() );
+    }
+
+    Bool Frustum::IntersectsCenterExtents( const Vector3& _Center, const Vector3& _Extents, float _Radius ) const
+    {
+        // The volume is outside when it is entirely behind one plane :
+        // distance of the center + projection of the extents on the normal + radius < 0.
+#ifdef AE_FRUSTUM_SSE
+        const __m128 CenterX = _mm_set1_ps( _Center.X );
+        const __m128 CenterY = _mm_set1_ps( _Center.Y );
+        const __m128 CenterZ = _mm_set1_ps( _Center.Z );
+        const __m128 ExtentsX = _mm_set1_ps( _Extents.X );
+        const __m128 ExtentsY = _mm_set1_ps( _Extents.Y );
+        const __m128 ExtentsZ = _mm_set1_ps( _Extents.Z );
+        const __m128 Radius = _mm_set1_ps( _Radius );
+        const __m128 SignMask = _mm_set1_ps( -0.0f );
+        const __m128 Zero = _mm_setzero_ps();
+
+        for( Uint32 p = 0; p < PaddedPlanesCount; p += 4 )
+        {
+            const __m128 NormalX = _mm_load_ps( m_NormalsX + p );
+            const __m128 NormalY = _mm_load_ps( m_NormalsY + p );
+            const __m128 NormalZ = _mm_load_ps( m_NormalsZ + p );
+
+            __m128 Distance = _mm_load_ps( m_Distances + p );
+            Distance = _mm_add_ps( Distance, _mm_mul_ps( NormalX, CenterX ) );
+            Distance = _mm_add_ps( Distance, _mm_mul_ps( NormalY, CenterY ) );
+            Distance = _mm_add_ps( Distance, _mm_mul_ps( NormalZ, CenterZ ) );
+
+            __m128 Projection = Radius;
+            Projection = _mm_add_ps( Projection, _mm_mul_ps( _mm_andnot_ps( SignMask, NormalX ), ExtentsX ) );
+            Projection = _mm_add_ps( Projection, _mm_mul_ps( _mm_andnot_ps( SignMask, NormalY ), ExtentsY ) );
+            Projection = _mm_add_ps( Projection, _mm_mul_ps( _mm_andnot_ps( SignMask, NormalZ ), ExtentsZ ) );
+
+            if( _mm_movemask_ps( _mm_cmplt_ps( _mm_add_ps( Distance, Projection ), Zero ) ) != 0 )
+                return False;
+        }
+
+        return True;
+#else
+        for( Uint32 p = 0; p < Cast( Uint32, PlaneIndex::Count ); p++ )
+        {
+            const float Distance = m_NormalsX[p] * _Center.X + m_NormalsY[p] * _Center.Y + m_NormalsZ[p] * _Center.Z + m_Distances[p];
+            const float Projection = Math::Abs( m_NormalsX[p] ) * _Extents.X + Math::Abs( m_NormalsY[p] ) * _Extents.Y + Math::Abs( m_NormalsZ[p] ) * _Extents.Z + _Radius;
+
+            if( Distance + Projection < 0.0f )
+                return False;
+        }
+
+        return True;
+#endif
+    }
+
+} // ae
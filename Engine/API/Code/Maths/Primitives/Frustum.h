@@ -0,0 +1,101 @@
+#pragma once
+
+
+
+#include "../../Toolbox/Toolbox.h"
+#include "../Vector/Vector3.h"
+#include "Plane.h"
+
+namespace ae
+{
+    class Matrix4x4;
+    class AABB;
+    class Sphere;
+
+    /// \ingroup math
+    /// <summary>
+    /// Volume seen by a camera, bounded by six planes with their normals toward the inside.<para/>
+    /// The planes are stored by component to test a volume against four planes at once with SSE.
+    /// </summary>
+    class AERO_CORE_EXPORT Frustum
+    {
+    public:
+        /// <summary>Index of each plane of the frustum.</summary>
+        enum class PlaneIndex : Uint8
+        {
+            /// <summary>Left plane.</summary>
+            Left,
+            /// <summary>Right plane.</summary>
+            Right,
+            /// <summary>Bottom plane.</summary>
+            Bottom,
+            /// <summary>Top plane.</summary>
+            Top,
+            /// <summary>Near plane.</summary>
+            Near,
+            /// <summary>Far plane.</summary>
+            Far,
+
+            /// <summary>Count of planes, for internal use.</summary>
+            Count
+        };
+
+    public:
+        /// <summary>Build a frustum containing everything.</summary>
+        Frustum();
+
+        /// <summary>Build the frustum of a view projection matrix.</summary>
+        /// <param name="_ViewProjection">Projection * View (* Model to get the frustum in model space).</param>
+        Frustum( const Matrix4x4& _ViewProjection );
+
+        /// <summary>Extract the planes of the frustum from a view projection matrix (OpenGL clip space, Gribb / Hartmann).</summary>
+        /// <param name="_ViewProjection">Projection * View (* Model to get the frustum in model space).</param>
+        void SetFromMatrix( const Matrix4x4& _ViewProjection );
+
+        /// <summary>Retrieve one plane of the frustum.</summary>
+        /// <param name="_Index">The plane to retrieve.</param>
+        /// <returns>The plane, normal toward the inside of the frustum.</returns>
+        Plane GetPlane( PlaneIndex _Index ) const;
+
+        /// <summary>
+        /// Test if a box is at least partially inside the frustum.<para/>
+        /// Conservative : a box outside the frustum but close to a corner can be considered inside.
+        /// </summary>
+        /// <param name="_Box">The box to test. An invalid box is never inside.</param>
+        /// <returns>True if the box is inside or intersecting the frustum, False otherwise.</returns>
+        Bool Intersects( const AABB& _Box ) const;
+
+        /// <summary>
+        /// Test if a sphere is at least partially inside the frustum.<para/>
+        /// Conservative : a sphere outside the frustum but close to a corner can be considered inside.
+        /// </summary>
+        /// <param name="_Sphere">The sphere to test.</param>
+        /// <returns>True if the sphere is inside or intersecting the frustum, False otherwise.</returns>
+        Bool Intersects( const Sphere& _Sphere ) const;
+
+    private:
+        /// <summary>Test a box given by its center and its half size against the planes.</summary>
+        /// <param name="_Center">Center of the box.</param>
+        /// <param name="_Extents">Half size of the box.</param>
+        /// <param name="_Radius">Extra distance to add to the box, for the spheres.</param>
+        /// <returns>True if the box is not entirely behind one of the planes.</returns>
+        Bool IntersectsCenterExtents( const Vector3& _Center, const Vector3& _Extents, float _Radius ) const;
+
+    private:
+        /// <summary>Count of planes stored, padded to a multiple of 4 for SSE.</summary>
+        static constexpr Uint32 PaddedPlanesCount = 8;
+
+        /// <summary>X component of the normals of the planes.</summary>
+        alignas( 16 ) float m_NormalsX[PaddedPlanesCount];
+
+        /// <summary>Y component of the normals of the planes.</summary>
+        alignas( 16 ) float m_NormalsY[PaddedPlanesCount];
+
+        /// <summary>Z component of the normals of the planes.</summary>
+        alignas( 16 ) float m_NormalsZ[PaddedPlanesCount];
+
+        /// <summary>Signed distance of the origin to the planes. The padding planes have a null normal and a positive distance : everything is inside.</summary>
+        alignas( 16 ) float m_Distances[PaddedPlanesCount];
+    };
+
+} // ae
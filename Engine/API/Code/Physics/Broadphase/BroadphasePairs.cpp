@@ -0,0 +1,111 @@
+#include "BroadphasePairs.h"
+
+#include "../../Toolbox/JobSystem/JobSystem.h"
+
+#include <algorithm>
+
+namespace ae
+{
+    namespace priv
+    {
+        constexpr Uint32 BroadphasePairs::MovedPerJob;
+
+        BroadphasePairs::BroadphasePairs( float _Margin ) :
+            m_Tree( _Margin )
+        {
+        }
+
+        Uint32 BroadphasePairs::CreateProxy( const AABB& _Bounds )
+        {
+            const Uint32 Proxy = m_Tree.CreateProxy( _Bounds, 0 );
+
+            if( Proxy >= m_IsAlive.size() )
+                m_IsAlive.resize( Proxy + 1, 0 );
+
+            m_IsAlive[Proxy] = 1;
+            m_MoveBuffer.push_back( Proxy );
+
+            return Proxy;
+        }
+
+        void BroadphasePairs::DestroyProxy( Uint32 _Proxy )
+        {
+            // Its pairs are removed with the stale ones, the proxy can be reused before.
+            m_Tree.DestroyProxy( _Proxy );
+            m_IsAlive[_Proxy] = 0;
+        }
+
+        Bool BroadphasePairs::MoveProxy( Uint32 _Proxy, const AABB& _Bounds, const Vector3& _Displacement )
+        {
+            if( !m_Tree.MoveProxy( _Proxy, _Bounds, _Displacement ) )
+                return False;
+
+            m_MoveBuffer.push_back( _Proxy );
+            return True;
+        }
+
+        Uint32 BroadphasePairs::GetProxyCount() const
+        {
+            return m_Tree.GetProxyCount();
+        }
+
+        Bool BroadphasePairs::FindNewPairs( JobSystem& _Jobs )
+        {
+            if( m_MoveBuffer.empty() )
+                return False;
+
+            const Uint32 MovedCount = Cast( Uint32, m_MoveBuffer.size() );
+            const Uint32 JobsCount = ( MovedCount + MovedPerJob - 1 ) / MovedPerJob;
+
+            if( m_JobPairs.size() < JobsCount )
+                m_JobPairs.resize( JobsCount );
+
+            _Jobs.ParallelFor( 0, MovedCount, MovedPerJob, [this]( Uint32 _Begin, Uint32 _End )
+            {
+                std::vector<Uint64>& Pairs = m_JobPairs[_Begin / MovedPerJob];
+                Pairs.clear();
+
+                for( Uint32 m = _Begin; m < _End; m++ )
+                {
+                    const Uint32 Proxy = m_MoveBuffer[m];
+
+                    // Removed since it has been moved.
+                    if( !IsAlive( Proxy ) )
+                        continue;
+
+                    m_Tree.Query( m_Tree.GetFatBounds( Proxy ), [&]( Uint32 _Other )
+                    {
+                        if( _Other != Proxy )
+                            Pairs.push_back( MakePair( Proxy, _Other ) );
+                    } );
+                }
+            } );
+
+            m_MoveBuffer.clear();
+
+            for( Uint32 Job = 0; Job < JobsCount; Job++ )
+                m_Pairs.insert( m_Pairs.end(), m_JobPairs[Job].cbegin(), m_JobPairs[Job].cend() );
+
+            // Two moved proxies find their pair twice, a pair already known is found again.
+            std::sort( m_Pairs.begin(), m_Pairs.end() );
+            m_Pairs.erase( std::unique( m_Pairs.begin(), m_Pairs.end() ), m_Pairs.end() );
+
+            return True;
+        }
+
+        void BroadphasePairs::RemoveStalePairs()
+        {
+            m_Pairs.erase( std::remove_if( m_Pairs.begin(), m_Pairs.end(), [this]( Uint64 _Pair )
+            {
+                const Uint32 ProxyA = GetFirstProxy( _Pair );
+                const Uint32 ProxyB = GetSecondProxy( _Pair );
+
+                // A removed proxy can have been reused : the pair is kept only if the new one overlaps too.
+                return !IsAlive( ProxyA ) || !IsAlive( ProxyB ) ||
+                       !m_Tree.GetFatBounds( ProxyA ).Intersects( m_Tree.GetFatBounds( ProxyB ) );
+            } ), m_Pairs.end() );
+        }
+
+    } // priv
+
+} // ae
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "../../Toolbox/Toolbox.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+#include "DynamicAABBTree.h"
+
+#include <vector>
+
+namespace ae
+{
+    class JobSystem;
+
+    namespace priv
+    {
+        /// \ingroup physics
+        /// <summary>
+        /// Pairs of proxies of a dynamic AABB tree whose enlarged boxes overlap, kept from frame to frame. <para/>
+        /// The proxies created or moved in the tree go to the move buffer : only they are queried to find the new pairs.
+        /// The pairs of a removed proxy or whose enlarged boxes do not overlap anymore are removed on demand.
+        /// </summary>
+        /// <remarks>
+        /// A pair is a key of 64 bits, the lower proxy in the high bits : the pairs are sorted, without duplicate.
+        /// A removed proxy can be reused by the next created one, before its pairs are removed.
+        /// </remarks>
+        class AERO_CORE_EXPORT BroadphasePairs : public NotCopiable
+        {
+        public:
+            /// <summary>Build an empty broadphase.</summary>
+            /// <param name="_Margin">Distance added around the boxes of the proxies, the more the less they must be moved.</param>
+            explicit BroadphasePairs( float _Margin = 0.0f );
+
+            /// <summary>Add a proxy, its pairs are found at the next query.</summary>
+            /// <param name="_Bounds">Box of the proxy.</param>
+            /// <returns>Index of the proxy.</returns>
+            Uint32 CreateProxy( const AABB& _Bounds );
+
+            /// <summary>Remove a proxy, its pairs are removed with the stale ones.</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            void DestroyProxy( Uint32 _Proxy );
+
+            /// <summary>Update the box of a proxy. If it goes out of its enlarged box, the proxy is moved in the tree and its pairs are found at the next query.</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            /// <param name="_Bounds">New box of the proxy.</param>
+            /// <param name="_Displacement">Expected move of the box, the enlarged box is stretched in its direction.</param>
+            /// <returns>True if the proxy has been moved in the tree, False otherwise.</returns>
+            Bool MoveProxy( Uint32 _Proxy, const AABB& _Bounds, const Vector3& _Displacement );
+
+            /// <summary>Get the enlarged box of a proxy.</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            /// <returns>Box stored in the tree for the proxy.</returns>
+            inline const AABB& GetFatBounds( Uint32 _Proxy ) const
+            {
+                return m_Tree.GetFatBounds( _Proxy );
+            }
+
+            /// <summary>Get the count of proxies.</summary>
+            /// <returns>Count of proxies in the tree.</returns>
+            Uint32 GetProxyCount() const;
+
+            /// <summary>Query the tree with the proxies of the move buffer and add the pairs found. The move buffer is emptied.</summary>
+            /// <param name="_Jobs">Job system to query the tree on.</param>
+            /// <returns>True if the move buffer had proxies, False otherwise.</returns>
+            Bool FindNewPairs( JobSystem& _Jobs );
+
+            /// <summary>Remove the pairs of a removed proxy or whose enlarged boxes do not overlap anymore.</summary>
+            void RemoveStalePairs();
+
+            /// <summary>Get the pairs found.</summary>
+            /// <returns>Pairs of proxies whose enlarged boxes overlap, sorted. Can hold stale pairs until RemoveStalePairs is called.</returns>
+            inline const std::vector<Uint64>& GetPairs() const
+            {
+                return m_Pairs;
+            }
+
+            /// <summary>Key of a pair of proxies, the same whatever their order.</summary>
+            /// <param name="_ProxyA">A proxy of the pair.</param>
+            /// <param name="_ProxyB">The other proxy of the pair.</param>
+            /// <returns>Key of the pair.</returns>
+            static inline Uint64 MakePair( Uint32 _ProxyA, Uint32 _ProxyB )
+            {
+                return _ProxyA < _ProxyB ? ( Cast( Uint64, _ProxyA ) << 32 ) | _ProxyB : ( Cast( Uint64, _ProxyB ) << 32 ) | _ProxyA;
+            }
+
+            /// <summary>Lower proxy of a pair.</summary>
+            /// <param name="_Pair">Key of the pair.</param>
+            /// <returns>Index of the proxy.</returns>
+            static inline Uint32 GetFirstProxy( Uint64 _Pair )
+            {
+                return Cast( Uint32, _Pair >> 32 );
+            }
+
+            /// <summary>Higher proxy of a pair.</summary>
+            /// <param name="_Pair">Key of the pair.</param>
+            /// <returns>Index of the proxy.</returns>
+            static inline Uint32 GetSecondProxy( Uint64 _Pair )
+            {
+                return Cast( Uint32, _Pair & 0xFFFFFFFF );
+            }
+
+        private:
+            /// <summary>Count of moved proxies per job to query the tree.</summary>
+            static constexpr Uint32 MovedPerJob = 64;
+
+            /// <summary>Is a proxy in the tree ?</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            /// <returns>True if the proxy has been created and not removed since, False otherwise.</returns>
+            inline Bool IsAlive( Uint32 _Proxy ) const
+            {
+                return m_IsAlive[_Proxy] != 0;
+            }
+
+        private:
+            /// <summary>Tree of the proxies.</summary>
+            DynamicAABBTree m_Tree;
+
+            /// <summary>Is each proxy in the tree ? The nodes of the removed proxies are reused.</summary>
+            std::vector<Uint8> m_IsAlive;
+
+            /// <summary>Proxies moved in the tree or created since the last query, their pairs must be found again.</summary>
+            std::vector<Uint32> m_MoveBuffer;
+
+            /// <summary>Pairs of proxies whose enlarged boxes overlap, the lower proxy in the high bits. Sorted, without duplicate.</summary>
+            std::vector<Uint64> m_Pairs;
+
+            /// <summary>Pairs found by each query job.</summary>
+            std::vector<std::vector<Uint64>> m_JobPairs;
+        };
+
+    } // priv
+
+} // ae
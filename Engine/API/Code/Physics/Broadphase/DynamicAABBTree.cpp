@@ -0,0 +1,380 @@
+#include "DynamicAABBTree.h"
+
+#include "../../Maths/Functions/MathsFunctions.h"
+
+namespace ae
+{
+    namespace priv
+    {
+        namespace
+        {
+            /// <summary>Box containing two boxes.</summary>
+            inline AABB Union( const AABB& _A, const AABB& _B )
+            {
+                AABB Result = _A;
+                Result.Grow( _B );
+                return Result;
+            }
+        }
+
+        constexpr Uint32 DynamicAABBTree::InvalidProxy;
+        constexpr Uint32 DynamicAABBTree::MaxQueryDepth;
+
+        DynamicAABBTree::DynamicAABBTree( float _Margin ) :
+            m_Root( InvalidProxy ),
+            m_FreeList( InvalidProxy ),
+            m_ProxyCount( 0 ),
+            m_Margin( _Margin )
+        {
+        }
+
+        Uint32 DynamicAABBTree::CreateProxy( const AABB& _Bounds, Uint32 _UserData )
+        {
+            const Uint32 Proxy = AllocateNode();
+
+            Node& Leaf = m_Nodes[Proxy];
+            Leaf.Bounds = Enlarge( _Bounds, Vector3::Zero );
+            Leaf.UserData = _UserData;
+            Leaf.Height = 0;
+
+            InsertLeaf( Proxy );
+            m_ProxyCount++;
+
+            return Proxy;
+        }
+
+        void DynamicAABBTree::DestroyProxy( Uint32 _Proxy )
+        {
+            if( _Proxy >= m_Nodes.size() || !m_Nodes[_Proxy].IsLeaf() || m_Nodes[_Proxy].Height < 0 )
+            {
+                AE_LogError( "Invalid proxy to remove from the tree." );
+                return;
+            }
+
+            RemoveLeaf( _Proxy );
+            FreeNode( _Proxy );
+            m_ProxyCount--;
+        }
+
+        Bool DynamicAABBTree::MoveProxy( Uint32 _Proxy, const AABB& _Bounds, const Vector3& _Displacement )
+        {
+            // Still inside of its enlarged box : nothing to change in the tree.
+            if( m_Nodes[_Proxy].Bounds.Contains( _Bounds ) )
+                return False;
+
+            RemoveLeaf( _Proxy );
+            m_Nodes[_Proxy].Bounds = Enlarge( _Bounds, _Displacement );
+            InsertLeaf( _Proxy );
+
+            return True;
+        }
+
+        void DynamicAABBTree::Translate( const Vector3& _Offset )
+        {
+            for( Node& Current : m_Nodes )
+            {
+                if( Current.Height < 0 )
+                    continue;
+
+                Current.Bounds = AABB( Current.Bounds.GetMin() + _Offset, Current.Bounds.GetMax() + _Offset );
+            }
+        }
+
+        void DynamicAABBTree::Clear()
+        {
+            m_Nodes.clear();
+            m_Root = InvalidProxy;
+            m_FreeList = InvalidProxy;
+            m_ProxyCount = 0;
+        }
+
+        Uint32 DynamicAABBTree::GetProxyCount() const
+        {
+            return m_ProxyCount;
+        }
+
+        Uint32 DynamicAABBTree::GetHeight() const
+        {
+            return m_Root != InvalidProxy ? Cast( Uint32, m_Nodes[m_Root].Height + 1 ) : 0;
+        }
+
+        Uint32 DynamicAABBTree::AllocateNode()
+        {
+            Uint32 Index = m_FreeList;
+
+            if( Index != InvalidProxy )
+                m_FreeList = m_Nodes[Index].Parent;
+            else
+            {
+                Index = Cast( Uint32, m_Nodes.size() );
+                m_Nodes.emplace_back();
+            }
+
+            Node& NewNode = m_Nodes[Index];
+            NewNode.Parent = InvalidProxy;
+            NewNode.Child1 = InvalidProxy;
+            NewNode.Child2 = InvalidProxy;
+            NewNode.Height = 0;
+            NewNode.UserData = 0;
+
+            return Index;
+        }
+
+        void DynamicAABBTree::FreeNode( Uint32 _Index )
+        {
+            m_Nodes[_Index].Parent = m_FreeList;
+            m_Nodes[_Index].Height = -1;
+            m_FreeList = _Index;
+        }
+
+        void DynamicAABBTree::InsertLeaf( Uint32 _Leaf )
+        {
+            if( m_Root == InvalidProxy )
+            {
+                m_Root = _Leaf;
+                m_Nodes[_Leaf].Parent = InvalidProxy;
+                return;
+            }
+
+            // Go down to the sibling whose union with the leaf costs the less surface area, the growth of the ancestors included.
+            const AABB LeafBounds = m_Nodes[_Leaf].Bounds;
+            Uint32 Index = m_Root;
+
+            while( !m_Nodes[Index].IsLeaf() )
+            {
+                const Node& Current = m_Nodes[Index];
+
+                const float Area = Current.Bounds.GetSurfaceArea();
+                const float CombinedArea = Union( Current.Bounds, LeafBounds ).GetSurfaceArea();
+
+                // Cost of a new parent for this node and the leaf.
+                const float Cost = 2.0f * CombinedArea;
+
+                // Cost added to all the ancestors by going down.
+                const float InheritanceCost = 2.0f * ( CombinedArea - Area );
+
+                auto ChildCost = [this, &LeafBounds, InheritanceCost]( Uint32 _Child )
+                {
+                    const Node& Child = m_Nodes[_Child];
+                    const float ChildCombinedArea = Union( Child.Bounds, LeafBounds ).GetSurfaceArea();
+
+                    return Child.IsLeaf() ? ChildCombinedArea + InheritanceCost : ChildCombinedArea - Child.Bounds.GetSurfaceArea() + InheritanceCost;
+                };
+
+                const float Cost1 = ChildCost( Current.Child1 );
+                const float Cost2 = ChildCost( Current.Child2 );
+
+                if( Cost < Cost1 && Cost < Cost2 )
+                    break;
+
+                Index = Cost1 < Cost2 ? Current.Child1 : Current.Child2;
+            }
+
+            const Uint32 Sibling = Index;
+
+            // The allocation can move the nodes : no reference kept across it.
+            const Uint32 NewParent = AllocateNode();
+            const Uint32 OldParent = m_Nodes[Sibling].Parent;
+
+            m_Nodes[NewParent].Parent = OldParent;
+            m_Nodes[NewParent].Bounds = Union( LeafBounds, m_Nodes[Sibling].Bounds );
+            m_Nodes[NewParent].Height = m_Nodes[Sibling].Height + 1;
+            m_Nodes[NewParent].Child1 = Sibling;
+            m_Nodes[NewParent].Child2 = _Leaf;
+
+            if( OldParent != InvalidProxy )
+            {
+                if( m_Nodes[OldParent].Child1 == Sibling )
+                    m_Nodes[OldParent].Child1 = NewParent;
+                else
+                    m_Nodes[OldParent].Child2 = NewParent;
+            }
+            else
+                m_Root = NewParent;
+
+            m_Nodes[Sibling].Parent = NewParent;
+            m_Nodes[_Leaf].Parent = NewParent;
+
+            RefreshAncestors( m_Nodes[_Leaf].Parent );
+        }
+
+        void DynamicAABBTree::RemoveLeaf( Uint32 _Leaf )
+        {
+            if( _Leaf == m_Root )
+            {
+                m_Root = InvalidProxy;
+                return;
+            }
+
+            // The sibling takes the place of the parent.
+            const Uint32 Parent = m_Nodes[_Leaf].Parent;
+            const Uint32 GrandParent = m_Nodes[Parent].Parent;
+            const Uint32 Sibling = m_Nodes[Parent].Child1 == _Leaf ? m_Nodes[Parent].Child2 : m_Nodes[Parent].Child1;
+
+            m_Nodes[Sibling].Parent = GrandParent;
+            FreeNode( Parent );
+
+            if( GrandParent == InvalidProxy )
+            {
+                m_Root = Sibling;
+                return;
+            }
+
+            if( m_Nodes[GrandParent].Child1 == Parent )
+                m_Nodes[GrandParent].Child1 = Sibling;
+            else
+                m_Nodes[GrandParent].Child2 = Sibling;
+
+            RefreshAncestors( GrandParent );
+        }
+
+        void DynamicAABBTree::RefreshAncestors( Uint32 _Index )
+        {
+            Uint32 Index = _Index;
+
+            while( Index != InvalidProxy )
+            {
+                Index = Balance( Index );
+
+                Node& Current = m_Nodes[Index];
+                const Node& Child1 = m_Nodes[Current.Child1];
+                const Node& Child2 = m_Nodes[Current.Child2];
+
+                Current.Height = 1 + Math::Max( Child1.Height, Child2.Height );
+                Current.Bounds = Union( Child1.Bounds, Child2.Bounds );
+
+                Index = Current.Parent;
+            }
+        }
+
+        Uint32 DynamicAABBTree::Balance( Uint32 _Index )
+        {
+            // See Box2D, b2DynamicTree::Balance : the highest child goes up, taking the place of its parent.
+
+            Node& A = m_Nodes[_Index];
+            if( A.IsLeaf() || A.Height < 2 )
+                return _Index;
+
+            const Uint32 IndexB = A.Child1;
+            const Uint32 IndexC = A.Child2;
+            Node& B = m_Nodes[IndexB];
+            Node& C = m_Nodes[IndexC];
+
+            const Int32 Difference = C.Height - B.Height;
+
+            // Rotate C up.
+            if( Difference > 1 )
+            {
+                const Uint32 IndexF = C.Child1;
+                const Uint32 IndexG = C.Child2;
+                Node& F = m_Nodes[IndexF];
+                Node& G = m_Nodes[IndexG];
+
+                C.Child1 = _Index;
+                C.Parent = A.Parent;
+                A.Parent = IndexC;
+
+                if( C.Parent != InvalidProxy )
+                {
+                    if( m_Nodes[C.Parent].Child1 == _Index )
+                        m_Nodes[C.Parent].Child1 = IndexC;
+                    else
+                        m_Nodes[C.Parent].Child2 = IndexC;
+                }
+                else
+                    m_Root = IndexC;
+
+                // The highest child of C stays under C, the other one goes under A.
+                if( F.Height > G.Height )
+                {
+                    C.Child2 = IndexF;
+                    A.Child2 = IndexG;
+                    G.Parent = _Index;
+                    A.Bounds = Union( B.Bounds, G.Bounds );
+                    C.Bounds = Union( A.Bounds, F.Bounds );
+                    A.Height = 1 + Math::Max( B.Height, G.Height );
+                    C.Height = 1 + Math::Max( A.Height, F.Height );
+                }
+                else
+                {
+                    C.Child2 = IndexG;
+                    A.Child2 = IndexF;
+                    F.Parent = _Index;
+                    A.Bounds = Union( B.Bounds, F.Bounds );
+                    C.Bounds = Union( A.Bounds, G.Bounds );
+                    A.Height = 1 + Math::Max( B.Height, F.Height );
+                    C.Height = 1 + Math::Max( A.Height, G.Height );
+                }
+
+                return IndexC;
+            }
+
+            // Rotate B up.
+            if( Difference < -1 )
+            {
+                const Uint32 IndexD = B.Child1;
+                const Uint32 IndexE = B.Child2;
+                Node& D = m_Nodes[IndexD];
+                Node& E = m_Nodes[IndexE];
+
+                B.Child1 = _Index;
+                B.Parent = A.Parent;
+                A.Parent = IndexB;
+
+                if( B.Parent != InvalidProxy )
+                {
+                    if( m_Nodes[B.Parent].Child1 == _Index )
+                        m_Nodes[B.Parent].Child1 = IndexB;
+                    else
+                        m_Nodes[B.Parent].Child2 = IndexB;
+                }
+                else
+                    m_Root = IndexB;
+
+                // The highest child of B stays under B, the other one goes under A.
+                if( D.Height > E.Height )
+                {
+                    B.Child2 = IndexD;
+                    A.Child1 = IndexE;
+                    E.Parent = _Index;
+                    A.Bounds = Union( C.Bounds, E.Bounds );
+                    B.Bounds = Union( A.Bounds, D.Bounds );
+                    A.Height = 1 + Math::Max( C.Height, E.Height );
+                    B.Height = 1 + Math::Max( A.Height, D.Height );
+                }
+                else
+                {
+                    B.Child2 = IndexE;
+                    A.Child1 = IndexD;
+                    D.Parent = _Index;
+                    A.Bounds = Union( C.Bounds, D.Bounds );
+                    B.Bounds = Union( A.Bounds, E.Bounds );
+                    A.Height = 1 + Math::Max( C.Height, D.Height );
+                    B.Height = 1 + Math::Max( A.Height, E.Height );
+                }
+
+                return IndexB;
+            }
+
+            return _Index;
+        }
+
+        AABB DynamicAABBTree::Enlarge( const AABB& _Bounds, const Vector3& _Displacement ) const
+        {
+            Vector3 Min = _Bounds.GetMin() - m_Margin;
+            Vector3 Max = _Bounds.GetMax() + m_Margin;
+
+            for( Uint32 Axis = 0; Axis < 3; Axis++ )
+            {
+                if( _Displacement[Axis] < 0.0f )
+                    Min[Axis] += _Displacement[Axis];
+                else
+                    Max[Axis] += _Displacement[Axis];
+            }
+
+            return AABB( Min, Max );
+        }
+
+    } // priv
+
+} // ae
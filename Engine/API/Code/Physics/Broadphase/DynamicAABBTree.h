@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../../Toolbox/Toolbox.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+#include "../../Maths/Primitives/AABB.h"
+#include "../../Debugging/Log/Log.h"
+
+#include <vector>
+
+namespace ae
+{
+    namespace priv
+    {
+        /// \ingroup physics
+        /// <summary>
+        /// Bounding volume hierarchy of boxes that can be added, moved and removed one by one. <para/>
+        /// Each leaf is a proxy : a box enlarged by a margin, it is moved in the tree only when its content goes out of it.
+        /// A new leaf goes down to the sibling the cheapest in surface area, the tree is then balanced by rotations :
+        /// a query visits O(log n) nodes, whatever the order of the insertions.
+        /// </summary>
+        /// <remarks>
+        /// The nodes are stored in an array and linked by index, the freed ones are reused.
+        /// The index of a proxy does not change while it exists.
+        /// </remarks>
+        class AERO_CORE_EXPORT DynamicAABBTree : public NotCopiable
+        {
+        public:
+            /// <summary>Index of no proxy.</summary>
+            static constexpr Uint32 InvalidProxy = 0xFFFFFFFF;
+
+        public:
+            /// <summary>Build an empty tree.</summary>
+            /// <param name="_Margin">Distance added around the boxes of the proxies, the more the less they must be moved.</param>
+            explicit DynamicAABBTree( float _Margin = 0.0f );
+
+            /// <summary>Add a proxy.</summary>
+            /// <param name="_Bounds">Box of the proxy.</param>
+            /// <param name="_UserData">Value given back by GetUserData.</param>
+            /// <returns>Index of the proxy.</returns>
+            Uint32 CreateProxy( const AABB& _Bounds, Uint32 _UserData );
+
+            /// <summary>Remove a proxy.</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            void DestroyProxy( Uint32 _Proxy );
+
+            /// <summary>Update the box of a proxy. It is moved in the tree only if the box goes out of its enlarged box.</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            /// <param name="_Bounds">New box of the proxy.</param>
+            /// <param name="_Displacement">Expected move of the box, the enlarged box is stretched in its direction.</param>
+            /// <returns>True if the proxy has been moved in the tree, False otherwise.</returns>
+            Bool MoveProxy( Uint32 _Proxy, const AABB& _Bounds, const Vector3& _Displacement );
+
+            /// <summary>Move all the proxies.</summary>
+            /// <param name="_Offset">Translation to apply to all the boxes.</param>
+            void Translate( const Vector3& _Offset );
+
+            /// <summary>Remove all the proxies.</summary>
+            void Clear();
+
+            /// <summary>Get the value given at the creation of a proxy.</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            /// <returns>User data of the proxy.</returns>
+            inline Uint32 GetUserData( Uint32 _Proxy ) const
+            {
+                return m_Nodes[_Proxy].UserData;
+            }
+
+            /// <summary>Get the enlarged box of a proxy.</summary>
+            /// <param name="_Proxy">Index of the proxy.</param>
+            /// <returns>Box stored in the tree for the proxy.</returns>
+            inline const AABB& GetFatBounds( Uint32 _Proxy ) const
+            {
+                return m_Nodes[_Proxy].Bounds;
+            }
+
+            /// <summary>Get the count of proxies.</summary>
+            /// <returns>Count of proxies in the tree.</returns>
+            Uint32 GetProxyCount() const;
+
+            /// <summary>Get the height of the tree.</summary>
+            /// <returns>Count of nodes from the root to the deepest leaf, 0 for an empty tree.</returns>
+            Uint32 GetHeight() const;
+
+            /// <summary>Call a function for each proxy whose enlarged box intersects a box. Can be called from several threads at once.</summary>
+            /// <param name="_Bounds">Box to test.</param>
+            /// <param name="_Callback">Function called with the index of each proxy found.</param>
+            template<typename Function>
+            void Query( const AABB& _Bounds, Function&& _Callback ) const
+            {
+                if( m_Root == InvalidProxy )
+                    return;
+
+                Uint32 Stack[MaxQueryDepth];
+                Uint32 StackSize = 0;
+                Stack[StackSize++] = m_Root;
+
+                while( StackSize > 0 )
+                {
+                    const Uint32 Index = Stack[--StackSize];
+                    const Node& Current = m_Nodes[Index];
+
+                    if( !Current.Bounds.Intersects( _Bounds ) )
+                        continue;
+
+                    if( Current.IsLeaf() )
+                    {
+                        _Callback( Index );
+                        continue;
+                    }
+
+                    // The balance keeps the height logarithmic : only a corrupted tree can go that deep.
+                    if( StackSize + 2 > MaxQueryDepth )
+                    {
+                        AE_LogError( "Dynamic AABB tree too deep for a query." );
+                        return;
+                    }
+
+                    Stack[StackSize++] = Current.Child1;
+                    Stack[StackSize++] = Current.Child2;
+                }
+            }
+
+        private:
+            /// <summary>Size of the stack of the queries.</summary>
+            static constexpr Uint32 MaxQueryDepth = 256;
+
+            /// <summary>Leaf (proxy), branch or free node.</summary>
+            struct Node
+            {
+                /// <summary>Is the node a proxy ?</summary>
+                inline Bool IsLeaf() const
+                {
+                    return Child1 == InvalidProxy;
+                }
+
+                /// <summary>Enlarged box for a leaf, box of the two children for a branch.</summary>
+                AABB Bounds;
+
+                /// <summary>Parent of the node, next free node for a free one.</summary>
+                Uint32 Parent;
+
+                /// <summary>First child, InvalidProxy for a leaf.</summary>
+                Uint32 Child1;
+
+                /// <summary>Second child, InvalidProxy for a leaf.</summary>
+                Uint32 Child2;
+
+                /// <summary>Height of the node, 0 for a leaf and -1 for a free node.</summary>
+                Int32 Height;
+
+                /// <summary>User data of a leaf.</summary>
+                Uint32 UserData;
+            };
+
+            /// <summary>Get a free node or add a new one.</summary>
+            /// <returns>Index of the node.</returns>
+            Uint32 AllocateNode();
+
+            /// <summary>Give a node back to the free list.</summary>
+            /// <param name="_Index">Index of the node.</param>
+            void FreeNode( Uint32 _Index );
+
+            /// <summary>Insert a leaf next to its cheapest sibling and balance its ancestors.</summary>
+            /// <param name="_Leaf">Index of the leaf.</param>
+            void InsertLeaf( Uint32 _Leaf );
+
+            /// <summary>Remove a leaf, its sibling takes the place of their parent.</summary>
+            /// <param name="_Leaf">Index of the leaf.</param>
+            void RemoveLeaf( Uint32 _Leaf );
+
+            /// <summary>Refresh the boxes and the heights of the ancestors of a node, balancing them.</summary>
+            /// <param name="_Index">First ancestor to refresh.</param>
+            void RefreshAncestors( Uint32 _Index );
+
+            /// <summary>Rotate a node if one of its children is higher than the other by more than 1.</summary>
+            /// <param name="_Index">Index of the node.</param>
+            /// <returns>Index of the node now at its place.</returns>
+            Uint32 Balance( Uint32 _Index );
+
+            /// <summary>Enlarge a box by the margin, and in the direction of its move.</summary>
+            /// <param name="_Bounds">Box to enlarge.</param>
+            /// <param name="_Displacement">Expected move of the box.</param>
+            /// <returns>Box to store in the leaf.</returns>
+            AABB Enlarge( const AABB& _Bounds, const Vector3& _Displacement ) const;
+
+        private:
+            /// <summary>All the nodes, used or free.</summary>
+            std::vector<Node> m_Nodes;
+
+            /// <summary>Index of the root, InvalidProxy if the tree is empty.</summary>
+            Uint32 m_Root;
+
+            /// <summary>First free node, InvalidProxy if there is none.</summary>
+            Uint32 m_FreeList;
+
+            /// <summary>Count of proxies.</summary>
+            Uint32 m_ProxyCount;
+
+            /// <summary>Distance added around the boxes of the proxies.</summary>
+            float m_Margin;
+        };
+
+    } // priv
+
+} // ae
@@ -0,0 +1,47 @@
+#include "BoxCollider.h"
+
+#include "../../Maths/Matrix/Matrix4x4.h"
+
+namespace ae
+{
+	BoxCollider::BoxCollider( const Vector3& _HalfSize, const Vector3& _Center ) :
+		Collider( Type::Box ),
+		m_HalfSize( _HalfSize ),
+		m_Center( _Center )
+	{
+		m_Bounds = AABB( m_Center - m_HalfSize, m_Center + m_HalfSize );
+	}
+
+	void BoxCollider::SetHalfSize( const Vector3& _HalfSize )
+	{
+		m_HalfSize = _HalfSize;
+		OnShapeChanged();
+	}
+
+	const Vector3& BoxCollider::GetHalfSize() const
+	{
+		return m_HalfSize;
+	}
+
+	void BoxCollider::SetCenter( const Vector3& _Center )
+	{
+		m_Center = _Center;
+		OnShapeChanged();
+	}
+
+	const Vector3& BoxCollider::GetCenter() const
+	{
+		return m_Center;
+	}
+
+	void BoxCollider::UpdateTransform( const Matrix4x4& _Transform )
+	{
+		m_Bounds = AABB( m_Center - m_HalfSize, m_Center + m_HalfSize ).GetTransformed( _Transform );
+	}
+
+	void BoxCollider::Translate( const Vector3& _Offset )
+	{
+		m_Bounds = AABB( m_Bounds.GetMin() + _Offset, m_Bounds.GetMax() + _Offset );
+	}
+
+} // ae
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Collider.h"
+
+namespace ae
+{
+	/// \ingroup physics
+	/// <summary>
+	/// Axis aligned box collider, centered on its object by default.<para/>
+	/// The box stays aligned with the world axes : a rotated object gets the box containing its rotated box.
+	/// </summary>
+	/// <seealso cref="Collider" />
+	class AERO_CORE_EXPORT BoxCollider : public Collider
+	{
+	public:
+		/// <summary>Build a box collider.</summary>
+		/// <param name="_HalfSize">Half of the size of the box on each axis, in the space of the object.</param>
+		/// <param name="_Center">Center of the box in the space of the object.</param>
+		explicit BoxCollider( const Vector3& _HalfSize = Vector3( 0.5f, 0.5f, 0.5f ), const Vector3& _Center = Vector3::Zero );
+
+		/// <summary>Set the half size of the box.</summary>
+		/// <param name="_HalfSize">The new half size on each axis, in the space of the object.</param>
+		void SetHalfSize( const Vector3& _HalfSize );
+
+		/// <summary>Retrieve the half size of the box.</summary>
+		/// <returns>The half size on each axis, in the space of the object.</returns>
+		const Vector3& GetHalfSize() const;
+
+		/// <summary>Set the center of the box.</summary>
+		/// <param name="_Center">The new center, in the space of the object.</param>
+		void SetCenter( const Vector3& _Center );
+
+		/// <summary>Retrieve the center of the box.</summary>
+		/// <returns>The center of the box, in the space of the object.</returns>
+		const Vector3& GetCenter() const;
+
+		/// <summary>Place the collider in world space.</summary>
+		/// <param name="_Transform">World matrix of the object the collider is attached to.</param>
+		void UpdateTransform( const Matrix4x4& _Transform ) override;
+
+		/// <summary>Move the collider in world space, faster than placing it again.</summary>
+		/// <param name="_Offset">Translation to apply to the collider.</param>
+		void Translate( const Vector3& _Offset ) override;
+
+	private:
+		/// <summary>Half of the size of the box on each axis, in the space of the object.</summary>
+		Vector3 m_HalfSize;
+
+		/// <summary>Center of the box in the space of the object.</summary>
+		Vector3 m_Center;
+	};
+
+} // ae
@@ -0,0 +1,81 @@
+#include "CapsuleCollider.h"
+
+#include "../../Maths/Matrix/Matrix4x4.h"
+
+namespace ae
+{
+	CapsuleCollider::CapsuleCollider( float _Radius, float _HalfHeight ) :
+		Collider( Type::Capsule ),
+		m_Radius( _Radius ),
+		m_HalfHeight( _HalfHeight ),
+		m_WorldPointA( 0.0f, -_HalfHeight, 0.0f ),
+		m_WorldPointB( 0.0f, _HalfHeight, 0.0f ),
+		m_WorldRadius( _Radius )
+	{
+		UpdateBounds();
+	}
+
+	void CapsuleCollider::SetRadius( float _Radius )
+	{
+		m_Radius = _Radius;
+		OnShapeChanged();
+	}
+
+	float CapsuleCollider::GetRadius() const
+	{
+		return m_Radius;
+	}
+
+	void CapsuleCollider::SetHalfHeight( float _HalfHeight )
+	{
+		m_HalfHeight = _HalfHeight;
+		OnShapeChanged();
+	}
+
+	float CapsuleCollider::GetHalfHeight() const
+	{
+		return m_HalfHeight;
+	}
+
+	const Vector3& CapsuleCollider::GetWorldPointA() const
+	{
+		return m_WorldPointA;
+	}
+
+	const Vector3& CapsuleCollider::GetWorldPointB() const
+	{
+		return m_WorldPointB;
+	}
+
+	float CapsuleCollider::GetWorldRadius() const
+	{
+		return m_WorldRadius;
+	}
+
+	void CapsuleCollider::UpdateTransform( const Matrix4x4& _Transform )
+	{
+		m_WorldPointA = _Transform.GetTransformedPoint( Vector3( 0.0f, -m_HalfHeight, 0.0f ) );
+		m_WorldPointB = _Transform.GetTransformedPoint( Vector3( 0.0f, m_HalfHeight, 0.0f ) );
+		m_WorldRadius = m_Radius * GetMaxScale( _Transform );
+
+		UpdateBounds();
+	}
+
+	void CapsuleCollider::Translate( const Vector3& _Offset )
+	{
+		m_WorldPointA += _Offset;
+		m_WorldPointB += _Offset;
+
+		UpdateBounds();
+	}
+
+	void CapsuleCollider::UpdateBounds()
+	{
+		m_Bounds.Reset();
+		m_Bounds.Grow( m_WorldPointA - m_WorldRadius );
+		m_Bounds.Grow( m_WorldPointA + m_WorldRadius );
+		m_Bounds.Grow( m_WorldPointB - m_WorldRadius );
+		m_Bounds.Grow( m_WorldPointB + m_WorldRadius );
+	}
+
+} // ae
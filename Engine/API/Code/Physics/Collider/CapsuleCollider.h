@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Collider.h"
+
+namespace ae
+{
+	/// \ingroup physics
+	/// <summary>
+	/// Capsule collider : a segment along the up axis of its object with a radius, centered on the object.<para/>
+	/// The radius is scaled by the most scaled axis of the object.
+	/// </summary>
+	/// <seealso cref="Collider" />
+	class AERO_CORE_EXPORT CapsuleCollider : public Collider
+	{
+	public:
+		/// <summary>Build a capsule collider.</summary>
+		/// <param name="_Radius">Radius of the capsule, before the scale of the object.</param>
+		/// <param name="_HalfHeight">Half of the length of the segment (from the center to the center of an end), in the space of the object.</param>
+		explicit CapsuleCollider( float _Radius = 0.5f, float _HalfHeight = 0.5f );
+
+		/// <summary>Set the radius of the capsule.</summary>
+		/// <param name="_Radius">The new radius, before the scale of the object.</param>
+		void SetRadius( float _Radius );
+
+		/// <summary>Retrieve the radius of the capsule.</summary>
+		/// <returns>The radius of the capsule, before the scale of the object.</returns>
+		float GetRadius() const;
+
+		/// <summary>Set the half of the length of the segment.</summary>
+		/// <param name="_HalfHeight">The new half length, in the space of the object.</param>
+		void SetHalfHeight( float _HalfHeight );
+
+		/// <summary>Retrieve the half of the length of the segment.</summary>
+		/// <returns>The half length, in the space of the object.</returns>
+		float GetHalfHeight() const;
+
+		/// <summary>Retrieve the center of the bottom end in world space.</summary>
+		/// <returns>The first point of the segment in world space.</returns>
+		const Vector3& GetWorldPointA() const;
+
+		/// <summary>Retrieve the center of the top end in world space.</summary>
+		/// <returns>The second point of the segment in world space.</returns>
+		const Vector3& GetWorldPointB() const;
+
+		/// <summary>Retrieve the radius of the capsule in world space.</summary>
+		/// <returns>The radius of the capsule in world space.</returns>
+		float GetWorldRadius() const;
+
+		/// <summary>Place the collider in world space.</summary>
+		/// <param name="_Transform">World matrix of the object the collider is attached to.</param>
+		void UpdateTransform( const Matrix4x4& _Transform ) override;
+
+		/// <summary>Move the collider in world space, faster than placing it again.</summary>
+		/// <param name="_Offset">Translation to apply to the collider.</param>
+		void Translate( const Vector3& _Offset ) override;
+
+	private:
+		/// <summary>Compute the world box from the world segment.</summary>
+		void UpdateBounds();
+
+	private:
+		/// <summary>Radius of the capsule, before the scale of the object.</summary>
+		float m_Radius;
+
+		/// <summary>Half of the length of the segment, in the space of the object.</summary>
+		float m_HalfHeight;
+
+		/// <summary>Center of the bottom end in world space.</summary>
+		Vector3 m_WorldPointA;
+
+		/// <summary>Center of the top end in world space.</summary>
+		Vector3 m_WorldPointB;
+
+		/// <summary>Radius of the capsule in world space.</summary>
+		float m_WorldRadius;
+	};
+
+} // ae
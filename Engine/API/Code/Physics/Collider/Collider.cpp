@@ -1,18 +1,299 @@
 #include "Collider.h"
 
+#include "SphereCollider.h"
+#include "BoxCollider.h"
+#include "CapsuleCollider.h"
+#include "MeshCollider.h"
+#include "../PhysicObject/PhysicObject.h"
+#include "../../Maths/Functions/IntersectionFunctions.h"
+#include "../../Maths/Matrix/Matrix4x4.h"
 
 namespace ae
 {
-	Collider::Collider() : 
-		m_Type( Type::None )
+	namespace
+	{
+		/// <summary>Contact between two colliders, see the contacts functions of Intersections.</summary>
+		struct Contact
+		{
+			Vector3 Point;
+			Vector3 Normal;
+			float Depth;
+			Uint32 FaceID;
+			float U;
+			float V;
+			float W;
+		};
+
+		/// <summary>Keep the deepest contact between a collider and the triangles of a mesh collider.</summary>
+		template<typename TriangleTest>
+		Bool CollideMesh( Contact& _OutContact, const AABB& _Bounds, const MeshCollider& _Mesh, TriangleTest&& _Test )
+		{
+			Bool IsHit = False;
+
+			_Mesh.QueryTriangles( _Bounds, [&]( Uint32 _Triangle, const Vector3& _A, const Vector3& _B, const Vector3& _C )
+			{
+				Contact TriangleContact;
+				if( !_Test( TriangleContact, _A, _B, _C ) )
+					return;
+
+				if( !IsHit || TriangleContact.Depth > _OutContact.Depth )
+				{
+					_OutContact = TriangleContact;
+					_OutContact.FaceID = _Triangle;
+					IsHit = True;
+				}
+			} );
+
+			return IsHit;
+		}
+
+		/// <summary>Contact of a rounded segment (a sphere when both ends are the same) against any collider.</summary>
+		Bool CollideRounded( Contact& _OutContact, const Vector3& _A, const Vector3& _B, float _Radius, const AABB& _Bounds, const Collider& _Other )
+		{
+			Contact& C = _OutContact;
+			const Bool IsSphere = _A == _B;
+
+			switch( _Other.GetType() )
+			{
+			case Collider::Type::Sphere:
+			{
+				const SphereCollider& Other = static_cast<const SphereCollider&>( _Other );
+
+				Vector3 Closest;
+				Intersections::ClosestPointSegment( Closest, Other.GetWorldCenter(), _A, _B );
+
+				return Intersections::SphereSphere( C.Point, C.Normal, C.Depth, Closest, _Radius, Other.GetWorldCenter(), Other.GetWorldRadius() );
+			}
+
+			case Collider::Type::Capsule:
+			{
+				const CapsuleCollider& Other = static_cast<const CapsuleCollider&>( _Other );
+
+				Vector3 Closest;
+				Vector3 OtherClosest;
+				Intersections::ClosestPointsSegmentSegment( Closest, OtherClosest, _A, _B, Other.GetWorldPointA(), Other.GetWorldPointB() );
+
+				return Intersections::SphereSphere( C.Point, C.Normal, C.Depth, Closest, _Radius, OtherClosest, Other.GetWorldRadius() );
+			}
+
+			case Collider::Type::Box:
+			{
+				const AABB& Box = _Other.GetBounds();
+
+				if( IsSphere )
+					return Intersections::SphereAABB( C.Point, C.Normal, C.Depth, _A, _Radius, Box.GetMin(), Box.GetMax() );
+
+				return Intersections::CapsuleAABB( C.Point, C.Normal, C.Depth, _A, _B, _Radius, Box.GetMin(), Box.GetMax() );
+			}
+
+			case Collider::Type::Mesh:
+			{
+				return CollideMesh( C, _Bounds, static_cast<const MeshCollider&>( _Other ), [&]( Contact& _Contact, const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC )
+				{
+					if( IsSphere )
+						return Intersections::SphereTriangle( _Contact.Point, _Contact.Normal, _Contact.Depth, _Contact.U, _Contact.V, _Contact.W, _A, _Radius, _TriA, _TriB, _TriC );
+
+					return Intersections::CapsuleTriangle( _Contact.Point, _Contact.Normal, _Contact.Depth, _Contact.U, _Contact.V, _Contact.W, _A, _B, _Radius, _TriA, _TriB, _TriC );
+				} );
+			}
+
+			case Collider::Type::None:
+			default:
+				return False;
+			}
+		}
+
+		/// <summary>Get the segment and the radius of a sphere or a capsule collider.</summary>
+		Bool GetRoundedShape( const Collider& _Collider, Vector3& _OutA, Vector3& _OutB, float& _OutRadius )
+		{
+			if( _Collider.GetType() == Collider::Type::Sphere )
+			{
+				const SphereCollider& Sphere = static_cast<const SphereCollider&>( _Collider );
+				_OutA = Sphere.GetWorldCenter();
+				_OutB = Sphere.GetWorldCenter();
+				_OutRadius = Sphere.GetWorldRadius();
+				return True;
+			}
+
+			if( _Collider.GetType() == Collider::Type::Capsule )
+			{
+				const CapsuleCollider& Capsule = static_cast<const CapsuleCollider&>( _Collider );
+				_OutA = Capsule.GetWorldPointA();
+				_OutB = Capsule.GetWorldPointB();
+				_OutRadius = Capsule.GetWorldRadius();
+				return True;
+			}
+
+			return False;
+		}
+
+		/// <summary>Contact of a box against a box or a mesh collider.</summary>
+		Bool CollideBox( Contact& _OutContact, const AABB& _Box, const Collider& _Other )
+		{
+			Contact& C = _OutContact;
+
+			switch( _Other.GetType() )
+			{
+			case Collider::Type::Box:
+				return Intersections::AABBAABB( C.Point, C.Normal, C.Depth, _Box.GetMin(), _Box.GetMax(), _Other.GetBounds().GetMin(), _Other.GetBounds().GetMax() );
+
+			case Collider::Type::Mesh:
+			{
+				return CollideMesh( C, _Box, static_cast<const MeshCollider&>( _Other ), [&_Box]( Contact& _Contact, const Vector3& _TriA, const Vector3& _TriB, const Vector3& _TriC )
+				{
+					return Intersections::AABBTriangle( _Contact.Point, _Contact.Normal, _Contact.Depth, _Contact.U, _Contact.V, _Contact.W, _Box.GetMin(), _Box.GetMax(), _TriA, _TriB, _TriC );
+				} );
+			}
+
+			default:
+				return False;
+			}
+		}
+
+		/// <summary>Contact between two colliders : the normal pushes the first one, the point is on the second one.</summary>
+		Bool Collide( Contact& _OutContact, const Collider& _First, const Collider& _Second )
+		{
+			_OutContact.FaceID = 0;
+			_OutContact.U = 0.0f;
+			_OutContact.V = 0.0f;
+			_OutContact.W = 0.0f;
+
+			if( !_First.GetBounds().Intersects( _Second.GetBounds() ) )
+				return False;
+
+			Vector3 A;
+			Vector3 B;
+			float Radius = 0.0f;
+
+			if( GetRoundedShape( _First, A, B, Radius ) )
+				return CollideRounded( _OutContact, A, B, Radius, _First.GetBounds(), _Second );
+
+			if( _First.GetType() == Collider::Type::Box && _Second.GetType() != Collider::Type::Sphere && _Second.GetType() != Collider::Type::Capsule )
+				return CollideBox( _OutContact, _First.GetBounds(), _Second );
+
+			// The pairs are written one way only : test the other way and swap the roles.
+			Contact Swapped;
+			Bool IsHit = False;
+
+			if( GetRoundedShape( _Second, A, B, Radius ) )
+				IsHit = CollideRounded( Swapped, A, B, Radius, _Second.GetBounds(), _First );
+			else if( _Second.GetType() == Collider::Type::Box )
+				IsHit = CollideBox( Swapped, _Second.GetBounds(), _First );
+
+			if( !IsHit )
+				return False;
+
+			// The deepest point of the second collider in the first one is on the surface of the first one.
+			_OutContact.Point = Swapped.Point - Swapped.Normal * Swapped.Depth;
+			_OutContact.Normal = -Swapped.Normal;
+			_OutContact.Depth = Swapped.Depth;
+
+			return True;
+		}
+	}
+
+	Collider::Collider() :
+		Collider( Type::None )
 	{
 	}
-	Bool Collider::Intersects( const Collider& ) const
+
+	Collider::Collider( Type _Type ) :
+		m_Type( _Type ),
+		m_Object( nullptr ),
+		m_Restitution( 0.5f ),
+		m_Friction( 0.3f )
 	{
-		return False;
 	}
-	Bool Collider::Intersects( HitResult&, const Collider& ) const
+
+	Collider::~Collider()
+	{
+		if( m_Object != nullptr )
+			m_Object->SetCollider( nullptr );
+	}
+
+	Collider::Type Collider::GetType() const
 	{
-		return False;
+		return m_Type;
 	}
+
+	const AABB& Collider::GetBounds() const
+	{
+		return m_Bounds;
+	}
+
+	World::ObjectID Collider::GetObjectID() const
+	{
+		return m_Object != nullptr ? m_Object->GetObjectID() : World::InvalidObjectID;
+	}
+
+	void Collider::SetRestitution( float _Restitution )
+	{
+		m_Restitution = Math::Clamp01( _Restitution );
+	}
+
+	float Collider::GetRestitution() const
+	{
+		return m_Restitution;
+	}
+
+	void Collider::SetFriction( float _Friction )
+	{
+		m_Friction = Math::Max( _Friction, 0.0f );
+	}
+
+	float Collider::GetFriction() const
+	{
+		return m_Friction;
+	}
+
+	Bool Collider::Intersects( const Collider& _Other ) const
+	{
+		HitResult Hit;
+		return Intersects( Hit, _Other );
+	}
+
+	Bool Collider::Intersects( HitResult& _OutHit, const Collider& _Other ) const
+	{
+		Contact Result;
+		if( !Collide( Result, *this, _Other ) )
+			return False;
+
+		_OutHit.IsHit = True;
+		_OutHit.ImpactPoint = Result.Point;
+		_OutHit.ImpactNormal = Result.Normal;
+		_OutHit.Depth = Result.Depth;
+		_OutHit.ObjectHit = _Other.GetObjectID();
+		_OutHit.FaceID = Result.FaceID;
+		_OutHit.U = Result.U;
+		_OutHit.V = Result.V;
+		_OutHit.W = Result.W;
+
+		return True;
+	}
+
+	void Collider::UpdateTransform( const Matrix4x4& )
+	{
+	}
+
+	void Collider::Translate( const Vector3& )
+	{
+	}
+
+	void Collider::OnShapeChanged()
+	{
+		if( m_Object != nullptr )
+			m_Object->MarkColliderDirty();
+	}
+
+	float Collider::GetMaxScale( const Matrix4x4& _Transform )
+	{
+		const float* const M = _Transform.GetData();
+
+		float MaxScaleSqr = 0.0f;
+		for( Uint32 c = 0; c < 3; c++ )
+			MaxScaleSqr = Math::Max( MaxScaleSqr, M[c] * M[c] + M[4 + c] * M[4 + c] + M[8 + c] * M[8 + c] );
+
+		return Math::Sqrt( MaxScaleSqr );
+	}
+
 } // ae
@@ -3,32 +3,88 @@
 #include "../../Toolbox/Toolbox.h"
 
 #include "../HitResult/HitResult.h"
+#include "../../Maths/Primitives/AABB.h"
 
 namespace ae
 {
+	class Matrix4x4;
+	class PhysicObject;
+
 	/// \ingroup physics
 	/// <summary>
-	/// Physic component to make objects collide with each others.
+	/// Physic component to make objects collide with each others.<para/>
+	/// A collider is given to a physic object (see PhysicObject::SetCollider) and follows its world matrix.
+	/// The simulation then finds the colliders overlapping with a broadphase and pushes the objects apart.
 	/// </summary>
 	/// <seealso cref="PhysicObject" />
+	/// <seealso cref="SphereCollider" />
+	/// <seealso cref="BoxCollider" />
+	/// <seealso cref="CapsuleCollider" />
+	/// <seealso cref="MeshCollider" />
 	class AERO_CORE_EXPORT Collider
 	{
-	private:
+		// Give the object it is attached to.
+		friend class PhysicObject;
+
+	public:
+		/// <summary>Shape of a collider.</summary>
 		enum class Type : Uint8
 		{
+			/// <summary>Collides with nothing.</summary>
 			None,
+
+			/// <summary>Sphere, see SphereCollider.</summary>
 			Sphere,
-			Triangle,
-			Plane,
-			AABB,
+
+			/// <summary>Axis aligned box, see BoxCollider.</summary>
+			Box,
+
+			/// <summary>Segment with a radius, see CapsuleCollider.</summary>
+			Capsule,
+
+			/// <summary>Triangles, see MeshCollider.</summary>
 			Mesh
 		};
 
 	public:
 		/// <summary>Default constructor.</summary>
 		Collider();
-		/// <summary>Default destructor.</summary>
-		virtual ~Collider() = default;
+		/// <summary>Detach the collider from its object.</summary>
+		virtual ~Collider();
+
+		/// <summary>Retrieve the shape of the collider.</summary>
+		/// <returns>The shape of the collider.</returns>
+		Type GetType() const;
+
+		/// <summary>Retrieve the box containing the collider, in world space.</summary>
+		/// <returns>The box containing the collider, invalid before the collider is placed.</returns>
+		const AABB& GetBounds() const;
+
+		/// <summary>Retrieve the ID of the object the collider is attached to.</summary>
+		/// <returns>The ID of the object, World::InvalidObjectID if the collider is not attached.</returns>
+		World::ObjectID GetObjectID() const;
+
+		/// <summary>
+		/// Set the bounciness of the collider.<para/>
+		/// 0 stops the objects on impact, 1 bounces them back at the same speed. The highest one of the two colliders is used.
+		/// </summary>
+		/// <param name="_Restitution">The new bounciness, between 0 and 1.</param>
+		void SetRestitution( float _Restitution );
+
+		/// <summary>Retrieve the bounciness of the collider.</summary>
+		/// <returns>The bounciness of the collider, between 0 and 1.</returns>
+		float GetRestitution() const;
+
+		/// <summary>
+		/// Set the friction of the collider.<para/>
+		/// 0 lets the objects slide on it, more slows them down along the surface. The two colliders frictions are combined (square root of the product).
+		/// </summary>
+		/// <param name="_Friction">The new friction, positive.</param>
+		void SetFriction( float _Friction );
+
+		/// <summary>Retrieve the friction of the collider.</summary>
+		/// <returns>The friction of the collider.</returns>
+		float GetFriction() const;
 
 		/// <summary>Process the intersection between the calling collider and <paramref name="_Other"/>.</summary>
 		/// <param name="_Other">The other collider to do the intersection test with.</param>
@@ -38,15 +94,51 @@ namespace ae
 		/// <summary>Process the intersection between the calling collider and <paramref name="_Other"/>.</summary>
 		/// <param name="_OutHit">
 		/// Filled with informations concerning the hit if an intersection happens.<para/>
+		/// The impact point is on the surface of <paramref name="_Other"/>,
+		/// the calling collider must be moved of the depth along the impact normal to stop intersecting.<para/>
 		/// Stay unchanged if no hit happens.
 		/// </param>
 		/// <param name="_Other">The other collider to do the intersection test with.</param>
 		/// <returns>True if the colliders are intersecting each other, false otherwise.</returns>
 		virtual Bool Intersects( HitResult&  _OutHit, const Collider& _Other ) const;
 
+		/// <summary>Place the collider in world space.</summary>
+		/// <param name="_Transform">World matrix of the object the collider is attached to.</param>
+		virtual void UpdateTransform( const Matrix4x4& _Transform );
+
+		/// <summary>Move the collider in world space, faster than placing it again.</summary>
+		/// <param name="_Offset">Translation to apply to the collider.</param>
+		virtual void Translate( const Vector3& _Offset );
+
+	protected:
+		/// <summary>Constructor for the shapes.</summary>
+		/// <param name="_Type">Shape of the collider.</param>
+		explicit Collider( Type _Type );
+
+		/// <summary>Flag the object of the collider to place it again : its shape changed.</summary>
+		void OnShapeChanged();
+
+		/// <summary>Get the scale of a matrix on its most scaled axis, to scale the radiuses.</summary>
+		/// <param name="_Transform">The matrix.</param>
+		/// <returns>The longest axis length of the matrix.</returns>
+		static float GetMaxScale( const Matrix4x4& _Transform );
+
+	protected:
+		/// <summary>Box containing the collider, in world space.</summary>
+		AABB m_Bounds;
+
 	private:
-		/// <summary>Type of the collider : Sphere, Triangle, Plane, ...</summary>
+		/// <summary>Type of the collider : Sphere, Box, ...</summary>
 		Type m_Type;
+
+		/// <summary>Object the collider is attached to, null if it is not attached.</summary>
+		PhysicObject* m_Object;
+
+		/// <summary>Bounciness of the collider.</summary>
+		float m_Restitution;
+
+		/// <summary>Friction of the collider.</summary>
+		float m_Friction;
 	};
 
-} // ae
\ No newline at end of file
+} // ae
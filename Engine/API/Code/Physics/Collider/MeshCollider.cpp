@@ -0,0 +1,115 @@
+#include "MeshCollider.h"
+
+#include "../../Maths/Matrix/Matrix4x4.h"
+#include "../../Graphics/Mesh/3D/Mesh3D.h"
+
+namespace ae
+{
+	MeshCollider::MeshCollider() :
+		Collider( Type::Mesh )
+	{
+	}
+
+	MeshCollider::MeshCollider( const std::vector<Vector3>& _Positions, const std::vector<Uint32>& _Indices ) :
+		Collider( Type::Mesh )
+	{
+		SetTriangles( _Positions, _Indices );
+	}
+
+	void MeshCollider::SetTriangles( const std::vector<Vector3>& _Positions, const std::vector<Uint32>& _Indices )
+	{
+		m_Positions = _Positions;
+		m_Indices = _Indices;
+
+		// An incomplete triangle at the end is ignored.
+		m_Indices.resize( m_Indices.size() - m_Indices.size() % 3 );
+
+		for( Uint32 Index : m_Indices )
+		{
+			if( Index >= m_Positions.size() )
+			{
+				AE_LogError( "Invalid vertex index in the triangles of the mesh collider." );
+				m_Indices.clear();
+				break;
+			}
+		}
+
+		m_WorldPositions = m_Positions;
+		BuildTree();
+
+		OnShapeChanged();
+	}
+
+	void MeshCollider::SetTriangles( const Mesh3D& _Mesh )
+	{
+		if( _Mesh.GetLoadingState() != LoadingState::Ready )
+		{
+			AE_LogError( "The mesh collider can't read the triangles of a mesh not loaded yet." );
+			return;
+		}
+
+		std::vector<Vector3> Positions( _Mesh.GetVerticesCount() );
+		for( Uint32 v = 0; v < _Mesh.GetVerticesCount(); v++ )
+			Positions[v] = _Mesh.GetVertex( v ).Position;
+
+		// The full level of detail, whatever the level drawn.
+		Uint32 FirstIndex = 0;
+		Uint32 IndicesCount = 0;
+		_Mesh.GetLODIndices( 0, FirstIndex, IndicesCount );
+
+		std::vector<Uint32> Indices( IndicesCount );
+		for( Uint32 i = 0; i < IndicesCount; i++ )
+			Indices[i] = _Mesh.GetIndice( FirstIndex + i );
+
+		SetTriangles( Positions, Indices );
+	}
+
+	Uint32 MeshCollider::GetTrianglesCount() const
+	{
+		return Cast( Uint32, m_Indices.size() / 3 );
+	}
+
+	void MeshCollider::GetWorldTriangle( Uint32 _Triangle, Vector3& _OutA, Vector3& _OutB, Vector3& _OutC ) const
+	{
+		const Uint32 First = _Triangle * 3;
+
+		_OutA = m_WorldPositions[m_Indices[First]];
+		_OutB = m_WorldPositions[m_Indices[First + 1]];
+		_OutC = m_WorldPositions[m_Indices[First + 2]];
+	}
+
+	void MeshCollider::UpdateTransform( const Matrix4x4& _Transform )
+	{
+		m_WorldPositions.resize( m_Positions.size() );
+		_Transform.TransformPoints( m_Positions.data(), m_WorldPositions.data(), Cast( Uint32, m_Positions.size() ) );
+
+		BuildTree();
+	}
+
+	void MeshCollider::Translate( const Vector3& _Offset )
+	{
+		for( Vector3& Position : m_WorldPositions )
+			Position += _Offset;
+
+		m_Tree.Translate( _Offset );
+		m_Bounds = AABB( m_Bounds.GetMin() + _Offset, m_Bounds.GetMax() + _Offset );
+	}
+
+	void MeshCollider::BuildTree()
+	{
+		m_Tree.Clear();
+		m_Bounds.Reset();
+
+		for( Uint32 Triangle = 0; Triangle < GetTrianglesCount(); Triangle++ )
+		{
+			AABB TriangleBounds;
+
+			for( Uint32 Corner = 0; Corner < 3; Corner++ )
+				TriangleBounds.Grow( m_WorldPositions[m_Indices[Triangle * 3 + Corner]] );
+
+			m_Tree.CreateProxy( TriangleBounds, Triangle );
+			m_Bounds.Grow( TriangleBounds );
+		}
+	}
+
+} // ae
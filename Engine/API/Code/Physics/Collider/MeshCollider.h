@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Collider.h"
+#include "../Broadphase/DynamicAABBTree.h"
+
+#include <vector>
+
+namespace ae
+{
+	class Mesh3D;
+
+	/// \ingroup physics
+	/// <summary>
+	/// Triangles collider, collided from both sides of the triangles.<para/>
+	/// The triangles are placed in world space in a bounding volume hierarchy : a test only visits the triangles near the other collider.
+	/// Placing the collider again transforms all the triangles, it is meant for static or rarely moved objects.
+	/// </summary>
+	/// <remarks>Two mesh colliders never collide with each other.</remarks>
+	/// <seealso cref="Collider" />
+	class AERO_CORE_EXPORT MeshCollider : public Collider
+	{
+	public:
+		/// <summary>Build a mesh collider without triangle.</summary>
+		MeshCollider();
+
+		/// <summary>Build a mesh collider from triangles.</summary>
+		/// <param name="_Positions">Positions of the vertices in the space of the object.</param>
+		/// <param name="_Indices">Three indices of vertices per triangle.</param>
+		MeshCollider( const std::vector<Vector3>& _Positions, const std::vector<Uint32>& _Indices );
+
+		/// <summary>Set the triangles of the collider.</summary>
+		/// <param name="_Positions">Positions of the vertices in the space of the object.</param>
+		/// <param name="_Indices">Three indices of vertices per triangle.</param>
+		void SetTriangles( const std::vector<Vector3>& _Positions, const std::vector<Uint32>& _Indices );
+
+		/// <summary>Set the triangles of the collider from the vertices and the indices of the full level of detail of a mesh.</summary>
+		/// <param name="_Mesh">Mesh to copy the triangles of, must be loaded.</param>
+		void SetTriangles( const Mesh3D& _Mesh );
+
+		/// <summary>Retrieve the count of triangles.</summary>
+		/// <returns>The count of triangles of the collider.</returns>
+		Uint32 GetTrianglesCount() const;
+
+		/// <summary>Retrieve a triangle in world space.</summary>
+		/// <param name="_Triangle">Index of the triangle.</param>
+		/// <param name="_OutA">First point of the triangle.</param>
+		/// <param name="_OutB">Second point of the triangle.</param>
+		/// <param name="_OutC">Third point of the triangle.</param>
+		void GetWorldTriangle( Uint32 _Triangle, Vector3& _OutA, Vector3& _OutB, Vector3& _OutC ) const;
+
+		/// <summary>Call a function for each triangle whose box intersects a box, in world space.</summary>
+		/// <param name="_Bounds">Box to test.</param>
+		/// <param name="_Callback">Function called with the index and the three points of each triangle found.</param>
+		template<typename Function>
+		void QueryTriangles( const AABB& _Bounds, Function&& _Callback ) const
+		{
+			m_Tree.Query( _Bounds, [this, &_Callback]( Uint32 _Proxy )
+			{
+				const Uint32 Triangle = m_Tree.GetUserData( _Proxy );
+				const Uint32 First = Triangle * 3;
+
+				_Callback( Triangle, m_WorldPositions[m_Indices[First]], m_WorldPositions[m_Indices[First + 1]], m_WorldPositions[m_Indices[First + 2]] );
+			} );
+		}
+
+		/// <summary>Place the collider in world space, transforming all the triangles.</summary>
+		/// <param name="_Transform">World matrix of the object the collider is attached to.</param>
+		void UpdateTransform( const Matrix4x4& _Transform ) override;
+
+		/// <summary>Move the collider in world space, faster than placing it again.</summary>
+		/// <param name="_Offset">Translation to apply to the collider.</param>
+		void Translate( const Vector3& _Offset ) override;
+
+	private:
+		/// <summary>Build the hierarchy of the triangles in world space.</summary>
+		void BuildTree();
+
+	private:
+		/// <summary>Positions of the vertices in the space of the object.</summary>
+		std::vector<Vector3> m_Positions;
+
+		/// <summary>Three indices of vertices per triangle.</summary>
+		std::vector<Uint32> m_Indices;
+
+		/// <summary>Positions of the vertices in world space.</summary>
+		std::vector<Vector3> m_WorldPositions;
+
+		/// <summary>Hierarchy of the triangles in world space, the user data of a proxy is the index of its triangle.</summary>
+		priv::DynamicAABBTree m_Tree;
+	};
+
+} // ae
@@ -0,0 +1,69 @@
+#include "SphereCollider.h"
+
+#include "../../Maths/Matrix/Matrix4x4.h"
+
+namespace ae
+{
+	SphereCollider::SphereCollider( float _Radius, const Vector3& _Center ) :
+		Collider( Type::Sphere ),
+		m_Radius( _Radius ),
+		m_Center( _Center ),
+		m_WorldCenter( _Center ),
+		m_WorldRadius( _Radius )
+	{
+		UpdateBounds();
+	}
+
+	void SphereCollider::SetRadius( float _Radius )
+	{
+		m_Radius = _Radius;
+		OnShapeChanged();
+	}
+
+	float SphereCollider::GetRadius() const
+	{
+		return m_Radius;
+	}
+
+	void SphereCollider::SetCenter( const Vector3& _Center )
+	{
+		m_Center = _Center;
+		OnShapeChanged();
+	}
+
+	const Vector3& SphereCollider::GetCenter() const
+	{
+		return m_Center;
+	}
+
+	const Vector3& SphereCollider::GetWorldCenter() const
+	{
+		return m_WorldCenter;
+	}
+
+	float SphereCollider::GetWorldRadius() const
+	{
+		return m_WorldRadius;
+	}
+
+	void SphereCollider::UpdateTransform( const Matrix4x4& _Transform )
+	{
+		m_WorldCenter = _Transform.GetTransformedPoint( m_Center );
+		m_WorldRadius = m_Radius * GetMaxScale( _Transform );
+
+		UpdateBounds();
+	}
+
+	void SphereCollider::Translate( const Vector3& _Offset )
+	{
+		m_WorldCenter += _Offset;
+
+		UpdateBounds();
+	}
+
+	void SphereCollider::UpdateBounds()
+	{
+		m_Bounds = AABB( m_WorldCenter - m_WorldRadius, m_WorldCenter + m_WorldRadius );
+	}
+
+} // ae
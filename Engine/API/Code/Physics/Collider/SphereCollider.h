@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Collider.h"
+
+namespace ae
+{
+	/// \ingroup physics
+	/// <summary>
+	/// Sphere collider, centered on its object by default.<para/>
+	/// The radius is scaled by the most scaled axis of the object.
+	/// </summary>
+	/// <seealso cref="Collider" />
+	class AERO_CORE_EXPORT SphereCollider : public Collider
+	{
+	public:
+		/// <summary>Build a sphere collider.</summary>
+		/// <param name="_Radius">Radius of the sphere, before the scale of the object.</param>
+		/// <param name="_Center">Center of the sphere in the space of the object.</param>
+		explicit SphereCollider( float _Radius = 0.5f, const Vector3& _Center = Vector3::Zero );
+
+		/// <summary>Set the radius of the sphere.</summary>
+		/// <param name="_Radius">The new radius, before the scale of the object.</param>
+		void SetRadius( float _Radius );
+
+		/// <summary>Retrieve the radius of the sphere.</summary>
+		/// <returns>The radius of the sphere, before the scale of the object.</returns>
+		float GetRadius() const;
+
+		/// <summary>Set the center of the sphere.</summary>
+		/// <param name="_Center">The new center, in the space of the object.</param>
+		void SetCenter( const Vector3& _Center );
+
+		/// <summary>Retrieve the center of the sphere.</summary>
+		/// <returns>The center of the sphere, in the space of the object.</returns>
+		const Vector3& GetCenter() const;
+
+		/// <summary>Retrieve the center of the sphere in world space.</summary>
+		/// <returns>The center of the sphere in world space.</returns>
+		const Vector3& GetWorldCenter() const;
+
+		/// <summary>Retrieve the radius of the sphere in world space.</summary>
+		/// <returns>The radius of the sphere in world space.</returns>
+		float GetWorldRadius() const;
+
+		/// <summary>Place the collider in world space.</summary>
+		/// <param name="_Transform">World matrix of the object the collider is attached to.</param>
+		void UpdateTransform( const Matrix4x4& _Transform ) override;
+
+		/// <summary>Move the collider in world space, faster than placing it again.</summary>
+		/// <param name="_Offset">Translation to apply to the collider.</param>
+		void Translate( const Vector3& _Offset ) override;
+
+	private:
+		/// <summary>Compute the world box from the world sphere.</summary>
+		void UpdateBounds();
+
+	private:
+		/// <summary>Radius of the sphere, before the scale of the object.</summary>
+		float m_Radius;
+
+		/// <summary>Center of the sphere in the space of the object.</summary>
+		Vector3 m_Center;
+
+		/// <summary>Center of the sphere in world space.</summary>
+		Vector3 m_WorldCenter;
+
+		/// <summary>Radius of the sphere in world space.</summary>
+		float m_WorldRadius;
+	};
+
+} // ae
@@ -18,6 +18,7 @@ namespace ae
 		/// <summary>Initialize default values.</summary>
 		HitResult() :
 			IsHit( False ),
+			Depth( 0.0f ),
 			ObjectHit( World::InvalidObjectID ),
 			FaceID( 0 ),
 			U( 0.0f ),
@@ -32,6 +33,7 @@ namespace ae
 			IsHit = False;
 			ImpactPoint = Vector3::Zero;
 			ImpactNormal = Vector3::Zero;
+			Depth = 0.0f;
 			ObjectHit = World::InvalidObjectID;
 			FaceID = 0;
 			U = 0.0f;
@@ -51,6 +53,12 @@ namespace ae
 		/// </summary>
 		Vector3 ImpactNormal;
 
+		/// <summary>
+		/// If an object has been hit, will contain how deep the objects are overlapping.<para/>
+		/// Moving the first object of this distance along the impact normal separates them.
+		/// </summary>
+		float Depth;
+
 		/// <summary>If an object has beend hit, will contain its Object ID.</summary>
 		World::ObjectID ObjectHit;
 
@@ -1,22 +1,37 @@
 #include "PhysicObject.h"
 
+#include "../Collider/Collider.h"
+#include "../Broadphase/DynamicAABBTree.h"
 #include "../../Aero/Aero.h"
 #include "../../Editor/TypesToEditor/PhysicObjectToEditor.h"
 
 namespace ae
 {
+    constexpr Uint32 PhysicObject::InvalidEntry;
+
     PhysicObject::PhysicObject( float _Mass ) :
         m_ApplyPhysics( True ),
         m_ApplyGravity( True ),
         m_ApplyAirResistance( True ),
-        m_Mass( _Mass ),
+        m_ApplyGlobalWind( True ),
         m_AirResistance( 0.0f ),
-        m_Forces( Vector3::Zero ),
-        m_Velocity( Vector3::Zero ),
-        m_Acceleration( Vector3::Zero )
+        m_Acceleration( Vector3::Zero ),
+        m_RenderedPosition( GetPosition() ),
+        m_SleepTime( 0.0f ),
+        m_IsSleeping( False ),
+        m_IsTransformChanged( False ),
+        m_IsSimulationWriting( False ),
+        m_Collider( nullptr ),
+        m_ProxyID( priv::DynamicAABBTree::InvalidProxy ),
+        m_Entry( InvalidEntry ),
+        m_ColliderPosition( Vector3::Zero ),
+        m_IsColliderDirty( False )
     {
         World& worldRef = Aero.GetWorld();
         worldRef.AddPhysicObjectToList( this );
+        GetSimulator().SetMass( GetBody(), _Mass );
+
+        AttachTransform( *this );
 
 
         SetName( std::string( "PhysicObject_" ) + std::to_string( GetObjectID() ) );
@@ -24,6 +39,9 @@ namespace ae
 
     PhysicObject::~PhysicObject()
     {
+        if( m_Collider != nullptr )
+            m_Collider->m_Object = nullptr;
+
         World& worldRef = Aero.GetWorld();
         worldRef.RemoveLightFromList( this );
     }
@@ -31,16 +49,25 @@ namespace ae
 
     void PhysicObject::SetMass( float _Mass )
     {
-        m_Mass = Math::Max( _Mass, Math::Epsilon() );
+        const float NewMass = Math::Max( _Mass, Math::Epsilon() );
+
+        // The editor sets the values each frame : only a real change wakes the object up.
+        if( NewMass != GetMass() )
+            WakeUp();
+
+        GetSimulator().SetMass( GetBody(), NewMass );
     }
 
     float PhysicObject::GetMass() const
     {
-        return m_Mass;
+        return GetSimulator().GetMass( GetBody() );
     }
 
     void PhysicObject::SetAirResistance( float _AirResistance )
     {
+        if( _AirResistance != m_AirResistance )
+            WakeUp();
+
         m_AirResistance = _AirResistance;
     }
 
@@ -50,30 +77,34 @@ namespace ae
         return m_AirResistance;
     }
 
-    const Vector3& PhysicObject::GetForces() const
+    Vector3 PhysicObject::GetForces() const
     {
-        return m_Forces;
+        return GetSimulator().GetForces( GetBody() );
     }
 
     void PhysicObject::SetForces( const Vector3& _NewForces )
     {
-        m_Forces = _NewForces;
+        GetSimulator().SetForces( GetBody(), _NewForces );
+        WakeUp();
     }
 
     void PhysicObject::AddForce( const Vector3& _ForceToAdd )
     {
-        m_Forces += _ForceToAdd;
+        priv::PhysicsSimulator& Simulator = GetSimulator();
+        Simulator.SetForces( GetBody(), Simulator.GetForces( GetBody() ) + _ForceToAdd );
+        WakeUp();
     }
 
 
-    const Vector3& PhysicObject::GetVelocity() const
+    Vector3 PhysicObject::GetVelocity() const
     {
-        return m_Velocity;
+        return GetSimulator().GetVelocity( GetBody() );
     }
 
     void PhysicObject::SetVelocity( const Vector3& _Velocity )
     {
-        m_Velocity = _Velocity;
+        GetSimulator().SetVelocity( GetBody(), _Velocity );
+        WakeUp();
     }
 
     const Vector3& PhysicObject::GetAcceleration() const
@@ -88,6 +119,9 @@ namespace ae
 
     void PhysicObject::SetApplyPhysics( Bool _ApplyPhysics )
     {
+        if( _ApplyPhysics != m_ApplyPhysics )
+            WakeUp();
+
         m_ApplyPhysics = _ApplyPhysics;
     }
 
@@ -98,6 +132,9 @@ namespace ae
 
     void PhysicObject::SetApplyGravity( Bool _ApplyGravity )
     {
+        if( _ApplyGravity != m_ApplyGravity )
+            WakeUp();
+
         m_ApplyGravity = _ApplyGravity;
     }
 
@@ -108,6 +145,9 @@ namespace ae
 
     void PhysicObject::SetApplyGlobalWind( Bool _ApplyGlobalWind )
     {
+        if( _ApplyGlobalWind != m_ApplyGlobalWind )
+            WakeUp();
+
         m_ApplyGlobalWind = _ApplyGlobalWind;
     }
 
@@ -118,6 +158,9 @@ namespace ae
 
     void PhysicObject::SetApplyAirResistance( Bool _ApplyAirResistance )
     {
+        if( _ApplyAirResistance != m_ApplyAirResistance )
+            WakeUp();
+
         m_ApplyAirResistance = _ApplyAirResistance;
     }
 
@@ -127,6 +170,44 @@ namespace ae
     }
 
 
+    void PhysicObject::SetCollider( Collider* _Collider )
+    {
+        if( _Collider == m_Collider )
+            return;
+
+        if( m_Collider != nullptr )
+            m_Collider->m_Object = nullptr;
+
+        // Taken from its previous object.
+        if( _Collider != nullptr )
+        {
+            if( _Collider->m_Object != nullptr )
+                _Collider->m_Object->SetCollider( nullptr );
+
+            _Collider->m_Object = this;
+        }
+
+        m_Collider = _Collider;
+        MarkColliderDirty();
+    }
+
+    Collider* PhysicObject::GetCollider() const
+    {
+        return m_Collider;
+    }
+
+    void PhysicObject::WakeUp()
+    {
+        m_IsSleeping = False;
+        m_SleepTime = 0.0f;
+    }
+
+    Bool PhysicObject::IsSleeping() const
+    {
+        return m_IsSleeping;
+    }
+
+
     void PhysicObject::ToEditor()
     {
         WorldObject::ToEditor();
@@ -134,5 +215,32 @@ namespace ae
         priv::ui::PhysicObjectToEditor( *this );
     }
 
+    void PhysicObject::OnTransformChanged()
+    {
+        MarkTransformDirty();
+
+        if( m_IsSimulationWriting )
+            return;
+
+        m_IsTransformChanged = True;
+        MarkColliderDirty();
+    }
+
+    void PhysicObject::MarkColliderDirty()
+    {
+        m_IsColliderDirty = True;
+        WakeUp();
+    }
+
+    priv::PhysicsSimulator& PhysicObject::GetSimulator() const
+    {
+        return Aero.GetWorld().m_PhysicsSimulator;
+    }
+
+    Uint32 PhysicObject::GetBody() const
+    {
+        return priv::PhysicsSimulator::GetBody( GetObjectID() );
+    }
+
 
 } // ae
\ No newline at end of file
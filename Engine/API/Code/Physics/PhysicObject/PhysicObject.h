@@ -7,17 +7,34 @@
 namespace ae
 {
     class World;
+    class Collider;
+
+    namespace priv
+    {
+        class PhysicsSimulator;
+        class CollisionSolver;
+    }
 
     /// \ingroup physics
     /// <summary>
     /// Basic class for physic object.
-    /// Physic object are simulated when updating the world.
+    /// Physic object are simulated when updating the world.<para/>
+    /// The mass, the forces, the velocity and the simulated position are stored by the simulator of the world, with the ones of the other objects.
     /// </summary>
     class AERO_CORE_EXPORT PhysicObject : public Transform, public WorldObject
     {
         // Give access to the update function for the world.
         friend class World;
 
+        // Give access to the simulation state for the batched integration.
+        friend class priv::PhysicsSimulator;
+
+        // Give access to the simulation state and the proxy for the collisions.
+        friend class priv::CollisionSolver;
+
+        // Flag the collider to be placed again when its shape changes.
+        friend class Collider;
+
     public:
         /// <summary>Build a physic object and add it to the world.</summary>
         /// <param name="_Mass">The mass of the object.</param>
@@ -52,7 +69,7 @@ namespace ae
 
         /// <summary>Retrieve the current forces that apply to the object.</summary>
         /// <returns>The current forces that apply to the object.</returns>
-        const Vector3& GetForces() const;
+        Vector3 GetForces() const;
 
         /// <summary>Set the forces that apply to the object.</summary>
         /// <param name="_NewForces">The new forces to apply to the object</param>
@@ -65,7 +82,7 @@ namespace ae
 
         /// <summary>Retrieve the current velocity of the object.</summary>
         /// <returns>The current velocity of the object.</returns>
-        const Vector3& GetVelocity() const;
+        Vector3 GetVelocity() const;
 
         /// <summary>Set the current velocity of the object.</summary>
         /// <param name="_Velocity">The new velocity to apply to the object.</param>
@@ -113,6 +130,30 @@ namespace ae
         /// <returns>True if the air resistance must be applied, false otherwise.</returns>
         Bool DoApplyAirResistance() const;
 
+        /// <summary>
+        /// Set the collider of the object, it follows the world matrix of the object.<para/>
+        /// An object with a collider collides with the other ones. If it does not apply the physics, it is static : the other objects bounce on it.<para/>
+        /// Between two steps the collider only follows the position of the object : a simulated object is expected to have no parent,
+        /// and a mesh collider to be static (MeshCollider).
+        /// </summary>
+        /// <param name="_Collider">The collider, not owned : it must live while it is attached. A collider is attached to one object at a time. Null to remove it.</param>
+        void SetCollider( Collider* _Collider );
+
+        /// <summary>Retrieve the collider of the object.</summary>
+        /// <returns>The collider of the object, null if it has none.</returns>
+        Collider* GetCollider() const;
+
+        /// <summary>Wake the object up : it is simulated again from the next frame.</summary>
+        void WakeUp();
+
+        /// <summary>
+        /// Is the object sleeping ? <para/>
+        /// An object falls asleep when it stays slow long enough (see PhysicsSettings::SleepDelay), it costs nothing until it wakes up.
+        /// Changing its forces, velocity, position or physics parameters wakes it up.
+        /// </summary>
+        /// <returns>True if the object is not simulated until it wakes up, False otherwise.</returns>
+        Bool IsSleeping() const;
+
         /// <summary>
         /// Function called by the editor.
         /// It allows the class to expose some attributes for user editing.
@@ -120,6 +161,28 @@ namespace ae
         /// </summary>
         virtual void ToEditor() override;
 
+    protected:
+        /// <summary>
+        /// Flag the world matrix to be recomputed. Called from the simulation jobs too. <para/>
+        /// A change not made by the simulation moves the object : the simulation restarts from its new position.
+        /// </summary>
+        void OnTransformChanged() override;
+
+    private:
+        /// <summary>Entry of the objects not simulated this frame.</summary>
+        static constexpr Uint32 InvalidEntry = 0xFFFFFFFF;
+
+        /// <summary>Flag the collider to be placed again from the world matrix on the next frame.</summary>
+        void MarkColliderDirty();
+
+        /// <summary>Retrieve the simulator storing the state of the object.</summary>
+        /// <returns>Simulator of the world.</returns>
+        priv::PhysicsSimulator& GetSimulator() const;
+
+        /// <summary>Retrieve the index of the state of the object in the arrays of the simulator.</summary>
+        /// <returns>Body of the object.</returns>
+        Uint32 GetBody() const;
+
     private:
         /// <summary>Apply or not the physics for this object.</summary>
         Bool m_ApplyPhysics;
@@ -133,9 +196,6 @@ namespace ae
         /// <summary>Apply or not the global world wind to this object.</summary>
         Bool m_ApplyGlobalWind;
 
-        /// <summary>Mass of the object.</summary>
-        float m_Mass;
-
         /// <summary>
         /// Air resistance of the object.<para/>
         /// Small value mean that the object is slippery and will not catch a lot of wind. <para/>
@@ -143,14 +203,38 @@ namespace ae
         /// </summary>
         float m_AirResistance;
 
-        /// <summary>Current forces that apply to the object.</summary>
-        Vector3 m_Forces;
-
-        /// <summary>Current velocity of the object.</summary>
-        Vector3 m_Velocity;
-
         /// <summary>Current acceleration of the object.</summary>
         Vector3 m_Acceleration;
+
+        /// <summary>Last position given to the transform by the simulation.</summary>
+        Vector3 m_RenderedPosition;
+
+        /// <summary>Time spent under the sleep velocity.</summary>
+        float m_SleepTime;
+
+        /// <summary>Is the object sleeping ?</summary>
+        Bool m_IsSleeping;
+
+        /// <summary>Has the transform been changed outside of the simulation since the last frame ?</summary>
+        Bool m_IsTransformChanged;
+
+        /// <summary>Is the simulation writing the position ? Its own changes must not be seen as moves.</summary>
+        Bool m_IsSimulationWriting;
+
+        /// <summary>Collider of the object, not owned.</summary>
+        Collider* m_Collider;
+
+        /// <summary>Proxy of the collider in the broadphase, DynamicAABBTree::InvalidProxy if it has none yet.</summary>
+        Uint32 m_ProxyID;
+
+        /// <summary>Body of the object while it is simulated during the frame, InvalidEntry if it is not simulated.</summary>
+        Uint32 m_Entry;
+
+        /// <summary>Position of the object the collider has been placed at, the simulation moves the collider from it.</summary>
+        Vector3 m_ColliderPosition;
+
+        /// <summary>Must the collider be placed again from the world matrix (attached, object moved or shape changed) ?</summary>
+        Bool m_IsColliderDirty;
     };
 
 } // ae
@@ -8,6 +8,12 @@
 
 #include "HitResult/HitResult.h"
 
+#include "Collider/Collider.h"
+#include "Collider/SphereCollider.h"
+#include "Collider/BoxCollider.h"
+#include "Collider/CapsuleCollider.h"
+#include "Collider/MeshCollider.h"
+
 #include "PhysicObject/PhysicObject.h"
 #include "Settings/PhysicsSettings.h"
 #include "Simulator/PhysicsSimulator.h"
@@ -35,13 +35,20 @@ namespace ae
         /// Initialize the defaults settings for the physics simulation. <para/>
         /// Integrator : EulerAverageVelocity <para/>
         /// Gravity : X = 0, Y = -10, Z = 0 <para/>
-        /// Iteration : 1
+        /// Fixed frame rate : 60 <para/>
+        /// Max steps per frame : 8 <para/>
+        /// Interpolation : enabled <para/>
+        /// Sleep velocity : 0.05, sleep delay : 0.5 seconds
         /// </summary>
         PhysicsSettings() :
             Integrator( IntegrationMethod::EulerAverageVelocity ),
             Gravity( 0.0f, -10.0f, 0.0f ),
             GlobalWind( 0.0f, 0.0f, 0.0f ),
-			FixedFrameRate( 60 )
+			FixedFrameRate( 60 ),
+            MaxStepsPerFrame( 8 ),
+            Interpolate( True ),
+            SleepVelocity( 0.05f ),
+            SleepDelay( 0.5f )
         {}
 
     public:
@@ -56,5 +63,26 @@ namespace ae
 
         /// <summary>The framerate that the physics must used.</summary>
         Uint32 FixedFrameRate;
+
+        /// <summary>
+        /// Maximum count of fixed steps simulated in one frame. <para/>
+        /// The time left after a long frame is dropped : the physics slows down instead of taking more and more time each frame.
+        /// </summary>
+        Uint32 MaxStepsPerFrame;
+
+        /// <summary>
+        /// Place the objects between their two last steps, according to the time left in the frame. <para/>
+        /// Smooth the moves when the fixed frame rate is not the one of the application, at the cost of one step of latency.
+        /// </summary>
+        Bool Interpolate;
+
+        /// <summary>Speed under which an object starts to fall asleep.</summary>
+        float SleepVelocity;
+
+        /// <summary>
+        /// Time in seconds that an object must stay under the sleep velocity to fall asleep. <para/>
+        /// Sleeping objects are not simulated until a force, a velocity or a position is given to them.
+        /// </summary>
+        float SleepDelay;
     };
 } // ae
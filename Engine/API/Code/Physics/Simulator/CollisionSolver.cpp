@@ -0,0 +1,282 @@
+#include "CollisionSolver.h"
+
+#include "../PhysicObject/PhysicObject.h"
+#include "../Collider/Collider.h"
+#include "../HitResult/HitResult.h"
+#include "../../Maths/Functions/MathsFunctions.h"
+#include "../../Toolbox/JobSystem/JobSystem.h"
+
+#include <algorithm>
+
+namespace ae
+{
+    namespace priv
+    {
+        constexpr float CollisionSolver::ProxyMargin;
+        constexpr Uint32 CollisionSolver::EntriesPerJob;
+        constexpr Uint32 CollisionSolver::PairsPerJob;
+        constexpr float CollisionSolver::Slop;
+        constexpr float CollisionSolver::CorrectionPercent;
+
+        CollisionSolver::CollisionSolver() :
+            m_Broadphase( ProxyMargin ),
+            m_FrameTime( 0.0f )
+        {
+        }
+
+        Bool CollisionSolver::IsEmpty() const
+        {
+            return m_Broadphase.GetProxyCount() == 0;
+        }
+
+        void CollisionSolver::UpdateCollider( PhysicObject& _Object, const Bodies& _Bodies )
+        {
+            _Object.m_IsColliderDirty = False;
+
+            Collider* ObjectCollider = _Object.m_Collider;
+            if( ObjectCollider == nullptr )
+            {
+                RemoveObject( _Object );
+                return;
+            }
+
+            // The world matrix places the object between its two last steps (interpolated for the rendering) :
+            // the collider is moved from there to the simulated position, the one of the contacts.
+            ObjectCollider->UpdateTransform( _Object.GetWorldMatrix() );
+
+            const Uint32 Entry = _Object.m_Entry;
+            const Vector3 SimulatedOffset = Entry != PhysicObject::InvalidEntry ?
+                Vector3( _Bodies.Positions[0][Entry], _Bodies.Positions[1][Entry], _Bodies.Positions[2][Entry] ) - _Object.GetPosition() : Vector3::Zero;
+            if( SimulatedOffset != Vector3::Zero )
+                ObjectCollider->Translate( SimulatedOffset );
+
+            _Object.m_ColliderPosition = _Object.GetPosition() + SimulatedOffset;
+
+            if( _Object.m_ProxyID != DynamicAABBTree::InvalidProxy )
+            {
+                m_Broadphase.MoveProxy( _Object.m_ProxyID, ObjectCollider->GetBounds(), Vector3::Zero );
+                return;
+            }
+
+            _Object.m_ProxyID = m_Broadphase.CreateProxy( ObjectCollider->GetBounds() );
+
+            if( _Object.m_ProxyID >= m_ProxyObjects.size() )
+                m_ProxyObjects.resize( _Object.m_ProxyID + 1, nullptr );
+
+            m_ProxyObjects[_Object.m_ProxyID] = &_Object;
+        }
+
+        void CollisionSolver::RemoveObject( PhysicObject& _Object )
+        {
+            if( _Object.m_ProxyID == DynamicAABBTree::InvalidProxy )
+                return;
+
+            // Its pairs are removed at the next update, the proxy can be reused before.
+            m_Broadphase.DestroyProxy( _Object.m_ProxyID );
+            m_ProxyObjects[_Object.m_ProxyID] = nullptr;
+            _Object.m_ProxyID = DynamicAABBTree::InvalidProxy;
+        }
+
+        void CollisionSolver::UpdatePairs( const std::vector<Uint32>& _Entries, const Bodies& _Bodies, float _FrameTime, JobSystem& _Jobs )
+        {
+            m_FrameTime = _FrameTime;
+
+            MoveColliders( _Entries, _Bodies, _Jobs );
+            m_Broadphase.FindNewPairs( _Jobs );
+            m_Broadphase.RemoveStalePairs();
+            ListActivePairs();
+        }
+
+        void CollisionSolver::Solve( const std::vector<Uint32>& _Entries, const Bodies& _Bodies, float _TimeStep, float _MinBounceSpeed, JobSystem& _Jobs )
+        {
+            if( _Entries.empty() )
+                return;
+
+            // The proxies are enlarged by the move of the frame : only a collider pushed out of it by a bounce finds new pairs.
+            MoveColliders( _Entries, _Bodies, _Jobs );
+
+            if( m_Broadphase.FindNewPairs( _Jobs ) )
+                ListActivePairs();
+
+            const Uint32 PairsCount = Cast( Uint32, m_ActivePairs.size() );
+            const Uint32 JobsCount = ( PairsCount + PairsPerJob - 1 ) / PairsPerJob;
+
+            if( m_JobContacts.size() < JobsCount )
+                m_JobContacts.resize( JobsCount );
+
+            // The narrowphase only reads the colliders : each job writes its own contacts.
+            _Jobs.ParallelFor( 0, PairsCount, PairsPerJob, [this]( Uint32 _Begin, Uint32 _End )
+            {
+                FindContacts( _Begin, _End, m_JobContacts[_Begin / PairsPerJob] );
+            } );
+
+            // An object can touch several others : the contacts are solved one after the other, in the order of the pairs.
+            for( Uint32 Job = 0; Job < JobsCount; Job++ )
+            {
+                for( const Contact& CurrentContact : m_JobContacts[Job] )
+                    ResolveContact( CurrentContact, _Bodies, _MinBounceSpeed );
+            }
+        }
+
+        void CollisionSolver::MoveColliders( const std::vector<Uint32>& _Entries, const Bodies& _Bodies, JobSystem& _Jobs )
+        {
+            const Uint32 EntriesCount = Cast( Uint32, _Entries.size() );
+            m_HasLeftProxy.resize( EntriesCount );
+
+            // Each job translates its own colliders, the tree is only read.
+            _Jobs.ParallelFor( 0, EntriesCount, EntriesPerJob, [this, &_Entries, &_Bodies]( Uint32 _Begin, Uint32 _End )
+            {
+                for( Uint32 e = _Begin; e < _End; e++ )
+                {
+                    const Uint32 Entry = _Entries[e];
+                    PhysicObject& Object = *_Bodies.Objects[Entry];
+
+                    const Vector3 Position( _Bodies.Positions[0][Entry], _Bodies.Positions[1][Entry], _Bodies.Positions[2][Entry] );
+                    const Vector3 Offset = Position - Object.m_ColliderPosition;
+
+                    if( Offset != Vector3::Zero )
+                    {
+                        Object.m_Collider->Translate( Offset );
+                        Object.m_ColliderPosition = Position;
+                    }
+
+                    m_HasLeftProxy[e] = !m_Broadphase.GetFatBounds( Object.m_ProxyID ).Contains( Object.m_Collider->GetBounds() );
+                }
+            } );
+
+            for( Uint32 e = 0; e < EntriesCount; e++ )
+            {
+                if( !m_HasLeftProxy[e] )
+                    continue;
+
+                const Uint32 Entry = _Entries[e];
+                const PhysicObject& Object = *_Bodies.Objects[Entry];
+
+                // Stretched where the object goes until the end of the frame : it leaves its proxy less often.
+                const Vector3 Velocity( _Bodies.Velocities[0][Entry], _Bodies.Velocities[1][Entry], _Bodies.Velocities[2][Entry] );
+                m_Broadphase.MoveProxy( Object.m_ProxyID, Object.m_Collider->GetBounds(), Velocity * m_FrameTime );
+            }
+        }
+
+        void CollisionSolver::ListActivePairs()
+        {
+            m_ActivePairs.clear();
+
+            for( Uint64 Pair : m_Broadphase.GetPairs() )
+            {
+                const PhysicObject* ObjectA = m_ProxyObjects[BroadphasePairs::GetFirstProxy( Pair )];
+                const PhysicObject* ObjectB = m_ProxyObjects[BroadphasePairs::GetSecondProxy( Pair )];
+
+                if( ObjectA == nullptr || ObjectB == nullptr )
+                    continue;
+
+                // Two static or sleeping objects do not move each other.
+                if( ObjectA->m_Entry != PhysicObject::InvalidEntry || ObjectB->m_Entry != PhysicObject::InvalidEntry )
+                    m_ActivePairs.push_back( Pair );
+            }
+        }
+
+        void CollisionSolver::FindContacts( Uint32 _Begin, Uint32 _End, AE_Out std::vector<Contact>& _OutContacts ) const
+        {
+            _OutContacts.clear();
+
+            for( Uint32 p = _Begin; p < _End; p++ )
+            {
+                PhysicObject* Object = m_ProxyObjects[BroadphasePairs::GetFirstProxy( m_ActivePairs[p] )];
+                PhysicObject* Other = m_ProxyObjects[BroadphasePairs::GetSecondProxy( m_ActivePairs[p] )];
+
+                // The contact is solved for the awake object.
+                if( Object->m_Entry == PhysicObject::InvalidEntry )
+                    std::swap( Object, Other );
+
+                const Collider& ObjectCollider = *Object->m_Collider;
+
+                HitResult Hit;
+                if( !ObjectCollider.Intersects( Hit, *Other->m_Collider ) )
+                    continue;
+
+                Contact NewContact;
+                NewContact.Entry = Object->m_Entry;
+                NewContact.OtherEntry = Other->m_Entry;
+                NewContact.Other = Other;
+                NewContact.Normal = Hit.ImpactNormal;
+                NewContact.Depth = Hit.Depth;
+                NewContact.Restitution = Math::Max( ObjectCollider.GetRestitution(), Other->m_Collider->GetRestitution() );
+                NewContact.Friction = Math::Sqrt( ObjectCollider.GetFriction() * Other->m_Collider->GetFriction() );
+
+                _OutContacts.push_back( NewContact );
+            }
+        }
+
+        void CollisionSolver::ResolveContact( const Contact& _Contact, const Bodies& _Bodies, float _MinBounceSpeed ) const
+        {
+            const Uint32 A = _Contact.Entry;
+            const Uint32 B = _Contact.OtherEntry;
+            const Bool IsOtherSimulated = B != PhysicObject::InvalidEntry;
+
+            // The static and sleeping objects have an infinite mass.
+            const float InverseMassA = _Bodies.InverseMasses[A];
+            const float InverseMassB = IsOtherSimulated ? _Bodies.InverseMasses[B] : 0.0f;
+            const float InverseMassSum = InverseMassA + InverseMassB;
+
+            if( InverseMassSum <= 0.0f )
+                return;
+
+            const Vector3& Normal = _Contact.Normal;
+
+            // Push the objects apart, each one by its share of the inverse masses.
+            const float Correction = Math::Max( _Contact.Depth - Slop, 0.0f ) * CorrectionPercent / InverseMassSum;
+
+            for( Uint32 Axis = 0; Axis < 3; Axis++ )
+            {
+                _Bodies.Positions[Axis][A] += Normal[Axis] * Correction * InverseMassA;
+
+                if( IsOtherSimulated )
+                    _Bodies.Positions[Axis][B] -= Normal[Axis] * Correction * InverseMassB;
+            }
+
+            const Vector3 VelocityA( _Bodies.Velocities[0][A], _Bodies.Velocities[1][A], _Bodies.Velocities[2][A] );
+            const Vector3 VelocityB = IsOtherSimulated ? Vector3( _Bodies.Velocities[0][B], _Bodies.Velocities[1][B], _Bodies.Velocities[2][B] ) : Vector3::Zero;
+
+            const Vector3 RelativeVelocity = VelocityA - VelocityB;
+            const float NormalSpeed = RelativeVelocity.Dot( Normal );
+
+            // Already separating.
+            if( NormalSpeed >= 0.0f )
+                return;
+
+            // Slow impacts do not bounce : the objects resting on others would never stop.
+            const Bool IsBouncing = -NormalSpeed > _MinBounceSpeed;
+
+            // A sleeping object hit hard enough moves again from the next frame.
+            if( IsBouncing && !IsOtherSimulated && _Contact.Other->DoApplyPhysics() )
+                _Contact.Other->WakeUp();
+
+            const float Restitution = IsBouncing ? _Contact.Restitution : 0.0f;
+            const float NormalImpulse = -( 1.0f + Restitution ) * NormalSpeed / InverseMassSum;
+
+            // Friction against the sliding, at most the friction times the normal impulse (Coulomb).
+            Vector3 Tangent = RelativeVelocity - Normal * NormalSpeed;
+            const float TangentSpeed = Tangent.Length();
+            float FrictionImpulse = 0.0f;
+
+            if( TangentSpeed > Math::Epsilon() )
+            {
+                Tangent /= TangentSpeed;
+                FrictionImpulse = Math::Min( TangentSpeed / InverseMassSum, _Contact.Friction * NormalImpulse );
+            }
+
+            const Vector3 Impulse = Normal * NormalImpulse - Tangent * FrictionImpulse;
+
+            for( Uint32 Axis = 0; Axis < 3; Axis++ )
+            {
+                _Bodies.Velocities[Axis][A] += Impulse[Axis] * InverseMassA;
+
+                if( IsOtherSimulated )
+                    _Bodies.Velocities[Axis][B] -= Impulse[Axis] * InverseMassB;
+            }
+        }
+
+    } // priv
+
+} // ae
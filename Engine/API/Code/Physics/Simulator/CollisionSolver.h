@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../../Toolbox/Toolbox.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+#include "../../Maths/Vector/Vector3.h"
+#include "../Broadphase/BroadphasePairs.h"
+
+#include <vector>
+
+namespace ae
+{
+    class PhysicObject;
+    class JobSystem;
+
+    namespace priv
+    {
+        /// \ingroup physics
+        /// <summary>
+        /// Find and solve the collisions between the colliders of the physic objects. <para/>
+        /// Each collider is a proxy of a dynamic AABB tree (the broadphase), enlarged by its move over the frame.
+        /// Once per frame, only the proxies that left their enlarged box are moved in the tree (the move buffer) and queried :
+        /// the pairs of overlapping proxies are kept from frame to frame. At each step, only the pairs of an awake object are tested
+        /// (the narrowphase), in parallel jobs. The contacts are then solved one by one : the objects are pushed apart and their velocities reflected.
+        /// </summary>
+        /// <remarks>
+        /// The sleeping objects and the ones not applying the physics are static : the awake objects bounce on them, they are not moved.
+        /// A colliding object stays in the tree while it is in the world : only its moves are tracked.
+        /// A collider going out of its enlarged box during the frame (after a bounce) is moved and queried at this step.
+        /// </remarks>
+        class AERO_CORE_EXPORT CollisionSolver : public NotCopiable
+        {
+        public:
+            /// <summary>Arrays of the bodies of the simulator, indexed by the body of the objects.</summary>
+            struct Bodies
+            {
+                /// <summary>Positions, one array per axis.</summary>
+                float* Positions[3];
+
+                /// <summary>Velocities, one array per axis.</summary>
+                float* Velocities[3];
+
+                /// <summary>Inverse of the masses.</summary>
+                const float* InverseMasses;
+
+                /// <summary>Object of each body.</summary>
+                PhysicObject* const* Objects;
+            };
+
+        public:
+            /// <summary>Default constructor.</summary>
+            CollisionSolver();
+
+            /// <summary>Is there any collider to collide ?</summary>
+            /// <returns>True if no object has a collider in the broadphase, False otherwise.</returns>
+            Bool IsEmpty() const;
+
+            /// <summary>
+            /// Place the collider of an object at its simulated position, oriented by its world matrix.
+            /// Add it to the broadphase or remove it if the object has no more collider.
+            /// </summary>
+            /// <param name="_Object">Object whose collider is dirty, already prepared for the frame. Must be called from the main thread : it reads the world matrix.</param>
+            /// <param name="_Bodies">Arrays of the bodies, to read the simulated position.</param>
+            void UpdateCollider( PhysicObject& _Object, const Bodies& _Bodies );
+
+            /// <summary>Remove an object from the broadphase.</summary>
+            /// <param name="_Object">Object to remove.</param>
+            void RemoveObject( PhysicObject& _Object );
+
+            /// <summary>
+            /// Move the proxies of the colliders that left their enlarged box, enlarged by their move over the frame,
+            /// and update the pairs of overlapping proxies. Called once per frame, before the steps.
+            /// </summary>
+            /// <param name="_Entries">Bodies of the simulated objects having a collider.</param>
+            /// <param name="_Bodies">Arrays of the bodies.</param>
+            /// <param name="_FrameTime">Time simulated this frame : count of steps times their duration.</param>
+            /// <param name="_Jobs">Job system to query the tree on.</param>
+            void UpdatePairs( const std::vector<Uint32>& _Entries, const Bodies& _Bodies, float _FrameTime, JobSystem& _Jobs );
+
+            /// <summary>Move the colliders to the simulated positions, find the contacts of the pairs and solve them. Called after each step.</summary>
+            /// <param name="_Entries">Bodies of the simulated objects having a collider.</param>
+            /// <param name="_Bodies">Arrays of the bodies, the positions and velocities are corrected.</param>
+            /// <param name="_TimeStep">Duration of a step.</param>
+            /// <param name="_MinBounceSpeed">Speed under which the objects do not bounce : the objects resting on others would jitter.</param>
+            /// <param name="_Jobs">Job system to find the contacts on.</param>
+            void Solve( const std::vector<Uint32>& _Entries, const Bodies& _Bodies, float _TimeStep, float _MinBounceSpeed, JobSystem& _Jobs );
+
+        private:
+            /// <summary>Contact found for an awake object.</summary>
+            struct Contact
+            {
+                /// <summary>Body of the awake object.</summary>
+                Uint32 Entry;
+
+                /// <summary>Body of the other object, PhysicObject::InvalidEntry if it is static.</summary>
+                Uint32 OtherEntry;
+
+                /// <summary>The other object.</summary>
+                PhysicObject* Other;
+
+                /// <summary>Direction to push the awake object to, from the other one.</summary>
+                Vector3 Normal;
+
+                /// <summary>Distance to push the objects apart.</summary>
+                float Depth;
+
+                /// <summary>Combined bounciness of the two colliders.</summary>
+                float Restitution;
+
+                /// <summary>Combined friction of the two colliders.</summary>
+                float Friction;
+            };
+
+            /// <summary>Margin of the proxies : the colliders moving less than it plus their move of the frame are not moved in the tree.</summary>
+            static constexpr float ProxyMargin = 0.05f;
+
+            /// <summary>Count of objects per job to move the colliders.</summary>
+            static constexpr Uint32 EntriesPerJob = 128;
+
+            /// <summary>Count of pairs per job to find the contacts.</summary>
+            static constexpr Uint32 PairsPerJob = 128;
+
+            /// <summary>Depth allowed between two objects, pushing them apart completely would make the resting ones jitter.</summary>
+            static constexpr float Slop = 0.005f;
+
+            /// <summary>Part of the depth removed at each step.</summary>
+            static constexpr float CorrectionPercent = 0.8f;
+
+            /// <summary>Translate the colliders to the simulated positions and move the proxies out of their enlarged box to the move buffer.</summary>
+            /// <param name="_Entries">Bodies of the simulated objects having a collider.</param>
+            /// <param name="_Bodies">Arrays of the bodies.</param>
+            /// <param name="_Jobs">Job system to translate the colliders on.</param>
+            void MoveColliders( const std::vector<Uint32>& _Entries, const Bodies& _Bodies, JobSystem& _Jobs );
+
+            /// <summary>List the pairs having an awake object, the only ones to test at the steps.</summary>
+            void ListActivePairs();
+
+            /// <summary>Find the contacts of a range of active pairs.</summary>
+            /// <param name="_Begin">First pair of the range.</param>
+            /// <param name="_End">Pair after the last one of the range.</param>
+            /// <param name="_OutContacts">Filled with the contacts of the range.</param>
+            void FindContacts( Uint32 _Begin, Uint32 _End, AE_Out std::vector<Contact>& _OutContacts ) const;
+
+            /// <summary>Push apart two objects in contact and apply the impulses of the bounce and of the friction.</summary>
+            /// <param name="_Contact">Contact to solve.</param>
+            /// <param name="_Bodies">Arrays of the bodies.</param>
+            /// <param name="_MinBounceSpeed">Speed under which the objects do not bounce.</param>
+            void ResolveContact( const Contact& _Contact, const Bodies& _Bodies, float _MinBounceSpeed ) const;
+
+        private:
+            /// <summary>Broadphase of the colliders and their pairs.</summary>
+            BroadphasePairs m_Broadphase;
+
+            /// <summary>Object of each proxy.</summary>
+            std::vector<PhysicObject*> m_ProxyObjects;
+
+            /// <summary>Pairs having an awake object this frame, in the order of the pairs of the broadphase.</summary>
+            std::vector<Uint64> m_ActivePairs;
+
+            /// <summary>Contacts found by each narrowphase job.</summary>
+            std::vector<std::vector<Contact>> m_JobContacts;
+
+            /// <summary>Has the collider of each entry left its enlarged box ? Written by the jobs moving the colliders.</summary>
+            std::vector<Uint8> m_HasLeftProxy;
+
+            /// <summary>Time simulated this frame, the proxies are enlarged by the move of their collider during it.</summary>
+            float m_FrameTime;
+        };
+
+    } // priv
+
+} // ae
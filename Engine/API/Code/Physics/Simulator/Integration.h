@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../../Toolbox/Toolbox.h"
+#include "../Settings/PhysicsSettings.h"
+
+#include <cmath>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __SSE2__ )
+#define AE_PHYSICS_SSE
+#include <xmmintrin.h>
+#endif
+
+
+namespace ae
+{
+    namespace priv
+    {
+        /// \ingroup physics
+        /// <summary>
+        /// Fixed steps and integration of the physics simulator, on arrays per axis. <para/>
+        /// The same step code runs on one body or on four with SSE : both give the same results, bit for bit.
+        /// </summary>
+        namespace Integration
+        {
+            // Operations shared by the scalar and SSE integration : the same step code runs on one object or on four.
+
+            inline float Add( float _A, float _B ) { return _A + _B; }
+            inline float Sub( float _A, float _B ) { return _A - _B; }
+            inline float Mul( float _A, float _B ) { return _A * _B; }
+
+#ifdef AE_PHYSICS_SSE
+            inline __m128 Add( __m128 _A, __m128 _B ) { return _mm_add_ps( _A, _B ); }
+            inline __m128 Sub( __m128 _A, __m128 _B ) { return _mm_sub_ps( _A, _B ); }
+            inline __m128 Mul( __m128 _A, __m128 _B ) { return _mm_mul_ps( _A, _B ); }
+#endif
+
+            /// <summary>Integrate one fixed step on one axis.</summary>
+            /// <param name="_Position">Position to update.</param>
+            /// <param name="_Velocity">Velocity to update.</param>
+            /// <param name="_Acceleration">Acceleration not depending on the velocity.</param>
+            /// <param name="_Damping">Air resistance over the mass.</param>
+            /// <param name="_TimeStep">Duration of the step.</param>
+            /// <param name="_Half">0.5 in each lane.</param>
+            template<PhysicsSettings::IntegrationMethod Method, typename T>
+            inline void Step( T& _Position, T& _Velocity, const T _Acceleration, const T _Damping, const T _TimeStep, const T _Half )
+            {
+                // The air resistance is against the velocity of the step : a = A - d/m * V.
+                const T Acceleration = Sub( _Acceleration, Mul( _Damping, _Velocity ) );
+
+                switch( Method )
+                {
+                case PhysicsSettings::IntegrationMethod::Euler:
+                    // Update the position with the current velocity, then the velocity.
+                    _Position = Add( _Position, Mul( _Velocity, _TimeStep ) );
+                    _Velocity = Add( _Velocity, Mul( Acceleration, _TimeStep ) );
+                    break;
+
+                case PhysicsSettings::IntegrationMethod::EulerEndingVelocity:
+                    // Update the velocity first, then the position with the updated velocity.
+                    _Velocity = Add( _Velocity, Mul( Acceleration, _TimeStep ) );
+                    _Position = Add( _Position, Mul( _Velocity, _TimeStep ) );
+                    break;
+
+                case PhysicsSettings::IntegrationMethod::EulerAverageVelocity:
+                default:
+                {
+                    // Update the position with the average of the current velocity and the updated one.
+                    const T CurrentVelocity = _Velocity;
+                    _Velocity = Add( _Velocity, Mul( Acceleration, _TimeStep ) );
+                    _Position = Add( _Position, Mul( Mul( Add( CurrentVelocity, _Velocity ), _Half ), _TimeStep ) );
+                    break;
+                }
+                }
+            }
+
+#ifdef AE_PHYSICS_SSE
+            /// <summary>Take the lanes of <paramref name="_A"/> where the mask is set, the ones of <paramref name="_B"/> elsewhere.</summary>
+            inline __m128 Select( __m128 _Mask, __m128 _A, __m128 _B ) { return _mm_or_ps( _mm_and_ps( _Mask, _A ), _mm_andnot_ps( _Mask, _B ) ); }
+#endif
+
+            /// <summary>Integrate the steps of the frame for bodies on one axis, keeping the position before the last step.</summary>
+            /// <param name="_Positions">Positions to update.</param>
+            /// <param name="_PreviousPositions">Filled with the positions before the last step.</param>
+            /// <param name="_Velocities">Velocities to update.</param>
+            /// <param name="_Accelerations">Accelerations not depending on the velocity.</param>
+            /// <param name="_Dampings">Air resistance over the mass.</param>
+            /// <param name="_Masks">All bits set for the bodies to integrate, the others are not written.</param>
+            /// <param name="_Count">Count of bodies.</param>
+            /// <param name="_StepCount">Count of steps to integrate, at least one.</param>
+            /// <param name="_TimeStep">Duration of a step.</param>
+            template<PhysicsSettings::IntegrationMethod Method>
+            void IntegrateAxis( float* _Positions, AE_Out float* _PreviousPositions, float* _Velocities, const float* _Accelerations, const float* _Dampings,
+                                const Uint32* _Masks, Uint32 _Count, Uint32 _StepCount, float _TimeStep )
+            {
+                Uint32 Body = 0;
+
+#ifdef AE_PHYSICS_SSE
+                const __m128 TimeStep = _mm_set1_ps( _TimeStep );
+                const __m128 Half = _mm_set1_ps( 0.5f );
+
+                // Four bodies at a time, all the steps are done in registers. The masked lanes keep their values.
+                for( ; Body + 4 <= _Count; Body += 4 )
+                {
+                    const __m128 Mask = _mm_loadu_ps( reinterpret_cast<const float*>( _Masks + Body ) );
+                    if( _mm_movemask_ps( Mask ) == 0 )
+                        continue;
+
+                    const __m128 StartPosition = _mm_loadu_ps( _Positions + Body );
+                    const __m128 StartVelocity = _mm_loadu_ps( _Velocities + Body );
+                    const __m128 Acceleration = _mm_loadu_ps( _Accelerations + Body );
+                    const __m128 Damping = _mm_loadu_ps( _Dampings + Body );
+
+                    __m128 Position = StartPosition;
+                    __m128 PreviousPosition = Position;
+                    __m128 Velocity = StartVelocity;
+
+                    for( Uint32 s = 0; s < _StepCount; s++ )
+                    {
+                        PreviousPosition = Position;
+                        Step<Method>( Position, Velocity, Acceleration, Damping, TimeStep, Half );
+                    }
+
+                    _mm_storeu_ps( _Positions + Body, Select( Mask, Position, StartPosition ) );
+                    _mm_storeu_ps( _PreviousPositions + Body, Select( Mask, PreviousPosition, _mm_loadu_ps( _PreviousPositions + Body ) ) );
+                    _mm_storeu_ps( _Velocities + Body, Select( Mask, Velocity, StartVelocity ) );
+                }
+#endif
+
+                for( ; Body < _Count; Body++ )
+                {
+                    if( _Masks[Body] == 0 )
+                        continue;
+
+                    float Position = _Positions[Body];
+                    float PreviousPosition = Position;
+                    float Velocity = _Velocities[Body];
+
+                    for( Uint32 s = 0; s < _StepCount; s++ )
+                    {
+                        PreviousPosition = Position;
+                        Step<Method>( Position, Velocity, _Accelerations[Body], _Dampings[Body], _TimeStep, 0.5f );
+                    }
+
+                    _Positions[Body] = Position;
+                    _PreviousPositions[Body] = PreviousPosition;
+                    _Velocities[Body] = Velocity;
+                }
+            }
+
+            /// <summary>Consume the time of a frame in fixed steps, the time left waits for the next frame.</summary>
+            /// <param name="_Accumulator">Time not simulated yet, less than a step when the function returns.</param>
+            /// <param name="_DeltaTime">Duration of the frame.</param>
+            /// <param name="_TimeStep">Duration of a step.</param>
+            /// <param name="_MaxSteps">Maximum count of steps, at least one. The whole steps beyond it are dropped.</param>
+            /// <returns>Count of steps to simulate this frame.</returns>
+            inline Uint32 ConsumeSteps( AE_InOut float& _Accumulator, float _DeltaTime, float _TimeStep, Uint32 _MaxSteps )
+            {
+                _Accumulator += _DeltaTime;
+
+                const Uint32 WholeSteps = Cast( Uint32, _Accumulator / _TimeStep );
+                const Uint32 StepCount = WholeSteps < _MaxSteps ? WholeSteps : _MaxSteps;
+                _Accumulator -= Cast( float, StepCount ) * _TimeStep;
+
+                // Too far behind : drop the whole steps left instead of simulating more steps each frame.
+                if( _Accumulator >= _TimeStep )
+                    _Accumulator = std::fmod( _Accumulator, _TimeStep );
+
+                return StepCount;
+            }
+        }
+    } // priv
+} // ae
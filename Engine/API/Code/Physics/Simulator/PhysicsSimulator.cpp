@@ -2,15 +2,42 @@
 
 #include "../PhysicObject/PhysicObject.h"
 #include "../../Aero/Aero.h"
+#include "../../Toolbox/JobSystem/JobSystem.h"
+#include "Integration.h"
 
 
 namespace ae
 {
     namespace priv
     {
-		PhysicsSimulator::PhysicsSimulator() : 
-			m_TimeStep( 0.0f )
+        namespace
+        {
+            /// <summary>Read a vector stored in arrays per axis.</summary>
+            inline Vector3 LoadVector( const std::vector<float>* _Arrays, Uint32 _Index )
+            {
+                return Vector3( _Arrays[0][_Index], _Arrays[1][_Index], _Arrays[2][_Index] );
+            }
+
+            /// <summary>Write a vector stored in arrays per axis.</summary>
+            inline void StoreVector( std::vector<float>* _Arrays, Uint32 _Index, const Vector3& _Vector )
+            {
+                for( Uint32 Axis = 0; Axis < 3; Axis++ )
+                    _Arrays[Axis][_Index] = _Vector[Axis];
+            }
+        }
+
+        constexpr Uint32 PhysicsSimulator::ObjectsPerJob;
+
+		PhysicsSimulator::PhysicsSimulator() :
+			m_TimeStep( 0.0f ),
+			m_Accumulator( 0.0f ),
+			m_StepCount( 0 ),
+			m_Alpha( 1.0f ),
+			m_LastGravity( m_Settings.Gravity ),
+			m_LastWind( m_Settings.GlobalWind )
 		{
+			// The body of the invalid handle.
+			ResizeArrays( 1 );
 		}
 
 		const PhysicsSettings& PhysicsSimulator::GetPhysicsSettings() const
@@ -23,109 +50,353 @@ namespace ae
             return m_Settings;
         }
 
+        void PhysicsSimulator::SimulateObjects( JobSystem& _Jobs )
+        {
+            // The steps are shared by all the objects : processed once, only read by the jobs.
+            UpdateTimeStep();
+
+            // The sleeping objects would not see the new gravity or wind.
+            const Bool WakeUp = m_Settings.Gravity != m_LastGravity || m_Settings.GlobalWind != m_LastWind;
+            m_LastGravity = m_Settings.Gravity;
+            m_LastWind = m_Settings.GlobalWind;
+
+            const Uint32 BodiesCount = Cast( Uint32, m_Objects.size() );
+            const Uint32 ChunksCount = ( BodiesCount + ObjectsPerJob - 1 ) / ObjectsPerJob;
+
+            if( ChunksCount > m_ChunkRanges.size() )
+            {
+                m_ChunkRanges.resize( ChunksCount );
+                m_ChunkDirtyCounts.resize( ChunksCount );
+            }
+
+            _Jobs.ParallelFor( 0, ChunksCount, 1, [this, WakeUp]( Uint32 _Begin, Uint32 _End )
+            {
+                for( Uint32 Chunk = _Begin; Chunk < _End; Chunk++ )
+                    PrepareChunk( Chunk, WakeUp );
+            } );
+
+            CollisionSolver::Bodies Bodies;
+            for( Uint32 Axis = 0; Axis < 3; Axis++ )
+            {
+                Bodies.Positions[Axis] = m_Positions[Axis].data();
+                Bodies.Velocities[Axis] = m_Velocities[Axis].data();
+            }
+            Bodies.InverseMasses = m_InverseMasses.data();
+            Bodies.Objects = m_Objects.data();
+
+            PrepareCollisions( ChunksCount, Bodies, _Jobs );
+
+            const IntegratorFunction Integrator = GetIntegrator();
+
+            // Without collision all the steps are integrated at once, in registers. Otherwise the contacts are solved after each step.
+            const Bool Collide = !m_CollidingEntries.empty();
+            const Uint32 StepsPerPass = Collide ? 1 : m_StepCount;
+
+            // Slower than the speed gained by falling during two steps : the object is resting on the other one.
+            const float MinBounceSpeed = 2.0f * m_Settings.Gravity.Length() * m_TimeStep;
+
+            for( Uint32 Step = 0; Step < m_StepCount; Step += StepsPerPass )
+            {
+                _Jobs.ParallelFor( 0, ChunksCount, 1, [this, StepsPerPass, Integrator]( Uint32 _Begin, Uint32 _End )
+                {
+                    for( Uint32 Chunk = _Begin; Chunk < _End; Chunk++ )
+                        IntegrateChunk( Chunk, StepsPerPass, Integrator );
+                } );
+
+                if( Collide )
+                    m_Collisions.Solve( m_CollidingEntries, Bodies, m_TimeStep, MinBounceSpeed, _Jobs );
+            }
+
+            _Jobs.ParallelFor( 0, ChunksCount, 1, [this]( Uint32 _Begin, Uint32 _End )
+            {
+                for( Uint32 Chunk = _Begin; Chunk < _End; Chunk++ )
+                    FinishChunk( Chunk );
+            } );
+        }
 
-        void PhysicsSimulator::SimulateObject( PhysicObject& _Object )
+        void PhysicsSimulator::AddObject( PhysicObject& _Object )
         {
-            if( !_Object.DoApplyPhysics() )
-                return;
+            const Uint32 Body = GetBody( _Object.GetObjectID() );
+
+            if( Body >= m_Objects.size() )
+                ResizeArrays( Body + 1 );
+
+            // The slot can come from a removed object : start at rest from the transform.
+            m_Objects[Body] = &_Object;
+            StoreVector( m_Positions, Body, _Object.GetPosition() );
+            StoreVector( m_PreviousPositions, Body, _Object.GetPosition() );
+            StoreVector( m_Velocities, Body, Vector3::Zero );
+            StoreVector( m_Forces, Body, Vector3::Zero );
+            m_Masses[Body] = 1.0f;
+            m_SimulatedMasks[Body] = 0;
+        }
 
-            // Retrieve object data.
-            Vector3 Position = _Object.GetPosition();
-            Vector3 Velocity = _Object.GetVelocity();                             
-            Vector3 Forces = _Object.GetForces();
+        void PhysicsSimulator::RemoveObject( PhysicObject& _Object )
+        {
+            m_Collisions.RemoveObject( _Object );
 
-            // Gravity. (g*m)
-            if( _Object.DoApplyGravity() )
-                Forces += m_Settings.Gravity * _Object.GetMass();
+            const Uint32 Body = GetBody( _Object.GetObjectID() );
+            if( Body != 0 && Body < m_Objects.size() && m_Objects[Body] == &_Object )
+            {
+                m_Objects[Body] = nullptr;
+                m_SimulatedMasks[Body] = 0;
+            }
+        }
 
-            // Air resistance. (Damping against the velocity : -d*V)
-            if( _Object.DoApplyAirResistance() )
-                Forces += -Velocity * _Object.GetAirResistance();
+        Uint32 PhysicsSimulator::GetBody( HandlePool::Handle _ID )
+        {
+            return HandlePool::GetIndex( _ID );
+        }
 
-            // Wind. (d*V_wind)
-            if( _Object.DoApplyGlobalWind() )
-                Forces += m_Settings.GlobalWind *  _Object.GetAirResistance();
+        float PhysicsSimulator::GetMass( Uint32 _Body ) const
+        {
+            return m_Masses[_Body];
+        }
 
-            // TODO : Add other forces to acceleration...
+        void PhysicsSimulator::SetMass( Uint32 _Body, float _Mass )
+        {
+            m_Masses[_Body] = _Mass;
+        }
+
+        Vector3 PhysicsSimulator::GetForces( Uint32 _Body ) const
+        {
+            return LoadVector( m_Forces, _Body );
+        }
+
+        void PhysicsSimulator::SetForces( Uint32 _Body, const Vector3& _Forces )
+        {
+            StoreVector( m_Forces, _Body, _Forces );
+        }
 
+        Vector3 PhysicsSimulator::GetVelocity( Uint32 _Body ) const
+        {
+            return LoadVector( m_Velocities, _Body );
+        }
 
-            // Process the final acceleration.
-            // F = ma -> a = F/m
-            const Vector3 Acceleration = Forces / _Object.GetMass();
+        void PhysicsSimulator::SetVelocity( Uint32 _Body, const Vector3& _Velocity )
+        {
+            StoreVector( m_Velocities, _Body, _Velocity );
+        }
+
+        void PhysicsSimulator::UpdateTimeStep()
+        {
+			// Fixed steps : the frame time is accumulated and consumed step by step, the rest waits for the next frame.
+            m_TimeStep = 1.0f / Cast( float, Math::Max( m_Settings.FixedFrameRate, Cast( Uint32, 1 ) ) );
+            m_StepCount = Integration::ConsumeSteps( m_Accumulator, Aero.GetDeltaTime(), m_TimeStep, Math::Max( m_Settings.MaxStepsPerFrame, Cast( Uint32, 1 ) ) );
+            m_Alpha = m_Settings.Interpolate ? m_Accumulator / m_TimeStep : 1.0f;
+        }
 
-			// Process the timestep to use according the fixed framerate of the physics.
-			// For stability, we do not take a value higher than the current framerate of the application.
-            float Time = 0.0f;
-            const float MaxTime = Aero.GetDeltaTime();
-            m_TimeStep = Math::Min( 1.0f / Cast( float, m_Settings.FixedFrameRate ), MaxTime );
+        void PhysicsSimulator::PrepareChunk( Uint32 _Chunk, Bool _WakeUp )
+        {
+            const Uint32 Begin = _Chunk * ObjectsPerJob;
+            const Uint32 End = Math::Min( Begin + ObjectsPerJob, Cast( Uint32, m_Objects.size() ) );
 
-            IntegratorFunction Integrator = GetIntegrator();
+            ChunkRange& Range = m_ChunkRanges[_Chunk];
+            Range.Begin = End;
+            Range.End = End;
 
-            // Do the simulation with the asked count of iterations to reach the time of a frame.
-            while( Time < MaxTime )
+            Uint32 DirtyCount = 0;
+            for( Uint32 Body = Begin; Body < End; Body++ )
             {
-                Integrator( *this, Position, Velocity, Acceleration );
+                m_SimulatedMasks[Body] = 0;
+
+                PhysicObject* Object = m_Objects[Body];
+                if( Object == nullptr )
+                    continue;
+
+                Object->m_Entry = PhysicObject::InvalidEntry;
+
+                // Static objects collide too : their collider is placed whatever their state.
+                if( Object->m_IsColliderDirty )
+                    m_DirtyColliders[Begin + DirtyCount++] = Object;
+
+                if( !Object->DoApplyPhysics() )
+                    continue;
+
+                if( _WakeUp )
+                    Object->WakeUp();
+
+                if( Object->IsSleeping() )
+                    continue;
 
-                Time += m_TimeStep;
+                PrepareObject( *Object, Body );
+
+                m_SimulatedMasks[Body] = 0xFFFFFFFF;
+                Object->m_Entry = Body;
+
+                Range.Begin = Math::Min( Range.Begin, Body );
+                Range.End = Body + 1;
             }
 
-            // Send the result to the object.
+            m_ChunkDirtyCounts[_Chunk] = DirtyCount;
+        }
+
+        void PhysicsSimulator::IntegrateChunk( Uint32 _Chunk, Uint32 _StepCount, IntegratorFunction _Integrator )
+        {
+            const ChunkRange& Range = m_ChunkRanges[_Chunk];
+
+            if( Range.Begin >= Range.End || _StepCount == 0 )
+                return;
+
+            const Uint32 Begin = Range.Begin;
+            const Uint32 Count = Range.End - Range.Begin;
 
-            _Object.SetPosition( Position );
-            _Object.SetVelocity( Velocity );
-            _Object.SetAcceleration( Acceleration );
+            // The axes are independent : the damping only links the velocity and the acceleration of the same axis.
+            for( Uint32 Axis = 0; Axis < 3; Axis++ )
+            {
+                _Integrator( m_Positions[Axis].data() + Begin, m_PreviousPositions[Axis].data() + Begin, m_Velocities[Axis].data() + Begin,
+                             m_Accelerations[Axis].data() + Begin, m_Dampings.data() + Begin, m_SimulatedMasks.data() + Begin, Count, _StepCount, m_TimeStep );
+            }
         }
 
+        void PhysicsSimulator::FinishChunk( Uint32 _Chunk )
+        {
+            const ChunkRange& Range = m_ChunkRanges[_Chunk];
+
+            for( Uint32 Body = Range.Begin; Body < Range.End; Body++ )
+            {
+                if( m_SimulatedMasks[Body] == 0 )
+                    continue;
+
+                PhysicObject& Object = *m_Objects[Body];
+                Object.m_Entry = PhysicObject::InvalidEntry;
 
-        void PhysicsSimulator::EulerIntegration( Vector3& _InOutPosition, Vector3& _InOutVelocity, const Vector3& _Acceleration )
+                FinishObject( Object, Body );
+            }
+        }
+
+        void PhysicsSimulator::PrepareCollisions( Uint32 _ChunksCount, const CollisionSolver::Bodies& _Bodies, JobSystem& _Jobs )
         {
-            // Euler classic : 
+            for( Uint32 Chunk = 0; Chunk < _ChunksCount; Chunk++ )
+            {
+                const Uint32 Begin = Chunk * ObjectsPerJob;
 
-            // Update the position with the current velocity.
-            _InOutPosition = _InOutPosition + _InOutVelocity * m_TimeStep;
+                for( Uint32 d = Begin; d < Begin + m_ChunkDirtyCounts[Chunk]; d++ )
+                    m_Collisions.UpdateCollider( *m_DirtyColliders[d], _Bodies );
+            }
+
+            m_CollidingEntries.clear();
+
+            if( m_Collisions.IsEmpty() )
+                return;
 
-            // Update the velocity after.
-            _InOutVelocity = _InOutVelocity + _Acceleration * m_TimeStep;
+            for( Uint32 Chunk = 0; m_StepCount > 0 && Chunk < _ChunksCount; Chunk++ )
+            {
+                const ChunkRange& Range = m_ChunkRanges[Chunk];
+
+                for( Uint32 Body = Range.Begin; Body < Range.End; Body++ )
+                {
+                    if( m_SimulatedMasks[Body] != 0 && m_Objects[Body]->m_ProxyID != DynamicAABBTree::InvalidProxy )
+                        m_CollidingEntries.push_back( Body );
+                }
+            }
+
+            // The broadphase runs once per frame, for the move of the whole frame : the steps only test the pairs found.
+            m_Collisions.UpdatePairs( m_CollidingEntries, _Bodies, Cast( float, m_StepCount ) * m_TimeStep, _Jobs );
         }
 
-        void PhysicsSimulator::EulerEndingVelocityIntegration( Vector3& _InOutPosition, Vector3& _InOutVelocity, const Vector3& _Acceleration )
+        void PhysicsSimulator::PrepareObject( PhysicObject& _Object, Uint32 _Body )
         {
-            // Euler ending velocity :
+            // Moved outside of the simulation : restart from the new position, without interpolation.
+            if( _Object.m_IsTransformChanged )
+            {
+                if( _Object.GetPosition() != _Object.m_RenderedPosition )
+                {
+                    StoreVector( m_Positions, _Body, _Object.GetPosition() );
+                    StoreVector( m_PreviousPositions, _Body, _Object.GetPosition() );
+                }
+
+                _Object.m_IsTransformChanged = False;
+            }
+
+            const float Mass = m_Masses[_Body];
+            Vector3 Forces = LoadVector( m_Forces, _Body );
 
-            // Update the velocity first.
-            _InOutVelocity = _InOutVelocity + _Acceleration * m_TimeStep;
+            // Gravity. (g*m)
+            if( _Object.DoApplyGravity() )
+                Forces += m_Settings.Gravity * Mass;
+
+            // Wind. (d*V_wind)
+            if( _Object.DoApplyGlobalWind() )
+                Forces += m_Settings.GlobalWind * _Object.GetAirResistance();
+
+            // TODO : Add other forces to acceleration...
 
-            // Update the position with the updated velocity.
-            _InOutPosition = _InOutPosition + _InOutVelocity * m_TimeStep;
+
+            // F = ma -> a = F/m, the air resistance (-d*V) is applied at each step.
+            const float InverseMass = 1.0f / Mass;
+            StoreVector( m_Accelerations, _Body, Forces * InverseMass );
+            m_Dampings[_Body] = _Object.DoApplyAirResistance() ? _Object.GetAirResistance() * InverseMass : 0.0f;
+            m_InverseMasses[_Body] = InverseMass;
         }
 
-        void PhysicsSimulator::EulerAverageVelocityIntegration( Vector3& _InOutPosition, Vector3& _InOutVelocity, const Vector3& _Acceleration )
+        void PhysicsSimulator::FinishObject( PhysicObject& _Object, Uint32 _Body )
         {
-            // Euler average velocity :
+            const Vector3 Position = LoadVector( m_Positions, _Body );
+            const Vector3 Velocity = LoadVector( m_Velocities, _Body );
+
+            _Object.m_Acceleration = LoadVector( m_Accelerations, _Body ) - Velocity * m_Dampings[_Body];
 
-            // Store the current velocity then update it.
-            const Vector3 currentVelocity = _InOutVelocity;
-            _InOutVelocity = _InOutVelocity + _Acceleration * m_TimeStep;
+            // Slow long enough : the object stops where it is until something wakes it up.
+            if( Velocity.LengthSqr() < m_Settings.SleepVelocity * m_Settings.SleepVelocity )
+                _Object.m_SleepTime += Cast( float, m_StepCount ) * m_TimeStep;
+            else
+                _Object.m_SleepTime = 0.0f;
 
-            // Update the position with the average of the current velocity and the new.
-            _InOutPosition = _InOutPosition + ( ( currentVelocity + _InOutVelocity ) * 0.5f ) * m_TimeStep;
+            if( _Object.m_SleepTime >= m_Settings.SleepDelay && m_StepCount > 0 )
+            {
+                _Object.m_IsSleeping = True;
+                StoreVector( m_PreviousPositions, _Body, Position );
+                StoreVector( m_Velocities, _Body, Vector3::Zero );
+                _Object.m_Acceleration = Vector3::Zero;
+            }
+
+            // Place the object between its two last steps. Without step this frame, it stays between the same two steps.
+            const Vector3 PreviousPosition = LoadVector( m_PreviousPositions, _Body );
+            _Object.m_RenderedPosition = PreviousPosition + ( Position - PreviousPosition ) * m_Alpha;
+
+            _Object.m_IsSimulationWriting = True;
+            _Object.SetPosition( _Object.m_RenderedPosition );
+            _Object.m_IsSimulationWriting = False;
         }
 
         PhysicsSimulator::IntegratorFunction PhysicsSimulator::GetIntegrator() const
         {
-            // Chose the right integrator according to the settings.
+            // Chose the right integrator according to the settings, each one has its own compiled loops.
             switch( m_Settings.Integrator )
             {
             case PhysicsSettings::IntegrationMethod::Euler:
-            return &PhysicsSimulator::EulerIntegration;
+            return &Integration::IntegrateAxis<PhysicsSettings::IntegrationMethod::Euler>;
 
             case PhysicsSettings::IntegrationMethod::EulerEndingVelocity:
-            return &PhysicsSimulator::EulerEndingVelocityIntegration;
+            return &Integration::IntegrateAxis<PhysicsSettings::IntegrationMethod::EulerEndingVelocity>;
 
             case PhysicsSettings::IntegrationMethod::EulerAverageVelocity:
             default:
-            return &PhysicsSimulator::EulerAverageVelocityIntegration;
+            return &Integration::IntegrateAxis<PhysicsSettings::IntegrationMethod::EulerAverageVelocity>;
+            }
+        }
+
+        void PhysicsSimulator::ResizeArrays( Uint32 _Count )
+        {
+            if( _Count <= m_Objects.size() )
+                return;
+
+            for( Uint32 Axis = 0; Axis < 3; Axis++ )
+            {
+                m_Positions[Axis].resize( _Count, 0.0f );
+                m_PreviousPositions[Axis].resize( _Count, 0.0f );
+                m_Velocities[Axis].resize( _Count, 0.0f );
+                m_Forces[Axis].resize( _Count, 0.0f );
+                m_Accelerations[Axis].resize( _Count, 0.0f );
             }
+
+            m_Masses.resize( _Count, 1.0f );
+            m_Dampings.resize( _Count, 0.0f );
+            m_InverseMasses.resize( _Count, 1.0f );
+            m_SimulatedMasks.resize( _Count, 0 );
+            m_Objects.resize( _Count, nullptr );
+            m_DirtyColliders.resize( _Count, nullptr );
         }
 
     } // priv
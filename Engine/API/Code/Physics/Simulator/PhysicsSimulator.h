@@ -1,25 +1,37 @@
 #pragma once
 
 #include "../../Toolbox/Toolbox.h"
+#include "../../Toolbox/HandlePool/HandlePool.h"
+#include "../../Maths/Vector/Vector3.h"
 
 #include "../Settings/PhysicsSettings.h"
+#include "CollisionSolver.h"
 
-#include <functional>
+#include <vector>
 
 namespace ae
 {
     class PhysicObject;
-    class Vector3;
+    class JobSystem;
 
     namespace priv
     {
         /// \ingroup physics
         /// <summary>
-        /// This class stored the physics settings and update physics objects of the world.
+        /// This class stored the physics settings and update physics objects of the world. <para/>
+        /// The simulation advances by fixed steps : the time of the frames is accumulated and consumed step by step,
+        /// the objects are then placed between their two last steps according to the time left. <para/>
+        /// The simulator owns the state of the physic objects in arrays per axis (positions, velocities, forces, ...),
+        /// indexed by the slot of their object handle : the objects read and write them there, nothing is copied each frame.
+        /// The arrays are cut in chunks integrated by parallel jobs, in place, four bodies at a time. The bodies not simulated
+        /// (sleeping, static or free slots) are masked out. <para/>
+        /// When some objects have a collider, the chunks are integrated one step at a time and the collisions are solved after each step.
         /// </summary>
+        /// <remarks>The slot 0 is never given to a valid handle : it is the body of the objects without valid handle.</remarks>
         class AERO_CORE_EXPORT PhysicsSimulator
         {
-            using IntegratorFunction = std::function<void( PhysicsSimulator&, Vector3&, Vector3&, const Vector3& )>;
+            /// <summary>Integrate the steps of the frame for bodies on one axis : positions, previous positions, velocities, accelerations, dampings, masks, count, steps and time step.</summary>
+            using IntegratorFunction = void( * )( float*, float*, float*, const float*, const float*, const Uint32*, Uint32, Uint32, float );
 
         public:
 			/// <summary>Default constructor.</summary>
@@ -33,40 +45,181 @@ namespace ae
             /// <returns>The world physics settings.</returns>
             PhysicsSettings& GetPhysicsSettings();
 
-            /// <summary>Update the physics of an object.</summary>
-            /// <param name="_Object"></param>
-            void SimulateObject( PhysicObject& _Object );
+            /// <summary>
+            /// Update the physics of the objects for the time of the frame, in parallel.<para/>
+            /// The bodies are independent : each job only writes the bodies of its chunk. The sleeping objects are skipped.
+            /// </summary>
+            /// <param name="_Jobs">Job system to run the update on.</param>
+            void SimulateObjects( JobSystem& _Jobs );
+
+            /// <summary>Give a body to an object, at rest at the position of its transform.</summary>
+            /// <param name="_Object">Object to add, with a valid object ID.</param>
+            void AddObject( PhysicObject& _Object );
+
+            /// <summary>Remove an object from the collisions and free its body, before it is removed from the world.</summary>
+            /// <param name="_Object">Object to remove.</param>
+            void RemoveObject( PhysicObject& _Object );
+
+            /// <summary>Retrieve the body of an object : the index of its state in the arrays.</summary>
+            /// <param name="_ID">Object ID of the object.</param>
+            /// <returns>Slot of the handle, 0 for an invalid one.</returns>
+            static Uint32 GetBody( HandlePool::Handle _ID );
+
+            /// <summary>Retrieve the mass of a body.</summary>
+            /// <param name="_Body">Index of the body.</param>
+            /// <returns>Mass of the body.</returns>
+            float GetMass( Uint32 _Body ) const;
+
+            /// <summary>Set the mass of a body.</summary>
+            /// <param name="_Body">Index of the body.</param>
+            /// <param name="_Mass">New mass of the body.</param>
+            void SetMass( Uint32 _Body, float _Mass );
+
+            /// <summary>Retrieve the forces applied to a body.</summary>
+            /// <param name="_Body">Index of the body.</param>
+            /// <returns>Forces of the body.</returns>
+            Vector3 GetForces( Uint32 _Body ) const;
+
+            /// <summary>Set the forces applied to a body.</summary>
+            /// <param name="_Body">Index of the body.</param>
+            /// <param name="_Forces">New forces of the body.</param>
+            void SetForces( Uint32 _Body, const Vector3& _Forces );
+
+            /// <summary>Retrieve the velocity of a body.</summary>
+            /// <param name="_Body">Index of the body.</param>
+            /// <returns>Velocity of the body at the end of the last step.</returns>
+            Vector3 GetVelocity( Uint32 _Body ) const;
+
+            /// <summary>Set the velocity of a body.</summary>
+            /// <param name="_Body">Index of the body.</param>
+            /// <param name="_Velocity">New velocity of the body.</param>
+            void SetVelocity( Uint32 _Body, const Vector3& _Velocity );
 
         private:
-            /// <summary>Process the next position using Euler integration.</summary>
-            /// <param name="_InOutPosition">The position to process.</param>
-            /// <param name="_Velocity">The velocity of the current step, will be updated.</param>
-            /// <param name="_Acceleration">The acceleration of the current step.</param>
-            void EulerIntegration( Vector3& _InOutPosition, Vector3& _InOutVelocity, const Vector3& _Acceleration );
-
-            /// <summary>Process the next position using Euler ending velocity integration.</summary>
-            /// <param name="_InOutPosition">The position to process.</param>
-            /// <param name="_Velocity">The velocity of the current step, will be updated.</param>
-            /// <param name="_Acceleration">The acceleration of the current step.</param>
-            void EulerEndingVelocityIntegration( Vector3& _InOutPosition, Vector3& _InOutVelocity, const Vector3& _Acceleration );
-
-            /// <summary>Process the next position using Euler average velocity integration.</summary>
-            /// <param name="_InOutPosition">The position to process.</param>
-            /// <param name="_Velocity">The velocity of the current step, will be updated.</param>
-            /// <param name="_Acceleration">The acceleration of the current step.</param>
-            void EulerAverageVelocityIntegration( Vector3& _InOutPosition, Vector3& _InOutVelocity, const Vector3& _Acceleration );
+            /// <summary>Count of bodies per job, less would cost more in scheduling than in simulation.</summary>
+            static constexpr Uint32 ObjectsPerJob = 256;
+
+            /// <summary>Range of the simulated bodies of a chunk, the integration skips the rest of the chunk.</summary>
+            struct ChunkRange
+            {
+                /// <summary>First simulated body.</summary>
+                Uint32 Begin;
+
+                /// <summary>Body after the last simulated one, equal to Begin if the chunk has none.</summary>
+                Uint32 End;
+            };
+
+            /// <summary>Accumulate the time of the frame and process the count of fixed steps to simulate.</summary>
+            void UpdateTimeStep();
+
+            /// <summary>Prepare the awake objects of a chunk, mask the other bodies and list the objects whose collider must be placed again.</summary>
+            /// <param name="_Chunk">Index of the chunk.</param>
+            /// <param name="_WakeUp">Must the objects be woken up (the gravity or the wind changed) ?</param>
+            void PrepareChunk( Uint32 _Chunk, Bool _WakeUp );
+
+            /// <summary>Integrate steps for the simulated bodies of a chunk, four at a time.</summary>
+            /// <param name="_Chunk">Index of the chunk.</param>
+            /// <param name="_StepCount">Count of steps to integrate.</param>
+            /// <param name="_Integrator">Integrator to use.</param>
+            void IntegrateChunk( Uint32 _Chunk, Uint32 _StepCount, IntegratorFunction _Integrator );
+
+            /// <summary>Check if the simulated objects of a chunk fall asleep and place them for the rendering.</summary>
+            /// <param name="_Chunk">Index of the chunk.</param>
+            void FinishChunk( Uint32 _Chunk );
+
+            /// <summary>
+            /// Place the dirty colliders, list the simulated bodies having a collider and update the pairs of the broadphase.
+            /// Reads the world matrices : called from the main thread.
+            /// </summary>
+            /// <param name="_ChunksCount">Count of chunks.</param>
+            /// <param name="_Bodies">Arrays of the bodies.</param>
+            /// <param name="_Jobs">Job system to query the broadphase on.</param>
+            void PrepareCollisions( Uint32 _ChunksCount, const CollisionSolver::Bodies& _Bodies, JobSystem& _Jobs );
+
+            /// <summary>Restart the simulation of an object from its position if it has been moved, and process its acceleration.</summary>
+            /// <param name="_Object">Object to prepare.</param>
+            /// <param name="_Body">Body of the object.</param>
+            void PrepareObject( PhysicObject& _Object, Uint32 _Body );
+
+            /// <summary>Check if an integrated object falls asleep and place it for the rendering.</summary>
+            /// <param name="_Object">Object to update.</param>
+            /// <param name="_Body">Body of the object.</param>
+            void FinishObject( PhysicObject& _Object, Uint32 _Body );
 
             /// <summary>Retrieve the integrator that the user wants to process the new position and the velocity.</summary>
             /// <returns>The integrator to use to update the positions and velocity.</returns>
             IntegratorFunction GetIntegrator() const;
 
+            /// <summary>Give the size of the arrays, without shrinking them. The new bodies are at rest, without object.</summary>
+            /// <param name="_Count">Count of bodies.</param>
+            void ResizeArrays( Uint32 _Count );
+
         private:
             /// <summary>Current world physics settings.</summary>
             PhysicsSettings m_Settings;
 
-            /// <summary>Current time step for this frame.</summary>
+            /// <summary>Duration of a fixed step.</summary>
             float m_TimeStep;
-            
+
+            /// <summary>Time not simulated yet, less than a step after the update.</summary>
+            float m_Accumulator;
+
+            /// <summary>Count of steps to simulate this frame.</summary>
+            Uint32 m_StepCount;
+
+            /// <summary>Position between the two last steps to place the objects at, from 0 (previous step) to 1 (last step).</summary>
+            float m_Alpha;
+
+            /// <summary>Gravity of the last frame, the sleeping objects are woken up when it changes.</summary>
+            Vector3 m_LastGravity;
+
+            /// <summary>Global wind of the last frame, the sleeping objects are woken up when it changes.</summary>
+            Vector3 m_LastWind;
+
+            /// <summary>Positions at the end of the last step, one array per axis.</summary>
+            std::vector<float> m_Positions[3];
+
+            /// <summary>Positions at the start of the last step, the interpolation starts from them. One array per axis.</summary>
+            std::vector<float> m_PreviousPositions[3];
+
+            /// <summary>Velocities, one array per axis.</summary>
+            std::vector<float> m_Velocities[3];
+
+            /// <summary>Forces applied by the users, one array per axis.</summary>
+            std::vector<float> m_Forces[3];
+
+            /// <summary>Masses of the bodies.</summary>
+            std::vector<float> m_Masses;
+
+            /// <summary>Accelerations not depending on the velocity (forces, gravity and wind over the mass), one array per axis. Processed each frame.</summary>
+            std::vector<float> m_Accelerations[3];
+
+            /// <summary>Air resistance over the mass : the acceleration of a step is Acceleration - Damping * Velocity. Processed each frame.</summary>
+            std::vector<float> m_Dampings;
+
+            /// <summary>Inverse of the masses, for the collisions. Processed each frame.</summary>
+            std::vector<float> m_InverseMasses;
+
+            /// <summary>All bits set for the bodies simulated this frame, 0 for the others : the integration keeps their state.</summary>
+            std::vector<Uint32> m_SimulatedMasks;
+
+            /// <summary>Object of each body, null for a free slot.</summary>
+            std::vector<PhysicObject*> m_Objects;
+
+            /// <summary>Simulated bodies of each chunk.</summary>
+            std::vector<ChunkRange> m_ChunkRanges;
+
+            /// <summary>Objects whose collider must be placed again, stored from the first body of each chunk.</summary>
+            std::vector<PhysicObject*> m_DirtyColliders;
+
+            /// <summary>Count of dirty colliders of each chunk.</summary>
+            std::vector<Uint32> m_ChunkDirtyCounts;
+
+            /// <summary>Simulated bodies having a collider.</summary>
+            std::vector<Uint32> m_CollidingEntries;
+
+            /// <summary>Broadphase and solver of the collisions.</summary>
+            CollisionSolver m_Collisions;
         };
     } // priv
 } // ae
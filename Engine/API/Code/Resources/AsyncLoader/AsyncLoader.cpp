@@ -0,0 +1,206 @@
+#include "AsyncLoader.h"
+
+#include "../../TimeManagement/Time/Time.h"
+
+#include <algorithm>
+
+namespace ae
+{
+	AsyncLoader::AsyncLoader() :
+		m_IsStopping( False ),
+		m_NextRequestID( InvalidRequestID + 1 ),
+		m_UploadBudget( 4.0f ),
+		m_MaxWaitingUploads( 16 )
+	{
+	}
+
+	AsyncLoader::~AsyncLoader()
+	{
+		{
+			std::lock_guard<std::mutex> Lock( m_Mutex );
+			m_IsStopping = True;
+		}
+
+		m_DecodeCondition.notify_all();
+		m_UploadSlotCondition.notify_all();
+
+		for( std::thread& Worker : m_Workers )
+			Worker.join();
+	}
+
+	AsyncLoader::RequestID AsyncLoader::Load( Task _Decode, Task _Upload )
+	{
+		StartWorkers();
+
+		std::shared_ptr<Request> NewRequest = std::make_shared<Request>();
+		NewRequest->Decode = std::move( _Decode );
+		NewRequest->Upload = std::move( _Upload );
+		NewRequest->IsCancelled = False;
+
+		{
+			std::lock_guard<std::mutex> Lock( m_Mutex );
+
+			NewRequest->ID = m_NextRequestID++;
+			m_Requests.emplace( NewRequest->ID, NewRequest );
+			m_DecodeQueue.push_back( NewRequest );
+		}
+
+		m_DecodeCondition.notify_one();
+
+		return NewRequest->ID;
+	}
+
+	void AsyncLoader::Cancel( RequestID _Request )
+	{
+		std::lock_guard<std::mutex> Lock( m_Mutex );
+
+		std::unordered_map<RequestID, std::shared_ptr<Request>>::iterator ItRequest = m_Requests.find( _Request );
+		if( ItRequest != m_Requests.end() )
+			ItRequest->second->IsCancelled = True;
+	}
+
+	Bool AsyncLoader::IsPending( RequestID _Request ) const
+	{
+		std::lock_guard<std::mutex> Lock( m_Mutex );
+		return m_Requests.find( _Request ) != m_Requests.cend();
+	}
+
+	Uint32 AsyncLoader::GetPendingCount() const
+	{
+		std::lock_guard<std::mutex> Lock( m_Mutex );
+		return Cast( Uint32, m_Requests.size() );
+	}
+
+	void AsyncLoader::ProcessUploads()
+	{
+		const Int64 StartTime = Time::GetTick().AsMicroSeconds();
+		const Int64 Budget = Cast( Int64, m_UploadBudget * 1000.0f );
+
+		// At least one upload per frame, so loading always progresses.
+		do
+		{
+			std::shared_ptr<Request> NextUpload = PopUpload();
+			if( NextUpload == nullptr )
+				return;
+
+			if( !NextUpload->IsCancelled )
+				NextUpload->Upload();
+
+		} while( Time::GetTick().AsMicroSeconds() - StartTime < Budget );
+	}
+
+	void AsyncLoader::Flush()
+	{
+		while( True )
+		{
+			std::shared_ptr<Request> NextUpload = PopUpload();
+
+			if( NextUpload != nullptr )
+			{
+				if( !NextUpload->IsCancelled )
+					NextUpload->Upload();
+
+				continue;
+			}
+
+			std::unique_lock<std::mutex> Lock( m_Mutex );
+
+			if( m_Requests.empty() )
+				return;
+
+			m_UploadReadyCondition.wait( Lock, [this]() { return !m_UploadQueue.empty() || m_Requests.empty(); } );
+		}
+	}
+
+	void AsyncLoader::SetUploadBudget( float _Milliseconds )
+	{
+		m_UploadBudget = _Milliseconds;
+	}
+
+	float AsyncLoader::GetUploadBudget() const
+	{
+		return m_UploadBudget;
+	}
+
+	void AsyncLoader::SetMaxWaitingUploads( Uint32 _Count )
+	{
+		{
+			std::lock_guard<std::mutex> Lock( m_Mutex );
+			m_MaxWaitingUploads = std::max( _Count, 1u );
+		}
+
+		m_UploadSlotCondition.notify_all();
+	}
+
+	void AsyncLoader::StartWorkers()
+	{
+		if( !m_Workers.empty() )
+			return;
+
+		// Keep a core for the main thread, more workers would only fight for the disk.
+		const Uint32 HardwareThreads = std::thread::hardware_concurrency();
+		const Uint32 WorkersCount = std::min( std::max( HardwareThreads, 2u ) - 1, 4u );
+
+		m_Workers.reserve( WorkersCount );
+		for( Uint32 w = 0; w < WorkersCount; w++ )
+			m_Workers.emplace_back( &AsyncLoader::WorkerLoop, this );
+	}
+
+	void AsyncLoader::WorkerLoop()
+	{
+		while( True )
+		{
+			std::shared_ptr<Request> NextDecode;
+
+			{
+				std::unique_lock<std::mutex> Lock( m_Mutex );
+				m_DecodeCondition.wait( Lock, [this]() { return m_IsStopping || !m_DecodeQueue.empty(); } );
+
+				if( m_IsStopping )
+					return;
+
+				NextDecode = m_DecodeQueue.front();
+				m_DecodeQueue.pop_front();
+			}
+
+			if( !NextDecode->IsCancelled )
+				NextDecode->Decode();
+
+			{
+				// Wait for the main thread to upload some requests, the decoded data stay in memory until then.
+				std::unique_lock<std::mutex> Lock( m_Mutex );
+				m_UploadSlotCondition.wait( Lock, [this]() { return m_IsStopping || m_UploadQueue.size() < m_MaxWaitingUploads; } );
+
+				if( m_IsStopping )
+					return;
+
+				m_UploadQueue.push_back( NextDecode );
+			}
+
+			m_UploadReadyCondition.notify_all();
+		}
+	}
+
+	std::shared_ptr<AsyncLoader::Request> AsyncLoader::PopUpload()
+	{
+		std::shared_ptr<Request> NextUpload;
+
+		{
+			std::lock_guard<std::mutex> Lock( m_Mutex );
+
+			if( m_UploadQueue.empty() )
+				return nullptr;
+
+			NextUpload = m_UploadQueue.front();
+			m_UploadQueue.pop_front();
+
+			// Finished from now, an upload step can flush the loader without waiting for itself.
+			m_Requests.erase( NextUpload->ID );
+		}
+
+		m_UploadSlotCondition.notify_one();
+
+		return NextUpload;
+	}
+
+} // ae
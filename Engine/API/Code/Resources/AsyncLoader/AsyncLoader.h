@@ -0,0 +1,167 @@
+#pragma once
+
+#include "../../Toolbox/Toolbox.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+
+#include <functional>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <unordered_map>
+
+namespace ae
+{
+	/// \ingroup resources
+	/// <summary>Loading state of a resource loaded in the background.</summary>
+	enum class LoadingState : Uint8
+	{
+		/// <summary>The resource is being read or waits for its upload, a placeholder is used meanwhile.</summary>
+		Pending,
+
+		/// <summary>The resource is loaded and uploaded to the GPU.</summary>
+		Ready,
+
+		/// <summary>The resource could not be loaded, the placeholder is kept.</summary>
+		Failed
+	};
+
+	/// \ingroup resources
+	/// <summary>
+	/// Load resources in the background.<para/>
+	/// A request is made of two steps : a decode step reading and decoding files on a worker thread,
+	/// then an upload step creating the OpenGL objects on the context thread.<para/>
+	/// The upload steps are run by AeroCore::Update within a time budget per frame,
+	/// so a large scene can stream in while the window stays interactive.
+	/// </summary>
+	/// <remarks>
+	/// The decode step must not touch OpenGL nor the resources manager (resources are not thread safe),
+	/// it should only fill data owned by the request.
+	/// </remarks>
+	class AERO_CORE_EXPORT AsyncLoader : public NotCopiable
+	{
+	public:
+		/// <summary>Identifier of a load request.</summary>
+		using RequestID = Uint64;
+
+		/// <summary>Step of a load request.</summary>
+		using Task = std::function<void()>;
+
+		/// <summary>Returned when no request could be created.</summary>
+		static constexpr RequestID InvalidRequestID = 0;
+
+	public:
+		/// <summary>Build a loader without worker, they are started with the first request.</summary>
+		AsyncLoader();
+
+		/// <summary>Stop the workers. Requests not uploaded yet are dropped.</summary>
+		~AsyncLoader();
+
+		/// <summary>Queue a load request.</summary>
+		/// <param name="_Decode">Step run on a worker thread : file reading and decoding.</param>
+		/// <param name="_Upload">Step run on the context thread after the decode : OpenGL objects creation.</param>
+		/// <returns>Identifier of the request.</returns>
+		RequestID Load( Task _Decode, Task _Upload );
+
+		/// <summary>
+		/// Cancel a request. Its decode step is skipped if not started yet and its upload step is never run.<para/>
+		/// Must be called by the owner of the data touched by the upload step before destroying it.
+		/// </summary>
+		/// <param name="_Request">Request to cancel.</param>
+		void Cancel( RequestID _Request );
+
+		/// <summary>Is a request still waiting for its decode or upload step ?</summary>
+		/// <param name="_Request">Request to check.</param>
+		/// <returns>True if the request is not finished, False otherwise.</returns>
+		Bool IsPending( RequestID _Request ) const;
+
+		/// <summary>Get the count of requests not finished.</summary>
+		/// <returns>Count of requests waiting for their decode or upload step.</returns>
+		Uint32 GetPendingCount() const;
+
+		/// <summary>
+		/// Run the upload steps of the decoded requests until the upload budget is spent.<para/>
+		/// Called each frame by AeroCore::Update.
+		/// </summary>
+		void ProcessUploads();
+
+		/// <summary>Wait for all the requests to be decoded and run all their uploads, whatever the budget.</summary>
+		void Flush();
+
+		/// <summary>Set the time that can be spent uploading each frame. At least one upload is done per frame.</summary>
+		/// <param name="_Milliseconds">Budget in milliseconds.</param>
+		void SetUploadBudget( float _Milliseconds );
+
+		/// <summary>Get the time that can be spent uploading each frame.</summary>
+		/// <returns>Budget in milliseconds.</returns>
+		float GetUploadBudget() const;
+
+		/// <summary>
+		/// Set the count of decoded requests that can wait for their upload.<para/>
+		/// Workers wait when it is reached, it bounds the memory taken by the decoded data.
+		/// </summary>
+		/// <param name="_Count">Maximum count of requests waiting for their upload.</param>
+		void SetMaxWaitingUploads( Uint32 _Count );
+
+	private:
+		/// <summary>A request and its state.</summary>
+		struct Request
+		{
+			RequestID ID;
+			Task Decode;
+			Task Upload;
+			std::atomic<Bool> IsCancelled;
+		};
+
+		/// <summary>Start the workers threads if not already done.</summary>
+		void StartWorkers();
+
+		/// <summary>Loop of the workers : decode the requests and push them in the upload queue.</summary>
+		void WorkerLoop();
+
+		/// <summary>Take the next decoded request.</summary>
+		/// <returns>The request, null if none is decoded.</returns>
+		std::shared_ptr<Request> PopUpload();
+
+	private:
+		/// <summary>Threads running the decode steps.</summary>
+		std::vector<std::thread> m_Workers;
+
+		/// <summary>Requests waiting for their decode step.</summary>
+		std::deque<std::shared_ptr<Request>> m_DecodeQueue;
+
+		/// <summary>Requests decoded, waiting for their upload step.</summary>
+		std::deque<std::shared_ptr<Request>> m_UploadQueue;
+
+		/// <summary>Requests not finished, by ID.</summary>
+		std::unordered_map<RequestID, std::shared_ptr<Request>> m_Requests;
+
+		/// <summary>Protect the queues and the requests map.</summary>
+		mutable std::mutex m_Mutex;
+
+		/// <summary>Signaled when a request is queued for decode or the loader is stopping.</summary>
+		std::condition_variable m_DecodeCondition;
+
+		/// <summary>Signaled when a request is taken from the upload queue.</summary>
+		std::condition_variable m_UploadSlotCondition;
+
+		/// <summary>Signaled when a request is pushed in the upload queue.</summary>
+		std::condition_variable m_UploadReadyCondition;
+
+		/// <summary>Are the workers asked to stop ?</summary>
+		Bool m_IsStopping;
+
+		/// <summary>ID of the next request.</summary>
+		RequestID m_NextRequestID;
+
+		/// <summary>Time that can be spent uploading each frame, in milliseconds.</summary>
+		float m_UploadBudget;
+
+		/// <summary>Maximum count of requests waiting for their upload.</summary>
+		Uint32 m_MaxWaitingUploads;
+	};
+
+} // ae
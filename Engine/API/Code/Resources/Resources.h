@@ -11,3 +11,4 @@
 
 #include "Resource/Resource.h"
 #include "ResourcesManager.h"
+#include "AsyncLoader/AsyncLoader.h"
@@ -8,6 +8,8 @@
 #include "../Graphics/Material/SkyboxMaterial.h"
 #include "../Graphics/Material/FramebufferMaterial.h"
 #include "../Graphics/Material/CurveMaterial.h"
+#include "../Graphics/Shader/UniformBlock/UniformBlockPool.h"
+#include "../Debugging/Debugging.h"
 #include "../Aero/Aero.h"
 
 namespace ae
@@ -15,6 +17,8 @@ namespace ae
 	ResourcesManager::ResourcesManager() :
 		m_Default3DShader( nullptr ),
 		m_DefaultCookTorranceShader( nullptr ),
+		m_DefaultInstanced3DShader( nullptr ),
+		m_DefaultInstancedCookTorranceShader( nullptr ),
 		m_Default2DShader( nullptr ),
 		m_DefaultToonShader( nullptr ),
 		m_DefaultUniShadowMapShader( nullptr ),
@@ -25,7 +29,10 @@ namespace ae
 		m_Default3DMaterial( nullptr ),
 		m_Default2DMaterial( nullptr ),
 		m_DefaultFramebufferMaterial( nullptr ),
-		m_DefaultSkyboxMaterial( nullptr )
+		m_DefaultSkyboxMaterial( nullptr ),
+		m_GeometryCacheHits( 0 ),
+		m_GeometryCacheMisses( 0 ),
+		m_GeometrySavedLoadTime( 0.0f )
 	{
 	}
 
@@ -34,29 +41,26 @@ namespace ae
 		UnloadAll();
 		UnloadEngineMaterials();
 		UnloadEngineShaders();
+		UnloadUniformBlockPools();
+		UnloadGeometries();
 	}
-	const std::unordered_map<ResourcesManager::ResourceID, Resource*>& ResourcesManager::GetResources() const
-	{
-		return m_Resources;
-	}
-
-	std::unordered_map<ResourcesManager::ResourceID, Resource*>& ResourcesManager::GetResources()
+	const HandleMap<Resource*>& ResourcesManager::GetResources() const
 	{
 		return m_Resources;
 	}
 
 	const Resource* ResourcesManager::GetResource( ResourceID _ID ) const
 	{
-		if( _ID == InvalidResourceID )
+		if( !m_IDPool.IsValid( _ID ) )
 		{
-			AE_LogError( "Invalid ID. Function will return nullptr." );
+			AE_LogError( "Invalid ID or destroyed resource. Function will return nullptr." );
 			return nullptr;
 		}
 
-		std::unordered_map<ResourceID, Resource*>::const_iterator It = m_Resources.find( _ID );
+		const Resource* const* Found = m_Resources.Find( _ID );
 
-		if( It != m_Resources.cend() )
-			return It->second;
+		if( Found != nullptr )
+			return *Found;
 
 		else
 		{
@@ -67,16 +71,16 @@ namespace ae
 
 	Resource* ResourcesManager::GetResource( ResourceID _ID )
 	{
-		if( _ID == InvalidResourceID )
+		if( !m_IDPool.IsValid( _ID ) )
 		{
-			AE_LogError( "Invalid ID. Function will return nullptr." );
+			AE_LogError( "Invalid ID or destroyed resource. Function will return nullptr." );
 			return nullptr;
 		}
 
-		std::unordered_map<ResourceID, Resource*>::const_iterator It = m_Resources.find( _ID );
+		Resource** Found = m_Resources.Find( _ID );
 
-		if( It != m_Resources.cend() )
-			return It->second;
+		if( Found != nullptr )
+			return *Found;
 
 		else
 		{
@@ -85,14 +89,19 @@ namespace ae
 		}
 	}
 
+	Bool ResourcesManager::IsResourceValid( ResourceID _ID ) const
+	{
+		return m_IDPool.IsValid( _ID );
+	}
+
 	ResourcesManager::ResourceID ResourcesManager::GenerateResourceID()
 	{
-		return m_IDPool.GenerateID();
+		return m_IDPool.GenerateHandle();
 	}
 
 	void ResourcesManager::FreeResourceID( ResourceID _ID )
 	{
-		m_IDPool.FreeID( _ID );
+		m_IDPool.FreeHandle( _ID );
 	}
 
 	ResourcesManager::ResourceID ResourcesManager::AddResource( Resource* _ResourceToAdd )
@@ -112,15 +121,14 @@ namespace ae
 			return InvalidResourceID;
 		}
 
-		if( m_Resources.find( NewID ) != m_Resources.cend() )
+		// Add the resource to the manager with this ID.
+		if( !m_Resources.Insert( NewID, _ResourceToAdd ) )
 		{
 			AE_LogError( std::string( "Resource with the generated ID (" ) + std::to_string( NewID ) + ") already exists." );
+			FreeResourceID( NewID );
 			return InvalidResourceID;
 		}
 
-		// Add the resource to the manager with this ID.
-		m_Resources.insert( { NewID , _ResourceToAdd } );
-
 		return NewID;
 	}
 
@@ -134,15 +142,13 @@ namespace ae
 
 		const ResourceID& ToDeleteID = _ResourceToRemove->GetResourceID();
 
-		if( m_Resources.find( ToDeleteID ) == m_Resources.cend() )
+		// Remove the resource from the manager.
+		if( !m_Resources.Remove( ToDeleteID ) )
 		{
 			AE_LogError( std::string( "Resource with the ID (" ) + std::to_string( ToDeleteID ) + ") doesn't exist. Impossible to remove it from the manager." );
 			return;
 		}
 
-		// Remove the resource from the manager.
-		m_Resources.erase( ToDeleteID );
-
 		// Make its ID available again.
 		FreeResourceID( ToDeleteID );
 	}
@@ -154,9 +160,8 @@ namespace ae
 		std::vector<Resource*> ToFree;
 
 		// Retrieve in the manager all the resources to free.
-		for( std::pair<const ResourceID, Resource*> ResourcePair : m_Resources )
+		for( Resource* ResourcePtr : m_Resources )
 		{
-			Resource* ResourcePtr = ResourcePair.second;
 			if( ResourcePtr != nullptr && ResourcePtr->IsManagedByManager() )
 				ToFree.push_back( ResourcePtr );
 		}
@@ -191,6 +196,30 @@ namespace ae
 		return m_DefaultCookTorranceShader;
 	}
 
+	Shader* ResourcesManager::GetDefaultInstanced3DShader()
+	{
+		if( m_DefaultInstanced3DShader == nullptr )
+		{
+			const std::string& PathToEngineData = Aero.GetPathToEngineData() + "/Shader/";
+			m_DefaultInstanced3DShader = new Shader( PathToEngineData + "Default3DInstancedVertex.glsl", PathToEngineData + "Default3DFragment.glsl" );
+			m_DefaultInstanced3DShader->SetName( "Default Instanced 3D Shader" );
+		}
+
+		return m_DefaultInstanced3DShader;
+	}
+
+	Shader* ResourcesManager::GetDefaultInstancedCookTorranceShader()
+	{
+		if( m_DefaultInstancedCookTorranceShader == nullptr )
+		{
+			const std::string& PathToEngineData = Aero.GetPathToEngineData() + "/Shader/";
+			m_DefaultInstancedCookTorranceShader = new Shader( PathToEngineData + "Default3DInstancedVertex.glsl", PathToEngineData + "PBRFragment.glsl" );
+			m_DefaultInstancedCookTorranceShader->SetName( "Default Instanced Cook-Torrance Shader" );
+		}
+
+		return m_DefaultInstancedCookTorranceShader;
+	}
+
 	Shader* ResourcesManager::GetDefault2DShader()
 	{
 		if( m_Default2DShader == nullptr )
@@ -336,6 +365,143 @@ namespace ae
 	}
 
 
+	priv::UniformBlockPool& ResourcesManager::GetUniformBlockPool( const priv::UniformBlockLayout& _Layout )
+	{
+		std::unordered_map<std::string, priv::UniformBlockPool*>::iterator ItPool = m_UniformBlockPools.find( _Layout.GetKey() );
+
+		if( ItPool != m_UniformBlockPools.end() )
+			return *ItPool->second;
+
+		priv::UniformBlockPool* NewPool = new priv::UniformBlockPool( _Layout );
+		m_UniformBlockPools.emplace( _Layout.GetKey(), NewPool );
+
+		return *NewPool;
+	}
+
+	priv::SharedGeometry* ResourcesManager::AcquireGeometry( const std::string& _FileName, Uint32 _ImportFlags, Bool _Async )
+	{
+		const std::string Key = priv::SharedGeometry::MakeKey( _FileName, _ImportFlags );
+
+		std::unordered_map<std::string, priv::SharedGeometry*>::iterator ItGeometry = m_Geometries.find( Key );
+		if( ItGeometry != m_Geometries.end() )
+		{
+			priv::SharedGeometry* Geometry = ItGeometry->second;
+
+			// A synchronous load can't return a geometry without buffers.
+			if( !_Async && Geometry->GetLoadingState() == LoadingState::Pending )
+				Aero.GetAsyncLoader().Flush();
+
+			if( Geometry->GetLoadingState() == LoadingState::Failed )
+				return nullptr;
+
+			m_GeometryCacheHits++;
+			m_GeometrySavedLoadTime += Geometry->GetLoadTime();
+
+			Geometry->AddReference();
+			return Geometry;
+		}
+
+		m_GeometryCacheMisses++;
+
+		priv::SharedGeometry* NewGeometry = new priv::SharedGeometry();
+
+		if( !_Async )
+		{
+			if( !NewGeometry->LoadFromFile( _FileName, _ImportFlags ) )
+			{
+				delete NewGeometry;
+				return nullptr;
+			}
+
+			NewGeometry->AddReference();
+			m_Geometries.emplace( Key, NewGeometry );
+
+			return NewGeometry;
+		}
+
+		// One reference for the caller, one for the loading so the geometry outlives its request.
+		NewGeometry->AddReference();
+		NewGeometry->AddReference();
+		m_Geometries.emplace( Key, NewGeometry );
+
+		Aero.GetAsyncLoader().Load(
+			[NewGeometry, _FileName, _ImportFlags]()
+			{
+				NewGeometry->Decode( _FileName, _ImportFlags );
+			},
+			[this, NewGeometry]()
+			{
+				NewGeometry->FinishLoading();
+				ReleaseGeometry( *NewGeometry );
+			} );
+
+		return NewGeometry;
+	}
+
+	void ResourcesManager::ReleaseGeometry( priv::SharedGeometry& _Geometry )
+	{
+		if( _Geometry.RemoveReference() > 0 )
+			return;
+
+		for( std::unordered_map<std::string, priv::SharedGeometry*>::iterator ItGeometry = m_Geometries.begin(); ItGeometry != m_Geometries.end(); ++ItGeometry )
+		{
+			if( ItGeometry->second != &_Geometry )
+				continue;
+
+			delete ItGeometry->second;
+			m_Geometries.erase( ItGeometry );
+			return;
+		}
+
+		AE_LogWarning( "Trying to release a geometry that is not in the cache." );
+	}
+
+	GeometryCacheStats ResourcesManager::GetGeometryCacheStats() const
+	{
+		GeometryCacheStats Stats;
+		Stats.GeometriesCount = Cast( Uint32, m_Geometries.size() );
+		Stats.Hits = m_GeometryCacheHits;
+		Stats.Misses = m_GeometryCacheMisses;
+		Stats.SavedLoadTime = m_GeometrySavedLoadTime;
+
+		for( const std::pair<const std::string, priv::SharedGeometry*>& GeometryPair : m_Geometries )
+		{
+			const priv::SharedGeometry& Geometry = *GeometryPair.second;
+
+			// The data of a pending geometry may still be written by a loader worker.
+			if( Geometry.GetLoadingState() != LoadingState::Ready )
+				continue;
+
+			const Uint32 ReferencesCount = Geometry.GetReferencesCount();
+
+			Stats.ReferencesCount += ReferencesCount;
+			Stats.GPUMemory += Geometry.GetMemorySize();
+			Stats.LoadTime += Geometry.GetLoadTime();
+
+			// Without the cache, each extra mesh would hold its own copy of the buffers.
+			if( ReferencesCount > 1 )
+				Stats.SavedGPUMemory += Geometry.GetMemorySize() * ( ReferencesCount - 1 );
+		}
+
+		return Stats;
+	}
+
+	priv::ShaderCache& ResourcesManager::GetShaderCache()
+	{
+		return m_ShaderCache;
+	}
+
+	const ShaderCacheStats& ResourcesManager::GetShaderCacheStats() const
+	{
+		return m_ShaderCache.GetStats();
+	}
+
+	priv::ShaderSourceCache& ResourcesManager::GetShaderSourceCache()
+	{
+		return m_ShaderSourceCache;
+	}
+
+
 	void ResourcesManager::UnloadEngineShaders()
 	{
 		if( m_Default3DShader != nullptr )
@@ -350,6 +516,18 @@ namespace ae
 			m_DefaultCookTorranceShader = nullptr;
 		}
 
+		if( m_DefaultInstanced3DShader != nullptr )
+		{
+			delete m_DefaultInstanced3DShader;
+			m_DefaultInstanced3DShader = nullptr;
+		}
+
+		if( m_DefaultInstancedCookTorranceShader != nullptr )
+		{
+			delete m_DefaultInstancedCookTorranceShader;
+			m_DefaultInstancedCookTorranceShader = nullptr;
+		}
+
 		if( m_Default2DShader != nullptr )
 		{
 			delete m_Default2DShader;
@@ -414,5 +592,21 @@ namespace ae
 		}
 	}
 
+	void ResourcesManager::UnloadUniformBlockPools()
+	{
+		for( const std::pair<const std::string, priv::UniformBlockPool*>& PoolPair : m_UniformBlockPools )
+			delete PoolPair.second;
+
+		m_UniformBlockPools.clear();
+	}
+
+	void ResourcesManager::UnloadGeometries()
+	{
+		for( const std::pair<const std::string, priv::SharedGeometry*>& GeometryPair : m_Geometries )
+			delete GeometryPair.second;
+
+		m_Geometries.clear();
+	}
+
 } // ae
 
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "../Toolbox/Toolbox.h"
-#include "../Toolbox/PoolUniqueID/PoolUniqueID.h"
+#include "../Toolbox/HandlePool/HandlePool.h"
+#include "../Toolbox/HandleMap/HandleMap.h"
+#include "../Graphics/Mesh/3D/SharedGeometry.h"
+#include "../Graphics/Shader/ShaderCache/ShaderCache.h"
+#include "../Graphics/Shader/ShaderCache/ShaderSourceCache.h"
 
 #include <unordered_map>
+#include <string>
 
 
 namespace ae
@@ -17,6 +22,12 @@ namespace ae
 	class FramebufferMaterial;
 	class CurveMaterial;
 
+	namespace priv
+	{
+		class UniformBlockLayout;
+		class UniformBlockPool;
+	}
+
 	/// \ingroup resources
 	/// <summary>
 	/// Store references to resources (textures, shaders, ...)
@@ -27,14 +38,14 @@ namespace ae
 		friend class Renderer;
 
 	public:
-		/// <summary>Type used to identify resource in the manager.</summary>
-		using ResourceID = Uint16;
+		/// <summary>Type used to identify resource in the manager : generational handle, never equal to the ID of a destroyed resource.</summary>
+		using ResourceID = HandlePool::Handle;
 
 		/// <summary>Value that represent an invalid resource ID.</summary>
-		static constexpr ResourceID InvalidResourceID = PoolUniqueID::InvalidID;
+		static constexpr ResourceID InvalidResourceID = HandlePool::InvalidHandle;
 
 		/// <summary>Represents the maximum amount of resources that the world can have at the same time.</summary>
-		static constexpr ResourceID MaxResourceID = PoolUniqueID::MaxID;
+		static constexpr Uint32 MaxResourceID = HandlePool::MaxSlotsCount;
 
 	public:
 		/// <summary>Default constructor.</summary>
@@ -49,12 +60,8 @@ namespace ae
 
 		
 		/// <summary>Retrieve all the resources of the manager.</summary>
-		/// <returns>Manager's resources.</returns>
-		const std::unordered_map<ResourceID, Resource*>& GetResources() const;
-
-		/// <summary>Retrieve all the resources of the manager.</summary>
-		/// <returns>Manager's resources.</returns>
-		std::unordered_map<ResourceID, Resource*>& GetResources();
+		/// <returns>Manager's resources, stored contiguously.</returns>
+		const HandleMap<Resource*>& GetResources() const;
 
 		/// <summary>Get the resource with the <paramref name="_ID"/> in the manager.</summary>
 		/// <param name="_ID">The ID of the resource to retrieve from the manager.</param>
@@ -65,6 +72,11 @@ namespace ae
 		/// <param name="_ID">The ID of the resource to retrieve from the manager.</param>
 		/// <returns>Resource of the manager with the corresponding ID.</returns>
 		Resource* GetResource( ResourceID _ID );
+
+		/// <summary>Is an ID the one of a resource still in the manager ?</summary>
+		/// <param name="_ID">The ID to check.</param>
+		/// <returns>True if the resource exists, False if the ID is invalid or its resource has been destroyed.</returns>
+		Bool IsResourceValid( ResourceID _ID ) const;
 		
 		/// <summary>
 		/// Free memory of all resources stored tagged as managed by the manager.
@@ -78,6 +90,14 @@ namespace ae
 		/// <summary>Retrieve the default Cook-Torrance shader of the engine.</summary>
 		/// <returns>The default Cook-Torrance shader of the engine.</returns>
 		Shader* GetDefaultCookTorranceShader();
+
+		/// <summary>Retrieve the default 3D shader of the engine for instanced drawables.</summary>
+		/// <returns>The default instanced 3D shader of the engine.</returns>
+		Shader* GetDefaultInstanced3DShader();
+
+		/// <summary>Retrieve the default Cook-Torrance shader of the engine for instanced drawables.</summary>
+		/// <returns>The default instanced Cook-Torrance shader of the engine.</returns>
+		Shader* GetDefaultInstancedCookTorranceShader();
 		
 		/// <summary>Retrieve the default 2D shader of the engine.</summary>
 		/// <returns>The default 2D shader of the engine.</returns>
@@ -127,6 +147,47 @@ namespace ae
 		/// <returns>The default skybox material of the engine.</returns>
 		SkyboxMaterial* GetDefaultSkyboxMaterial();
 
+		/// <summary>
+		/// Retrieve the pool of uniform buffers for a block layout, created at the first request.<para/>
+		/// Materials whose shaders share the same block layout share the same pool.
+		/// </summary>
+		/// <param name="_Layout">Layout of the block.</param>
+		/// <returns>The pool for this layout.</returns>
+		priv::UniformBlockPool& GetUniformBlockPool( const priv::UniformBlockLayout& _Layout );
+
+		/// <summary>
+		/// Retrieve the geometry of a 3D file, loaded at the first request.<para/>
+		/// Meshes loading the same file with the same flags share the same buffers.
+		/// The caller holds a reference and must give it back with ReleaseGeometry.<para/>
+		/// With <paramref name="_Async"/>, the file is loaded by the asynchronous loader and the geometry stays pending until uploaded.
+		/// Without it, a geometry still pending is finished before returning.
+		/// </summary>
+		/// <param name="_FileName">Path to the 3D file.</param>
+		/// <param name="_ImportFlags">Assimp post process flags.</param>
+		/// <param name="_Async">Load the file in the background ?</param>
+		/// <returns>The geometry of the file, null if the file cannot be loaded.</returns>
+		priv::SharedGeometry* AcquireGeometry( const std::string& _FileName, Uint32 _ImportFlags, Bool _Async = False );
+
+		/// <summary>Give back a reference on a geometry. The geometry is freed when it is no longer used.</summary>
+		/// <param name="_Geometry">Geometry to release.</param>
+		void ReleaseGeometry( priv::SharedGeometry& _Geometry );
+
+		/// <summary>Retrieve the memory and load time used and saved by the geometry cache.</summary>
+		/// <returns>Statistics of the geometry cache.</returns>
+		GeometryCacheStats GetGeometryCacheStats() const;
+
+		/// <summary>Retrieve the disk cache of linked shader programs, to change its directory or disable it.</summary>
+		/// <returns>The shader cache.</returns>
+		priv::ShaderCache& GetShaderCache();
+
+		/// <summary>Retrieve how many shaders have been loaded from the shader cache and the time spent creating them.</summary>
+		/// <returns>Statistics of the shader cache.</returns>
+		const ShaderCacheStats& GetShaderCacheStats() const;
+
+		/// <summary>Retrieve the cache of the shader files and includes, to configure the hot reload of the shaders.</summary>
+		/// <returns>The shader source cache.</returns>
+		priv::ShaderSourceCache& GetShaderSourceCache();
+
 	private:
 		/// <summary>Take a new resource ID from the pool.</summary>
 		/// <returns>The new ID taken from the pool (can be InvalidResourceID).</returns>
@@ -160,12 +221,18 @@ namespace ae
 		/// <summary>Unlaod default engine materials.</summary>
 		void UnloadEngineMaterials();
 
+		/// <summary>Free the uniform block pools. Must be called after the materials are unloaded.</summary>
+		void UnloadUniformBlockPools();
+
+		/// <summary>Free the cached geometries still loaded.</summary>
+		void UnloadGeometries();
+
 	private:
 		/// <summary>Resource ID generator.</summary>
-		PoolUniqueID m_IDPool;
+		HandlePool m_IDPool;
 
-		/// <summary>Textures.</summary>
-		std::unordered_map<ResourceID, Resource*> m_Resources;
+		/// <summary>Resources, by ID.</summary>
+		HandleMap<Resource*> m_Resources;
 
 
 		/// <summary>Default 3D rendering shader.</summary>
@@ -174,6 +241,12 @@ namespace ae
 		/// <summary>Default Cook-Torrance BRDF shader.</summary>
 		Shader* m_DefaultCookTorranceShader;
 
+		/// <summary>Default 3D rendering shader for instanced drawables.</summary>
+		Shader* m_DefaultInstanced3DShader;
+
+		/// <summary>Default Cook-Torrance BRDF shader for instanced drawables.</summary>
+		Shader* m_DefaultInstancedCookTorranceShader;
+
 		/// <summary>Default 2D rendering shader.</summary>
 		Shader* m_Default2DShader;
 
@@ -215,6 +288,27 @@ namespace ae
 
 		/// <summary>Default skybox material for rendering.</summary>
 		SkyboxMaterial* m_DefaultSkyboxMaterial;
+
+		/// <summary>Uniform block pools by layout key.</summary>
+		std::unordered_map<std::string, priv::UniformBlockPool*> m_UniformBlockPools;
+
+		/// <summary>Geometries of the loaded 3D files by path and import flags.</summary>
+		std::unordered_map<std::string, priv::SharedGeometry*> m_Geometries;
+
+		/// <summary>Count of geometry requests answered by the cache.</summary>
+		Uint32 m_GeometryCacheHits;
+
+		/// <summary>Count of geometry requests that loaded a file.</summary>
+		Uint32 m_GeometryCacheMisses;
+
+		/// <summary>Sum of the load times of the geometries answered by the cache.</summary>
+		float m_GeometrySavedLoadTime;
+
+		/// <summary>Disk cache of the linked shader programs.</summary>
+		priv::ShaderCache m_ShaderCache;
+
+		/// <summary>Content of the shader files and the shaders using them.</summary>
+		priv::ShaderSourceCache m_ShaderSourceCache;
 	};
 
 } // ae
@@ -0,0 +1,127 @@
+#include "FrameAllocator.h"
+
+#include "../../Maths/Functions/MathsFunctions.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace ae
+{
+	namespace priv
+	{
+		namespace
+		{
+			/// <summary>Current frame, incremented by FrameArena::EndFrame.</summary>
+			std::atomic<Uint64> CurrentFrame( 0 );
+		}
+
+		constexpr size_t FrameArena::DefaultBlockSize;
+
+		FrameArena& FrameArena::Get()
+		{
+			thread_local FrameArena Arena;
+			return Arena;
+		}
+
+		void FrameArena::EndFrame()
+		{
+			CurrentFrame.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		FrameArena::FrameArena() :
+			m_Offset( 0 ),
+			m_UsedInPreviousBlocks( 0 ),
+			m_Frame( CurrentFrame.load( std::memory_order_relaxed ) )
+		{
+		}
+
+		FrameArena::~FrameArena()
+		{
+		}
+
+		void* FrameArena::Allocate( size_t _Size, size_t _Alignment )
+		{
+			const Uint64 Frame = CurrentFrame.load( std::memory_order_relaxed );
+			if( Frame != m_Frame )
+			{
+				Rewind();
+				m_Frame = Frame;
+			}
+
+			void* Result = AllocateInCurrentBlock( _Size, _Alignment );
+			if( Result != nullptr )
+				return Result;
+
+			// The block is full : continue in a new one, large enough for the padding too.
+			AddBlock( _Size + _Alignment );
+
+			return AllocateInCurrentBlock( _Size, _Alignment );
+		}
+
+		void* FrameArena::AllocateInCurrentBlock( size_t _Size, size_t _Alignment )
+		{
+			if( m_Blocks.empty() )
+				return nullptr;
+
+			Block& Current = m_Blocks.back();
+
+			const uintptr_t Address = reinterpret_cast<uintptr_t>( Current.Data.get() ) + m_Offset;
+			const size_t Padding = Cast( size_t, ( _Alignment - ( Address & ( _Alignment - 1 ) ) ) & ( _Alignment - 1 ) );
+
+			if( m_Offset + Padding + _Size > Current.Size )
+				return nullptr;
+
+			Uint8* Result = Current.Data.get() + m_Offset + Padding;
+			m_Offset += Padding + _Size;
+
+			return Result;
+		}
+
+		size_t FrameArena::GetUsedSize() const
+		{
+			return m_UsedInPreviousBlocks + m_Offset;
+		}
+
+		size_t FrameArena::GetCapacity() const
+		{
+			size_t Capacity = 0;
+			for( const Block& CurrentBlock : m_Blocks )
+				Capacity += CurrentBlock.Size;
+
+			return Capacity;
+		}
+
+		void FrameArena::Rewind()
+		{
+			// The last frame did not fit in one block : take one block for all of it, the next frames should fit.
+			if( m_Blocks.size() > 1 )
+			{
+				const size_t Capacity = GetCapacity();
+
+				m_Blocks.clear();
+				AddBlock( Capacity );
+			}
+
+			m_Offset = 0;
+			m_UsedInPreviousBlocks = 0;
+		}
+
+		void FrameArena::AddBlock( size_t _MinimumSize )
+		{
+			if( !m_Blocks.empty() )
+				m_UsedInPreviousBlocks += m_Offset;
+
+			// Each new block doubles the arena, to need few blocks even for a large first frame.
+			const size_t Size = Math::Max( Math::Max( _MinimumSize, DefaultBlockSize ), GetCapacity() );
+
+			Block NewBlock;
+			NewBlock.Data.reset( new Uint8[Size] );
+			NewBlock.Size = Size;
+
+			m_Blocks.push_back( std::move( NewBlock ) );
+			m_Offset = 0;
+		}
+
+	} // priv
+
+} // ae
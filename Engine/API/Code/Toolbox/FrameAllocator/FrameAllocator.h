@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../Toolbox.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace ae
+{
+	namespace priv
+	{
+		/// \ingroup toolbox
+		/// <summary>
+		/// Linear allocator for the data living at most until the end of the frame, one per thread.<para/>
+		/// An allocation only moves a cursor in a block, nothing is freed before the arena is rewound.
+		/// AeroCore::Update ends the frame : each arena rewinds on its next allocation.<para/>
+		/// When a frame overflows the block, more blocks are chained, then merged in one large enough at the next rewind.
+		/// </summary>
+		/// <remarks>
+		/// The memory of a frame must not be kept after AeroCore::Update returns, jobs included.
+		/// Use it through FrameAllocator, FrameString and FrameVector.
+		/// </remarks>
+		class AERO_CORE_EXPORT FrameArena : public NotCopiable
+		{
+		public:
+			/// <summary>Size of the first block of an arena, in bytes.</summary>
+			static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+		public:
+			/// <summary>Get the arena of the calling thread, created on first use.</summary>
+			/// <returns>The arena of the thread.</returns>
+			static FrameArena& Get();
+
+			/// <summary>Start a new frame : the memory of all the arenas can be reused. Called by AeroCore::Update.</summary>
+			static void EndFrame();
+
+			/// <summary>Allocate memory until the end of the frame.</summary>
+			/// <param name="_Size">Size in bytes.</param>
+			/// <param name="_Alignment">Alignment in bytes, power of two.</param>
+			/// <returns>The allocated memory, never null.</returns>
+			void* Allocate( size_t _Size, size_t _Alignment );
+
+			/// <summary>Get the size allocated in the arena during this frame.</summary>
+			/// <returns>Allocated size in bytes, alignment padding included.</returns>
+			size_t GetUsedSize() const;
+
+			/// <summary>Get the size reserved by the arena.</summary>
+			/// <returns>Size of all the blocks in bytes.</returns>
+			size_t GetCapacity() const;
+
+			/// <summary>Free the blocks of the arena.</summary>
+			~FrameArena();
+
+		private:
+			/// <summary>Build an empty arena, the first block is allocated on first use.</summary>
+			FrameArena();
+
+			/// <summary>Allocate in the current block.</summary>
+			/// <param name="_Size">Size in bytes.</param>
+			/// <param name="_Alignment">Alignment in bytes, power of two.</param>
+			/// <returns>The allocated memory, null if there is no block or not enough space left in it.</returns>
+			void* AllocateInCurrentBlock( size_t _Size, size_t _Alignment );
+
+			/// <summary>Move the cursor back to the start, merging the blocks if the frame needed several.</summary>
+			void Rewind();
+
+			/// <summary>Add a block to the arena and make it the current one.</summary>
+			/// <param name="_MinimumSize">Size the block must hold at least.</param>
+			void AddBlock( size_t _MinimumSize );
+
+		private:
+			/// <summary>Memory of the arena, the last one is the current block.</summary>
+			struct Block
+			{
+				std::unique_ptr<Uint8[]> Data;
+				size_t Size;
+			};
+
+			/// <summary>Blocks of the arena.</summary>
+			std::vector<Block> m_Blocks;
+
+			/// <summary>Offset of the next allocation in the current block.</summary>
+			size_t m_Offset;
+
+			/// <summary>Size allocated in the blocks before the current one during this frame.</summary>
+			size_t m_UsedInPreviousBlocks;
+
+			/// <summary>Frame of the last allocation, the arena rewinds when a new frame started since.</summary>
+			Uint64 m_Frame;
+		};
+
+	} // priv
+
+	/// \ingroup toolbox
+	/// <summary>
+	/// Standard allocator in the frame arena of the calling thread, for the transient containers of the hot paths.<para/>
+	/// Deallocations do nothing : the memory is reused after the end of the frame.
+	/// </summary>
+	/// <typeparam name="T">Type of the allocated elements.</typeparam>
+	template<typename T>
+	class FrameAllocator
+	{
+	public:
+		using value_type = T;
+
+	public:
+		FrameAllocator() = default;
+
+		template<typename U>
+		FrameAllocator( const FrameAllocator<U>& )
+		{
+		}
+
+		T* allocate( size_t _Count )
+		{
+			return Cast( T*, priv::FrameArena::Get().Allocate( _Count * sizeof( T ), alignof( T ) ) );
+		}
+
+		void deallocate( T*, size_t )
+		{
+		}
+	};
+
+	template<typename T, typename U>
+	Bool operator==( const FrameAllocator<T>&, const FrameAllocator<U>& )
+	{
+		return True;
+	}
+
+	template<typename T, typename U>
+	Bool operator!=( const FrameAllocator<T>&, const FrameAllocator<U>& )
+	{
+		return False;
+	}
+
+	/// <summary>String in the frame arena, for the names built each frame (uniforms, ...).</summary>
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+	/// <summary>Array in the frame arena.</summary>
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // ae
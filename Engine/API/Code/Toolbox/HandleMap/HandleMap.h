@@ -0,0 +1,184 @@
+#pragma once
+
+#include "../Types.h"
+#include "../HandlePool/HandlePool.h"
+
+#include <vector>
+#include <utility>
+
+namespace ae
+{
+
+	/// \ingroup toolbox
+	/// <summary>
+	/// Values stored contiguously and found by the handles of a HandlePool. <para/>
+	/// A sparse array indexed by the slot of the handles gives the position of the value in the dense arrays :
+	/// insertion, removal (swap with the last value) and search are O(1), iterations are linear in memory.<para/>
+	/// A handle freed and given again with another generation does not find the value of the old one.
+	/// </summary>
+	/// <typeparam name="T">Type of the values, moved on removals.</typeparam>
+	/// <remarks>The order of the values changes on removals.</remarks>
+	template<typename T>
+	class HandleMap
+	{
+	public:
+		/// <summary>Type of the handles.</summary>
+		using Handle = HandlePool::Handle;
+
+		using iterator = typename std::vector<T>::iterator;
+		using const_iterator = typename std::vector<T>::const_iterator;
+
+	public:
+		/// <summary>Add a value.</summary>
+		/// <param name="_Handle">Handle to find the value with, valid.</param>
+		/// <param name="_Value">Value to add.</param>
+		/// <returns>False if the handle is invalid or its slot is already used, True otherwise.</returns>
+		Bool Insert( Handle _Handle, T _Value )
+		{
+			const Uint32 Slot = HandlePool::GetIndex( _Handle );
+
+			if( _Handle == HandlePool::InvalidHandle || FindPosition( Slot ) != InvalidPosition )
+				return False;
+
+			if( Slot >= m_Positions.size() )
+				m_Positions.resize( Slot + 1, InvalidPosition );
+
+			m_Positions[Slot] = Cast( Uint32, m_Values.size() );
+			m_Values.push_back( std::move( _Value ) );
+			m_Handles.push_back( _Handle );
+
+			return True;
+		}
+
+		/// <summary>Remove a value. The last value takes its place.</summary>
+		/// <param name="_Handle">Handle of the value to remove.</param>
+		/// <returns>False if there is no value for this handle, True otherwise.</returns>
+		Bool Remove( Handle _Handle )
+		{
+			const Uint32 Position = FindHandle( _Handle );
+			if( Position == InvalidPosition )
+				return False;
+
+			const Uint32 Last = Cast( Uint32, m_Values.size() - 1 );
+
+			if( Position != Last )
+			{
+				m_Values[Position] = std::move( m_Values[Last] );
+				m_Handles[Position] = m_Handles[Last];
+				m_Positions[HandlePool::GetIndex( m_Handles[Position] )] = Position;
+			}
+
+			m_Values.pop_back();
+			m_Handles.pop_back();
+			m_Positions[HandlePool::GetIndex( _Handle )] = InvalidPosition;
+
+			return True;
+		}
+
+		/// <summary>Find the value of a handle.</summary>
+		/// <param name="_Handle">Handle of the value.</param>
+		/// <returns>The value, null if there is no value for this handle.</returns>
+		T* Find( Handle _Handle )
+		{
+			const Uint32 Position = FindHandle( _Handle );
+			return Position != InvalidPosition ? &m_Values[Position] : nullptr;
+		}
+
+		/// <summary>Find the value of a handle.</summary>
+		/// <param name="_Handle">Handle of the value.</param>
+		/// <returns>The value, null if there is no value for this handle.</returns>
+		const T* Find( Handle _Handle ) const
+		{
+			const Uint32 Position = FindHandle( _Handle );
+			return Position != InvalidPosition ? &m_Values[Position] : nullptr;
+		}
+
+		/// <summary>Is there a value for a handle ?</summary>
+		/// <param name="_Handle">Handle to look for.</param>
+		/// <returns>True if a value is stored with exactly this handle.</returns>
+		Bool Contains( Handle _Handle ) const
+		{
+			return FindHandle( _Handle ) != InvalidPosition;
+		}
+
+		/// <summary>Remove all the values.</summary>
+		void Clear()
+		{
+			m_Values.clear();
+			m_Handles.clear();
+			m_Positions.clear();
+		}
+
+		/// <summary>Reserve the memory for a count of values.</summary>
+		/// <param name="_Count">Count of values to reserve.</param>
+		void Reserve( Uint32 _Count )
+		{
+			m_Values.reserve( _Count );
+			m_Handles.reserve( _Count );
+		}
+
+		/// <summary>Get the count of values.</summary>
+		/// <returns>Count of values stored.</returns>
+		Uint32 GetCount() const
+		{
+			return Cast( Uint32, m_Values.size() );
+		}
+
+		/// <summary>Is there no value ?</summary>
+		/// <returns>True if the map is empty.</returns>
+		Bool IsEmpty() const
+		{
+			return m_Values.empty();
+		}
+
+		/// <summary>Get the values, contiguous.</summary>
+		/// <returns>The values, in the same order as GetHandles.</returns>
+		const std::vector<T>& GetValues() const
+		{
+			return m_Values;
+		}
+
+		/// <summary>Get the handles of the values.</summary>
+		/// <returns>The handle of each value, in the same order as GetValues.</returns>
+		const std::vector<Handle>& GetHandles() const
+		{
+			return m_Handles;
+		}
+
+		iterator begin() { return m_Values.begin(); }
+		iterator end() { return m_Values.end(); }
+		const_iterator begin() const { return m_Values.cbegin(); }
+		const_iterator end() const { return m_Values.cend(); }
+
+	private:
+		/// <summary>Position of the slots without value.</summary>
+		static constexpr Uint32 InvalidPosition = 0xFFFFFFFF;
+
+		/// <summary>Get the position of the value of a slot, whatever its generation.</summary>
+		Uint32 FindPosition( Uint32 _Slot ) const
+		{
+			return _Slot < m_Positions.size() ? m_Positions[_Slot] : InvalidPosition;
+		}
+
+		/// <summary>Get the position of the value of a handle, checking its generation.</summary>
+		Uint32 FindHandle( Handle _Handle ) const
+		{
+			const Uint32 Position = FindPosition( HandlePool::GetIndex( _Handle ) );
+			return Position != InvalidPosition && m_Handles[Position] == _Handle ? Position : InvalidPosition;
+		}
+
+	private:
+		/// <summary>Position in the dense arrays of the value of each slot.</summary>
+		std::vector<Uint32> m_Positions;
+
+		/// <summary>Values, dense.</summary>
+		std::vector<T> m_Values;
+
+		/// <summary>Handle of each value.</summary>
+		std::vector<Handle> m_Handles;
+	};
+
+	template<typename T>
+	constexpr Uint32 HandleMap<T>::InvalidPosition;
+
+} // ae
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../Types.h"
+#include "../../Debugging/Log/Log.h"
+
+#include <vector>
+#include <deque>
+
+namespace ae
+{
+
+	/// \ingroup toolbox
+	/// <summary>
+	/// Generator of generational handles. <para/>
+	/// A handle packs the index of a slot (low 24 bits) and the generation of the slot (high 8 bits).
+	/// Freeing a handle increments the generation of its slot : the old handle is detected as invalid in O(1)
+	/// instead of aliasing the next object given the same slot.<para/>
+	/// The freed slots are reused in FIFO order, and only when at least MinimumFreeSlots are waiting :
+	/// a slot comes back after many others, its 256 generations cover a long time before a handle can alias.
+	/// </summary>
+	class HandlePool
+	{
+	public:
+		/// <summary>Type of the handles.</summary>
+		using Handle = Uint32;
+
+		/// <summary>Count of bits of the slot index in a handle.</summary>
+		static constexpr Uint32 IndexBits = 24;
+
+		/// <summary>Count of bits of the generation in a handle.</summary>
+		static constexpr Uint32 GenerationBits = 8;
+
+		/// <summary>Mask of the slot index in a handle.</summary>
+		static constexpr Uint32 IndexMask = ( 1u << IndexBits ) - 1;
+
+		/// <summary>Mask of the generation, once shifted.</summary>
+		static constexpr Uint32 GenerationMask = ( 1u << GenerationBits ) - 1;
+
+		/// <summary>Value that represent an invalid handle. Never given to user as usable handle (the slot 0 is never used).</summary>
+		static constexpr Handle InvalidHandle = 0;
+
+		/// <summary>Count of slots available, without the slot of the invalid handle.</summary>
+		static constexpr Uint32 MaxSlotsCount = IndexMask;
+
+		/// <summary>Count of freed slots waiting before one of them is reused.</summary>
+		static constexpr Uint32 MinimumFreeSlots = 1024;
+
+	public:
+		/// <summary>Initialize the generator, without slot allocated.</summary>
+		HandlePool() :
+			m_Generations( 1, 0 ),
+			m_Count( 0 )
+		{
+		}
+
+		/// <summary>Generate a handle.</summary>
+		/// <returns>A new handle or InvalidHandle if the maximum count of slots has been reached.</returns>
+		Handle GenerateHandle()
+		{
+			Uint32 Index = 0;
+
+			if( m_FreeSlots.size() > MinimumFreeSlots )
+			{
+				Index = m_FreeSlots.front();
+				m_FreeSlots.pop_front();
+			}
+			else
+			{
+				if( m_Generations.size() > MaxSlotsCount )
+				{
+					// All the slots are taken, reuse the freed ones even if there are few.
+					if( m_FreeSlots.empty() )
+					{
+						AE_LogError( "No more available handle in the pool." );
+						return InvalidHandle;
+					}
+
+					Index = m_FreeSlots.front();
+					m_FreeSlots.pop_front();
+				}
+				else
+				{
+					Index = Cast( Uint32, m_Generations.size() );
+					m_Generations.push_back( 0 );
+				}
+			}
+
+			m_Count++;
+
+			return MakeHandle( Index, m_Generations[Index] );
+		}
+
+		/// <summary>Free a handle. Its slot will be given again later, with another generation.</summary>
+		/// <param name="_Handle">The handle to free.</param>
+		/// <returns>True if the handle was freed, False if it was not valid.</returns>
+		Bool FreeHandle( Handle _Handle )
+		{
+			if( !IsValid( _Handle ) )
+			{
+				AE_LogError( "Invalid handle to free." );
+				return False;
+			}
+
+			const Uint32 Index = GetIndex( _Handle );
+
+			m_Generations[Index] = Cast( Uint8, ( m_Generations[Index] + 1 ) & GenerationMask );
+			m_FreeSlots.push_back( Index );
+			m_Count--;
+
+			return True;
+		}
+
+		/// <summary>Is a handle given by this pool and not freed since ?</summary>
+		/// <param name="_Handle">The handle to check.</param>
+		/// <returns>True if the handle is alive, False otherwise.</returns>
+		Bool IsValid( Handle _Handle ) const
+		{
+			const Uint32 Index = GetIndex( _Handle );
+
+			return Index != 0 && Index < m_Generations.size() && m_Generations[Index] == GetGeneration( _Handle );
+		}
+
+		/// <summary>Get the count of handles alive.</summary>
+		/// <returns>Count of handles generated and not freed.</returns>
+		Uint32 GetCount() const
+		{
+			return m_Count;
+		}
+
+		/// <summary>Get the count of slots allocated, alive or free, the slot of the invalid handle included.</summary>
+		/// <returns>Size of an array indexed by the slot indices of the handles.</returns>
+		Uint32 GetSlotsCount() const
+		{
+			return Cast( Uint32, m_Generations.size() );
+		}
+
+		/// <summary>Get the slot index of a handle.</summary>
+		/// <param name="_Handle">The handle.</param>
+		/// <returns>Index of the slot, unique among the handles alive.</returns>
+		static Uint32 GetIndex( Handle _Handle )
+		{
+			return _Handle & IndexMask;
+		}
+
+		/// <summary>Get the generation of a handle.</summary>
+		/// <param name="_Handle">The handle.</param>
+		/// <returns>Generation of the slot when the handle was generated.</returns>
+		static Uint8 GetGeneration( Handle _Handle )
+		{
+			return Cast( Uint8, ( _Handle >> IndexBits ) & GenerationMask );
+		}
+
+	private:
+		/// <summary>Pack a slot index and a generation in a handle.</summary>
+		static Handle MakeHandle( Uint32 _Index, Uint8 _Generation )
+		{
+			return ( Cast( Uint32, _Generation ) << IndexBits ) | ( _Index & IndexMask );
+		}
+
+	private:
+		/// <summary>Current generation of each slot. The slot 0 is never used.</summary>
+		std::vector<Uint8> m_Generations;
+
+		/// <summary>Freed slots, oldest first.</summary>
+		std::deque<Uint32> m_FreeSlots;
+
+		/// <summary>Count of handles alive.</summary>
+		Uint32 m_Count;
+	};
+
+} // ae
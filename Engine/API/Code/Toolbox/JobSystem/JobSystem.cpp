@@ -0,0 +1,411 @@
+#include "JobSystem.h"
+
+#include "../../Maths/Functions/MathsFunctions.h"
+
+namespace ae
+{
+	namespace priv
+	{
+		/// <summary>A job waiting to be run.</summary>
+		struct Job
+		{
+			JobSystem::Function Function;
+			JobCounter* Counter;
+		};
+
+		/// <summary>
+		/// Work stealing deque of fixed capacity (Chase and Lev, with the memory orders of Le, Pop, Cohen and Zappa Nardelli).<para/>
+		/// The owner thread pushes and pops at the bottom, the others threads steal at the top.
+		/// </summary>
+		class JobDeque
+		{
+		public:
+			/// <summary>Count of jobs a deque can hold, power of two. The jobs pushed beyond go to the shared queue.</summary>
+			static constexpr Int64 Capacity = 4096;
+
+		public:
+			JobDeque() :
+				m_Top( 0 ),
+				m_Bottom( 0 )
+			{
+				for( std::atomic<Job*>& Slot : m_Jobs )
+					Slot.store( nullptr, std::memory_order_relaxed );
+			}
+
+			/// <summary>Owner only.</summary>
+			/// <returns>False if the deque is full.</returns>
+			Bool Push( Job* _Job )
+			{
+				const Int64 Bottom = m_Bottom.load( std::memory_order_relaxed );
+				const Int64 Top = m_Top.load( std::memory_order_acquire );
+
+				if( Bottom - Top >= Capacity )
+					return False;
+
+				// Published by the release : a thief reading the new bottom sees the job.
+				m_Jobs[Bottom & ( Capacity - 1 )].store( _Job, std::memory_order_relaxed );
+				m_Bottom.store( Bottom + 1, std::memory_order_release );
+
+				return True;
+			}
+
+			/// <summary>Owner only, newest job first.</summary>
+			Job* Pop()
+			{
+				const Int64 Bottom = m_Bottom.load( std::memory_order_relaxed ) - 1;
+				m_Bottom.store( Bottom, std::memory_order_relaxed );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				Int64 Top = m_Top.load( std::memory_order_relaxed );
+
+				if( Top > Bottom )
+				{
+					// Empty.
+					m_Bottom.store( Bottom + 1, std::memory_order_relaxed );
+					return nullptr;
+				}
+
+				Job* Result = m_Jobs[Bottom & ( Capacity - 1 )].load( std::memory_order_relaxed );
+
+				if( Top == Bottom )
+				{
+					// Last job : a thief may take it at the same time, the one moving the top wins.
+					if( !m_Top.compare_exchange_strong( Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+						Result = nullptr;
+
+					m_Bottom.store( Bottom + 1, std::memory_order_relaxed );
+				}
+
+				return Result;
+			}
+
+			/// <summary>Any thread, oldest job first.</summary>
+			Job* Steal()
+			{
+				Int64 Top = m_Top.load( std::memory_order_acquire );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				const Int64 Bottom = m_Bottom.load( std::memory_order_acquire );
+
+				if( Top >= Bottom )
+					return nullptr;
+
+				Job* Result = m_Jobs[Top & ( Capacity - 1 )].load( std::memory_order_relaxed );
+
+				if( !m_Top.compare_exchange_strong( Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+					return nullptr;
+
+				return Result;
+			}
+
+		private:
+			/// <summary>Next job to steal. On its own cache line, written by the thieves.</summary>
+			alignas( 64 ) std::atomic<Int64> m_Top;
+
+			/// <summary>Next free slot. On its own cache line, written by the owner.</summary>
+			alignas( 64 ) std::atomic<Int64> m_Bottom;
+
+			/// <summary>Jobs, the job of an index is at index % Capacity.</summary>
+			std::atomic<Job*> m_Jobs[Capacity];
+		};
+
+	} // priv
+
+	namespace
+	{
+		/// <summary>Job system the deque of the calling thread belongs to.</summary>
+		thread_local const JobSystem* CurrentJobSystem = nullptr;
+
+		/// <summary>Index of the deque of the calling thread in its job system.</summary>
+		thread_local Uint32 CurrentDequeIndex = 0;
+
+		/// <summary>Count of attempts to find a job before a worker goes to sleep.</summary>
+		constexpr Uint32 SpinsBeforeSleep = 64;
+	}
+
+
+	JobCounter::JobCounter() :
+		m_Count( 0 )
+	{
+	}
+
+	Bool JobCounter::IsDone() const
+	{
+		return m_Count.load( std::memory_order_acquire ) == 0;
+	}
+
+	Uint32 JobCounter::GetCount() const
+	{
+		return m_Count.load( std::memory_order_acquire );
+	}
+
+
+	JobSystem::JobSystem( Uint32 _WorkersCount ) :
+		m_MainThreadID( std::this_thread::get_id() ),
+		m_QueuedCount( 0 ),
+		m_SleepingCount( 0 ),
+		m_IsStopping( False )
+	{
+		// Keep a core for the main thread.
+		const Uint32 HardwareThreads = Math::Max( 1u, Cast( Uint32, std::thread::hardware_concurrency() ) );
+		const Uint32 WorkersCount = _WorkersCount == 0 ? Math::Max( 1u, HardwareThreads - 1 ) : _WorkersCount;
+
+		for( Uint32 d = 0; d < WorkersCount + 1; d++ )
+			m_Deques.push_back( std::make_unique<priv::JobDeque>() );
+
+		// A thread has one deque : a second job system built by the same thread uses the shared queue.
+		if( CurrentJobSystem == nullptr )
+		{
+			CurrentJobSystem = this;
+			CurrentDequeIndex = 0;
+		}
+
+		m_Workers.reserve( WorkersCount );
+		for( Uint32 w = 0; w < WorkersCount; w++ )
+			m_Workers.emplace_back( &JobSystem::WorkerLoop, this, w + 1 );
+	}
+
+	JobSystem::~JobSystem()
+	{
+		// The workers run the pending jobs before exiting, they may hold counters waited by others.
+		if( IsMainThread() )
+			ProcessMainThreadJobs();
+
+		{
+			std::lock_guard<std::mutex> Lock( m_SleepMutex );
+			m_IsStopping = True;
+		}
+		m_SleepCondition.notify_all();
+
+		for( std::thread& Worker : m_Workers )
+			Worker.join();
+
+		if( CurrentJobSystem == this )
+			CurrentJobSystem = nullptr;
+	}
+
+	void JobSystem::Run( Function _Job, JobCounter* _Counter )
+	{
+		if( _Counter != nullptr )
+			_Counter->m_Count.fetch_add( 1, std::memory_order_relaxed );
+
+		Push( new priv::Job{ std::move( _Job ), _Counter } );
+	}
+
+	void JobSystem::RunOnMainThread( Function _Job, JobCounter* _Counter )
+	{
+		if( _Counter != nullptr )
+			_Counter->m_Count.fetch_add( 1, std::memory_order_relaxed );
+
+		std::lock_guard<std::mutex> Lock( m_MainThreadMutex );
+		m_MainThreadQueue.push_back( new priv::Job{ std::move( _Job ), _Counter } );
+	}
+
+	void JobSystem::ParallelFor( Uint32 _Begin, Uint32 _End, Uint32 _GrainSize, const RangeFunction& _Function )
+	{
+		if( _Begin >= _End )
+			return;
+
+		const Uint32 GrainSize = Math::Max( 1u, _GrainSize );
+
+		// A single chunk is run directly, without scheduling.
+		if( _End - _Begin <= GrainSize )
+		{
+			_Function( _Begin, _End );
+			return;
+		}
+
+		JobCounter Counter;
+
+		// The first chunk is kept for the calling thread, the others are queued before it starts.
+		for( Uint32 ChunkBegin = _Begin + GrainSize; ChunkBegin < _End; ChunkBegin += Math::Min( GrainSize, _End - ChunkBegin ) )
+		{
+			const Uint32 ChunkEnd = ChunkBegin + Math::Min( GrainSize, _End - ChunkBegin );
+			Run( [&_Function, ChunkBegin, ChunkEnd]() { _Function( ChunkBegin, ChunkEnd ); }, &Counter );
+		}
+
+		_Function( _Begin, _Begin + GrainSize );
+
+		Wait( Counter );
+	}
+
+	void JobSystem::Wait( const JobCounter& _Counter )
+	{
+		const Bool IsMain = IsMainThread();
+
+		while( !_Counter.IsDone() )
+		{
+			priv::Job* NextJob = IsMain ? PopMainThreadJob() : nullptr;
+
+			if( NextJob == nullptr )
+				NextJob = FindJob();
+
+			// The last jobs of the counter are running on other threads.
+			if( NextJob == nullptr )
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			Execute( NextJob );
+		}
+	}
+
+	void JobSystem::ProcessMainThreadJobs()
+	{
+		// Only the jobs queued so far : a job queuing another one must not keep the main thread here.
+		size_t Count = 0;
+		{
+			std::lock_guard<std::mutex> Lock( m_MainThreadMutex );
+			Count = m_MainThreadQueue.size();
+		}
+
+		for( size_t j = 0; j < Count; j++ )
+		{
+			priv::Job* NextJob = PopMainThreadJob();
+
+			if( NextJob == nullptr )
+				return;
+
+			Execute( NextJob );
+		}
+	}
+
+	Uint32 JobSystem::GetWorkersCount() const
+	{
+		return Cast( Uint32, m_Workers.size() );
+	}
+
+	Uint32 JobSystem::GetThreadsCount() const
+	{
+		return GetWorkersCount() + 1;
+	}
+
+	Bool JobSystem::IsMainThread() const
+	{
+		return std::this_thread::get_id() == m_MainThreadID;
+	}
+
+	void JobSystem::WorkerLoop( Uint32 _DequeIndex )
+	{
+		CurrentJobSystem = this;
+		CurrentDequeIndex = _DequeIndex;
+
+		Uint32 Spins = 0;
+
+		while( True )
+		{
+			if( priv::Job* NextJob = FindJob() )
+			{
+				Execute( NextJob );
+				Spins = 0;
+				continue;
+			}
+
+			if( m_IsStopping.load( std::memory_order_acquire ) )
+				break;
+
+			if( ++Spins < SpinsBeforeSleep )
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Counted as sleeping before checking the queued jobs : a job queued meanwhile is seen or wakes this worker.
+			std::unique_lock<std::mutex> Lock( m_SleepMutex );
+			m_SleepingCount.fetch_add( 1 );
+			m_SleepCondition.wait( Lock, [this]() { return m_QueuedCount.load() > 0 || m_IsStopping.load(); } );
+			m_SleepingCount.fetch_sub( 1 );
+
+			Spins = 0;
+		}
+
+		CurrentJobSystem = nullptr;
+	}
+
+	void JobSystem::Push( priv::Job* _Job )
+	{
+		const Uint32 DequeIndex = GetDequeIndex();
+
+		if( DequeIndex == InvalidDeque || !m_Deques[DequeIndex]->Push( _Job ) )
+		{
+			std::lock_guard<std::mutex> Lock( m_SharedMutex );
+			m_SharedQueue.push_back( _Job );
+		}
+
+		m_QueuedCount.fetch_add( 1 );
+
+		if( m_SleepingCount.load() > 0 )
+		{
+			std::lock_guard<std::mutex> Lock( m_SleepMutex );
+			m_SleepCondition.notify_one();
+		}
+	}
+
+	priv::Job* JobSystem::FindJob()
+	{
+		// Fast exit for the idle workers, without touching the others deques.
+		if( m_QueuedCount.load( std::memory_order_relaxed ) == 0 )
+			return nullptr;
+
+		const Uint32 DequeIndex = GetDequeIndex();
+		priv::Job* Result = DequeIndex != InvalidDeque ? m_Deques[DequeIndex]->Pop() : nullptr;
+
+		if( Result == nullptr )
+		{
+			std::lock_guard<std::mutex> Lock( m_SharedMutex );
+
+			if( !m_SharedQueue.empty() )
+			{
+				Result = m_SharedQueue.front();
+				m_SharedQueue.pop_front();
+			}
+		}
+
+		// Steal from the others, starting after the own deque to spread the thieves.
+		const Uint32 DequesCount = Cast( Uint32, m_Deques.size() );
+		const Uint32 FirstVictim = DequeIndex != InvalidDeque ? DequeIndex + 1 : 0;
+
+		for( Uint32 v = 0; v < DequesCount && Result == nullptr; v++ )
+		{
+			const Uint32 Victim = ( FirstVictim + v ) % DequesCount;
+
+			if( Victim != DequeIndex )
+				Result = m_Deques[Victim]->Steal();
+		}
+
+		if( Result != nullptr )
+			m_QueuedCount.fetch_sub( 1, std::memory_order_relaxed );
+
+		return Result;
+	}
+
+	priv::Job* JobSystem::PopMainThreadJob()
+	{
+		std::lock_guard<std::mutex> Lock( m_MainThreadMutex );
+
+		if( m_MainThreadQueue.empty() )
+			return nullptr;
+
+		priv::Job* Result = m_MainThreadQueue.front();
+		m_MainThreadQueue.pop_front();
+
+		return Result;
+	}
+
+	void JobSystem::Execute( priv::Job* _Job )
+	{
+		_Job->Function();
+
+		// Freed before the counter is decremented : the captures of the job may refer to data of the waiting thread.
+		JobCounter* Counter = _Job->Counter;
+		delete _Job;
+
+		if( Counter != nullptr )
+			Counter->m_Count.fetch_sub( 1, std::memory_order_release );
+	}
+
+	Uint32 JobSystem::GetDequeIndex() const
+	{
+		return CurrentJobSystem == this ? CurrentDequeIndex : InvalidDeque;
+	}
+
+} // ae
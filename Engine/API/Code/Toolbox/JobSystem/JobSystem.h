@@ -0,0 +1,184 @@
+#pragma once
+
+#include "../Toolbox.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+
+#include <functional>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace ae
+{
+	namespace priv
+	{
+		struct Job;
+		class JobDeque;
+	}
+
+	/// \ingroup toolbox
+	/// <summary>
+	/// Count of jobs not finished yet.<para/>
+	/// Given to JobSystem::Run to wait for a group of jobs : JobSystem::Wait returns once it reaches zero.
+	/// A job depending on others can be run after them, or wait for their counter itself.
+	/// </summary>
+	class AERO_CORE_EXPORT JobCounter : public NotCopiable
+	{
+		friend class JobSystem;
+
+	public:
+		/// <summary>Build a counter without pending job.</summary>
+		JobCounter();
+
+		/// <summary>Are all the jobs of this counter finished ?</summary>
+		/// <returns>True if no job is pending, False otherwise.</returns>
+		Bool IsDone() const;
+
+		/// <summary>Get the count of jobs not finished yet.</summary>
+		/// <returns>Count of pending jobs.</returns>
+		Uint32 GetCount() const;
+
+	private:
+		/// <summary>Pending jobs. Decremented by the jobs once finished, nothing touches the counter after.</summary>
+		std::atomic<Uint32> m_Count;
+	};
+
+	/// \ingroup toolbox
+	/// <summary>
+	/// Run short CPU jobs on a pool of worker threads, with work stealing.<para/>
+	/// Each worker and the main thread own a deque : they push and pop their jobs at its bottom (last in, first out, hot in cache),
+	/// the idle workers steal the oldest jobs at the top of the others. The jobs submitted by other threads go through a shared queue.<para/>
+	/// The threads waiting for a counter run the pending jobs meanwhile, so jobs can wait for other jobs without blocking a worker.<para/>
+	/// The OpenGL jobs are run on the main thread only, by ProcessMainThreadJobs (called each frame by AeroCore::Update) or while the main thread waits.
+	/// </summary>
+	/// <remarks>
+	/// The jobs must not throw and should not block on I/O : a blocked worker is a lost core for every subsystem.
+	/// The resources loading keeps its own threads for that reason (see AsyncLoader).
+	/// </remarks>
+	class AERO_CORE_EXPORT JobSystem : public NotCopiable
+	{
+	public:
+		/// <summary>Work of a job.</summary>
+		using Function = std::function<void()>;
+
+		/// <summary>Work of a parallel for on the range [_Begin, _End).</summary>
+		using RangeFunction = std::function<void( Uint32 _Begin, Uint32 _End )>;
+
+	public:
+		/// <summary>Start the workers. The calling thread is the main thread of this job system.</summary>
+		/// <param name="_WorkersCount">Count of worker threads, 0 for one per core except the main thread one.</param>
+		explicit JobSystem( Uint32 _WorkersCount = 0 );
+
+		/// <summary>Run the pending jobs then stop the workers.</summary>
+		~JobSystem();
+
+		/// <summary>Run a job on any thread of the system.</summary>
+		/// <param name="_Job">Work to do.</param>
+		/// <param name="_Counter">Counter incremented now and decremented when the job is finished, can be null.</param>
+		void Run( Function _Job, JobCounter* _Counter = nullptr );
+
+		/// <summary>Run a job on the main thread, for the work that needs the OpenGL context.</summary>
+		/// <param name="_Job">Work to do.</param>
+		/// <param name="_Counter">Counter incremented now and decremented when the job is finished, can be null.</param>
+		void RunOnMainThread( Function _Job, JobCounter* _Counter = nullptr );
+
+		/// <summary>
+		/// Split a range into chunks run in parallel and wait for them.<para/>
+		/// The calling thread runs chunks too. The chunks are independent : a chunk must only write its own part of the data.
+		/// </summary>
+		/// <param name="_Begin">First index of the range.</param>
+		/// <param name="_End">Index after the last one.</param>
+		/// <param name="_GrainSize">Count of indices per chunk, large enough to make a job worth its scheduling (a few microseconds of work).</param>
+		/// <param name="_Function">Work on a chunk [_Begin, _End).</param>
+		void ParallelFor( Uint32 _Begin, Uint32 _End, Uint32 _GrainSize, const RangeFunction& _Function );
+
+		/// <summary>Run pending jobs until all the jobs of a counter are finished.</summary>
+		/// <param name="_Counter">Counter to wait for.</param>
+		void Wait( const JobCounter& _Counter );
+
+		/// <summary>Run the main thread jobs submitted so far. Must be called by the main thread.</summary>
+		void ProcessMainThreadJobs();
+
+		/// <summary>Get the count of worker threads.</summary>
+		/// <returns>Count of workers, the main thread excluded.</returns>
+		Uint32 GetWorkersCount() const;
+
+		/// <summary>Get the count of threads running the jobs.</summary>
+		/// <returns>Count of workers and the main thread.</returns>
+		Uint32 GetThreadsCount() const;
+
+		/// <summary>Is the calling thread the main thread of this job system ?</summary>
+		/// <returns>True if called from the thread that built the job system, False otherwise.</returns>
+		Bool IsMainThread() const;
+
+	private:
+		/// <summary>Loop of the workers : run their jobs, steal the others ones, sleep when there is nothing to do.</summary>
+		/// <param name="_DequeIndex">Index of the deque of the worker.</param>
+		void WorkerLoop( Uint32 _DequeIndex );
+
+		/// <summary>Queue a job in the deque of the calling thread, or in the shared queue for the threads without deque.</summary>
+		/// <param name="_Job">Job to queue.</param>
+		void Push( priv::Job* _Job );
+
+		/// <summary>Take a job : from the deque of the calling thread, then from the shared queue, then from the others deques.</summary>
+		/// <returns>The job, null if there is none.</returns>
+		priv::Job* FindJob();
+
+		/// <summary>Take a main thread job.</summary>
+		/// <returns>The job, null if there is none.</returns>
+		priv::Job* PopMainThreadJob();
+
+		/// <summary>Run a job, decrement its counter and free it.</summary>
+		/// <param name="_Job">Job to run.</param>
+		void Execute( priv::Job* _Job );
+
+		/// <summary>Get the index of the deque of the calling thread.</summary>
+		/// <returns>Index of the deque, InvalidDeque if the thread has none.</returns>
+		Uint32 GetDequeIndex() const;
+
+	private:
+		/// <summary>Index of the deque of the threads without one.</summary>
+		static constexpr Uint32 InvalidDeque = 0xFFFFFFFF;
+
+		/// <summary>Deque of the main thread first, then one per worker.</summary>
+		std::vector<std::unique_ptr<priv::JobDeque>> m_Deques;
+
+		/// <summary>Worker threads.</summary>
+		std::vector<std::thread> m_Workers;
+
+		/// <summary>Thread that built the job system.</summary>
+		std::thread::id m_MainThreadID;
+
+		/// <summary>Jobs submitted by the threads without deque, or when a deque is full.</summary>
+		std::deque<priv::Job*> m_SharedQueue;
+
+		/// <summary>Protect the shared queue.</summary>
+		std::mutex m_SharedMutex;
+
+		/// <summary>Jobs to run on the main thread.</summary>
+		std::deque<priv::Job*> m_MainThreadQueue;
+
+		/// <summary>Protect the main thread queue.</summary>
+		std::mutex m_MainThreadMutex;
+
+		/// <summary>Count of jobs queued and not taken yet, the main thread jobs excluded. The workers sleep when it is zero.</summary>
+		std::atomic<Uint32> m_QueuedCount;
+
+		/// <summary>Count of workers sleeping, they are only woken when it is not zero.</summary>
+		std::atomic<Uint32> m_SleepingCount;
+
+		/// <summary>Protect the sleep of the workers.</summary>
+		std::mutex m_SleepMutex;
+
+		/// <summary>Signaled when a job is queued and a worker sleeps, or when the system stops.</summary>
+		std::condition_variable m_SleepCondition;
+
+		/// <summary>Ask the workers to exit.</summary>
+		std::atomic<Bool> m_IsStopping;
+	};
+
+} // ae
@@ -0,0 +1,313 @@
+#include "TransformHierarchy.h"
+
+#include "../../Maths/Transform/Transform.h"
+#include "../../Maths/Matrix/MatrixToolbox.h"
+#include "../../Toolbox/JobSystem/JobSystem.h"
+#include "../../Debugging/Log/Log.h"
+
+#include <algorithm>
+
+namespace ae
+{
+    namespace priv
+    {
+        namespace
+        {
+            /// <summary>Reorder values : the value at _Order[i] goes to i.</summary>
+            template<typename T>
+            void Permute( std::vector<T>& _Values, const std::vector<Uint32>& _Order )
+            {
+                std::vector<T> Sorted;
+                Sorted.reserve( _Values.size() );
+
+                for( Uint32 OldPosition : _Order )
+                    Sorted.push_back( std::move( _Values[OldPosition] ) );
+
+                _Values.swap( Sorted );
+            }
+        }
+
+        constexpr Uint32 TransformHierarchy::InvalidPosition;
+        constexpr Uint32 TransformHierarchy::EntriesPerJob;
+
+        TransformHierarchy::TransformHierarchy() :
+            m_NeedsSort( False ),
+            m_HasDirty( False )
+        {
+        }
+
+        void TransformHierarchy::AddTransform( Handle _ID, Transform* _Transform, Handle _ParentID )
+        {
+            if( _Transform == nullptr || _ID == HandlePool::InvalidHandle )
+            {
+                AE_LogError( "Invalid transform to add to the hierarchy." );
+                return;
+            }
+
+            if( FindPosition( _ID ) != InvalidPosition )
+            {
+                AE_LogError( std::string( "Object with the ID (" ) + std::to_string( _ID ) + ") already has a transform in the hierarchy." );
+                return;
+            }
+
+            const Uint32 Slot = HandlePool::GetIndex( _ID );
+            if( Slot >= m_Positions.size() )
+                m_Positions.resize( Slot + 1, InvalidPosition );
+
+            m_Positions[Slot] = GetCount();
+
+            m_IDs.push_back( _ID );
+            m_ParentIDs.push_back( _ParentID );
+            m_Parents.push_back( InvalidPosition );
+            m_Transforms.push_back( _Transform );
+            m_Dirty.push_back( LocalChanged );
+            m_Versions.push_back( 0 );
+            m_LocalMatrices.push_back( Matrix4x4::Identity );
+            m_WorldMatrices.push_back( Matrix4x4::Identity );
+
+            m_NeedsSort = True;
+            m_HasDirty.store( True, std::memory_order_relaxed );
+        }
+
+        void TransformHierarchy::RemoveTransform( Handle _ID )
+        {
+            const Uint32 Position = FindPosition( _ID );
+            if( Position == InvalidPosition )
+                return;
+
+            const Uint32 Last = GetCount() - 1;
+
+            // Swap with the last entry, the depth order is restored by the next sort.
+            if( Position != Last )
+            {
+                m_IDs[Position] = m_IDs[Last];
+                m_ParentIDs[Position] = m_ParentIDs[Last];
+                m_Transforms[Position] = m_Transforms[Last];
+                m_Dirty[Position] = m_Dirty[Last];
+                m_Versions[Position] = m_Versions[Last];
+                m_LocalMatrices[Position] = m_LocalMatrices[Last];
+                m_WorldMatrices[Position] = m_WorldMatrices[Last];
+
+                m_Positions[HandlePool::GetIndex( m_IDs[Position] )] = Position;
+            }
+
+            m_IDs.pop_back();
+            m_ParentIDs.pop_back();
+            m_Parents.pop_back();
+            m_Transforms.pop_back();
+            m_Dirty.pop_back();
+            m_Versions.pop_back();
+            m_LocalMatrices.pop_back();
+            m_WorldMatrices.pop_back();
+
+            m_Positions[HandlePool::GetIndex( _ID )] = InvalidPosition;
+
+            m_NeedsSort = True;
+        }
+
+        void TransformHierarchy::SetParent( Handle _ID, Handle _ParentID )
+        {
+            const Uint32 Position = FindPosition( _ID );
+            if( Position == InvalidPosition || m_ParentIDs[Position] == _ParentID )
+                return;
+
+            m_ParentIDs[Position] = _ParentID;
+            m_NeedsSort = True;
+        }
+
+        void TransformHierarchy::MarkDirty( Handle _ID )
+        {
+            const Uint32 Position = FindPosition( _ID );
+            if( Position == InvalidPosition )
+                return;
+
+            m_Dirty[Position] |= LocalChanged;
+            m_HasDirty.store( True, std::memory_order_relaxed );
+        }
+
+        void TransformHierarchy::Update( JobSystem& _Jobs )
+        {
+            if( m_NeedsSort )
+                SortByDepth();
+
+            if( !m_HasDirty.exchange( False, std::memory_order_relaxed ) )
+                return;
+
+            // A level only reads the world matrices of the previous ones, its entries are independent.
+            for( Uint32 Level = 0; Level + 1 < Cast( Uint32, m_LevelStarts.size() ); Level++ )
+            {
+                _Jobs.ParallelFor( m_LevelStarts[Level], m_LevelStarts[Level + 1], EntriesPerJob, [this]( Uint32 _Begin, Uint32 _End )
+                {
+                    UpdateRange( _Begin, _End );
+                } );
+            }
+
+            std::fill( m_Dirty.begin(), m_Dirty.end(), Cast( Uint8, Clean ) );
+        }
+
+        const Matrix4x4& TransformHierarchy::GetWorldMatrix( Handle _ID, JobSystem& _Jobs )
+        {
+            // Objects moved since the last update (after World::Update, ...) : the first read of the frame updates them all.
+            if( m_NeedsSort || m_HasDirty.load( std::memory_order_relaxed ) )
+                Update( _Jobs );
+
+            const Uint32 Position = FindPosition( _ID );
+
+            return Position != InvalidPosition ? m_WorldMatrices[Position] : Matrix4x4::Identity;
+        }
+
+        Uint32 TransformHierarchy::GetWorldVersion( Handle _ID, JobSystem& _Jobs )
+        {
+            if( m_NeedsSort || m_HasDirty.load( std::memory_order_relaxed ) )
+                Update( _Jobs );
+
+            const Uint32 Position = FindPosition( _ID );
+
+            return Position != InvalidPosition ? m_Versions[Position] : 0;
+        }
+
+        Uint32 TransformHierarchy::GetCount() const
+        {
+            return Cast( Uint32, m_IDs.size() );
+        }
+
+        Uint32 TransformHierarchy::GetLevelCount() const
+        {
+            return m_LevelStarts.empty() ? 0 : Cast( Uint32, m_LevelStarts.size() - 1 );
+        }
+
+        Uint32 TransformHierarchy::FindPosition( Handle _ID ) const
+        {
+            const Uint32 Slot = HandlePool::GetIndex( _ID );
+            if( Slot >= m_Positions.size() )
+                return InvalidPosition;
+
+            const Uint32 Position = m_Positions[Slot];
+
+            return Position != InvalidPosition && m_IDs[Position] == _ID ? Position : InvalidPosition;
+        }
+
+        void TransformHierarchy::SortByDepth()
+        {
+            const Uint32 Count = GetCount();
+
+            for( Uint32 Entry = 0; Entry < Count; Entry++ )
+                m_Parents[Entry] = FindPosition( m_ParentIDs[Entry] );
+
+            std::vector<Uint32> Depths;
+            ComputeDepths( Depths );
+
+            // Counting sort by depth : one range per level, the parents before their children.
+            const Uint32 LevelCount = Count > 0 ? *std::max_element( Depths.begin(), Depths.end() ) + 1 : 0;
+
+            m_LevelStarts.assign( LevelCount + 1, 0 );
+            for( Uint32 Entry = 0; Entry < Count; Entry++ )
+                m_LevelStarts[Depths[Entry] + 1]++;
+
+            for( Uint32 Level = 1; Level <= LevelCount; Level++ )
+                m_LevelStarts[Level] += m_LevelStarts[Level - 1];
+
+            std::vector<Uint32> Cursors( m_LevelStarts.begin(), m_LevelStarts.end() - 1 );
+            std::vector<Uint32> Order( Count );
+            std::vector<Uint32> NewPositions( Count );
+
+            for( Uint32 Entry = 0; Entry < Count; Entry++ )
+            {
+                const Uint32 NewPosition = Cursors[Depths[Entry]]++;
+
+                Order[NewPosition] = Entry;
+                NewPositions[Entry] = NewPosition;
+            }
+
+            std::vector<Uint32> Parents( Count );
+            for( Uint32 Entry = 0; Entry < Count; Entry++ )
+            {
+                const Uint32 OldParent = m_Parents[Order[Entry]];
+                Parents[Entry] = OldParent != InvalidPosition ? NewPositions[OldParent] : InvalidPosition;
+            }
+            m_Parents.swap( Parents );
+
+            Permute( m_IDs, Order );
+            Permute( m_ParentIDs, Order );
+            Permute( m_Transforms, Order );
+            Permute( m_Versions, Order );
+            Permute( m_LocalMatrices, Order );
+            Permute( m_WorldMatrices, Order );
+
+            for( Uint32 Entry = 0; Entry < Count; Entry++ )
+                m_Positions[HandlePool::GetIndex( m_IDs[Entry] )] = Entry;
+
+            // The parents may have changed : every world matrix is computed again.
+            m_Dirty.assign( Count, LocalChanged );
+            m_HasDirty.store( True, std::memory_order_relaxed );
+
+            m_NeedsSort = False;
+        }
+
+        void TransformHierarchy::ComputeDepths( AE_Out std::vector<Uint32>& _Depths )
+        {
+            const Uint32 Count = GetCount();
+            const Uint32 Visiting = InvalidPosition - 1;
+
+            _Depths.assign( Count, InvalidPosition );
+
+            std::vector<Uint32> Chain;
+
+            for( Uint32 Entry = 0; Entry < Count; Entry++ )
+            {
+                // Go up to a root or to an entry with a known depth.
+                Uint32 Current = Entry;
+                while( Current != InvalidPosition && _Depths[Current] == InvalidPosition )
+                {
+                    _Depths[Current] = Visiting;
+                    Chain.push_back( Current );
+                    Current = m_Parents[Current];
+                }
+
+                // The chain loops on itself : cut it, the last entry becomes a root.
+                if( Current != InvalidPosition && _Depths[Current] == Visiting )
+                {
+                    AE_LogWarning( "Cycle in the objects hierarchy, an object is used as root." );
+                    m_Parents[Chain.back()] = InvalidPosition;
+                    Current = InvalidPosition;
+                }
+
+                Uint32 Depth = Current != InvalidPosition ? _Depths[Current] + 1 : 0;
+
+                for( std::vector<Uint32>::reverse_iterator It = Chain.rbegin(); It != Chain.rend(); ++It )
+                    _Depths[*It] = Depth++;
+
+                Chain.clear();
+            }
+        }
+
+        void TransformHierarchy::UpdateRange( Uint32 _Begin, Uint32 _End )
+        {
+            for( Uint32 Entry = _Begin; Entry < _End; Entry++ )
+            {
+                const Uint32 Parent = m_Parents[Entry];
+
+                Uint8 Flags = m_Dirty[Entry];
+                if( Parent != InvalidPosition && m_Dirty[Parent] != Clean )
+                    Flags |= ParentChanged;
+
+                if( Flags == Clean )
+                    continue;
+
+                if( Flags & LocalChanged )
+                    m_LocalMatrices[Entry] = m_Transforms[Entry]->GetMatrix();
+
+                if( Parent == InvalidPosition )
+                    m_WorldMatrices[Entry] = m_LocalMatrices[Entry];
+                else
+                    MatrixToolbox::Multiply<4, 4, 4>( m_WorldMatrices[Entry].GetData(), m_WorldMatrices[Parent].GetData(), m_LocalMatrices[Entry].GetData() );
+
+                // Kept until the end of the update : the children of the next level read it.
+                m_Dirty[Entry] = Flags;
+                m_Versions[Entry]++;
+            }
+        }
+
+    } // priv
+
+} // ae
@@ -0,0 +1,168 @@
+#ifndef _TRANSFORMHIERARCHY_AERO_H_
+#define _TRANSFORMHIERARCHY_AERO_H_
+
+#include "../../Toolbox/Toolbox.h"
+#include "../../Toolbox/HandlePool/HandlePool.h"
+#include "../../Idioms/NotCopiable/NotCopiable.h"
+#include "../../Maths/Matrix/Matrix4x4.h"
+
+#include <atomic>
+#include <vector>
+
+namespace ae
+{
+    class Transform;
+    class JobSystem;
+
+    namespace priv
+    {
+        /// \ingroup scene
+        /// <summary>
+        /// World matrices of the objects having a transform, combined with the ones of their parents. <para/>
+        /// Local and world matrices are stored in separate arrays sorted by depth in the hierarchy :
+        /// the parents are always before their children and each depth is a contiguous range. <para/>
+        /// A change of a transform only flags it, the flags propagate to the children during the update :
+        /// the world matrices are computed once per frame, level by level, each level split in parallel jobs.
+        /// </summary>
+        /// <remarks>
+        /// An object whose parent has no transform is a root : its world matrix is its local one.
+        /// </remarks>
+        class AERO_CORE_EXPORT TransformHierarchy : public NotCopiable
+        {
+        public:
+            /// <summary>Type of the IDs of the objects.</summary>
+            using Handle = HandlePool::Handle;
+
+        public:
+            /// <summary>Build an empty hierarchy.</summary>
+            TransformHierarchy();
+
+            /// <summary>Add the transform of an object.</summary>
+            /// <param name="_ID">ID of the object.</param>
+            /// <param name="_Transform">Transform of the object, must live until it is removed.</param>
+            /// <param name="_ParentID">ID of the parent of the object, can be invalid.</param>
+            void AddTransform( Handle _ID, Transform* _Transform, Handle _ParentID );
+
+            /// <summary>Remove the transform of an object.</summary>
+            /// <param name="_ID">ID of the object.</param>
+            void RemoveTransform( Handle _ID );
+
+            /// <summary>Change the parent of an object. Ignored if the object has no transform.</summary>
+            /// <param name="_ID">ID of the object.</param>
+            /// <param name="_ParentID">ID of the new parent, invalid to make it a root.</param>
+            void SetParent( Handle _ID, Handle _ParentID );
+
+            /// <summary>
+            /// Flag the local transform of an object as changed. Ignored if the object has no transform. <para/>
+            /// Can be called from jobs, for different objects.
+            /// </summary>
+            /// <param name="_ID">ID of the object.</param>
+            void MarkDirty( Handle _ID );
+
+            /// <summary>Compute the world matrices of the flagged objects and their children. Main thread only.</summary>
+            /// <param name="_Jobs">Job system to split the levels with.</param>
+            void Update( JobSystem& _Jobs );
+
+            /// <summary>Get the world matrix of an object, updating the hierarchy first if something changed. Main thread only.</summary>
+            /// <param name="_ID">ID of the object.</param>
+            /// <param name="_Jobs">Job system to split the update with.</param>
+            /// <returns>World matrix of the object, identity if it has no transform.</returns>
+            const Matrix4x4& GetWorldMatrix( Handle _ID, JobSystem& _Jobs );
+
+            /// <summary>
+            /// Get the version of the world matrix of an object, incremented each time it is recomputed. <para/>
+            /// Lets the objects refresh their caches (bounds, ...) when a parent moved.
+            /// </summary>
+            /// <param name="_ID">ID of the object.</param>
+            /// <param name="_Jobs">Job system to split the update with.</param>
+            /// <returns>Version of the world matrix, 0 if the object has no transform.</returns>
+            Uint32 GetWorldVersion( Handle _ID, JobSystem& _Jobs );
+
+            /// <summary>Get the count of transforms in the hierarchy.</summary>
+            /// <returns>Count of transforms.</returns>
+            Uint32 GetCount() const;
+
+            /// <summary>Get the count of depths in the hierarchy.</summary>
+            /// <returns>Count of levels, 1 if there are only roots.</returns>
+            Uint32 GetLevelCount() const;
+
+        private:
+            /// <summary>Changes of an entry since the last update.</summary>
+            enum DirtyFlags : Uint8
+            {
+                /// <summary>Nothing to compute.</summary>
+                Clean = 0,
+
+                /// <summary>The local matrix must be read again from the transform.</summary>
+                LocalChanged = 1,
+
+                /// <summary>The world matrix of the parent changed.</summary>
+                ParentChanged = 2
+            };
+
+            /// <summary>Position of the entries not in the hierarchy.</summary>
+            static constexpr Uint32 InvalidPosition = 0xFFFFFFFF;
+
+            /// <summary>Count of entries per job, a job must update enough matrices to be worth its scheduling.</summary>
+            static constexpr Uint32 EntriesPerJob = 256;
+
+            /// <summary>Get the position of the entry of an object.</summary>
+            /// <param name="_ID">ID of the object.</param>
+            /// <returns>Position in the arrays, InvalidPosition if the object has no transform.</returns>
+            Uint32 FindPosition( Handle _ID ) const;
+
+            /// <summary>Sort the entries by depth and resolve the positions of the parents. Every entry is flagged.</summary>
+            void SortByDepth();
+
+            /// <summary>Compute the depth of each entry, parents positions must be resolved.</summary>
+            /// <param name="_Depths">Depth of each entry.</param>
+            void ComputeDepths( AE_Out std::vector<Uint32>& _Depths );
+
+            /// <summary>Update the world matrices of a range of entries of the same depth.</summary>
+            /// <param name="_Begin">First entry of the range.</param>
+            /// <param name="_End">Entry after the last one.</param>
+            void UpdateRange( Uint32 _Begin, Uint32 _End );
+
+        private:
+            /// <summary>Position of the entry of each handle slot.</summary>
+            std::vector<Uint32> m_Positions;
+
+            /// <summary>ID of the object of each entry.</summary>
+            std::vector<Handle> m_IDs;
+
+            /// <summary>ID of the parent of each entry.</summary>
+            std::vector<Handle> m_ParentIDs;
+
+            /// <summary>Position of the parent of each entry, InvalidPosition for the roots. Valid after the sort.</summary>
+            std::vector<Uint32> m_Parents;
+
+            /// <summary>Transform of each entry, read only when its local matrix changed.</summary>
+            std::vector<Transform*> m_Transforms;
+
+            /// <summary>DirtyFlags of each entry.</summary>
+            std::vector<Uint8> m_Dirty;
+
+            /// <summary>Version of the world matrix of each entry.</summary>
+            std::vector<Uint32> m_Versions;
+
+            /// <summary>Local matrix of each entry.</summary>
+            std::vector<Matrix4x4> m_LocalMatrices;
+
+            /// <summary>World matrix of each entry.</summary>
+            std::vector<Matrix4x4> m_WorldMatrices;
+
+            /// <summary>First entry of each depth, followed by the count of entries.</summary>
+            std::vector<Uint32> m_LevelStarts;
+
+            /// <summary>Must the entries be sorted again (added, removed or parent changed) ?</summary>
+            Bool m_NeedsSort;
+
+            /// <summary>Is there an entry flagged since the last update ? Set by the jobs of the physics too.</summary>
+            std::atomic<Bool> m_HasDirty;
+        };
+
+    } // priv
+
+} // ae
+
+#endif // _TRANSFORMHIERARCHY_AERO_H_
@@ -4,6 +4,7 @@
 #include "../Graphics/Light/Light.h"
 #include "../Physics/PhysicObject/PhysicObject.h"
 #include "../Debugging/Log/Log.h"
+#include "../Aero/Aero.h"
 #include "../Editor/TypesToEditor/WorldToEditor.h"
 #include "../Editor/TypesToEditor/PhysicsSettingsToEditor.h"
 
@@ -18,33 +19,43 @@ namespace ae
 	{
 	}
 
-    const std::unordered_map<World::ObjectID, Light*>& World::GetLights() const
+    const HandleMap<Light*>& World::GetLights() const
     {
         return m_Lights;
     }
 
-    const std::unordered_map<World::ObjectID, WorldObject*>& World::GetObjects() const
+    LightClusters& World::GetLightClusters()
     {
-        return m_Objects;
+        return m_LightClusters;
+    }
+
+    const LightClusters& World::GetLightClusters() const
+    {
+        return m_LightClusters;
     }
 
-    std::unordered_map<World::ObjectID, WorldObject*>& World::GetObjects()
+    const HandleMap<WorldObject*>& World::GetObjects() const
     {
         return m_Objects;
     }
 
+    const HandleMap<PhysicObject*>& World::GetPhysicObjects() const
+    {
+        return m_PhysicObjects;
+    }
+
     const WorldObject* World::GetObject( ObjectID _ID ) const
     {
-        if( _ID == InvalidObjectID )
+        if( !m_IDPool.IsValid( _ID ) )
         {
-            AE_LogError( "Invalid ID. Function will return nullptr." );
+            AE_LogError( "Invalid ID or destroyed object. Function will return nullptr." );
             return nullptr;
         }
 
-        std::unordered_map<World::ObjectID, WorldObject*>::const_iterator It = m_Objects.find( _ID );
+        WorldObject* const* Found = m_Objects.Find( _ID );
 
-        if( It != m_Objects.cend() )
-            return It->second;
+        if( Found != nullptr )
+            return *Found;
         
         else
         {
@@ -55,16 +66,16 @@ namespace ae
 
     WorldObject* World::GetObject( ObjectID _ID )
     {
-        if( _ID == InvalidObjectID )
+        if( !m_IDPool.IsValid( _ID ) )
         {
-            AE_LogError( "Invalid ID. Function will return nullptr." );
+            AE_LogError( "Invalid ID or destroyed object. Function will return nullptr." );
             return nullptr;
         }
 
-        std::unordered_map<World::ObjectID, WorldObject*>::iterator It = m_Objects.find( _ID );
+        WorldObject** Found = m_Objects.Find( _ID );
 
-        if( It != m_Objects.end() )
-            return It->second;
+        if( Found != nullptr )
+            return *Found;
 
         else
         {
@@ -74,6 +85,23 @@ namespace ae
     }
 
 
+    Bool World::IsObjectValid( ObjectID _ID ) const
+    {
+        return m_IDPool.IsValid( _ID );
+    }
+
+
+    const Matrix4x4& World::GetWorldMatrix( ObjectID _ID )
+    {
+        return m_TransformHierarchy.GetWorldMatrix( _ID, Aero.GetJobSystem() );
+    }
+
+    Uint32 World::GetWorldMatrixVersion( ObjectID _ID )
+    {
+        return m_TransformHierarchy.GetWorldVersion( _ID, Aero.GetJobSystem() );
+    }
+
+
     const PhysicsSettings& World::GetPhysicsSettings() const
     {
         return m_PhysicsSimulator.GetPhysicsSettings();
@@ -93,25 +121,25 @@ namespace ae
 
     void World::Update()
     {
-        for( std::pair<const ObjectID, PhysicObject*>& PhysicObjectItem : m_PhysicObjects )
-        {
-            PhysicObject* PhysicObject = PhysicObjectItem.second;
-            if( PhysicObject == nullptr )
-                continue;
+        // Lights may have moved, the clusters will be rebuilt on the next draw that needs them.
+        m_LightClusters.Invalidate();
 
-            m_PhysicsSimulator.SimulateObject( *PhysicObject );
-        }
+        // Each object only changes itself (OnTransformChanged included), they are simulated in parallel. The collisions are solved between the steps.
+        m_PhysicsSimulator.SimulateObjects( Aero.GetJobSystem() );
+
+        // World matrices of the objects moved by the simulation and their children.
+        m_TransformHierarchy.Update( Aero.GetJobSystem() );
     }
 
 
 	World::ObjectID World::GenerateObjectID()
 	{
-		return m_IDPool.GenerateID();
+		return m_IDPool.GenerateHandle();
 	}
 
 	void World::FreeObjectID( ObjectID _ID )
 	{
-		m_IDPool.FreeID( _ID );
+		m_IDPool.FreeHandle( _ID );
 	}
 
 	World::ObjectID World::AddObjectToWorld( WorldObject* _ObjectToAdd )
@@ -131,15 +159,14 @@ namespace ae
 			return InvalidObjectID;
 		}
 
-		if( m_Objects.find( NewID ) != m_Objects.cend() )
+		// Add the object to the word with this ID.
+		if( !m_Objects.Insert( NewID, _ObjectToAdd ) )
 		{
 			AE_LogError( std::string( "Object with the generated ID (" ) + std::to_string( NewID ) + ") already exists." );
+			FreeObjectID( NewID );
 			return InvalidObjectID;
 		}
 
-		// Add the object to the word with this ID.
-		m_Objects.insert( { NewID , _ObjectToAdd } );
-
 		return NewID;
 	}
 
@@ -153,15 +180,13 @@ namespace ae
 
 		const ObjectID& ToDeleteID = _ObjectToRemove->GetObjectID();
 
-		if( m_Objects.find( ToDeleteID ) == m_Objects.cend() )
+		// Remove the object from the world.
+		if( !m_Objects.Remove( ToDeleteID ) )
 		{
 			AE_LogError( std::string( "Object with the ID (" ) + std::to_string( ToDeleteID ) + ") doesn't exist. Impossible to remove it from the world." );
 			return;
 		}
 
-		// Remove the object from the world.
-		m_Objects.erase( ToDeleteID );
-
 		// Make its ID available again.
 		FreeObjectID( ToDeleteID );
 	}
@@ -175,7 +200,7 @@ namespace ae
             return;
         }
 
-        const Uint16 LightID = _LightToAdd->GetObjectID();
+        const ObjectID LightID = _LightToAdd->GetObjectID();
 
         if( LightID == InvalidObjectID )
         {
@@ -183,7 +208,7 @@ namespace ae
             return;
         }
 
-        m_Lights[LightID] = _LightToAdd;
+        m_Lights.Insert( LightID, _LightToAdd );
     }
 
     void World::RemoveLightFromList( Light* _LightToRemove )
@@ -194,7 +219,7 @@ namespace ae
             return;
         }
 
-        const Uint16 LightID = _LightToRemove->GetObjectID();
+        const ObjectID LightID = _LightToRemove->GetObjectID();
 
         if( LightID == InvalidObjectID )
         {
@@ -202,7 +227,7 @@ namespace ae
             return;
         }
 
-        m_Lights.erase( LightID );
+        m_Lights.Remove( LightID );
     }
 
 
@@ -214,15 +239,16 @@ namespace ae
             return;
         }
 
-        const Uint16 ObjectID = _PhysicObjectToAdd->GetObjectID();
+        const ObjectID PhysicObjectID = _PhysicObjectToAdd->GetObjectID();
 
-        if( ObjectID == InvalidObjectID )
+        if( PhysicObjectID == InvalidObjectID )
         {
             AE_LogError( "Invalid object ID for the physic object to add to the world physic object list." );
             return;
         }
 
-        m_PhysicObjects[ObjectID] = _PhysicObjectToAdd;
+        m_PhysicObjects.Insert( PhysicObjectID, _PhysicObjectToAdd );
+        m_PhysicsSimulator.AddObject( *_PhysicObjectToAdd );
     }
 
     void World::RemoveLightFromList( PhysicObject* _PhysicObjectToRemove )
@@ -233,15 +259,18 @@ namespace ae
             return;
         }
 
-        const Uint16 ObjectID = _PhysicObjectToRemove->GetObjectID();
+        const ObjectID PhysicObjectID = _PhysicObjectToRemove->GetObjectID();
 
-        if( ObjectID == InvalidObjectID )
+        if( PhysicObjectID == InvalidObjectID )
         {
             AE_LogError( "Invalid object ID for the physic object to remove from the world physic object list." );
             return;
         }
 
-        m_PhysicObjects.erase( ObjectID );
+        // Its collider must not be found by the others anymore, its body is free for another object.
+        m_PhysicsSimulator.RemoveObject( *_PhysicObjectToRemove );
+
+        m_PhysicObjects.Remove( PhysicObjectID );
     }
 
 
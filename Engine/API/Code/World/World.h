@@ -5,11 +5,15 @@
 
 #include "../Graphics/Color/Color.h"
 #include "../Physics/Simulator/PhysicsSimulator.h"
-#include "../Toolbox/PoolUniqueID/PoolUniqueID.h"
+#include "../Graphics/Light/LightClusters/LightClusters.h"
+#include "../Toolbox/HandlePool/HandlePool.h"
+#include "../Toolbox/HandleMap/HandleMap.h"
+#include "TransformHierarchy/TransformHierarchy.h"
 
 #include <limits>
 #include <array>
 #include <unordered_map>
+#include <vector>
 
 ////////////////////////////////////////////////////////////
 /// \defgroup scene Scene Management
@@ -39,14 +43,14 @@ namespace ae
 
     public:
 
-        /// <summary>Type used to identify object in the world.</summary>
-        using ObjectID = Uint16;
+        /// <summary>Type used to identify object in the world : generational handle, never equal to the ID of a destroyed object.</summary>
+        using ObjectID = HandlePool::Handle;
 
         /// <summary>Value that represent an invalid object ID.</summary>
-        static constexpr ObjectID InvalidObjectID = PoolUniqueID::InvalidID;
+        static constexpr ObjectID InvalidObjectID = HandlePool::InvalidHandle;
 
         /// <summary>Represents the maximum amount of objects that the world can have at the same time.</summary>
-        static constexpr ObjectID MaxObjectID = PoolUniqueID::MaxID;
+        static constexpr Uint32 MaxObjectID = HandlePool::MaxSlotsCount;
 
 
     public:
@@ -55,16 +59,24 @@ namespace ae
 
 
         /// <summary>Retrieve all the lights that are active in the world.</summary>
-        /// <returns>World's lights.</returns>
-        const std::unordered_map<ObjectID, Light*>& GetLights() const;
+        /// <returns>World's lights, stored contiguously.</returns>
+        const HandleMap<Light*>& GetLights() const;
 
-        /// <summary>Retrieve all the objects in the world.</summary>
-        /// <returns>World's objects.</returns>
-        const std::unordered_map<ObjectID, WorldObject*>& GetObjects() const;
+        /// <summary>Retrieve the clustered light assignment of the world lights.</summary>
+        /// <returns>World's light clusters.</returns>
+        LightClusters& GetLightClusters();
+
+        /// <summary>Retrieve the clustered light assignment of the world lights.</summary>
+        /// <returns>World's light clusters.</returns>
+        const LightClusters& GetLightClusters() const;
 
         /// <summary>Retrieve all the objects in the world.</summary>
-        /// <returns>World's objects.</returns>
-        std::unordered_map<ObjectID, WorldObject*>& GetObjects();
+        /// <returns>World's objects, stored contiguously.</returns>
+        const HandleMap<WorldObject*>& GetObjects() const;
+
+        /// <summary>Retrieve all the physic objects in the world.</summary>
+        /// <returns>World's physic objects, stored contiguously.</returns>
+        const HandleMap<PhysicObject*>& GetPhysicObjects() const;
 
         /// <summary>Get the object with the <paramref name="_ID"/> in the world.</summary>
         /// <param name="_ID">The ID of the object to retrieve from the world.</param>
@@ -76,6 +88,24 @@ namespace ae
         /// <returns>Object in the world with the corresponding ID.</returns>
         WorldObject* GetObject( ObjectID _ID );
 
+        /// <summary>Is an ID the one of an object still in the world ?</summary>
+        /// <param name="_ID">The ID to check.</param>
+        /// <returns>True if the object exists, False if the ID is invalid or its object has been destroyed.</returns>
+        Bool IsObjectValid( ObjectID _ID ) const;
+
+        /// <summary>
+        /// Get the world matrix of an object : its transform combined with the ones of its parents. <para/>
+        /// Computed for all the objects on the first call after a change. Main thread only.
+        /// </summary>
+        /// <param name="_ID">The ID of the object.</param>
+        /// <returns>World matrix of the object, identity if it has no transform.</returns>
+        const Matrix4x4& GetWorldMatrix( ObjectID _ID );
+
+        /// <summary>Get the version of the world matrix of an object, it changes each time the matrix is computed again.</summary>
+        /// <param name="_ID">The ID of the object.</param>
+        /// <returns>Version of the world matrix of the object.</returns>
+        Uint32 GetWorldMatrixVersion( ObjectID _ID );
+
         /// <summary>Retrieve the world physics settings.</summary>
         /// <returns>The world physics settings.</returns>
         const PhysicsSettings& GetPhysicsSettings() const;
@@ -146,19 +176,25 @@ namespace ae
 
     private:
         /// <summary>Object ID generator.</summary>
-        PoolUniqueID m_IDPool;
+        HandlePool m_IDPool;
 
-        /// <summary>World objects.</summary>
-        std::unordered_map<ObjectID, WorldObject*> m_Objects;
+        /// <summary>World objects, by ID.</summary>
+        HandleMap<WorldObject*> m_Objects;
 
-        /// <summary>World lights, for quicker access in render.</summary>
-        std::unordered_map<ObjectID, Light*> m_Lights;
+        /// <summary>World lights, for quicker access in render. Dense : the render iterates them linearly.</summary>
+        HandleMap<Light*> m_Lights;
 
-        /// <summary>World physic objects, for quicker access for simulation.</summary>
-        std::unordered_map<ObjectID, PhysicObject*> m_PhysicObjects;
+        /// <summary>World physic objects, for quicker access to all of them. The simulator stores their state by the slot of their ID.</summary>
+        HandleMap<PhysicObject*> m_PhysicObjects;
+
+        /// <summary>World matrices of the objects having a transform, sorted by depth in the hierarchy.</summary>
+        priv::TransformHierarchy m_TransformHierarchy;
 
         /// <summary>Physics simulator to update physic objects.</summary>
         priv::PhysicsSimulator m_PhysicsSimulator;
+
+        /// <summary>Lights binned by view clusters, rebuilt once per frame when a shader needs them.</summary>
+        LightClusters m_LightClusters;
     };
 
 } //ae
@@ -29,6 +29,7 @@ namespace ae
     {
         World& WorldRef = Aero.GetWorld();
 
+        WorldRef.m_TransformHierarchy.RemoveTransform( m_ObjectID );
         WorldRef.RemoveObjectFromWorld( this );
     }
 
@@ -128,6 +129,28 @@ namespace ae
         return !m_Children.empty();
     }
 
+    const Matrix4x4& WorldObject::GetWorldMatrix() const
+    {
+        return Aero.GetWorld().GetWorldMatrix( m_ObjectID );
+    }
+
+    Uint32 WorldObject::GetWorldMatrixVersion() const
+    {
+        return Aero.GetWorld().GetWorldMatrixVersion( m_ObjectID );
+    }
+
+    void WorldObject::AttachTransform( Transform& _Transform )
+    {
+        const World::ObjectID ParentID = m_Parent != nullptr ? m_Parent->GetObjectID() : World::InvalidObjectID;
+
+        Aero.GetWorld().m_TransformHierarchy.AddTransform( m_ObjectID, &_Transform, ParentID );
+    }
+
+    void WorldObject::MarkTransformDirty()
+    {
+        Aero.GetWorld().m_TransformHierarchy.MarkDirty( m_ObjectID );
+    }
+
    
     void WorldObject::MakeRelation( WorldObject* _Parent, WorldObject* _Child )
     {
@@ -167,6 +190,10 @@ namespace ae
             _Child->m_Parent = _Parent;
             _Parent->m_Children.push_back( _Child );
         }
+
+        // The world matrices of the child and of its children now depend on the new parent.
+        const World::ObjectID ParentID = _Parent != nullptr ? _Parent->GetObjectID() : World::InvalidObjectID;
+        Aero.GetWorld().m_TransformHierarchy.SetParent( _Child->GetObjectID(), ParentID );
     }
 
 
@@ -8,6 +8,8 @@
 
 namespace ae
 {
+    class Transform;
+
     /// \ingroup scene
     /// <summary>
     /// Class that represent an object in the world. <para/>
@@ -102,6 +104,14 @@ namespace ae
         /// <returns>True if the object has at least one child, False otherwise.</returns>
         Bool HasChildren() const;
 
+        /// <summary>Retrieve the transform of the object combined with the ones of its parents.</summary>
+        /// <returns>World matrix of the object, identity if it has no transform.</returns>
+        const Matrix4x4& GetWorldMatrix() const;
+
+        /// <summary>Retrieve the version of the world matrix, it changes each time the matrix is computed again.</summary>
+        /// <returns>Version of the world matrix of the object.</returns>
+        Uint32 GetWorldMatrixVersion() const;
+
         /// <summary>
         /// Function called by the editor.
         /// It allows the class to expose some attributes for user editing.
@@ -109,6 +119,14 @@ namespace ae
         /// </summary>
         virtual void ToEditor();
 
+    protected:
+        /// <summary>Add the transform of the object to the world hierarchy, to have a world matrix. Removed on destruction.</summary>
+        /// <param name="_Transform">Transform of the object, usually the object itself.</param>
+        void AttachTransform( Transform& _Transform );
+
+        /// <summary>Flag the world matrix of the object and of its children to be computed again. To call on each change of the transform.</summary>
+        void MarkTransformDirty();
+
     private:
 
         /// <summary>
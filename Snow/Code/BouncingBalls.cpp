@@ -0,0 +1,186 @@
+#include "BouncingBalls.h"
+
+#include <API/Code/Aero/Aero.h>
+#include <API/Code/Maths/Functions/MathsFunctions.h>
+#include <API/Code/UI/Dependencies/IncludeImGui.h>
+
+#include <cmath>
+
+constexpr float BouncingBalls::BallRadius;
+constexpr float BouncingBalls::GroundHeight;
+
+BouncingBalls::Ball::Ball() :
+	Object( 1.0f ),
+	Collider( BallRadius )
+{
+	Collider.SetRestitution( 0.6f );
+	Object.SetCollider( &Collider );
+}
+
+BouncingBalls::BouncingBalls() :
+	m_BallMesh( BallRadius, 12, 12 ),
+	m_BallsMesh( m_BallMesh ),
+	m_GroundCollider( ae::Vector3( 10.0f, 0.5f, 10.0f ) ),
+	m_FenceMesh( 0, 0 ),
+	m_BallsCount( 10000 ),
+	m_IsEnabled( False )
+{
+	m_Material.SetName( "Bouncing Balls Mat" );
+	m_Material.GetRoughness().SetValue( 1.0f );
+	m_Material.GetApplyGammaCorrection().SetValue( False );
+	m_Material.GetAmbientOcclusion().SetValue( 1.0f );
+	m_Material.GetAmbientStrength().SetValue( 0.015f );
+
+	m_BallMesh.SetName( "Bouncing Ball" );
+
+	m_BallsMesh.SetName( "Bouncing Balls" );
+	m_BallsMesh.SetMaterial( m_Material );
+	m_BallsMesh.SetBlendMode( ae::BlendMode::BlendNone );
+
+	// Larger than the snow plane : the balls spread around the fences.
+	m_Ground.SetName( "Bouncing Balls Ground" );
+	m_Ground.SetApplyPhysics( False );
+	m_Ground.SetPosition( 0.0f, GroundHeight - 0.5f, 0.0f );
+
+	m_Fences[0].SetPosition( 0.0f, 0.2f, -0.8f );
+	m_Fences[1].SetPosition( -0.8f, 0.2f, 0.0f );
+	m_Fences[1].SetRotation( 0.0f, ae::Math::PiDivBy2(), 0.0f );
+
+	for( ae::PhysicObject& Fence : m_Fences )
+	{
+		Fence.SetName( "Bouncing Balls Fence" );
+		Fence.SetApplyPhysics( False );
+		Fence.SetScale( 0.4f, 0.4f, 0.4f );
+	}
+
+	m_FenceMesh.SetName( "Bouncing Balls Fence Mesh" );
+	m_FenceMesh.LoadFromFileAsync( "../../../Data/Projects/Snow/Fence/Fence.ply", False, [this]( ae::Mesh3D& _Mesh )
+	{
+		for( ae::MeshCollider& FenceCollider : m_FenceColliders )
+			FenceCollider.SetTriangles( _Mesh );
+	} );
+}
+
+void BouncingBalls::Update()
+{
+	if( !m_IsEnabled )
+		return;
+
+	for( Uint32 b = 0; b < m_Balls.size(); b++ )
+	{
+		ae::PhysicObject& Object = m_Balls[b]->Object;
+
+		// Fallen from the ground : thrown again to keep the same count of balls bouncing.
+		if( Object.GetPosition().Y < GroundHeight - 2.0f )
+			Throw( b );
+
+		m_BallsMesh.SetInstance( b, Object.GetMatrix() );
+	}
+
+	m_BallsMesh.ApplyChanges();
+}
+
+void BouncingBalls::Render( ae::Renderer& _Renderer )
+{
+	if( m_IsEnabled && !m_Balls.empty() )
+		_Renderer.Draw( m_BallsMesh );
+}
+
+Bool BouncingBalls::IsEnabled() const
+{
+	return m_IsEnabled;
+}
+
+void BouncingBalls::SetEnabled( Bool _Enabled )
+{
+	if( _Enabled == m_IsEnabled )
+		return;
+
+	m_IsEnabled = _Enabled;
+
+	// Without balls, the static colliders would stay in the broadphase for nothing.
+	m_Ground.SetCollider( m_IsEnabled ? &m_GroundCollider : nullptr );
+
+	for( Uint32 f = 0; f < 2; f++ )
+		m_Fences[f].SetCollider( m_IsEnabled ? &m_FenceColliders[f] : nullptr );
+
+	CreateBalls();
+}
+
+void BouncingBalls::SetBallsCount( Uint32 _Count )
+{
+	m_BallsCount = _Count;
+	CreateBalls();
+}
+
+Uint32 BouncingBalls::GetBallsCount() const
+{
+	return m_BallsCount;
+}
+
+void BouncingBalls::ToEditor()
+{
+	ImGui::Text( "Bouncing Balls" );
+
+	bool IsEnabled = m_IsEnabled;
+	if( ImGui::Checkbox( "Bouncing Balls", &IsEnabled ) )
+		SetEnabled( IsEnabled );
+
+	// Applied once typed : each change creates all the balls again.
+	int BallsCount = Cast( int, m_BallsCount );
+	if( ImGui::InputInt( "Balls Count", &BallsCount, 1000, 10000, ImGuiInputTextFlags_EnterReturnsTrue ) )
+		SetBallsCount( Cast( Uint32, ae::Math::Clamp( 1, 100000, BallsCount ) ) );
+
+	if( !m_IsEnabled )
+		return;
+
+	Uint32 SleepingCount = 0;
+	for( const std::unique_ptr<Ball>& CurrentBall : m_Balls )
+	{
+		if( CurrentBall->Object.IsSleeping() )
+			SleepingCount++;
+	}
+
+	ImGui::Text( "Frame : %.2f ms, %u sleeping balls", Aero.GetDeltaTime() * 1000.0f, SleepingCount );
+}
+
+void BouncingBalls::CreateBalls()
+{
+	m_BallsMesh.ClearInstances();
+	m_Balls.clear();
+
+	if( !m_IsEnabled )
+		return;
+
+	m_Balls.reserve( m_BallsCount );
+
+	for( Uint32 b = 0; b < m_BallsCount; b++ )
+	{
+		m_Balls.push_back( std::make_unique<Ball>() );
+		Throw( b );
+
+		m_BallsMesh.AddInstance( m_Balls[b]->Object.GetMatrix() );
+	}
+
+	m_BallsMesh.ApplyChanges();
+}
+
+void BouncingBalls::Throw( Uint32 _Index )
+{
+	// Layers of balls above the ground, spaced enough to start without overlapping.
+	const float Spacing = 2.5f * BallRadius;
+	const Uint32 PerRow = ae::Math::Min( Cast( Uint32, std::ceil( std::sqrt( Cast( float, m_BallsCount ) ) ) ), Cast( Uint32, 60 ) );
+	const Uint32 PerLayer = PerRow * PerRow;
+
+	const Uint32 Layer = _Index / PerLayer;
+	const Uint32 Row = ( _Index % PerLayer ) / PerRow;
+	const Uint32 Column = _Index % PerRow;
+	const float Offset = Cast( float, PerRow - 1 ) * 0.5f;
+
+	ae::PhysicObject& Object = m_Balls[_Index]->Object;
+	Object.SetPosition( ( Cast( float, Column ) - Offset ) * Spacing, GroundHeight + 1.0f + Cast( float, Layer ) * Spacing, ( Cast( float, Row ) - Offset ) * Spacing );
+
+	// Different directions for each ball, the same ones at each run.
+	const float Angle = Cast( float, _Index ) * 2.39996f;
+	Object.SetVelocity( ae::Vector3( std::cos( Angle ), 0.0f, std::sin( Angle ) ) );
+}
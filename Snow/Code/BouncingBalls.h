@@ -0,0 +1,111 @@
+#pragma once
+
+#include <API/Code/Graphics/Material/CookTorranceMaterial.h>
+#include <API/Code/Graphics/Mesh/3D/SphereMesh.h>
+#include <API/Code/Graphics/Mesh/3D/Mesh3D.h>
+#include <API/Code/Graphics/Mesh/3D/InstancedMesh.h>
+
+#include <API/Code/Graphics/Renderer/Renderer.h>
+
+#include <API/Code/Physics/PhysicObject/PhysicObject.h>
+#include <API/Code/Physics/Collider/SphereCollider.h>
+#include <API/Code/Physics/Collider/BoxCollider.h>
+#include <API/Code/Physics/Collider/MeshCollider.h>
+
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// Benchmark of the collisions : many balls like the one of the scene bouncing on the ground and against the fences.<para/>
+/// The balls are simulated by the world and drawn in one instanced draw call. They do not deform the snow.
+/// The ground is a static box, the fences static mesh colliders built from the fence model at the same places as in the scene.
+/// </summary>
+class BouncingBalls
+{
+public:
+	/// <summary>Create the ground and load the fences, without ball.</summary>
+	BouncingBalls();
+
+	/// <summary>Place the balls falling out of the ground back above it and update the instances to draw.</summary>
+	void Update();
+
+	/// <summary>Draw the balls.</summary>
+	/// <param name="_Renderer">The rendering target.</param>
+	void Render( ae::Renderer& _Renderer );
+
+	/// <summary>Is the benchmark running ?</summary>
+	/// <returns>True if the balls are simulated, False otherwise.</returns>
+	Bool IsEnabled() const;
+
+	/// <summary>Start or stop the benchmark. The balls are created or destroyed, the ground and the fences collide only while it runs.</summary>
+	/// <param name="_Enabled">True to simulate the balls.</param>
+	void SetEnabled( Bool _Enabled );
+
+	/// <summary>Set the count of balls, they are all thrown again.</summary>
+	/// <param name="_Count">Count of balls.</param>
+	void SetBallsCount( Uint32 _Count );
+
+	/// <summary>Retrieve the count of balls.</summary>
+	/// <returns>Count of balls, simulated while the benchmark runs.</returns>
+	Uint32 GetBallsCount() const;
+
+	/// <summary>Expose properties to the editor panel.</summary>
+	void ToEditor();
+
+private:
+	/// <summary>Physic object of a ball and its collider.</summary>
+	struct Ball
+	{
+		Ball();
+
+		ae::PhysicObject Object;
+		ae::SphereCollider Collider;
+	};
+
+	/// <summary>Create the balls or destroy them according to the state of the benchmark.</summary>
+	void CreateBalls();
+
+	/// <summary>Throw a ball from above the ground, each one from its own place.</summary>
+	/// <param name="_Index">Index of the ball.</param>
+	void Throw( Uint32 _Index );
+
+private:
+	/// <summary>Radius of the balls, the one of the scene ball.</summary>
+	static constexpr float BallRadius = 0.1f;
+
+	/// <summary>Height of the ground surface.</summary>
+	static constexpr float GroundHeight = 0.2f;
+
+	/// <summary>Material of the balls.</summary>
+	ae::CookTorranceMaterial m_Material;
+
+	/// <summary>Mesh of one ball.</summary>
+	ae::SphereMesh m_BallMesh;
+
+	/// <summary>All the balls drawn in one draw call.</summary>
+	ae::InstancedMesh m_BallsMesh;
+
+	/// <summary>Balls simulated.</summary>
+	std::vector<std::unique_ptr<Ball>> m_Balls;
+
+	/// <summary>Static ground.</summary>
+	ae::PhysicObject m_Ground;
+
+	/// <summary>Box of the ground, its top is at the ground height.</summary>
+	ae::BoxCollider m_GroundCollider;
+
+	/// <summary>Fence model, only used to build the colliders.</summary>
+	ae::Mesh3D m_FenceMesh;
+
+	/// <summary>Static fences, at the places of the scene ones.</summary>
+	ae::PhysicObject m_Fences[2];
+
+	/// <summary>Triangles of the fences.</summary>
+	ae::MeshCollider m_FenceColliders[2];
+
+	/// <summary>Count of balls.</summary>
+	Uint32 m_BallsCount;
+
+	/// <summary>Are the balls simulated ?</summary>
+	Bool m_IsEnabled;
+};
@@ -0,0 +1,260 @@
+#include "CDLODGround.h"
+#include "SnowPlane.h"
+#include "SnowParametersBuffer.h"
+
+#include <API/Code/Graphics/Camera/Camera.h>
+#include <API/Code/Graphics/Material/Material.h>
+#include <API/Code/Graphics/Shader/ShaderParameter/ShaderParameterFloat.h>
+#include <API/Code/Graphics/Shader/ShaderParameter/ShaderParameterVector3.h>
+#include <API/Code/Maths/Functions/MathsFunctions.h>
+#include <API/Code/UI/Dependencies/IncludeImGui.h>
+
+CDLODGround::CDLODGround( SnowPlane& _Ground ) :
+	m_Ground( _Ground ),
+	m_ChunkGrid( 1.0f, 1, 1 ),
+	m_Chunks( m_ChunkGrid ),
+	m_Shader( "../../../Data/Projects/Snow/CDLODVertex.glsl", "../../../Data/Projects/Snow/SnowFragment.glsl" ),
+	m_GridResolutionParameter( nullptr ),
+	m_LeafSizeParameter( nullptr ),
+	m_LodBaseDistanceParameter( nullptr ),
+	m_MorphStartRatioParameter( nullptr ),
+	m_GroundSizeParameter( nullptr ),
+	m_GroundPositionParameter( nullptr ),
+	m_IsEnabled( True ),
+	m_IsCullingEnabled( True ),
+	m_TessellationTrianglesCount( 0 )
+{
+	m_ChunkGrid.SetName( "Ground Chunk Grid" );
+	m_Chunks.SetName( "Ground Chunks" );
+	m_Shader.SetName( "Ground CDLOD Shader" );
+
+	// The chunk shader rebuilds everything from the grid position : 12 bytes per vertex instead of 48.
+	m_ChunkGrid.SetVertexFormat( ae::Drawable::AttributePointer::Position );
+	m_Chunks.SetMesh( m_ChunkGrid );
+
+	// The chunks are an instanced drawable : the renderer picks the instanced shader of the snow material.
+	ae::Material& SnowMat = m_Ground.GetMaterial();
+	SnowMat.SetInstancedShader( &m_Shader );
+
+	m_GridResolutionParameter = SnowMat.AddFloatParameterToMaterial( "CDLODGridResolution", "CDLODGridResolution", 1.0f );
+	m_LeafSizeParameter = SnowMat.AddFloatParameterToMaterial( "CDLODLeafSize", "CDLODLeafSize", 1.0f );
+	m_LodBaseDistanceParameter = SnowMat.AddFloatParameterToMaterial( "CDLODLodBaseDistance", "CDLODLodBaseDistance", 1.0f );
+	m_MorphStartRatioParameter = SnowMat.AddFloatParameterToMaterial( "CDLODMorphStartRatio", "CDLODMorphStartRatio", 0.0f, 0.0f, 1.0f );
+	m_GroundSizeParameter = SnowMat.AddFloatParameterToMaterial( "CDLODGroundSize", "CDLODGroundSize", 1.0f );
+	m_GroundPositionParameter = SnowMat.AddVector3ParameterToMaterial( "CDLODGroundPosition", "CDLODGroundPosition", m_Ground.GetPosition() );
+
+	// Driven by the quadtree settings.
+	m_GridResolutionParameter->SetEditable( False );
+	m_LeafSizeParameter->SetEditable( False );
+	m_LodBaseDistanceParameter->SetEditable( False );
+	m_MorphStartRatioParameter->SetEditable( False );
+	m_GroundSizeParameter->SetEditable( False );
+	m_GroundPositionParameter->SetEditable( False );
+
+	m_Chunks.SetMaterial( SnowMat );
+	m_Chunks.SetBlendMode( ae::BlendMode::BlendNone );
+
+	// Already culled by the quadtree, and the chunks are placed and raised in the vertex shader.
+	m_Chunks.SetCullingEnabled( False );
+
+	CDLODQuadtree::Settings Settings;
+	Settings.Size = m_Ground.GetSize();
+	Settings.LevelsCount = 6;
+	Settings.GridResolution = 32;
+	Settings.LodBaseDistance = 0.4f;
+
+	ApplySettings( Settings );
+}
+
+void CDLODGround::Update( ae::Camera& _Camera, const SnowParametersBuffer& _Parameters )
+{
+	const ae::Vector3& GroundPosition = m_Ground.GetPosition();
+
+	// The height map is in [CameraNear, CameraFar] of the camera below the ground.
+	CDLODQuadtree::Settings Settings = m_Quadtree.GetSettings();
+	if( Settings.Size != m_Ground.GetSize() || Settings.MinHeight != _Parameters.GetCameraNear() || Settings.MaxHeight != _Parameters.GetCameraFar() )
+	{
+		Settings.Size = m_Ground.GetSize();
+		Settings.MinHeight = _Parameters.GetCameraNear();
+		Settings.MaxHeight = _Parameters.GetCameraFar();
+
+		ApplySettings( Settings );
+	}
+
+	// Compare with the triangles the tessellation would generate for the same camera.
+	m_TessellationTrianglesCount = CountTessellationTriangles( _Camera.GetPosition(), _Parameters );
+
+	if( !m_IsEnabled )
+		return;
+
+	// Select in the ground space, the vertex shader moves the chunks to the ground position.
+	const ae::Matrix4x4 ViewProjection = _Camera.GetProjectionMatrix() * _Camera.GetLookAtMatrix() * ae::Matrix4x4::GetTranslationMatrix( GroundPosition );
+	const ae::Frustum Frustum( ViewProjection );
+
+	m_Quadtree.Select( _Camera.GetPosition() - GroundPosition, Frustum, m_SelectedChunks, m_IsCullingEnabled );
+
+	m_GroundPositionParameter->SetValue( GroundPosition );
+	m_Chunks.ClearInstances();
+
+	for( const CDLODQuadtree::Chunk& Chunk : m_SelectedChunks )
+	{
+		ae::Matrix4x4 ChunkTransform = ae::Matrix4x4::GetScaleMatrix( ae::Vector3( Chunk.Size, 1.0f, Chunk.Size ) );
+		ChunkTransform.SetTranslation( ae::Vector3( Chunk.X, 0.0f, Chunk.Z ) );
+
+		m_Chunks.AddInstance( ChunkTransform );
+	}
+
+	m_Chunks.ApplyChanges();
+}
+
+const ae::Drawable& CDLODGround::GetDrawable() const
+{
+	if( m_IsEnabled )
+		return m_Chunks;
+
+	return m_Ground;
+}
+
+Bool CDLODGround::IsEnabled() const
+{
+	return m_IsEnabled;
+}
+
+void CDLODGround::SetEnabled( Bool _Enabled )
+{
+	m_IsEnabled = _Enabled;
+}
+
+const CDLODQuadtree& CDLODGround::GetQuadtree() const
+{
+	return m_Quadtree;
+}
+
+Uint64 CDLODGround::GetTrianglesCount() const
+{
+	return m_IsEnabled ? m_Quadtree.GetTrianglesCount( m_SelectedChunks ) : 0;
+}
+
+Uint64 CDLODGround::GetTessellationTrianglesCount() const
+{
+	return m_TessellationTrianglesCount;
+}
+
+void CDLODGround::ToEditor()
+{
+	ImGui::Text( "Ground LOD" );
+
+	bool IsEnabled = m_IsEnabled;
+	if( ImGui::Checkbox( "CDLOD Ground", &IsEnabled ) )
+		m_IsEnabled = IsEnabled;
+
+	bool IsCullingEnabled = m_IsCullingEnabled;
+	if( ImGui::Checkbox( "Frustum Culling", &IsCullingEnabled ) )
+		m_IsCullingEnabled = IsCullingEnabled;
+
+	CDLODQuadtree::Settings Settings = m_Quadtree.GetSettings();
+	Bool HasChanged = False;
+
+	int LevelsCount = Cast( int, Settings.LevelsCount );
+	if( ImGui::SliderInt( "LOD Levels", &LevelsCount, 1, 10 ) )
+	{
+		Settings.LevelsCount = Cast( Uint32, LevelsCount );
+		HasChanged = True;
+	}
+
+	int GridResolution = Cast( int, Settings.GridResolution );
+	if( ImGui::SliderInt( "Chunk Grid Resolution", &GridResolution, 2, 128 ) )
+	{
+		Settings.GridResolution = Cast( Uint32, GridResolution );
+		HasChanged = True;
+	}
+
+	if( ImGui::DragFloat( "LOD Base Distance", &Settings.LodBaseDistance, 0.01f, 0.0f, 10.0f ) )
+		HasChanged = True;
+
+	if( ImGui::DragFloat( "Morph Start Ratio", &Settings.MorphStartRatio, 0.01f, 0.0f, 0.95f ) )
+		HasChanged = True;
+
+	if( HasChanged )
+		ApplySettings( Settings );
+
+	const Uint64 TrianglesCount = GetTrianglesCount();
+	const Uint64 TessellationTrianglesCount = GetTessellationTrianglesCount();
+
+	ImGui::Text( "Chunks : %u", Cast( Uint32, m_SelectedChunks.size() ) );
+	ImGui::Text( "Triangles : CDLOD %llu / Tessellation %llu", Cast( unsigned long long, TrianglesCount ), Cast( unsigned long long, TessellationTrianglesCount ) );
+
+	if( m_IsEnabled && TessellationTrianglesCount > 0 )
+		ImGui::Text( "Ratio : %.1f %%", 100.0 * Cast( double, TrianglesCount ) / Cast( double, TessellationTrianglesCount ) );
+
+	ImGui::Separator();
+}
+
+void CDLODGround::ApplySettings( const CDLODQuadtree::Settings& _Settings )
+{
+	m_Quadtree.SetSettings( _Settings );
+
+	const CDLODQuadtree::Settings& Settings = m_Quadtree.GetSettings();
+
+	if( m_ChunkGrid.GetSubdivisionWidth() != Settings.GridResolution )
+	{
+		m_ChunkGrid.SetSubdivisionWidth( Settings.GridResolution );
+		m_ChunkGrid.SetSubdivisionHeight( Settings.GridResolution );
+
+		// Link again the buffers of the new grid.
+		m_Chunks.SetMesh( m_ChunkGrid );
+	}
+
+	m_GridResolutionParameter->SetValue( Cast( float, Settings.GridResolution ) );
+	m_LeafSizeParameter->SetValue( m_Quadtree.GetChunkSize( 0 ) );
+	m_LodBaseDistanceParameter->SetValue( Settings.LodBaseDistance );
+	m_MorphStartRatioParameter->SetValue( Settings.MorphStartRatio );
+	m_GroundSizeParameter->SetValue( Settings.Size );
+}
+
+Uint64 CDLODGround::CountTessellationTriangles( const ae::Vector3& _CameraPosition, const SnowParametersBuffer& _Parameters ) const
+{
+	const Uint32 SubdivisionWidth = m_Ground.GetSubdivisionWidth();
+	const Uint32 SubdivisionHeight = m_Ground.GetSubdivisionHeight();
+	const float HalfSize = m_Ground.GetSize() * 0.5f;
+	const ae::Vector3& GroundPosition = m_Ground.GetPosition();
+
+	const float DistanceMin = _Parameters.GetTessCameraDistanceMin();
+	const float DistanceRange = ae::Math::Max( _Parameters.GetTessCameraDistanceMax() - DistanceMin, ae::Math::Epsilon() );
+
+	// Level of each vertex of the plane, as computed in SnowControl.glsl.
+	std::vector<float> Levels( ( SubdivisionWidth + 1 ) * ( SubdivisionHeight + 1 ) );
+
+	for( Uint32 h = 0; h <= SubdivisionHeight; h++ )
+	{
+		for( Uint32 w = 0; w <= SubdivisionWidth; w++ )
+		{
+			const float X = -HalfSize + 2.0f * HalfSize * Cast( float, w ) / Cast( float, SubdivisionWidth );
+			const float Z = -HalfSize + 2.0f * HalfSize * Cast( float, h ) / Cast( float, SubdivisionHeight );
+
+			const float Distance = ( GroundPosition + ae::Vector3( X, 0.0f, Z ) - _CameraPosition ).Length();
+			const float Ratio = ae::Math::Clamp01( ( Distance - DistanceMin ) / DistanceRange );
+
+			Levels[h * ( SubdivisionWidth + 1 ) + w] = ae::Math::Lerp( _Parameters.GetTessMax(), _Parameters.GetTessMin(), Ratio );
+		}
+	}
+
+	// Each control shader invocation writes the levels of the patch, take the mean of the 3 vertices.
+	Uint64 Count = 0;
+
+	for( Uint32 h = 0; h < SubdivisionHeight; h++ )
+	{
+		for( Uint32 w = 0; w < SubdivisionWidth; w++ )
+		{
+			const float A = Levels[h * ( SubdivisionWidth + 1 ) + w];
+			const float B = Levels[h * ( SubdivisionWidth + 1 ) + w + 1];
+			const float C = Levels[( h + 1 ) * ( SubdivisionWidth + 1 ) + w + 1];
+			const float D = Levels[( h + 1 ) * ( SubdivisionWidth + 1 ) + w];
+
+			Count += CDLODQuadtree::GetTessellatedTrianglesCount( ( A + C + B ) / 3.0f );
+			Count += CDLODQuadtree::GetTessellatedTrianglesCount( ( A + D + C ) / 3.0f );
+		}
+	}
+
+	return Count;
+}
\ No newline at end of file
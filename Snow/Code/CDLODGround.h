@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CDLODQuadtree.h"
+
+#include <API/Code/Graphics/Mesh/3D/PlaneMesh.h>
+#include <API/Code/Graphics/Mesh/3D/InstancedMesh.h>
+#include <API/Code/Graphics/Shader/Shader.h>
+
+class SnowPlane;
+class SnowParametersBuffer;
+
+namespace ae
+{
+	class Camera;
+	class ShaderParameterFloat;
+	class ShaderParameterVector3;
+}
+
+/// <summary>
+/// Snow surface drawn with a CDLOD quadtree instead of the tessellation of the whole plane.<para/>
+/// The chunks are selected and culled on the CPU each frame, then drawn in one instanced draw call of the same grid.
+/// The vertex shader places the grid, morphs it between the levels and offsets it with the height map.
+/// Share the material of the snow plane, only the vertex stage differs.
+/// </summary>
+class CDLODGround
+{
+public:
+	/// <summary>Create the chunk grid and add the CDLOD shader to the material of <paramref name="_Ground"/>.</summary>
+	/// <param name="_Ground">The snow plane to draw with the quadtree.</param>
+	CDLODGround( SnowPlane& _Ground );
+
+	/// <summary>Select the chunks to draw from the camera and count the triangles of both paths.</summary>
+	/// <param name="_Camera">The camera used to draw the ground.</param>
+	/// <param name="_Parameters">The snow parameters with the tessellation settings and the height range.</param>
+	void Update( ae::Camera& _Camera, const SnowParametersBuffer& _Parameters );
+
+	/// <summary>Retrieve the object to draw for the ground : the chunks or the tessellated plane.</summary>
+	/// <returns>The object to draw.</returns>
+	const ae::Drawable& GetDrawable() const;
+
+	/// <summary>Is the ground drawn with the quadtree ?</summary>
+	/// <returns>True if the chunks are drawn, False if it is the tessellated plane.</returns>
+	Bool IsEnabled() const;
+
+	/// <summary>Draw the ground with the quadtree or with the tessellated plane.</summary>
+	/// <param name="_Enabled">True to draw the chunks, False to draw the tessellated plane.</param>
+	void SetEnabled( Bool _Enabled );
+
+	/// <summary>Retrieve the quadtree selecting the chunks.</summary>
+	/// <returns>The quadtree.</returns>
+	const CDLODQuadtree& GetQuadtree() const;
+
+	/// <summary>Get the count of triangles of the selected chunks.</summary>
+	/// <returns>Count of triangles drawn by the quadtree.</returns>
+	Uint64 GetTrianglesCount() const;
+
+	/// <summary>Get the count of triangles generated by the tessellation of the plane for the same camera.</summary>
+	/// <returns>Count of triangles drawn by the tessellation.</returns>
+	Uint64 GetTessellationTrianglesCount() const;
+
+	/// <summary>Expose properties to the editor panel.</summary>
+	void ToEditor();
+
+private:
+	/// <summary>Apply new quadtree settings to the chunk grid and the material.</summary>
+	/// <param name="_Settings">The new settings.</param>
+	void ApplySettings( const CDLODQuadtree::Settings& _Settings );
+
+	/// <summary>Count the triangles the tessellation shaders generate for the plane, with the same levels as SnowControl.glsl.</summary>
+	/// <param name="_CameraPosition">Position of the camera in world space.</param>
+	/// <param name="_Parameters">The snow parameters with the tessellation settings.</param>
+	/// <returns>Count of triangles generated.</returns>
+	Uint64 CountTessellationTriangles( const ae::Vector3& _CameraPosition, const SnowParametersBuffer& _Parameters ) const;
+
+private:
+	/// <summary>The snow plane, drawn when the quadtree is disabled.</summary>
+	SnowPlane& m_Ground;
+
+	/// <summary>Selection of the chunks.</summary>
+	CDLODQuadtree m_Quadtree;
+
+	/// <summary>Chunks selected for the current frame.</summary>
+	CDLODQuadtree::ChunkArray m_SelectedChunks;
+
+	/// <summary>Grid drawn for each chunk, unit size centered on the origin.</summary>
+	ae::PlaneMesh m_ChunkGrid;
+
+	/// <summary>Chunks drawn with instancing, the transform of each instance places and scales the grid.</summary>
+	ae::InstancedMesh m_Chunks;
+
+	/// <summary>Shader of the chunks : CDLOD vertex shader with the snow fragment shader.</summary>
+	ae::Shader m_Shader;
+
+	/// <summary>Count of quads of the chunk grid in each axis.</summary>
+	ae::ShaderParameterFloat* m_GridResolutionParameter;
+
+	/// <summary>Size of the chunks of the finest level.</summary>
+	ae::ShaderParameterFloat* m_LeafSizeParameter;
+
+	/// <summary>Distance to the camera of the end of the finest level.</summary>
+	ae::ShaderParameterFloat* m_LodBaseDistanceParameter;
+
+	/// <summary>Ratio in the range of a level where the vertices start to morph.</summary>
+	ae::ShaderParameterFloat* m_MorphStartRatioParameter;
+
+	/// <summary>Size of the ground, to compute the height map coordinates.</summary>
+	ae::ShaderParameterFloat* m_GroundSizeParameter;
+
+	/// <summary>Position of the ground, the chunks are placed in the ground space.</summary>
+	ae::ShaderParameterVector3* m_GroundPositionParameter;
+
+	/// <summary>Draw the ground with the quadtree ?</summary>
+	Bool m_IsEnabled;
+
+	/// <summary>Reject the chunks out of the camera frustum ?</summary>
+	Bool m_IsCullingEnabled;
+
+	/// <summary>Count of triangles generated by the tessellation for the last update.</summary>
+	Uint64 m_TessellationTrianglesCount;
+};
\ No newline at end of file
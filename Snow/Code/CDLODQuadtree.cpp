@@ -0,0 +1,111 @@
+#include "CDLODQuadtree.h"
+
+#include <API/Code/Maths/Functions/MathsFunctions.h>
+
+CDLODQuadtree::CDLODQuadtree()
+{
+	SetSettings( Settings() );
+}
+
+void CDLODQuadtree::SetSettings( const Settings& _Settings )
+{
+	m_Settings = _Settings;
+
+	m_Settings.Size = ae::Math::Max( m_Settings.Size, ae::Math::Epsilon() );
+	m_Settings.LevelsCount = ae::Math::Clamp( 1u, 16u, m_Settings.LevelsCount );
+
+	// The morph moves the odd vertices onto the even ones, the grid needs an even count of quads.
+	m_Settings.GridResolution = ae::Math::Max( 2u, m_Settings.GridResolution + ( m_Settings.GridResolution & 1u ) );
+
+	// A level must cover at least twice its chunks, otherwise the morph area is wider than a chunk and cracks appear.
+	m_Settings.LodBaseDistance = ae::Math::Max( m_Settings.LodBaseDistance, GetChunkSize( 0 ) * 2.0f );
+	m_Settings.MorphStartRatio = ae::Math::Clamp( 0.0f, 0.95f, m_Settings.MorphStartRatio );
+	m_Settings.MaxHeight = ae::Math::Max( m_Settings.MaxHeight, m_Settings.MinHeight );
+}
+
+const CDLODQuadtree::Settings& CDLODQuadtree::GetSettings() const
+{
+	return m_Settings;
+}
+
+float CDLODQuadtree::GetChunkSize( Uint32 _Level ) const
+{
+	const Uint32 Depth = m_Settings.LevelsCount - 1 - ae::Math::Min( _Level, m_Settings.LevelsCount - 1 );
+
+	return m_Settings.Size / Cast( float, 1u << Depth );
+}
+
+float CDLODQuadtree::GetLodRange( Uint32 _Level ) const
+{
+	return m_Settings.LodBaseDistance * Cast( float, 1u << _Level );
+}
+
+void CDLODQuadtree::Select( const ae::Vector3& _CameraPosition, const ae::Frustum& _Frustum, AE_Out ChunkArray& _Chunks, Bool _Cull ) const
+{
+	_Chunks.clear();
+
+	SelectNode( 0.0f, 0.0f, m_Settings.LevelsCount - 1, _CameraPosition, _Frustum, _Chunks, _Cull );
+}
+
+Uint64 CDLODQuadtree::GetTrianglesCount( const ChunkArray& _Chunks ) const
+{
+	const Uint64 TrianglesPerChunk = 2ull * m_Settings.GridResolution * m_Settings.GridResolution;
+
+	return TrianglesPerChunk * _Chunks.size();
+}
+
+Uint64 CDLODQuadtree::GetTessellatedTrianglesCount( float _TessLevel )
+{
+	// Equal spacing rounds the level up to the next integer.
+	Int32 Level = Cast( Int32, ae::Math::Ceil( ae::Math::Clamp( 1.0f, 64.0f, _TessLevel ) ) );
+
+	// The triangle is tessellated as concentric rings, each one having 2 less subdivisions per edge than the previous one.
+	Uint64 Count = 0;
+
+	while( Level > 0 )
+	{
+		if( Level == 1 )
+			return Count + 1;
+
+		const Int32 InnerLevel = Level - 2;
+
+		Count += 3ull * Cast( Uint64, Level + InnerLevel );
+		Level = InnerLevel;
+	}
+
+	return Count;
+}
+
+void CDLODQuadtree::SelectNode( float _X, float _Z, Uint32 _Level, const ae::Vector3& _CameraPosition, const ae::Frustum& _Frustum, AE_Out ChunkArray& _Chunks, Bool _Cull ) const
+{
+	const float Size = GetChunkSize( _Level );
+	const float HalfSize = Size * 0.5f;
+
+	const ae::AABB Bounds( ae::Vector3( _X - HalfSize, m_Settings.MinHeight, _Z - HalfSize ), ae::Vector3( _X + HalfSize, m_Settings.MaxHeight, _Z + HalfSize ) );
+
+	if( _Cull && !_Frustum.Intersects( Bounds ) )
+		return;
+
+	// Far enough from the camera to not need the finer level : draw the whole node.
+	if( _Level == 0 || !IntersectsSphere( Bounds, _CameraPosition, GetLodRange( _Level - 1 ) ) )
+	{
+		_Chunks.push_back( { _X, _Z, Size, _Level } );
+		return;
+	}
+
+	const float QuarterSize = HalfSize * 0.5f;
+
+	SelectNode( _X - QuarterSize, _Z - QuarterSize, _Level - 1, _CameraPosition, _Frustum, _Chunks, _Cull );
+	SelectNode( _X + QuarterSize, _Z - QuarterSize, _Level - 1, _CameraPosition, _Frustum, _Chunks, _Cull );
+	SelectNode( _X - QuarterSize, _Z + QuarterSize, _Level - 1, _CameraPosition, _Frustum, _Chunks, _Cull );
+	SelectNode( _X + QuarterSize, _Z + QuarterSize, _Level - 1, _CameraPosition, _Frustum, _Chunks, _Cull );
+}
+
+Bool CDLODQuadtree::IntersectsSphere( const ae::AABB& _Box, const ae::Vector3& _Center, float _Radius )
+{
+	const ae::Vector3& Min = _Box.GetMin();
+	const ae::Vector3& Max = _Box.GetMax();
+	const ae::Vector3 Closest( ae::Math::Clamp( Min.X, Max.X, _Center.X ), ae::Math::Clamp( Min.Y, Max.Y, _Center.Y ), ae::Math::Clamp( Min.Z, Max.Z, _Center.Z ) );
+
+	return ( Closest - _Center ).LengthSqr() <= _Radius * _Radius;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <API/Code/Maths/Vector/Vector3.h>
+#include <API/Code/Maths/Matrix/Matrix4x4.h>
+#include <API/Code/Maths/Primitives/AABB.h>
+#include <API/Code/Maths/Primitives/Frustum.h>
+
+#include <vector>
+
+/// <summary>
+/// Continuous distance-dependent level of detail (CDLOD) quadtree of the ground.<para/>
+/// Select each frame the chunks to draw from the camera position : the closer to the camera, the smaller the chunks.
+/// All the chunks are drawn with the same grid, the vertices are morphed to the grid of the next level in the vertex shader
+/// when getting closer to the end of the range of their level to avoid cracks and popping.<para/>
+/// Only maths, no OpenGL : the selection can run without context or window.<para/>
+/// https://github.com/fstrugar/CDLOD
+/// </summary>
+class CDLODQuadtree
+{
+public:
+	/// <summary>Settings of the quadtree.</summary>
+	struct Settings
+	{
+		/// <summary>Size of the ground (root node) in the X and Z axes.</summary>
+		float Size = 2.0f;
+
+		/// <summary>Count of levels of detail, the root is the level LevelsCount - 1 and the leaves the level 0.</summary>
+		Uint32 LevelsCount = 5;
+
+		/// <summary>Count of quads of the chunk grid in each axis.</summary>
+		Uint32 GridResolution = 16;
+
+		/// <summary>Distance to the camera of the end of the finest level, doubled for each level.</summary>
+		float LodBaseDistance = 0.3f;
+
+		/// <summary>Ratio in the range of a level where the vertices start to morph to the next level.</summary>
+		float MorphStartRatio = 0.7f;
+
+		/// <summary>Minimum height of the ground, bounds of the nodes.</summary>
+		float MinHeight = 0.0f;
+
+		/// <summary>Maximum height of the ground, bounds of the nodes.</summary>
+		float MaxHeight = 1.0f;
+	};
+
+	/// <summary>Part of the ground to draw with the chunk grid.</summary>
+	struct Chunk
+	{
+		/// <summary>Center of the chunk in the X axis.</summary>
+		float X;
+
+		/// <summary>Center of the chunk in the Z axis.</summary>
+		float Z;
+
+		/// <summary>Size of the chunk in the X and Z axes.</summary>
+		float Size;
+
+		/// <summary>Level of detail of the chunk, 0 for the finest.</summary>
+		Uint32 Level;
+	};
+
+	/// <summary>Alias for array of chunks for better readability.</summary>
+	using ChunkArray = std::vector<Chunk>;
+
+public:
+	/// <summary>Create a quadtree with default settings.</summary>
+	CDLODQuadtree();
+
+	/// <summary>Change the settings of the quadtree. Invalid values are clamped.</summary>
+	/// <param name="_Settings">The new settings.</param>
+	void SetSettings( const Settings& _Settings );
+
+	/// <summary>Retrieve the settings of the quadtree.</summary>
+	/// <returns>The settings of the quadtree.</returns>
+	const Settings& GetSettings() const;
+
+	/// <summary>Get the size of the chunks of a level.</summary>
+	/// <param name="_Level">The level, 0 for the finest.</param>
+	/// <returns>Size of the chunks of the level.</returns>
+	float GetChunkSize( Uint32 _Level ) const;
+
+	/// <summary>Get the distance to the camera where a level ends.</summary>
+	/// <param name="_Level">The level, 0 for the finest.</param>
+	/// <returns>Distance where the level ends.</returns>
+	float GetLodRange( Uint32 _Level ) const;
+
+	/// <summary>
+	/// Select the chunks to draw. Each part of the ground inside the frustum is covered by exactly one chunk.
+	/// </summary>
+	/// <param name="_CameraPosition">Position of the camera in the ground space.</param>
+	/// <param name="_Frustum">Frustum of the camera in the ground space.</param>
+	/// <param name="_Chunks">The selected chunks, cleared first.</param>
+	/// <param name="_Cull">Reject the nodes out of the frustum ?</param>
+	void Select( const ae::Vector3& _CameraPosition, const ae::Frustum& _Frustum, AE_Out ChunkArray& _Chunks, Bool _Cull = True ) const;
+
+	/// <summary>Get the count of triangles drawn for some chunks.</summary>
+	/// <param name="_Chunks">The chunks to draw.</param>
+	/// <returns>Count of triangles.</returns>
+	Uint64 GetTrianglesCount( const ChunkArray& _Chunks ) const;
+
+	/// <summary>
+	/// Get the count of triangles generated by the tessellation of a triangle patch
+	/// with the same inner and outer levels and equal spacing.
+	/// </summary>
+	/// <param name="_TessLevel">Tessellation level.</param>
+	/// <returns>Count of triangles generated.</returns>
+	static Uint64 GetTessellatedTrianglesCount( float _TessLevel );
+
+private:
+	/// <summary>Select the chunks of a node and its children.</summary>
+	/// <param name="_X">Center of the node in the X axis.</param>
+	/// <param name="_Z">Center of the node in the Z axis.</param>
+	/// <param name="_Level">Level of the node.</param>
+	/// <param name="_CameraPosition">Position of the camera in the ground space.</param>
+	/// <param name="_Frustum">Frustum of the camera in the ground space.</param>
+	/// <param name="_Chunks">The selected chunks.</param>
+	/// <param name="_Cull">Reject the nodes out of the frustum ?</param>
+	void SelectNode( float _X, float _Z, Uint32 _Level, const ae::Vector3& _CameraPosition, const ae::Frustum& _Frustum, AE_Out ChunkArray& _Chunks, Bool _Cull ) const;
+
+	/// <summary>Does a node bounding box intersect a sphere ?</summary>
+	/// <param name="_Box">Bounding box of the node.</param>
+	/// <param name="_Center">Center of the sphere.</param>
+	/// <param name="_Radius">Radius of the sphere.</param>
+	/// <returns>True if the box intersects the sphere.</returns>
+	static Bool IntersectsSphere( const ae::AABB& _Box, const ae::Vector3& _Center, float _Radius );
+
+private:
+	/// <summary>Settings of the quadtree.</summary>
+	Settings m_Settings;
+};
\ No newline at end of file
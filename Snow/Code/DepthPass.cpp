@@ -6,6 +6,7 @@
 DepthPass::DepthPass( Uint32 _TextureSize, const SnowPlane& _Ground ) :
 	m_FBO( _TextureSize, _TextureSize, ae::Framebuffer::AttachementPreset::Depth_Float ),
 	m_Shader( "../../../Data/Projects/Snow/DepthVertex.glsl", "../../../Data/Projects/Snow/DepthFragment.glsl" ),
+	m_InstancedShader( "../../../Data/Projects/Snow/DepthInstancedVertex.glsl", "../../../Data/Projects/Snow/DepthFragment.glsl" ),
 	m_Material( m_Shader )
 {
 	m_Camera.SetName( "Below Camera" );
@@ -14,17 +15,28 @@ DepthPass::DepthPass( Uint32 _TextureSize, const SnowPlane& _Ground ) :
 	m_Camera.SetFar( 1.0f );
 	UpdateCamera( _Ground );
 
+	m_FBO.SetPassName( "Depth Pass" );
 	m_FBO.GetAttachementTexture( ae::FramebufferAttachement::Type::Depth )->SetName( "Depth Texture" );
 	m_Shader.SetName( "Depth Shader" );
+	m_InstancedShader.SetName( "Depth Instanced Shader" );
 	m_Material.SetName( "Depth Material" );
 	m_Material.SetNeedLights( False );
+	m_Material.SetInstancedShader( &m_InstancedShader );
 }
 
 void DepthPass::Run( Scene& _Scene )
 {
+	// The far distance of the camera is the maximum height of the snow, it can be edited between two updates of the camera.
+	ae::Vector3 VolumeMax = m_SnowVolume.GetMax();
+	VolumeMax.Y = m_SnowVolume.GetMin().Y + m_Camera.GetFar();
+	m_SnowVolume.SetMax( VolumeMax );
+
 	m_FBO.Bind();
 	m_FBO.Clear();
-	_Scene.RenderDepthPass( m_FBO, m_Material, m_Camera );
+	// Half a texel of the depth texture : a coarser footprint would move the deformation to other texels.
+	const float MaxError = 0.5f * ( m_SnowVolume.GetMax().X - m_SnowVolume.GetMin().X ) / Cast( float, m_FBO.GetWidth() );
+
+	_Scene.RenderDepthPass( m_FBO, m_Material, m_Camera, m_SnowVolume, MaxError );
 	m_FBO.Unbind();
 }
 
@@ -49,6 +61,10 @@ void DepthPass::UpdateCamera( const SnowPlane& _Ground )
 
 	m_Camera.SetViewport( ae::FloatRect( -HalfSize, HalfSize, HalfSize, -HalfSize ) );
 	m_Camera.SetPosition( _Ground.GetPosition() );
+
+	const ae::Vector3& GroundPosition = _Ground.GetPosition();
+	m_SnowVolume.SetMin( ae::Vector3( GroundPosition.X - HalfSize, GroundPosition.Y, GroundPosition.Z - HalfSize ) );
+	m_SnowVolume.SetMax( ae::Vector3( GroundPosition.X + HalfSize, GroundPosition.Y + m_Camera.GetFar(), GroundPosition.Z + HalfSize ) );
 }
 
 void DepthPass::Resize( Uint32 _TextureSize )
@@ -5,6 +5,7 @@
 #include <API/Code/Graphics/Material/Material.h>
 #include <API/Code/Graphics/Shader/Shader.h>
 #include <API/Code/Graphics/Texture/Texture.h>
+#include <API/Code/Maths/Primitives/AABB.h>
 
 class Scene;
 class SnowPlane;
@@ -55,6 +56,12 @@ private:
 	/// <summary>Shader for the depth pass.</summary>
 	ae::Shader m_Shader;
 
+	/// <summary>Shader for the depth pass of instanced objects.</summary>
+	ae::Shader m_InstancedShader;
+
 	/// <summary>Material for the depth pass (simpler than default objects material).</summary>
 	ae::Material m_Material;
+
+	/// <summary>Volume where the objects can deform the snow : footprint of the ground, up to the maximum snow height.</summary>
+	ae::AABB m_SnowVolume;
 };
\ No newline at end of file
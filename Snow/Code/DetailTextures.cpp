@@ -0,0 +1,494 @@
+#include "DetailTextures.h"
+#include "SnowParametersBuffer.h"
+
+#include <API/Code/Graphics/Image/Image.h>
+#include <API/Code/Graphics/Shader/ShaderParameter/ShaderParameterFloat.h>
+#include <API/Code/Graphics/Dependencies/OpenGL.h>
+#include <API/Code/Debugging/Debugging.h>
+#include <API/Code/Maths/Functions/MathsFunctions.h>
+#include <API/Code/TimeManagement/Time/Time.h>
+#include <API/Code/Aero/Aero.h>
+
+#include <API/Code/UI/Dependencies/IncludeImGui.h>
+
+#ifdef WINDOWS
+#include <direct.h>
+#elif defined( LINUX )
+#include <sys/stat.h>
+#endif
+
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	/// <summary>Size of the baked textures.</summary>
+	constexpr Uint32 TextureSize = 512;
+
+	/// <summary>Maximum count of noise cells in a tile, a cell must cover a few texels.</summary>
+	constexpr Uint32 MaxCells = TextureSize / 4;
+
+	/// <summary>Count of glitter noise cells in a tile.</summary>
+	constexpr Uint32 GlitterCells = 128;
+
+	/// <summary>Count of octaves of the chunk and grain noises, as in the analytic noise.</summary>
+	constexpr Uint32 OctavesCount = 4;
+
+	/// <summary>Directory of the cached textures.</summary>
+	constexpr const char* CacheDirectory = "SnowCache";
+
+	/// <summary>"SNDT" read as a little endian integer.</summary>
+	constexpr Uint32 CacheMagic = 0x54444E53;
+
+	/// <summary>Version of the cache files, increase it when the bake or the file layout changes.</summary>
+	constexpr Uint32 CacheVersion = 1;
+
+	/// <summary>Layout of the beginning of a cache file.</summary>
+	struct CacheHeader
+	{
+		Uint32 Magic;
+		Uint32 Version;
+		Uint32 Size;
+		Uint32 ChunkCells;
+		Uint32 GrainCells;
+		Uint32 GlitterCells;
+		Uint32 Seed;
+	};
+
+	/// <summary>Hash of a noise cell, wrapped to make the noise tile.</summary>
+	/// <param name="_X">Cell X coordinate.</param>
+	/// <param name="_Y">Cell Y coordinate.</param>
+	/// <param name="_Period">Count of cells before the noise repeats.</param>
+	/// <param name="_Seed">Seed of the noise.</param>
+	/// <returns>The hash of the cell.</returns>
+	Uint32 HashCell( Int32 _X, Int32 _Y, Uint32 _Period, Uint32 _Seed )
+	{
+		const Int32 Period = Cast( Int32, _Period );
+		const Uint32 X = Cast( Uint32, ( ( _X % Period ) + Period ) % Period );
+		const Uint32 Y = Cast( Uint32, ( ( _Y % Period ) + Period ) % Period );
+
+		Uint32 Hash = _Seed ^ ( X * 0x8DA6B343u ) ^ ( Y * 0xD8163841u );
+		Hash ^= Hash >> 16;
+		Hash *= 0x7FEB352Du;
+		Hash ^= Hash >> 15;
+		Hash *= 0x846CA68Bu;
+		Hash ^= Hash >> 16;
+
+		return Hash;
+	}
+
+	/// <summary>Dot product between the gradient of a cell and the offset to the cell corner.</summary>
+	/// <param name="_Hash">Hash of the cell, selecting the gradient.</param>
+	/// <param name="_X">X offset from the corner.</param>
+	/// <param name="_Y">Y offset from the corner.</param>
+	/// <returns>The dot product.</returns>
+	float GradientDot( Uint32 _Hash, float _X, float _Y )
+	{
+		static const float Gradients[8][2] =
+		{
+			{ 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+			{ 0.7071f, 0.7071f }, { -0.7071f, 0.7071f }, { 0.7071f, -0.7071f }, { -0.7071f, -0.7071f }
+		};
+
+		const float* Gradient = Gradients[_Hash & 7u];
+		return Gradient[0] * _X + Gradient[1] * _Y;
+	}
+
+	/// <summary>Quintic interpolation curve of the gradient noise.</summary>
+	/// <param name="_T">Value between 0 and 1.</param>
+	/// <returns>The smoothed value.</returns>
+	float Fade( float _T )
+	{
+		return _T * _T * _T * ( _T * ( _T * 6.0f - 15.0f ) + 10.0f );
+	}
+
+	/// <summary>Gradient noise repeating every <paramref name="_Period"/> cells.</summary>
+	/// <param name="_X">X coordinate in cells.</param>
+	/// <param name="_Y">Y coordinate in cells.</param>
+	/// <param name="_Period">Count of cells before the noise repeats.</param>
+	/// <param name="_Seed">Seed of the noise.</param>
+	/// <returns>Noise value, about between -1 and 1.</returns>
+	float TilingNoise( float _X, float _Y, Uint32 _Period, Uint32 _Seed )
+	{
+		const float FloorX = std::floor( _X );
+		const float FloorY = std::floor( _Y );
+
+		const Int32 CellX = Cast( Int32, FloorX );
+		const Int32 CellY = Cast( Int32, FloorY );
+
+		const float X = _X - FloorX;
+		const float Y = _Y - FloorY;
+
+		const float Corner00 = GradientDot( HashCell( CellX, CellY, _Period, _Seed ), X, Y );
+		const float Corner10 = GradientDot( HashCell( CellX + 1, CellY, _Period, _Seed ), X - 1.0f, Y );
+		const float Corner01 = GradientDot( HashCell( CellX, CellY + 1, _Period, _Seed ), X, Y - 1.0f );
+		const float Corner11 = GradientDot( HashCell( CellX + 1, CellY + 1, _Period, _Seed ), X - 1.0f, Y - 1.0f );
+
+		const float U = Fade( X );
+		const float V = Fade( Y );
+
+		const float Bottom = Corner00 + ( Corner10 - Corner00 ) * U;
+		const float Top = Corner01 + ( Corner11 - Corner01 ) * U;
+
+		return ( Bottom + ( Top - Bottom ) * V ) * 1.4142f;
+	}
+
+	/// <summary>Fractal sum of tiling noises, each octave doubling the frequency and the period.</summary>
+	/// <param name="_X">X coordinate in cells.</param>
+	/// <param name="_Y">Y coordinate in cells.</param>
+	/// <param name="_Period">Count of cells of the first octave before the noise repeats.</param>
+	/// <param name="_Seed">Seed of the noise.</param>
+	/// <returns>Noise value, about between -1 and 1.</returns>
+	float TilingFractalNoise( float _X, float _Y, Uint32 _Period, Uint32 _Seed )
+	{
+		float Result = 0.0f;
+		float Amplitude = 0.5f;
+		float Frequency = 1.0f;
+
+		for( Uint32 o = 0; o < OctavesCount; o++ )
+		{
+			Result += Amplitude * TilingNoise( _X * Frequency, _Y * Frequency, _Period << o, _Seed + o * 0x9E3779B9u );
+
+			Amplitude *= 0.5f;
+			Frequency *= 2.0f;
+		}
+
+		return Result;
+	}
+
+	/// <summary>Convert a value between -1 and 1 to a byte.</summary>
+	/// <param name="_Value">The value to convert.</param>
+	/// <returns>The value as byte.</returns>
+	Uint8 ToByte( float _Value )
+	{
+		return Cast( Uint8, ae::Math::Clamp01( _Value * 0.5f + 0.5f ) * 255.0f + 0.5f );
+	}
+
+	/// <summary>Compute the detail normal of a texel, as the analytic SimplexNormal of the snow shader.</summary>
+	/// <param name="_Heights">Noise heights.</param>
+	/// <param name="_X">X coordinate of the texel.</param>
+	/// <param name="_Y">Y coordinate of the texel.</param>
+	/// <param name="_TexelsPerCell">Count of texels in a noise cell.</param>
+	/// <param name="_NormalX">X component of the normal.</param>
+	/// <param name="_NormalY">Y component of the normal.</param>
+	void ComputeDetailNormal( const std::vector<float>& _Heights, Uint32 _X, Uint32 _Y, float _TexelsPerCell, AE_Out float& _NormalX, AE_Out float& _NormalY )
+	{
+		const Uint32 Left = ( _X + TextureSize - 1 ) % TextureSize;
+		const Uint32 Right = ( _X + 1 ) % TextureSize;
+		const Uint32 Down = ( _Y + TextureSize - 1 ) % TextureSize;
+		const Uint32 Up = ( _Y + 1 ) % TextureSize;
+
+		// Height differences over two cells, like the offsets of the analytic noise.
+		const float DeltaX = ( _Heights[_Y * TextureSize + Right] - _Heights[_Y * TextureSize + Left] ) * _TexelsPerCell;
+		const float DeltaY = ( _Heights[Up * TextureSize + _X] - _Heights[Down * TextureSize + _X] ) * _TexelsPerCell;
+
+		// Cross product of the normalized horizontal ( 2, 0, DeltaX ) and vertical ( 0, 2, DeltaY ) tangents.
+		const float HorizontalLength = std::sqrt( 4.0f + DeltaX * DeltaX );
+		const float VerticalLength = std::sqrt( 4.0f + DeltaY * DeltaY );
+
+		_NormalX = -( DeltaX / HorizontalLength ) * ( 2.0f / VerticalLength );
+		_NormalY = -( 2.0f / HorizontalLength ) * ( DeltaY / VerticalLength );
+	}
+}
+
+DetailTextures::DetailTextures() :
+	m_IsBaked( False ),
+	m_Material( nullptr ),
+	m_ChunkCellsParameter( nullptr ),
+	m_GrainCellsParameter( nullptr ),
+	m_UseAnalyticNoise( False ),
+	m_BakeTime( 0.0f ),
+	m_IsFromCache( False )
+{
+	m_DetailMap.SetName( "Detail Normal Map" );
+	m_DetailMap.SetWrapMode( ae::TextureWrapMode::Repeat );
+	m_DetailMap.SetFilterMode( ae::TextureFilterMode::Linear );
+
+	m_GlitterMap.SetName( "Glitter Map" );
+	m_GlitterMap.SetWrapMode( ae::TextureWrapMode::Repeat );
+	m_GlitterMap.SetFilterMode( ae::TextureFilterMode::Linear );
+}
+
+void DetailTextures::AddToMaterial( ae::Material& _Material )
+{
+	m_Material = &_Material;
+
+	_Material.AddTextureParameterToMaterial( "SnowDetailMap", "SnowDetailMap", &m_DetailMap );
+	_Material.AddTextureParameterToMaterial( "SnowGlitterMap", "SnowGlitterMap", &m_GlitterMap );
+
+	m_ChunkCellsParameter = _Material.AddFloatParameterToMaterial( "SnowDetailChunkCells", "SnowDetailChunkCells", Cast( float, ae::Math::Max( m_Settings.ChunkCells, 1u ) ) );
+	m_ChunkCellsParameter->SetEditable( False );
+
+	m_GrainCellsParameter = _Material.AddFloatParameterToMaterial( "SnowDetailGrainCells", "SnowDetailGrainCells", Cast( float, ae::Math::Max( m_Settings.GrainCells, 1u ) ) );
+	m_GrainCellsParameter->SetEditable( False );
+
+	ae::ShaderParameterFloat* GlitterCellsParameter = _Material.AddFloatParameterToMaterial( "SnowDetailGlitterCells", "SnowDetailGlitterCells", Cast( float, GlitterCells ) );
+	GlitterCellsParameter->SetEditable( False );
+}
+
+void DetailTextures::Update( const SnowParametersBuffer& _Parameters )
+{
+	const BakeSettings Settings = GetBakeSettings( _Parameters );
+
+	if( m_IsBaked && Settings.ChunkCells == m_Settings.ChunkCells && Settings.GrainCells == m_Settings.GrainCells && Settings.Seed == m_Settings.Seed )
+		return;
+
+	// Wait for the end of the edition of a parameter, not baking at each step of a drag.
+	if( m_IsBaked && ImGui::GetCurrentContext() != nullptr && ImGui::IsAnyItemActive() )
+		return;
+
+	Bake( Settings );
+}
+
+ae::TextureImage& DetailTextures::GetDetailMap()
+{
+	return m_DetailMap;
+}
+
+ae::TextureImage& DetailTextures::GetGlitterMap()
+{
+	return m_GlitterMap;
+}
+
+void DetailTextures::ToEditor()
+{
+	ImGui::Text( "Detail Textures" );
+
+	bool UseAnalyticNoise = m_UseAnalyticNoise;
+	if( ImGui::Checkbox( "Analytic Noise (Quality)", &UseAnalyticNoise ) )
+	{
+		m_UseAnalyticNoise = UseAnalyticNoise;
+
+		// Compile a variant of the snow shader evaluating the noises for each pixel.
+		if( m_Material != nullptr )
+		{
+			if( m_UseAnalyticNoise )
+				m_Material->SetShaderDefine( "SNOW_ANALYTIC_NOISE" );
+			else
+				m_Material->RemoveShaderDefine( "SNOW_ANALYTIC_NOISE" );
+		}
+	}
+
+	ImGui::Text( "Baked in %.3f s%s", m_BakeTime, m_IsFromCache ? " (from disk cache)" : "" );
+
+	ImGui::Separator();
+}
+
+DetailTextures::BakeSettings DetailTextures::GetBakeSettings( const SnowParametersBuffer& _Parameters )
+{
+	// The analytic noise has "Frequency" cells in a fifth of the plane UV, the tile covers this fifth with the closest count of cells.
+	// When there are too many cells to fit in the texture, the tile repeats more often.
+	const float ChunkCells = ae::Math::Round( _Parameters.GetChunkFrequency() * 5.0f );
+	const float GrainCells = ae::Math::Round( _Parameters.GetGrainFrequency() * 5.0f );
+
+	BakeSettings Settings;
+	Settings.ChunkCells = Cast( Uint32, ae::Math::Clamp( 1.0f, Cast( float, MaxCells ), ChunkCells ) );
+	Settings.GrainCells = Cast( Uint32, ae::Math::Clamp( 1.0f, Cast( float, MaxCells ), GrainCells ) );
+
+	const float Seed = _Parameters.GetNoiseSeed();
+	std::memcpy( &Settings.Seed, &Seed, sizeof( Uint32 ) );
+
+	return Settings;
+}
+
+void DetailTextures::Bake( const BakeSettings& _Settings )
+{
+	const ae::Time StartTime = ae::Time::GetTick();
+
+	m_IsFromCache = LoadFromCache( _Settings );
+
+	if( !m_IsFromCache )
+	{
+		std::vector<float> ChunkHeights( TextureSize * TextureSize );
+		std::vector<float> GrainHeights( TextureSize * TextureSize );
+
+		m_DetailPixels.resize( TextureSize * TextureSize * 4 );
+		m_GlitterPixels.resize( TextureSize * TextureSize );
+
+		// The normals need the heights of the neighbor rows, so all the heights are baked first.
+		RunOnAllCores( [&]( Uint32 _Begin, Uint32 _End )
+		{
+			BakeHeights( _Settings, _Begin, _End, ChunkHeights, GrainHeights );
+		} );
+
+		RunOnAllCores( [&]( Uint32 _Begin, Uint32 _End )
+		{
+			BakeNormals( _Settings, _Begin, _End, ChunkHeights, GrainHeights );
+		} );
+
+		SaveToCache( _Settings );
+	}
+
+	m_Settings = _Settings;
+	m_IsBaked = True;
+
+	UploadTextures();
+
+	m_BakeTime = Cast( float, ae::Time::GetTick().AsMicroSeconds() - StartTime.AsMicroSeconds() ) * 0.000001f;
+
+	AE_LogMessage( std::string( "Snow detail textures " ) + ( m_IsFromCache ? "read from cache" : "baked" ) + " in " + std::to_string( m_BakeTime ) + " s." );
+}
+
+void DetailTextures::BakeHeights( const BakeSettings& _Settings, Uint32 _Begin, Uint32 _End, AE_Out std::vector<float>& _ChunkHeights, AE_Out std::vector<float>& _GrainHeights )
+{
+	const float ChunkScale = Cast( float, _Settings.ChunkCells ) / Cast( float, TextureSize );
+	const float GrainScale = Cast( float, _Settings.GrainCells ) / Cast( float, TextureSize );
+	const float GlitterScale = Cast( float, GlitterCells ) / Cast( float, TextureSize );
+
+	// Different seeds, the chunks, the grains and the glitter must not be correlated.
+	const Uint32 ChunkSeed = _Settings.Seed;
+	const Uint32 GrainSeed = _Settings.Seed ^ 0x68E31DA4u;
+	const Uint32 GlitterSeed = _Settings.Seed ^ 0xB5297A4Du;
+
+	for( Uint32 y = _Begin; y < _End; y++ )
+	{
+		const float TexelY = Cast( float, y ) + 0.5f;
+
+		for( Uint32 x = 0; x < TextureSize; x++ )
+		{
+			const float TexelX = Cast( float, x ) + 0.5f;
+			const Uint32 Index = y * TextureSize + x;
+
+			_ChunkHeights[Index] = TilingFractalNoise( TexelX * ChunkScale, TexelY * ChunkScale, _Settings.ChunkCells, ChunkSeed );
+			_GrainHeights[Index] = TilingFractalNoise( TexelX * GrainScale, TexelY * GrainScale, _Settings.GrainCells, GrainSeed );
+
+			// Single octave, as the analytic glitter.
+			m_GlitterPixels[Index] = ToByte( TilingNoise( TexelX * GlitterScale, TexelY * GlitterScale, GlitterCells, GlitterSeed ) );
+		}
+	}
+}
+
+void DetailTextures::BakeNormals( const BakeSettings& _Settings, Uint32 _Begin, Uint32 _End, const std::vector<float>& _ChunkHeights, const std::vector<float>& _GrainHeights )
+{
+	const float ChunkTexelsPerCell = Cast( float, TextureSize ) / Cast( float, _Settings.ChunkCells );
+	const float GrainTexelsPerCell = Cast( float, TextureSize ) / Cast( float, _Settings.GrainCells );
+
+	for( Uint32 y = _Begin; y < _End; y++ )
+	{
+		for( Uint32 x = 0; x < TextureSize; x++ )
+		{
+			Uint8* Pixel = &m_DetailPixels[( y * TextureSize + x ) * 4];
+
+			float NormalX = 0.0f;
+			float NormalY = 0.0f;
+
+			ComputeDetailNormal( _ChunkHeights, x, y, ChunkTexelsPerCell, NormalX, NormalY );
+			Pixel[0] = ToByte( NormalX );
+			Pixel[1] = ToByte( NormalY );
+
+			ComputeDetailNormal( _GrainHeights, x, y, GrainTexelsPerCell, NormalX, NormalY );
+			Pixel[2] = ToByte( NormalX );
+			Pixel[3] = ToByte( NormalY );
+		}
+	}
+}
+
+template<typename StepFunction>
+void DetailTextures::RunOnAllCores( StepFunction _Step )
+{
+	// Small bands of rows : the jobs of the threads done first steal the remaining ones.
+	constexpr Uint32 RowsPerJob = 8;
+
+	Aero.GetJobSystem().ParallelFor( 0, TextureSize, RowsPerJob, _Step );
+}
+
+Bool DetailTextures::LoadFromCache( const BakeSettings& _Settings )
+{
+	std::ifstream File( GetCachePath( _Settings ), std::ios::binary );
+	if( !File.is_open() )
+		return False;
+
+	CacheHeader Header;
+	if( !File.read( reinterpret_cast<char*>( &Header ), sizeof( CacheHeader ) ) )
+		return False;
+
+	if( Header.Magic != CacheMagic || Header.Version != CacheVersion || Header.Size != TextureSize || Header.ChunkCells != _Settings.ChunkCells ||
+		Header.GrainCells != _Settings.GrainCells || Header.GlitterCells != GlitterCells || Header.Seed != _Settings.Seed )
+		return False;
+
+	m_DetailPixels.resize( TextureSize * TextureSize * 4 );
+	m_GlitterPixels.resize( TextureSize * TextureSize );
+
+	File.read( reinterpret_cast<char*>( m_DetailPixels.data() ), m_DetailPixels.size() );
+	File.read( reinterpret_cast<char*>( m_GlitterPixels.data() ), m_GlitterPixels.size() );
+
+	return !File.fail();
+}
+
+void DetailTextures::SaveToCache( const BakeSettings& _Settings ) const
+{
+	// Fails when the directory already exists, the opening of the file tells if it is usable.
+#ifdef WINDOWS
+	_mkdir( CacheDirectory );
+#elif defined( LINUX )
+	mkdir( CacheDirectory, 0755 );
+#endif
+
+	const std::string CachePath = GetCachePath( _Settings );
+
+	std::ofstream File( CachePath, std::ios::binary | std::ios::trunc );
+	if( !File.is_open() )
+	{
+		AE_LogWarning( std::string( "Failed to open the snow detail cache file " ) + CachePath + ". The textures will be baked at each launch." );
+		return;
+	}
+
+	CacheHeader Header;
+	Header.Magic = CacheMagic;
+	Header.Version = CacheVersion;
+	Header.Size = TextureSize;
+	Header.ChunkCells = _Settings.ChunkCells;
+	Header.GrainCells = _Settings.GrainCells;
+	Header.GlitterCells = GlitterCells;
+	Header.Seed = _Settings.Seed;
+
+	File.write( reinterpret_cast<const char*>( &Header ), sizeof( CacheHeader ) );
+	File.write( reinterpret_cast<const char*>( m_DetailPixels.data() ), m_DetailPixels.size() );
+	File.write( reinterpret_cast<const char*>( m_GlitterPixels.data() ), m_GlitterPixels.size() );
+
+	// Never leave a truncated file, it would be read and refused at each launch.
+	if( !File.good() )
+	{
+		File.close();
+		std::remove( CachePath.c_str() );
+	}
+}
+
+std::string DetailTextures::GetCachePath( const BakeSettings& _Settings ) const
+{
+	char FileName[64];
+	std::snprintf( FileName, sizeof( FileName ), "Detail_%u_%u_%u_%08x.aedetail", TextureSize, _Settings.ChunkCells, _Settings.GrainCells, _Settings.Seed );
+
+	return std::string( CacheDirectory ) + "/" + FileName;
+}
+
+void DetailTextures::UploadTextures()
+{
+	ae::Image DetailImage;
+	DetailImage.LoadFromMemory( m_DetailPixels.data(), TextureSize, TextureSize, ae::ImageFormat::RGB_Alpha );
+	m_DetailMap.Set( DetailImage );
+
+	ae::Image GlitterImage;
+	GlitterImage.LoadFromMemory( m_GlitterPixels.data(), TextureSize, TextureSize, ae::ImageFormat::GeyScale );
+	m_GlitterMap.Set( GlitterImage );
+
+	// The grains are smaller than a pixel from far away, filter them with the mip maps.
+	ae::TextureImage* Textures[2] = { &m_DetailMap, &m_GlitterMap };
+	for( ae::TextureImage* Texture : Textures )
+	{
+		Texture->Bind();
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+		AE_ErrorCheckOpenGLError();
+		Texture->Unbind();
+
+		Texture->GenerateMipMap();
+	}
+
+	if( m_ChunkCellsParameter != nullptr )
+		m_ChunkCellsParameter->SetValue( Cast( float, m_Settings.ChunkCells ) );
+
+	if( m_GrainCellsParameter != nullptr )
+		m_GrainCellsParameter->SetValue( Cast( float, m_Settings.GrainCells ) );
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <API/Code/Graphics/Texture/TextureImage.h>
+#include <API/Code/Graphics/Material/Material.h>
+
+#include <vector>
+
+class SnowParametersBuffer;
+
+/// <summary>
+/// Tiling textures replacing the noises evaluated for each pixel of the snow surface : <para/>
+/// - Detail normals : chunk normal in red/green, grain normal in blue/alpha.<para/>
+/// - Glitter mask : random value of the glitter in red.<para/>
+/// Baked on the CPU with all the cores and saved on the disk, the next launches with the same parameters only read them.
+/// The analytic noises can still be used in the shader for quality.
+/// </summary>
+class DetailTextures
+{
+public:
+	/// <summary>Create the textures, empty until the first bake.</summary>
+	DetailTextures();
+
+	/// <summary>Add the textures and their settings to the snow material.</summary>
+	/// <param name="_Material">The material of the snow surface.</param>
+	void AddToMaterial( ae::Material& _Material );
+
+	/// <summary>Bake the textures if the noise parameters changed, from the disk cache when possible.</summary>
+	/// <param name="_Parameters">The snow parameters with the noise settings.</param>
+	void Update( const SnowParametersBuffer& _Parameters );
+
+	/// <summary>Retrieve the detail normals texture.</summary>
+	/// <returns>The detail normals (chunk in red/green, grain in blue/alpha).</returns>
+	ae::TextureImage& GetDetailMap();
+
+	/// <summary>Retrieve the glitter mask texture.</summary>
+	/// <returns>The glitter mask.</returns>
+	ae::TextureImage& GetGlitterMap();
+
+	/// <summary>Expose properties to the editor panel.</summary>
+	void ToEditor();
+
+private:
+	/// <summary>Settings of a bake.</summary>
+	struct BakeSettings
+	{
+		/// <summary>Count of chunk noise cells in a tile.</summary>
+		Uint32 ChunkCells = 0;
+
+		/// <summary>Count of grain noise cells in a tile.</summary>
+		Uint32 GrainCells = 0;
+
+		/// <summary>Seed of the noises.</summary>
+		Uint32 Seed = 0;
+	};
+
+	/// <summary>Compute the bake settings from the snow parameters.</summary>
+	/// <param name="_Parameters">The snow parameters with the noise settings.</param>
+	/// <returns>The bake settings.</returns>
+	static BakeSettings GetBakeSettings( const SnowParametersBuffer& _Parameters );
+
+	/// <summary>Bake the textures on the CPU with all the cores.</summary>
+	/// <param name="_Settings">Settings of the bake.</param>
+	void Bake( const BakeSettings& _Settings );
+
+	/// <summary>Bake the rows [_Begin, _End[ of the noise heights and the glitter mask.</summary>
+	/// <param name="_Settings">Settings of the bake.</param>
+	/// <param name="_Begin">First row to bake.</param>
+	/// <param name="_End">Row after the last one to bake.</param>
+	/// <param name="_ChunkHeights">Heights of the chunk noise.</param>
+	/// <param name="_GrainHeights">Heights of the grain noise.</param>
+	void BakeHeights( const BakeSettings& _Settings, Uint32 _Begin, Uint32 _End, AE_Out std::vector<float>& _ChunkHeights, AE_Out std::vector<float>& _GrainHeights );
+
+	/// <summary>Bake the rows [_Begin, _End[ of the detail normals from the noise heights.</summary>
+	/// <param name="_Settings">Settings of the bake.</param>
+	/// <param name="_Begin">First row to bake.</param>
+	/// <param name="_End">Row after the last one to bake.</param>
+	/// <param name="_ChunkHeights">Heights of the chunk noise.</param>
+	/// <param name="_GrainHeights">Heights of the grain noise.</param>
+	void BakeNormals( const BakeSettings& _Settings, Uint32 _Begin, Uint32 _End, const std::vector<float>& _ChunkHeights, const std::vector<float>& _GrainHeights );
+
+	/// <summary>Run a bake step on all the cores with the job system, each job processing a band of rows.</summary>
+	/// <param name="_Step">The step to run, called with the first and the last row of a band.</param>
+	template<typename StepFunction>
+	void RunOnAllCores( StepFunction _Step );
+
+	/// <summary>Read the textures of a bake from the disk cache.</summary>
+	/// <param name="_Settings">Settings of the bake.</param>
+	/// <returns>True if the textures have been read, False otherwise.</returns>
+	Bool LoadFromCache( const BakeSettings& _Settings );
+
+	/// <summary>Write the textures of a bake to the disk cache.</summary>
+	/// <param name="_Settings">Settings of the bake.</param>
+	void SaveToCache( const BakeSettings& _Settings ) const;
+
+	/// <summary>Get the path of the cached textures of a bake.</summary>
+	/// <param name="_Settings">Settings of the bake.</param>
+	/// <returns>Path to the cache file.</returns>
+	std::string GetCachePath( const BakeSettings& _Settings ) const;
+
+	/// <summary>Send the baked pixels to the textures and the cell counts to the material.</summary>
+	void UploadTextures();
+
+private:
+	/// <summary>Detail normals texture.</summary>
+	ae::TextureImage m_DetailMap;
+
+	/// <summary>Glitter mask texture.</summary>
+	ae::TextureImage m_GlitterMap;
+
+	/// <summary>Baked detail normals pixels (RGBA).</summary>
+	std::vector<Uint8> m_DetailPixels;
+
+	/// <summary>Baked glitter mask pixels (red).</summary>
+	std::vector<Uint8> m_GlitterPixels;
+
+	/// <summary>Settings of the current textures.</summary>
+	BakeSettings m_Settings;
+
+	/// <summary>Has a bake been done ?</summary>
+	Bool m_IsBaked;
+
+	/// <summary>Material of the snow surface.</summary>
+	ae::Material* m_Material;
+
+	/// <summary>Parameter for the count of chunk noise cells in a tile.</summary>
+	ae::ShaderParameterFloat* m_ChunkCellsParameter;
+
+	/// <summary>Parameter for the count of grain noise cells in a tile.</summary>
+	ae::ShaderParameterFloat* m_GrainCellsParameter;
+
+	/// <summary>Use the noises evaluated for each pixel instead of the baked textures ?</summary>
+	Bool m_UseAnalyticNoise;
+
+	/// <summary>Time of the last bake in seconds.</summary>
+	float m_BakeTime;
+
+	/// <summary>Has the last bake been read from the disk cache ?</summary>
+	Bool m_IsFromCache;
+};
\ No newline at end of file
@@ -19,6 +19,8 @@ JumpFlooding::JumpFlooding( Uint32 _TextureSize, ae::Texture& _PenetrationTextur
 	m_TextureSize( _TextureSize ),
 	m_CurrentPingPongIndex( 0 )
 {
+	m_PingPongFBO[0]->SetPassName( "Flooding Ping" );
+	m_PingPongFBO[1]->SetPassName( "Flooding Pong" );
 	m_PingPongFBO[0]->GetAttachementTexture()->SetWrapMode( ae::TextureWrapMode::ClampToEdge );
 	m_PingPongFBO[0]->GetAttachementTexture()->SetName( "Flooding Ping Texture" );
 	m_PingPongFBO[1]->GetAttachementTexture()->SetWrapMode( ae::TextureWrapMode::ClampToEdge );
@@ -5,6 +5,7 @@ PenetrationPass::PenetrationPass( Uint32 _TextureSize, ae::Texture& _HeightMap,
 	m_Shader( "../../../Data/Projects/Snow/PenetrationVertex.glsl", "../../../Data/Projects/Snow/PenetrationFragment.glsl" ),
 	m_Material( m_Shader )
 {
+	m_FBO.SetPassName( "Penetration Pass" );
 	m_FBO.GetAttachementTexture()->SetName( "Penetration Texture" );
 
 	m_Shader.SetName( "Penetration Shader" );
@@ -3,16 +3,16 @@
 
 #include <API/Code/Graphics/Image/Image.h>
 #include <API/Code/Aero/Aero.h>
+#include <API/Code/Graphics/Camera/Camera.h>
 
 Scene::Scene() :
 	m_Ball( 0.1f, 50, 50 ),
-	m_Lantern( "../../../Data/Projects/Snow/Lantern/Lantern.ply" ),
-	m_MooMoo( "../../../Data/Projects/Snow/MooMoo/spot_triangulated.obj" ),
-	m_MooMooTexture( "../../../Data/Projects/Snow/MooMoo/spot_texture.png" ),
-	m_FenceBack( "../../../Data/Projects/Snow/Fence/Fence.ply" ),
-	m_FenceLeft( "../../../Data/Projects/Snow/Fence/Fence.ply" ),
-	m_LeftBoot( "../../../Data/Projects/Snow/Boots/LeftBoot.obj" ),
-	m_RightBoot( "../../../Data/Projects/Snow/Boots/RightBoot.obj" ),
+	m_Lantern( 0, 0 ),
+	m_MooMoo( 0, 0 ),
+	m_Fence( 0, 0 ),
+	m_Fences( m_Fence ),
+	m_LeftBoot( 0, 0 ),
+	m_RightBoot( 0, 0 ),
 
 	m_BootsTrajectoryLeft( { { 0.8f, 0.27f, 0.7f }, { 0.6f, 0.34f, 0.7f }, { 0.4f, 0.27f, 0.7f }, { 0.2f, 0.34f, 0.7f }, { 0.0f, 0.27f, 0.7f }, { -0.2f, 0.34f, 0.7f }, { -0.4f, 0.27f, 0.7f }, { -0.6f, 0.34f, 0.7f }, { -0.8f, 0.27f, 0.7f } },
 						   { { 0.0f, 0.0f, 0.0f }, { -0.4f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { -0.4f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { -0.4f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { -0.4f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } } ),
@@ -33,38 +33,44 @@ Scene::Scene() :
 	m_Ball.SetPosition( 0.0f, 0.32f, 0.0f );
 	m_Ball.SetBlendMode( ae::BlendMode::BlendNone );
 
+	// The meshes stream in while the scene is already displayed.
+	m_Lantern.LoadFromFileAsync( "../../../Data/Projects/Snow/Lantern/Lantern.ply", False, [this]( ae::Mesh3D& _Mesh ) { _Mesh.SetMaterial( m_ObjectsMat ); } );
 	m_Lantern.SetName( "Lantern" );
-	m_Lantern.SetMaterial( m_ObjectsMat );
 	m_Lantern.SetPosition( -0.8f, 0.2f, -0.8f );
 	m_Lantern.SetScale( 0.4f, 0.4f, 0.4f );
 	m_Lantern.SetBlendMode( ae::BlendMode::BlendNone );
 
+	m_MooMooTexture.SetAsync( "../../../Data/Projects/Snow/MooMoo/spot_texture.png" );
+
+	m_MooMoo.LoadFromFileAsync( "../../../Data/Projects/Snow/MooMoo/spot_triangulated.obj", False, [this]( ae::Mesh3D& _Mesh )
+	{
+		_Mesh.GetMaterial().GetParameter<ae::ShaderParameterTextureBool>( ae::Material::DefaultParameters::DiffuseTexture )->SetTexture( &m_MooMooTexture );
+	} );
 	m_MooMoo.SetName( "Moo Moo" );
 	m_MooMoo.SetPosition( -0.55f, 0.42f, -0.7f );
 	m_MooMoo.SetRotation( 0.0f, ae::Math::Pi(), 0.0f );
 	m_MooMoo.Scale( 0.2f, 0.2f, 0.2f );
 	m_MooMoo.SetBlendMode( ae::BlendMode::BlendNone );
-	m_MooMoo.GetMaterial().GetParameter<ae::ShaderParameterTextureBool>( ae::Material::DefaultParameters::DiffuseTexture )->SetTexture( &m_MooMooTexture );
 
-	m_FenceBack.SetName( "Fence Back" );
-	m_FenceBack.SetPosition( 0.0f, 0.2f, -0.8f );
-	m_FenceBack.SetScale( 0.4f, 0.4f, 0.4f );
-	m_FenceBack.SetMaterial( m_ObjectsMat );
-	m_FenceBack.SetBlendMode( ae::BlendMode::BlendNone );
+	// The fence is loaded once and drawn at each place in one draw call.
+	m_Fence.LoadFromFileAsync( "../../../Data/Projects/Snow/Fence/Fence.ply", False, [this]( ae::Mesh3D& _Mesh ) { m_Fences.SetMesh( _Mesh ); } );
+	m_Fence.SetName( "Fence" );
 
-	m_FenceLeft.SetName( "Fence Left" );
-	m_FenceLeft.SetPosition( -0.8f, 0.2f, 0.0f );
-	m_FenceLeft.SetRotation( 0.0f, ae::Math::PiDivBy2(), 0.0f );
-	m_FenceLeft.SetScale( 0.4f, 0.4f, 0.4f );
-	m_FenceLeft.SetMaterial( m_ObjectsMat );
-	m_FenceLeft.SetBlendMode( ae::BlendMode::BlendNone );
+	m_Fences.SetName( "Fences" );
+	m_Fences.AddInstance( ae::Transform( ae::Vector3( 0.0f, 0.2f, -0.8f ), ae::Rotator( 0.0f, 0.0f, 0.0f ), ae::Vector3( 0.4f, 0.4f, 0.4f ) ).GetMatrix() );
+	m_Fences.AddInstance( ae::Transform( ae::Vector3( -0.8f, 0.2f, 0.0f ), ae::Rotator( 0.0f, ae::Math::PiDivBy2(), 0.0f ), ae::Vector3( 0.4f, 0.4f, 0.4f ) ).GetMatrix() );
+	m_Fences.ApplyChanges();
+	m_Fences.SetMaterial( m_ObjectsMat );
+	m_Fences.SetBlendMode( ae::BlendMode::BlendNone );
 
 
+	m_LeftBoot.LoadFromFileAsync( "../../../Data/Projects/Snow/Boots/LeftBoot.obj" );
 	m_LeftBoot.SetName( "Left Boot" );
 	m_LeftBoot.SetScale( 0.05f, 0.05f, 0.05f );
 	m_LeftBoot.SetPosition( 0.8f, 0.29f, 0.8f );
 	m_LeftBoot.SetBlendMode( ae::BlendMode::BlendNone );
 
+	m_RightBoot.LoadFromFileAsync( "../../../Data/Projects/Snow/Boots/RightBoot.obj" );
 	m_RightBoot.SetName( "Right Boot" );
 	m_RightBoot.SetScale( 0.05f, 0.05f, 0.05f );
 	m_RightBoot.SetPosition( 0.8f, 0.29f, 0.8f );
@@ -82,20 +88,65 @@ Scene::Scene() :
 	m_AmbientLight.SetColor( ae::Color( 0.8f, 0.619f, 0.662f ) );
 }
 
-void Scene::RenderDepthPass( ae::Renderer& _Renderer, const ae::Material& _DepthMaterial, ae::Camera& _Camera )
+void Scene::RenderDepthPass( ae::Renderer& _Renderer, const ae::Material& _DepthMaterial, ae::Camera& _Camera, const ae::AABB& _SnowVolume, float _MaxError )
 {
-	_Renderer.Draw( m_Ball, _DepthMaterial, &_Camera );
-	_Renderer.Draw( m_Lantern, _DepthMaterial, &_Camera );
-	_Renderer.Draw( m_MooMoo, _DepthMaterial, &_Camera );
-	_Renderer.Draw( m_FenceBack, _DepthMaterial, &_Camera );
-	_Renderer.Draw( m_FenceLeft, _DepthMaterial, &_Camera );
-
-	_Renderer.Draw( m_LeftBoot, _DepthMaterial, &_Camera );
-	_Renderer.Draw( m_RightBoot, _DepthMaterial, &_Camera );
+	// The depth pass decides the footprints : same tolerance for every object, independent of the view.
+	m_Lantern.SelectLOD( _MaxError );
+	m_MooMoo.SelectLOD( _MaxError );
+	m_LeftBoot.SelectLOD( _MaxError );
+	m_RightBoot.SelectLOD( _MaxError );
+
+	// Objects above the maximum snow height or out of the ground footprint don't touch the snow.
+	// Objects without bounds yet (still loading) are always drawn.
+	auto DrawIfInSnow = [&]( const ae::Drawable& _Object )
+	{
+		const ae::AABB& Bounds = _Object.GetWorldBounds();
+
+		if( Bounds.IsValid() && !Bounds.Intersects( _SnowVolume ) )
+			return;
+
+		_Renderer.Draw( _Object, _DepthMaterial, &_Camera );
+	};
+
+	DrawIfInSnow( m_Ball );
+	DrawIfInSnow( m_Lantern );
+	DrawIfInSnow( m_MooMoo );
+	DrawIfInSnow( m_Fences );
+
+	DrawIfInSnow( m_LeftBoot );
+	DrawIfInSnow( m_RightBoot );
 }
 
 void Scene::RenderColorPass( ae::Renderer& _Renderer )
 {
+	// Keep the error of the levels of detail under one pixel, measured at the closest point of each object.
+	ae::Camera& ViewCamera = Aero.GetCamera();
+	const ae::Vector3 CameraPosition = ViewCamera.GetPosition();
+
+	auto SelectLOD = [&]( ae::Mesh3D& _Mesh )
+	{
+		const ae::Sphere Bounds = _Mesh.GetWorldBoundingSphere();
+		ae::Vector3 ClosestPoint = Bounds.GetCenter();
+
+		if( Bounds.GetRadius() > 0.0f )
+		{
+			const ae::Vector3 ToCamera = CameraPosition - Bounds.GetCenter();
+			const float Distance = ToCamera.Length();
+
+			if( Distance > Bounds.GetRadius() )
+				ClosestPoint += ToCamera * ( Bounds.GetRadius() / Distance );
+			else
+				ClosestPoint = CameraPosition;
+		}
+
+		_Mesh.SelectLOD( ViewCamera.GetPixelWorldSize( ClosestPoint, _Renderer.GetHeight() ) );
+	};
+
+	SelectLOD( m_Lantern );
+	SelectLOD( m_MooMoo );
+	SelectLOD( m_LeftBoot );
+	SelectLOD( m_RightBoot );
+
 	if( m_LanternLight.IsEnabled() )
 	{
 		m_LanternLight.SetPosition( m_Lantern.GetPosition() + ae::Vector3( 0.0f, 0.7f, 0.0f ) );
@@ -109,8 +160,7 @@ void Scene::RenderColorPass( ae::Renderer& _Renderer )
 
 	_Renderer.Draw( m_Ball );
 	_Renderer.Draw( m_MooMoo );
-	_Renderer.Draw( m_FenceBack );
-	_Renderer.Draw( m_FenceLeft );
+	_Renderer.Draw( m_Fences );
 
 	_Renderer.Draw( m_LeftBoot );
 	_Renderer.Draw( m_RightBoot );
@@ -4,6 +4,7 @@
 #include <API/Code/Graphics/Mesh/3D/CubeMesh.h>
 #include <API/Code/Graphics/Mesh/3D/SphereMesh.h>
 #include <API/Code/Graphics/Mesh/3D/Mesh3D.h>
+#include <API/Code/Graphics/Mesh/3D/InstancedMesh.h>
 
 #include <API/Code/Graphics/Texture/TextureImage.h>
 
@@ -13,6 +14,7 @@
 #include <API/Code/Graphics/Renderer/Renderer.h>
 
 #include <API/Code/Maths/Curve/CurveHermite.h>
+#include <API/Code/Maths/Primitives/AABB.h>
 
 class SnowPlane;
 
@@ -32,9 +34,11 @@ public:
 	/// <param name="_Renderer">The rendering target.</param>
 	/// <param name="_DepthMaterial">The material to use (will be the one in the DepthPass class).</param>
 	/// <param name="_Camera">The camera to use (will be the one bellow the ground).</param>
-	void RenderDepthPass( ae::Renderer& _Renderer, const ae::Material& _DepthMaterial,  ae::Camera& _Camera );
+	/// <param name="_SnowVolume">Volume of the snow, the objects entirely outside cannot deform it and are skipped.</param>
+	/// <param name="_MaxError">Maximum error of the levels of detail in world space, the footprints must stay accurate to the depth texels.</param>
+	void RenderDepthPass( ae::Renderer& _Renderer, const ae::Material& _DepthMaterial,  ae::Camera& _Camera, const ae::AABB& _SnowVolume, float _MaxError );
 
-	/// <summary>Render all the objects on the target.</summary>
+	/// <summary>Render all the objects on the target, with the levels of detail whose error is under a pixel.</summary>
 	/// <param name="_Renderer">The rendering target.</param>
 	void RenderColorPass( ae::Renderer& _Renderer );
 
@@ -52,8 +56,8 @@ private:
 	ae::Mesh3D m_Lantern;
 	ae::Mesh3D m_MooMoo;
 	ae::TextureImage m_MooMooTexture;
-	ae::Mesh3D m_FenceBack;
-	ae::Mesh3D m_FenceLeft;
+	ae::Mesh3D m_Fence;
+	ae::InstancedMesh m_Fences;
 
 	ae::Mesh3D m_LeftBoot;
 	ae::Mesh3D m_RightBoot;
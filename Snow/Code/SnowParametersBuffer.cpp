@@ -106,6 +106,41 @@ float SnowParametersBuffer::GetPixelSize() const
 	return m_Parameters.PixelSize;
 }
 
+float SnowParametersBuffer::GetChunkFrequency() const
+{
+	return m_Parameters.ChunkFrequency;
+}
+
+float SnowParametersBuffer::GetGrainFrequency() const
+{
+	return m_Parameters.GrainFrequency;
+}
+
+float SnowParametersBuffer::GetNoiseSeed() const
+{
+	return m_Parameters.NoiseSeed;
+}
+
+float SnowParametersBuffer::GetTessMin() const
+{
+	return m_Parameters.TessMin;
+}
+
+float SnowParametersBuffer::GetTessMax() const
+{
+	return m_Parameters.TessMax;
+}
+
+float SnowParametersBuffer::GetTessCameraDistanceMin() const
+{
+	return m_Parameters.TessCameraDistanceMin;
+}
+
+float SnowParametersBuffer::GetTessCameraDistanceMax() const
+{
+	return m_Parameters.TessCameraDistanceMax;
+}
+
 void SnowParametersBuffer::UpdateTimeFromLifeTime()
 {
 	m_Parameters.Time = Aero.GetLifeTime();
@@ -68,6 +68,34 @@ public:
 	/// <returns>The size of a texel as world distance.</returns>
 	float GetPixelSize() const;
 
+	/// <summary>Get the frequency of the chunk noise of the snow surface normals.</summary>
+	/// <returns>The frequency of the chunk noise.</returns>
+	float GetChunkFrequency() const;
+
+	/// <summary>Get the frequency of the grain noise of the snow surface normals.</summary>
+	/// <returns>The frequency of the grain noise.</returns>
+	float GetGrainFrequency() const;
+
+	/// <summary>Get the seed of the noises of the snow surface.</summary>
+	/// <returns>The seed of the noises.</returns>
+	float GetNoiseSeed() const;
+
+	/// <summary>Get the minimum tessellation level of the snow surface.</summary>
+	/// <returns>The tessellation level far from the camera.</returns>
+	float GetTessMin() const;
+
+	/// <summary>Get the maximum tessellation level of the snow surface.</summary>
+	/// <returns>The tessellation level close to the camera.</returns>
+	float GetTessMax() const;
+
+	/// <summary>Get the distance to the camera where the tessellation starts to decrease.</summary>
+	/// <returns>The distance of the maximum tessellation.</returns>
+	float GetTessCameraDistanceMin() const;
+
+	/// <summary>Get the distance to the camera where the tessellation reaches its minimum.</summary>
+	/// <returns>The distance of the minimum tessellation.</returns>
+	float GetTessCameraDistanceMax() const;
+
 	/// <summary>Update the tim value from the application life time.</summary>
 	void UpdateTimeFromLifeTime();
 
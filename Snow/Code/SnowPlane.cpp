@@ -31,4 +31,11 @@ SnowPlane::SnowPlane( ae::Texture& _HeightMap, ae::Texture& _NormalMap, float _S
 
 	SetBlendMode( ae::BlendMode::BlendNone );
 	SetPrimitiveType( ae::PrimitiveType::Patches );
+
+	// The snow shaders read only the position and the UV : 20 bytes per vertex instead of 48.
+	// The UV stay in floats, they sample the height map and must be exact to the texel.
+	SetVertexFormat( AttributePointer::Position | AttributePointer::TexCoords );
+
+	// The vertices are raised by the height map in the shaders, above the bounds of the flat plane.
+	SetCullingEnabled( False );
 }
@@ -8,6 +8,9 @@
 #include "SnowParametersBuffer.h"
 #include "Scene.h"
 #include "SnowPlane.h"
+#include "DetailTextures.h"
+#include "CDLODGround.h"
+#include "BouncingBalls.h"
 
 #include <API/Code/Includes.h>
 #include <API/Code/UI/Dependencies/IncludeImGui.h>
@@ -22,6 +25,8 @@ int main()
 	Aero;
 	Aero.SetPathToEngineData( "../../../Data/Engine/" );
 
+	const ae::Time StartupBeginTime = ae::Time::GetTick();
+
 	ae::Window MyWindow;
 	MyWindow.Create();
 	MyWindow.SetWindowTitle( "Snow Demo" );
@@ -47,6 +52,14 @@ int main()
 	NormalGeneration Normal( Parameters.GetTextureSize() );
 
 	SnowPlane Ground( Height.GetFloatHeightMap(), Normal.GetNormalMap() );
+
+	// Baked at startup, or read from the disk cache when the noise parameters did not change.
+	DetailTextures Detail;
+	Detail.AddToMaterial( Ground.GetMaterial() );
+	Detail.Update( Parameters );
+
+	// Chunks of the ground selected each frame, drawn instead of the tessellated plane.
+	CDLODGround GroundLOD( Ground );
 	
 
 	DepthPass DepthPassFromBelow( Parameters.GetTextureSize(), Ground );
@@ -70,6 +83,9 @@ int main()
 
 	Scene SceneObjects;
 
+	// Collisions benchmark, started from the editor.
+	BouncingBalls Balls;
+
 	ae::UI::InitImGUI( MyWindow );
 	ae::Editor Editor( True );
 	ImGui::GetIO().IniFilename = "Snow.ini";
@@ -81,13 +97,23 @@ int main()
 
 	ae::GammaCorrection GammaPostProcess;
 
+	// Compare a first launch, compiling the shaders, with the next ones loading them from the shader cache.
+	const ae::ShaderCacheStats& ShaderStats = Aero.GetResourcesManager().GetShaderCacheStats();
+	const float StartupTime = Cast( float, ae::Time::GetTick().AsMicroSeconds() - StartupBeginTime.AsMicroSeconds() ) * 0.000001f;
+
+	AE_LogMessage( "Startup in " + std::to_string( StartupTime ) + " s. Shaders : " + std::to_string( ShaderStats.Hits ) + " from cache, " +
+				   std::to_string( ShaderStats.Misses ) + " compiled, " + std::to_string( ShaderStats.CreationTime ) + " s spent creating them." );
+
 	while( Aero.Update() )
 	{
 		SceneObjects.UpdateBootsAnim();
+		Balls.Update();
 
 		DepthPassFromBelow.UpdateCamera( Ground );
 		PixelSize = GetPixelSize( Parameters.GetTextureSize(), Ground );
 		Parameters.Update( DepthPassFromBelow.GetCameraFar(), DepthPassFromBelow.GetCameraNear(), PixelSize );
+		Detail.Update( Parameters );
+		GroundLOD.Update( Camera, Parameters );
 
 
 		// Draw the objects that can collide with the terrain.
@@ -114,7 +140,8 @@ int main()
 		Editor.BindViewport( True, ae::Color( 0.1f, 0.1f, 0.1f ) );
 
 		SceneObjects.RenderColorPass( Editor.GetViewport() );
-		Editor.DrawOnViewport( Ground );
+		Balls.Render( Editor.GetViewport() );
+		Editor.DrawOnViewport( GroundLOD.GetDrawable() );
 
 		Editor.UnbindViewport();
 
@@ -135,6 +162,12 @@ int main()
 
 			Flooding.ToEditor();
 
+			Detail.ToEditor();
+
+			GroundLOD.ToEditor();
+
+			Balls.ToEditor();
+
 			EditorTextureSize( Parameters, Height, DepthPassFromBelow, Penetration, Flooding, Normal, Displacement, Ground );
 
 			ImGui::Separator();
@@ -151,6 +184,8 @@ int main()
 
 	MyWindow.Destroy();
 
+	// Stop the logging thread before the static objects are destroyed.
+	ae::Log::Shutdown();
 }
 
 
@@ -0,0 +1,47 @@
+#include <API/Code/Graphics/Mesh/3D/Mesh3D.h>
+#include <API/Code/Graphics/Mesh/3D/SharedGeometry.h>
+
+#include <chrono>
+#include <cstdio>
+
+// Cooks 3D files offline, without window nor OpenGL context : the ".aemesh" file is written next to each source,
+// with the optimized vertices, the levels of detail and the material, as the loading of a Mesh3D reads it.
+// The loading cooks the files anyway when they are missing or outdated, this avoids the cost on the first run.
+// Usage : MeshCooker <File> [<File> ...]
+// Returns 0 if every file has been cooked, 1 otherwise.
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+}
+
+int main( int _ArgumentsCount, char** _Arguments )
+{
+	if( _ArgumentsCount < 2 )
+	{
+		std::printf( "Usage : MeshCooker <File> [<File> ...]\n" );
+		return 1;
+	}
+
+	Uint32 FailuresCount = 0;
+
+	for( int a = 1; a < _ArgumentsCount; a++ )
+	{
+		const std::string File = _Arguments[a];
+		const Clock::time_point Start = Clock::now();
+
+		if( !ae::priv::SharedGeometry::Cook( File, ae::Mesh3D::GetImportFlags() ) )
+		{
+			std::printf( "FAILED : %s\n", File.c_str() );
+			FailuresCount++;
+			continue;
+		}
+
+		const double Milliseconds = std::chrono::duration<double, std::milli>( Clock::now() - Start ).count();
+		std::printf( "%s -> %s (%.1f ms)\n", File.c_str(), ae::priv::CookedMesh::GetCookedPath( File ).c_str(), Milliseconds );
+	}
+
+	std::printf( "%d files, %u failed\n", _ArgumentsCount - 1, FailuresCount );
+
+	return FailuresCount == 0 ? 0 : 1;
+}
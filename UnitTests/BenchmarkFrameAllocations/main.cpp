@@ -0,0 +1,216 @@
+#include <API/Code/Graphics/Light/Light.h>
+#include <API/Code/Toolbox/FrameAllocator/FrameAllocator.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+
+// Measures the heap allocations of the lights sent to the shaders, CPU only : the old code of these paths, with temporary strings,
+// is replayed next to the current one, with the light names and the frame arena. The uniform locations are searched in a map
+// filled like the cache of the shader, the OpenGL calls are left out.
+// Returns 0 if both paths found the same locations, 1 otherwise.
+
+namespace
+{
+	/// <summary>Count of heap allocations since the start, every operator new of the program.</summary>
+	std::atomic<Uint64> AllocationsCount( 0 );
+}
+
+void* operator new( size_t _Size )
+{
+	AllocationsCount.fetch_add( 1, std::memory_order_relaxed );
+
+	void* Memory = std::malloc( _Size > 0 ? _Size : 1 );
+	if( Memory == nullptr )
+		throw std::bad_alloc();
+
+	return Memory;
+}
+
+void operator delete( void* _Memory ) noexcept
+{
+	std::free( _Memory );
+}
+
+void operator delete( void* _Memory, size_t ) noexcept
+{
+	std::free( _Memory );
+}
+
+namespace
+{
+	/// <summary>Count of draws of each frame, each one sends all the lights.</summary>
+	constexpr Uint32 DrawsCount = 50;
+
+	/// <summary>Count of lights of each type : point, spot and directional.</summary>
+	constexpr std::array<Uint32, 3> LightsCount = { 8, 4, 2 };
+
+	/// <summary>Count of frames of each measure.</summary>
+	constexpr Uint32 FramesCount = 1000;
+
+	/// <summary>Count of repetitions of each measure, the first one warms the caches up.</summary>
+	constexpr Uint32 Repetitions = 3;
+
+	/// <summary>Names of the light arrays in the shaders, as the material gives them.</summary>
+	const std::array<std::string, 3> ArrayNames = { "PointLights", "SpotLights", "DirectionalLights" };
+
+	/// <summary>Members sent by each type of light, terminated by a null pointer.</summary>
+	const char* const PointMembers[] = { ".Position", ".Color", ".Radius", ".Intensity", nullptr };
+	const char* const SpotMembers[] = { ".Position", ".Color", ".LookAt", ".InnerAngle", ".OuterAngle", ".Intensity", ".Range", nullptr };
+	const char* const DirectionalMembers[] = { ".Position", ".Color", ".LookAt", ".Intensity", nullptr };
+	const std::array<const char* const*, 3> Members = { PointMembers, SpotMembers, DirectionalMembers };
+
+	using LocationsMap = std::unordered_map<std::string, Int32>;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>Time elapsed since a tick, in nanoseconds.</summary>
+	double GetNanoSecondsSince( Clock::time_point _Start )
+	{
+		return std::chrono::duration<double, std::nano>( Clock::now() - _Start ).count();
+	}
+
+	/// <summary>Gives access to the name builder of the lights, protected to the lights.</summary>
+	class LightAccess : public ae::Light
+	{
+	public:
+		using ae::Light::UniformName;
+	};
+
+	/// <summary>The cache of the shader filled with every name sent.</summary>
+	LocationsMap BuildLocations()
+	{
+		LocationsMap Locations;
+		Int32 Location = 0;
+
+		for( size_t t = 0; t < ArrayNames.size(); t++ )
+		{
+			for( Uint32 l = 0; l < LightsCount[t]; l++ )
+			{
+				for( const char* const* Member = Members[t]; *Member != nullptr; Member++ )
+					Locations[ArrayNames[t] + "[" + std::to_string( l ) + "]" + *Member] = Location++;
+			}
+		}
+
+		return Locations;
+	}
+
+	/// <summary>Search of the const char* overload of the shader : one key string reused per thread.</summary>
+	Int32 FindLocation( const LocationsMap& _Locations, const char* _Name )
+	{
+		thread_local std::string LookupName;
+		LookupName.assign( _Name );
+
+		LocationsMap::const_iterator itLocation = _Locations.find( LookupName );
+		return itLocation != _Locations.cend() ? itLocation->second : -1;
+	}
+
+	/// <summary>The old code : the array names copied on each draw, then a concatenation per member.</summary>
+	Int64 SendLightsBefore( const LocationsMap& _Locations )
+	{
+		Int64 Sum = 0;
+
+		for( Uint32 d = 0; d < DrawsCount; d++ )
+		{
+			const std::array<std::string, 3> UniformNames = { ArrayNames[0], ArrayNames[1], ArrayNames[2] };
+
+			for( size_t t = 0; t < UniformNames.size(); t++ )
+			{
+				for( Uint32 l = 0; l < LightsCount[t]; l++ )
+				{
+					const std::string IndexedLightName = UniformNames[t] + "[" + std::to_string( l ) + "]";
+
+					for( const char* const* Member = Members[t]; *Member != nullptr; Member++ )
+					{
+						LocationsMap::const_iterator itLocation = _Locations.find( IndexedLightName + *Member );
+						Sum += itLocation != _Locations.cend() ? itLocation->second : -1;
+					}
+				}
+			}
+		}
+
+		return Sum;
+	}
+
+	/// <summary>The current code : references to the array names, the names built in the frame arena.</summary>
+	Int64 SendLightsAfter( const LocationsMap& _Locations )
+	{
+		Int64 Sum = 0;
+
+		for( Uint32 d = 0; d < DrawsCount; d++ )
+		{
+			const std::array<const std::string*, 3> UniformNames = { &ArrayNames[0], &ArrayNames[1], &ArrayNames[2] };
+
+			for( size_t t = 0; t < UniformNames.size(); t++ )
+			{
+				for( Uint32 l = 0; l < LightsCount[t]; l++ )
+				{
+					LightAccess::UniformName IndexedLightName( *UniformNames[t], l );
+
+					for( const char* const* Member = Members[t]; *Member != nullptr; Member++ )
+						Sum += FindLocation( _Locations, IndexedLightName.Get( *Member ) );
+				}
+			}
+		}
+
+		return Sum;
+	}
+
+	/// <summary>Run the frames of a path, returns the sum of the locations found.</summary>
+	template<typename SendFunction>
+	Int64 Measure( const char* _Label, const LocationsMap& _Locations, SendFunction _Send )
+	{
+		Int64 Sum = 0;
+
+		const Uint64 AllocationsBefore = AllocationsCount.load();
+		const Clock::time_point Start = Clock::now();
+
+		for( Uint32 f = 0; f < FramesCount; f++ )
+		{
+			Sum += _Send( _Locations );
+
+			if( f + 1 < FramesCount )
+				ae::priv::FrameArena::EndFrame();
+		}
+
+		const double NanoSeconds = GetNanoSecondsSince( Start );
+		const Uint64 Allocations = AllocationsCount.load() - AllocationsBefore;
+
+		std::printf( "%s : %.1f allocations, %.1f us per frame\n", _Label, Cast( double, Allocations ) / FramesCount, NanoSeconds / FramesCount / 1000.0 );
+
+		return Sum;
+	}
+}
+
+int main()
+{
+	const LocationsMap Locations = BuildLocations();
+
+	std::printf( "%u draws per frame, %u point, %u spot and %u directional lights\n", DrawsCount, LightsCount[0], LightsCount[1], LightsCount[2] );
+
+	Bool IsSame = True;
+
+	for( Uint32 r = 0; r < Repetitions; r++ )
+	{
+		std::printf( "Run %u :\n", r + 1 );
+
+		const Int64 SumBefore = Measure( "Before", Locations, SendLightsBefore );
+		const Int64 SumAfter = Measure( "After ", Locations, SendLightsAfter );
+
+		// The last frame is not ended yet : the arena still holds its names.
+		std::printf( "Arena : %u bytes used by the last frame\n", Cast( Uint32, ae::priv::FrameArena::Get().GetUsedSize() ) );
+		ae::priv::FrameArena::EndFrame();
+
+		IsSame &= SumBefore == SumAfter;
+	}
+
+	if( !IsSame )
+		std::printf( "The paths did not find the same locations.\n" );
+
+	return IsSame ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#include <API/Code/Toolbox/HandlePool/HandlePool.h>
+#include <API/Code/Toolbox/HandleMap/HandleMap.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Measures the generational handles of the world objects and the resources : a pool gives the handles, a map stores a value for each.
+// The handles are validated, found then freed in a random order, as the objects of a scene are.
+// Returns 0 if every value has been found and the stale handles rejected, 1 otherwise.
+
+namespace
+{
+	/// <summary>Count of live handles of each measure.</summary>
+	constexpr Uint32 HandlesCount = 2000000;
+
+	/// <summary>Seed of the random orders.</summary>
+	constexpr Uint32 Seed = 1234;
+
+	/// <summary>Count of repetitions of each measure, the first one warms the caches up.</summary>
+	constexpr Uint32 Repetitions = 3;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>Time elapsed since a tick, in nanoseconds.</summary>
+	double GetNanoSecondsSince( Clock::time_point _Start )
+	{
+		return std::chrono::duration<double, std::nano>( Clock::now() - _Start ).count();
+	}
+
+	/// <summary>Create, find then free all the handles, returns False when a value is missing or a handle is refused.</summary>
+	Bool MeasureLifetime( std::mt19937& _Generator )
+	{
+		ae::HandlePool Pool;
+		ae::HandleMap<Uint32> Map;
+		std::vector<ae::HandlePool::Handle> Handles( HandlesCount );
+
+		Bool IsComplete = True;
+
+		Clock::time_point Start = Clock::now();
+
+		for( Uint32 h = 0; h < HandlesCount; h++ )
+		{
+			Handles[h] = Pool.GenerateHandle();
+			IsComplete &= Map.Insert( Handles[h], h );
+		}
+
+		std::printf( "Create + insert : %.1f ns\n", GetNanoSecondsSince( Start ) / HandlesCount );
+
+		// The values remember their creation order : shuffle both together to check each one.
+		std::vector<Uint32> Order( HandlesCount );
+		for( Uint32 h = 0; h < HandlesCount; h++ )
+			Order[h] = h;
+		std::shuffle( Order.begin(), Order.end(), _Generator );
+
+		Start = Clock::now();
+
+		for( Uint32 Index : Order )
+		{
+			const ae::HandlePool::Handle Handle = Handles[Index];
+			const Uint32* Value = Pool.IsValid( Handle ) ? Map.Find( Handle ) : nullptr;
+
+			IsComplete &= Value != nullptr && *Value == Index;
+		}
+
+		std::printf( "Validate + find, random order : %.1f ns\n", GetNanoSecondsSince( Start ) / HandlesCount );
+
+		std::shuffle( Order.begin(), Order.end(), _Generator );
+
+		Start = Clock::now();
+
+		for( Uint32 Index : Order )
+		{
+			IsComplete &= Map.Remove( Handles[Index] );
+			IsComplete &= Pool.FreeHandle( Handles[Index] );
+		}
+
+		std::printf( "Free + remove, random order : %.1f ns\n", GetNanoSecondsSince( Start ) / HandlesCount );
+
+		return IsComplete && Pool.GetCount() == 0 && Map.IsEmpty();
+	}
+
+	/// <summary>A handle whose slot has been reused by another one is refused by the pool and the map.</summary>
+	Bool CheckStaleHandles()
+	{
+		ae::HandlePool Pool;
+		ae::HandleMap<Uint32> Map;
+
+		const ae::HandlePool::Handle Stale = Pool.GenerateHandle();
+		Map.Insert( Stale, 1 );
+		Map.Remove( Stale );
+		Pool.FreeHandle( Stale );
+
+		// The slots freed are reused once enough of them wait : free more until the first one comes back.
+		ae::HandlePool::Handle Reused = ae::HandlePool::InvalidHandle;
+		for( Uint32 h = 0; h <= ae::HandlePool::MinimumFreeSlots + 1 && Reused == ae::HandlePool::InvalidHandle; h++ )
+		{
+			const ae::HandlePool::Handle Handle = Pool.GenerateHandle();
+
+			if( ae::HandlePool::GetIndex( Handle ) == ae::HandlePool::GetIndex( Stale ) )
+				Reused = Handle;
+			else
+				Pool.FreeHandle( Handle );
+		}
+
+		if( Reused == ae::HandlePool::InvalidHandle || !Map.Insert( Reused, 2 ) )
+			return False;
+
+		const Uint32* Value = Map.Find( Reused );
+
+		return Reused != Stale && !Pool.IsValid( Stale ) && Map.Find( Stale ) == nullptr && !Map.Remove( Stale ) && Value != nullptr && *Value == 2;
+	}
+}
+
+int main()
+{
+	std::mt19937 Generator( Seed );
+
+	std::printf( "%u handles\n", HandlesCount );
+
+	Bool IsComplete = True;
+
+	for( Uint32 r = 0; r < Repetitions; r++ )
+	{
+		std::printf( "Run %u :\n", r + 1 );
+
+		IsComplete &= MeasureLifetime( Generator );
+	}
+
+	const Bool IsStaleRejected = CheckStaleHandles();
+	std::printf( "Stale handle of a reused slot : %s\n", IsStaleRejected ? "rejected" : "ACCEPTED" );
+
+	if( !IsComplete )
+		std::printf( "Some values were not found or some handles were refused.\n" );
+
+	return IsComplete && IsStaleRejected ? 0 : 1;
+}
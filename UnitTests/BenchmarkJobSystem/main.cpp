@@ -0,0 +1,177 @@
+#include <API/Code/Toolbox/JobSystem/JobSystem.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Measures the scheduling overhead of the job system : the cost of the jobs themselves is close to nothing.
+// The count of workers can be given as first argument, 0 (the default) for one per core except the main thread one.
+// Returns 0 if every job ran, 1 otherwise.
+
+namespace
+{
+	/// <summary>Count of empty jobs of each round trip measure.</summary>
+	constexpr Uint32 EmptyJobsCount = 100000;
+
+	/// <summary>Count of single job round trips, each one waited before the next one.</summary>
+	constexpr Uint32 RoundTripsCount = 20000;
+
+	/// <summary>Count of calls to the parallel for.</summary>
+	constexpr Uint32 ParallelForCount = 2000;
+
+	/// <summary>Count of chunks of each parallel for, one index per chunk.</summary>
+	constexpr Uint32 ParallelForChunks = 64;
+
+	/// <summary>Count of jobs pushed by one worker job : the other threads steal them from its deque.</summary>
+	constexpr Uint32 FanOutJobsCount = 100000;
+
+	/// <summary>Count of repetitions of each measure, the first one warms the threads up.</summary>
+	constexpr Uint32 Repetitions = 3;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>Time elapsed since a tick, in nanoseconds.</summary>
+	double GetNanoSecondsSince( Clock::time_point _Start )
+	{
+		return std::chrono::duration<double, std::nano>( Clock::now() - _Start ).count();
+	}
+
+	/// <summary>Empty jobs run from the main thread and waited one by one : the latency of a submission.</summary>
+	Bool MeasureRoundTrip( ae::JobSystem& _Jobs )
+	{
+		std::atomic<Uint32> Done( 0 );
+
+		const Clock::time_point Start = Clock::now();
+
+		for( Uint32 j = 0; j < RoundTripsCount; j++ )
+		{
+			ae::JobCounter Counter;
+			_Jobs.Run( [&Done]() { Done++; }, &Counter );
+			_Jobs.Wait( Counter );
+		}
+
+		std::printf( "Run + Wait of one empty job : %.0f ns\n", GetNanoSecondsSince( Start ) / RoundTripsCount );
+
+		return Done == RoundTripsCount;
+	}
+
+	/// <summary>Empty jobs run from the main thread then waited all together : the throughput of the submissions.</summary>
+	Bool MeasureBatch( ae::JobSystem& _Jobs )
+	{
+		std::atomic<Uint32> Done( 0 );
+		ae::JobCounter Counter;
+
+		const Clock::time_point Start = Clock::now();
+
+		for( Uint32 j = 0; j < EmptyJobsCount; j++ )
+			_Jobs.Run( [&Done]() { Done++; }, &Counter );
+
+		_Jobs.Wait( Counter );
+
+		std::printf( "Run of %u empty jobs then Wait : %.0f ns per job\n", EmptyJobsCount, GetNanoSecondsSince( Start ) / EmptyJobsCount );
+
+		return Done == EmptyJobsCount;
+	}
+
+	/// <summary>Parallel for with a trivial body : the cost of a dispatch in a frame.</summary>
+	Bool MeasureParallelFor( ae::JobSystem& _Jobs )
+	{
+		std::vector<Uint32> Visits( ParallelForChunks, 0 );
+
+		const Clock::time_point Start = Clock::now();
+
+		for( Uint32 p = 0; p < ParallelForCount; p++ )
+		{
+			_Jobs.ParallelFor( 0, ParallelForChunks, 1, [&Visits]( Uint32 _Begin, Uint32 _End )
+			{
+				for( Uint32 Index = _Begin; Index < _End; Index++ )
+					Visits[Index]++;
+			} );
+		}
+
+		std::printf( "ParallelFor of %u trivial chunks : %.2f us\n", ParallelForChunks, GetNanoSecondsSince( Start ) / ParallelForCount / 1000.0 );
+
+		for( Uint32 Count : Visits )
+		{
+			if( Count != ParallelForCount )
+				return False;
+		}
+
+		return True;
+	}
+
+	/// <summary>One worker job pushes all the jobs on its own deque and waits : the other threads only get work by stealing.</summary>
+	Bool MeasureFanOut( ae::JobSystem& _Jobs )
+	{
+		std::atomic<Uint32> Done( 0 );
+		ae::JobCounter Outer;
+
+		const Clock::time_point Start = Clock::now();
+
+		_Jobs.Run( [&_Jobs, &Done]()
+		{
+			ae::JobCounter Inner;
+
+			for( Uint32 j = 0; j < FanOutJobsCount; j++ )
+				_Jobs.Run( [&Done]() { Done++; }, &Inner );
+
+			_Jobs.Wait( Inner );
+		}, &Outer );
+
+		_Jobs.Wait( Outer );
+
+		std::printf( "Fan-out of %u jobs from a worker : %.0f ns per job\n", FanOutJobsCount, GetNanoSecondsSince( Start ) / FanOutJobsCount );
+
+		return Done == FanOutJobsCount;
+	}
+
+	/// <summary>Threads created and joined for each dispatch, what the job system replaces.</summary>
+	void MeasureThreadsSpawn( Uint32 _ThreadsCount )
+	{
+		const Uint32 SpawnsCount = 200;
+
+		const Clock::time_point Start = Clock::now();
+
+		for( Uint32 s = 0; s < SpawnsCount; s++ )
+		{
+			std::vector<std::thread> Threads;
+			for( Uint32 t = 0; t < _ThreadsCount; t++ )
+				Threads.emplace_back( []() {} );
+
+			for( std::thread& Thread : Threads )
+				Thread.join();
+		}
+
+		std::printf( "Spawn + join of %u std::thread : %.2f us\n", _ThreadsCount, GetNanoSecondsSince( Start ) / SpawnsCount / 1000.0 );
+	}
+}
+
+int main( int _ArgumentsCount, char** _Arguments )
+{
+	const Uint32 WorkersCount = _ArgumentsCount > 1 ? Cast( Uint32, std::atoi( _Arguments[1] ) ) : 0;
+
+	ae::JobSystem Jobs( WorkersCount );
+	std::printf( "%u workers\n", Jobs.GetWorkersCount() );
+
+	Bool IsComplete = True;
+
+	for( Uint32 r = 0; r < Repetitions; r++ )
+	{
+		std::printf( "Run %u :\n", r + 1 );
+
+		IsComplete &= MeasureRoundTrip( Jobs );
+		IsComplete &= MeasureBatch( Jobs );
+		IsComplete &= MeasureParallelFor( Jobs );
+		IsComplete &= MeasureFanOut( Jobs );
+	}
+
+	MeasureThreadsSpawn( Jobs.GetWorkersCount() );
+
+	if( !IsComplete )
+		std::printf( "Some jobs did not run.\n" );
+
+	return IsComplete ? 0 : 1;
+}
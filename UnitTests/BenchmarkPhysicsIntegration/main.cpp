@@ -0,0 +1,201 @@
+#include <API/Code/Physics/Simulator/Integration.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Measures the integration of the physics simulator on one thread : the bodies stored in arrays per axis are integrated in place,
+// four at a time with SSE, the bodies not simulated masked out. The reference integrates the same arrays body by body with the scalar step.
+// The sleeping bodies come in groups, as objects resting together do.
+// Returns 0 if both integrations give the same results bit for bit, 1 otherwise.
+
+using ae::PhysicsSettings;
+
+namespace
+{
+	/// <summary>Count of bodies.</summary>
+	constexpr Uint32 BodiesCount = 100000;
+
+	/// <summary>Count of bodies of a job of the simulator.</summary>
+	constexpr Uint32 BodiesPerChunk = 256;
+
+	/// <summary>Count of neighbour bodies falling asleep together.</summary>
+	constexpr Uint32 SleepingGroupSize = 16;
+
+	/// <summary>Counts of steps per frame measured.</summary>
+	constexpr Uint32 StepCounts[] = { 1, 2, 4 };
+
+	/// <summary>Count of frames of each measure, the fastest one is kept.</summary>
+	constexpr Uint32 FramesCount = 60;
+
+	/// <summary>Duration of a step, 60 steps per second.</summary>
+	constexpr float TimeStep = 1.0f / 60.0f;
+
+	/// <summary>Seed of the bodies and of the sleeping groups.</summary>
+	constexpr Uint32 Seed = 1234;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>Time elapsed since a tick, in nanoseconds.</summary>
+	double GetNanoSecondsSince( Clock::time_point _Start )
+	{
+		return std::chrono::duration<double, std::nano>( Clock::now() - _Start ).count();
+	}
+
+	/// <summary>Bodies stored as the simulator does, one array per axis.</summary>
+	struct Bodies
+	{
+		std::vector<float> Positions[3];
+		std::vector<float> PreviousPositions[3];
+		std::vector<float> Velocities[3];
+		std::vector<float> Accelerations[3];
+		std::vector<float> Dampings;
+		std::vector<Uint32> Masks;
+	};
+
+	/// <summary>Bodies thrown in the air, a part of them asleep in groups.</summary>
+	Bodies BuildBodies( float _SleepingRatio, std::mt19937& _Generator )
+	{
+		std::uniform_real_distribution<float> Value( -5.0f, 5.0f );
+		std::uniform_real_distribution<float> Damping( 0.0f, 0.1f );
+		std::uniform_real_distribution<float> Ratio( 0.0f, 1.0f );
+
+		Bodies Result;
+		for( Uint32 Axis = 0; Axis < 3; Axis++ )
+		{
+			for( Uint32 b = 0; b < BodiesCount; b++ )
+			{
+				Result.Positions[Axis].push_back( Value( _Generator ) );
+				Result.Velocities[Axis].push_back( Value( _Generator ) );
+				Result.Accelerations[Axis].push_back( Axis == 1 ? -10.0f : 0.0f );
+			}
+
+			Result.PreviousPositions[Axis] = Result.Positions[Axis];
+		}
+
+		for( Uint32 b = 0; b < BodiesCount; b++ )
+			Result.Dampings.push_back( Damping( _Generator ) );
+
+		Result.Masks.resize( BodiesCount );
+		for( Uint32 Group = 0; Group < BodiesCount; Group += SleepingGroupSize )
+		{
+			const Uint32 Mask = Ratio( _Generator ) < _SleepingRatio ? 0 : 0xFFFFFFFF;
+			std::fill( Result.Masks.begin() + Group, Result.Masks.begin() + std::min( Group + SleepingGroupSize, BodiesCount ), Mask );
+		}
+
+		return Result;
+	}
+
+	/// <summary>Integration of the simulator : chunk by chunk, axis by axis, in place.</summary>
+	void IntegrateArrays( Bodies& _Bodies, Uint32 _StepCount )
+	{
+		for( Uint32 Begin = 0; Begin < BodiesCount; Begin += BodiesPerChunk )
+		{
+			const Uint32 Count = std::min( BodiesPerChunk, BodiesCount - Begin );
+
+			for( Uint32 Axis = 0; Axis < 3; Axis++ )
+			{
+				ae::priv::Integration::IntegrateAxis<PhysicsSettings::IntegrationMethod::EulerAverageVelocity>(
+					_Bodies.Positions[Axis].data() + Begin, _Bodies.PreviousPositions[Axis].data() + Begin, _Bodies.Velocities[Axis].data() + Begin,
+					_Bodies.Accelerations[Axis].data() + Begin, _Bodies.Dampings.data() + Begin, _Bodies.Masks.data() + Begin, Count, _StepCount, TimeStep );
+			}
+		}
+	}
+
+	/// <summary>Reference : each simulated body integrated on its own, all the steps of an axis at once.</summary>
+	void IntegrateScalar( Bodies& _Bodies, Uint32 _StepCount )
+	{
+		for( Uint32 b = 0; b < BodiesCount; b++ )
+		{
+			if( _Bodies.Masks[b] == 0 )
+				continue;
+
+			for( Uint32 Axis = 0; Axis < 3; Axis++ )
+			{
+				float Position = _Bodies.Positions[Axis][b];
+				float PreviousPosition = Position;
+				float Velocity = _Bodies.Velocities[Axis][b];
+
+				for( Uint32 s = 0; s < _StepCount; s++ )
+				{
+					PreviousPosition = Position;
+					ae::priv::Integration::Step<PhysicsSettings::IntegrationMethod::EulerAverageVelocity>(
+						Position, Velocity, _Bodies.Accelerations[Axis][b], _Bodies.Dampings[b], TimeStep, 0.5f );
+				}
+
+				_Bodies.Positions[Axis][b] = Position;
+				_Bodies.PreviousPositions[Axis][b] = PreviousPosition;
+				_Bodies.Velocities[Axis][b] = Velocity;
+			}
+		}
+	}
+
+	/// <summary>Both integrations left the same bits in every array.</summary>
+	Bool IsSame( const Bodies& _A, const Bodies& _B )
+	{
+		for( Uint32 Axis = 0; Axis < 3; Axis++ )
+		{
+			if( std::memcmp( _A.Positions[Axis].data(), _B.Positions[Axis].data(), BodiesCount * sizeof( float ) ) != 0 ||
+				std::memcmp( _A.PreviousPositions[Axis].data(), _B.PreviousPositions[Axis].data(), BodiesCount * sizeof( float ) ) != 0 ||
+				std::memcmp( _A.Velocities[Axis].data(), _B.Velocities[Axis].data(), BodiesCount * sizeof( float ) ) != 0 )
+				return False;
+		}
+
+		return True;
+	}
+
+	/// <summary>Fastest frame of an integration, in nanoseconds.</summary>
+	template<typename IntegrateFunction>
+	double MeasureFastest( Bodies& _Bodies, Uint32 _StepCount, IntegrateFunction _Integrate )
+	{
+		double Fastest = 0.0;
+
+		for( Uint32 f = 0; f < FramesCount; f++ )
+		{
+			const Clock::time_point Start = Clock::now();
+			_Integrate( _Bodies, _StepCount );
+			const double NanoSeconds = GetNanoSecondsSince( Start );
+
+			Fastest = f == 0 ? NanoSeconds : std::min( Fastest, NanoSeconds );
+		}
+
+		return Fastest;
+	}
+
+	/// <summary>Both integrations for a count of steps, returns False if they do not give the same results.</summary>
+	Bool Measure( float _SleepingRatio, Uint32 _StepCount, std::mt19937& _Generator )
+	{
+		const Bodies Start = BuildBodies( _SleepingRatio, _Generator );
+		Bodies Arrays = Start;
+		Bodies Scalar = Start;
+
+		const double ArraysTime = MeasureFastest( Arrays, _StepCount, IntegrateArrays );
+		const double ScalarTime = MeasureFastest( Scalar, _StepCount, IntegrateScalar );
+
+		std::printf( "%3.0f%% asleep, %u steps : SSE masked %.3f ms, scalar %.3f ms\n", _SleepingRatio * 100.0f, _StepCount, ArraysTime / 1000000.0, ScalarTime / 1000000.0 );
+
+		return IsSame( Arrays, Scalar );
+	}
+}
+
+int main()
+{
+	std::mt19937 Generator( Seed );
+
+	std::printf( "%u bodies, fastest of %u frames\n", BodiesCount, FramesCount );
+
+	Bool IsSameResult = True;
+
+	for( Uint32 StepCount : StepCounts )
+		IsSameResult &= Measure( 0.0f, StepCount, Generator );
+
+	IsSameResult &= Measure( 0.9f, 1, Generator );
+
+	if( !IsSameResult )
+		std::printf( "The SSE and scalar integrations do not give the same results.\n" );
+
+	return IsSameResult ? 0 : 1;
+}
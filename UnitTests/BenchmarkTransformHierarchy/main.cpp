@@ -0,0 +1,234 @@
+#include <API/Code/World/TransformHierarchy/TransformHierarchy.h>
+#include <API/Code/Maths/Transform/Transform.h>
+#include <API/Code/Maths/Matrix/MatrixToolbox.h>
+#include <API/Code/Toolbox/JobSystem/JobSystem.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Measures the update of the world matrices of the objects, with a few of them moved each frame in deep random trees.
+// The reference walks up the parents of every object, as the renderer did before the hierarchy : both must give the same matrices.
+// The count of workers can be given as first argument, 0 (the default) for one per core except the main thread one.
+// Returns 0 if the world matrices match the reference, 1 otherwise.
+
+namespace
+{
+	/// <summary>Count of objects with a transform.</summary>
+	constexpr Uint32 ObjectsCount = 100000;
+
+	/// <summary>Count of levels of the trees, the roots included.</summary>
+	constexpr Uint32 LevelsCount = 20;
+
+	/// <summary>Count of objects moved each frame, 1% of them.</summary>
+	constexpr Uint32 MovedCount = ObjectsCount / 100;
+
+	/// <summary>Count of frames of each measure of the hierarchy.</summary>
+	constexpr Uint32 FramesCount = 100;
+
+	/// <summary>Count of frames of each measure of the reference, much slower.</summary>
+	constexpr Uint32 ReferenceFramesCount = 5;
+
+	/// <summary>Largest difference accepted with the reference, relative to the magnitude of the value.</summary>
+	constexpr float Tolerance = 2e-5f;
+
+	/// <summary>Seed of the trees and of the moves.</summary>
+	constexpr Uint32 Seed = 1234;
+
+	/// <summary>Count of repetitions of each measure, the first one warms the caches up.</summary>
+	constexpr Uint32 Repetitions = 3;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>Time elapsed since a tick, in nanoseconds.</summary>
+	double GetNanoSecondsSince( Clock::time_point _Start )
+	{
+		return std::chrono::duration<double, std::nano>( Clock::now() - _Start ).count();
+	}
+
+	/// <summary>Objects of the scene : a transform, an ID and the position of its parent.</summary>
+	struct Scene
+	{
+		std::vector<ae::Transform> Transforms;
+		std::vector<ae::HandlePool::Handle> IDs;
+		std::vector<Uint32> Parents;
+	};
+
+	/// <summary>Invalid parent position : the object is a root.</summary>
+	constexpr Uint32 NoParent = 0xFFFFFFFF;
+
+	/// <summary>Move an object somewhere random, rotated but not scaled so the errors do not grow with the depth.</summary>
+	void MoveRandomly( ae::Transform& _Transform, std::mt19937& _Generator )
+	{
+		std::uniform_real_distribution<float> Position( -10.0f, 10.0f );
+		std::uniform_real_distribution<float> Angle( -180.0f, 180.0f );
+
+		_Transform.SetPosition( Position( _Generator ), Position( _Generator ), Position( _Generator ) );
+		_Transform.SetRotation( Angle( _Generator ), Angle( _Generator ), Angle( _Generator ) );
+	}
+
+	/// <summary>Random trees : each object takes a random parent in the level above its own, the first ones make a full chain.</summary>
+	void BuildScene( AE_Out Scene& _Scene, AE_Out ae::HandlePool& _Pool, std::mt19937& _Generator )
+	{
+		std::uniform_int_distribution<Uint32> LevelDistribution( 0, LevelsCount - 1 );
+		std::vector<std::vector<Uint32>> Levels( LevelsCount );
+
+		_Scene.Transforms.resize( ObjectsCount );
+		_Scene.IDs.resize( ObjectsCount );
+		_Scene.Parents.resize( ObjectsCount );
+
+		for( Uint32 o = 0; o < ObjectsCount; o++ )
+		{
+			const Uint32 Level = o < LevelsCount ? o : LevelDistribution( _Generator );
+
+			if( Level == 0 )
+				_Scene.Parents[o] = NoParent;
+			else
+			{
+				const std::vector<Uint32>& Above = Levels[Level - 1];
+				_Scene.Parents[o] = Above[std::uniform_int_distribution<size_t>( 0, Above.size() - 1 )( _Generator )];
+			}
+
+			Levels[Level].push_back( o );
+
+			_Scene.IDs[o] = _Pool.GenerateHandle();
+			MoveRandomly( _Scene.Transforms[o], _Generator );
+		}
+	}
+
+	/// <summary>The objects are added in a random order : the hierarchy sorts them by depth itself.</summary>
+	void FillHierarchy( Scene& _Scene, AE_Out ae::priv::TransformHierarchy& _Hierarchy, std::mt19937& _Generator )
+	{
+		std::vector<Uint32> Order( ObjectsCount );
+		for( Uint32 o = 0; o < ObjectsCount; o++ )
+			Order[o] = o;
+		std::shuffle( Order.begin(), Order.end(), _Generator );
+
+		for( Uint32 Object : Order )
+		{
+			const Uint32 Parent = _Scene.Parents[Object];
+			_Hierarchy.AddTransform( _Scene.IDs[Object], &_Scene.Transforms[Object], Parent != NoParent ? _Scene.IDs[Parent] : ae::HandlePool::InvalidHandle );
+		}
+	}
+
+	/// <summary>Move a few random objects, as the gameplay does between two updates.</summary>
+	void MoveObjects( Scene& _Scene, ae::priv::TransformHierarchy& _Hierarchy, std::mt19937& _Generator )
+	{
+		std::uniform_int_distribution<Uint32> ObjectDistribution( 0, ObjectsCount - 1 );
+
+		for( Uint32 m = 0; m < MovedCount; m++ )
+		{
+			const Uint32 Object = ObjectDistribution( _Generator );
+
+			MoveRandomly( _Scene.Transforms[Object], _Generator );
+			_Hierarchy.MarkDirty( _Scene.IDs[Object] );
+		}
+	}
+
+	/// <summary>World matrix of an object from its local matrix and the ones of all its parents.</summary>
+	void ComputeByParentWalk( Scene& _Scene, Uint32 _Object, AE_Out ae::Matrix4x4& _World )
+	{
+		_World = _Scene.Transforms[_Object].GetMatrix();
+
+		ae::Matrix4x4 Child;
+		for( Uint32 Parent = _Scene.Parents[_Object]; Parent != NoParent; Parent = _Scene.Parents[Parent] )
+		{
+			Child = _World;
+			ae::priv::MatrixToolbox::Multiply<4, 4, 4>( _World.GetData(), _Scene.Transforms[Parent].GetMatrix().GetData(), Child.GetData() );
+		}
+	}
+
+	/// <summary>The updates of the hierarchy with 1% of the objects moved before each one.</summary>
+	void MeasureUpdate( Scene& _Scene, ae::priv::TransformHierarchy& _Hierarchy, ae::JobSystem& _Jobs, std::mt19937& _Generator )
+	{
+		double NanoSeconds = 0.0;
+
+		for( Uint32 f = 0; f < FramesCount; f++ )
+		{
+			MoveObjects( _Scene, _Hierarchy, _Generator );
+
+			const Clock::time_point Start = Clock::now();
+			_Hierarchy.Update( _Jobs );
+			NanoSeconds += GetNanoSecondsSince( Start );
+		}
+
+		std::printf( "Hierarchy update, %u objects moved : %.2f ms per frame\n", MovedCount, NanoSeconds / FramesCount / 1000000.0 );
+	}
+
+	/// <summary>Every world matrix computed again by walking up the parents.</summary>
+	void MeasureParentWalk( Scene& _Scene )
+	{
+		ae::Matrix4x4 World;
+
+		const Clock::time_point Start = Clock::now();
+
+		for( Uint32 f = 0; f < ReferenceFramesCount; f++ )
+		{
+			for( Uint32 o = 0; o < ObjectsCount; o++ )
+				ComputeByParentWalk( _Scene, o, World );
+		}
+
+		std::printf( "Parent walk of every object : %.2f ms per frame\n", GetNanoSecondsSince( Start ) / ReferenceFramesCount / 1000000.0 );
+	}
+
+	/// <summary>The largest difference between the world matrices of the hierarchy and the reference, relative to the values.</summary>
+	float GetLargestError( Scene& _Scene, ae::priv::TransformHierarchy& _Hierarchy, ae::JobSystem& _Jobs )
+	{
+		ae::Matrix4x4 Expected;
+		float LargestError = 0.0f;
+
+		for( Uint32 o = 0; o < ObjectsCount; o++ )
+		{
+			ComputeByParentWalk( _Scene, o, Expected );
+			const ae::Matrix4x4& World = _Hierarchy.GetWorldMatrix( _Scene.IDs[o], _Jobs );
+
+			for( Uint32 e = 0; e < 16; e++ )
+			{
+				const float Error = std::fabs( World( e ) - Expected( e ) ) / std::max( 1.0f, std::fabs( Expected( e ) ) );
+				LargestError = std::max( LargestError, Error );
+			}
+		}
+
+		return LargestError;
+	}
+}
+
+int main( int _ArgumentsCount, char** _Arguments )
+{
+	const Uint32 WorkersCount = _ArgumentsCount > 1 ? Cast( Uint32, std::atoi( _Arguments[1] ) ) : 0;
+
+	ae::JobSystem Jobs( WorkersCount );
+	std::mt19937 Generator( Seed );
+
+	Scene Objects;
+	ae::HandlePool Pool;
+	ae::priv::TransformHierarchy Hierarchy;
+
+	BuildScene( Objects, Pool, Generator );
+	FillHierarchy( Objects, Hierarchy, Generator );
+	Hierarchy.Update( Jobs );
+
+	std::printf( "%u workers, %u objects in %u levels\n", Jobs.GetWorkersCount(), Hierarchy.GetCount(), Hierarchy.GetLevelCount() );
+
+	for( Uint32 r = 0; r < Repetitions; r++ )
+	{
+		std::printf( "Run %u :\n", r + 1 );
+
+		MeasureUpdate( Objects, Hierarchy, Jobs, Generator );
+		MeasureParentWalk( Objects );
+	}
+
+	const float LargestError = GetLargestError( Objects, Hierarchy, Jobs );
+	const Bool IsMatching = Hierarchy.GetLevelCount() == LevelsCount && LargestError <= Tolerance;
+
+	std::printf( "Largest relative difference with the parent walk : %g\n", LargestError );
+
+	if( !IsMatching )
+		std::printf( "The world matrices do not match the reference.\n" );
+
+	return IsMatching ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+#include <API/Code/Toolbox/HandlePool/HandlePool.h>
+#include <API/Code/Toolbox/HandleMap/HandleMap.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Measures the registries of the world objects : the hash map of pointers it used before against the dense handle map of pointers.
+// Both registries are built by the same creations and destructions, and point to the same objects allocated on the heap one by one.
+// Returns 0 if both registries hold and find the same objects, 1 otherwise.
+
+namespace
+{
+	/// <summary>Counts of live entries of the measures.</summary>
+	constexpr Uint32 EntriesCounts[] = { 10000, 100000, 1000000 };
+
+	/// <summary>Count of entries looked up by their ID in each measure of the finds.</summary>
+	constexpr Uint32 FindsCount = 10000;
+
+	/// <summary>Count of entries walked by each measure : the small registries are walked several times.</summary>
+	constexpr Uint32 WalkedEntriesCount = 10000000;
+
+	/// <summary>Seed of the destructions and of the finds.</summary>
+	constexpr Uint32 Seed = 1234;
+
+	/// <summary>Count of repetitions of each measure, the first one warms the caches up.</summary>
+	constexpr Uint32 Repetitions = 3;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>Time elapsed since a tick, in nanoseconds.</summary>
+	double GetNanoSecondsSince( Clock::time_point _Start )
+	{
+		return std::chrono::duration<double, std::nano>( Clock::now() - _Start ).count();
+	}
+
+	/// <summary>An object of the world, about the size of a physic object state.</summary>
+	struct Object
+	{
+		ae::HandlePool::Handle ID;
+		float Position[3];
+		float Velocity[3];
+		float Padding[25];
+	};
+
+	using ObjectID = ae::HandlePool::Handle;
+
+	/// <summary>The two registries and the objects they point to.</summary>
+	struct Registries
+	{
+		ae::HandlePool Pool;
+		std::unordered_map<ObjectID, Object*> Map;
+		ae::HandleMap<Object*> Dense;
+		std::vector<std::unique_ptr<Object>> Objects;
+	};
+
+	/// <summary>1.5 times the entries created, then a third of them destroyed in a random order.</summary>
+	void Build( Uint32 _EntriesCount, AE_Out Registries& _Registries, std::mt19937& _Generator )
+	{
+		const Uint32 CreationsCount = _EntriesCount + _EntriesCount / 2;
+
+		std::vector<ObjectID> IDs;
+		IDs.reserve( CreationsCount );
+
+		for( Uint32 c = 0; c < CreationsCount; c++ )
+		{
+			std::unique_ptr<Object> NewObject( new Object() );
+			NewObject->ID = _Registries.Pool.GenerateHandle();
+			NewObject->Velocity[0] = 1.0f;
+
+			_Registries.Map.emplace( NewObject->ID, NewObject.get() );
+			_Registries.Dense.Insert( NewObject->ID, NewObject.get() );
+			IDs.push_back( NewObject->ID );
+
+			const Uint32 Slot = ae::HandlePool::GetIndex( NewObject->ID );
+			if( Slot >= _Registries.Objects.size() )
+				_Registries.Objects.resize( Slot + 1 );
+			_Registries.Objects[Slot] = std::move( NewObject );
+		}
+
+		std::shuffle( IDs.begin(), IDs.end(), _Generator );
+
+		for( Uint32 d = 0; d < CreationsCount - _EntriesCount; d++ )
+		{
+			const ObjectID ID = IDs[d];
+
+			_Registries.Map.erase( ID );
+			_Registries.Dense.Remove( ID );
+			_Registries.Pool.FreeHandle( ID );
+			_Registries.Objects[ae::HandlePool::GetIndex( ID )].reset();
+		}
+	}
+
+	/// <summary>Sum of the low bytes of the pointers walked, without reading the objects : the same for both registries whatever their order.</summary>
+	Uint64 WalkMap( const Registries& _Registries )
+	{
+		Uint64 Sum = 0;
+		for( const std::pair<const ObjectID, Object*>& Entry : _Registries.Map )
+			Sum += reinterpret_cast<uintptr_t>( Entry.second ) & 0xFF;
+
+		return Sum;
+	}
+
+	Uint64 WalkDense( const Registries& _Registries )
+	{
+		Uint64 Sum = 0;
+		for( Object* Entry : _Registries.Dense )
+			Sum += reinterpret_cast<uintptr_t>( Entry ) & 0xFF;
+
+		return Sum;
+	}
+
+	/// <summary>Move each object, as the physics update does.</summary>
+	void UpdateMap( Registries& _Registries )
+	{
+		for( std::pair<const ObjectID, Object*>& Entry : _Registries.Map )
+			Entry.second->Position[0] += Entry.second->Velocity[0];
+	}
+
+	void UpdateDense( Registries& _Registries )
+	{
+		for( Object* Entry : _Registries.Dense )
+			Entry->Position[0] += Entry->Velocity[0];
+	}
+
+	/// <summary>Sum of the IDs of the objects found, as the editor or the gameplay get them.</summary>
+	Uint64 FindInMap( const Registries& _Registries, const std::vector<ObjectID>& _IDs )
+	{
+		Uint64 Sum = 0;
+		for( ObjectID ID : _IDs )
+		{
+			std::unordered_map<ObjectID, Object*>::const_iterator itObject = _Registries.Map.find( ID );
+			Sum += itObject != _Registries.Map.cend() ? itObject->second->ID : 0;
+		}
+
+		return Sum;
+	}
+
+	Uint64 FindInDense( const Registries& _Registries, const std::vector<ObjectID>& _IDs )
+	{
+		Uint64 Sum = 0;
+		for( ObjectID ID : _IDs )
+		{
+			Object* const* Found = _Registries.Dense.Find( ID );
+			Sum += Found != nullptr ? ( *Found )->ID : 0;
+		}
+
+		return Sum;
+	}
+
+	/// <summary>Time of a function called several times, in nanoseconds per call.</summary>
+	template<typename Function>
+	double Time( Uint32 _CallsCount, Function _Function )
+	{
+		const Clock::time_point Start = Clock::now();
+
+		for( Uint32 c = 0; c < _CallsCount; c++ )
+			_Function();
+
+		return GetNanoSecondsSince( Start ) / _CallsCount;
+	}
+
+	/// <summary>Print a duration in the unit that fits it.</summary>
+	void PrintDuration( double _NanoSeconds )
+	{
+		if( _NanoSeconds >= 1000000.0 )
+			std::printf( " %8.2f ms", _NanoSeconds / 1000000.0 );
+		else
+			std::printf( " %8.1f us", _NanoSeconds / 1000.0 );
+	}
+
+	/// <summary>Walks, updates and finds in both registries, returns False if they do not hold the same objects.</summary>
+	Bool Measure( Uint32 _EntriesCount, std::mt19937& _Generator )
+	{
+		Registries Scene;
+		Build( _EntriesCount, Scene, _Generator );
+
+		// IDs of live objects only : every find succeeds.
+		std::vector<ObjectID> IDs;
+		const std::vector<ObjectID>& Handles = Scene.Dense.GetHandles();
+		std::uniform_int_distribution<size_t> Distribution( 0, Handles.size() - 1 );
+		for( Uint32 f = 0; f < FindsCount; f++ )
+			IDs.push_back( Handles[Distribution( _Generator )] );
+
+		const Uint32 WalksCount = std::max( 1u, WalkedEntriesCount / _EntriesCount );
+
+		Uint64 MapSum = 0;
+		Uint64 DenseSum = 0;
+
+		const double MapWalk = Time( WalksCount, [&]() { MapSum = WalkMap( Scene ); } );
+		const double DenseWalk = Time( WalksCount, [&]() { DenseSum = WalkDense( Scene ); } );
+		Bool IsSame = MapSum == DenseSum;
+
+		const double MapUpdate = Time( WalksCount, [&]() { UpdateMap( Scene ); } );
+		const double DenseUpdate = Time( WalksCount, [&]() { UpdateDense( Scene ); } );
+
+		const double MapFinds = Time( Repetitions, [&]() { MapSum = FindInMap( Scene, IDs ); } );
+		const double DenseFinds = Time( Repetitions, [&]() { DenseSum = FindInDense( Scene, IDs ); } );
+		IsSame &= MapSum == DenseSum;
+
+		IsSame &= Scene.Map.size() == _EntriesCount && Scene.Dense.GetCount() == _EntriesCount;
+
+		std::printf( "%8u", _EntriesCount );
+		PrintDuration( MapWalk );
+		PrintDuration( DenseWalk );
+		PrintDuration( MapUpdate );
+		PrintDuration( DenseUpdate );
+		PrintDuration( MapFinds );
+		PrintDuration( DenseFinds );
+		std::printf( "\n" );
+
+		return IsSame;
+	}
+}
+
+int main()
+{
+	std::mt19937 Generator( Seed );
+
+	Bool IsSame = True;
+
+	for( Uint32 r = 0; r < Repetitions; r++ )
+	{
+		std::printf( "Run %u :\n", r + 1 );
+		std::printf( " entries    map walk  dense walk  map update dense update  map finds dense finds\n" );
+
+		for( Uint32 EntriesCount : EntriesCounts )
+			IsSame &= Measure( EntriesCount, Generator );
+	}
+
+	if( !IsSame )
+		std::printf( "The registries do not hold the same objects.\n" );
+
+	return IsSame ? 0 : 1;
+}
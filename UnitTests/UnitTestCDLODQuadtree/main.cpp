@@ -0,0 +1,310 @@
+#include "../../Snow/Code/CDLODQuadtree.h"
+
+#include <API/Code/Maths/Functions/MathsFunctions.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// Checks the chunks selection of the CDLOD quadtree, without OpenGL context :
+// - without culling, the selected chunks cover the whole ground exactly once, wherever the camera is,
+// - with culling, the chunks out of the frustum are rejected and the others are the same as without culling,
+// - each chunk is in the range of its level : out of the range of the finer level, its parent in the range of its level,
+// - at known heights of the camera above a flat ground, the finest level selected is the expected one,
+// - the triangles count of the tessellation path matches the OpenGL equal spacing.
+// Returns 0 if every check passed, 1 otherwise.
+
+using ae::Vector3;
+
+namespace
+{
+	/// <summary>Tolerance on the coverage areas, the chunk sizes being powers of two of the ground size.</summary>
+	constexpr float AreaTolerance = 1e-4f;
+
+	/// <summary>Checks run and checks failed, the failures are printed.</summary>
+	struct Report
+	{
+		Uint32 ChecksCount = 0;
+		Uint32 FailuresCount = 0;
+
+		void Check( Bool _Condition, const char* _Description )
+		{
+			ChecksCount++;
+
+			if( _Condition )
+				return;
+
+			FailuresCount++;
+			std::printf( "FAILED : %s\n", _Description );
+		}
+	};
+
+	/// <summary>Bounds of a chunk, or of its parent, as the quadtree computes them.</summary>
+	ae::AABB GetBounds( const CDLODQuadtree& _Quadtree, float _X, float _Z, float _Size )
+	{
+		const CDLODQuadtree::Settings& Settings = _Quadtree.GetSettings();
+		const float HalfSize = _Size * 0.5f;
+
+		return ae::AABB( Vector3( _X - HalfSize, Settings.MinHeight, _Z - HalfSize ), Vector3( _X + HalfSize, Settings.MaxHeight, _Z + HalfSize ) );
+	}
+
+	/// <summary>Distance from a point to a box, 0 inside.</summary>
+	float GetDistance( const ae::AABB& _Box, const Vector3& _Point )
+	{
+		const Vector3& Min = _Box.GetMin();
+		const Vector3& Max = _Box.GetMax();
+		const Vector3 Closest( ae::Math::Clamp( Min.X, Max.X, _Point.X ), ae::Math::Clamp( Min.Y, Max.Y, _Point.Y ), ae::Math::Clamp( Min.Z, Max.Z, _Point.Z ) );
+
+		return ( Closest - _Point ).Length();
+	}
+
+	/// <summary>Frustum of a camera looking at a point of the ground.</summary>
+	ae::Frustum GetFrustum( const Vector3& _Eye, const Vector3& _Target, const Vector3& _Up = Vector3::AxeY )
+	{
+		const ae::Matrix4x4 Projection = ae::Matrix4x4::GetPerspectiveMatrix( ae::Math::DegToRad( 60.0f ), 16.0f / 9.0f, 0.01f, 100.0f );
+
+		return ae::Frustum( Projection * ae::Matrix4x4::GetLookAtMatrix( _Eye, _Target, _Up ) );
+	}
+
+	/// <summary>The chunks are inside the ground, cover its area and do not overlap each other.</summary>
+	Bool IsCoverageExact( const CDLODQuadtree& _Quadtree, const CDLODQuadtree::ChunkArray& _Chunks )
+	{
+		const float GroundHalfSize = _Quadtree.GetSettings().Size * 0.5f;
+		float Area = 0.0f;
+
+		for( size_t i = 0; i < _Chunks.size(); i++ )
+		{
+			const CDLODQuadtree::Chunk& A = _Chunks[i];
+			const float HalfA = A.Size * 0.5f;
+
+			if( A.X - HalfA < -GroundHalfSize || A.X + HalfA > GroundHalfSize || A.Z - HalfA < -GroundHalfSize || A.Z + HalfA > GroundHalfSize )
+				return False;
+
+			if( A.Size != _Quadtree.GetChunkSize( A.Level ) )
+				return False;
+
+			Area += A.Size * A.Size;
+
+			for( size_t j = i + 1; j < _Chunks.size(); j++ )
+			{
+				const CDLODQuadtree::Chunk& B = _Chunks[j];
+				const float HalfSum = HalfA + B.Size * 0.5f;
+
+				// Squares touching by an edge are fine, their interiors must be disjoint.
+				if( ae::Math::Abs( A.X - B.X ) < HalfSum && ae::Math::Abs( A.Z - B.Z ) < HalfSum )
+					return False;
+			}
+		}
+
+		const float GroundArea = GroundHalfSize * GroundHalfSize * 4.0f;
+
+		return ae::Math::Abs( Area - GroundArea ) <= GroundArea * AreaTolerance;
+	}
+
+	/// <summary>
+	/// Each chunk is out of the range of the finer level, otherwise it would have been split,
+	/// and its parent is in the range of the chunk level, otherwise the parent would have been selected.
+	/// </summary>
+	Bool AreRangesRespected( const CDLODQuadtree& _Quadtree, const CDLODQuadtree::ChunkArray& _Chunks, const Vector3& _CameraPosition )
+	{
+		const CDLODQuadtree::Settings& Settings = _Quadtree.GetSettings();
+
+		for( const CDLODQuadtree::Chunk& Chunk : _Chunks )
+		{
+			if( Chunk.Level > 0 && GetDistance( GetBounds( _Quadtree, Chunk.X, Chunk.Z, Chunk.Size ), _CameraPosition ) <= _Quadtree.GetLodRange( Chunk.Level - 1 ) )
+				return False;
+
+			if( Chunk.Level + 1 >= Settings.LevelsCount )
+				continue;
+
+			// The parent node is the one of the next level holding the chunk.
+			const float ParentSize = Chunk.Size * 2.0f;
+			const float GroundOrigin = -Settings.Size * 0.5f;
+			const float ParentX = GroundOrigin + ( ae::Math::Floor( ( Chunk.X - GroundOrigin ) / ParentSize ) + 0.5f ) * ParentSize;
+			const float ParentZ = GroundOrigin + ( ae::Math::Floor( ( Chunk.Z - GroundOrigin ) / ParentSize ) + 0.5f ) * ParentSize;
+
+			if( GetDistance( GetBounds( _Quadtree, ParentX, ParentZ, ParentSize ), _CameraPosition ) > _Quadtree.GetLodRange( Chunk.Level ) )
+				return False;
+		}
+
+		return True;
+	}
+
+	Uint32 GetFinestLevel( const CDLODQuadtree::ChunkArray& _Chunks )
+	{
+		Uint32 Level = ~0u;
+		for( const CDLODQuadtree::Chunk& Chunk : _Chunks )
+			Level = ae::Math::Min( Level, Chunk.Level );
+
+		return Level;
+	}
+
+	Bool IsSelected( const CDLODQuadtree::ChunkArray& _Chunks, const CDLODQuadtree::Chunk& _Chunk )
+	{
+		return std::find_if( _Chunks.begin(), _Chunks.end(), [&_Chunk]( const CDLODQuadtree::Chunk& _Other )
+		{
+			return _Other.X == _Chunk.X && _Other.Z == _Chunk.Z && _Other.Level == _Chunk.Level;
+		} ) != _Chunks.end();
+	}
+
+	void CheckCoverage( CDLODQuadtree& _Quadtree, AE_InOut Report& _Report )
+	{
+		_Quadtree.SetSettings( CDLODQuadtree::Settings() );
+
+		const ae::Frustum Unused;
+		const float HalfSize = _Quadtree.GetSettings().Size * 0.5f;
+
+		// Above the center, on a corner, on an edge, outside of the ground, and far away.
+		const std::vector<Vector3> Cameras =
+		{
+			Vector3( 0.0f, 0.5f, 0.0f ),
+			Vector3( HalfSize, 0.2f, HalfSize ),
+			Vector3( -HalfSize, 0.8f, 0.3f ),
+			Vector3( HalfSize * 1.5f, 0.5f, -HalfSize * 0.5f ),
+			Vector3( 0.3f, 0.1f, -0.7f ),
+			Vector3( 0.0f, 1000.0f, 0.0f )
+		};
+
+		CDLODQuadtree::ChunkArray Chunks;
+		for( const Vector3& Camera : Cameras )
+		{
+			_Quadtree.Select( Camera, Unused, Chunks, False );
+
+			_Report.Check( IsCoverageExact( _Quadtree, Chunks ), "no culling : the chunks cover the ground without overlap" );
+			_Report.Check( AreRangesRespected( _Quadtree, Chunks, Camera ), "no culling : each chunk is in the range of its level" );
+		}
+
+		// Finest levels near the camera, the root alone far away.
+		_Quadtree.Select( Vector3( 0.0f, 0.5f, 0.0f ), Unused, Chunks, False );
+		_Report.Check( GetFinestLevel( Chunks ) == 0, "camera on the ground : the finest level is selected" );
+
+		_Quadtree.Select( Vector3( 0.0f, 1000.0f, 0.0f ), Unused, Chunks, False );
+		_Report.Check( Chunks.size() == 1 && Chunks[0].Level == _Quadtree.GetSettings().LevelsCount - 1, "camera far away : only the root is selected" );
+	}
+
+	void CheckCulling( CDLODQuadtree& _Quadtree, AE_InOut Report& _Report )
+	{
+		_Quadtree.SetSettings( CDLODQuadtree::Settings() );
+
+		const float HalfSize = _Quadtree.GetSettings().Size * 0.5f;
+		CDLODQuadtree::ChunkArray All;
+		CDLODQuadtree::ChunkArray Culled;
+
+		// Above the center of the ground, looking toward an edge : the half of the ground behind the camera is out of the frustum.
+		const Vector3 Center( 0.0f, 0.5f, 0.0f );
+		const ae::Frustum Frustum = GetFrustum( Center, Vector3( HalfSize, 0.0f, 0.0f ) );
+
+		_Quadtree.Select( Center, Frustum, All, False );
+		_Quadtree.Select( Center, Frustum, Culled, True );
+
+		Bool AreAllVisible = True;
+		Bool AreVisibleKept = True;
+		Uint32 RejectedCount = 0;
+
+		for( const CDLODQuadtree::Chunk& Chunk : Culled )
+			AreAllVisible &= Frustum.Intersects( GetBounds( _Quadtree, Chunk.X, Chunk.Z, Chunk.Size ) );
+
+		// A node holding a visible chunk is visible too : culling only removes chunks, it never changes the levels of the others.
+		for( const CDLODQuadtree::Chunk& Chunk : All )
+		{
+			if( Frustum.Intersects( GetBounds( _Quadtree, Chunk.X, Chunk.Z, Chunk.Size ) ) )
+				AreVisibleKept &= IsSelected( Culled, Chunk );
+			else
+				RejectedCount++;
+		}
+
+		_Report.Check( AreAllVisible, "culling : every selected chunk intersects the frustum" );
+		_Report.Check( AreVisibleKept, "culling : every chunk intersecting the frustum is kept, at the same level" );
+		_Report.Check( RejectedCount > 0 && Culled.size() + RejectedCount == All.size(), "culling : the chunks out of the frustum are rejected" );
+
+		// Above the highest point of the ground, looking at the sky.
+		const Vector3 Above( 0.0f, _Quadtree.GetSettings().MaxHeight + 1.0f, 0.0f );
+		_Quadtree.Select( Above, GetFrustum( Above, Above + Vector3::AxeY, Vector3::AxeZ ), Culled, True );
+		_Report.Check( Culled.empty(), "culling : no chunk when looking away from the ground" );
+
+		// Outside of the ground, looking away from it.
+		const Vector3 Outside( HalfSize * 2.0f, 0.5f, 0.0f );
+		_Quadtree.Select( Outside, GetFrustum( Outside, Outside + Vector3::AxeX ), Culled, True );
+		_Report.Check( Culled.empty(), "culling : no chunk behind the camera" );
+	}
+
+	void CheckLevelsAtKnownDistances( CDLODQuadtree& _Quadtree, AE_InOut Report& _Report )
+	{
+		// A flat ground : the distance from a camera above the center to the nearest chunk is its height.
+		CDLODQuadtree::Settings Settings;
+		Settings.Size = 16.0f;
+		Settings.LevelsCount = 5;
+		Settings.GridResolution = 16;
+		Settings.LodBaseDistance = 2.0f;
+		Settings.MinHeight = 0.0f;
+		Settings.MaxHeight = 0.0f;
+		_Quadtree.SetSettings( Settings );
+
+		_Report.Check( _Quadtree.GetLodRange( 0 ) == 2.0f && _Quadtree.GetLodRange( 3 ) == 16.0f, "known distances : the ranges double for each level" );
+		_Report.Check( _Quadtree.GetChunkSize( 0 ) == 1.0f && _Quadtree.GetChunkSize( 4 ) == 16.0f, "known distances : the chunks sizes double for each level" );
+
+		const ae::Frustum Unused;
+		CDLODQuadtree::ChunkArray Chunks;
+
+		// The finest level under the camera is the first one whose range reaches the ground : ranges 2, 4, 8, 16.
+		const struct { float Height; Uint32 FinestLevel; } Expectations[] =
+		{
+			{ 0.5f, 0 }, { 1.9f, 0 }, { 2.1f, 1 }, { 3.9f, 1 }, { 4.1f, 2 }, { 7.9f, 2 }, { 8.1f, 3 }, { 15.9f, 3 }, { 16.1f, 4 }
+		};
+
+		for( const auto& Expectation : Expectations )
+		{
+			const Vector3 Camera( 0.0f, Expectation.Height, 0.0f );
+			_Quadtree.Select( Camera, Unused, Chunks, False );
+
+			_Report.Check( GetFinestLevel( Chunks ) == Expectation.FinestLevel, "known distances : the finest level under the camera" );
+			_Report.Check( AreRangesRespected( _Quadtree, Chunks, Camera ), "known distances : each chunk is in the range of its level" );
+			_Report.Check( IsCoverageExact( _Quadtree, Chunks ), "known distances : the chunks cover the ground without overlap" );
+		}
+
+		// Above the center at the height 1, the level 0 covers the chunks up to 2 away : the 4 x 4 chunks around the center.
+		_Quadtree.Select( Vector3( 0.0f, 1.0f, 0.0f ), Unused, Chunks, False );
+		const size_t FinestCount = std::count_if( Chunks.begin(), Chunks.end(), []( const CDLODQuadtree::Chunk& _Chunk ) { return _Chunk.Level == 0; } );
+		_Report.Check( FinestCount == 16, "known distances : the 4 x 4 finest chunks around the camera" );
+
+		_Report.Check( _Quadtree.GetTrianglesCount( Chunks ) == 2ull * 16 * 16 * Chunks.size(), "known distances : two triangles per quad of each chunk" );
+	}
+
+	void CheckTessellatedTriangles( AE_InOut Report& _Report )
+	{
+		_Report.Check( CDLODQuadtree::GetTessellatedTrianglesCount( 1.0f ) == 1, "tessellation : the level 1 keeps the triangle" );
+		_Report.Check( CDLODQuadtree::GetTessellatedTrianglesCount( 2.0f ) == 6, "tessellation : the level 2 gives 6 triangles" );
+		_Report.Check( CDLODQuadtree::GetTessellatedTrianglesCount( 3.0f ) == 13, "tessellation : the level 3 gives 13 triangles" );
+		_Report.Check( CDLODQuadtree::GetTessellatedTrianglesCount( 4.0f ) == 24, "tessellation : the level 4 gives 24 triangles" );
+
+		// Equal spacing rounds the levels up, in [1, 64].
+		_Report.Check( CDLODQuadtree::GetTessellatedTrianglesCount( 1.5f ) == 6, "tessellation : a fractional level is rounded up" );
+		_Report.Check( CDLODQuadtree::GetTessellatedTrianglesCount( 0.2f ) == 1, "tessellation : a level under 1 is clamped" );
+		_Report.Check( CDLODQuadtree::GetTessellatedTrianglesCount( 100.0f ) == CDLODQuadtree::GetTessellatedTrianglesCount( 64.0f ), "tessellation : a level over 64 is clamped" );
+
+		// The concentric rings add up to 3n^2 / 2 triangles for an even level n, ( 3n^2 - 1 ) / 2 for an odd one.
+		Bool IsClosedFormMatched = True;
+		for( Uint64 Level = 1; Level <= 64; Level++ )
+		{
+			const Uint64 Expected = ( 3 * Level * Level - ( Level & 1 ) ) / 2;
+			IsClosedFormMatched &= CDLODQuadtree::GetTessellatedTrianglesCount( Cast( float, Level ) ) == Expected;
+		}
+
+		_Report.Check( IsClosedFormMatched, "tessellation : every level from 1 to 64" );
+	}
+}
+
+int main()
+{
+	CDLODQuadtree Quadtree;
+	Report Result;
+
+	CheckCoverage( Quadtree, Result );
+	CheckCulling( Quadtree, Result );
+	CheckLevelsAtKnownDistances( Quadtree, Result );
+	CheckTessellatedTriangles( Result );
+
+	std::printf( "%u checks, %u failed\n", Result.ChecksCount, Result.FailuresCount );
+
+	return Result.FailuresCount == 0 ? 0 : 1;
+}
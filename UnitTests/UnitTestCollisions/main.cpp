@@ -0,0 +1,367 @@
+#include <API/Code/Physics/Broadphase/BroadphasePairs.h>
+#include <API/Code/Physics/Collider/SphereCollider.h>
+#include <API/Code/Physics/Collider/BoxCollider.h>
+#include <API/Code/Physics/Collider/CapsuleCollider.h>
+#include <API/Code/Physics/Collider/MeshCollider.h>
+#include <API/Code/Physics/HitResult/HitResult.h>
+#include <API/Code/Toolbox/JobSystem/JobSystem.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Checks the collisions of the physics simulator, CPU only :
+// - the pairs of the broadphase, with spheres bouncing in a box over several steps per frame, some of them removed for a few frames then added back :
+//   after the update of each frame the pairs are exactly the overlapping enlarged boxes found by brute force,
+//   after each step every pair of overlapping spheres is in the pairs, and the removed proxies are reused,
+// - the contacts between the colliders (sphere, box, capsule and the triangles of a mesh) give the expected normal and depth,
+//   the opposite normal and the same depth when the colliders are swapped, and no contact when they are apart.
+// Returns 0 if every check passed, 1 otherwise.
+
+using ae::Vector3;
+using ae::AABB;
+using ae::priv::BroadphasePairs;
+
+namespace
+{
+	/// <summary>Count of spheres bouncing in the box.</summary>
+	constexpr Uint32 SpheresCount = 400;
+
+	/// <summary>Radius of the spheres.</summary>
+	constexpr float SphereRadius = 0.1f;
+
+	/// <summary>Size of the box the spheres bounce in, small enough for them to meet often.</summary>
+	constexpr float BoxSize = 3.0f;
+
+	/// <summary>Margin of the proxies, the one of the collision solver.</summary>
+	constexpr float ProxyMargin = 0.05f;
+
+	/// <summary>Count of frames simulated.</summary>
+	constexpr Uint32 FramesCount = 120;
+
+	/// <summary>Count of steps per frame.</summary>
+	constexpr Uint32 StepsPerFrame = 4;
+
+	/// <summary>Duration of a step, 60 steps per second.</summary>
+	constexpr float TimeStep = 1.0f / 60.0f;
+
+	/// <summary>Count of frames the removed spheres stay out of the broadphase.</summary>
+	constexpr Uint32 RemovalPeriod = 10;
+
+	/// <summary>Count of spheres removed at once.</summary>
+	constexpr Uint32 RemovedCount = 20;
+
+	/// <summary>Largest difference accepted on the normals and the depths of the contacts.</summary>
+	constexpr float Tolerance = 1e-3f;
+
+	/// <summary>Seed of the spheres and of the replacements.</summary>
+	constexpr Uint32 Seed = 1234;
+
+	/// <summary>Checks run and checks failed, the failures are printed.</summary>
+	struct Report
+	{
+		Uint32 ChecksCount = 0;
+		Uint32 FailuresCount = 0;
+
+		void Check( Bool _Condition, const char* _Description )
+		{
+			ChecksCount++;
+
+			if( _Condition )
+				return;
+
+			FailuresCount++;
+			std::printf( "FAILED : %s\n", _Description );
+		}
+	};
+
+	/// <summary>Spheres bouncing in the box, each one a proxy of the broadphase.</summary>
+	struct Spheres
+	{
+		std::vector<Vector3> Positions;
+		std::vector<Vector3> Velocities;
+		std::vector<Uint32> Proxies;
+	};
+
+	/// <summary>Proxy of the spheres removed from the broadphase.</summary>
+	constexpr Uint32 NoProxy = ae::priv::DynamicAABBTree::InvalidProxy;
+
+	/// <summary>Box of a sphere.</summary>
+	AABB GetBounds( const Vector3& _Position )
+	{
+		return AABB( _Position - SphereRadius, _Position + SphereRadius );
+	}
+
+	/// <summary>Place a sphere somewhere random in the box, going in a random direction.</summary>
+	void PlaceRandomly( Spheres& _Spheres, Uint32 _Sphere, std::mt19937& _Generator )
+	{
+		std::uniform_real_distribution<float> Position( SphereRadius, BoxSize - SphereRadius );
+		std::uniform_real_distribution<float> Velocity( -2.0f, 2.0f );
+
+		_Spheres.Positions[_Sphere] = Vector3( Position( _Generator ), Position( _Generator ), Position( _Generator ) );
+		_Spheres.Velocities[_Sphere] = Vector3( Velocity( _Generator ), Velocity( _Generator ), Velocity( _Generator ) );
+	}
+
+	/// <summary>Move the spheres of a step, they bounce on the walls of the box.</summary>
+	void MoveSpheres( Spheres& _Spheres )
+	{
+		for( Uint32 s = 0; s < SpheresCount; s++ )
+		{
+			Vector3& Position = _Spheres.Positions[s];
+			Vector3& Velocity = _Spheres.Velocities[s];
+
+			Position += Velocity * TimeStep;
+
+			for( Uint32 Axis = 0; Axis < 3; Axis++ )
+			{
+				if( ( Position[Axis] < SphereRadius && Velocity[Axis] < 0.0f ) || ( Position[Axis] > BoxSize - SphereRadius && Velocity[Axis] > 0.0f ) )
+					Velocity[Axis] = -Velocity[Axis];
+			}
+		}
+	}
+
+	/// <summary>Move the proxies of the spheres out of their enlarged box, stretched by their move over the frame, as the collision solver does.</summary>
+	void MoveProxies( const Spheres& _Spheres, BroadphasePairs& _Broadphase )
+	{
+		for( Uint32 s = 0; s < SpheresCount; s++ )
+		{
+			if( _Spheres.Proxies[s] != NoProxy )
+				_Broadphase.MoveProxy( _Spheres.Proxies[s], GetBounds( _Spheres.Positions[s] ), _Spheres.Velocities[s] * ( TimeStep * StepsPerFrame ) );
+		}
+	}
+
+	/// <summary>Pairs of proxies whose enlarged boxes overlap, every proxy tested against every other one.</summary>
+	std::vector<Uint64> FindPairsByBruteForce( const Spheres& _Spheres, const BroadphasePairs& _Broadphase )
+	{
+		std::vector<Uint64> Pairs;
+
+		for( Uint32 a = 0; a < SpheresCount; a++ )
+		{
+			for( Uint32 b = a + 1; b < SpheresCount; b++ )
+			{
+				const Uint32 ProxyA = _Spheres.Proxies[a];
+				const Uint32 ProxyB = _Spheres.Proxies[b];
+
+				if( ProxyA != NoProxy && ProxyB != NoProxy && _Broadphase.GetFatBounds( ProxyA ).Intersects( _Broadphase.GetFatBounds( ProxyB ) ) )
+					Pairs.push_back( BroadphasePairs::MakePair( ProxyA, ProxyB ) );
+			}
+		}
+
+		std::sort( Pairs.begin(), Pairs.end() );
+		return Pairs;
+	}
+
+	/// <summary>Are all the pairs of overlapping spheres in the pairs of the broadphase ? The narrowphase only tests these.</summary>
+	Bool HasOverlappingPairs( const Spheres& _Spheres, const BroadphasePairs& _Broadphase )
+	{
+		const std::vector<Uint64>& Pairs = _Broadphase.GetPairs();
+
+		for( Uint32 a = 0; a < SpheresCount; a++ )
+		{
+			for( Uint32 b = a + 1; b < SpheresCount; b++ )
+			{
+				if( _Spheres.Proxies[a] == NoProxy || _Spheres.Proxies[b] == NoProxy || !GetBounds( _Spheres.Positions[a] ).Intersects( GetBounds( _Spheres.Positions[b] ) ) )
+					continue;
+
+				if( !std::binary_search( Pairs.cbegin(), Pairs.cend(), BroadphasePairs::MakePair( _Spheres.Proxies[a], _Spheres.Proxies[b] ) ) )
+					return False;
+			}
+		}
+
+		return True;
+	}
+
+	/// <summary>Remove random spheres from the broadphase, their pairs stay until the next update.</summary>
+	void RemoveSpheres( Spheres& _Spheres, BroadphasePairs& _Broadphase, AE_Out std::vector<Uint32>& _OutRemoved, AE_Out std::vector<Uint32>& _OutFreedProxies, std::mt19937& _Generator )
+	{
+		std::vector<Uint32> Order( SpheresCount );
+		for( Uint32 s = 0; s < SpheresCount; s++ )
+			Order[s] = s;
+		std::shuffle( Order.begin(), Order.end(), _Generator );
+
+		_OutRemoved.assign( Order.cbegin(), Order.cbegin() + RemovedCount );
+		_OutFreedProxies.clear();
+
+		for( Uint32 Sphere : _OutRemoved )
+		{
+			_OutFreedProxies.push_back( _Spheres.Proxies[Sphere] );
+			_Broadphase.DestroyProxy( _Spheres.Proxies[Sphere] );
+			_Spheres.Proxies[Sphere] = NoProxy;
+		}
+	}
+
+	/// <summary>Add the removed spheres back somewhere else.</summary>
+	/// <returns>True if at least one new proxy took the index of a removed one, False otherwise.</returns>
+	Bool AddSpheres( Spheres& _Spheres, BroadphasePairs& _Broadphase, const std::vector<Uint32>& _Removed, const std::vector<Uint32>& _FreedProxies, std::mt19937& _Generator )
+	{
+		Bool IsReused = False;
+
+		for( Uint32 Sphere : _Removed )
+		{
+			PlaceRandomly( _Spheres, Sphere, _Generator );
+			_Spheres.Proxies[Sphere] = _Broadphase.CreateProxy( GetBounds( _Spheres.Positions[Sphere] ) );
+
+			IsReused |= std::find( _FreedProxies.cbegin(), _FreedProxies.cend(), _Spheres.Proxies[Sphere] ) != _FreedProxies.cend();
+		}
+
+		return IsReused;
+	}
+
+	/// <summary>The pairs of the broadphase against brute force, over frames of several steps.</summary>
+	void CheckBroadphasePairs( AE_InOut Report& _Report )
+	{
+		ae::JobSystem Jobs;
+		std::mt19937 Generator( Seed );
+
+		BroadphasePairs Broadphase( ProxyMargin );
+
+		Spheres Scene;
+		Scene.Positions.resize( SpheresCount );
+		Scene.Velocities.resize( SpheresCount );
+		Scene.Proxies.resize( SpheresCount );
+
+		for( Uint32 s = 0; s < SpheresCount; s++ )
+		{
+			PlaceRandomly( Scene, s, Generator );
+			Scene.Proxies[s] = Broadphase.CreateProxy( GetBounds( Scene.Positions[s] ) );
+		}
+
+		std::vector<Uint32> Removed;
+		std::vector<Uint32> FreedProxies;
+
+		Bool IsExactAtFrames = True;
+		Bool HasOverlapsAtSteps = True;
+		Bool IsReused = False;
+		size_t PairsCount = 0;
+
+		for( Uint32 f = 0; f < FramesCount; f++ )
+		{
+			// The spheres removed a few frames ago are added back before others are removed : the update sees both.
+			if( f % RemovalPeriod == 0 )
+			{
+				IsReused |= AddSpheres( Scene, Broadphase, Removed, FreedProxies, Generator );
+				RemoveSpheres( Scene, Broadphase, Removed, FreedProxies, Generator );
+			}
+
+			// Update of the frame : the new pairs are found, the stale ones removed.
+			MoveProxies( Scene, Broadphase );
+			Broadphase.FindNewPairs( Jobs );
+			Broadphase.RemoveStalePairs();
+
+			IsExactAtFrames &= Broadphase.GetPairs() == FindPairsByBruteForce( Scene, Broadphase );
+			PairsCount += Broadphase.GetPairs().size();
+
+			// Steps : only the new pairs are found, the stale ones wait for the next frame.
+			for( Uint32 s = 0; s < StepsPerFrame; s++ )
+			{
+				MoveSpheres( Scene );
+				MoveProxies( Scene, Broadphase );
+				Broadphase.FindNewPairs( Jobs );
+
+				HasOverlapsAtSteps &= HasOverlappingPairs( Scene, Broadphase );
+			}
+		}
+
+		std::printf( "%u spheres, %u frames of %u steps, %.1f pairs per frame\n", SpheresCount, FramesCount, StepsPerFrame, Cast( double, PairsCount ) / FramesCount );
+
+		_Report.Check( PairsCount > 0, "pairs : the spheres overlap" );
+		_Report.Check( IsExactAtFrames, "pairs : after the update of each frame, the pairs are the overlapping enlarged boxes found by brute force" );
+		_Report.Check( HasOverlapsAtSteps, "pairs : after each step, every pair of overlapping spheres is in the pairs" );
+		_Report.Check( IsReused, "pairs : the removed proxies are reused" );
+		_Report.Check( Broadphase.GetProxyCount() == SpheresCount - RemovedCount, "pairs : one proxy per sphere in the broadphase" );
+	}
+
+	/// <summary>Are two vectors the same, within the tolerance ?</summary>
+	Bool IsNear( const Vector3& _A, const Vector3& _B )
+	{
+		return std::fabs( _A.X - _B.X ) <= Tolerance && std::fabs( _A.Y - _B.Y ) <= Tolerance && std::fabs( _A.Z - _B.Z ) <= Tolerance;
+	}
+
+	/// <summary>The contact of two colliders, tested both ways : the normal pushes the first one out of the second one.</summary>
+	void CheckContact( const ae::Collider& _First, const ae::Collider& _Second, const Vector3& _Normal, float _Depth, const std::string& _Name, AE_InOut Report& _Report )
+	{
+		ae::HitResult Hit;
+		const Bool IsHit = _First.Intersects( Hit, _Second );
+
+		_Report.Check( IsHit && IsNear( Hit.ImpactNormal, _Normal ) && std::fabs( Hit.Depth - _Depth ) <= Tolerance, ( "contacts : " + _Name ).c_str() );
+
+		ae::HitResult SwappedHit;
+		const Bool IsSwappedHit = _Second.Intersects( SwappedHit, _First );
+
+		_Report.Check( IsSwappedHit && IsNear( SwappedHit.ImpactNormal, -_Normal ) && std::fabs( SwappedHit.Depth - _Depth ) <= Tolerance, ( "contacts : " + _Name + ", swapped" ).c_str() );
+	}
+
+	/// <summary>Two colliders apart, tested both ways.</summary>
+	void CheckApart( const ae::Collider& _First, const ae::Collider& _Second, const std::string& _Name, AE_InOut Report& _Report )
+	{
+		_Report.Check( !_First.Intersects( _Second ) && !_Second.Intersects( _First ), ( "contacts : " + _Name + " apart" ).c_str() );
+	}
+
+	/// <summary>The contacts between the shapes, with known normals and depths.</summary>
+	void CheckContacts( AE_InOut Report& _Report )
+	{
+		// A sphere, a box and a capsule standing up, all at the origin.
+		const ae::SphereCollider Sphere( 0.5f );
+		const ae::BoxCollider Box( Vector3( 1.0f, 1.0f, 1.0f ) );
+
+		ae::CapsuleCollider Capsule( 0.5f, 1.0f );
+
+		// A square of two triangles in the plane Y = 0, collided from both sides.
+		const std::vector<Vector3> Positions = { Vector3( -5.0f, 0.0f, -5.0f ), Vector3( 5.0f, 0.0f, -5.0f ), Vector3( 5.0f, 0.0f, 5.0f ), Vector3( -5.0f, 0.0f, 5.0f ) };
+		const std::vector<Uint32> Indices = { 0, 1, 2, 0, 2, 3 };
+		const ae::MeshCollider Ground( Positions, Indices );
+
+		CheckContact( ae::SphereCollider( 0.5f, Vector3( 0.8f, 0.0f, 0.0f ) ), Sphere, Vector3::AxeX, 0.2f, "sphere against sphere", _Report );
+		CheckApart( ae::SphereCollider( 0.5f, Vector3( 1.1f, 0.0f, 0.0f ) ), Sphere, "sphere against sphere", _Report );
+
+		CheckContact( ae::SphereCollider( 0.5f, Vector3( 0.0f, 1.3f, 0.0f ) ), Box, Vector3::AxeY, 0.2f, "sphere against box", _Report );
+		CheckContact( ae::SphereCollider( 0.5f, Vector3( 0.0f, 0.8f, 0.0f ) ), Box, Vector3::AxeY, 0.7f, "sphere centered in a box", _Report );
+		CheckApart( ae::SphereCollider( 0.5f, Vector3( 1.4f, 1.4f, 0.0f ) ), Box, "sphere against box corner", _Report );
+
+		CheckContact( ae::SphereCollider( 0.5f, Vector3( 0.8f, 0.5f, 0.0f ) ), Capsule, Vector3::AxeX, 0.2f, "sphere against capsule side", _Report );
+		CheckContact( ae::SphereCollider( 0.5f, Vector3( 0.0f, 1.8f, 0.0f ) ), Capsule, Vector3::AxeY, 0.2f, "sphere against capsule end", _Report );
+
+		CheckContact( ae::SphereCollider( 0.5f, Vector3( 0.2f, 0.3f, 0.1f ) ), Ground, Vector3::AxeY, 0.2f, "sphere above triangles", _Report );
+		CheckContact( ae::SphereCollider( 0.5f, Vector3( 0.2f, -0.3f, 0.1f ) ), Ground, -Vector3::AxeY, 0.2f, "sphere below triangles", _Report );
+		CheckApart( ae::SphereCollider( 0.5f, Vector3( 0.2f, 0.7f, 0.1f ) ), Ground, "sphere above triangles", _Report );
+
+		ae::CapsuleCollider Moved( 0.5f, 1.0f );
+
+		Moved.Translate( Vector3( 0.9f, 0.3f, 0.0f ) );
+		CheckContact( Moved, Capsule, Vector3::AxeX, 0.1f, "capsule against capsule", _Report );
+
+		Moved.Translate( Vector3( -0.9f, 2.0f, 0.0f ) );
+		CheckContact( Moved, Box, Vector3::AxeY, 0.2f, "capsule against box", _Report );
+
+		Moved.Translate( Vector3( 0.2f, -1.6f, 0.1f ) );
+		CheckContact( Moved, Ground, Vector3::AxeY, 0.8f, "capsule crossing triangles", _Report );
+
+		Moved.Translate( Vector3( 0.0f, 0.7f, 0.0f ) );
+		CheckContact( Moved, Ground, Vector3::AxeY, 0.1f, "capsule above triangles", _Report );
+
+		Moved.Translate( Vector3( 0.0f, 0.2f, 0.0f ) );
+		CheckApart( Moved, Ground, "capsule above triangles", _Report );
+
+		CheckContact( ae::BoxCollider( Vector3( 1.0f, 1.0f, 1.0f ), Vector3( 1.5f, 0.2f, 0.0f ) ), Box, Vector3::AxeX, 0.5f, "box against box", _Report );
+		CheckApart( ae::BoxCollider( Vector3( 1.0f, 1.0f, 1.0f ), Vector3( 2.1f, 0.0f, 0.0f ) ), Box, "box against box", _Report );
+
+		CheckContact( ae::BoxCollider( Vector3( 0.5f, 0.5f, 0.5f ), Vector3( 0.1f, 0.4f, 0.1f ) ), Ground, Vector3::AxeY, 0.1f, "box above triangles", _Report );
+		CheckContact( ae::BoxCollider( Vector3( 0.5f, 0.5f, 0.5f ), Vector3( 0.1f, -0.4f, 0.1f ) ), Ground, -Vector3::AxeY, 0.1f, "box below triangles", _Report );
+		CheckApart( ae::BoxCollider( Vector3( 0.5f, 0.5f, 0.5f ), Vector3( 0.1f, 0.6f, 0.1f ) ), Ground, "box above triangles", _Report );
+	}
+}
+
+int main()
+{
+	Report Result;
+
+	CheckBroadphasePairs( Result );
+	CheckContacts( Result );
+
+	std::printf( "%u checks, %u failed\n", Result.ChecksCount, Result.FailuresCount );
+
+	return Result.FailuresCount == 0 ? 0 : 1;
+}
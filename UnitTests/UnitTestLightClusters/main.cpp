@@ -0,0 +1,297 @@
+#include <API/Code/Aero/Aero.h>
+#include <API/Code/Graphics/Light/LightClusters/LightClusters.h>
+#include <API/Code/Maths/Functions/MathsFunctions.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// Checks the binning of the lights in the clusters of a camera at the origin looking toward -Z :
+// - the lights straddling the boundaries of the tiles and of the depth slices are in the clusters of each side,
+// - the lights outside of the frustum are in no cluster, the ones reaching inside it are,
+// - a cluster crowded with many more lights than usual keeps all of them, the lists have no fixed capacity.
+// Returns 0 if every check passed, 1 otherwise.
+
+using ae::LightClusters;
+using ae::Vector3;
+
+namespace
+{
+	/// <summary>Grid of the clusters, the default one of the renderer.</summary>
+	constexpr Uint32 CountX = 16;
+	constexpr Uint32 CountY = 9;
+	constexpr Uint32 CountZ = 24;
+
+	constexpr float Near = 0.1f;
+	constexpr float Far = 100.0f;
+
+	/// <summary>Count of lights at the same place in the crowded cluster.</summary>
+	constexpr Uint32 CrowdedPointLightsCount = 1000;
+	constexpr Uint32 CrowdedSpotLightsCount = 300;
+
+	/// <summary>Checks run and checks failed, the failures are printed.</summary>
+	struct Report
+	{
+		Uint32 ChecksCount = 0;
+		Uint32 FailuresCount = 0;
+
+		void Check( Bool _Condition, const char* _Description )
+		{
+			ChecksCount++;
+
+			if( _Condition )
+				return;
+
+			FailuresCount++;
+			std::printf( "FAILED : %s\n", _Description );
+		}
+	};
+
+	ae::Matrix4x4 GetProjection()
+	{
+		ae::Matrix4x4 Projection;
+		Projection.SetToPerspectiveMatrix( ae::Math::DegToRad( 60.0f ), 16.0f / 9.0f, Near, Far );
+
+		return Projection;
+	}
+
+	/// <summary>View depth of the boundary between a depth slice and the previous one.</summary>
+	float GetSliceStart( Uint32 _Slice )
+	{
+		return Near * ae::Math::Pow( Far / Near, Cast( float, _Slice ) / Cast( float, CountZ ) );
+	}
+
+	/// <summary>View space point on the ray of a normalized device coordinates position, at a depth.</summary>
+	Vector3 GetViewPoint( const ae::Matrix4x4& _Projection, float _NDCX, float _NDCY, float _Depth )
+	{
+		const float* const M = _Projection.GetData();
+
+		// The perspective divide is by the depth : x_ndc = x * P00 / depth.
+		return Vector3( _NDCX * _Depth / M[ae::Matrix4x4::R0C0], _NDCY * _Depth / M[ae::Matrix4x4::R1C1], -_Depth );
+	}
+
+	/// <summary>Find the cluster of a view space point, as the shaders do.</summary>
+	/// <returns>True if the point is in the frustum, False otherwise.</returns>
+	Bool FindCluster( const LightClusters& _Clusters, const ae::Matrix4x4& _Projection, const Vector3& _Point, AE_Out Uint32& _Cluster )
+	{
+		const float* const M = _Projection.GetData();
+		const float Depth = -_Point.Z;
+
+		if( Depth < Near || Depth > Far )
+			return False;
+
+		const float NDCX = _Point.X * M[ae::Matrix4x4::R0C0] / Depth;
+		const float NDCY = _Point.Y * M[ae::Matrix4x4::R1C1] / Depth;
+
+		if( ae::Math::Abs( NDCX ) >= 1.0f || ae::Math::Abs( NDCY ) >= 1.0f )
+			return False;
+
+		const Uint32 TileX = Cast( Uint32, ( NDCX * 0.5f + 0.5f ) * Cast( float, CountX ) );
+		const Uint32 TileY = Cast( Uint32, ( NDCY * 0.5f + 0.5f ) * Cast( float, CountY ) );
+
+		_Cluster = _Clusters.GetClusterIndex( TileX, TileY, _Clusters.GetSlice( Depth ) );
+
+		return True;
+	}
+
+	/// <summary>Is a light listed by a cluster ?</summary>
+	Bool HasLight( const LightClusters& _Clusters, Uint32 _Cluster, Uint32 _Light, Bool _IsSpot )
+	{
+		const LightClusters::Cell& Cell = _Clusters.GetCells()[_Cluster];
+		const std::vector<Uint32>& Indices = _Clusters.GetLightIndices();
+
+		const Uint32 First = Cell.Offset + ( _IsSpot ? Cell.PointLightsCount : 0 );
+		const Uint32 Count = _IsSpot ? Cell.SpotLightsCount : Cell.PointLightsCount;
+
+		return std::find( Indices.begin() + First, Indices.begin() + First + Count, _Light ) != Indices.begin() + First + Count;
+	}
+
+	/// <summary>Count of clusters listing a light.</summary>
+	Uint32 CountClustersWithLight( const LightClusters& _Clusters, Uint32 _Light, Bool _IsSpot )
+	{
+		Uint32 Count = 0;
+		for( Uint32 c = 0; c < _Clusters.GetClustersCount(); c++ )
+		{
+			if( HasLight( _Clusters, c, _Light, _IsSpot ) )
+				Count++;
+		}
+
+		return Count;
+	}
+
+	/// <summary>The ranges of the cells follow each other in the indices list, without gap nor overlap.</summary>
+	Bool AreRangesValid( const LightClusters& _Clusters )
+	{
+		Uint32 Expected = 0;
+		for( const LightClusters::Cell& Cell : _Clusters.GetCells() )
+		{
+			if( Cell.Offset != Expected )
+				return False;
+
+			Expected += Cell.PointLightsCount + Cell.SpotLightsCount;
+		}
+
+		return Expected == _Clusters.GetLightIndices().size();
+	}
+
+	/// <summary>Every cluster holding a point of the light volume lists the light : a missing one would cut the light at the cluster boundary.</summary>
+	Bool IsVolumeCovered( const LightClusters& _Clusters, const ae::Matrix4x4& _Projection, const LightClusters::LightBounds& _Light, Uint32 _Index, Bool _IsSpot )
+	{
+		// The center, the ends of the axes and the corners of the inscribed cube, slightly inside the sphere.
+		std::vector<Vector3> Samples = { Vector3::Zero };
+		for( float Sign : { -1.0f, 1.0f } )
+		{
+			Samples.push_back( Vector3( Sign, 0.0f, 0.0f ) );
+			Samples.push_back( Vector3( 0.0f, Sign, 0.0f ) );
+			Samples.push_back( Vector3( 0.0f, 0.0f, Sign ) );
+		}
+
+		for( Uint32 Corner = 0; Corner < 8; Corner++ )
+			Samples.push_back( Vector3( Corner & 1 ? 1.0f : -1.0f, Corner & 2 ? 1.0f : -1.0f, Corner & 4 ? 1.0f : -1.0f ) * 0.57f );
+
+		for( const Vector3& Sample : Samples )
+		{
+			Uint32 Cluster = 0;
+			if( FindCluster( _Clusters, _Projection, _Light.Position + Sample * ( _Light.Radius * 0.99f ), Cluster ) && !HasLight( _Clusters, Cluster, _Index, _IsSpot ) )
+				return False;
+		}
+
+		return True;
+	}
+
+	void CheckStraddlingLights( LightClusters& _Clusters, AE_InOut Report& _Report )
+	{
+		const ae::Matrix4x4 Projection = GetProjection();
+
+		// On the boundary between the tiles 7 and 8 along X, in the middle of the tile 5 along Y, on the start of the slice 12.
+		const float Depth = GetSliceStart( 12 );
+		const LightClusters::LightBounds OnBoundary = { GetViewPoint( Projection, 0.0f, 2.0f / Cast( float, CountY ), Depth ), Depth * 0.01f };
+
+		// On the corner of the tiles 9 and 10 along X, 4 and 5 along Y, inside a slice.
+		const float CornerDepth = ( GetSliceStart( 8 ) + GetSliceStart( 9 ) ) * 0.5f;
+		const LightClusters::LightBounds OnCorner = { GetViewPoint( Projection, 0.25f, 1.0f / Cast( float, CountY ), CornerDepth ), CornerDepth * 0.005f };
+
+		// Larger than a cluster : spans several tiles and slices.
+		const LightClusters::LightBounds Large = { GetViewPoint( Projection, -0.5f, -0.3f, 20.0f ), 6.0f };
+
+		const std::vector<LightClusters::LightBounds> PointLights = { OnBoundary, OnCorner, Large };
+		const std::vector<LightClusters::LightBounds> SpotLights = { OnBoundary };
+
+		_Clusters.Bin( ae::Matrix4x4::Identity, Projection, Near, Far, PointLights, SpotLights );
+
+		_Report.Check( AreRangesValid( _Clusters ), "straddling lights : the cells ranges follow each other" );
+
+		for( Uint32 z = 11; z <= 12; z++ )
+		{
+			for( Uint32 x = 7; x <= 8; x++ )
+			{
+				_Report.Check( HasLight( _Clusters, _Clusters.GetClusterIndex( x, 5, z ), 0, False ), "point light on a tile and slice boundary : in the clusters of each side" );
+				_Report.Check( HasLight( _Clusters, _Clusters.GetClusterIndex( x, 5, z ), 0, True ), "spot light on a tile and slice boundary : in the clusters of each side" );
+			}
+		}
+
+		// Far from the boundaries, the light must not be spread : it stays in the 2x2x2 clusters around it, the bounds of a cluster being conservative.
+		_Report.Check( CountClustersWithLight( _Clusters, 0, False ) <= 12, "point light on a tile and slice boundary : only in the clusters around it" );
+
+		_Report.Check( IsVolumeCovered( _Clusters, Projection, PointLights[1], 1, False ), "point light on a tiles corner : in every cluster of its volume" );
+		_Report.Check( CountClustersWithLight( _Clusters, 1, False ) >= 4, "point light on a tiles corner : in the four tiles" );
+
+		_Report.Check( IsVolumeCovered( _Clusters, Projection, PointLights[2], 2, False ), "large point light : in every cluster of its volume" );
+		_Report.Check( IsVolumeCovered( _Clusters, Projection, PointLights[0], 0, False ), "point light on a tile and slice boundary : in every cluster of its volume" );
+	}
+
+	void CheckLightsOutsideFrustum( LightClusters& _Clusters, AE_InOut Report& _Report )
+	{
+		const ae::Matrix4x4 Projection = GetProjection();
+
+		const std::vector<LightClusters::LightBounds> Outside =
+		{
+			{ Vector3( 0.0f, 0.0f, 5.0f ), 1.0f },			// Behind the camera.
+			{ Vector3( 0.0f, 0.0f, -Far - 5.0f ), 1.0f },	// Beyond the far plane.
+			{ Vector3( 1000.0f, 0.0f, -10.0f ), 1.0f },		// On the right of the frustum.
+			{ Vector3( 0.0f, -1000.0f, -10.0f ), 1.0f }		// Under the frustum.
+		};
+
+		_Clusters.Bin( ae::Matrix4x4::Identity, Projection, Near, Far, Outside, Outside );
+
+		_Report.Check( _Clusters.GetLightIndices().empty(), "lights outside of the frustum : in no cluster" );
+		_Report.Check( AreRangesValid( _Clusters ), "lights outside of the frustum : the cells ranges follow each other" );
+
+		// Centers outside of the frustum, volumes reaching inside it.
+		const std::vector<LightClusters::LightBounds> Reaching =
+		{
+			{ Vector3( 0.0f, 0.0f, 0.5f ), 1.0f },			// Behind the camera, through the near plane.
+			{ Vector3( 0.0f, 0.0f, -Far - 0.5f ), 1.0f },	// Beyond the far plane, through it.
+			{ GetViewPoint( Projection, 1.05f, 0.0f, 10.0f ), 1.0f }	// Just on the right of the frustum.
+		};
+
+		_Clusters.Bin( ae::Matrix4x4::Identity, Projection, Near, Far, Reaching, {} );
+
+		_Report.Check( HasLight( _Clusters, _Clusters.GetClusterIndex( CountX / 2, CountY / 2, 0 ), 0, False ), "light behind the camera through the near plane : in the first slice" );
+		_Report.Check( HasLight( _Clusters, _Clusters.GetClusterIndex( CountX / 2, CountY / 2, CountZ - 1 ), 1, False ), "light through the far plane : in the last slice" );
+		_Report.Check( HasLight( _Clusters, _Clusters.GetClusterIndex( CountX - 1, CountY / 2, _Clusters.GetSlice( 10.0f ) ), 2, False ), "light on the right of the frustum : in the last tile" );
+		_Report.Check( AreRangesValid( _Clusters ), "lights reaching the frustum : the cells ranges follow each other" );
+	}
+
+	void CheckCrowdedCluster( LightClusters& _Clusters, AE_InOut Report& _Report )
+	{
+		const ae::Matrix4x4 Projection = GetProjection();
+
+		// All the lights in the middle of one cluster : enough lights to bin them in parallel jobs too.
+		const float Depth = ( GetSliceStart( 10 ) + GetSliceStart( 11 ) ) * 0.5f;
+		const LightClusters::LightBounds Crowded = { GetViewPoint( Projection, 1.0f / Cast( float, CountX ), 0.0f, Depth ), Depth * 0.001f };
+
+		const std::vector<LightClusters::LightBounds> PointLights( CrowdedPointLightsCount, Crowded );
+		const std::vector<LightClusters::LightBounds> SpotLights( CrowdedSpotLightsCount, Crowded );
+
+		_Clusters.Bin( ae::Matrix4x4::Identity, Projection, Near, Far, PointLights, SpotLights );
+
+		Uint32 Cluster = 0;
+		FindCluster( _Clusters, Projection, Crowded.Position, Cluster );
+
+		const LightClusters::Cell& Cell = _Clusters.GetCells()[Cluster];
+		_Report.Check( Cell.PointLightsCount == CrowdedPointLightsCount, "crowded cluster : every point light is kept" );
+		_Report.Check( Cell.SpotLightsCount == CrowdedSpotLightsCount, "crowded cluster : every spot light is kept" );
+		_Report.Check( _Clusters.GetMaxLightsPerCluster() == CrowdedPointLightsCount + CrowdedSpotLightsCount, "crowded cluster : the maximum count of lights is the crowded one" );
+		_Report.Check( AreRangesValid( _Clusters ), "crowded cluster : the cells ranges follow each other" );
+
+		// Each light once, the point lights then the spot lights.
+		const std::vector<Uint32>& Indices = _Clusters.GetLightIndices();
+
+		std::vector<Uint32> Points( Indices.begin() + Cell.Offset, Indices.begin() + Cell.Offset + Cell.PointLightsCount );
+		std::vector<Uint32> Spots( Indices.begin() + Cell.Offset + Cell.PointLightsCount, Indices.begin() + Cell.Offset + Cell.PointLightsCount + Cell.SpotLightsCount );
+		std::sort( Points.begin(), Points.end() );
+		std::sort( Spots.begin(), Spots.end() );
+
+		Bool AreAllListed = Points.size() == CrowdedPointLightsCount && Spots.size() == CrowdedSpotLightsCount;
+		for( Uint32 i = 0; AreAllListed && i < CrowdedPointLightsCount; i++ )
+			AreAllListed = Points[i] == i;
+
+		for( Uint32 i = 0; AreAllListed && i < CrowdedSpotLightsCount; i++ )
+			AreAllListed = Spots[i] == i;
+
+		_Report.Check( AreAllListed, "crowded cluster : each light is listed once" );
+
+		// The same binning on the calling thread only.
+		const std::vector<Uint32> ParallelIndices = Indices;
+		_Clusters.SetWorkersCount( 1 );
+		_Clusters.Bin( ae::Matrix4x4::Identity, Projection, Near, Far, PointLights, SpotLights );
+		_Clusters.SetWorkersCount( 0 );
+
+		_Report.Check( _Clusters.GetLightIndices() == ParallelIndices, "crowded cluster : the same lists with one or several jobs" );
+	}
+}
+
+int main()
+{
+	LightClusters Clusters( CountX, CountY, CountZ );
+	Report Result;
+
+	CheckStraddlingLights( Clusters, Result );
+	CheckLightsOutsideFrustum( Clusters, Result );
+	CheckCrowdedCluster( Clusters, Result );
+
+	std::printf( "%u checks, %u failed, on %u job threads\n", Result.ChecksCount, Result.FailuresCount, Aero.GetJobSystem().GetThreadsCount() );
+
+	return Result.FailuresCount == 0 ? 0 : 1;
+}
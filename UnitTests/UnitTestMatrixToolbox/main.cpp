@@ -0,0 +1,299 @@
+#include <API/Code/Maths/Matrix/Matrix4x4.h>
+#include <API/Code/Maths/Matrix/MatrixToolbox.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Checks the fixed size 4x4 kernels of the matrix toolbox against the scalar paths, then times them.
+// The multiplication, the transposition and the points transformation must give the same bits as the scalar versions :
+// the sums are done in the same order. The inverse is compared to the double precision one, within a tolerance.
+// Returns 0 if every check passed, 1 otherwise.
+
+namespace MatrixToolbox = ae::priv::MatrixToolbox;
+
+namespace
+{
+	/// <summary>Count of random matrices checked.</summary>
+	constexpr Uint32 ChecksCount = 100000;
+
+	/// <summary>Largest count of points transformed in one check : all the tails of the four points batches are covered.</summary>
+	constexpr Uint32 MaxPointsCount = 13;
+
+	/// <summary>Largest coefficient of the double inverse to compare with : beyond, the matrix is too ill conditioned for floats.</summary>
+	constexpr double MaxInverseCoefficient = 50.0;
+
+	/// <summary>Error allowed for the float inverse against the double one, relative to the coefficient plus one.</summary>
+	constexpr double InverseTolerance = 1e-3;
+
+	/// <summary>Count of matrices in each timed array, small enough to stay in the caches.</summary>
+	constexpr Uint32 TimedMatricesCount = 4096;
+
+	/// <summary>Count of runs over the timed arrays.</summary>
+	constexpr Uint32 TimedRepetitions = 200;
+
+	/// <summary>Count of points transformed by the timed batches.</summary>
+	constexpr Uint32 TimedPointsCount = 1 << 20;
+
+	/// <summary>Failures of each check.</summary>
+	struct Failures
+	{
+		Uint32 Multiply = 0;
+		Uint32 Transpose = 0;
+		Uint32 Inverse = 0;
+		Uint32 TransformPoints = 0;
+		Uint32 Aliasing = 0;
+	};
+
+	Bool AreEqual( const float* _A, const float* _B, Uint32 _Count )
+	{
+		return std::memcmp( _A, _B, _Count * sizeof( float ) ) == 0;
+	}
+
+	/// <summary>Points transformed one by one, in the order of the sums of the scalar version.</summary>
+	void TransformPointsScalar( AE_Out float* _Result, const float* _Matrix, const float* _Points, Uint32 _CountPoints )
+	{
+		for( Uint32 Point = 0; Point < _CountPoints; Point++ )
+		{
+			const float X = _Points[Point * 3];
+			const float Y = _Points[Point * 3 + 1];
+			const float Z = _Points[Point * 3 + 2];
+
+			for( Uint32 Row = 0; Row < 3; Row++ )
+				_Result[Point * 3 + Row] = X * _Matrix[Row * 4] + Y * _Matrix[Row * 4 + 1] + Z * _Matrix[Row * 4 + 2] + _Matrix[Row * 4 + 3];
+		}
+	}
+
+	void CheckMultiply( const float* _A, const float* _B, AE_InOut Failures& _Failures )
+	{
+		// The runtime sized version is never specialized : it is the scalar reference.
+		float Expected[16];
+		MatrixToolbox::Multiply( Expected, _A, 4, 4, _B, 4 );
+
+		float Result[16];
+		MatrixToolbox::Multiply<4, 4, 4>( Result, _A, _B );
+
+		if( !AreEqual( Result, Expected, 16 ) )
+			_Failures.Multiply++;
+
+		// The result written over each operand.
+		float OverA[16];
+		std::memcpy( OverA, _A, sizeof( OverA ) );
+		MatrixToolbox::Multiply<4, 4, 4>( OverA, OverA, _B );
+
+		float OverB[16];
+		std::memcpy( OverB, _B, sizeof( OverB ) );
+		MatrixToolbox::Multiply<4, 4, 4>( OverB, _A, OverB );
+
+		if( !AreEqual( OverA, Expected, 16 ) || !AreEqual( OverB, Expected, 16 ) )
+			_Failures.Aliasing++;
+	}
+
+	void CheckTranspose( const float* _A, AE_InOut Failures& _Failures )
+	{
+		float Expected[16];
+		MatrixToolbox::Transpose( Expected, _A, 4, 4 );
+
+		float Result[16];
+		MatrixToolbox::Transpose<4, 4>( Result, _A );
+
+		if( !AreEqual( Result, Expected, 16 ) )
+			_Failures.Transpose++;
+
+		float InPlace[16];
+		std::memcpy( InPlace, _A, sizeof( InPlace ) );
+		MatrixToolbox::Transpose<4, 4>( InPlace, InPlace );
+
+		if( !AreEqual( InPlace, Expected, 16 ) )
+			_Failures.Aliasing++;
+	}
+
+	void CheckInverse( const float* _A, AE_InOut Failures& _Failures )
+	{
+		double DoubleA[16];
+		std::copy( _A, _A + 16, DoubleA );
+
+		double Expected[16];
+		if( !MatrixToolbox::Inverse4x4( Expected, DoubleA ) )
+			return;
+
+		const double LargestCoefficient = std::fabs( *std::max_element( Expected, Expected + 16, []( double _Left, double _Right ) { return std::fabs( _Left ) < std::fabs( _Right ); } ) );
+		if( LargestCoefficient > MaxInverseCoefficient )
+			return;
+
+		float Result[16];
+		if( !MatrixToolbox::Inverse4x4( Result, _A ) )
+		{
+			_Failures.Inverse++;
+			return;
+		}
+
+		for( Uint32 Index = 0; Index < 16; Index++ )
+		{
+			if( std::fabs( Result[Index] - Expected[Index] ) > InverseTolerance * ( 1.0 + std::fabs( Expected[Index] ) ) )
+			{
+				_Failures.Inverse++;
+				break;
+			}
+		}
+
+		float InPlace[16];
+		std::memcpy( InPlace, _A, sizeof( InPlace ) );
+		MatrixToolbox::Inverse4x4( InPlace, InPlace );
+
+		if( !AreEqual( InPlace, Result, 16 ) )
+			_Failures.Aliasing++;
+	}
+
+	void CheckTransformPoints( const float* _A, const float* _Points, Uint32 _CountPoints, AE_InOut Failures& _Failures )
+	{
+		float Expected[MaxPointsCount * 3];
+		TransformPointsScalar( Expected, _A, _Points, _CountPoints );
+
+		float Result[MaxPointsCount * 3];
+		MatrixToolbox::TransformPoints( Result, _A, _Points, _CountPoints );
+
+		if( !AreEqual( Result, Expected, _CountPoints * 3 ) )
+			_Failures.TransformPoints++;
+
+		float InPlace[MaxPointsCount * 3];
+		std::memcpy( InPlace, _Points, _CountPoints * 3 * sizeof( float ) );
+		MatrixToolbox::TransformPoints( InPlace, _A, InPlace, _CountPoints );
+
+		if( !AreEqual( InPlace, Expected, _CountPoints * 3 ) )
+			_Failures.Aliasing++;
+	}
+
+	/// <summary>A singular matrix is reported and the result is not written.</summary>
+	Bool CheckSingularInverse()
+	{
+		const float Zeros[16] = { 0.0f };
+
+		float Result[16];
+		std::fill( Result, Result + 16, 5.0f );
+
+		return !MatrixToolbox::Inverse4x4( Result, Zeros ) && Result[0] == 5.0f;
+	}
+
+	/// <summary>Duration of a function per item, in nanoseconds.</summary>
+	template<typename Function>
+	double MeasureNanoSeconds( Uint32 _ItemsCount, Function _Function )
+	{
+		const std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+		_Function();
+
+		return std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - Start ).count() / Cast( double, _ItemsCount );
+	}
+
+	void RunTimings( std::mt19937& _Random )
+	{
+		std::uniform_real_distribution<float> Distribution( -1.0f, 1.0f );
+
+		// Diagonal dominant : every matrix can be inverted.
+		std::vector<ae::Matrix4x4> A( TimedMatricesCount ), B( TimedMatricesCount ), Result( TimedMatricesCount );
+		for( Uint32 m = 0; m < TimedMatricesCount; m++ )
+		{
+			for( Uint32 Index = 0; Index < 16; Index++ )
+			{
+				A[m][Index] = Distribution( _Random ) + ( Index % 5 == 0 ? 3.0f : 0.0f );
+				B[m][Index] = Distribution( _Random );
+			}
+		}
+
+		const Uint32 TimedCount = TimedMatricesCount * TimedRepetitions;
+
+		// Summed and printed : the compiler cannot remove the timed loops.
+		float Sink = 0.0f;
+
+		const double MultiplyTime = MeasureNanoSeconds( TimedCount, [&]()
+		{
+			for( Uint32 r = 0; r < TimedRepetitions; r++ )
+				for( Uint32 m = 0; m < TimedMatricesCount; m++ )
+					Result[m] = A[m] * B[m];
+		} );
+		Sink += Result[7][3];
+
+		const double InverseTime = MeasureNanoSeconds( TimedCount, [&]()
+		{
+			for( Uint32 r = 0; r < TimedRepetitions; r++ )
+				for( Uint32 m = 0; m < TimedMatricesCount; m++ )
+					Result[m] = A[m].GetInverse();
+		} );
+		Sink += Result[7][3];
+
+		const double TransposeTime = MeasureNanoSeconds( TimedCount, [&]()
+		{
+			for( Uint32 r = 0; r < TimedRepetitions; r++ )
+				for( Uint32 m = 0; m < TimedMatricesCount; m++ )
+					Result[m] = A[m].GetTranspose();
+		} );
+		Sink += Result[7][3];
+
+		std::vector<ae::Vector3> Points( TimedPointsCount ), Transformed( TimedPointsCount );
+		for( ae::Vector3& Point : Points )
+			Point = ae::Vector3( Distribution( _Random ), Distribution( _Random ), Distribution( _Random ) );
+
+		const Uint32 PointsRepetitions = 20;
+
+		const double PointTime = MeasureNanoSeconds( TimedPointsCount * PointsRepetitions, [&]()
+		{
+			for( Uint32 r = 0; r < PointsRepetitions; r++ )
+				for( Uint32 p = 0; p < TimedPointsCount; p++ )
+					Transformed[p] = A[r].GetTransformedPoint( Points[p] );
+		} );
+		Sink += Transformed[5].X;
+
+		const double BatchTime = MeasureNanoSeconds( TimedPointsCount * PointsRepetitions, [&]()
+		{
+			for( Uint32 r = 0; r < PointsRepetitions; r++ )
+				A[r].TransformPoints( Points.data(), Transformed.data(), TimedPointsCount );
+		} );
+		Sink += Transformed[5].X;
+
+		std::printf( "Multiply : %.2f ns, inverse : %.2f ns, transpose : %.2f ns\n", MultiplyTime, InverseTime, TransposeTime );
+		std::printf( "Transform points : %.3f ns per point one by one, %.3f ns per point in batch [%g]\n", PointTime, BatchTime, Sink );
+	}
+}
+
+int main()
+{
+	std::mt19937 Random( 7 );
+	std::uniform_real_distribution<float> Distribution( -2.0f, 2.0f );
+
+	Failures Failed;
+
+	for( Uint32 c = 0; c < ChecksCount; c++ )
+	{
+		float A[16], B[16];
+		for( Uint32 Index = 0; Index < 16; Index++ )
+		{
+			A[Index] = Distribution( Random );
+			B[Index] = Distribution( Random );
+		}
+
+		float Points[MaxPointsCount * 3];
+		for( float& Coordinate : Points )
+			Coordinate = Distribution( Random );
+
+		CheckMultiply( A, B, Failed );
+		CheckTranspose( A, Failed );
+		CheckInverse( A, Failed );
+		CheckTransformPoints( A, Points, c % ( MaxPointsCount + 1 ), Failed );
+	}
+
+	const Bool IsSingularReported = CheckSingularInverse();
+
+	std::printf( "Failed checks on %u matrices :\n", ChecksCount );
+	std::printf( "  multiply %u, transpose %u, inverse %u, transform points %u, aliased in/out %u\n", Failed.Multiply, Failed.Transpose, Failed.Inverse, Failed.TransformPoints, Failed.Aliasing );
+	std::printf( "  singular matrix %s\n", IsSingularReported ? "reported" : "NOT reported" );
+
+	RunTimings( Random );
+
+	const Bool HasFailed = Failed.Multiply + Failed.Transpose + Failed.Inverse + Failed.TransformPoints + Failed.Aliasing > 0 || !IsSingularReported;
+
+	return HasFailed ? 1 : 0;
+}
@@ -0,0 +1,262 @@
+#include <API/Code/Graphics/Mesh/3D/Mesh3D.h>
+#include <API/Code/Graphics/Mesh/3D/MeshSimplifier.h>
+#include <API/Code/Graphics/Mesh/3D/SharedGeometry.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+// Checks that the generation of the levels of detail is deterministic, CPU only :
+// - the chain of a generated terrain with a UV seam is the same, byte for byte, when built twice from copies of the mesh,
+// - the levels are valid ranges of the index buffer, coarser and coarser, and keep the seam and border vertices,
+// - a 3D file cooked twice gives the same cooked file and the same index buffer for each level, byte for byte.
+// The file to cook can be given as first argument, the cow of the Snow project by default.
+// Returns 0 if every check passed, 1 otherwise.
+
+using ae::Vector2;
+using ae::Vector3;
+
+namespace
+{
+	/// <summary>Count of quads of the generated terrain in each axis.</summary>
+	constexpr Uint32 GridSize = 64;
+
+	/// <summary>Seed of the heights of the generated terrain.</summary>
+	constexpr Uint32 Seed = 1234;
+
+	/// <summary>File cooked by default, from the binaries directory.</summary>
+	const char* const DefaultFile = "../../../Data/Projects/Snow/MooMoo/spot_triangulated.obj";
+
+	/// <summary>Checks run and checks failed, the failures are printed.</summary>
+	struct Report
+	{
+		Uint32 ChecksCount = 0;
+		Uint32 FailuresCount = 0;
+
+		void Check( Bool _Condition, const char* _Description )
+		{
+			ChecksCount++;
+
+			if( _Condition )
+				return;
+
+			FailuresCount++;
+			std::printf( "FAILED : %s\n", _Description );
+		}
+	};
+
+	/// <summary>A bumpy grid, with its middle column of vertices duplicated with other UVs as a texture seam.</summary>
+	void BuildTerrain( AE_Out ae::Vertex3DArray& _Vertices, AE_Out std::vector<Uint32>& _Indices, AE_Out std::vector<Uint32>& _SeamVertices )
+	{
+		std::mt19937 Generator( Seed );
+		std::uniform_real_distribution<float> Height( 0.0f, 0.05f );
+
+		const Uint32 RowSize = GridSize + 1;
+		const Uint32 SeamColumn = GridSize / 2;
+
+		_Vertices.clear();
+		_Indices.clear();
+		_SeamVertices.clear();
+
+		for( Uint32 z = 0; z <= GridSize; z++ )
+		{
+			for( Uint32 x = 0; x <= GridSize; x++ )
+			{
+				const Vector3 Position( Cast( float, x ) / GridSize, Height( Generator ), Cast( float, z ) / GridSize );
+				_Vertices.push_back( ae::Vertex3D( Position, ae::Color::White, Vector2( Position.X, Position.Z ), Vector3::AxeY ) );
+			}
+		}
+
+		// The right side of the seam uses its own vertices, at the same positions.
+		std::vector<Uint32> SeamCopies( RowSize );
+		for( Uint32 z = 0; z <= GridSize; z++ )
+		{
+			const Uint32 Original = z * RowSize + SeamColumn;
+			ae::Vertex3D Copy = _Vertices[Original];
+			Copy.UV.X += 1.0f;
+
+			SeamCopies[z] = Cast( Uint32, _Vertices.size() );
+			_Vertices.push_back( Copy );
+
+			_SeamVertices.push_back( Original );
+			_SeamVertices.push_back( SeamCopies[z] );
+		}
+
+		for( Uint32 z = 0; z < GridSize; z++ )
+		{
+			for( Uint32 x = 0; x < GridSize; x++ )
+			{
+				Uint32 Corners[4] = { z * RowSize + x, z * RowSize + x + 1, ( z + 1 ) * RowSize + x, ( z + 1 ) * RowSize + x + 1 };
+
+				if( x == SeamColumn )
+				{
+					Corners[0] = SeamCopies[z];
+					Corners[2] = SeamCopies[z + 1];
+				}
+
+				_Indices.insert( _Indices.end(), { Corners[0], Corners[2], Corners[1], Corners[1], Corners[2], Corners[3] } );
+			}
+		}
+	}
+
+	/// <summary>The levels follow each other in the index buffer, with less triangles and more error each time, all valid.</summary>
+	Bool IsChainValid( const ae::Vertex3DArray& _Vertices, const std::vector<Uint32>& _Indices, const std::vector<ae::priv::MeshLOD>& _LODs )
+	{
+		Uint32 Expected = 0;
+
+		for( size_t l = 0; l < _LODs.size(); l++ )
+		{
+			const ae::priv::MeshLOD& LOD = _LODs[l];
+
+			if( LOD.FirstIndex != Expected || LOD.IndicesCount % 3 != 0 || LOD.IndicesCount == 0 )
+				return False;
+
+			if( l > 0 && ( LOD.IndicesCount >= _LODs[l - 1].IndicesCount || LOD.Error < _LODs[l - 1].Error ) )
+				return False;
+
+			for( Uint32 i = LOD.FirstIndex; i < LOD.FirstIndex + LOD.IndicesCount; i += 3 )
+			{
+				const Uint32 A = _Indices[i];
+				const Uint32 B = _Indices[i + 1];
+				const Uint32 C = _Indices[i + 2];
+
+				if( A >= _Vertices.size() || B >= _Vertices.size() || C >= _Vertices.size() || A == B || B == C || A == C )
+					return False;
+			}
+
+			Expected += LOD.IndicesCount;
+		}
+
+		return Expected == _Indices.size();
+	}
+
+	/// <summary>Every vertex of a list is still used by each level.</summary>
+	Bool AreVerticesKept( const std::vector<Uint32>& _Indices, const std::vector<ae::priv::MeshLOD>& _LODs, const std::vector<Uint32>& _Vertices, Uint32 _VerticesCount )
+	{
+		for( const ae::priv::MeshLOD& LOD : _LODs )
+		{
+			std::vector<Bool> IsUsed( _VerticesCount, False );
+			for( Uint32 i = LOD.FirstIndex; i < LOD.FirstIndex + LOD.IndicesCount; i++ )
+				IsUsed[_Indices[i]] = True;
+
+			for( Uint32 Vertex : _Vertices )
+			{
+				if( !IsUsed[Vertex] )
+					return False;
+			}
+		}
+
+		return True;
+	}
+
+	void CheckGeneratedTerrain( AE_InOut Report& _Report )
+	{
+		ae::Vertex3DArray Vertices;
+		std::vector<Uint32> Indices;
+		std::vector<Uint32> SeamVertices;
+		BuildTerrain( Vertices, Indices, SeamVertices );
+
+		// The second build works on copies at other addresses : nothing may depend on pointers.
+		const ae::Vertex3DArray VerticesCopy( Vertices );
+		std::vector<Uint32> IndicesCopy( Indices );
+
+		std::vector<ae::priv::MeshLOD> LODs;
+		std::vector<ae::priv::MeshLOD> LODsCopy;
+		ae::priv::MeshSimplifier::BuildLODChain( Vertices, Indices, LODs );
+		ae::priv::MeshSimplifier::BuildLODChain( VerticesCopy, IndicesCopy, LODsCopy );
+
+		_Report.Check( LODs.size() > 2, "generated terrain : several levels are generated" );
+		_Report.Check( IsChainValid( Vertices, Indices, LODs ), "generated terrain : the levels are valid ranges, coarser and coarser" );
+
+		_Report.Check( Indices.size() == IndicesCopy.size() && std::memcmp( Indices.data(), IndicesCopy.data(), Indices.size() * sizeof( Uint32 ) ) == 0,
+					   "generated terrain : the same indices when built twice" );
+		_Report.Check( LODs.size() == LODsCopy.size() && std::memcmp( LODs.data(), LODsCopy.data(), LODs.size() * sizeof( ae::priv::MeshLOD ) ) == 0,
+					   "generated terrain : the same levels when built twice" );
+
+		// The seam and the corners are locked, a crack or a hole would open otherwise.
+		const Uint32 RowSize = GridSize + 1;
+		const std::vector<Uint32> Corners = { 0, GridSize, GridSize * RowSize, GridSize * RowSize + GridSize };
+
+		_Report.Check( AreVerticesKept( Indices, LODs, SeamVertices, Cast( Uint32, Vertices.size() ) ), "generated terrain : the seam vertices are kept in each level" );
+		_Report.Check( AreVerticesKept( Indices, LODs, Corners, Cast( Uint32, Vertices.size() ) ), "generated terrain : the corners are kept in each level" );
+
+		std::printf( "Generated terrain : %u levels, %u to %u triangles\n", Cast( Uint32, LODs.size() ), LODs.front().IndicesCount / 3, LODs.back().IndicesCount / 3 );
+	}
+
+	Bool ReadFile( const std::string& _File, AE_Out std::vector<char>& _Content )
+	{
+		std::ifstream Stream( _File, std::ios::binary );
+		if( !Stream )
+			return False;
+
+		_Content.assign( std::istreambuf_iterator<char>( Stream ), std::istreambuf_iterator<char>() );
+
+		return True;
+	}
+
+	/// <summary>Cook a file and read the raw indices of each of its levels.</summary>
+	Bool CookAndReadLevels( const std::string& _File, AE_Out std::vector<char>& _Cooked, AE_Out std::vector<std::vector<char>>& _Levels )
+	{
+		if( !ae::priv::SharedGeometry::Cook( _File, ae::Mesh3D::GetImportFlags() ) )
+			return False;
+
+		const std::string CookedPath = ae::priv::CookedMesh::GetCookedPath( _File );
+		if( !ReadFile( CookedPath, _Cooked ) )
+			return False;
+
+		Uint64 SourceHash = 0;
+		ae::priv::CookedMesh Cooked;
+		if( !ae::priv::CookedMesh::HashFile( SourceHash, _File ) || !Cooked.Open( CookedPath, SourceHash, ae::Mesh3D::GetImportFlags() ) )
+			return False;
+
+		std::vector<ae::priv::MeshLOD> LODs;
+		Cooked.ReadLODs( LODs );
+
+		const char* const Indices = static_cast<const char*>( Cooked.GetIndices() );
+		const Uint32 IndexSize = Cooked.GetIndexSize();
+
+		_Levels.clear();
+		for( const ae::priv::MeshLOD& LOD : LODs )
+			_Levels.emplace_back( Indices + LOD.FirstIndex * IndexSize, Indices + ( LOD.FirstIndex + LOD.IndicesCount ) * IndexSize );
+
+		return True;
+	}
+
+	void CheckCookedFile( const std::string& _File, AE_InOut Report& _Report )
+	{
+		std::vector<char> FirstCooked;
+		std::vector<char> SecondCooked;
+		std::vector<std::vector<char>> FirstLevels;
+		std::vector<std::vector<char>> SecondLevels;
+
+		const Bool IsFirstCooked = CookAndReadLevels( _File, FirstCooked, FirstLevels );
+		const Bool IsSecondCooked = CookAndReadLevels( _File, SecondCooked, SecondLevels );
+
+		_Report.Check( IsFirstCooked && IsSecondCooked, "cooked file : the file is cooked and read back" );
+
+		if( !IsFirstCooked || !IsSecondCooked )
+			return;
+
+		_Report.Check( FirstLevels.size() > 1, "cooked file : several levels are cooked" );
+		_Report.Check( FirstLevels == SecondLevels, "cooked file : the same indices for each level when cooked twice" );
+		_Report.Check( FirstCooked == SecondCooked, "cooked file : the same cooked file when cooked twice" );
+
+		std::printf( "%s : %u levels, %u bytes cooked\n", _File.c_str(), Cast( Uint32, FirstLevels.size() ), Cast( Uint32, FirstCooked.size() ) );
+	}
+}
+
+int main( int _ArgumentsCount, char** _Arguments )
+{
+	Report Result;
+
+	CheckGeneratedTerrain( Result );
+	CheckCookedFile( _ArgumentsCount > 1 ? _Arguments[1] : DefaultFile, Result );
+
+	std::printf( "%u checks, %u failed\n", Result.ChecksCount, Result.FailuresCount );
+
+	return Result.FailuresCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,275 @@
+#include <API/Code/Physics/Simulator/Integration.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Checks the fixed steps of the physics simulator, CPU only :
+// - for the three integrators, the bodies integrated four at a time with SSE and the ones of the scalar tail give the same results
+//   as the scalar step, bit for bit, whatever the count of bodies, and the masked bodies are not written,
+// - the three integrators follow their closed form under a constant acceleration,
+// - the accumulator gives the right count of steps and time left with frame times that are not multiples of the step,
+// - the whole steps beyond the maximum per frame are dropped, the time left stays under a step.
+// Returns 0 if every check passed, 1 otherwise.
+
+using ae::PhysicsSettings;
+
+namespace
+{
+	/// <summary>Largest count of bodies integrated at once : several blocks of four and every size of tail.</summary>
+	constexpr Uint32 MaxBodiesCount = 40;
+
+	/// <summary>Count of steps of each integration.</summary>
+	constexpr Uint32 StepCount = 3;
+
+	/// <summary>Duration of a step, 60 steps per second.</summary>
+	constexpr float TimeStep = 1.0f / 60.0f;
+
+	/// <summary>Duration of a step exact in binary, the accumulator then has no rounding.</summary>
+	constexpr float ExactTimeStep = 1.0f / 64.0f;
+
+	/// <summary>Seed of the bodies and of the masks.</summary>
+	constexpr Uint32 Seed = 1234;
+
+	/// <summary>Checks run and checks failed, the failures are printed.</summary>
+	struct Report
+	{
+		Uint32 ChecksCount = 0;
+		Uint32 FailuresCount = 0;
+
+		void Check( Bool _Condition, const char* _Description )
+		{
+			ChecksCount++;
+
+			if( _Condition )
+				return;
+
+			FailuresCount++;
+			std::printf( "FAILED : %s\n", _Description );
+		}
+	};
+
+	/// <summary>Name of an integrator for the reports.</summary>
+	const char* GetName( PhysicsSettings::IntegrationMethod _Method )
+	{
+		switch( _Method )
+		{
+		case PhysicsSettings::IntegrationMethod::Euler:
+			return "Euler";
+
+		case PhysicsSettings::IntegrationMethod::EulerEndingVelocity:
+			return "EulerEndingVelocity";
+
+		case PhysicsSettings::IntegrationMethod::EulerAverageVelocity:
+		default:
+			return "EulerAverageVelocity";
+		}
+	}
+
+	/// <summary>Two floats with the same bits.</summary>
+	Bool IsSame( float _A, float _B )
+	{
+		return std::memcmp( &_A, &_B, sizeof( float ) ) == 0;
+	}
+
+	/// <summary>Bodies on one axis, as the simulator stores them.</summary>
+	struct Bodies
+	{
+		std::vector<float> Positions;
+		std::vector<float> PreviousPositions;
+		std::vector<float> Velocities;
+		std::vector<float> Accelerations;
+		std::vector<float> Dampings;
+		std::vector<Uint32> Masks;
+	};
+
+	/// <summary>Random bodies, about a third of them masked out.</summary>
+	Bodies BuildBodies( Uint32 _Count, std::mt19937& _Generator )
+	{
+		std::uniform_real_distribution<float> Value( -5.0f, 5.0f );
+		std::uniform_real_distribution<float> Damping( 0.0f, 0.5f );
+		std::uniform_int_distribution<Uint32> Masked( 0, 2 );
+
+		Bodies Result;
+		for( Uint32 b = 0; b < _Count; b++ )
+		{
+			Result.Positions.push_back( Value( _Generator ) );
+			Result.PreviousPositions.push_back( Value( _Generator ) );
+			Result.Velocities.push_back( Value( _Generator ) );
+			Result.Accelerations.push_back( Value( _Generator ) );
+			Result.Dampings.push_back( Damping( _Generator ) );
+			Result.Masks.push_back( Masked( _Generator ) == 0 ? 0 : 0xFFFFFFFF );
+		}
+
+		return Result;
+	}
+
+	/// <summary>The integration of the arrays against the scalar step run body by body.</summary>
+	template<PhysicsSettings::IntegrationMethod Method>
+	void CheckMaskedLanes( AE_InOut Report& _Report )
+	{
+		std::mt19937 Generator( Seed );
+
+		Bool IsIntegratedSame = True;
+		Bool IsMaskedKept = True;
+
+		for( Uint32 Count = 0; Count <= MaxBodiesCount; Count++ )
+		{
+			const Bodies Start = BuildBodies( Count, Generator );
+			Bodies Result = Start;
+
+			ae::priv::Integration::IntegrateAxis<Method>( Result.Positions.data(), Result.PreviousPositions.data(), Result.Velocities.data(),
+														  Result.Accelerations.data(), Result.Dampings.data(), Result.Masks.data(), Count, StepCount, TimeStep );
+
+			for( Uint32 b = 0; b < Count; b++ )
+			{
+				if( Start.Masks[b] == 0 )
+				{
+					IsMaskedKept &= IsSame( Result.Positions[b], Start.Positions[b] ) && IsSame( Result.PreviousPositions[b], Start.PreviousPositions[b] ) &&
+									IsSame( Result.Velocities[b], Start.Velocities[b] );
+					continue;
+				}
+
+				float Position = Start.Positions[b];
+				float PreviousPosition = Position;
+				float Velocity = Start.Velocities[b];
+
+				for( Uint32 s = 0; s < StepCount; s++ )
+				{
+					PreviousPosition = Position;
+					ae::priv::Integration::Step<Method>( Position, Velocity, Start.Accelerations[b], Start.Dampings[b], TimeStep, 0.5f );
+				}
+
+				IsIntegratedSame &= IsSame( Result.Positions[b], Position ) && IsSame( Result.PreviousPositions[b], PreviousPosition ) &&
+									IsSame( Result.Velocities[b], Velocity );
+			}
+		}
+
+		const std::string Name = GetName( Method );
+		_Report.Check( IsIntegratedSame, ( Name + " : the bodies of the SSE lanes and of the scalar tail match the scalar step bit for bit" ).c_str() );
+		_Report.Check( IsMaskedKept, ( Name + " : the masked bodies are not written" ).c_str() );
+	}
+
+	/// <summary>A body under a constant acceleration, without air resistance, against the closed form of the integrator.</summary>
+	template<PhysicsSettings::IntegrationMethod Method>
+	void CheckClosedForm( float _StepsFactor, AE_InOut Report& _Report )
+	{
+		const Uint32 Steps = 60;
+		const float StartPosition = 2.0f;
+		const float StartVelocity = 3.0f;
+		const float Acceleration = -10.0f;
+
+		float Position = StartPosition;
+		float PreviousPosition = 0.0f;
+		float Velocity = StartVelocity;
+		const float Damping = 0.0f;
+		const Uint32 Mask = 0xFFFFFFFF;
+
+		ae::priv::Integration::IntegrateAxis<Method>( &Position, &PreviousPosition, &Velocity, &Acceleration, &Damping, &Mask, 1, Steps, TimeStep );
+
+		// x(n) = x0 + v0 * n * dt + a * dt^2 * f(n), with f(n) = n(n-1)/2, n(n+1)/2 or n^2/2 for the three integrators.
+		const auto Expected = [&]( Uint32 _Steps )
+		{
+			const double n = _Steps;
+			const double t = TimeStep;
+			const double Factor = ( n * n + _StepsFactor * n ) / 2.0;
+
+			return StartPosition + StartVelocity * n * t + Acceleration * t * t * Factor;
+		};
+
+		const double ExpectedVelocity = StartVelocity + Acceleration * Steps * TimeStep;
+
+		const std::string Name = GetName( Method );
+		_Report.Check( std::fabs( Position - Expected( Steps ) ) < 1e-4, ( Name + " : the position follows the closed form" ).c_str() );
+		_Report.Check( std::fabs( PreviousPosition - Expected( Steps - 1 ) ) < 1e-4, ( Name + " : the previous position is the one before the last step" ).c_str() );
+		_Report.Check( std::fabs( Velocity - ExpectedVelocity ) < 1e-4, ( Name + " : the velocity follows the closed form" ).c_str() );
+	}
+
+	/// <summary>Frame times that are not multiples of the step.</summary>
+	void CheckAccumulator( AE_InOut Report& _Report )
+	{
+		// 2.5 steps per frame, exact in binary : 2 steps then 3, half a step left then none.
+		float Accumulator = 0.0f;
+		Bool IsAlternating = True;
+
+		for( Uint32 f = 0; f < 8; f++ )
+		{
+			const Uint32 Steps = ae::priv::Integration::ConsumeSteps( Accumulator, 2.5f * ExactTimeStep, ExactTimeStep, 8 );
+			const float Alpha = Accumulator / ExactTimeStep;
+
+			IsAlternating &= f % 2 == 0 ? Steps == 2 && Alpha == 0.5f : Steps == 3 && Alpha == 0.0f;
+		}
+
+		_Report.Check( IsAlternating, "accumulator : 2.5 steps per frame give 2 then 3 steps, an alpha of 0.5 then 0" );
+
+		// 0.4 step per frame : a step every 2 or 3 frames, the time left grows by 0.4 step each frame without it.
+		Accumulator = 0.0f;
+		const Uint32 FirstSteps = ae::priv::Integration::ConsumeSteps( Accumulator, 0.4f * TimeStep, TimeStep, 8 );
+		const float FirstAlpha = Accumulator / TimeStep;
+		const Uint32 SecondSteps = ae::priv::Integration::ConsumeSteps( Accumulator, 0.4f * TimeStep, TimeStep, 8 );
+		const Uint32 ThirdSteps = ae::priv::Integration::ConsumeSteps( Accumulator, 0.4f * TimeStep, TimeStep, 8 );
+		const float ThirdAlpha = Accumulator / TimeStep;
+
+		_Report.Check( FirstSteps == 0 && std::fabs( FirstAlpha - 0.4f ) < 1e-5f, "accumulator : no step for 0.4 step, an alpha of 0.4" );
+		_Report.Check( SecondSteps == 0 && ThirdSteps == 1 && std::fabs( ThirdAlpha - 0.2f ) < 1e-4f, "accumulator : a step after 1.2 steps, an alpha of 0.2" );
+
+		// 144 Hz frames on 60 Hz steps : one second of frames gives one second of steps, the time left always under a step.
+		Accumulator = 0.0f;
+		Uint32 TotalSteps = 0;
+		Bool IsUnderStep = True;
+
+		for( Uint32 f = 0; f < 144; f++ )
+		{
+			TotalSteps += ae::priv::Integration::ConsumeSteps( Accumulator, 1.0f / 144.0f, TimeStep, 8 );
+			IsUnderStep &= Accumulator >= -1e-6f && Accumulator < TimeStep;
+		}
+
+		_Report.Check( TotalSteps == 60 || ( TotalSteps == 59 && Accumulator > TimeStep - 1e-5f ), "accumulator : 144 frames of 1/144 s give 60 steps of 1/60 s" );
+		_Report.Check( IsUnderStep, "accumulator : the time left is always under a step" );
+	}
+
+	/// <summary>A frame too long : the maximum of steps is simulated, the whole steps left are dropped, not the fraction.</summary>
+	void CheckMaxStepsDrop( AE_InOut Report& _Report )
+	{
+		// 12.75 steps in one frame with 4 steps at most : 4 steps, 8 dropped, 0.75 step left.
+		float Accumulator = 0.0f;
+		const Uint32 Steps = ae::priv::Integration::ConsumeSteps( Accumulator, 12.75f * ExactTimeStep, ExactTimeStep, 4 );
+
+		_Report.Check( Steps == 4, "max steps : a frame of 12.75 steps simulates 4 steps" );
+		_Report.Check( Accumulator == 0.75f * ExactTimeStep, "max steps : the 8 whole steps left are dropped, 0.75 step is kept" );
+
+		// The dropped steps do not come back the next frames.
+		const Uint32 NextSteps = ae::priv::Integration::ConsumeSteps( Accumulator, 0.5f * ExactTimeStep, ExactTimeStep, 4 );
+
+		_Report.Check( NextSteps == 1 && Accumulator == 0.25f * ExactTimeStep, "max steps : the next frame of 0.5 step simulates 1 step, 0.25 step left" );
+
+		// At the maximum exactly, nothing is dropped.
+		Accumulator = 0.0f;
+		const Uint32 MaxSteps = ae::priv::Integration::ConsumeSteps( Accumulator, 4.5f * ExactTimeStep, ExactTimeStep, 4 );
+
+		_Report.Check( MaxSteps == 4 && Accumulator == 0.5f * ExactTimeStep, "max steps : a frame of 4.5 steps simulates 4 steps, 0.5 step left" );
+	}
+}
+
+int main()
+{
+	Report Result;
+
+	CheckMaskedLanes<PhysicsSettings::IntegrationMethod::Euler>( Result );
+	CheckMaskedLanes<PhysicsSettings::IntegrationMethod::EulerEndingVelocity>( Result );
+	CheckMaskedLanes<PhysicsSettings::IntegrationMethod::EulerAverageVelocity>( Result );
+
+	CheckClosedForm<PhysicsSettings::IntegrationMethod::Euler>( -1.0f, Result );
+	CheckClosedForm<PhysicsSettings::IntegrationMethod::EulerEndingVelocity>( 1.0f, Result );
+	CheckClosedForm<PhysicsSettings::IntegrationMethod::EulerAverageVelocity>( 0.0f, Result );
+
+	CheckAccumulator( Result );
+	CheckMaxStepsDrop( Result );
+
+	std::printf( "%u checks, %u failed\n", Result.ChecksCount, Result.FailuresCount );
+
+	return Result.FailuresCount == 0 ? 0 : 1;
+}